@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ameba_soc.h"
+#include "platform_stdlib.h"
+
+#include "audio_uart_frame.h"
+
+#define AUDIO_UART_FRAME_DEBUG(fmt, args...)    printf("=> D/AudioUartFrame:[%s]: " fmt "\n", __func__, ## args)
+#define AUDIO_UART_FRAME_ERROR(fmt, args...)    printf("=> E/AudioUartFrame:[%s]: " fmt "\n", __func__, ## args)
+
+static const uint16_t g_crc16_table[256] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+	0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+	0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+	0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+	0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+	0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+	0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+	0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+	0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+	0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+	0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+	0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+	0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+	0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+	0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+	0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+	0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+	0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+	0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+	0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+	0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+	0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+	0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+	0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+	0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+	0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+	0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+	0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+	0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+	0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+	0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+uint16_t audio_uart_frame_crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+	while (len--) {
+		crc = (uint16_t)(crc << 8) ^ g_crc16_table[(uint8_t)(crc >> 8) ^ *data++];
+	}
+	return crc;
+}
+
+int32_t audio_uart_frame_pack(uint8_t *buf, uint8_t type, uint16_t seq, const void *payload, uint16_t len)
+{
+	uint16_t crc;
+
+	if (len > AUDIO_UART_FRAME_MAX_PAYLOAD) {
+		return -1;
+	}
+
+	buf[0] = AUDIO_UART_FRAME_SOF0;
+	buf[1] = AUDIO_UART_FRAME_SOF1;
+	buf[2] = type;
+	buf[3] = 0;
+	audio_uart_frame_put_u16(buf + 4, seq);
+	audio_uart_frame_put_u16(buf + 6, len);
+	if (payload && len && payload != AUDIO_UART_FRAME_PAYLOAD(buf)) {
+		memcpy(AUDIO_UART_FRAME_PAYLOAD(buf), payload, len);
+	}
+
+	crc = audio_uart_frame_crc16(0xFFFF, buf + 2, AUDIO_UART_FRAME_HEADER_LEN - 2 + len);
+	audio_uart_frame_put_u16(AUDIO_UART_FRAME_PAYLOAD(buf) + len, crc);
+	return AUDIO_UART_FRAME_HEADER_LEN + len + AUDIO_UART_FRAME_CRC_LEN;
+}
+
+int32_t audio_uart_frame_unpack(struct audio_uart_frame *frame)
+{
+	const uint8_t *raw = frame->raw;
+	uint16_t len;
+
+	if (raw[0] != AUDIO_UART_FRAME_SOF0 || raw[1] != AUDIO_UART_FRAME_SOF1) {
+		return -1;
+	}
+	len = audio_uart_frame_get_u16(raw + 6);
+	if (len > AUDIO_UART_FRAME_MAX_PAYLOAD) {
+		return -1;
+	}
+	if (audio_uart_frame_crc16(0xFFFF, raw + 2, AUDIO_UART_FRAME_HEADER_LEN - 2 + len) !=
+		audio_uart_frame_get_u16(raw + AUDIO_UART_FRAME_HEADER_LEN + len)) {
+		return -1;
+	}
+
+	frame->type = raw[2];
+	frame->flags = raw[3];
+	frame->seq = audio_uart_frame_get_u16(raw + 4);
+	frame->len = len;
+	frame->payload = raw + AUDIO_UART_FRAME_HEADER_LEN;
+	return 0;
+}
+
+int32_t audio_uart_frame_dispatch(const struct audio_uart_frame_handler *table, uint32_t count,
+								  const struct audio_uart_frame *frame, void *priv)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		if (table[i].type != frame->type) {
+			continue;
+		}
+		if (frame->len < table[i].min_len) {
+			return AUDIO_UART_FRAME_ERR_LEN;
+		}
+		return table[i].handle(frame, priv);
+	}
+	return AUDIO_UART_FRAME_ERR_TYPE;
+}
+
+/*
+ * keeps the tail of the header bytes in buf that could still be the start of a frame,
+ * returns how many are kept, AUDIO_UART_FRAME_HEADER_LEN when buf starts with the sof.
+ */
+static uint32_t audio_uart_frame_sync(uint8_t *buf, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (buf[i] != AUDIO_UART_FRAME_SOF0) {
+			continue;
+		}
+		if (i + 1 == len || buf[i + 1] == AUDIO_UART_FRAME_SOF1) {
+			break;
+		}
+	}
+
+	if (i > 0 && i < len) {
+		memmove(buf, buf + i, len - i);
+	}
+	return len - i;
+}
+
+static void audio_uart_frame_rx_dma_done(uint32_t id)
+{
+	struct audio_uart_frame_rx *rx = (struct audio_uart_frame_rx *)id;
+
+	rtos_sema_give(rx->dma_sema);
+}
+
+static int32_t audio_uart_frame_rx_dma(struct audio_uart_frame_rx *rx, uint8_t *buf, uint32_t len, uint32_t timeout_ms)
+{
+	//write back what the sync moved before the dma lands next to it.
+	DCache_CleanInvalidate((u32)buf, len);
+	if (serial_recv_stream_dma(rx->sobj, (char *)buf, len) != 0) {
+		rtos_time_delay_ms(1);
+		return -1;
+	}
+	if (rtos_sema_take(rx->dma_sema, timeout_ms) != RTK_SUCCESS) {
+		serial_recv_stream_abort(rx->sobj);
+		rx->timeouts++;
+		return -1;
+	}
+	if (rx->stop) {
+		return -1;
+	}
+	DCache_Invalidate((u32)buf, len);
+	return 0;
+}
+
+static void audio_uart_frame_rx_task(void *param)
+{
+	struct audio_uart_frame_rx *rx = (struct audio_uart_frame_rx *)param;
+	struct audio_uart_frame *frame;
+	uint32_t have;
+	uint16_t len;
+
+	while (!rx->stop) {
+		if (rx->head - rx->tail < AUDIO_UART_FRAME_SLOTS) {
+			frame = &rx->slots[rx->head % AUDIO_UART_FRAME_SLOTS];
+		} else {
+			frame = &rx->spare;
+		}
+
+		//the header is taken a byte at a time only while looking for the sof after line noise.
+		have = 0;
+		while (have < AUDIO_UART_FRAME_HEADER_LEN && !rx->stop) {
+			if (audio_uart_frame_rx_dma(rx, frame->raw + have, AUDIO_UART_FRAME_HEADER_LEN - have, RTOS_MAX_TIMEOUT) != 0) {
+				have = 0;
+				continue;
+			}
+			have = audio_uart_frame_sync(frame->raw, AUDIO_UART_FRAME_HEADER_LEN);
+			if (have < AUDIO_UART_FRAME_HEADER_LEN) {
+				rx->resyncs++;
+			}
+		}
+		if (rx->stop) {
+			break;
+		}
+
+		len = audio_uart_frame_get_u16(frame->raw + 6);
+		if (len > AUDIO_UART_FRAME_MAX_PAYLOAD) {
+			rx->resyncs++;
+			continue;
+		}
+		if (audio_uart_frame_rx_dma(rx, AUDIO_UART_FRAME_PAYLOAD(frame->raw), len + AUDIO_UART_FRAME_CRC_LEN,
+									AUDIO_UART_FRAME_TIMEOUT_MS) != 0) {
+			continue;
+		}
+		if (audio_uart_frame_unpack(frame) != 0) {
+			rx->crc_errors++;
+			continue;
+		}
+		if (frame == &rx->spare) {
+			rx->overruns++;
+			continue;
+		}
+
+		rx->frames++;
+		rx->head++;
+		rtos_sema_give(rx->frame_sema);
+	}
+
+	rtos_sema_give(rx->exit_sema);
+	rtos_task_delete(NULL);
+}
+
+int32_t audio_uart_frame_rx_start(struct audio_uart_frame_rx *rx, serial_t *sobj, uint32_t priority)
+{
+	memset(rx, 0, sizeof(*rx));
+	rx->sobj = sobj;
+
+	rtos_sema_create(&rx->dma_sema, 0, RTOS_SEMA_MAX_COUNT);
+	rtos_sema_create(&rx->frame_sema, 0, RTOS_SEMA_MAX_COUNT);
+	rtos_sema_create(&rx->exit_sema, 0, RTOS_SEMA_MAX_COUNT);
+	serial_recv_comp_handler(sobj, (void *)audio_uart_frame_rx_dma_done, (uint32_t)rx);
+
+	if (rtos_task_create(NULL, ((const char *)"audio_uart_frame_rx"), audio_uart_frame_rx_task, rx, 1024 * 2, priority) != RTK_SUCCESS) {
+		AUDIO_UART_FRAME_ERROR("error: rtos_task_create(audio_uart_frame_rx) failed");
+		rtos_sema_delete(rx->dma_sema);
+		rtos_sema_delete(rx->frame_sema);
+		rtos_sema_delete(rx->exit_sema);
+		return -1;
+	}
+	return 0;
+}
+
+void audio_uart_frame_rx_stop(struct audio_uart_frame_rx *rx)
+{
+	rx->stop = true;
+	serial_recv_stream_abort(rx->sobj);
+	rtos_sema_give(rx->dma_sema);
+	rtos_sema_take(rx->exit_sema, RTOS_MAX_TIMEOUT);
+
+	AUDIO_UART_FRAME_DEBUG("%lu frames, %lu crc errors, %lu timeouts, %lu overruns, %lu resyncs",
+						   rx->frames, rx->crc_errors, rx->timeouts, rx->overruns, rx->resyncs);
+	rtos_sema_delete(rx->dma_sema);
+	rtos_sema_delete(rx->frame_sema);
+	rtos_sema_delete(rx->exit_sema);
+}
+
+struct audio_uart_frame *audio_uart_frame_rx_get(struct audio_uart_frame_rx *rx, uint32_t timeout_ms)
+{
+	if (rtos_sema_take(rx->frame_sema, timeout_ms) != RTK_SUCCESS) {
+		return NULL;
+	}
+	return &rx->slots[rx->tail % AUDIO_UART_FRAME_SLOTS];
+}
+
+void audio_uart_frame_rx_put(struct audio_uart_frame_rx *rx)
+{
+	rx->tail++;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_CMDS_AUDIO_UART_FRAME_H
+#define AMEBA_AUDIO_AUDIO_CMDS_AUDIO_UART_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "serial_api.h"
+#include "serial_ex_api.h"
+#include "os_wrapper.h"
+
+/*
+ * control frame on the tuning uarts, all fields little endian:
+ *   0xA5 0x5A | type u8 | flags u8 | seq u16 | len u16 | payload[len] | crc16 u16
+ * crc16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over type to the end of the payload.
+ * replies echo the seq of the request they answer.
+ */
+#define AUDIO_UART_FRAME_SOF0           0xA5
+#define AUDIO_UART_FRAME_SOF1           0x5A
+#define AUDIO_UART_FRAME_HEADER_LEN     8
+#define AUDIO_UART_FRAME_CRC_LEN        2
+#define AUDIO_UART_FRAME_MAX_PAYLOAD    256
+#define AUDIO_UART_FRAME_MAX_LEN        (AUDIO_UART_FRAME_HEADER_LEN + AUDIO_UART_FRAME_MAX_PAYLOAD + AUDIO_UART_FRAME_CRC_LEN)
+
+//frames received and not handled yet, the receiver drops frames while all slots are taken.
+#ifndef AUDIO_UART_FRAME_SLOTS
+#define AUDIO_UART_FRAME_SLOTS          4
+#endif
+//the rest of a frame has to follow its header within this, else the receiver starts over.
+#define AUDIO_UART_FRAME_TIMEOUT_MS     100
+
+//ack payload: type of the request, then one of these.
+#define AUDIO_UART_FRAME_OK             0
+#define AUDIO_UART_FRAME_ERR_TYPE       -1
+#define AUDIO_UART_FRAME_ERR_LEN        -2
+#define AUDIO_UART_FRAME_ERR_PARAM      -3
+
+#define AUDIO_UART_FRAME_PAYLOAD(buf)   ((uint8_t *)(buf) + AUDIO_UART_FRAME_HEADER_LEN)
+
+struct audio_uart_frame {
+	//raw bytes as received, dma writes here so it has a cache line of its own.
+	uint8_t raw[(AUDIO_UART_FRAME_MAX_LEN + 31) & ~31] __attribute__((aligned(32)));
+	uint8_t type;
+	uint8_t flags;
+	uint16_t seq;
+	uint16_t len;
+	const uint8_t *payload;
+};
+
+/*
+ * handler of one frame type, payloads shorter than min_len are answered with AUDIO_UART_FRAME_ERR_LEN
+ * without calling it. returns AUDIO_UART_FRAME_OK or an error for the ack, or 1 if it sent the reply itself.
+ */
+struct audio_uart_frame_handler {
+	uint8_t type;
+	uint16_t min_len;
+	int32_t (*handle)(const struct audio_uart_frame *frame, void *priv);
+};
+
+struct audio_uart_frame_rx {
+	serial_t *sobj;
+	struct audio_uart_frame slots[AUDIO_UART_FRAME_SLOTS];
+	//frames that arrive while all slots are taken are read into this and dropped.
+	struct audio_uart_frame spare;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	volatile bool stop;
+	rtos_sema_t dma_sema;
+	rtos_sema_t frame_sema;
+	rtos_sema_t exit_sema;
+	uint32_t frames;
+	uint32_t crc_errors;
+	uint32_t timeouts;
+	uint32_t overruns;
+	uint32_t resyncs;
+};
+
+uint16_t audio_uart_frame_crc16(uint16_t crc, const uint8_t *data, uint32_t len);
+
+static inline uint16_t audio_uart_frame_get_u16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t audio_uart_frame_get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void audio_uart_frame_put_u16(uint8_t *p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void audio_uart_frame_put_u32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+/*
+ * fills header and crc around a payload in buf, buf has AUDIO_UART_FRAME_MAX_LEN bytes.
+ * payload may already sit at AUDIO_UART_FRAME_PAYLOAD(buf). returns the frame length, or -1 if len is too long.
+ */
+int32_t audio_uart_frame_pack(uint8_t *buf, uint8_t type, uint16_t seq, const void *payload, uint16_t len);
+
+/* checks the complete frame in frame->raw and fills the other fields, returns 0 or -1 on a bad frame. */
+int32_t audio_uart_frame_unpack(struct audio_uart_frame *frame);
+
+/* calls the handler of frame->type from table, returns what it returns or AUDIO_UART_FRAME_ERR_TYPE/LEN. */
+int32_t audio_uart_frame_dispatch(const struct audio_uart_frame_handler *table, uint32_t count,
+								  const struct audio_uart_frame *frame, void *priv);
+
+/*
+ * receives frames by uart dma on its own task, the uart rx irq must not be enabled.
+ * rx has to stay valid until audio_uart_frame_rx_stop returns.
+ */
+int32_t audio_uart_frame_rx_start(struct audio_uart_frame_rx *rx, serial_t *sobj, uint32_t priority);
+void audio_uart_frame_rx_stop(struct audio_uart_frame_rx *rx);
+
+/* next frame in arrival order, NULL on timeout. the frame stays valid until audio_uart_frame_rx_put. */
+struct audio_uart_frame *audio_uart_frame_rx_get(struct audio_uart_frame_rx *rx, uint32_t timeout_ms);
+void audio_uart_frame_rx_put(struct audio_uart_frame_rx *rx);
+
+#endif /* AMEBA_AUDIO_AUDIO_CMDS_AUDIO_UART_FRAME_H */
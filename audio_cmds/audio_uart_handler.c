@@ -18,6 +18,7 @@
 #include "audio/audio_service.h"
 
 #include "audio_uart_handler.h"
+#include "audio_uart_frame.h"
 
 #define USING_CMD      1
 #define EXAMPLE_AUDIO_DEBUG(fmt, args...)    printf("=> D/AudioUart:[%s]: " fmt "\n", __func__, ## args)
@@ -37,17 +38,24 @@
 	EXAMPLE_AUDIO_DEBUG(" diff (%d), peak (%d)", heap_start - heap_end, heap_start - heap_min_ever_free)
 
 
+#if AUDIO_UART_USE_JSON
 static int32_t        g_receive_msg_start_cnt = 0;
 static int32_t        g_receive_msg_end_cnt = 0;
 static unsigned char *g_receive_msg_data = NULL;
 static int32_t        g_receive_data_size = 0;
 static rtos_sema_t    g_receive_data_sema;
+#else
+static struct audio_uart_frame_rx g_frame_rx;
+//replies go out by dma from here, only the task handling the frames writes it.
+static uint8_t        g_reply_frame[AUDIO_UART_FRAME_MAX_LEN] __attribute__((aligned(32)));
+#endif
 static rtos_sema_t    g_send_data_sema;
 static rtos_mutex_t   g_send_data_mutex;
 static serial_t       g_serial_obj;
 static int32_t        g_receive_cnt = 0;
 static int32_t        g_max_receive_cnt = 0x7fffffff;
 
+#if AUDIO_UART_USE_JSON
 struct audio_uart_msg {
 	int32_t item;
 	char *item_str;
@@ -95,6 +103,7 @@ static bool audio_uart_check_cjson(unsigned char *inbuf, int32_t len)
 	}
 	return FALSE;
 }
+#endif
 
 static void audio_uart_send_data(char *pstr, int32_t len)
 {
@@ -116,6 +125,16 @@ static void audio_uart_send_data(char *pstr, int32_t len)
 #endif
 }
 
+//the buffer passed to audio_uart_send_data can be reused after this.
+static void audio_uart_wait_send_done(void)
+{
+#if AUDIO_UART_USE_DMA_TX
+	rtos_sema_take(g_send_data_sema, RTOS_MAX_TIMEOUT);
+	rtos_sema_give(g_send_data_sema);
+#endif
+}
+
+#if AUDIO_UART_USE_JSON
 static int32_t audio_uart_eq_query(struct AudioEqualizer *audio_equalizer)
 {
 	uint32_t eq_bands = 10;
@@ -311,6 +330,149 @@ static void audio_uart_receive_irq(uint32_t id, SerialIrq event)
 		}
 	}
 }
+#else
+//payload is already at AUDIO_UART_FRAME_PAYLOAD(g_reply_frame).
+static void audio_uart_frame_reply(uint8_t type, uint16_t seq, uint16_t len)
+{
+	int32_t frame_len = audio_uart_frame_pack(g_reply_frame, type, seq, NULL, len);
+
+	rtos_mutex_take(g_send_data_mutex, MUTEX_WAIT_TIMEOUT);
+	audio_uart_send_data((char *)g_reply_frame, frame_len);
+	audio_uart_wait_send_done();
+	rtos_mutex_give(g_send_data_mutex);
+}
+
+static void audio_uart_frame_ack(const struct audio_uart_frame *frame, int32_t status)
+{
+	uint8_t *payload = AUDIO_UART_FRAME_PAYLOAD(g_reply_frame);
+
+	payload[0] = frame->type;
+	payload[1] = (uint8_t)(int8_t)status;
+	audio_uart_frame_reply(status >= 0 ? AUDIO_UART_MSG_ACK : AUDIO_UART_MSG_ERROR, frame->seq, 2);
+}
+
+static bool audio_uart_frame_band_valid(struct AudioEqualizer *audio_equalizer, uint8_t band)
+{
+	return band < AudioEqualizer_GetNumberOfBands(audio_equalizer);
+}
+
+static int32_t audio_uart_frame_eq_query(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+	uint8_t *payload = AUDIO_UART_FRAME_PAYLOAD(g_reply_frame);
+	int16_t bands = AudioEqualizer_GetNumberOfBands(audio_equalizer);
+	uint8_t *band;
+
+	if (bands < 0 || 1 + bands * AUDIO_UART_BAND_LEN > AUDIO_UART_FRAME_MAX_PAYLOAD) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+
+	payload[0] = (uint8_t)bands;
+	for (int16_t i = 0; i < bands; i++) {
+		band = payload + 1 + i * AUDIO_UART_BAND_LEN;
+		audio_uart_frame_put_u32(band, AudioEqualizer_GetCenterFreq(audio_equalizer, i));
+		audio_uart_frame_put_u16(band + 4, (uint16_t)AudioEqualizer_GetBandLevel(audio_equalizer, i));
+		audio_uart_frame_put_u16(band + 6, (uint16_t)AudioEqualizer_GetQfactor(audio_equalizer, i));
+		//filter type is not kept by the eq yet.
+		band[8] = 0;
+	}
+
+	audio_uart_frame_reply(AUDIO_UART_MSG_QUERY, frame->seq, 1 + bands * AUDIO_UART_BAND_LEN);
+	return 1;
+}
+
+static int32_t audio_uart_frame_eq_set_frequency(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+
+	if (!audio_uart_frame_band_valid(audio_equalizer, frame->payload[0])) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	if (AudioEqualizer_SetCenterFreq(audio_equalizer, frame->payload[0], audio_uart_frame_get_u32(frame->payload + 1)) < 0) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	return AUDIO_UART_FRAME_OK;
+}
+
+static int32_t audio_uart_frame_eq_set_gain(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+	int16_t gain = (int16_t)audio_uart_frame_get_u16(frame->payload + 1);
+
+	if (!audio_uart_frame_band_valid(audio_equalizer, frame->payload[0])) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	if (AudioEqualizer_SetBandLevel(audio_equalizer, frame->payload[0], (uint32_t)(int32_t)gain) < 0) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	return AUDIO_UART_FRAME_OK;
+}
+
+static int32_t audio_uart_frame_eq_set_qfactor(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+
+	if (!audio_uart_frame_band_valid(audio_equalizer, frame->payload[0])) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	if (AudioEqualizer_SetQfactor(audio_equalizer, frame->payload[0], audio_uart_frame_get_u16(frame->payload + 1)) < 0) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	return AUDIO_UART_FRAME_OK;
+}
+
+static int32_t audio_uart_frame_eq_set_filter_type(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+
+	if (!audio_uart_frame_band_valid(audio_equalizer, frame->payload[0])) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	//set type here.do nothing.
+	return AUDIO_UART_FRAME_OK;
+}
+
+//all of one band in a frame, what a tuning tool sends while a control is dragged.
+static int32_t audio_uart_frame_eq_set_band(const struct audio_uart_frame *frame, void *priv)
+{
+	struct AudioEqualizer *audio_equalizer = (struct AudioEqualizer *)priv;
+	uint8_t band = frame->payload[0];
+	int16_t gain = (int16_t)audio_uart_frame_get_u16(frame->payload + 5);
+
+	if (!audio_uart_frame_band_valid(audio_equalizer, band)) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	if (AudioEqualizer_SetCenterFreq(audio_equalizer, band, audio_uart_frame_get_u32(frame->payload + 1)) < 0 ||
+		AudioEqualizer_SetBandLevel(audio_equalizer, band, (uint32_t)(int32_t)gain) < 0 ||
+		AudioEqualizer_SetQfactor(audio_equalizer, band, audio_uart_frame_get_u16(frame->payload + 7)) < 0) {
+		return AUDIO_UART_FRAME_ERR_PARAM;
+	}
+	return AUDIO_UART_FRAME_OK;
+}
+
+static const struct audio_uart_frame_handler g_eq_frame_handlers[] = {
+	{AUDIO_UART_MSG_SET_FREQUENCY,   5,                       audio_uart_frame_eq_set_frequency  },
+	{AUDIO_UART_MSG_SET_GAIN,        3,                       audio_uart_frame_eq_set_gain       },
+	{AUDIO_UART_MSG_SETQFACTOR,      3,                       audio_uart_frame_eq_set_qfactor    },
+	{AUDIO_UART_MSG_SETFILTERTYPE,   2,                       audio_uart_frame_eq_set_filter_type},
+	{AUDIO_UART_MSG_QUERY,           0,                       audio_uart_frame_eq_query          },
+	{AUDIO_UART_MSG_SET_BAND,        1 + AUDIO_UART_BAND_LEN, audio_uart_frame_eq_set_band       },
+};
+
+static void audio_uart_process_frame(const struct audio_uart_frame *frame, struct AudioEqualizer *audio_equalizer)
+{
+	int32_t ret;
+
+	ret = audio_uart_frame_dispatch(g_eq_frame_handlers, sizeof(g_eq_frame_handlers) / sizeof(g_eq_frame_handlers[0]),
+									frame, audio_equalizer);
+	if (ret < 0) {
+		EXAMPLE_AUDIO_ERROR("type 0x%x seq %d len %d: error %ld", frame->type, frame->seq, frame->len, ret);
+	}
+	if (ret <= 0) {
+		audio_uart_frame_ack(frame, ret);
+	}
+}
+#endif
 
 static void uart_dma_tx_done(uint32_t id)
 {
@@ -327,8 +489,10 @@ static void audio_uart_init_uart(void)
 
 	serial_rx_fifo_level(&g_serial_obj, FifoLvHalf);
 	serial_set_flow_control(&g_serial_obj, FlowControlNone, 0, 0);
+#if AUDIO_UART_USE_JSON
 	serial_irq_handler(&g_serial_obj, audio_uart_receive_irq, (uint32_t)&g_serial_obj);
 	serial_irq_set(&g_serial_obj, RxIrq, ENABLE);
+#endif
 #if AUDIO_UART_USE_DMA_TX
 	serial_send_comp_handler(&g_serial_obj, (void *)uart_dma_tx_done, (uint32_t) &g_serial_obj);
 #endif
@@ -384,7 +548,9 @@ static void audio_uart_task(void *param)
 
 	AUDIO_UART_DEBUG_HEAP_BEGIN();
 
+#if AUDIO_UART_USE_JSON
 	g_receive_msg_data = (unsigned char *) calloc(AUDIO_UART_RECEIVE_DATA_BUFLEN, sizeof(unsigned char));
+#endif
 
 	struct AudioEqualizer *audio_equalizer;
 	audio_uart_create_eq(&audio_equalizer);
@@ -392,11 +558,12 @@ static void audio_uart_task(void *param)
 #if AUDIO_UART_USE_DMA_TX
 	rtos_sema_create(&g_send_data_sema, 1, RTOS_SEMA_MAX_COUNT);
 #endif
-	rtos_sema_create(&g_receive_data_sema, 0, RTOS_SEMA_MAX_COUNT);
 	rtos_mutex_create(&g_send_data_mutex);
 
 	audio_uart_init_uart();
 
+#if AUDIO_UART_USE_JSON
+	rtos_sema_create(&g_receive_data_sema, 0, RTOS_SEMA_MAX_COUNT);
 	memset(g_receive_msg_data, 0, AUDIO_UART_RECEIVE_DATA_BUFLEN);
 
 	msg_attrib_t pattrib = {0};
@@ -416,15 +583,39 @@ static void audio_uart_task(void *param)
 		audio_uart_process_receive_data(&pattrib, audio_equalizer);
 		g_receive_cnt ++;
 	}
+#else
+	struct audio_uart_frame *frame;
+
+	//above this task, so a burst of updates is read in while the eq applies the previous ones.
+	if (audio_uart_frame_rx_start(&g_frame_rx, &g_serial_obj, 2) == 0) {
+#if USING_CMD
+		while (g_receive_cnt < g_max_receive_cnt) {
+#else
+		(void) g_max_receive_cnt;
+		while (1) {
+#endif
+			frame = audio_uart_frame_rx_get(&g_frame_rx, RTOS_MAX_TIMEOUT);
+			if (!frame) {
+				continue;
+			}
+			audio_uart_process_frame(frame, audio_equalizer);
+			audio_uart_frame_rx_put(&g_frame_rx);
+			g_receive_cnt ++;
+		}
+		audio_uart_frame_rx_stop(&g_frame_rx);
+	}
+#endif
 
 	audio_uart_destroy_eq(&audio_equalizer);
 	g_receive_cnt = 0;
 	serial_free(&g_serial_obj);
 	rtos_mutex_delete(g_send_data_mutex);
 	rtos_sema_delete(g_send_data_sema);
+#if AUDIO_UART_USE_JSON
 	rtos_sema_delete(g_receive_data_sema);
 
 	free(g_receive_msg_data);
+#endif
 	rtos_time_delay_ms(1000);
 	AUDIO_UART_DEBUG_HEAP_END();
 
@@ -10,6 +10,8 @@
 #define AUDIO_UART_USE_DMA_TX           1
 #define AUDIO_UART_BAUDRATE             1500000
 #define AUDIO_UART_RECEIVE_DATA_BUFLEN  1024
+//1: json messages found by counting braces in the rx irq, for tools that do not send audio_uart_frame.h frames yet.
+#define AUDIO_UART_USE_JSON             0
 
 #define AUDIO_UART_MSG_ACK              0x00
 #define AUDIO_UART_MSG_ERROR            0x01
@@ -18,6 +20,20 @@
 #define AUDIO_UART_MSG_SETQFACTOR       0x04
 #define AUDIO_UART_MSG_SETFILTERTYPE    0x05
 #define AUDIO_UART_MSG_QUERY            0x06
+#define AUDIO_UART_MSG_SET_BAND         0x07
+
+/*
+ * frame payloads, little endian. gain is in 0.01dB and qfactor in 0.01 steps.
+ *   ack/error:      type u8 | status s8, status is AUDIO_UART_FRAME_OK or AUDIO_UART_FRAME_ERR_*
+ *   setfrequency:   band u8 | centerfrequency u32
+ *   setgain:        band u8 | gain s16
+ *   setqfactor:     band u8 | qfactor u16
+ *   setfiltertype:  band u8 | filtertype u8
+ *   setband:        band u8 | centerfrequency u32 | gain s16 | qfactor u16 | filtertype u8
+ *   query:          empty, answered with a query frame of bands u8 followed by
+ *                   centerfrequency u32 | gain s16 | qfactor u16 | filtertype u8 for each band
+ */
+#define AUDIO_UART_BAND_LEN             9
 
 #define cJSON_AddDoubleToObject(object,name,n)       cJSON_AddItemToObject(object, name, cJSON_CreateNumber(n))
 
@@ -4,15 +4,67 @@
 import serial
 import time
 import json
+import struct
+import binascii
 from datetime import datetime
 import threading
 
+# True for devices built with AUDIO_UART_USE_JSON 1
+USE_JSON = False
+
+MSG_ACK = 0x00
+MSG_ERROR = 0x01
+MSG_SET_FREQUENCY = 0x02
+MSG_SET_GAIN = 0x03
+MSG_SETQFACTOR = 0x04
+MSG_SETFILTERTYPE = 0x05
+MSG_QUERY = 0x06
+MSG_SET_BAND = 0x07
+
 msg_query = '{"type":"query"}'
 msg_set_freq = '{"type":"setfrequency", "id":0, "centerfrequency":47}'
 msg_set_gain = '{"type":"setgain", "id":5, "gain":15}'
 msg_set_qfactor = '{"type":"setqfactor", "id":0, "qfactor":0.96}'
 msg_set_filtertype = '{"type":"setfiltertype", "id":0, "filtertype":0}'
 
+frame_seq = 0
+
+# 0xA5 0x5A | type | flags | seq | len | payload | crc16, see audio_uart_frame.h
+def make_frame(msg_type, payload=b''):
+    global frame_seq
+    frame_seq = (frame_seq + 1) & 0xffff
+    body = struct.pack('<BBHH', msg_type, 0, frame_seq, len(payload)) + payload
+    # crc_hqx with 0xFFFF is CRC-16/CCITT-FALSE
+    return b'\xa5\x5a' + body + struct.pack('<H', binascii.crc_hqx(body, 0xFFFF))
+
+# gain in 0.01dB, qfactor in 0.01 steps
+def frame_set_band(band, frequency, gain, qfactor, filtertype):
+    return make_frame(MSG_SET_BAND, struct.pack('<BIhHB', band, frequency, int(gain * 100), int(qfactor * 100), filtertype))
+
+def parse_frames(data):
+    while True:
+        start = data.find(b'\xa5\x5a')
+        if start < 0 or len(data) - start < 8:
+            return data
+        msg_type, flags, seq, length = struct.unpack_from('<BBHH', data, start + 2)
+        if len(data) - start < 10 + length:
+            return data[start:]
+        body = bytes(data[start + 2:start + 8 + length])
+        crc, = struct.unpack_from('<H', data, start + 8 + length)
+        if crc != binascii.crc_hqx(body, 0xFFFF):
+            data = data[start + 2:]
+            continue
+        payload = body[6:]
+        if msg_type == MSG_QUERY:
+            for i in range(payload[0]):
+                freq, gain, q, ftype = struct.unpack_from('<IhHB', payload, 1 + i * 9)
+                print("seq %d band%d: centerfrequency %d, gain %.2f, qfactor %.2f, filtertype %d"
+                      % (seq, i, freq, gain / 100.0, q / 100.0, ftype))
+        elif msg_type in (MSG_ACK, MSG_ERROR):
+            print("seq %d %s type 0x%x status %d" % (seq, "ack" if msg_type == MSG_ACK else "error",
+                  payload[0], struct.unpack_from('<b', payload, 1)[0]))
+        data = data[start + 10 + length:]
+
 class SerialPort:
     def __init__(self, port, buand):
         self.data_bytes=bytearray()
@@ -30,7 +82,9 @@ class SerialPort:
         self.port.close()
 
     def send_data(self,data):
-        self.port.write(data.encode())
+        if isinstance(data, str):
+            data = data.encode()
+        self.port.write(data)
 
     def read_data(self):
         while not self.is_exit:
@@ -38,7 +92,10 @@ class SerialPort:
             if count > 0:
                 rec_str = self.port.read(count)
                 self.data_bytes=self.data_bytes+rec_str
-                print("get %s"%self.data_bytes)
+                if USE_JSON:
+                    print("get %s"%self.data_bytes)
+                else:
+                    self.data_bytes = parse_frames(self.data_bytes)
 
 serialPort = 'COM40'
 baudRate = 1500000
@@ -53,6 +110,27 @@ if __name__ == '__main__':
     frame_cnt = 0
     frame_error_cnt = 0
 
+    if not USE_JSON:
+        mSerial.send_data(make_frame(MSG_QUERY))
+        time.sleep(0.05)
+        mSerial.send_data(make_frame(MSG_SET_FREQUENCY, struct.pack('<BI', 0, 47)))
+        mSerial.send_data(make_frame(MSG_SET_GAIN, struct.pack('<Bh', 5, 1500)))
+        mSerial.send_data(make_frame(MSG_SETQFACTOR, struct.pack('<BH', 0, 96)))
+        mSerial.send_data(make_frame(MSG_SETFILTERTYPE, struct.pack('<BB', 0, 0)))
+        # a sweep of band 5 as a tuning tool sends it, no need to wait for each ack
+        for i in range(200):
+            mSerial.send_data(frame_set_band(5, 1000, -12 + i * 0.12, 0.96, 0))
+            time.sleep(0.005)
+        mSerial.send_data(make_frame(MSG_QUERY))
+
+        try:
+            while True:
+                time.sleep(5)
+        except KeyboardInterrupt:
+            mSerial.is_exit = True
+            mSerial.port_close()
+        raise SystemExit
+
     query_obj = json.loads(msg_query)
     query_json_str = json.dumps(query_obj, indent=4)
     print(query_json_str)
@@ -14,6 +14,7 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -78,11 +79,11 @@ AmpDummy_SetEnable(AudioAmplifier *amp, AmpControlMode type, bool enabled) {
     {
         case AMP_CTRL_GPIO:
             if (enabled) {
-                RTK_LOGD(TAG, "Enable amp:%ld\n", dummy->sd_pin_config.pinmux);
+                RTK_LOGD(TAG, "Enable amp:%" PRId32 "\n", dummy->sd_pin_config.pinmux);
                 GPIO_WriteBit(dummy->sd_pin_config.pinmux, 1);
                 rtos_time_delay_ms(dummy->sd_pin_config.enable_time);
             } else {
-                RTK_LOGD(TAG, "Disable amp:%ld\n", dummy->sd_pin_config.pinmux);
+                RTK_LOGD(TAG, "Disable amp:%" PRId32 "\n", dummy->sd_pin_config.pinmux);
                 GPIO_WriteBit(dummy->sd_pin_config.pinmux, 0);
                 rtos_time_delay_ms(dummy->sd_pin_config.disable_time);
             }
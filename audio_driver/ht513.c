@@ -14,6 +14,7 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -128,11 +129,11 @@ HT513_SetEnabled(AudioAmplifier *amp, AmpControlMode type, bool enabled) {
     {
         case AMP_CTRL_GPIO:
             if (enabled) {
-                RTK_LOGD(TAG, "Enable amp:%ld\n", ht513->sd_pin_config.pinmux);
+                RTK_LOGD(TAG, "Enable amp:%" PRId32 "\n", ht513->sd_pin_config.pinmux);
                 GPIO_WriteBit(ht513->sd_pin_config.pinmux, 1);
                 rtos_time_delay_ms(ht513->sd_pin_config.enable_time);
             } else {
-                RTK_LOGD(TAG, "Disable amp:%ld\n", ht513->sd_pin_config.pinmux);
+                RTK_LOGD(TAG, "Disable amp:%" PRId32 "\n", ht513->sd_pin_config.pinmux);
                 GPIO_WriteBit(ht513->sd_pin_config.pinmux, 0);
                 rtos_time_delay_ms(ht513->sd_pin_config.disable_time);
             }
@@ -141,7 +142,7 @@ HT513_SetEnabled(AudioAmplifier *amp, AmpControlMode type, bool enabled) {
             if (enabled) {
                 RTK_LOGW(TAG, "Not support i2c enable\n");
             } else {
-                RTK_LOGD(TAG, "Disable amp %ld", ht513->sd_pin_config.pinmux);
+                RTK_LOGD(TAG, "Disable amp %" PRId32 "", ht513->sd_pin_config.pinmux);
                 HT513_SetClassType(amp, AMP_CLASS_TYPE_AB);
 
                 GPIO_WriteBit(ht513->sd_pin_config.pinmux, 0);
@@ -192,7 +193,7 @@ HT513_SetVolume(AudioAmplifier *amp, enum AmpChannelIndex channel, float vol) {
     AmpHT513 *ht513 = (AmpHT513 *)amp;
     uint32_t vol_index = vol * (MAX_DAC_VOLUME - MIN_DAC_VOLUME) + 0x07;
 
-    RTK_LOGD(TAG, "SetVolume %lx\n", vol_index);
+    RTK_LOGD(TAG, "SetVolume %" PRIx32 "\n", vol_index);
 
     switch (channel)
     {
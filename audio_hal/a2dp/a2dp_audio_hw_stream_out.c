@@ -19,13 +19,13 @@
 #include "audio_hw_osal_errnos.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_params_handle.h"
-#include "ameba_audio_stream_buffer.h"
 
 #include "hardware/audio/audio_hw_types.h"
 #include "hardware/audio/audio_hw_utils.h"
 #include "hardware/audio/audio_hw_stream_out.h"
 
 #include "a2dp_audio_ring_buffer.h"
+#include "ameba_spsc_ring.h"
 
 #include "a2dp_audio_hw_card.h"
 
@@ -36,7 +36,6 @@
 #define DUMP_FRAME                192000
 #define DUMP_ENABLE               0
 
-#define DELAY_START              "delay_start"
 
 struct A2dpAudioHwStreamOut {
     struct AudioHwStreamOut stream;
@@ -56,10 +55,12 @@ struct A2dpAudioHwStreamOut {
     uint64_t written;
     bool delay_start;
 
-    AudioBuffer *rb;
+    //pcm from A2dpStreamOutWrite to the sbc encoder, one writer and one reader.
+    ring_buffer_header *rb;
     int32_t rb_size;
+    //writer sleeps on rb_sem only when the ring is full, reader gives it when rb_waiting is set.
     void *rb_sem;
-    bool rb_sem_taken;
+    volatile uint32_t rb_waiting;
 };
 
 struct A2dpAudioHwStreamOut *k_out = NULL;
@@ -172,20 +173,34 @@ static int32_t A2dpGetStreamOutBufferStatus(struct AudioHwStream *stream)
     return 0;
 }
 
-static int32_t A2dpSetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+static int32_t A2dpSetStreamOutParameter(struct AudioHwStreamOut *stream, enum AudioHwParamKey key, int32_t value)
 {
-    HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
     struct A2dpAudioHwStreamOut *out = (struct A2dpAudioHwStreamOut *)stream;
-    struct string_cell *cells;
-    cells = string_cells_create_from_str(str_pairs);
-    int32_t value;
 
-    if (string_cells_has_key(cells, DELAY_START)) {
-        string_cells_get_int(cells, DELAY_START, &value);
+    switch (key) {
+    case AUDIO_HW_PARAM_DELAY_START:
         out->delay_start = value == 1 ? true : false;
+        break;
+    default:
+        HAL_AUDIO_VERBOSE("key:%d not supported", key);
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    return HAL_OSAL_OK;
+}
+
+static int32_t A2dpSetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+{
+    HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
+    struct audio_hw_params params;
+
+    audio_hw_params_parse(str_pairs, &params);
+    for (int32_t key = 0; key < AUDIO_HW_PARAM_MAX; key++) {
+        if (audio_hw_params_has(&params, key)) {
+            A2dpSetStreamOutParameter((struct AudioHwStreamOut *)stream, key, params.values[key]);
+        }
     }
 
-    string_cells_destroy(cells);
     return HAL_OSAL_OK;
 }
 
@@ -259,16 +274,14 @@ int32_t a2dp_hal_buffer_read(int8_t *buffer, int32_t bytes)
         HAL_AUDIO_WARN("a2dp wait for init");
         return HAL_OSAL_ERR_NO_INIT;
     }
-    remain_size = ameba_audio_stream_buffer_get_remain_size(k_out->rb);
+    remain_size = ameba_spsc_ring_available(k_out->rb);
 
     if ((uint32_t)bytes > remain_size) {
         HAL_AUDIO_ERROR("byte bigger than remain size:%ld", remain_size);
         return 0;
     }
-    size_read = ameba_audio_stream_buffer_read(k_out->rb, buffer, bytes, 0);
-    if (k_out->rb_sem_taken) {
-        rtos_sema_give(k_out->rb_sem);
-    }
+    size_read = ameba_spsc_ring_read(k_out->rb, buffer, bytes);
+    ameba_spsc_ring_wake_writer(k_out->rb_sem, &k_out->rb_waiting);
     if (bytes != size_read) {
         printf("prefer size %d, size read %d \r\n", (int)bytes, (int)size_read);
     }
@@ -276,6 +289,43 @@ int32_t a2dp_hal_buffer_read(int8_t *buffer, int32_t bytes)
     return size_read;
 }
 
+int32_t a2dp_hal_buffer_peek(int8_t **buffer, int32_t bytes)
+{
+    uint32_t size;
+
+    if (!k_out) {
+        HAL_AUDIO_WARN("a2dp wait for init");
+        return HAL_OSAL_ERR_NO_INIT;
+    }
+    if (!buffer || bytes < 0) {
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    size = ameba_spsc_ring_peek(k_out->rb, (void **)buffer);
+    if (size > (uint32_t)bytes) {
+        size = bytes;
+    }
+
+    return size;
+}
+
+int32_t a2dp_hal_buffer_commit(int32_t bytes)
+{
+    if (!k_out) {
+        HAL_AUDIO_WARN("a2dp wait for init");
+        return HAL_OSAL_ERR_NO_INIT;
+    }
+    if (bytes < 0 || (uint32_t)bytes > ameba_spsc_ring_available(k_out->rb)) {
+        HAL_AUDIO_ERROR("commit %ld bigger than remain size", bytes);
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    ameba_spsc_ring_commit(k_out->rb, bytes);
+    ameba_spsc_ring_wake_writer(k_out->rb_sem, &k_out->rb_waiting);
+
+    return HAL_OSAL_OK;
+}
+
 /* must be called with hw device and output stream mutexes locked */
 static int32_t StartAudioHwStreamOut(struct A2dpAudioHwStreamOut *out)
 {
@@ -303,39 +353,26 @@ static ssize_t A2dpStreamOutWrite(struct AudioHwStreamOut *stream, const void *b
         ret = StartAudioHwStreamOut(out);
         if (ret != 0) {
             HAL_AUDIO_ERROR("start stream_out fail");
-            goto exit;
+            rtos_mutex_give(out->lock);
+            return ret;
         }
     }
+    rtos_mutex_give(out->lock);
 
     if (bytes > (size_t)out->rb_size) {
         HAL_AUDIO_WARN("make sure write less than rb size once, please check A2dpGetStreamOutBufferSize's return value.");
     }
 
-    int32_t bytes_left = bytes;
-    while (bytes_left) {
-        if (ameba_audio_stream_buffer_get_available_size(out->rb) < (size_t)bytes_left) {
-            out->rb_sem_taken = true;
-            ret = rtos_sema_take(out->rb_sem, max_wait_ms);
-            out->rb_sem_taken = false;
-            if (ret < 0) {
-                //wait timeout
-                break;
-            }
-        }
-
-        int32_t written = ameba_audio_stream_buffer_write(out->rb, (int8_t *)buffer + bytes - bytes_left, bytes_left);
-        bytes_left -= written;
-    }
-
-    //write successfully
-    ret = bytes - bytes_left;
-    out->written += bytes / frame_size;
+    //the ring is lock free, the reader runs in parallel, only sleep when it is full.
+    //less than bytes if the reader stops for max_wait_ms.
+    ret = (int32_t)ameba_spsc_ring_write_wait(out->rb, buffer, bytes, out->rb_sem, &out->rb_waiting, max_wait_ms);
+    //the position calls take the lock too, written is shared with them.
+    rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+    out->written += ret / frame_size;
     //sync with ameba audio driver's total_counter_boundary max value.
     if (out->written > UINT64_MAX) {
         out->written = 0;
     }
-
-exit:
     rtos_mutex_give(out->lock);
 
     return ret;
@@ -347,8 +384,10 @@ void DestroyA2dpAudioHwStreamOut(struct AudioHwStreamOut *stream_out)
 
     A2dpStandbyStreamOut(&stream_out->common);
 
+    k_out = NULL;
+
     rtos_mutex_delete(out->lock);
-    ameba_audio_stream_buffer_release(out->rb);
+    ameba_spsc_ring_destroy(out->rb);
     rtos_sema_delete(out->rb_sem);
 
     rtos_mem_free(out);
@@ -380,6 +419,7 @@ struct AudioHwStreamOut *CreateA2dpAudioHwStreamOut(struct AudioHwCard *card, co
     out->stream.common.Standby = A2dpStandbyStreamOut;
     out->stream.common.Dump = A2dpDumpStreamOut;
     out->stream.common.SetParameters = A2dpSetStreamOutParameters;
+    out->stream.SetParameter = A2dpSetStreamOutParameter;
     out->stream.common.GetParameters = A2dpGetStreamOutParameters;
     out->stream.common.GetBufferStatus = A2dpGetStreamOutBufferStatus;
     out->stream.GetPresentationPosition = A2dpGetPresentationPosition;
@@ -414,16 +454,18 @@ struct AudioHwStreamOut *CreateA2dpAudioHwStreamOut(struct AudioHwCard *card, co
 
     rtos_mutex_create(&out->lock);
 
-    out->rb_size = 1024 * 20;
-    out->rb = ameba_audio_stream_buffer_create();
+    //lock free ring needs power of 2 size.
+    out->rb_size = 1024 * 16;
+    out->rb = ameba_spsc_ring_create(out->rb_size);
     if (!out->rb) {
         HAL_AUDIO_ERROR("ring buffer create fail");
+        rtos_mutex_delete(out->lock);
+        rtos_mem_free(out);
         return NULL;
     }
-    ameba_audio_stream_buffer_alloc(out->rb, out->rb_size);
 
     rtos_sema_create(&out->rb_sem, 0, RTOS_SEMA_MAX_COUNT);
-    out->rb_sem_taken = false;
+    out->rb_waiting = 0;
 
     k_out = out;
 
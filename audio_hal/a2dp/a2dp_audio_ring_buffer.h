@@ -16,6 +16,21 @@
 #ifndef AMEBA_AUDIO_AUDIO_HAL_A2DP_AUDIO_RING_BUFFER_H
 #define AMEBA_AUDIO_AUDIO_HAL_A2DP_AUDIO_RING_BUFFER_H
 
+/*
+ * copy bytes of pcm out, return 0 if there is not enough data.
+ */
 int32_t a2dp_hal_buffer_read(int8_t *buffer, int32_t bytes);
 
+/*
+ * zero copy read for the encoder: *buffer points to the pcm in the hal ring, return the
+ * contiguous bytes there, not more than bytes. When the return value is less than the
+ * data needed, the data wraps, commit and peek again, or use a2dp_hal_buffer_read.
+ */
+int32_t a2dp_hal_buffer_peek(int8_t **buffer, int32_t bytes);
+
+/*
+ * release bytes got from a2dp_hal_buffer_peek after encoding.
+ */
+int32_t a2dp_hal_buffer_commit(int32_t bytes);
+
 #endif
\ No newline at end of file
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "ameba.h"
 
 #include "ameba_audio_hw_usrcfg.h"
@@ -21,14 +23,174 @@
 #include "ameba_audio_stream_control.h"
 
 #include "audio_hw_osal_errnos.h"
+#include "ameba_audio_patch_manager.h"
 
 #include "ameba_audio_stream_audio_patch.h"
 
-static void ameba_audio_stream_audio_patch_rx_sport_init(struct AmebaAudioPatchConfig config)
+#define AUDIO_PATCH_SPORT_NUM               2
+/* the dmic path of the codec is wired to sport0. */
+#define AUDIO_PATCH_CODEC_IN_SPORT_INDEX    0
+
+static int32_t ameba_audio_stream_audio_patch_get_source_sport(int32_t device)
+{
+    switch (device) {
+    case AMEBA_AUDIO_IN_MIC:
+        return AUDIO_PATCH_CODEC_IN_SPORT_INDEX;
+    case AMEBA_AUDIO_IN_I2S:
+        return AUDIO_I2S_IN_SPORT_INDEX;
+    default:
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+}
+
+static int32_t ameba_audio_stream_audio_patch_get_sink_sport(int32_t device)
+{
+    switch (device) {
+    //the speaker is an external amp on the i2s out pins.
+    case AMEBA_AUDIO_DEVICE_SPEAKER:
+    case AMEBA_AUDIO_DEVICE_I2S:
+        return AUDIO_I2S_OUT_SPORT_INDEX;
+    default:
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+}
+
+static uint32_t ameba_audio_stream_audio_patch_get_sport_ip(uint32_t index)
+{
+    return index == 0 ? SPORT0 : SPORT1;
+}
+
+/*
+ * Sink channel n is taken from channel n of the sources laid one after another,
+ * so two mono sources make a stereo sink.
+ */
+static int32_t ameba_audio_stream_audio_patch_get_route(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
+                                                        int32_t num_sinks, struct AmebaAudioPatchConfig *sinks,
+                                                        int32_t *source_sports, int32_t *sink_sports,
+                                                        AudioPatchRoute *route)
+{
+    uint32_t source_channels = 0;
+
+    if (num_sources <= 0 || num_sources > AUDIO_PATCH_SPORT_NUM || num_sinks <= 0 || num_sinks > AUDIO_PATCH_SPORT_NUM) {
+        HAL_AUDIO_ERROR("unsupported patch, sources:%ld, sinks:%ld", num_sources, num_sinks);
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    memset(route, 0, sizeof(AudioPatchRoute));
+    route->rate = sources[0].sample_rate;
+    //sports run from the cpu pll, see ameba_audio_stream_audio_patch_clock_init.
+    route->pll = true;
+
+    for (int32_t i = 0; i < num_sources; i++) {
+        source_sports[i] = ameba_audio_stream_audio_patch_get_source_sport(sources[i].device);
+        if (source_sports[i] < 0) {
+            HAL_AUDIO_ERROR("unsupported source type:%ld", sources[i].device);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (route->rx_sports & AUDIO_PATCH_SPORT_BIT(source_sports[i])) {
+            HAL_AUDIO_ERROR("sources share rx sport %ld", source_sports[i]);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sources[i].sample_rate != route->rate) {
+            HAL_AUDIO_ERROR("direct patch can't convert rate %lu to %lu", sources[i].sample_rate, route->rate);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        route->rx_sports |= AUDIO_PATCH_SPORT_BIT(source_sports[i]);
+        route->codec_in |= sources[i].device == AMEBA_AUDIO_IN_MIC;
+        source_channels += sources[i].channel_count;
+    }
+
+    for (int32_t i = 0; i < num_sinks; i++) {
+        sink_sports[i] = ameba_audio_stream_audio_patch_get_sink_sport(sinks[i].device);
+        if (sink_sports[i] < 0) {
+            HAL_AUDIO_ERROR("unsupported sink type:%ld", sinks[i].device);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (route->tx_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) {
+            HAL_AUDIO_ERROR("sinks share tx sport %ld", sink_sports[i]);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sinks[i].sample_rate != route->rate) {
+            HAL_AUDIO_ERROR("direct patch can't convert rate %lu to %lu", route->rate, sinks[i].sample_rate);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sinks[i].channel_count > source_channels) {
+            HAL_AUDIO_ERROR("sink needs %lu channels, sources have %lu", sinks[i].channel_count, source_channels);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        route->tx_sports |= AUDIO_PATCH_SPORT_BIT(sink_sports[i]);
+    }
+
+    route->clk_sports = route->rx_sports | route->tx_sports;
+
+    return HAL_OSAL_OK;
+}
+
+static int32_t ameba_audio_stream_audio_patch_check_streams(const AudioPatchRoute *route)
+{
+    uint32_t patch_sports = ameba_audio_patch_manager_get_sports();
+
+    for (uint32_t i = 0; i < AUDIO_PATCH_SPORT_NUM; i++) {
+        if (((route->rx_sports | route->tx_sports) & AUDIO_PATCH_SPORT_BIT(i)) && !(patch_sports & AUDIO_PATCH_SPORT_BIT(i))
+            && ameba_audio_is_audio_ip_in_use(ameba_audio_stream_audio_patch_get_sport_ip(i))) {
+            HAL_AUDIO_ERROR("sport %lu is used by a stream", i);
+            return HAL_OSAL_ERR_ALREADY_EXISTS;
+        }
+    }
+
+    return HAL_OSAL_OK;
+}
+
+static void ameba_audio_stream_audio_patch_clock_init(const AudioPatchRoute *route, uint32_t held_sports)
+{
+    uint32_t sports = route->rx_sports | route->tx_sports;
+    /*0: 98.304M, 1: 45.1584M*/
+    uint32_t pll_clk = route->rate % 8000 == 0 ? 0 : 1;
+
+    /*
+     *for demo board, we need to provde MCLK to amp
+     *please set component/soc/amebadplus/usrcfg/ameba_bootcfg.c's Boot_SocClk_Info_Idx for pll.
+     *PLL_677P376M for 44.1k.
+     *PLL_688P128M for 48k.
+     */
+    //held sports already run at this rate for a running patch, the manager checked it, their
+    //mux, pll divider and mclk are left as they are.
+    sports &= ~held_sports;
+    if (sports & AUDIO_PATCH_SPORT_BIT(0)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, ENABLE);
+        //choose sys pll for sport 0.
+        RCC_PeriphClockSource_SPORT(AUDIO_SPORT0_DEV, CKSL_I2S_CPUPLL);
+        PLL_I2S0_CLK(ENABLE, pll_clk);
+    }
+    if (sports & AUDIO_PATCH_SPORT_BIT(1)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, ENABLE);
+        RCC_PeriphClockSource_SPORT(AUDIO_SPORT1_DEV, CKSL_I2S_CPUPLL);
+        PLL_I2S1_CLK(ENABLE, pll_clk);
+    }
+
+    if (!(held_sports & AUDIO_PATCH_SPORT_BIT(0))) {
+        if (route->rate % 8000 == 0) {
+            //0: sport 0 output, 1:NI, 8:MI
+            AUDIO_SP_SetMclkDiv(0, 1, 8);
+        } else {
+            //0: sport 0 output, 1:NI, 4:MI
+            AUDIO_SP_SetMclkDiv(0, 1, 4);
+        }
+    }
+
+    if (route->codec_in || (route->rx_sports & AUDIO_PATCH_SPORT_BIT(0))) {
+        RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, ENABLE);
+    }
+}
+
+static void ameba_audio_stream_audio_patch_rx_sport_init(uint32_t index, struct AmebaAudioPatchConfig config, bool shared)
 {
     SP_InitTypeDef SP_InitStruct;
 
-    AUDIO_SP_Reset(AUDIO_I2S_IN_SPORT_INDEX);
+    //shared: the other direction belongs to a running patch, a sport reset would stop it.
+    if (!shared) {
+        AUDIO_SP_Reset(index);
+    }
     AUDIO_SP_StructInit(&SP_InitStruct);
     SP_InitStruct.SP_SelDataFormat = AUDIO_I2S_IN_DATA_FORMAT;
     SP_InitStruct.SP_SelI2SMonoStereo = ameba_audio_get_channel(config.channel_count);
@@ -36,22 +198,23 @@ static void ameba_audio_stream_audio_patch_rx_sport_init(struct AmebaAudioPatchC
     SP_InitStruct.SP_SelTDM = ameba_audio_get_sp_tdm(config.channel_count);
     SP_InitStruct.SP_SelFIFO = ameba_audio_get_fifo_num(config.channel_count);
     SP_InitStruct.SP_SR = ameba_audio_get_sp_rate(config.sample_rate);
-#if AUDIO_I2S_IN_MULTIIO_EN
-    SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_EN;
-#else
     SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_DIS;
-#endif
-    AUDIO_SP_Init(AUDIO_I2S_IN_SPORT_INDEX, SP_DIR_RX, &SP_InitStruct);
+    if (config.device == AMEBA_AUDIO_IN_I2S && AUDIO_I2S_IN_MULTIIO_EN) {
+        SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_EN;
+    }
+    AUDIO_SP_Init(index, SP_DIR_RX, &SP_InitStruct);
 
-    HAL_AUDIO_INFO("rx sport %d init, %ld, %ld, %ld, %ld, %ld, %ld", AUDIO_I2S_IN_SPORT_INDEX,
+    HAL_AUDIO_INFO("rx sport %ld init, %ld, %ld, %ld, %ld, %ld, %ld", index,
                     SP_InitStruct.SP_SelDataFormat, SP_InitStruct.SP_SelI2SMonoStereo,
                     SP_InitStruct.SP_SelWordLen, SP_InitStruct.SP_SelTDM,
                     SP_InitStruct.SP_SelFIFO, SP_InitStruct.SP_SR);
 }
 
-static void ameba_audio_stream_audio_patch_tx_sport_init(struct AmebaAudioPatchConfig config)
+static void ameba_audio_stream_audio_patch_tx_sport_init(uint32_t index, struct AmebaAudioPatchConfig config, bool shared)
 {
-    AUDIO_SP_Reset(AUDIO_I2S_OUT_SPORT_INDEX);
+    if (!shared) {
+        AUDIO_SP_Reset(index);
+    }
     SP_InitTypeDef SP_InitStruct;
     AUDIO_SP_StructInit(&SP_InitStruct);
     SP_InitStruct.SP_SelDataFormat = AUDIO_I2S_OUT_DATA_FORMAT;
@@ -65,9 +228,9 @@ static void ameba_audio_stream_audio_patch_tx_sport_init(struct AmebaAudioPatchC
 #else
     SP_InitStruct.SP_SetMultiIO = SP_TX_MULTIIO_DIS;
 #endif
-    AUDIO_SP_Init(AUDIO_I2S_OUT_SPORT_INDEX, SP_DIR_TX, &SP_InitStruct);
+    AUDIO_SP_Init(index, SP_DIR_TX, &SP_InitStruct);
 
-    HAL_AUDIO_INFO("tx sport %d init, %ld, %ld, %ld, %ld, %ld, %ld", AUDIO_I2S_OUT_SPORT_INDEX,
+    HAL_AUDIO_INFO("tx sport %ld init, %ld, %ld, %ld, %ld, %ld, %ld", index,
                     SP_InitStruct.SP_SelDataFormat, SP_InitStruct.SP_SelI2SMonoStereo,
                     SP_InitStruct.SP_SelWordLen, SP_InitStruct.SP_SelTDM,
                     SP_InitStruct.SP_SelFIFO, SP_InitStruct.SP_SR);
@@ -92,113 +255,159 @@ static void ameba_audio_stream_audio_patch_codec_init(struct AmebaAudioPatchConf
     AUDIO_CODEC_SetADCVolume(ADC2, 0x00);
 }
 
-int32_t ameba_audio_stream_create_audio_patch(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
-                                              int32_t num_sinks, struct AmebaAudioPatchConfig *sinks)
+static void ameba_audio_stream_audio_patch_set_direct_regs(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
+                                                           int32_t *source_sports, uint32_t sink_sport,
+                                                           uint32_t sink_channels)
 {
-    /*FIXME: suport more indexs*/
-    int patch_index = 0;
+    int32_t source = 0;
+    uint32_t source_channel = 0;
 
-    if (num_sources > 1) {
-        HAL_AUDIO_ERROR("only support one source for patch.");
-        return HAL_OSAL_ERR_INVALID_PARAM;
-    }
+    for (uint32_t i = 0; i < sink_channels; i ++) {
+        while (source < num_sources && source_channel >= sources[source].channel_count) {
+            source++;
+            source_channel = 0;
+        }
 
-    /*FIXME: to support more sinks.*/
-    if (num_sinks > 1) {
-        HAL_AUDIO_ERROR("only support one sink for patch.");
-        return HAL_OSAL_ERR_INVALID_PARAM;
-    }
+        /*I2S TX data from DIRECT_REG_N*/
+        AUDIO_SP_TXCHNSrcSel(sink_sport, ameba_audio_stream_get_sp_tx_channel_idx(i), DIRECT_REG_CHN);
 
-    HAL_AUDIO_INFO("source:%lx, sink:%lx", sources[0].device, sinks[0].device);
+        /*enable sport DIRECT_REG_N*/
+        AUDIO_SP_TXSetDirectRegStart(sink_sport, ameba_audio_stream_get_direct_reg_idx(i), ENABLE);
 
-    /*
-     *for demo board, we need to provde MCLK to amp
-     *please set component/soc/amebadplus/usrcfg/ameba_bootcfg.c's Boot_SocClk_Info_Idx for pll.
-     *PLL_677P376M for 44.1k.
-     *PLL_688P128M for 48k.
-     */
-    RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, ENABLE);
-    //choose sys pll for sport 0.
-    RCC_PeriphClockSource_SPORT(AUDIO_SPORT0_DEV, CKSL_I2S_CPUPLL);
-    RCC_PeriphClockSource_SPORT(AUDIO_SPORT1_DEV, CKSL_I2S_CPUPLL);
-
-    if (sinks[0].sample_rate % 8000 == 0) {
-        //0: sport 0 output, 1:NI, 8:MI
-        AUDIO_SP_SetMclkDiv(0, 1, 8);
-        //0: 98.304M, enable 98.304M
-        PLL_I2S0_CLK(ENABLE, 0);
-    } else {
-        //0: sport 0 output, 1:NI, 4:MI
-        AUDIO_SP_SetMclkDiv(0, 1, 4);
-        //1: 45.1584M, enable 45.1584M
-        PLL_I2S0_CLK(ENABLE, 1);
+        /*DIRECT_IN_N->DIRECT_REG_N, DIRECT_IN_N and DIRECT_OUT_N are the same for one sport.*/
+        AUDIO_SP_TXDirectRegSel(sink_sport, source_sports[source], ameba_audio_stream_get_direct_reg_idx(i),
+                                ameba_audio_stream_get_direct_in_channel_idx(source_channel));
+        source_channel++;
     }
+}
 
-    ameba_audio_stream_audio_patch_rx_sport_init(sources[0]);
-
-    if ((sources[0].device) == AMEBA_AUDIO_IN_MIC) {
-        ameba_audio_stream_audio_patch_codec_init(sources[0]);
+int32_t ameba_audio_stream_create_audio_patch(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
+                                              int32_t num_sinks, struct AmebaAudioPatchConfig *sinks)
+{
+    int32_t source_sports[AUDIO_PATCH_SPORT_NUM];
+    int32_t sink_sports[AUDIO_PATCH_SPORT_NUM];
+    AudioPatchRoute route;
+    uint32_t held_sports;
+    int32_t patch_index;
+    int32_t ret;
+
+    ret = ameba_audio_stream_audio_patch_get_route(num_sources, sources, num_sinks, sinks,
+                                                   source_sports, sink_sports, &route);
+    if (ret != HAL_OSAL_OK) {
+        return ret;
     }
 
-    if ((sources[0].device) == AMEBA_AUDIO_IN_I2S) {
-        ameba_audio_stream_rx_set_i2s_pin(AUDIO_I2S_IN_SPORT_INDEX);
-        AUDIO_SP_SetMasterSlave(AUDIO_I2S_IN_SPORT_INDEX, SLAVE);
-        RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, ENABLE);
-        if (AUDIO_I2S_IN_SPORT_INDEX == 0)
-            AUDIO_CODEC_SetI2SSRC(I2S0, EXTERNAL_I2S);
+    ret = ameba_audio_stream_audio_patch_check_streams(&route);
+    if (ret != HAL_OSAL_OK) {
+        return ret;
     }
 
-    AUDIO_SP_RXStart(AUDIO_I2S_IN_SPORT_INDEX, ENABLE);
-
-    if (sinks[0].device == AMEBA_AUDIO_DEVICE_SPEAKER) {
-        ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state, false);
+    //sports running patches hold, the manager lets this patch take their other direction.
+    held_sports = ameba_audio_patch_manager_get_sports();
+    patch_index = ameba_audio_patch_manager_add(&route);
+    if (patch_index < 0) {
+        return patch_index;
     }
 
-    ameba_audio_stream_tx_set_i2s_pin(AUDIO_I2S_OUT_SPORT_INDEX);
-
-    for (uint32_t i = 0; i < sources[0].channel_count; i ++) {
-        /*enable DIRECT_OUT_N*/
-        AUDIO_SP_RXSetDirectOutStart(AUDIO_I2S_IN_SPORT_INDEX,
-                                     ameba_audio_stream_get_direct_out_channel_idx(i), ENABLE);
+    ameba_audio_stream_audio_patch_clock_init(&route, held_sports);
+
+    for (int32_t i = 0; i < num_sources; i++) {
+        HAL_AUDIO_INFO("patch %ld source:%lx, sport:%ld", patch_index, sources[i].device, source_sports[i]);
+        ameba_audio_stream_audio_patch_rx_sport_init(source_sports[i], sources[i],
+                                                    (held_sports & AUDIO_PATCH_SPORT_BIT(source_sports[i])) != 0);
+
+        if ((sources[i].device) == AMEBA_AUDIO_IN_MIC) {
+            HAL_AUDIO_INFO("source mic");
+            ameba_audio_stream_audio_patch_codec_init(sources[i]);
+            ameba_audio_set_audio_ip_use_status(STREAM_IN, CODEC, true);
+        }
+
+        if ((sources[i].device) == AMEBA_AUDIO_IN_I2S) {
+            HAL_AUDIO_INFO("source i2s");
+            ameba_audio_stream_rx_set_i2s_pin(source_sports[i]);
+            HAL_AUDIO_INFO("set I2S IN slave");
+            AUDIO_SP_SetMasterSlave(source_sports[i], SLAVE);
+            if (source_sports[i] == 0)
+                AUDIO_CODEC_SetI2SSRC(I2S0, EXTERNAL_I2S);
+        }
+
+        AUDIO_SP_RXStart(source_sports[i], ENABLE);
+
+        for (uint32_t j = 0; j < sources[i].channel_count; j ++) {
+            /*enable DIRECT_OUT_N*/
+            AUDIO_SP_RXSetDirectOutStart(source_sports[i], ameba_audio_stream_get_direct_out_channel_idx(j), ENABLE);
+        }
+        ameba_audio_set_audio_ip_use_status(STREAM_IN, ameba_audio_stream_audio_patch_get_sport_ip(source_sports[i]), true);
     }
 
-    ameba_audio_stream_audio_patch_tx_sport_init(sinks[0]);
+    for (int32_t i = 0; i < num_sinks; i++) {
+        HAL_AUDIO_INFO("patch %ld sink:%lx, sport:%ld", patch_index, sinks[i].device, sink_sports[i]);
+        if (sinks[i].device == AMEBA_AUDIO_DEVICE_SPEAKER) {
+            ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state, false);
+        }
 
-    /*direct mode enable*/
-    AUDIO_SP_SetDirectOutMode(AUDIO_I2S_IN_SPORT_INDEX, AUDIO_I2S_OUT_SPORT_INDEX);
+        ameba_audio_stream_tx_set_i2s_pin(sink_sports[i]);
+        ameba_audio_stream_audio_patch_tx_sport_init(sink_sports[i], sinks[i],
+                                                         (held_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) != 0);
 
-    for (uint32_t i = 0; i < sinks[0].channel_count; i ++) {
-        /*I2S TX data from DIRECT_REG_N*/
-        AUDIO_SP_TXCHNSrcSel(AUDIO_I2S_OUT_SPORT_INDEX,
-                             ameba_audio_stream_get_sp_tx_channel_idx(i), DIRECT_REG_CHN);
+        /*direct mode enable*/
+        for (int32_t j = 0; j < num_sources; j++) {
+            AUDIO_SP_SetDirectOutMode(source_sports[j], sink_sports[i]);
+        }
 
-        /*enable sport DIRECT_REG_N*/
-        AUDIO_SP_TXSetDirectRegStart(AUDIO_I2S_OUT_SPORT_INDEX,
-                                     ameba_audio_stream_get_direct_reg_idx(i), ENABLE);
+        ameba_audio_stream_audio_patch_set_direct_regs(num_sources, sources, source_sports, sink_sports[i],
+                                                        sinks[i].channel_count);
 
-        /*DIRECT_IN_N->DIRECT_REG_N, DIRECT_IN_N and DIRECT_OUT_N are the same for one sport.*/
-        AUDIO_SP_TXDirectRegSel(AUDIO_I2S_OUT_SPORT_INDEX, AUDIO_I2S_IN_SPORT_INDEX,
-          ameba_audio_stream_get_direct_reg_idx(i), ameba_audio_stream_get_direct_in_channel_idx(i));
+        AUDIO_SP_TXStart(sink_sports[i], ENABLE);
+        ameba_audio_set_audio_ip_use_status(STREAM_OUT, ameba_audio_stream_audio_patch_get_sport_ip(sink_sports[i]), true);
     }
 
-    AUDIO_SP_TXStart(AUDIO_I2S_OUT_SPORT_INDEX, ENABLE);
-
     return patch_index;
 
 }
 
 int32_t ameba_audio_stream_release_audio_patch(int32_t patch_index)
 {
-    HAL_AUDIO_INFO("release patch %ld\n", patch_index);
-    AUDIO_SP_TXStart(AUDIO_I2S_OUT_SPORT_INDEX, DISABLE);
-    AUDIO_SP_Deinit(AUDIO_I2S_OUT_SPORT_INDEX, SP_DIR_TX);
-    AUDIO_SP_TXStart(AUDIO_I2S_IN_SPORT_INDEX, DISABLE);
-    AUDIO_SP_Deinit(AUDIO_I2S_IN_SPORT_INDEX, SP_DIR_RX);
-
-    RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, DISABLE);
+    AudioPatchRoute route;
+    int32_t ret;
+
+    ret = ameba_audio_patch_manager_get(patch_index, &route);
+    if (ret != HAL_OSAL_OK) {
+        HAL_AUDIO_ERROR("no patch %ld", patch_index);
+        return ret;
+    }
+
+    HAL_AUDIO_INFO("release patch %ld", patch_index);
+    for (uint32_t i = 0; i < AUDIO_PATCH_SPORT_NUM; i++) {
+        if (route.tx_sports & AUDIO_PATCH_SPORT_BIT(i)) {
+            AUDIO_SP_TXStart(i, DISABLE);
+            AUDIO_SP_Deinit(i, SP_DIR_TX);
+            ameba_audio_set_audio_ip_use_status(STREAM_OUT, ameba_audio_stream_audio_patch_get_sport_ip(i), false);
+        }
+        if (route.rx_sports & AUDIO_PATCH_SPORT_BIT(i)) {
+            AUDIO_SP_RXStart(i, DISABLE);
+            AUDIO_SP_Deinit(i, SP_DIR_RX);
+            ameba_audio_set_audio_ip_use_status(STREAM_IN, ameba_audio_stream_audio_patch_get_sport_ip(i), false);
+        }
+    }
+
+    if (route.codec_in) {
+        ameba_audio_set_audio_ip_use_status(STREAM_IN, CODEC, false);
+    }
+
+    ameba_audio_patch_manager_remove(patch_index);
+
+    //other patches and streams keep their clocks.
+    if (!ameba_audio_is_audio_ip_in_use(SPORT0)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_is_audio_ip_in_use(SPORT1)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_patch_manager_get_sports() && !ameba_audio_is_audio_ip_in_use(CODEC)
+        && !ameba_audio_is_audio_ip_in_use(POWER)) {
+        RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, DISABLE);
+    }
 
     return HAL_OSAL_OK;
 }
@@ -324,7 +324,7 @@ int32_t ameba_audio_ctl_set_adc_volume(StreamControl *control, uint32_t adc_num,
 	}
 
 	if (adc_num >= MAX_AD_NUM) {
-		HAL_AUDIO_ERROR("ops, adc_num(%lu) out of range", adc_num);
+		HAL_AUDIO_ERROR("ops, adc_num(%" PRIu32 ") out of range", adc_num);
 		return HAL_OSAL_ERR_INVALID_OPERATION;
 	}
 
@@ -355,7 +355,7 @@ int32_t ameba_audio_ctl_set_tdm_adc_volume(StreamControl *control, uint32_t chan
 	}
 
 	if (channels > MAX_AD_NUM) {
-		HAL_AUDIO_ERROR("ops, channels(%lu) out of range", channels);
+		HAL_AUDIO_ERROR("ops, channels(%" PRIu32 ") out of range", channels);
 		return HAL_OSAL_ERR_INVALID_OPERATION;
 	}
 
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <inttypes.h>
+
 #include "basic_types.h"
 
 #include "ameba.h"
@@ -262,7 +264,7 @@ int32_t ameba_audio_stream_get_mic_idx(uint32_t mic_category)
 		mic_num = DMIC2;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %ld not supported", mic_category);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %" PRId32 " not supported", mic_category);
 		break;
 	}
 
@@ -280,7 +282,7 @@ int32_t ameba_audio_stream_get_adc_chn_idx(uint32_t index)
 		adc_chn = ADCHN2;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %" PRId32 " not supported", index);
 		break;
 	}
 
@@ -298,7 +300,7 @@ int32_t ameba_audio_stream_get_adc_idx(uint32_t index)
 		adc_num = ADC2;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %" PRId32 " not supported", index);
 		break;
 	}
 
@@ -309,84 +311,84 @@ void ameba_audio_dump_gdma_regs(u8 GDMA_ChNum)
 {
 	GDMA_TypeDef *GDMA = ((GDMA_TypeDef *)GDMA_BASE);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%lx", GDMA_ChNum, GDMA->ChEnReg);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%" PRIx32 "", GDMA_ChNum, GDMA->ChEnReg);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%lx", GDMA_ChNum, GDMA->MASK_TFR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%lx", GDMA_ChNum, GDMA->MASK_BLOCK);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%lx", GDMA_ChNum, GDMA->MASK_ERR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%lx", GDMA_ChNum, GDMA->STATUS_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_TFR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_ERR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%" PRIx32 "", GDMA_ChNum, GDMA->STATUS_BLOCK);
 
 }
 
 void ameba_audio_dump_sport_regs(uint32_t SPORTx)
 {
 	uint32_t tmp;
-	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)SPORTx;
+	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)(uintptr_t)SPORTx;
 	HAL_AUDIO_DUMP_INFO("dump sportx:0x%p", sportx);
 	tmp = sportx->SP_REG_MUX;
-	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%" PRIx32 "", tmp);
 	tmp = sportx->SP_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%" PRIx32 "", tmp);
 	tmp = sportx->SP_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_INT_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD0;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TRX_COUNTER_STATUS;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%" PRIx32 "", tmp);
 	tmp = sportx->SP_ERR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_SR_TX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FIFO_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FORMAT;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DSP_COUNTER;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD1;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD2;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FIFO_IRQ;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD3;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL3;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL4;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_COUNTER1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_COUNTER2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_FIFO_0_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_FIFO_0_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_FIFO_1_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_FIFO_1_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%" PRIx32 "", tmp);
 
 }
 
@@ -405,7 +407,7 @@ AUDIO_SPORT_TypeDef *ameba_audio_get_sport_addr(uint32_t index)
 		addr = AUDIO_SPORT1_DEV;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		addr = NULL;
 		break;
 	}
@@ -423,7 +425,7 @@ int32_t ameba_audio_get_sport_irq(uint32_t index)
 		irq = SPORT1_IRQ;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		break;
 	}
 	return irq;
@@ -756,7 +758,7 @@ int32_t ameba_audio_stream_get_direct_out_channel_idx(uint32_t channel)
 		direct_out_channel = DIRECT_OUT_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct out:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct out:%" PRId32 "", channel);
 		break;
 	}
 
@@ -793,7 +795,7 @@ int32_t ameba_audio_stream_get_direct_in_channel_idx(uint32_t channel)
 		direct_in_channel = DIRECT_IN_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct in:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct in:%" PRId32 "", channel);
 		break;
 	}
 
@@ -830,7 +832,7 @@ int32_t ameba_audio_stream_get_direct_reg_idx(uint32_t channel)
 		direct_reg = DIRECT_REG_7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
@@ -867,7 +869,7 @@ int32_t ameba_audio_stream_get_sp_tx_channel_idx(uint32_t channel)
 		sp_tx_channel = TXCHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
@@ -22,6 +22,7 @@
 #include "ameba_audio_stream_capture.h"
 #include "ameba_audio_stream_control.h"
 
+#include "audio_hw_channel_utils.h"
 #include "audio_hw_compat.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_osal_errnos.h"
@@ -36,17 +37,6 @@
 #define NOIRQ_CAPTURE_PERIOD_SIZE     128
 #define CAPTURE_PERIOD_SIZE           1024
 #define CAPTURE_PERIOD_COUNT          4
-#define AUDIO_CAPTURE_MODE            "cap_mode"
-#define MIC_CATEGORY                  "mic_category"
-// channels of pure data
-#define PURE_DATA                     "no_afe_pure_data"
-// for debug (mic,mic,..ref,out), only out buffer not filled by audio fwk
-#define ALL_DATA                      "no_afe_all_data"
-#define REF_CHANNEL                   "ref_channel"
-//0 master, 1 slave
-#define MASTER_SLAVE                  "master_slave"
-// I2S:0, Left justified:1, pcm_a:2, pcm_b:3.
-#define CAPTURE_DATA_FORMAT           "data_format"
 #define PURE_DATA_DUMP                0
 #define DUMP_FRAME                    48000
 
@@ -232,53 +222,80 @@ static int32_t PrimaryDumpStreamIn(const struct AudioHwStream *stream, int32_t f
 	return HAL_OSAL_OK;
 }
 
-static int32_t PrimarySetStreamInParameters(struct AudioHwStream *stream, const char *str_pairs)
+static int32_t PrimarySetStreamInParameter(struct AudioHwStreamIn *stream, enum AudioHwParamKey key, int32_t value)
 {
-	HAL_AUDIO_VERBOSE("%s, keys = %s", __FUNCTION__, str_pairs);
 	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
-	struct string_cell *cells;
-	cells = string_cells_create_from_str(str_pairs);
-	int32_t value;
-	char string_value[15];
 
-	if (string_cells_has_key(cells, REF_CHANNEL)) {
-		string_cells_get_int(cells, REF_CHANNEL, &value);
+	switch (key) {
+	case AUDIO_HW_PARAM_REF_CHANNEL:
 		cap->channel_for_ref = value;
-	}
-
-	if (string_cells_has_key(cells, MIC_CATEGORY)) {
-		string_cells_get_int(cells, MIC_CATEGORY, &value);
+		break;
+	case AUDIO_HW_PARAM_MIC_CATEGORY:
 		cap->mic_category = value;
-	}
-
-	HAL_AUDIO_VERBOSE("check key AUDIO_CAPTURE_MODE");
-	if (string_cells_has_key(cells, AUDIO_CAPTURE_MODE)) {
-		string_cells_get_str(cells, AUDIO_CAPTURE_MODE, string_value, 15);
-		if (!strncmp(string_value, PURE_DATA, 14)) {
+		break;
+	case AUDIO_HW_PARAM_CAP_MODE:
+		if (value == AUDIO_HW_CAPTURE_NO_AFE_PURE_DATA) {
 			HAL_AUDIO_VERBOSE("mode:PURE DATA");
 			cap->mode = CAPTURE_PURE_DATA;
 		}
-	}
-
-	if (string_cells_has_key(cells, MASTER_SLAVE)) {
-		string_cells_get_int(cells, MASTER_SLAVE, &value);
+		break;
+	case AUDIO_HW_PARAM_MASTER_SLAVE:
 		cap->master_slave = value;
+		break;
+	case AUDIO_HW_PARAM_DATA_FORMAT:
+		cap->data_format = value;
+		break;
+	default:
+		HAL_AUDIO_VERBOSE("key:%d not supported", key);
+		return HAL_OSAL_ERR_INVALID_PARAM;
 	}
 
-	if (string_cells_has_key(cells, CAPTURE_DATA_FORMAT)) {
-		string_cells_get_int(cells, CAPTURE_DATA_FORMAT, &value);
-		cap->data_format = value;
+	return HAL_OSAL_OK;
+}
+
+static int32_t PrimarySetStreamInParameters(struct AudioHwStream *stream, const char *str_pairs)
+{
+	HAL_AUDIO_VERBOSE("%s, keys = %s", __FUNCTION__, str_pairs);
+	struct audio_hw_params params;
+
+	audio_hw_params_parse(str_pairs, &params);
+	for (int32_t key = 0; key < AUDIO_HW_PARAM_MAX; key++) {
+		if (audio_hw_params_has(&params, key)) {
+			PrimarySetStreamInParameter((struct AudioHwStreamIn *)stream, key, params.values[key]);
+		}
 	}
 
-	string_cells_destroy(cells);
 	return HAL_OSAL_OK;
 }
 
-static char *PrimaryGetStreamInParameters(const struct AudioHwStream *stream,
-		const char *keys)
+static int32_t PrimaryGetStreamInStats(const struct AudioHwStreamIn *stream, struct AudioHwStreamStats *stats)
 {
-	(void) stream;
-	(void) keys;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+	int32_t ret = HAL_OSAL_OK;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->in_pcm) {
+		ameba_audio_stream_stats_get(&cap->in_pcm->stats, stats);
+	} else {
+		memset(stats, 0, sizeof(*stats));
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
+static char *PrimaryGetStreamInParameters(const struct AudioHwStream *stream, const char *keys)
+{
+	struct AudioHwStreamStats stats;
+	char str[AMEBA_AUDIO_STREAM_STATS_STR_LEN];
+
+	if (keys && !strcmp(keys, AMEBA_AUDIO_STREAM_STATS_KEY)) {
+		PrimaryGetStreamInStats((const struct AudioHwStreamIn *)stream, &stats);
+		ameba_audio_stream_stats_to_str(&stats, str, sizeof(str));
+		return (char *)strdup(str);
+	}
+
 	return (char *)strdup("");
 }
 
@@ -453,16 +470,10 @@ static int32_t StartAudioHwStreamIn(struct PrimaryAudioHwStreamIn *cap)
 static ssize_t PureDataRead(struct AudioHwStreamIn *stream, void *buffer, size_t bytes, uint32_t time_out_ms)
 {
 	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
-	uint32_t i = 0;
 	size_t app_frame_size = PrimaryAudioHwStreamInFrameSize((const struct AudioHwStreamIn *)stream);
 	size_t driver_frame_size = app_frame_size * cap->config.channels / cap->requested_channels;
-	size_t driver_frame_size_extra;
 	uint32_t frames = bytes / app_frame_size;
 
-	if (cap->requested_channels >= 10) {
-		driver_frame_size_extra = app_frame_size * cap->config_extra.channels / cap->requested_channels;
-	}
-
 	if (cap->requested_channels == 3) {
 		uint32_t driver_bytes = bytes * cap->config.channels / cap->requested_channels;   // *4chan/3chan
 		if (driver_bytes > cap->cap_stream_buf_bytes)  {
@@ -472,17 +483,8 @@ static ssize_t PureDataRead(struct AudioHwStreamIn *stream, void *buffer, size_t
 		HAL_AUDIO_VERBOSE("read bytes:%u, driver_bytes:%lu", bytes, driver_bytes);
 		int32_t ret = ameba_audio_stream_rx_read(cap->in_pcm, cap->stream_buf, driver_bytes, time_out_ms);
 		if (ret > 0) {
-			for (i = 0; i < driver_bytes / driver_frame_size; i++) {
-				if (cap->config.format == AUDIO_HW_FORMAT_PCM_16_BIT) {
-					*((uint16_t *)buffer + cap->requested_channels * i) = *((uint16_t *)cap->stream_buf + cap->config.channels * i);
-					*((uint16_t *)buffer + cap->requested_channels * i + 1) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 1);
-					*((uint16_t *)buffer + cap->requested_channels * i + 2) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 2);
-				} else if (cap->config.format == AUDIO_HW_FORMAT_PCM_32_BIT || cap->config.format == AUDIO_HW_FORMAT_PCM_8_24_BIT) {
-					*((uint32_t *)buffer + cap->requested_channels * i) = *((uint32_t *)cap->stream_buf + cap->config.channels * i);
-					*((uint32_t *)buffer + cap->requested_channels * i + 1) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 1);
-					*((uint32_t *)buffer + cap->requested_channels * i + 2) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 2);
-				}
-			}
+			audio_hw_channel_drop(buffer, cap->requested_channels, cap->stream_buf, cap->config.channels,
+								  driver_bytes / driver_frame_size, GetAudioBytesPerSample(cap->config.format));
 		} else {
 			return ret;
 		}
@@ -503,21 +505,12 @@ static ssize_t PureDataRead(struct AudioHwStreamIn *stream, void *buffer, size_t
 		int32_t ret = ameba_audio_stream_rx_read(cap->in_pcm, cap->stream_buf, driver_bytes, time_out_ms);
 		int32_t ret_extra = ameba_audio_stream_rx_read(cap->in_pcm_extra, cap->stream_buf_extra, driver_bytes_extra, time_out_ms);
 
-		if (ret > 0) {
-			for (i = 0; i < frames; i++) {
-				memcpy((uint8_t *)buffer + i * app_frame_size, (uint8_t *)cap->stream_buf + i * driver_frame_size, driver_frame_size);
-			}
-		} else {
+		if (ret <= 0 || ret_extra <= 0) {
 			return ret;
 		}
 
-		if (ret_extra > 0) {
-			for (i = 0; i < frames; i++) {
-				memcpy((uint8_t *)buffer + i * app_frame_size + driver_frame_size, (uint8_t *)cap->stream_buf_extra + i * driver_frame_size_extra, driver_frame_size_extra);
-			}
-		} else {
-			return ret;
-		}
+		audio_hw_channel_interleave(buffer, cap->stream_buf, cap->config.channels, cap->stream_buf_extra, cap->config_extra.channels,
+									frames, GetAudioBytesPerSample(cap->config.format));
 
 	} else {
 		int32_t ret = ameba_audio_stream_rx_read(cap->in_pcm, buffer, bytes, time_out_ms);
@@ -608,6 +601,56 @@ exit:
 	return ret;
 }
 
+static ssize_t PrimaryStreamInAcquireBuffer(struct AudioHwStreamIn *stream, void **buffer, size_t bytes, uint32_t time_out_ms)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->standby) {
+		ret = StartAudioHwStreamIn(cap);
+		if (ret == 0) {
+			cap->standby = 0;
+		} else {
+			HAL_AUDIO_ERROR("start audio stream_in fail");
+			goto exit;
+		}
+	}
+
+	//the channels are converted by hal in other cases, use read instead.
+	if (cap->mode != CAPTURE_PURE_DATA || cap->config.channels != cap->requested_channels) {
+		ret = HAL_OSAL_ERR_INVALID_OPERATION;
+		goto exit;
+	}
+
+	ret = ameba_audio_stream_rx_acquire_region(cap->in_pcm, buffer, bytes, time_out_ms);
+
+exit:
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
+static ssize_t PrimaryStreamInCommitBuffer(struct AudioHwStreamIn *stream, size_t bytes)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->in_pcm) {
+		ret = ameba_audio_stream_rx_commit_region(cap->in_pcm, bytes);
+	} else {
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+
+	if (ret >= 0) {
+		cap->rframe += ret / PrimaryAudioHwStreamInFrameSize(stream);
+	}
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
 static int32_t CheckInputParameters(uint32_t sample_rate, enum AudioHwFormat format, uint32_t channel_count)
 {
 	switch (format) {
@@ -747,6 +790,10 @@ struct AudioHwStreamIn *CreateAudioHwStreamIn(struct AudioHwCard *card, const st
 	in->stream.GetTriggerTime = PrimaryGetTriggerTime;
 	in->stream.Read = PrimaryStreamInRead;
 	in->stream.ReadTimeout = PrimaryStreamInReadTimeout;
+	in->stream.AcquireBuffer = PrimaryStreamInAcquireBuffer;
+	in->stream.CommitBuffer = PrimaryStreamInCommitBuffer;
+	in->stream.SetParameter = PrimarySetStreamInParameter;
+	in->stream.GetStats = PrimaryGetStreamInStats;
 
 	in->config = stream_input_config;
 	in->config_extra = stream_input_config_extra;
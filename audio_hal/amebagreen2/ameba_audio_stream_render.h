@@ -36,6 +36,8 @@ void ameba_audio_stream_tx_start(Stream *stream, int32_t state);
 void ameba_audio_stream_tx_stop(Stream *stream, int32_t state);
 int32_t ameba_audio_stream_tx_get_buffer_status(Stream *stream);
 int32_t  ameba_audio_stream_tx_write(Stream *stream, const void *data, uint32_t bytes, bool block);
+int32_t  ameba_audio_stream_tx_acquire_region(Stream *stream, void **region, uint32_t bytes);
+int32_t  ameba_audio_stream_tx_commit_region(Stream *stream, uint32_t bytes);
 void ameba_audio_stream_tx_buffer_flush(Stream *stream);
 void ameba_audio_stream_tx_standby(Stream *stream);
 void ameba_audio_stream_tx_close(Stream *stream);
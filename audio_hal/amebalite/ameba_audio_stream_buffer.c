@@ -33,6 +33,9 @@ AudioBuffer *ameba_audio_stream_buffer_create(void)
 	buffer->size_remain = 0;
 	buffer->capacity = 0;
 	buffer->raw_data = NULL;
+	buffer->dirty_start = 0;
+	buffer->dirty_bytes = 0;
+	buffer->cache_defer = false;
 	return buffer;
 }
 
@@ -86,40 +89,8 @@ void ameba_audio_stream_buffer_flush(AudioBuffer *buffer)
 	buffer->read_ptr = 0;
 	buffer->write_ptr = 0;
 	buffer->size_remain = 0;
-}
-
-/*write to buffer by hal*/
-size_t ameba_audio_stream_buffer_write_in_noirq_mode(AudioBuffer *buffer, const void *data, size_t bytes, uint32_t period_bytes)
-{
-	if (bytes == 0 || buffer->capacity == 0) {
-		return 0;
-	}
-
-	size_t capacity = buffer->capacity;
-	size_t bytes_to_write = bytes;
-	size_t tx_addr;
-
-	if (bytes_to_write <= capacity - buffer->write_ptr) {
-		tx_addr = (size_t)buffer->raw_data + buffer->write_ptr;
-		memcpy(buffer->raw_data + buffer->write_ptr, (u8 *)data, bytes_to_write);
-		DCache_CleanInvalidate((uint32_t)tx_addr, (period_bytes + CACHE_LINE_SIZE));
-		buffer->write_ptr += bytes_to_write;
-		if (buffer->write_ptr == capacity) {
-			buffer->write_ptr = 0;
-		}
-	} else {
-		size_t size_1 = capacity - buffer->write_ptr;
-		tx_addr = (size_t)buffer->raw_data + buffer->write_ptr;
-		memcpy(buffer->raw_data + buffer->write_ptr, (u8 *)data, size_1);
-		size_t size_2 = bytes_to_write - size_1;
-		memcpy(buffer->raw_data, (u8 *)data + size_1, size_2);
-		DCache_CleanInvalidate((uint32_t)buffer->raw_data, ((uint32_t)capacity + CACHE_LINE_SIZE));
-		buffer->write_ptr = size_2;
-	}
-
-	buffer->size_remain += bytes_to_write;
-
-	return bytes_to_write;
+	buffer->dirty_start = 0;
+	buffer->dirty_bytes = 0;
 }
 
 /*write to buffer by hal*/
@@ -224,7 +195,7 @@ size_t ameba_audio_stream_buffer_read(AudioBuffer *buffer, void *data, size_t by
 
 	if (bytes_to_read <= capacity - buffer->read_ptr) {
 		/*must add cache clean invalidate here. otherwize buf read may remain dirty.*/
-		DCache_CleanInvalidate((uint32_t)buffer->raw_data + (uint32_t)buffer->read_ptr, bytes_to_read);
+		DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data + (uint32_t)buffer->read_ptr, bytes_to_read);
 		memcpy(data, buffer->raw_data + buffer->read_ptr, bytes_to_read);
 		buffer->read_ptr += bytes_to_read;
 		if (buffer->read_ptr == capacity) {
@@ -233,10 +204,10 @@ size_t ameba_audio_stream_buffer_read(AudioBuffer *buffer, void *data, size_t by
 	} else {
 		size_t size_1 = capacity - buffer->read_ptr;
 		/*must add cache clean invalidate here. otherwize buf read may remain dirty.*/
-		DCache_CleanInvalidate((uint32_t)buffer->raw_data + (uint32_t)buffer->read_ptr, size_1);
+		DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data + (uint32_t)buffer->read_ptr, size_1);
 		memcpy((u8 *)data, buffer->raw_data + buffer->read_ptr, size_1);
 		size_t size_2 = bytes_to_read - size_1;
-		DCache_CleanInvalidate((uint32_t)buffer->raw_data, size_2);
+		DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data, size_2);
 		memcpy((u8 *)data + size_1, buffer->raw_data, size_2);
 		buffer->read_ptr = size_2;
 	}
@@ -251,3 +222,91 @@ size_t ameba_audio_stream_buffer_get_rx_writeptr(AudioBuffer *buffer)
 	return buffer->write_ptr;
 }
 
+/*
+ * zero copy access of the ring, the region returned is inside raw_data and stops at the
+ * wrap point, so it may be shorter than the free space or data in the ring.
+ * for tx, the caller fills the region and commits it, gdma takes it from there.
+ * for rx, the caller processes the data in place and commits it to free the space.
+ * like write and read, the caller should mask gdma irq if gdma is running.
+ */
+size_t ameba_audio_stream_buffer_acquire_write_region(AudioBuffer *buffer, void **region, size_t bytes)
+{
+	if (bytes == 0 || buffer->size_remain >= buffer->capacity || buffer->capacity == 0) {
+		return 0;
+	}
+
+	size_t free_bytes = buffer->capacity - buffer->size_remain;
+	size_t contiguous = buffer->capacity - buffer->write_ptr;
+	size_t bytes_to_write = (bytes <= free_bytes) ? bytes : free_bytes;
+	if (bytes_to_write > contiguous) {
+		bytes_to_write = contiguous;
+	}
+
+	*region = buffer->raw_data + buffer->write_ptr;
+
+	return bytes_to_write;
+}
+
+size_t ameba_audio_stream_buffer_commit_write(AudioBuffer *buffer, size_t bytes)
+{
+	if (bytes == 0 || buffer->capacity == 0) {
+		return 0;
+	}
+
+	size_t bytes_to_write = (bytes <= buffer->capacity - buffer->size_remain) ? bytes : buffer->capacity - buffer->size_remain;
+	if (bytes_to_write > buffer->capacity - buffer->write_ptr) {
+		bytes_to_write = buffer->capacity - buffer->write_ptr;
+	}
+
+	buffer->write_ptr += bytes_to_write;
+	if (buffer->write_ptr == buffer->capacity) {
+		buffer->write_ptr = 0;
+	}
+	buffer->size_remain += bytes_to_write;
+
+	HAL_AUDIO_PVERBOSE("after commit write,rp:%d,wp:%d,bytes_to_write:%d,size_remain:%d", buffer->read_ptr, buffer->write_ptr, bytes_to_write,
+					   buffer->size_remain);
+
+	return bytes_to_write;
+}
+
+size_t ameba_audio_stream_buffer_acquire_read_region(AudioBuffer *buffer, void **region, size_t bytes)
+{
+	if (bytes == 0 || buffer->size_remain == 0 || buffer->capacity == 0) {
+		return 0;
+	}
+
+	size_t contiguous = buffer->capacity - buffer->read_ptr;
+	size_t bytes_to_read = (bytes <= buffer->size_remain) ? bytes : buffer->size_remain;
+	if (bytes_to_read > contiguous) {
+		bytes_to_read = contiguous;
+	}
+
+	/*must add cache clean invalidate here. otherwize buf read may remain dirty.*/
+	DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data + (uint32_t)buffer->read_ptr, bytes_to_read);
+	*region = buffer->raw_data + buffer->read_ptr;
+
+	return bytes_to_read;
+}
+
+size_t ameba_audio_stream_buffer_commit_read(AudioBuffer *buffer, size_t bytes)
+{
+	if (bytes == 0 || buffer->capacity == 0) {
+		return 0;
+	}
+
+	size_t bytes_to_read = (bytes <= buffer->size_remain) ? bytes : buffer->size_remain;
+	if (bytes_to_read > buffer->capacity - buffer->read_ptr) {
+		bytes_to_read = buffer->capacity - buffer->read_ptr;
+	}
+
+	buffer->read_ptr += bytes_to_read;
+	if (buffer->read_ptr == buffer->capacity) {
+		buffer->read_ptr = 0;
+	}
+	buffer->size_remain -= bytes_to_read;
+
+	HAL_AUDIO_CVERBOSE("after commit read,rp:%u,wp:%u, buffer->size_remain:%u", buffer->read_ptr, buffer->write_ptr, buffer->size_remain);
+
+	return bytes_to_read;
+}
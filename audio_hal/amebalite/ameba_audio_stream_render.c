@@ -21,9 +21,11 @@
 #include "ameba_audio_stream_control.h"
 #include "ameba_audio_stream_utils.h"
 #include "ameba_audio_stream_buffer.h"
+#include "ameba_audio_isr_trace.h"
 #include "ameba_audio_types.h"
 #include "ameba_audio_hw_usrcfg.h"
 
+#include "audio_hw_channel_utils.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_osal_errnos.h"
 
@@ -219,7 +221,7 @@ static void ameba_audo_stream_tx_codec_configure(uint32_t i2s, uint32_t type, I2
 	AUDIO_CODEC_EnableDACFifo(ENABLE);
 	AUDIO_CODEC_SetDACHPF(DAC_L, ENABLE);
 	AUDIO_CODEC_SetDACMute(DAC_L, ameba_audio_get_ctl()->tx_state);
-	AUDIO_CODEC_SetDACSrc(i2s, I2SL, NULL);
+	AUDIO_CODEC_SetDACSrc(i2s, I2SL, 0);
 
 	//5V power supply, the gain is set to 0X86 by default, otherwise clipping;
 	//12V power supply, the maximum gain can be set to 0x96, otherwise clipping
@@ -280,7 +282,7 @@ static void ameba_audio_stream_tx_sport_init(RenderStream **stream, StreamConfig
 	rstream->stream.sp_initstruct.SP_SelClk = CKSL_I2S_CPUPLL;
 #endif
 
-	HAL_AUDIO_VERBOSE("selmo:%lu, wordlen:%lu, sr:%lu, seltdm:%lu, selfifo:%lu,",
+	HAL_AUDIO_VERBOSE("selmo:%" PRIu32 ", wordlen:%" PRIu32 ", sr:%" PRIu32 ", seltdm:%" PRIu32 ", selfifo:%" PRIu32 ",",
 					  rstream->stream.sp_initstruct.SP_SelI2SMonoStereo,
 					  rstream->stream.sp_initstruct.SP_SelWordLen,
 					  rstream->stream.sp_initstruct.SP_SR,
@@ -320,14 +322,14 @@ static void ameba_audio_stream_tx_llp_init(Stream *stream)
 	HAL_AUDIO_INFO("ameba_audio_stream_tx_llp_init, period_count: %" PRId32 ", frame_size: %" PRId32 "", rstream->stream.period_count, rstream->stream.frame_size);
 
 	uint32_t j;
-	uint32_t tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data);
+	uint32_t tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data);
 
-	for (j = 0; j < rstream->stream.period_count; j++) {
-
-		DCache_CleanInvalidate(((uint32_t)tx_addr + j * rstream->stream.period_bytes), (rstream->stream.period_bytes + CACHE_LINE_SIZE));
+	//the ring is contiguous, one clean for all the periods.
+	DCache_Clean(tx_addr, rstream->stream.period_bytes * rstream->stream.period_count);
 
+	for (j = 0; j < rstream->stream.period_count; j++) {
 		ch_lli[j].LliEle.Sarx = (uint32_t)tx_addr + j * rstream->stream.period_bytes;
-		HAL_AUDIO_VERBOSE("ameba_audio_stream_tx_llp_init, addr: %x", ch_lli[j].LliEle.Sarx);
+		HAL_AUDIO_VERBOSE("ameba_audio_stream_tx_llp_init, addr: %" PRIx32 "", ch_lli[j].LliEle.Sarx);
 
 		if (j == rstream->stream.period_count - 1) {
 			ch_lli[j].pNextLli = &ch_lli[0];
@@ -337,7 +339,7 @@ static void ameba_audio_stream_tx_llp_init(Stream *stream)
 
 		//ch_lli[j].BlockSize = rstream->stream.period_bytes >> 2;
 		ch_lli[j].BlockSize = rstream->stream.period_bytes / rstream->stream.frame_size;
-		ch_lli[j].LliEle.Darx = (uint32_t)&AUDIO_DEV_TABLE[0].SPORTx->SP_TX_FIFO_0_WR_ADDR;
+		ch_lli[j].LliEle.Darx = (uint32_t)(uintptr_t)&AUDIO_DEV_TABLE[0].SPORTx->SP_TX_FIFO_0_WR_ADDR;
 	}
 }
 
@@ -482,13 +484,15 @@ Stream *ameba_audio_stream_tx_init(uint32_t device, StreamConfig config)
 
 	if (rstream->stream.stream_mode == AMEBA_AUDIO_DMA_NOIRQ_MODE) {
 		ameba_audio_stream_tx_llp_init(&rstream->stream);
+		//gdma runs the ring by itself, clean the written lines once per period instead of per write.
+		ameba_audio_stream_buffer_set_cache_defer(rstream->stream.rbuffer, true);
 	}
 
 	//enable sport interrupt
 	uint32_t irq = ameba_audio_get_sport_irq(rstream->stream.sport_dev_num);
 	InterruptDis(irq);
 	InterruptUnRegister(irq);
-	InterruptRegister((IRQ_FUN)ameba_audio_stream_tx_sport_interrupt, irq, (uint32_t)rstream, 4);
+	InterruptRegister((IRQ_FUN)ameba_audio_stream_tx_sport_interrupt, irq, (uint32_t)(uintptr_t)rstream, 4);
 	InterruptEn(irq, 4);
 
 	rstream->stream.state = STATE_INITED;
@@ -545,7 +549,7 @@ int32_t ameba_audio_stream_tx_get_buffer_status(Stream *stream)
 	uint32_t remain = 0;
 
 	if (rstream->stream.stream_mode == AMEBA_AUDIO_DMA_NOIRQ_MODE) {
-		uint32_t wr = (uint32_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
+		uint32_t wr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
 		uint32_t capacity = rstream->stream.rbuffer->capacity;
 		uint32_t dma_addr = GDMA_GetSrcAddr(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum);
 		remain = (wr < dma_addr) ? (capacity - (dma_addr - wr)) : (wr - dma_addr);
@@ -708,8 +712,7 @@ void ameba_audio_stream_tx_standby(Stream *stream)
 	ameba_audio_stream_tx_stop(stream, STATE_STANDBY);
 }
 
-//gdma done moving one period size data IRQ. Data is gdma_cb_data
-uint32_t ameba_audio_stream_tx_complete(void *data)
+static uint32_t ameba_audio_stream_tx_period_done(void *data, AudioIsrTraceEntry *trace)
 {
 	uint32_t tx_addr;
 	uint32_t tx_length;
@@ -728,8 +731,10 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 		tx_length = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
 		ameba_audio_stream_buffer_update_tx_readptr(rstream->stream.rbuffer, tx_length);
 		rstream->stream.gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer);
 
 		if (rstream->stream.sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(rstream->stream.sem_gdma_end);
 			return 0;
 		}
@@ -738,25 +743,30 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 			ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) < tx_length) {
 			rstream->stream.multi_dma_xrun_mask |= DMA_XRUN;
 			if (rstream->stream.extra_channel && ((rstream->stream.multi_dma_xrun_mask & EXTRA_DMA_XRUN) == 0)) {
+				trace->action = AUDIO_ISR_TRACE_WAIT_PEER;
 				return 0;
 			}
-			DiagPrintf("underrun \n");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
+			ameba_audio_stream_stats_xrun(&rstream->stream.stats);
 			ameba_audio_stream_tx_stop(gdata->stream, STATE_XRUN);
 		} else {
-			tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
 			AUDIO_SP_TXGDMA_Restart(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum, tx_addr, tx_length);
 			rstream->stream.gdma_cnt++;
 		}
 
 		if (rstream->stream.sem_need_post) {
 			rtos_sema_give(rstream->stream.sem);
+			trace->sem_posted = 1;
 		}
 	} else if (gdata->gdma_id == 1) {
 		extra_tx_length = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
 		ameba_audio_stream_buffer_update_tx_readptr(rstream->stream.extra_rbuffer, extra_tx_length);
 		rstream->stream.extra_gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(rstream->stream.extra_rbuffer);
 
 		if (rstream->stream.extra_sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(rstream->stream.extra_sem_gdma_end);
 			return 0;
 		}
@@ -765,24 +775,40 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 			ameba_audio_stream_buffer_get_remain_size(rstream->stream.extra_rbuffer) < extra_tx_length) {
 			rstream->stream.multi_dma_xrun_mask |= EXTRA_DMA_XRUN;
 			if ((rstream->stream.multi_dma_xrun_mask & DMA_XRUN) == 0) {
+				trace->action = AUDIO_ISR_TRACE_WAIT_PEER;
 				return 0;
 			}
-			DiagPrintf("extra underrun \n");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
+			ameba_audio_stream_stats_xrun(&rstream->stream.stats);
 			ameba_audio_stream_tx_stop(gdata->stream, STATE_XRUN);
 		} else {
-			extra_tx_addr = (uint32_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+			extra_tx_addr = (uint32_t)(uintptr_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
 			AUDIO_SP_TXGDMA_Restart(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_tx_length);
 			rstream->stream.extra_gdma_cnt++;
 		}
 
 		if (rstream->stream.extra_sem_need_post) {
 			rtos_sema_give(rstream->stream.extra_sem);
+			trace->sem_posted = 1;
 		}
 	}
 
 	return 0;
 }
 
+//gdma done moving one period size data IRQ. Data is gdma_cb_data
+uint32_t ameba_audio_stream_tx_complete(void *data)
+{
+	GdmaCallbackData *gdata = (GdmaCallbackData *) data;
+	uint64_t enter_us = ameba_audio_stream_stats_isr_enter();
+	AudioIsrTraceEntry *trace = ameba_audio_isr_trace_begin(STREAM_OUT, gdata->gdma_id);
+	uint32_t ret = ameba_audio_stream_tx_period_done(data, trace);
+
+	ameba_audio_isr_trace_end(trace);
+	ameba_audio_stream_stats_isr_exit(&gdata->stream->stats, enter_us);
+	return ret;
+}
+
 static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
 	uint32_t bytes_left_to_write = bytes;
@@ -793,7 +819,7 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 
 	while (bytes_left_to_write != 0) {
 		if (rstream->stream.start_gdma) {
-			uint32_t wr = (uint32_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
+			uint32_t wr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
 			uint32_t capacity = rstream->stream.rbuffer->capacity;
 			uint32_t dma_addr = GDMA_GetSrcAddr(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum);
 			uint32_t avail = (wr < dma_addr) ? (dma_addr - wr) : (capacity - (wr - dma_addr));
@@ -804,6 +830,10 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 				bytes_written = ameba_audio_stream_buffer_write_in_noirq_mode(rstream->stream.rbuffer, (u8 *)data + bytes - bytes_left_to_write, bytes_left_to_write,
 								rstream->stream.period_bytes);
 				rstream->total_written_from_tx_start += bytes_written / rstream->stream.config.frame_size;
+				//gdma is less than two periods behind, it may reach this period before it ends.
+				if (capacity - avail + bytes_written < 2 * rstream->stream.period_bytes) {
+					ameba_audio_stream_buffer_sync_cache(rstream->stream.rbuffer);
+				}
 			} else if (!block) { // non-block mode
 				HAL_AUDIO_INFO("stream_tx_write no buffer available in non-block mode\n");
 				return bytes - bytes_left_to_write;
@@ -819,6 +849,8 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 							   ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer));
 			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) >= rstream->stream.period_bytes) {
 
+				//lines still dirty in defer mode must reach memory before gdma reads them.
+				ameba_audio_stream_buffer_sync_cache(rstream->stream.rbuffer);
 				AUDIO_SP_LLPTXGDMA_Init(rstream->stream.sport_dev_num, GDMA_INT, sp_txgdma_initstruct, rstream->stream.gdma_struct,
 										(IRQ_FUN)NULL,
 										rstream->stream.period_bytes, rstream->stream.period_count, rstream->stream.gdma_ch_lli);
@@ -836,6 +868,71 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 	return bytes;
 }
 
+/*start or restart gdma once there is enough data in the ring, gdma irq should be masked.*/
+static void ameba_audio_stream_tx_check_and_start_gdma(Stream *stream, bool has_extra_dma)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+
+	uint32_t tx_addr;
+	PGDMA_InitTypeDef sp_txgdma_initstruct = &(rstream->stream.gdma_struct->u.SpTxGdmaInitStruct);
+	uint32_t dma_len = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
+
+	uint32_t extra_tx_addr = 0;
+	PGDMA_InitTypeDef extra_sp_txgdma_initstruct = &(rstream->stream.extra_gdma_struct->u.SpTxGdmaInitStruct);
+	uint32_t extra_dma_len = 0;
+
+	if (has_extra_dma) {
+		extra_dma_len = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
+	}
+
+	if (rstream->stream.state == STATE_INITED) {
+		if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			AUDIO_SP_TXGDMA_Init(rstream->stream.sport_dev_num, GDMA_INT, sp_txgdma_initstruct, rstream->stream.gdma_struct,
+								 (IRQ_FUN)ameba_audio_stream_tx_complete, (u8 *)(uintptr_t)tx_addr, dma_len);
+			rstream->stream.gdma_cnt++;
+			HAL_AUDIO_INFO("gdma init: index:%d, chNum:%d, tx_addr:0x%" PRIx32 ", dma_len:%" PRIu32 "",
+						   sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
+
+			if (has_extra_dma) {
+				extra_tx_addr = (uint32_t)(uintptr_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+				AUDIO_SP_TXGDMA_Init(rstream->stream.sport_dev_num, GDMA_EXT, extra_sp_txgdma_initstruct, rstream->stream.extra_gdma_struct,
+									 (IRQ_FUN)ameba_audio_stream_tx_complete, (u8 *)(uintptr_t)extra_tx_addr, extra_dma_len);
+				rstream->stream.extra_gdma_cnt++;
+				HAL_AUDIO_INFO("gdma extra init: index:%d, chNum:%d, tx_addr:0x%" PRIx32 ", extra_dma_len:%" PRIu32 "",
+							   extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
+			}
+			rstream->stream.start_gdma = true;
+
+			ameba_audio_stream_tx_start(stream, STATE_STARTED);
+
+#if HAL_AUDIO_PLAYBACK_DUMP_DEBUG
+			ameba_audio_dump_gdma_regs(sp_txgdma_initstruct->GDMA_ChNum);
+			ameba_audio_dump_sport_regs(SPORT0_REG_BASE);
+			ameba_audio_dump_codec_regs();
+#endif
+		}
+	}
+
+	if (rstream->stream.state == STATE_XRUN_NOTIFIED || rstream->stream.state == STATE_XRUN  || rstream->stream.state == STATE_STANDBY) {
+		if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			HAL_AUDIO_VERBOSE("restart gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			rstream->stream.multi_dma_xrun_mask = 0;
+			AUDIO_SP_TXGDMA_Restart(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
+			rstream->stream.gdma_cnt++;
+
+			if (has_extra_dma) {
+				extra_tx_addr = (uint32_t)(uintptr_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+				HAL_AUDIO_VERBOSE("restart extra gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+				AUDIO_SP_TXGDMA_Restart(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
+				rstream->stream.extra_gdma_cnt++;
+			}
+			ameba_audio_stream_tx_start(stream, STATE_STARTED);
+		}
+	}
+}
+
 static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
 	RenderStream *rstream = (RenderStream *)stream;
@@ -844,14 +941,10 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 	uint32_t total_bytes = bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
 	uint32_t bytes_left_to_write = total_bytes;
 	uint32_t bytes_written = 0;
-	uint32_t tx_addr;
-	PGDMA_InitTypeDef sp_txgdma_initstruct = &(rstream->stream.gdma_struct->u.SpTxGdmaInitStruct);
 
 	uint32_t extra_total_bytes = 0;
 	uint32_t extra_bytes_left_to_write = 0;
 	uint32_t extra_bytes_written = 0;
-	uint32_t extra_tx_addr;
-	PGDMA_InitTypeDef extra_sp_txgdma_initstruct = &(rstream->stream.extra_gdma_struct->u.SpTxGdmaInitStruct);
 
 	char *p_buf = NULL;
 	char *p_extra_buf = NULL;
@@ -876,9 +969,9 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 
 	if (AUDIO_OUT_DEBUG_BUFFER_LEVEL == 1) {
 		if (rstream->write_cnt % 100 == 0) {
-			HAL_AUDIO_DEBUG("wr cnt:%llu, remain:%dbytes, avail:%dbytes",
-							rstream->write_cnt, ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer),
-							ameba_audio_stream_buffer_get_available_size(rstream->stream.rbuffer));
+			HAL_AUDIO_DEBUG("wr cnt:%" PRIu64 ", remain:%" PRIu32 "bytes, avail:%" PRIu32 "bytes",
+							rstream->write_cnt, (uint32_t)ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer),
+							(uint32_t)ameba_audio_stream_buffer_get_available_size(rstream->stream.rbuffer));
 		}
 	}
 
@@ -892,12 +985,8 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 		p_buf = (char *)rtos_mem_calloc(total_bytes, sizeof(char));
 		p_extra_buf = (char *)rtos_mem_calloc(extra_total_bytes, sizeof(char));
 
-		uint32_t idx = 0;
-		for (; idx < bytes / rstream->stream.config.frame_size; idx++) {
-			memcpy(p_buf + idx * rstream->stream.frame_size, (char *)data + idx * rstream->stream.config.frame_size, rstream->stream.frame_size);
-			memcpy(p_extra_buf + idx * rstream->stream.extra_frame_size, (char *)data + idx * rstream->stream.config.frame_size + rstream->stream.frame_size,
-				   rstream->stream.extra_frame_size);
-		}
+		audio_hw_channel_deinterleave(p_buf, rstream->stream.channel, p_extra_buf, rstream->stream.extra_channel,
+									  data, bytes / rstream->stream.config.frame_size, rstream->stream.frame_size / rstream->stream.channel);
 	} else {
 		p_buf = (char *)data;
 	}
@@ -909,61 +998,12 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 		bytes_written = ameba_audio_stream_buffer_write(rstream->stream.rbuffer, (u8 *)p_buf + total_bytes - bytes_left_to_write, bytes_left_to_write);
 		rstream->total_written_from_tx_start += bytes_written / rstream->stream.frame_size;
 
-		uint32_t dma_len = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
-		uint32_t extra_dma_len = 0;
-
 		if (has_extra_dma) {
 			extra_bytes_written = ameba_audio_stream_buffer_write(rstream->stream.extra_rbuffer, (u8 *)p_extra_buf + extra_total_bytes - extra_bytes_left_to_write,
 								  extra_bytes_left_to_write);
-			extra_dma_len = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
-		}
-
-		if (rstream->stream.state == STATE_INITED) {
-			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
-				tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
-				AUDIO_SP_TXGDMA_Init(rstream->stream.sport_dev_num, GDMA_INT, sp_txgdma_initstruct, rstream->stream.gdma_struct,
-									 (IRQ_FUN)ameba_audio_stream_tx_complete, (u8 *)tx_addr, dma_len);
-				rstream->stream.gdma_cnt++;
-				HAL_AUDIO_INFO("gdma init: index:%d, chNum:%d, tx_addr:0x%lx, dma_len:%lu",
-							   sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
-
-				if (has_extra_dma) {
-					extra_tx_addr = (uint32_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
-					AUDIO_SP_TXGDMA_Init(rstream->stream.sport_dev_num, GDMA_EXT, extra_sp_txgdma_initstruct, rstream->stream.extra_gdma_struct,
-										 (IRQ_FUN)ameba_audio_stream_tx_complete, (u8 *)extra_tx_addr, extra_dma_len);
-					rstream->stream.extra_gdma_cnt++;
-					HAL_AUDIO_INFO("gdma extra init: index:%d, chNum:%d, tx_addr:0x%lx, extra_dma_len:%lu",
-								   extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
-				}
-				rstream->stream.start_gdma = true;
-
-				ameba_audio_stream_tx_start(stream, STATE_STARTED);
-
-#if HAL_AUDIO_PLAYBACK_DUMP_DEBUG
-				ameba_audio_dump_gdma_regs(sp_txgdma_initstruct->GDMA_ChNum);
-				ameba_audio_dump_sport_regs(SPORT0_REG_BASE);
-				ameba_audio_dump_codec_regs();
-#endif
-			}
 		}
 
-		if (rstream->stream.state == STATE_XRUN_NOTIFIED || rstream->stream.state == STATE_XRUN  || rstream->stream.state == STATE_STANDBY) {
-			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
-				tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
-				HAL_AUDIO_VERBOSE("restart gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
-				rstream->stream.multi_dma_xrun_mask = 0;
-				AUDIO_SP_TXGDMA_Restart(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
-				rstream->stream.gdma_cnt++;
-
-				if (has_extra_dma) {
-					extra_tx_addr = (uint32_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
-					HAL_AUDIO_VERBOSE("restart extra gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
-					AUDIO_SP_TXGDMA_Restart(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
-					rstream->stream.extra_gdma_cnt++;
-				}
-				ameba_audio_stream_tx_start(stream, STATE_STARTED);
-			}
-		}
+		ameba_audio_stream_tx_check_and_start_gdma(stream, has_extra_dma);
 
 		bytes_left_to_write -= bytes_written;
 
@@ -973,7 +1013,7 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 				ameba_audio_stream_tx_unmask_gdma_irq(stream);
 			}
 
-			int32_t sem_ret = rtos_sema_take(rstream->stream.sem, sem_timeout);
+			int32_t sem_ret = ameba_audio_stream_stats_sema_take(&rstream->stream.stats, rstream->stream.sem, sem_timeout);
 			if (sem_ret < 0) {
 				break;
 			}
@@ -989,7 +1029,7 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 					ameba_audio_stream_tx_unmask_gdma_irq(stream);
 				}
 
-				int32_t sem_ret = rtos_sema_take(rstream->stream.extra_sem, sem_timeout);
+				int32_t sem_ret = ameba_audio_stream_stats_sema_take(&rstream->stream.stats, rstream->stream.extra_sem, sem_timeout);
 				if (sem_ret < 0) {
 					break;
 				}
@@ -1027,15 +1067,78 @@ int64_t ameba_audio_stream_tx_get_frames_written(Stream *stream)
 
 int32_t ameba_audio_stream_tx_write(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
+	int32_t ret = 0;
+
 	if (stream) {
 		if (stream->stream_mode) {
-			return ameba_audio_stream_tx_write_in_noirq_mode(stream, data, bytes, block);
+			ret = ameba_audio_stream_tx_write_in_noirq_mode(stream, data, bytes, block);
 		} else {
-			return ameba_audio_stream_tx_write_in_irq_mode(stream, data, bytes, block);
+			ameba_audio_stream_stats_fill(&stream->stats, ameba_audio_stream_buffer_get_remain_size(stream->rbuffer));
+			ret = ameba_audio_stream_tx_write_in_irq_mode(stream, data, bytes, block);
+		}
+		if (ret > 0) {
+			stream->stats.bytes += ret;
 		}
 	}
 
-	return 0;
+	return ret;
+}
+
+int32_t ameba_audio_stream_tx_acquire_region(Stream *stream, void **region, uint32_t bytes)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+	uint32_t size;
+
+	if (!stream || !region) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	//noirq mode and the fifo0/fifo1 split of 6/8 channels need hal to copy the data.
+	if (rstream->stream.stream_mode || rstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	ameba_audio_stream_tx_mask_gdma_irq(stream);
+
+	if (rstream->stream.state == STATE_XRUN) {
+		rstream->stream.state = STATE_XRUN_NOTIFIED;
+		ameba_audio_stream_tx_unmask_gdma_irq(stream);
+		return HAL_OSAL_ERR_DEAD_OBJECT;
+	}
+
+	size = ameba_audio_stream_buffer_acquire_write_region(rstream->stream.rbuffer, region, bytes - bytes % rstream->stream.frame_size);
+	size -= size % rstream->stream.frame_size;
+
+	ameba_audio_stream_tx_unmask_gdma_irq(stream);
+
+	return size;
+}
+
+int32_t ameba_audio_stream_tx_commit_region(Stream *stream, uint32_t bytes)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+
+	if (!stream) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	if (rstream->stream.stream_mode || rstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	ameba_audio_stream_tx_mask_gdma_irq(stream);
+
+	bytes = ameba_audio_stream_buffer_commit_write(rstream->stream.rbuffer, bytes);
+	rstream->total_written_from_tx_start += bytes / rstream->stream.frame_size;
+	rstream->write_cnt++;
+
+	ameba_audio_stream_tx_check_and_start_gdma(stream, false);
+
+	ameba_audio_stream_tx_unmask_gdma_irq(stream);
+
+	rstream->stream.stats.bytes += bytes;
+
+	return bytes;
 }
 
 void ameba_audio_stream_tx_close(Stream *stream)
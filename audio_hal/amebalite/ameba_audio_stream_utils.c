@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <inttypes.h>
+
 #include "basic_types.h"
 
 #include "ameba.h"
@@ -282,7 +284,7 @@ int32_t ameba_audio_stream_get_mic_idx(uint32_t mic_category)
 		mic_num = DMIC4;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %ld not supported", mic_category);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %" PRId32 " not supported", mic_category);
 		return HAL_OSAL_ERR_INVALID_PARAM;
 	}
 
@@ -306,7 +308,7 @@ int32_t ameba_audio_stream_get_adc_chn_idx(uint32_t index)
 		adc_chn = ADCHN4;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %" PRId32 " not supported", index);
 		adc_chn = HAL_OSAL_ERR_INVALID_PARAM;
 		break;
 	}
@@ -331,7 +333,7 @@ int32_t ameba_audio_stream_get_adc_idx(uint32_t index)
 		adc_num = ADC4;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %" PRId32 " not supported", index);
 		adc_num = HAL_OSAL_ERR_INVALID_PARAM;
 		break;
 	}
@@ -343,83 +345,83 @@ void ameba_audio_dump_gdma_regs(u8 GDMA_ChNum)
 {
 	GDMA_TypeDef *GDMA = ((GDMA_TypeDef *) GDMA_BASE);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%lx\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%lx\r\n", GDMA_ChNum, GDMA->ChEnReg);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->ChEnReg);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%lx\r\n", GDMA_ChNum, GDMA->MASK_TFR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%lx\r\n", GDMA_ChNum, GDMA->MASK_BLOCK);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%lx\r\n", GDMA_ChNum, GDMA->MASK_ERR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%lx\r\n", GDMA_ChNum, GDMA->STATUS_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->MASK_TFR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->MASK_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->MASK_ERR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%" PRIx32 "\r\n", GDMA_ChNum, GDMA->STATUS_BLOCK);
 
 }
 
 void ameba_audio_dump_sport_regs(uint32_t SPORTx)
 {
 	uint32_t tmp;
-	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)SPORTx;
+	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)(uintptr_t)SPORTx;
 	tmp = sportx->SP_REG_MUX;
-	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_INT_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%" PRIx32 " \n", tmp);
 	tmp = sportx->RSVD0;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_TRX_COUNTER_STATUS;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_ERR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_SR_TX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_TX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_FIFO_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_FORMAT;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DSP_COUNTER;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%" PRIx32 " \n", tmp);
 	tmp = sportx->RSVD1;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DIRECT_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%" PRIx32 " \n", tmp);
 	tmp = sportx->RSVD2;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_FIFO_IRQ;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DIRECT_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DIRECT_CTRL2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%" PRIx32 " \n", tmp);
 	tmp = sportx->RSVD3;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DIRECT_CTRL3;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_DIRECT_CTRL4;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_COUNTER1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_COUNTER2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_TX_FIFO_0_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_FIFO_0_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_TX_FIFO_1_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%" PRIx32 " \n", tmp);
 	tmp = sportx->SP_RX_FIFO_1_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%" PRIx32 " \n", tmp);
 
 }
 
@@ -434,63 +436,63 @@ void ameba_audio_dump_codec_regs(void)
 	}
 
 	tmp = g_audio_analog->AUD_ADDA_CTL;
-	HAL_AUDIO_DUMP_INFO("ADDA_CTL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("ADDA_CTL:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_LO_CTL;
-	HAL_AUDIO_DUMP_INFO("LO_CTL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("LO_CTL:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MICBIAS_CTL0;
-	HAL_AUDIO_DUMP_INFO("MICBIAS_CTL0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBIAS_CTL0:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MICBST_CTL0;
-	HAL_AUDIO_DUMP_INFO("MICBST_CTL0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBST_CTL0:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MICBST_CTL1;
-	HAL_AUDIO_DUMP_INFO("MICBST_CTL1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBST_CTL1:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->RSVD0;
-	HAL_AUDIO_DUMP_INFO("ANALOG_RSVD0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("ANALOG_RSVD0:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_DTS_CTL;
-	HAL_AUDIO_DUMP_INFO("DTS_CTL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("DTS_CTL:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL0;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL0:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL1;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL1:%" PRIx32 " \n", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL2;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL2:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL2:%" PRIx32 " \n", tmp);
 
 	/***digital reg dump***/
 	tmp = audio_base->CODEC_AUDIO_CONTROL_0;
-	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_0:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_AUDIO_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_1:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_2;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_3;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_4;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_4:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_4:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_5;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_6;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_7;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_I2S_0_CONTROL;
-	HAL_AUDIO_DUMP_INFO("CODEC_I2S_0_CONTROL:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_I2S_0_CONTROL:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_I2S_0_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_I2S_0_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_I2S_0_CONTROL_1:%" PRIx32 " \n", tmp);
 
 	for (uint32_t i = 0; i < MAX_AD_NUM; i++) {
 		tmp = audio_base->CODEC_ADC_CH_CTRL[i].CODEC_ADC_x_CONTROL_0;
-		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%lu_CONTROL_0:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%" PRIu32 "_CONTROL_0:%" PRIx32 "", i, tmp);
 		tmp = audio_base->CODEC_ADC_CH_CTRL[i].CODEC_ADC_x_CONTROL_1;
-		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%lu_CONTROL_1:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%" PRIu32 "_CONTROL_1:%" PRIx32 "", i, tmp);
 	}
 
 	tmp = audio_base->CODEC_DAC_L_CONTROL_0;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_0:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_0:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_DAC_L_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_1:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_1:%" PRIx32 " \n", tmp);
 	tmp = audio_base->CODEC_DAC_L_CONTROL_2;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_2:%lx \n", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_2:%" PRIx32 " \n", tmp);
 
 }
 
@@ -510,7 +512,7 @@ AUDIO_SPORT_TypeDef *ameba_audio_get_sport_addr(uint32_t index)
 		addr = AUDIO_SPORT1_DEV;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		addr = NULL;
 		break;
 	}
@@ -528,7 +530,7 @@ int32_t ameba_audio_get_sport_irq(uint32_t index)
 		irq = SPORT1_IRQ;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		irq = HAL_OSAL_ERR_INVALID_PARAM;
 		break;
 	}
@@ -597,7 +599,7 @@ int32_t ameba_audio_stream_get_direct_out_channel_idx(uint32_t channel)
 		direct_out_channel = DIRECT_OUT_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct out:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct out:%" PRId32 "", channel);
 		break;
 	}
 
@@ -634,7 +636,7 @@ int32_t ameba_audio_stream_get_direct_in_channel_idx(uint32_t channel)
 		direct_in_channel = DIRECT_IN_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct in:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct in:%" PRId32 "", channel);
 		break;
 	}
 
@@ -671,7 +673,7 @@ int32_t ameba_audio_stream_get_direct_reg_idx(uint32_t channel)
 		direct_reg = DIRECT_REG_7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
@@ -708,7 +710,7 @@ int32_t ameba_audio_stream_get_sp_tx_channel_idx(uint32_t channel)
 		sp_tx_channel = TXCHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
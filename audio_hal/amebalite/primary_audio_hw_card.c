@@ -122,6 +122,11 @@ static int32_t PrimaryCreateAudioPatch(struct AudioHwCard *card,
 											int32_t num_sinks, struct AudioHwPatchConfig *sinks)
 {
 	(void) card;
+	if (num_sources <= 0 || num_sinks <= 0 || !sources || !sinks) {
+		HAL_AUDIO_ERROR("patch needs sources and sinks");
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
 	struct AmebaAudioPatchConfig ameba_sources[num_sources];
 	struct AmebaAudioPatchConfig ameba_sinks[num_sinks];
 	for (int32_t i = 0; i < num_sources; i++) {
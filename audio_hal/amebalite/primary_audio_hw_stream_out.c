@@ -26,6 +26,7 @@
 #include "audio_hw_debug.h"
 #include "audio_hw_mix.h"
 #include "audio_hw_params_handle.h"
+#include "ameba_audio_drift.h"
 
 #include "hardware/audio/audio_hw_types.h"
 #include "hardware/audio/audio_hw_utils.h"
@@ -33,12 +34,14 @@
 
 #include "primary_audio_hw_card.h"
 
+#ifdef AUDIO_HW_AEC
+#include "ameba_audio_aec.h"
+#endif
+
 #define DEFAULT_OUT_SAMPLING_RATE 16000
 #define NOIRQ_SHORT_PERIOD_SIZE   384
 #define SHORT_PERIOD_SIZE         1024
 #define SHORT_PERIOD_COUNT        4
-#define AMPLIFIER_EN_PIN          "amp_pin"
-#define DELAY_START               "delay_start"
 #define DUMP_BUFS                 0
 #define HAL_LITTLEFS_DUMP         0
 
@@ -84,6 +87,11 @@ struct PrimaryAudioHwStreamOut {
 	//max value should sync with ameba audio driver's total_counter_boundary.
 	uint64_t written;
 	bool delay_start;
+	AudioDrift drift;
+#ifdef AUDIO_HW_AEC
+	//region given by AcquireBuffer, tapped for the echo reference on commit.
+	void *aec_region;
+#endif
 };
 
 static inline size_t PrimaryAudioHwStreamOutFrameSize(const struct AudioHwStreamOut *s)
@@ -151,6 +159,62 @@ static int32_t PrimarySetStreamOutFormat(struct AudioHwStream *stream, enum Audi
 	return HAL_OSAL_OK;
 }
 
+/* must be called with output stream mutex locked */
+static void PrimaryStreamOutDriftReset(struct PrimaryAudioHwStreamOut *out)
+{
+	if (out->drift.owns_pll) {
+		ameba_audio_ctl_pll_clock_tune(ameba_audio_get_ctl(), out->config.rate, 0, PLL_AUTO);
+	}
+	ameba_audio_drift_release_pll(&out->drift);
+}
+
+/* must be called with output stream mutex locked, after new data reached the driver */
+static void PrimaryStreamOutDriftCompensate(struct PrimaryAudioHwStreamOut *out)
+{
+	int64_t counted_frames;
+	int64_t ring_frames;
+	float ppm;
+
+	if (!out->drift.enabled || !out->out_pcm) {
+		return;
+	}
+
+	//frames the source delivered and the sport has not shifted out yet.
+	counted_frames = ameba_audio_stream_tx_get_frames_written(out->out_pcm) - ameba_audio_stream_tx_sport_rendered_frames(out->out_pcm);
+	ring_frames = ameba_audio_stream_buffer_get_remain_size(out->out_pcm->rbuffer) / out->out_pcm->frame_size;
+	if (!ameba_audio_drift_update(&out->drift, counted_frames, ring_frames, out->out_pcm->period_bytes / out->out_pcm->frame_size) ||
+		!ameba_audio_drift_claim_pll(&out->drift)) {
+		return;
+	}
+
+	ppm = out->drift.ppm;
+	if (ppm >= 0) {
+		ppm = ameba_audio_ctl_pll_clock_tune(ameba_audio_get_ctl(), out->config.rate, ppm, PLL_FASTER);
+	} else {
+		ppm = -ameba_audio_ctl_pll_clock_tune(ameba_audio_get_ctl(), out->config.rate, -ppm, PLL_SLOWER);
+	}
+	ameba_audio_drift_applied(&out->drift, ppm);
+}
+
+#ifdef AUDIO_HW_AEC
+/* feeds what the driver plays to the capture echo canceller as its reference. */
+static void PrimaryStreamOutAecRef(struct PrimaryAudioHwStreamOut *out, const void *data, int32_t bytes)
+{
+	uint32_t sample_bytes = GetAudioBytesPerSample(out->config.format);
+	uint64_t rendered_frames;
+	struct timespec tstamp;
+
+	if (!ameba_audio_aec_ref_active() || bytes <= 0 ||
+		ameba_audio_stream_tx_get_position(out->out_pcm, &rendered_frames, &tstamp) != 0) {
+		return;
+	}
+
+	ameba_audio_aec_ref_write(data, bytes / (out->config.channels * sample_bytes), out->config.channels, sample_bytes,
+							  out->config.rate, ameba_audio_stream_tx_get_frames_written(out->out_pcm), rendered_frames,
+							  (int64_t)tstamp.tv_sec * 1000000000LL + tstamp.tv_nsec);
+}
+#endif
+
 /* must be called with hw device and output stream mutexes locked */
 static int32_t DoStandbyOutput(struct PrimaryAudioHwStreamOut *out)
 {
@@ -161,6 +225,11 @@ static int32_t DoStandbyOutput(struct PrimaryAudioHwStreamOut *out)
 		}
 		ameba_audio_stream_tx_standby(out->out_pcm);
 		ameba_audio_stream_buffer_flush(out->out_pcm->rbuffer);
+		PrimaryStreamOutDriftReset(out);
+		ameba_audio_drift_restart(&out->drift);
+#ifdef AUDIO_HW_AEC
+		ameba_audio_aec_ref_reset();
+#endif
 
 #if HAL_LITTLEFS_DUMP
 		if (s_lfs_fd > 0) {
@@ -205,34 +274,85 @@ static int32_t PrimaryGetStreamOutBufferStatus(struct AudioHwStream *stream)
 	return ameba_audio_stream_tx_get_buffer_status(out->out_pcm);
 }
 
-static int32_t PrimarySetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+static int32_t PrimarySetStreamOutParameter(struct AudioHwStreamOut *stream, enum AudioHwParamKey key, int32_t value)
 {
-	HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
 	struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream;
-	struct string_cell *cells;
-	cells = string_cells_create_from_str(str_pairs);
-	int32_t value;
 
-	if (string_cells_has_key(cells, AMPLIFIER_EN_PIN)) {
-		string_cells_get_int(cells, AMPLIFIER_EN_PIN, &value);
+	switch (key) {
+	case AUDIO_HW_PARAM_AMP_PIN:
 		out->amp_pin = value;
 		ameba_audio_ctl_set_amp_pin(ameba_audio_get_ctl(), out->amp_pin);
-	}
-
-	if (string_cells_has_key(cells, DELAY_START)) {
-		string_cells_get_int(cells, DELAY_START, &value);
+		break;
+	case AUDIO_HW_PARAM_DELAY_START:
 		out->delay_start = value == 1 ? true : false;
 		ameba_audio_stream_tx_set_delay_start(out->out_pcm, out->delay_start);
+		break;
+	case AUDIO_HW_PARAM_DRIFT_TARGET_MS:
+		//Write compensates drift with the lock held.
+		rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+		PrimaryStreamOutDriftReset(out);
+		ameba_audio_drift_init(&out->drift, out->config.rate, false, value > 0 ? value : 0);
+		rtos_mutex_give(out->lock);
+		break;
+	default:
+		HAL_AUDIO_VERBOSE("key:%d not supported", key);
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	return HAL_OSAL_OK;
+}
+
+static int32_t PrimarySetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+{
+	HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
+	struct audio_hw_params params;
+
+	audio_hw_params_parse(str_pairs, &params);
+	for (int32_t key = 0; key < AUDIO_HW_PARAM_MAX; key++) {
+		if (audio_hw_params_has(&params, key)) {
+			PrimarySetStreamOutParameter((struct AudioHwStreamOut *)stream, key, params.values[key]);
+		}
 	}
 
-	string_cells_destroy(cells);
 	return HAL_OSAL_OK;
 }
 
+static int32_t PrimaryGetStreamOutStats(const struct AudioHwStreamOut *stream, struct AudioHwStreamStats *stats)
+{
+	struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream;
+	int32_t ret = HAL_OSAL_OK;
+
+	rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+	if (out->out_pcm) {
+		ameba_audio_stream_stats_get(&out->out_pcm->stats, stats);
+	} else {
+		memset(stats, 0, sizeof(*stats));
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+	rtos_mutex_give(out->lock);
+
+	return ret;
+}
+
 static char *PrimaryGetStreamOutParameters(const struct AudioHwStream *stream, const char *keys)
 {
-	(void) stream;
-	(void) keys;
+	struct AudioHwStreamStats stats;
+	char str[AMEBA_AUDIO_STREAM_STATS_STR_LEN];
+
+	if (keys && !strcmp(keys, AMEBA_AUDIO_STREAM_STATS_KEY)) {
+		PrimaryGetStreamOutStats((const struct AudioHwStreamOut *)stream, &stats);
+		ameba_audio_stream_stats_to_str(&stats, str, sizeof(str));
+		return (char *)xstrdup(str);
+	}
+	if (keys && !strcmp(keys, AMEBA_AUDIO_DRIFT_KEY)) {
+		struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream;
+
+		rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+		ameba_audio_drift_to_str(&out->drift, str, sizeof(str));
+		rtos_mutex_give(out->lock);
+		return (char *)xstrdup(str);
+	}
+
 	return (char *)xstrdup("");
 }
 
@@ -401,10 +521,16 @@ static ssize_t PrimaryStreamOutWrite(struct AudioHwStreamOut *stream, const void
 #endif
 
 			ret = ameba_audio_stream_tx_write(out->out_pcm, (void *)out->buffer, bytes / 2, block);
+#ifdef AUDIO_HW_AEC
+			PrimaryStreamOutAecRef(out, out->buffer, ret);
+#endif
 			ret *= 2;
 			rtos_mem_free(out->buffer);
 		} else {
 			ret = ameba_audio_stream_tx_write(out->out_pcm, (void *)buffer, bytes, block);
+#ifdef AUDIO_HW_AEC
+			PrimaryStreamOutAecRef(out, buffer, ret);
+#endif
 			//int64_t dump_start = DTimestamp_Get();
 #if HAL_LITTLEFS_DUMP
 			if (s_lfs_fd > 0) {
@@ -420,6 +546,7 @@ static ssize_t PrimaryStreamOutWrite(struct AudioHwStreamOut *stream, const void
 	//write successfully
 	if (ret >= 0) {
 		out->written += ret / frame_size;
+		PrimaryStreamOutDriftCompensate(out);
 		//sync with ameba audio driver's total_counter_boundary max value.
 		if (out->written > UINT64_MAX) {
 			out->written = 0;
@@ -432,6 +559,71 @@ exit:
 	return ret;
 }
 
+static ssize_t PrimaryStreamOutAcquireBuffer(struct AudioHwStreamOut *stream, void **buffer, size_t bytes)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream;
+
+	if (out->channel_count == 2 && AUDIO_HW_ENABLE_MIX) {
+		//the stereo data is mixed by hal before written to driver.
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+	if (out->standby) {
+		ret = StartAudioHwStreamOut(out);
+		if (ret != 0) {
+			HAL_AUDIO_ERROR("start stream_out fail");
+			goto exit;
+		}
+		out->standby = 0;
+	}
+
+	if (out->out_pcm) {
+		ret = ameba_audio_stream_tx_acquire_region(out->out_pcm, buffer, bytes);
+#ifdef AUDIO_HW_AEC
+		out->aec_region = ret > 0 ? *buffer : NULL;
+#endif
+	} else {
+		HAL_AUDIO_ERROR("out pcm is NULL!!!");
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+
+exit:
+	rtos_mutex_give(out->lock);
+
+	return ret;
+}
+
+static ssize_t PrimaryStreamOutCommitBuffer(struct AudioHwStreamOut *stream, size_t bytes)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream;
+	size_t frame_size = PrimaryAudioHwStreamOutFrameSize((const struct AudioHwStreamOut *)stream);
+
+	rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+	if (out->out_pcm) {
+		ret = ameba_audio_stream_tx_commit_region(out->out_pcm, bytes);
+#ifdef AUDIO_HW_AEC
+		if (out->aec_region) {
+			PrimaryStreamOutAecRef(out, out->aec_region, ret);
+			out->aec_region = NULL;
+		}
+#endif
+	} else {
+		HAL_AUDIO_ERROR("out pcm is NULL!!!");
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+
+	if (ret >= 0) {
+		out->written += ret / frame_size;
+		PrimaryStreamOutDriftCompensate(out);
+	}
+	rtos_mutex_give(out->lock);
+
+	return ret;
+}
+
 void DestroyAudioHwStreamOut(struct AudioHwStreamOut *stream_out)
 {
 	struct PrimaryAudioHwStreamOut *out = (struct PrimaryAudioHwStreamOut *)stream_out;
@@ -480,6 +672,10 @@ struct AudioHwStreamOut *CreateAudioHwStreamOut(struct AudioHwCard *card, const
 	out->stream.GetLatency = PrimaryGetStreamOutLatency;
 	out->stream.SetVolume = PrimarySetStreamOutVolume;
 	out->stream.Write = PrimaryStreamOutWrite;
+	out->stream.AcquireBuffer = PrimaryStreamOutAcquireBuffer;
+	out->stream.CommitBuffer = PrimaryStreamOutCommitBuffer;
+	out->stream.SetParameter = PrimarySetStreamOutParameter;
+	out->stream.GetStats = PrimaryGetStreamOutStats;
 
 	out->format = AUDIO_HW_FORMAT_PCM_16_BIT;
 	out->channel_count = 2;
@@ -5,6 +5,7 @@
 
 #include "ameba.h"
 #include "ameba_audio_stream_buffer.h"
+#include "ameba_audio_stream_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -137,6 +138,7 @@ typedef struct _Stream {
 
 	int32_t               multi_dma_xrun_mask;
 	bool                  dma_irq_masked;
+	StreamStats           stats;
 
 } Stream;
 
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "ameba.h"
 
 #include "sys_api.h"
@@ -24,18 +26,180 @@
 #include "ameba_audio_stream_control.h"
 
 #include "audio_hw_osal_errnos.h"
+#include "ameba_audio_patch_manager.h"
 
 #include "ameba_audio_stream_audio_patch.h"
 
+#define AUDIO_PATCH_SPORT_NUM               4
+/* same sports as the render and capture streams of the codec. */
+#define AUDIO_PATCH_CODEC_OUT_SPORT_INDEX   0
+#define AUDIO_PATCH_CODEC_IN_SPORT_INDEX    1
+
 extern void PLL_I2S_24P576M(u32 NewState);
 extern void AUDIO_SP_SetMclk(u32 index, u32 NewState);
 extern void AUDIO_SP_SetMclkDiv(u32 index, u32 mck_div);
 
-static void ameba_audio_stream_audio_patch_rx_sport_init(struct AmebaAudioPatchConfig config)
+static int32_t ameba_audio_stream_audio_patch_get_source_sport(int32_t device)
+{
+    switch (device) {
+    case AMEBA_AUDIO_IN_MIC:
+        return AUDIO_PATCH_CODEC_IN_SPORT_INDEX;
+    case AMEBA_AUDIO_IN_I2S:
+        return AUDIO_I2S_IN_SPORT_INDEX;
+    default:
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+}
+
+static int32_t ameba_audio_stream_audio_patch_get_sink_sport(int32_t device)
+{
+    switch (device) {
+    case AMEBA_AUDIO_DEVICE_SPEAKER:
+    case AMEBA_AUDIO_DEVICE_HEADPHONE:
+        return AUDIO_PATCH_CODEC_OUT_SPORT_INDEX;
+    case AMEBA_AUDIO_DEVICE_I2S:
+        return AUDIO_I2S_OUT_SPORT_INDEX;
+    default:
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+}
+
+static uint32_t ameba_audio_stream_audio_patch_get_sport_ip(uint32_t index)
+{
+    switch (index) {
+    case 0:
+        return SPORT0;
+    case 1:
+        return SPORT1;
+    case 2:
+        return SPORT2;
+    default:
+        return SPORT3;
+    }
+}
+
+/*
+ * Sink channel n is taken from channel n of the sources laid one after another,
+ * so two mono sources make a stereo sink.
+ */
+static int32_t ameba_audio_stream_audio_patch_get_route(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
+                                                        int32_t num_sinks, struct AmebaAudioPatchConfig *sinks,
+                                                        int32_t *source_sports, int32_t *sink_sports,
+                                                        AudioPatchRoute *route)
+{
+    uint32_t source_channels = 0;
+
+    if (num_sources <= 0 || num_sources > AUDIO_PATCH_SPORT_NUM || num_sinks <= 0 || num_sinks > AUDIO_PATCH_SPORT_NUM) {
+        HAL_AUDIO_ERROR("unsupported patch, sources:%ld, sinks:%ld", num_sources, num_sinks);
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    memset(route, 0, sizeof(AudioPatchRoute));
+    route->rate = sources[0].sample_rate;
+
+    for (int32_t i = 0; i < num_sources; i++) {
+        source_sports[i] = ameba_audio_stream_audio_patch_get_source_sport(sources[i].device);
+        if (source_sports[i] < 0) {
+            HAL_AUDIO_ERROR("unsupported source type:%ld", sources[i].device);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (route->rx_sports & AUDIO_PATCH_SPORT_BIT(source_sports[i])) {
+            HAL_AUDIO_ERROR("sources share rx sport %ld", source_sports[i]);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sources[i].sample_rate != route->rate) {
+            HAL_AUDIO_ERROR("direct patch can't convert rate %lu to %lu", sources[i].sample_rate, route->rate);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        route->rx_sports |= AUDIO_PATCH_SPORT_BIT(source_sports[i]);
+        route->codec_in |= sources[i].device == AMEBA_AUDIO_IN_MIC;
+        source_channels += sources[i].channel_count;
+    }
+
+    for (int32_t i = 0; i < num_sinks; i++) {
+        sink_sports[i] = ameba_audio_stream_audio_patch_get_sink_sport(sinks[i].device);
+        if (sink_sports[i] < 0) {
+            HAL_AUDIO_ERROR("unsupported sink type:%ld", sinks[i].device);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (route->tx_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) {
+            HAL_AUDIO_ERROR("sinks share tx sport %ld", sink_sports[i]);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sinks[i].sample_rate != route->rate) {
+            HAL_AUDIO_ERROR("direct patch can't convert rate %lu to %lu", route->rate, sinks[i].sample_rate);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        if (sinks[i].channel_count > source_channels) {
+            HAL_AUDIO_ERROR("sink needs %lu channels, sources have %lu", sinks[i].channel_count, source_channels);
+            return HAL_OSAL_ERR_INVALID_PARAM;
+        }
+        route->tx_sports |= AUDIO_PATCH_SPORT_BIT(sink_sports[i]);
+        route->codec_out |= sinks[i].device == AMEBA_AUDIO_DEVICE_SPEAKER || sinks[i].device == AMEBA_AUDIO_DEVICE_HEADPHONE;
+        route->pll |= sinks[i].device == AMEBA_AUDIO_DEVICE_I2S && AUDIO_HW_OUT_SPORT_CLK_TYPE != 0;
+    }
+
+    //every sport has its own clock source mux.
+    route->clk_sports = route->rx_sports | route->tx_sports;
+
+    return HAL_OSAL_OK;
+}
+
+static int32_t ameba_audio_stream_audio_patch_check_streams(const AudioPatchRoute *route)
+{
+    uint32_t patch_sports = ameba_audio_patch_manager_get_sports();
+
+    for (uint32_t i = 0; i < AUDIO_PATCH_SPORT_NUM; i++) {
+        if (((route->rx_sports | route->tx_sports) & AUDIO_PATCH_SPORT_BIT(i)) && !(patch_sports & AUDIO_PATCH_SPORT_BIT(i))
+            && ameba_audio_is_audio_ip_in_use(ameba_audio_stream_audio_patch_get_sport_ip(i))) {
+            HAL_AUDIO_ERROR("sport %lu is used by a stream", i);
+            return HAL_OSAL_ERR_ALREADY_EXISTS;
+        }
+    }
+
+    return HAL_OSAL_OK;
+}
+
+static void ameba_audio_stream_audio_patch_clock_init(const AudioPatchRoute *route, uint32_t held_sports)
+{
+    uint32_t sports = route->rx_sports | route->tx_sports;
+
+    if (sports & AUDIO_PATCH_SPORT_BIT(0)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, ENABLE);
+    }
+    if (sports & AUDIO_PATCH_SPORT_BIT(1)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, ENABLE);
+    }
+    if (sports & AUDIO_PATCH_SPORT_BIT(2)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT2, APBPeriph_SPORT2_CLOCK, ENABLE);
+    }
+    if (sports & AUDIO_PATCH_SPORT_BIT(3)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT3, APBPeriph_SPORT3_CLOCK, ENABLE);
+    }
+
+    //the i2s sink of a pll patch switches its own sport to the pll when it is set up.
+    //held sports keep the source a running patch selected, the manager checked it matches.
+    for (uint32_t i = 0; i < AUDIO_PATCH_SPORT_NUM; i++) {
+        if ((sports & ~held_sports) & AUDIO_PATCH_SPORT_BIT(i)) {
+            RCC_PeriphClockSource_SPORT(i, CKSL_I2S_XTAL40M);
+        }
+    }
+
+    if (!ameba_audio_is_audio_ip_in_use(CODEC) && !ameba_audio_is_audio_ip_in_use(POWER)) {
+        RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, ENABLE);
+        RCC_PeriphClockCmd(APBPeriph_AUDIO, APBPeriph_CLOCK_NULL, ENABLE);
+        RCC_PeriphClockSource_AUDIOCODEC(CKSL_AC_XTAL);
+    }
+}
+
+static void ameba_audio_stream_audio_patch_rx_sport_init(uint32_t index, struct AmebaAudioPatchConfig config, bool shared)
 {
     SP_InitTypeDef SP_InitStruct;
 
-    AUDIO_SP_Reset(AUDIO_I2S_IN_SPORT_INDEX);
+    //shared: the other direction belongs to a running patch, a sport reset would stop it.
+    if (!shared) {
+        AUDIO_SP_Reset(index);
+    }
     AUDIO_SP_StructInit(&SP_InitStruct);
     SP_InitStruct.SP_SelDataFormat = AUDIO_I2S_IN_DATA_FORMAT;
     SP_InitStruct.SP_SelI2SMonoStereo = ameba_audio_get_channel(config.channel_count);
@@ -43,27 +207,28 @@ static void ameba_audio_stream_audio_patch_rx_sport_init(struct AmebaAudioPatchC
     SP_InitStruct.SP_SelTDM = ameba_audio_get_sp_tdm(config.channel_count);
     SP_InitStruct.SP_SelFIFO = ameba_audio_get_fifo_num(config.channel_count);
     SP_InitStruct.SP_SR = ameba_audio_get_sp_rate(config.sample_rate);
-#if AUDIO_I2S_IN_MULTIIO_EN
-    SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_EN;
-#else
     SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_DIS;
-#endif
-    AUDIO_SP_Init(AUDIO_I2S_IN_SPORT_INDEX, SP_DIR_RX, &SP_InitStruct);
+    if (config.device == AMEBA_AUDIO_IN_I2S && AUDIO_I2S_IN_MULTIIO_EN) {
+        SP_InitStruct.SP_SetMultiIO = SP_RX_MULTIIO_EN;
+    }
+    AUDIO_SP_Init(index, SP_DIR_RX, &SP_InitStruct);
 
-    HAL_AUDIO_INFO("rx sport %d init, %ld, %ld, %ld, %ld, %ld, %ld", AUDIO_I2S_IN_SPORT_INDEX,
+    HAL_AUDIO_INFO("rx sport %ld init, %ld, %ld, %ld, %ld, %ld, %ld", index,
                     SP_InitStruct.SP_SelDataFormat, SP_InitStruct.SP_SelI2SMonoStereo,
                     SP_InitStruct.SP_SelWordLen, SP_InitStruct.SP_SelTDM,
                     SP_InitStruct.SP_SelFIFO, SP_InitStruct.SP_SR);
 }
 
-static void ameba_audio_stream_audio_patch_tx_sport_init_with_clk(struct AmebaAudioPatchConfig config)
+static void ameba_audio_stream_audio_patch_tx_sport_init_with_clk(uint32_t index, struct AmebaAudioPatchConfig config, bool shared)
 {
     AUDIO_ClockParams Clock_Params;
     AUDIO_InitParams Init_Params;
     uint32_t clock_mode;
     uint32_t mck_div;
 
-    AUDIO_SP_Reset(AUDIO_I2S_OUT_SPORT_INDEX);
+    if (!shared) {
+        AUDIO_SP_Reset(index);
+    }
     SP_InitTypeDef SP_InitStruct;
     AUDIO_SP_StructInit(&SP_InitStruct);
     SP_InitStruct.SP_SelDataFormat = AUDIO_I2S_OUT_DATA_FORMAT;
@@ -104,48 +269,57 @@ static void ameba_audio_stream_audio_patch_tx_sport_init_with_clk(struct AmebaAu
         Audio_Clock_Choose(PLL_CLK, &Init_Params, &Clock_Params);
     }
 
+    //a shared sport already runs from this source and divider, see ameba_audio_patch_manager_check.
     switch (Clock_Params.Clock) {
     case PLL_CLOCK_24P576M:
         PLL_I2S_24P576M(ENABLE);
-        RCC_PeriphClockSource_SPORT(AUDIO_I2S_OUT_SPORT_INDEX, CKSL_I2S_PLL24M);
-        PLL_I2S_Div(AUDIO_I2S_OUT_SPORT_INDEX, Clock_Params.PLL_DIV);
+        if (!shared) {
+            RCC_PeriphClockSource_SPORT(index, CKSL_I2S_PLL24M);
+            PLL_I2S_Div(index, Clock_Params.PLL_DIV);
+        }
         clock_mode = PLL_CLOCK_24P576M / Clock_Params.PLL_DIV;
         break;
 
     case PLL_CLOCK_45P1584M:
         PLL_I2S_45P158M(ENABLE);
-        RCC_PeriphClockSource_SPORT(AUDIO_I2S_OUT_SPORT_INDEX, CKSL_I2S_PLL45M);
-        PLL_I2S_Div(AUDIO_I2S_OUT_SPORT_INDEX, Clock_Params.PLL_DIV);
+        if (!shared) {
+            RCC_PeriphClockSource_SPORT(index, CKSL_I2S_PLL45M);
+            PLL_I2S_Div(index, Clock_Params.PLL_DIV);
+        }
         PLL_I2S_45P158M_ClkTune(NULL, 0, PLL_AUTO);
         clock_mode = PLL_CLOCK_45P1584M / Clock_Params.PLL_DIV;
         break;
 
     case PLL_CLOCK_98P304M:
         PLL_I2S_98P304M(ENABLE);
-        RCC_PeriphClockSource_SPORT(AUDIO_I2S_OUT_SPORT_INDEX, CKSL_I2S_PLL98M);
-        PLL_I2S_Div(AUDIO_I2S_OUT_SPORT_INDEX, Clock_Params.PLL_DIV);
+        if (!shared) {
+            RCC_PeriphClockSource_SPORT(index, CKSL_I2S_PLL98M);
+            PLL_I2S_Div(index, Clock_Params.PLL_DIV);
+        }
         PLL_I2S_98P304M_ClkTune(NULL, 0, PLL_AUTO);
         clock_mode = PLL_CLOCK_98P304M / Clock_Params.PLL_DIV;
         break;
 
     case I2S_CLOCK_XTAL40M:
         clock_mode = I2S_CLOCK_XTAL40M;
-        RCC_PeriphClockSource_SPORT(AUDIO_I2S_OUT_SPORT_INDEX, CKSL_I2S_XTAL40M);
+        if (!shared) {
+            RCC_PeriphClockSource_SPORT(index, CKSL_I2S_XTAL40M);
+        }
         break;
     }
 
     SP_InitStruct.SP_SelClk = clock_mode;
 
-    AUDIO_SP_Init(AUDIO_I2S_OUT_SPORT_INDEX, SP_DIR_TX, &SP_InitStruct);
+    AUDIO_SP_Init(index, SP_DIR_TX, &SP_InitStruct);
 
-    HAL_AUDIO_INFO("tx sport %d init, %ld, %ld, %ld, %ld, %ld, %ld", AUDIO_I2S_OUT_SPORT_INDEX,
+    HAL_AUDIO_INFO("tx sport %ld init, %ld, %ld, %ld, %ld, %ld, %ld", index,
                     SP_InitStruct.SP_SelDataFormat, SP_InitStruct.SP_SelI2SMonoStereo,
                     SP_InitStruct.SP_SelWordLen, SP_InitStruct.SP_SelTDM,
                     SP_InitStruct.SP_SelFIFO, SP_InitStruct.SP_SR);
 
     if (AUDIO_I2S_OUT_NEED_MCLK_OUT == 1) {
         //enable mclk and set div
-        AUDIO_SP_SetMclk(AUDIO_I2S_OUT_SPORT_INDEX, ENABLE);
+        AUDIO_SP_SetMclk(index, ENABLE);
         switch (Clock_Params.MCLK_DIV) {
         case 1:
             mck_div = 2;
@@ -157,31 +331,29 @@ static void ameba_audio_stream_audio_patch_tx_sport_init_with_clk(struct AmebaAu
             mck_div = 0;
             break;
         }
-        AUDIO_SP_SetMclkDiv(AUDIO_I2S_OUT_SPORT_INDEX, mck_div);
+        AUDIO_SP_SetMclkDiv(index, mck_div);
     }
 
-    AUDIO_SP_SetMasterSlave(AUDIO_I2S_OUT_SPORT_INDEX, MASTER);
+    AUDIO_SP_SetMasterSlave(index, MASTER);
 
 }
 
-static void ameba_audio_stream_audio_patch_tx_sport_init(struct AmebaAudioPatchConfig config)
+static void ameba_audio_stream_audio_patch_tx_sport_init(uint32_t index, struct AmebaAudioPatchConfig config, bool shared)
 {
-    AUDIO_SP_Reset(AUDIO_I2S_OUT_SPORT_INDEX);
+    if (!shared) {
+        AUDIO_SP_Reset(index);
+    }
     SP_InitTypeDef SP_InitStruct;
     AUDIO_SP_StructInit(&SP_InitStruct);
     SP_InitStruct.SP_SelWordLen = ameba_audio_get_sp_format(config.format, STREAM_OUT);
     SP_InitStruct.SP_SR = ameba_audio_get_sp_rate(config.sample_rate);
     SP_InitStruct.SP_SelTDM = ameba_audio_get_sp_tdm(config.channel_count);
     SP_InitStruct.SP_SelFIFO = ameba_audio_get_fifo_num(config.channel_count);
-#if AUDIO_I2S_OUT_MULTIIO_EN
-    SP_InitStruct.SP_SetMultiIO = SP_TX_MULTIIO_EN;
-#else
     SP_InitStruct.SP_SetMultiIO = SP_TX_MULTIIO_DIS;
-#endif
 
-    AUDIO_SP_Init(AUDIO_I2S_OUT_SPORT_INDEX, SP_DIR_TX, &SP_InitStruct);
+    AUDIO_SP_Init(index, SP_DIR_TX, &SP_InitStruct);
 
-    HAL_AUDIO_INFO("tx sport %d init, %ld, %ld, %ld, %ld, %ld, %ld", AUDIO_I2S_OUT_SPORT_INDEX,
+    HAL_AUDIO_INFO("tx sport %ld init, %ld, %ld, %ld, %ld, %ld, %ld", index,
                     SP_InitStruct.SP_SelDataFormat, SP_InitStruct.SP_SelI2SMonoStereo,
                     SP_InitStruct.SP_SelWordLen, SP_InitStruct.SP_SelTDM,
                     SP_InitStruct.SP_SelFIFO, SP_InitStruct.SP_SR);
@@ -206,167 +378,223 @@ static void ameba_audio_stream_audio_patch_codec_init(struct AmebaAudioPatchConf
     AUDIO_CODEC_SetADCVolume(ADC2, 0x00);
 }
 
+static void ameba_audio_stream_audio_patch_set_direct_regs(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
+                                                           int32_t *source_sports, uint32_t sink_sport,
+                                                           uint32_t sink_channels)
+{
+    int32_t source = 0;
+    uint32_t source_channel = 0;
+
+    for (uint32_t i = 0; i < sink_channels; i ++) {
+        while (source < num_sources && source_channel >= sources[source].channel_count) {
+            source++;
+            source_channel = 0;
+        }
+
+        /*I2S TX data from DIRECT_REG_N*/
+        AUDIO_SP_TXCHNSrcSel(sink_sport, ameba_audio_stream_get_sp_tx_channel_idx(i), DIRECT_REG_CHN);
+
+        /*enable sport DIRECT_REG_N*/
+        AUDIO_SP_TXSetDirectRegStart(sink_sport, ameba_audio_stream_get_direct_reg_idx(i), ENABLE);
+
+        /*DIRECT_IN_N->DIRECT_REG_N, DIRECT_IN_N and DIRECT_OUT_N are the same for one sport.*/
+        AUDIO_SP_TXDirectRegSel(sink_sport, source_sports[source], ameba_audio_stream_get_direct_reg_idx(i),
+                                ameba_audio_stream_get_direct_in_channel_idx(source_channel));
+        source_channel++;
+    }
+}
+
 int32_t ameba_audio_stream_create_audio_patch(int32_t num_sources, struct AmebaAudioPatchConfig *sources,
                                               int32_t num_sinks, struct AmebaAudioPatchConfig *sinks)
 {
-    /*FIXME: suport more indexs*/
-    int patch_index = 0;
+    int32_t source_sports[AUDIO_PATCH_SPORT_NUM];
+    int32_t sink_sports[AUDIO_PATCH_SPORT_NUM];
+    AudioPatchRoute route;
+    uint32_t held_sports;
+    int32_t patch_index;
+    int32_t ret;
+
+    ret = ameba_audio_stream_audio_patch_get_route(num_sources, sources, num_sinks, sinks,
+                                                   source_sports, sink_sports, &route);
+    if (ret != HAL_OSAL_OK) {
+        return ret;
+    }
 
-    if (num_sources > 1) {
-        HAL_AUDIO_ERROR("only support one source for patch.");
-        return HAL_OSAL_ERR_INVALID_PARAM;
+    ret = ameba_audio_stream_audio_patch_check_streams(&route);
+    if (ret != HAL_OSAL_OK) {
+        return ret;
     }
 
-    /*FIXME: to support more sinks.*/
-    if (num_sinks > 1) {
-        HAL_AUDIO_ERROR("only support one sink for patch.");
-        return HAL_OSAL_ERR_INVALID_PARAM;
+    //sports running patches hold, the manager lets this patch take their other direction.
+    held_sports = ameba_audio_patch_manager_get_sports();
+    patch_index = ameba_audio_patch_manager_add(&route);
+    if (patch_index < 0) {
+        return patch_index;
     }
 
-    HAL_AUDIO_INFO("source:%lx, sink:%lx", sources[0].device, sinks[0].device);
+    ameba_audio_stream_audio_patch_clock_init(&route, held_sports);
 
-    RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT2, APBPeriph_SPORT2_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT3, APBPeriph_SPORT3_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, ENABLE);
-    RCC_PeriphClockCmd(APBPeriph_AUDIO, APBPeriph_CLOCK_NULL, ENABLE);
+    for (int32_t i = 0; i < num_sources; i++) {
+        HAL_AUDIO_INFO("patch %ld source:%lx, sport:%ld", patch_index, sources[i].device, source_sports[i]);
+        ameba_audio_stream_audio_patch_rx_sport_init(source_sports[i], sources[i],
+                                                    (held_sports & AUDIO_PATCH_SPORT_BIT(source_sports[i])) != 0);
 
-    //choose sys pll for sport 0.
-    RCC_PeriphClockSource_SPORT(0, CKSL_I2S_XTAL40M);
-    RCC_PeriphClockSource_SPORT(1, CKSL_I2S_XTAL40M);
-    RCC_PeriphClockSource_SPORT(2, CKSL_I2S_XTAL40M);
-    RCC_PeriphClockSource_SPORT(3, CKSL_I2S_XTAL40M);
-    RCC_PeriphClockSource_AUDIOCODEC(CKSL_AC_XTAL);
+        if ((sources[i].device) == AMEBA_AUDIO_IN_MIC) {
+            HAL_AUDIO_INFO("source mic");
+            ameba_audio_stream_audio_patch_codec_init(sources[i]);
+            ameba_audio_set_audio_ip_use_status(STREAM_IN, CODEC, true);
+        }
 
-    //need PLL setting?
+        if ((sources[i].device) == AMEBA_AUDIO_IN_I2S) {
+            HAL_AUDIO_INFO("source i2s");
+            if (AUDIO_I2S_IN_NEED_MCLK_OUT) {
+                Pinmux_Config(AUDIO_I2S_IN_MCLK_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+            }
+            Pinmux_Config(AUDIO_I2S_IN_BCLK_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+            Pinmux_Config(AUDIO_I2S_IN_LRCLK_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+            Pinmux_Config(AUDIO_I2S_IN_DATA0_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+            if (AUDIO_I2S_IN_MULTIIO_EN) {
+                Pinmux_Config(AUDIO_I2S_IN_DATA1_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+                Pinmux_Config(AUDIO_I2S_IN_DATA2_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+                Pinmux_Config(AUDIO_I2S_IN_DATA3_PIN, ameba_audio_get_i2s_pin_func(source_sports[i]));
+            }
+            HAL_AUDIO_INFO("set I2S IN slave");
+            AUDIO_SP_SetMasterSlave(source_sports[i], SLAVE);
+        }
 
-    ameba_audio_stream_audio_patch_rx_sport_init(sources[0]);
+        AUDIO_SP_RXStart(source_sports[i], ENABLE);
 
-    if ((sources[0].device) == AMEBA_AUDIO_IN_MIC) {
-        HAL_AUDIO_INFO("source mic");
-        ameba_audio_stream_audio_patch_codec_init(sources[0]);
+        for (uint32_t j = 0; j < sources[i].channel_count; j ++) {
+            /*enable DIRECT_OUT_N*/
+            AUDIO_SP_RXSetDirectOutStart(source_sports[i], ameba_audio_stream_get_direct_out_channel_idx(j), ENABLE);
+        }
+        ameba_audio_set_audio_ip_use_status(STREAM_IN, ameba_audio_stream_audio_patch_get_sport_ip(source_sports[i]), true);
     }
 
-    if ((sources[0].device) == AMEBA_AUDIO_IN_I2S) {
-        HAL_AUDIO_INFO("source i2s");
-        if (AUDIO_I2S_IN_NEED_MCLK_OUT) {
-            Pinmux_Config(AUDIO_I2S_IN_MCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
+    for (int32_t i = 0; i < num_sinks; i++) {
+        I2S_InitTypeDef i2s_initstruct;
+        AUDIO_CODEC_I2S_StructInit(&i2s_initstruct);
+        i2s_initstruct.CODEC_SelI2STxSR = ameba_audio_get_codec_rate(sinks[i].sample_rate);
+        i2s_initstruct.CODEC_SelI2STxWordLen = ameba_audio_get_codec_format(sinks[i].format, STREAM_OUT);
+
+        HAL_AUDIO_INFO("patch %ld sink:%lx, sport:%ld", patch_index, sinks[i].device, sink_sports[i]);
+        switch (sinks[i].device)
+        {
+        case AMEBA_AUDIO_DEVICE_SPEAKER:
+            HAL_AUDIO_INFO("set speaker");
+            AUDIO_CODEC_SetAudioIP(ENABLE);
+            AUDIO_CODEC_SetLDOMode(POWER_ON);
+
+            AUDIO_CODEC_Playback(I2S0, APP_LINE_OUT, &i2s_initstruct);
+            AUDIO_CODEC_SetDACASRC(i2s_initstruct.CODEC_SelI2STxSR, ENABLE);
+
+            ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, true);
+            ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state);
+            ameba_audio_stream_audio_patch_tx_sport_init(sink_sports[i], sinks[i],
+                                                         (held_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) != 0);
+            break;
+        case AMEBA_AUDIO_DEVICE_I2S:
+            HAL_AUDIO_INFO("set I2S out");
+            sys_jtag_off();
+            if (AUDIO_I2S_OUT_NEED_MCLK_OUT) {
+                Pinmux_Config(AUDIO_I2S_OUT_MCLK_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+            }
+            Pinmux_Config(AUDIO_I2S_OUT_BCLK_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+            Pinmux_Config(AUDIO_I2S_OUT_LRCLK_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+            Pinmux_Config(AUDIO_I2S_OUT_DATA0_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+            if (AUDIO_I2S_OUT_MULTIIO_EN == 1) {
+                Pinmux_Config(AUDIO_I2S_OUT_DATA1_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+                Pinmux_Config(AUDIO_I2S_OUT_DATA2_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+                Pinmux_Config(AUDIO_I2S_OUT_DATA3_PIN, ameba_audio_get_i2s_pin_func(sink_sports[i]));
+            }
+            ameba_audio_stream_audio_patch_tx_sport_init_with_clk(sink_sports[i], sinks[i],
+                                                                  (held_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) != 0);
+            break;
+        case AMEBA_AUDIO_DEVICE_HEADPHONE:
+            HAL_AUDIO_INFO("set headphone");
+            AUDIO_CODEC_SetAudioIP(ENABLE);
+            AUDIO_CODEC_SetLDOMode(POWER_ON);
+
+            AUDIO_CODEC_Playback(I2S0, APP_HPO_OUT, &i2s_initstruct);
+            AUDIO_CODEC_SetDACASRC(i2s_initstruct.CODEC_SelI2STxSR, ENABLE);
+
+            ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, true);
+            ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state);
+            ameba_audio_stream_audio_patch_tx_sport_init(sink_sports[i], sinks[i],
+                                                         (held_sports & AUDIO_PATCH_SPORT_BIT(sink_sports[i])) != 0);
+            break;
+        default:
+            break;
         }
-        Pinmux_Config(AUDIO_I2S_IN_BCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
-        Pinmux_Config(AUDIO_I2S_IN_LRCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
-        Pinmux_Config(AUDIO_I2S_IN_DATA0_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
-        if (AUDIO_I2S_IN_MULTIIO_EN) {
-            Pinmux_Config(AUDIO_I2S_IN_DATA1_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
-            Pinmux_Config(AUDIO_I2S_IN_DATA2_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
-            Pinmux_Config(AUDIO_I2S_IN_DATA3_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_IN_SPORT_INDEX));
+
+        /*direct mode enable*/
+        for (int32_t j = 0; j < num_sources; j++) {
+            AUDIO_SP_SetDirectOutMode(source_sports[j], sink_sports[i]);
         }
-        HAL_AUDIO_INFO("set I2S IN slave");
-        AUDIO_SP_SetMasterSlave(AUDIO_I2S_IN_SPORT_INDEX, SLAVE);
+
+        ameba_audio_stream_audio_patch_set_direct_regs(num_sources, sources, source_sports, sink_sports[i],
+                                                        sinks[i].channel_count);
+
+        AUDIO_SP_TXStart(sink_sports[i], ENABLE);
+        ameba_audio_set_audio_ip_use_status(STREAM_OUT, ameba_audio_stream_audio_patch_get_sport_ip(sink_sports[i]), true);
     }
 
-    AUDIO_SP_RXStart(AUDIO_I2S_IN_SPORT_INDEX, ENABLE);
+    return patch_index;
 
-    I2S_InitTypeDef i2s_initstruct;
-    AUDIO_CODEC_I2S_StructInit(&i2s_initstruct);
-    i2s_initstruct.CODEC_SelI2STxSR = ameba_audio_get_codec_rate(sinks[0].sample_rate);
-    i2s_initstruct.CODEC_SelI2STxWordLen = ameba_audio_get_codec_format(sinks[0].format, STREAM_OUT);
+}
 
-    switch (sinks[0].device)
-    {
-    case AMEBA_AUDIO_DEVICE_SPEAKER:
-        HAL_AUDIO_INFO("set speaker");
-        AUDIO_CODEC_SetAudioIP(ENABLE);
-        AUDIO_CODEC_SetLDOMode(POWER_ON);
+int32_t ameba_audio_stream_release_audio_patch(int32_t patch_index)
+{
+    AudioPatchRoute route;
+    int32_t ret;
 
-        AUDIO_CODEC_Playback(I2S0, APP_LINE_OUT, &i2s_initstruct);
-        AUDIO_CODEC_SetDACASRC(i2s_initstruct.CODEC_SelI2STxSR, ENABLE);
+    ret = ameba_audio_patch_manager_get(patch_index, &route);
+    if (ret != HAL_OSAL_OK) {
+        HAL_AUDIO_ERROR("no patch %ld", patch_index);
+        return ret;
+    }
 
-        ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, true);
-        ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state);
-        break;
-    case AMEBA_AUDIO_DEVICE_I2S:
-        HAL_AUDIO_INFO("set I2S out");
-        sys_jtag_off();
-        if (AUDIO_I2S_OUT_NEED_MCLK_OUT) {
-            Pinmux_Config(AUDIO_I2S_OUT_MCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
+    HAL_AUDIO_INFO("release patch %ld", patch_index);
+    for (uint32_t i = 0; i < AUDIO_PATCH_SPORT_NUM; i++) {
+        if (route.tx_sports & AUDIO_PATCH_SPORT_BIT(i)) {
+            AUDIO_SP_TXStart(i, DISABLE);
+            AUDIO_SP_Deinit(i, SP_DIR_TX);
+            ameba_audio_set_audio_ip_use_status(STREAM_OUT, ameba_audio_stream_audio_patch_get_sport_ip(i), false);
         }
-        Pinmux_Config(AUDIO_I2S_OUT_BCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
-        Pinmux_Config(AUDIO_I2S_OUT_LRCLK_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
-        Pinmux_Config(AUDIO_I2S_OUT_DATA0_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
-        if (AUDIO_I2S_OUT_MULTIIO_EN == 1) {
-            Pinmux_Config(AUDIO_I2S_OUT_DATA1_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
-            Pinmux_Config(AUDIO_I2S_OUT_DATA2_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
-            Pinmux_Config(AUDIO_I2S_OUT_DATA3_PIN, ameba_audio_get_i2s_pin_func(AUDIO_I2S_OUT_SPORT_INDEX));
+        if (route.rx_sports & AUDIO_PATCH_SPORT_BIT(i)) {
+            AUDIO_SP_RXStart(i, DISABLE);
+            AUDIO_SP_Deinit(i, SP_DIR_RX);
+            ameba_audio_set_audio_ip_use_status(STREAM_IN, ameba_audio_stream_audio_patch_get_sport_ip(i), false);
         }
-        break;
-    case AMEBA_AUDIO_DEVICE_HEADPHONE:
-        HAL_AUDIO_INFO("set headphone");
-        AUDIO_CODEC_SetAudioIP(ENABLE);
-        AUDIO_CODEC_SetLDOMode(POWER_ON);
-
-        AUDIO_CODEC_Playback(I2S0, APP_HPO_OUT, &i2s_initstruct);
-        AUDIO_CODEC_SetDACASRC(i2s_initstruct.CODEC_SelI2STxSR, ENABLE);
-
-        ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, true);
-        ameba_audio_ctl_set_amp_state(ameba_audio_get_ctl(), ameba_audio_get_ctl()->amp_state);
-        break;
-    default:
-        HAL_AUDIO_ERROR("unsupported sink type:%ld", sinks[0].device);
-        break;
     }
 
-    for (uint32_t i = 0; i < sources[0].channel_count; i ++) {
-        /*enable DIRECT_OUT_N*/
-        AUDIO_SP_RXSetDirectOutStart(AUDIO_I2S_IN_SPORT_INDEX,
-                                     ameba_audio_stream_get_direct_out_channel_idx(i), ENABLE);
+    if (route.codec_in) {
+        ameba_audio_set_audio_ip_use_status(STREAM_IN, CODEC, false);
     }
-
-    if (sinks[0].device == AMEBA_AUDIO_DEVICE_I2S) {
-        ameba_audio_stream_audio_patch_tx_sport_init_with_clk(sinks[0]);
-    } else {
-        ameba_audio_stream_audio_patch_tx_sport_init(sinks[0]);
+    if (route.codec_out) {
+        ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, false);
     }
 
-    /*direct mode enable*/
-    AUDIO_SP_SetDirectOutMode(AUDIO_I2S_IN_SPORT_INDEX, AUDIO_I2S_OUT_SPORT_INDEX);
-
-    for (uint32_t i = 0; i < sinks[0].channel_count; i ++) {
-        /*I2S TX data from DIRECT_REG_N*/
-        AUDIO_SP_TXCHNSrcSel(AUDIO_I2S_OUT_SPORT_INDEX,
-                             ameba_audio_stream_get_sp_tx_channel_idx(i), DIRECT_REG_CHN);
-
-        /*enable sport DIRECT_REG_N*/
-        AUDIO_SP_TXSetDirectRegStart(AUDIO_I2S_OUT_SPORT_INDEX,
-                                     ameba_audio_stream_get_direct_reg_idx(i), ENABLE);
-
-        /*DIRECT_IN_N->DIRECT_REG_N, DIRECT_IN_N and DIRECT_OUT_N are the same for one sport.*/
-        AUDIO_SP_TXDirectRegSel(AUDIO_I2S_OUT_SPORT_INDEX, AUDIO_I2S_IN_SPORT_INDEX,
-          ameba_audio_stream_get_direct_reg_idx(i), ameba_audio_stream_get_direct_in_channel_idx(i));
+    ameba_audio_patch_manager_remove(patch_index);
 
+    //other patches and streams keep their clocks.
+    if (!ameba_audio_is_audio_ip_in_use(SPORT0)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_is_audio_ip_in_use(SPORT1)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_is_audio_ip_in_use(SPORT2)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT2, APBPeriph_SPORT2_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_is_audio_ip_in_use(SPORT3)) {
+        RCC_PeriphClockCmd(APBPeriph_SPORT3, APBPeriph_SPORT3_CLOCK, DISABLE);
+    }
+    if (!ameba_audio_patch_manager_get_sports() && !ameba_audio_is_audio_ip_in_use(CODEC)
+        && !ameba_audio_is_audio_ip_in_use(POWER)) {
+        RCC_PeriphClockCmd(APBPeriph_AUDIO, APBPeriph_CLOCK_NULL, DISABLE);
+        RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, DISABLE);
     }
-
-    AUDIO_SP_TXStart(AUDIO_I2S_OUT_SPORT_INDEX, ENABLE);
-
-    return patch_index;
-
-}
-
-int32_t ameba_audio_stream_release_audio_patch(int32_t patch_index)
-{
-    (void) patch_index;
-    AUDIO_SP_TXStart(AUDIO_I2S_OUT_SPORT_INDEX, DISABLE);
-    AUDIO_SP_Deinit(AUDIO_I2S_OUT_SPORT_INDEX, SP_DIR_TX);
-    AUDIO_SP_TXStart(AUDIO_I2S_IN_SPORT_INDEX, DISABLE);
-    AUDIO_SP_Deinit(AUDIO_I2S_IN_SPORT_INDEX, SP_DIR_RX);
-
-    RCC_PeriphClockCmd(APBPeriph_SPORT0, APBPeriph_SPORT0_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT1, APBPeriph_SPORT1_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT2, APBPeriph_SPORT0_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_SPORT3, APBPeriph_SPORT1_CLOCK, DISABLE);
-    RCC_PeriphClockCmd(APBPeriph_AC, APBPeriph_AC_CLOCK, DISABLE);
-
-    ameba_audio_set_audio_ip_use_status(STREAM_OUT, CODEC, false);
 
     return HAL_OSAL_OK;
 }
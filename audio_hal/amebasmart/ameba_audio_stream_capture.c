@@ -25,8 +25,10 @@
 #include "ameba_audio_stream_control.h"
 #include "ameba_audio_stream_utils.h"
 #include "ameba_audio_stream_buffer.h"
+#include "ameba_audio_isr_trace.h"
 #include "ameba_audio_types.h"
 
+#include "audio_hw_channel_utils.h"
 #include "audio_hw_compat.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_osal_errnos.h"
@@ -54,7 +56,7 @@ static void ameba_audio_stream_rx_sport_init(CaptureStream **stream, StreamConfi
 	cstream->stream.sp_initstruct.SP_SelFIFO = ameba_audio_get_fifo_num(config.channels);
 	cstream->stream.sp_initstruct.SP_SR = ameba_audio_get_sp_rate(config.rate);
 	cstream->stream.sp_initstruct.SP_SelDataFormat = AUDIO_I2S_IN_DATA_FORMAT;
-	HAL_AUDIO_VERBOSE("selmo:%lu, wordlen:%lu, sr:%lu, seltdm:%lu, selfifo:%lu,",
+	HAL_AUDIO_VERBOSE("selmo:%" PRIu32 ", wordlen:%" PRIu32 ", sr:%" PRIu32 ", seltdm:%" PRIu32 ", selfifo:%" PRIu32 ",",
 					  cstream->stream.sp_initstruct.SP_SelI2SMonoStereo,
 					  cstream->stream.sp_initstruct.SP_SelWordLen,
 					  cstream->stream.sp_initstruct.SP_SR,
@@ -207,9 +209,9 @@ static void ameba_audio_stream_rx_adc_eq_dump(void)
 	}
 
 	for (int i = 0; i < MAX_AD_EQ_NUM; i++) {
-		HAL_AUDIO_INFO("adc:%ld state:%ld", i, dc->eq_config_for_adc[i].state);
+		HAL_AUDIO_INFO("adc:%" PRId32 " state:%" PRId32 "", i, dc->eq_config_for_adc[i].state);
 		for (int j = 0; j < MAX_AD_BANS_NUM; j++) {
-			HAL_AUDIO_INFO("adc:%ld band:%ld state:%ld, b0:%lx, b1:%lx, b2:%lx, a1:%lx, a2:%lx",
+			HAL_AUDIO_INFO("adc:%" PRId32 " band:%" PRId32 " state:%" PRId32 ", b0:%" PRIx32 ", b1:%" PRIx32 ", b2:%" PRIx32 ", a1:%" PRIx32 ", a2:%" PRIx32 "",
 							i, j,
 							dc->eq_config_for_adc[i].bands_config[j].state,
 							dc->eq_config_for_adc[i].bands_config[j].coef.H0_Q,
@@ -448,7 +450,7 @@ static void stream_rx_llp_init(Stream *stream)
 		return;
 	}
 
-	uint32_t rx_addr = (uint32_t)(cstream->stream.rbuffer->raw_data);
+	uint32_t rx_addr = (uint32_t)(uintptr_t)(cstream->stream.rbuffer->raw_data);
 	for (j = 0; j < cstream->stream.period_count; j++) {
 		ch_lli[j].LliEle.Darx = (uint32_t)rx_addr + j * cstream->stream.period_bytes;
 
@@ -459,7 +461,7 @@ static void stream_rx_llp_init(Stream *stream)
 		}
 
 		ch_lli[j].BlockSize = cstream->stream.period_bytes / cstream->stream.config.frame_size; // 4_bytes / item
-		ch_lli[j].LliEle.Sarx = (uint32_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_RX_FIFO_0_RD_ADDR;
+		ch_lli[j].LliEle.Sarx = (uint32_t)(uintptr_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_RX_FIFO_0_RD_ADDR;
 	}
 }
 
@@ -710,7 +712,7 @@ Stream *ameba_audio_stream_rx_init(uint32_t device, StreamConfig config)
 	uint32_t irq = ameba_audio_get_sport_irq(cstream->stream.sport_dev_num);
 	InterruptDis(irq);
 	InterruptUnRegister(irq);
-	InterruptRegister((IRQ_FUN)ameba_audio_stream_rx_sport_interrupt, irq, (uint32_t)cstream, 4);
+	InterruptRegister((IRQ_FUN)ameba_audio_stream_rx_sport_interrupt, irq, (uint32_t)(uintptr_t)cstream, 4);
 	InterruptEn(irq, 4);
 
 	return &cstream->stream;
@@ -752,7 +754,7 @@ void ameba_audio_stream_rx_unmask_gdma_irq(Stream *stream)
 	cstream->stream.dma_irq_masked = false;
 }
 
-uint32_t ameba_audio_stream_rx_complete(void *data)
+static uint32_t ameba_audio_stream_rx_period_done(void *data, AudioIsrTraceEntry *trace)
 {
 	uint32_t rx_addr;
 	uint32_t rx_length;
@@ -770,27 +772,38 @@ uint32_t ameba_audio_stream_rx_complete(void *data)
 		ameba_audio_stream_buffer_update_rx_writeptr(cstream->stream.rbuffer, rx_length);
 
 		cstream->stream.gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(cstream->stream.rbuffer);
+		//sampled here, right after a period lands, a blocking Read would always see it drained.
+		ameba_audio_stream_stats_fill(&cstream->stream.stats, trace->fill_bytes);
 
 		if (cstream->stream.sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(cstream->stream.sem_gdma_end);
 			return 0;
 		}
 
 		if (ameba_audio_stream_buffer_get_available_size(cstream->stream.rbuffer) == 0) {
-			HAL_AUDIO_IRQ_INFO("buffer full, overrun");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
 			cstream->stream.restart_by_user = true;
+			//fifo0 and fifo1 overrun together, count the pair once.
+			if (!cstream->stream.extra_restart_by_user) {
+				ameba_audio_stream_stats_xrun(&cstream->stream.stats);
+			}
 			AUDIO_SP_SetPhaseLatch(cstream->stream.sport_dev_num);
 			cstream->stream.total_counter += AUDIO_SP_GetRXCounterVal(cstream->stream.sport_dev_num);
 			AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, DISABLE);
 		} else {
-			rx_addr = (uint32_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
+			rx_addr = (uint32_t)(uintptr_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
 
 			if (ameba_audio_stream_buffer_get_available_size(cstream->stream.rbuffer) >= rx_length) {
 				AUDIO_SP_RXGDMA_Restart(rxgdma_initstruct->GDMA_Index, rxgdma_initstruct->GDMA_ChNum, rx_addr, rx_length);
 				cstream->stream.gdma_cnt++;
 			} else {
-				HAL_AUDIO_IRQ_INFO("buffer near full, overrun");
+				trace->action = AUDIO_ISR_TRACE_XRUN;
 				cstream->stream.restart_by_user = true;
+				if (!cstream->stream.extra_restart_by_user) {
+					ameba_audio_stream_stats_xrun(&cstream->stream.stats);
+				}
 				AUDIO_SP_SetPhaseLatch(cstream->stream.sport_dev_num);
 				cstream->stream.total_counter += AUDIO_SP_GetRXCounterVal(cstream->stream.sport_dev_num);
 				AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, DISABLE);
@@ -799,32 +812,42 @@ uint32_t ameba_audio_stream_rx_complete(void *data)
 
 		if (cstream->stream.sem_need_post) {
 			rtos_sema_give(cstream->stream.sem);
+			trace->sem_posted = 1;
 		}
 	} else if (gdata->gdma_id == 1) {
 		rx_length = cstream->stream.period_bytes * cstream->stream.extra_channel / (cstream->stream.channel + cstream->stream.extra_channel);
 		ameba_audio_stream_buffer_update_rx_writeptr(cstream->stream.extra_rbuffer, rx_length);
 		cstream->stream.extra_gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(cstream->stream.extra_rbuffer);
 
 		if (cstream->stream.extra_sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(cstream->stream.extra_sem_gdma_end);
 			return 0;
 		}
 
 		if (ameba_audio_stream_buffer_get_available_size(cstream->stream.extra_rbuffer) == 0) {
-			HAL_AUDIO_IRQ_INFO("extra buffer full, overrun");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
 			cstream->stream.extra_restart_by_user = true;
+			//fifo0 and fifo1 overrun together, count the pair once.
+			if (!cstream->stream.restart_by_user) {
+				ameba_audio_stream_stats_xrun(&cstream->stream.stats);
+			}
 			AUDIO_SP_SetPhaseLatch(cstream->stream.sport_dev_num);
 			cstream->stream.total_counter += AUDIO_SP_GetRXCounterVal(cstream->stream.sport_dev_num);
 			AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, DISABLE);
 		} else {
-			rx_addr = (uint32_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
+			rx_addr = (uint32_t)(uintptr_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
 
 			if (ameba_audio_stream_buffer_get_available_size(cstream->stream.extra_rbuffer) >= rx_length) {
 				AUDIO_SP_RXGDMA_Restart(rxgdma_initstruct->GDMA_Index, rxgdma_initstruct->GDMA_ChNum, rx_addr, rx_length);
 				cstream->stream.extra_gdma_cnt++;
 			} else {
-				HAL_AUDIO_IRQ_INFO("extra buffer near full, overrun");
+				trace->action = AUDIO_ISR_TRACE_XRUN;
 				cstream->stream.extra_restart_by_user = true;
+				if (!cstream->stream.restart_by_user) {
+					ameba_audio_stream_stats_xrun(&cstream->stream.stats);
+				}
 				AUDIO_SP_SetPhaseLatch(cstream->stream.sport_dev_num);
 				cstream->stream.total_counter += AUDIO_SP_GetRXCounterVal(cstream->stream.sport_dev_num);
 				AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, DISABLE);
@@ -832,12 +855,25 @@ uint32_t ameba_audio_stream_rx_complete(void *data)
 		}
 		if (cstream->stream.extra_sem_need_post) {
 			rtos_sema_give(cstream->stream.extra_sem);
+			trace->sem_posted = 1;
 		}
 	}
 
 	return 0;
 }
 
+uint32_t ameba_audio_stream_rx_complete(void *data)
+{
+	GdmaCallbackData *gdata = (GdmaCallbackData *) data;
+	uint64_t enter_us = ameba_audio_stream_stats_isr_enter();
+	AudioIsrTraceEntry *trace = ameba_audio_isr_trace_begin(STREAM_IN, gdata->gdma_id);
+	uint32_t ret = ameba_audio_stream_rx_period_done(data, trace);
+
+	ameba_audio_isr_trace_end(trace);
+	ameba_audio_stream_stats_isr_exit(&gdata->stream->stats, enter_us);
+	return ret;
+}
+
 static void ameba_audio_stream_rx_start_in_noirq_mode(Stream *stream)
 {
 	CaptureStream *cstream = (CaptureStream *)stream;
@@ -869,18 +905,18 @@ static void ameba_audio_stream_rx_start_in_irq_mode(Stream *stream)
 	if (!cstream->stream.start_gdma) {
 		uint32_t rx_addr;
 		uint32_t len = cstream->stream.period_bytes * cstream->stream.channel / (cstream->stream.channel + cstream->stream.extra_channel);
-		rx_addr = (uint32_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
+		rx_addr = (uint32_t)(uintptr_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
 		AUDIO_SP_RXGDMA_Init(cstream->stream.sport_dev_num, GDMA_INT, sp_rxgdma_initstruct, cstream->stream.gdma_struct,
-							 (IRQ_FUN)ameba_audio_stream_rx_complete, (u8 *)rx_addr, len);
+							 (IRQ_FUN)ameba_audio_stream_rx_complete, (u8 *)(uintptr_t)rx_addr, len);
 		cstream->stream.gdma_cnt++;
 
 		if (cstream->stream.extra_channel) {
 			uint32_t extra_rx_addr;
 			uint32_t extra_len = cstream->stream.period_bytes * cstream->stream.extra_channel / (cstream->stream.channel + cstream->stream.extra_channel);
-			extra_rx_addr = (uint32_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
+			extra_rx_addr = (uint32_t)(uintptr_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
 			PGDMA_InitTypeDef extra_sp_rxgdma_initstruct = &(cstream->stream.extra_gdma_struct->u.SpRxGdmaInitStruct);
 			AUDIO_SP_RXGDMA_Init(cstream->stream.sport_dev_num, GDMA_EXT, extra_sp_rxgdma_initstruct, cstream->stream.extra_gdma_struct,
-								 (IRQ_FUN)ameba_audio_stream_rx_complete, (u8 *)extra_rx_addr, extra_len);
+								 (IRQ_FUN)ameba_audio_stream_rx_complete, (u8 *)(uintptr_t)extra_rx_addr, extra_len);
 			cstream->stream.extra_gdma_cnt++;
 		}
 
@@ -900,7 +936,7 @@ static void ameba_audio_stream_rx_start_in_irq_mode(Stream *stream)
 	ameba_audio_dump_codec_regs();
 #endif
 
-	HAL_AUDIO_INFO("rx start at:%lldns", cstream->stream.trigger_tstamp);
+	HAL_AUDIO_INFO("rx start at:%" PRIu64 "ns", cstream->stream.trigger_tstamp);
 
 }
 
@@ -936,7 +972,7 @@ static void ameba_audio_stream_rx_check_and_start_gdma(CaptureStream *cstream)
 		uint32_t bytes = cstream->stream.period_bytes * cstream->stream.channel / (cstream->stream.channel + cstream->stream.extra_channel);
 		if (ameba_audio_stream_buffer_get_available_size(cstream->stream.rbuffer) >= bytes) {
 			GDMA_InitTypeDef sp_rxgdma_initstruct = cstream->stream.gdma_struct->u.SpRxGdmaInitStruct;
-			rx_addr = (uint32_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
+			rx_addr = (uint32_t)(uintptr_t)(cstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.rbuffer));
 			cstream->stream.restart_by_user = false;
 			AUDIO_SP_RXGDMA_Restart(sp_rxgdma_initstruct.GDMA_Index, sp_rxgdma_initstruct.GDMA_ChNum, rx_addr, bytes);
 			AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, ENABLE);
@@ -951,7 +987,7 @@ static void ameba_audio_stream_rx_check_and_start_gdma(CaptureStream *cstream)
 
 		if (ameba_audio_stream_buffer_get_available_size(cstream->stream.extra_rbuffer) >= extra_bytes) {
 			GDMA_InitTypeDef extra_sp_rxgdma_initstruct = cstream->stream.extra_gdma_struct->u.SpRxGdmaInitStruct;
-			extra_rx_addr = (uint32_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
+			extra_rx_addr = (uint32_t)(uintptr_t)(cstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_rx_writeptr(cstream->stream.extra_rbuffer));
 			cstream->stream.extra_restart_by_user = false;
 			AUDIO_SP_RXGDMA_Restart(extra_sp_rxgdma_initstruct.GDMA_Index, extra_sp_rxgdma_initstruct.GDMA_ChNum, extra_rx_addr, extra_bytes);
 			AUDIO_SP_SetRXCounter(cstream->stream.sport_dev_num, ENABLE);
@@ -974,7 +1010,7 @@ static int32_t ameba_audio_stream_rx_read_in_noirq_mode(Stream *stream, void *da
 	PGDMA_InitTypeDef sp_rxgdma_initstruct = &(cstream->stream.gdma_struct->u.SpRxGdmaInitStruct);
 
 	while (bytes_to_read_0 != 0) {
-		uint32_t rp = (uint32_t)(cstream->stream.rbuffer->raw_data + cstream->stream.rbuffer->read_ptr);
+		uint32_t rp = (uint32_t)(uintptr_t)(cstream->stream.rbuffer->raw_data + cstream->stream.rbuffer->read_ptr);
 		uint32_t capacity = cstream->stream.rbuffer->capacity;
 		uint32_t dma_addr = GDMA_GetDstAddr(sp_rxgdma_initstruct->GDMA_Index, sp_rxgdma_initstruct->GDMA_ChNum);
 		uint32_t avail = (rp <= dma_addr) ? (dma_addr - rp) : (capacity - (rp - dma_addr));
@@ -1017,7 +1053,7 @@ static int32_t ameba_audio_stream_rx_read_in_irq_mode(Stream *stream, void *data
 
 		if (ameba_audio_stream_buffer_get_remain_size(cstream->stream.rbuffer) < bytes_to_read) {
 			cstream->stream.sem_need_post = true;
-			int32_t sem_ret = rtos_sema_take(cstream->stream.sem, time_out_ms);
+			int32_t sem_ret = ameba_audio_stream_stats_sema_take(&cstream->stream.stats, cstream->stream.sem, time_out_ms);
 			if (sem_ret < 0) {
 				ret = HAL_OSAL_ERR_TIMED_OUT;
 				break;
@@ -1043,7 +1079,7 @@ static int32_t ameba_audio_stream_rx_read_in_irq_mode(Stream *stream, void *data
 
 			if (ameba_audio_stream_buffer_get_remain_size(cstream->stream.extra_rbuffer) < extra_bytes_to_read) {
 				cstream->stream.extra_sem_need_post = true;
-				int sem_ret = rtos_sema_take(cstream->stream.extra_sem, time_out_ms);
+				int sem_ret = ameba_audio_stream_stats_sema_take(&cstream->stream.stats, cstream->stream.extra_sem, time_out_ms);
 				if (sem_ret < 0) {
 					ret = HAL_OSAL_ERR_TIMED_OUT;
 					break;
@@ -1060,12 +1096,8 @@ static int32_t ameba_audio_stream_rx_read_in_irq_mode(Stream *stream, void *data
 
 	if (cstream->stream.extra_channel) {
 		if (ret >= 0) {
-			uint32_t idx = 0;
-			for (; idx < bytes / cstream->stream.config.frame_size; idx++) {
-				memcpy((char *)data + idx * cstream->stream.config.frame_size, p_buf + idx * cstream->stream.frame_size, cstream->stream.frame_size);
-				memcpy((char *)data + idx * cstream->stream.config.frame_size + cstream->stream.frame_size,
-					p_extra_buf + idx * cstream->stream.extra_frame_size, cstream->stream.extra_frame_size);
-			}
+			audio_hw_channel_interleave(data, p_buf, cstream->stream.channel, p_extra_buf, cstream->stream.extra_channel,
+											bytes / cstream->stream.config.frame_size, cstream->stream.frame_size / cstream->stream.channel);
 		}
 
 		if (p_buf) {
@@ -1082,16 +1114,82 @@ static int32_t ameba_audio_stream_rx_read_in_irq_mode(Stream *stream, void *data
 int32_t ameba_audio_stream_rx_read(Stream *stream, void *data, uint32_t bytes, uint32_t time_out_ms)
 {
 	CaptureStream *cstream = (CaptureStream *)stream;
+	int32_t ret = 0;
 
 	if (cstream) {
 		if (cstream->stream.stream_mode) {
-			return ameba_audio_stream_rx_read_in_noirq_mode(stream, data, bytes);
+			ret = ameba_audio_stream_rx_read_in_noirq_mode(stream, data, bytes);
 		} else {
-			return ameba_audio_stream_rx_read_in_irq_mode(stream, data, bytes, time_out_ms);
+			ret = ameba_audio_stream_rx_read_in_irq_mode(stream, data, bytes, time_out_ms);
+		}
+		if (ret > 0) {
+			cstream->stream.stats.bytes += ret;
 		}
 	}
 
-	return 0;
+	return ret;
+}
+
+int32_t ameba_audio_stream_rx_acquire_region(Stream *stream, void **region, uint32_t bytes, uint32_t time_out_ms)
+{
+	CaptureStream *cstream = (CaptureStream *)stream;
+	uint32_t wanted;
+	uint32_t size;
+
+	if (!stream || !region) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	//noirq mode and the fifo0/fifo1 merge of 6/8 channels need hal to copy the data.
+	if (cstream->stream.stream_mode || cstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	bytes -= bytes % cstream->stream.frame_size;
+	//the region can't cross the wrap point, so only wait for the data before it.
+	wanted = cstream->stream.rbuffer->capacity - cstream->stream.rbuffer->read_ptr;
+	if (wanted > bytes) {
+		wanted = bytes;
+	}
+
+	ameba_audio_stream_rx_check_and_start_gdma(cstream);
+	if (ameba_audio_stream_buffer_get_remain_size(cstream->stream.rbuffer) < wanted) {
+		cstream->stream.sem_need_post = true;
+		int32_t sem_ret = ameba_audio_stream_stats_sema_take(&cstream->stream.stats, cstream->stream.sem, time_out_ms);
+		cstream->stream.sem_need_post = false;
+		if (sem_ret < 0) {
+			return HAL_OSAL_ERR_TIMED_OUT;
+		}
+	}
+
+	ameba_audio_stream_rx_mask_gdma_irq(stream);
+	size = ameba_audio_stream_buffer_acquire_read_region(cstream->stream.rbuffer, region, wanted);
+	ameba_audio_stream_rx_unmask_gdma_irq(stream);
+
+	return size - size % cstream->stream.frame_size;
+}
+
+int32_t ameba_audio_stream_rx_commit_region(Stream *stream, uint32_t bytes)
+{
+	CaptureStream *cstream = (CaptureStream *)stream;
+
+	if (!stream) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	if (cstream->stream.stream_mode || cstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	ameba_audio_stream_rx_mask_gdma_irq(stream);
+	bytes = ameba_audio_stream_buffer_commit_read(cstream->stream.rbuffer, bytes);
+	ameba_audio_stream_rx_unmask_gdma_irq(stream);
+	cstream->stream.stats.bytes += bytes;
+
+	//gdma may stop for overrun, restart it now the space is freed.
+	ameba_audio_stream_rx_check_and_start_gdma(cstream);
+
+	return bytes;
 }
 
 HAL_AUDIO_WEAK void ameba_audio_stream_rx_stop(Stream *stream)
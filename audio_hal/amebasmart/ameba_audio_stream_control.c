@@ -163,7 +163,7 @@ int32_t ameba_audio_ctl_set_tx_volume(StreamControl *control, float left, float
 	}
 
 	if (control->volume_for_dacl != l) {
-		HAL_AUDIO_INFO("set dacl volume to 0x%lx", l);
+		HAL_AUDIO_INFO("set dacl volume to 0x%" PRIx32 "", l);
 		control->volume_for_dacl = l;
 		if (ameba_audio_is_audio_ip_in_use(CODEC)) {
 			AUDIO_CODEC_SetDACVolume(DAC_L, l);
@@ -171,7 +171,7 @@ int32_t ameba_audio_ctl_set_tx_volume(StreamControl *control, float left, float
 	}
 
 	if (control->volume_for_dacr != r) {
-		HAL_AUDIO_INFO("set dacr volume to 0x%lx", r);
+		HAL_AUDIO_INFO("set dacr volume to 0x%" PRIx32 "", r);
 		control->volume_for_dacr = r;
 		if (ameba_audio_is_audio_ip_in_use(CODEC)) {
 			AUDIO_CODEC_SetDACVolume(DAC_R, r);
@@ -381,7 +381,7 @@ int32_t ameba_audio_ctl_set_mic_category_for_adc(StreamControl *control, uint32_
 	}
 
 	if (channel >= MAX_AD_NUM) {
-		HAL_AUDIO_ERROR("ops, channel(%lu) out of range", channel);
+		HAL_AUDIO_ERROR("ops, channel(%" PRIu32 ") out of range", channel);
 		return HAL_OSAL_ERR_INVALID_OPERATION;
 	}
 
@@ -413,7 +413,7 @@ int32_t ameba_audio_ctl_set_adc_volume(StreamControl *control, uint32_t channel,
 	}
 
 	if (channel >= MAX_AD_NUM) {
-		HAL_AUDIO_ERROR("ops, channel(%lu) out of range", channel);
+		HAL_AUDIO_ERROR("ops, channel(%" PRIu32 ") out of range", channel);
 		return HAL_OSAL_ERR_INVALID_OPERATION;
 	}
 
@@ -444,7 +444,7 @@ int32_t ameba_audio_ctl_set_tdm_adc_volume(StreamControl *control, uint32_t chan
 	}
 
 	if (channels > MAX_AD_NUM) {
-		HAL_AUDIO_ERROR("ops, channels(%lu) out of range", channels);
+		HAL_AUDIO_ERROR("ops, channels(%" PRIu32 ") out of range", channels);
 		return HAL_OSAL_ERR_INVALID_OPERATION;
 	}
 
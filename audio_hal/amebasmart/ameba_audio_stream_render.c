@@ -22,9 +22,11 @@
 #include "ameba_audio_stream_control.h"
 #include "ameba_audio_stream_utils.h"
 #include "ameba_audio_stream_buffer.h"
+#include "ameba_audio_isr_trace.h"
 #include "ameba_audio_types.h"
 #include "ameba_audio_hw_usrcfg.h"
 
+#include "audio_hw_channel_utils.h"
 #include "audio_hw_compat.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_osal_errnos.h"
@@ -43,6 +45,17 @@ static uint64_t s_dma_frames = 0;
 
 #define FIFO_BYTES 32*4
 
+/*
+ * set to 1 to compare the cost of splitting 6/8 channel frames directly into the
+ * fifo0/fifo1 rings against the former calloc + memcpy + free path.
+ */
+#define DEBUG_SPLIT_COST  0
+#if DEBUG_SPLIT_COST
+static uint64_t s_split_ns = 0;
+static uint64_t s_legacy_split_ns = 0;
+static uint32_t s_split_cnt = 0;
+#endif
+
 int32_t ameba_audio_stream_tx_set_amp_state(bool state)
 {
 	StreamControl *control = ameba_audio_get_ctl();
@@ -326,9 +339,9 @@ static void ameba_audio_stream_tx_gdma_init(uint32_t index, uint32_t sel_gdma, G
 	uint8_t gdma_channel;
 
 	assert_param(gdma_initstruct != NULL);
-	DCache_CleanInvalidate((uint32_t)mem_addr, Length);
+	DCache_CleanInvalidate((uint32_t)(uintptr_t)mem_addr, Length);
 	/*obtain a DMA channel and register DMA interrupt handler*/
-	gdma_channel = GDMA_ChnlAlloc(0, callback_func, (uint32_t)callback_data, INT_PRI_MIDDLE);
+	gdma_channel = GDMA_ChnlAlloc(0, callback_func, (uint32_t)(uintptr_t)callback_data, INT_PRI_MIDDLE);
 	if (gdma_channel == 0xFF) {
 		// No Available DMA channel
 		HAL_AUDIO_ERROR("tx gdma init fail.");
@@ -343,10 +356,10 @@ static void ameba_audio_stream_tx_gdma_init(uint32_t index, uint32_t sel_gdma, G
 	gdma_initstruct->GDMA_DIR = TTFCMemToPeri;
 	if (sel_gdma == GDMA_INT) {
 		gdma_initstruct->GDMA_DstHandshakeInterface = AUDIO_DEV_TABLE[index].Tx_HandshakeInterface;
-		gdma_initstruct->GDMA_DstAddr = (uint32_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_TX_FIFO_0_WR_ADDR;
+		gdma_initstruct->GDMA_DstAddr = (uint32_t)(uintptr_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_TX_FIFO_0_WR_ADDR;
 	} else {
 		gdma_initstruct->GDMA_DstHandshakeInterface = AUDIO_DEV_TABLE[index].Tx_HandshakeInterface1;
-		gdma_initstruct->GDMA_DstAddr = (uint32_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_TX_FIFO_1_WR_ADDR;
+		gdma_initstruct->GDMA_DstAddr = (uint32_t)(uintptr_t)&AUDIO_DEV_TABLE[index].SPORTx->SP_TX_FIFO_1_WR_ADDR;
 	}
 	gdma_initstruct->GDMA_Index = 0;
 	gdma_initstruct->GDMA_ChNum = gdma_channel;
@@ -358,24 +371,24 @@ static void ameba_audio_stream_tx_gdma_init(uint32_t index, uint32_t sel_gdma, G
 
 	/*	Cofigure GDMA transfer */
 	/*	24bits or 16bits mode */
-	if (((Length & 0x03) == 0) && (((uint32_t)(mem_addr) & 0x03) == 0)) {
+	if (((Length & 0x03) == 0) && (((uint32_t)(uintptr_t)(mem_addr) & 0x03) == 0)) {
 		/*	4-bytes aligned, move 4 bytes each transfer */
 		gdma_initstruct->GDMA_SrcMsize = MsizeFour;
 		gdma_initstruct->GDMA_SrcDataWidth = TrWidthFourBytes;
 		gdma_initstruct->GDMA_BlockSize = Length >> 2;
-	} else if (((Length & 0x01) == 0) && (((uint32_t)(mem_addr) & 0x01) == 0)) {
+	} else if (((Length & 0x01) == 0) && (((uint32_t)(uintptr_t)(mem_addr) & 0x01) == 0)) {
 		/*	2-bytes aligned, move 2 bytes each transfer */
 		gdma_initstruct->GDMA_SrcMsize = MsizeEight;
 		gdma_initstruct->GDMA_SrcDataWidth = TrWidthTwoBytes;
 		gdma_initstruct->GDMA_BlockSize = Length >> 1;
 	} else {
-		HAL_AUDIO_ERROR("Aligment Err: mem_addr=%p, length=%lu\n", mem_addr, Length);
+		HAL_AUDIO_ERROR("Aligment Err: mem_addr=%p, length=%" PRIu32 "\n", mem_addr, Length);
 	}
 	gdma_initstruct->GDMA_DstMsize = MsizeFour;
 	gdma_initstruct->GDMA_DstDataWidth = TrWidthFourBytes;
 
 	/*configure GDMA source address */
-	gdma_initstruct->GDMA_SrcAddr = (uint32_t)mem_addr;
+	gdma_initstruct->GDMA_SrcAddr = (uint32_t)(uintptr_t)mem_addr;
 
 	GDMA_Init(gdma_initstruct->GDMA_Index, gdma_initstruct->GDMA_ChNum, gdma_initstruct);
 
@@ -396,7 +409,7 @@ static void ameba_audio_stream_tx_sport_init(RenderStream **stream, StreamConfig
 	rstream->stream.sp_initstruct.SP_SelTDM = ameba_audio_get_sp_tdm(config.channels);
 	rstream->stream.sp_initstruct.SP_SelFIFO = ameba_audio_get_fifo_num(config.channels);
 	rstream->stream.sp_initstruct.SP_SelDataFormat = AUDIO_I2S_OUT_DATA_FORMAT;
-	HAL_AUDIO_VERBOSE("selmo:%lu, wordlen:%lu, sr:%lu, seltdm:%lu, selfifo:%lu,",
+	HAL_AUDIO_VERBOSE("selmo:%" PRIu32 ", wordlen:%" PRIu32 ", sr:%" PRIu32 ", seltdm:%" PRIu32 ", selfifo:%" PRIu32 ",",
 					  rstream->stream.sp_initstruct.SP_SelI2SMonoStereo,
 					  rstream->stream.sp_initstruct.SP_SelWordLen,
 					  rstream->stream.sp_initstruct.SP_SR,
@@ -513,7 +526,7 @@ static void ameba_audio_stream_tx_codec_init(RenderStream **stream, StreamConfig
 		ameba_audo_stream_tx_codec_configure(I2S0, APP_HPO_OUT, config.channels, &rstream->stream.i2s_initstruct);
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported device:%ld", ameba_audio_ctl_get_device_category(ameba_audio_get_ctl()));
+		HAL_AUDIO_ERROR("unsupported device:%" PRId32 "", ameba_audio_ctl_get_device_category(ameba_audio_get_ctl()));
 		break;
 	}
 }
@@ -528,14 +541,14 @@ static void ameba_audio_stream_tx_llp_init(Stream *stream)
 	HAL_AUDIO_INFO("ameba_audio_stream_tx_llp_init, period_count: %" PRId32 ", frame_size: %" PRId32 "", rstream->stream.period_count, rstream->stream.frame_size);
 
 	uint32_t j;
-	uint32_t tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data);
-
-	for (j = 0; j < rstream->stream.period_count; j++) {
+	uint32_t tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data);
 
-		DCache_CleanInvalidate(((uint32_t)tx_addr + j * rstream->stream.period_bytes), (rstream->stream.period_bytes + CACHE_LINE_SIZE));
+	//the ring is contiguous, one clean for all the periods.
+	DCache_Clean(tx_addr, rstream->stream.period_bytes * rstream->stream.period_count);
 
+	for (j = 0; j < rstream->stream.period_count; j++) {
 		ch_lli[j].LliEle.Sarx = (uint32_t)tx_addr + j * rstream->stream.period_bytes;
-		HAL_AUDIO_VERBOSE("ameba_audio_stream_tx_llp_init, addr: %lx", ch_lli[j].LliEle.Sarx);
+		HAL_AUDIO_VERBOSE("ameba_audio_stream_tx_llp_init, addr: %" PRIx32 "", ch_lli[j].LliEle.Sarx);
 
 		if (j == rstream->stream.period_count - 1) {
 			ch_lli[j].pNextLli = &ch_lli[0];
@@ -545,7 +558,7 @@ static void ameba_audio_stream_tx_llp_init(Stream *stream)
 
 		//ch_lli[j].BlockSize = rstream->stream.period_bytes >> 2;
 		ch_lli[j].BlockSize = rstream->stream.period_bytes / rstream->stream.frame_size;
-		ch_lli[j].LliEle.Darx = (uint32_t)&AUDIO_DEV_TABLE[0].SPORTx->SP_TX_FIFO_0_WR_ADDR;
+		ch_lli[j].LliEle.Darx = (uint32_t)(uintptr_t)&AUDIO_DEV_TABLE[0].SPORTx->SP_TX_FIFO_0_WR_ADDR;
 	}
 }
 
@@ -716,13 +729,15 @@ Stream *ameba_audio_stream_tx_init(uint32_t device, StreamConfig config)
 
 	if (rstream->stream.stream_mode == AMEBA_AUDIO_DMA_NOIRQ_MODE) {
 		ameba_audio_stream_tx_llp_init(&rstream->stream);
+		//gdma runs the ring by itself, clean the written lines once per period instead of per write.
+		ameba_audio_stream_buffer_set_cache_defer(rstream->stream.rbuffer, true);
 	}
 
 	//enable sport interrupt
 	uint32_t irq = ameba_audio_get_sport_irq(rstream->stream.sport_dev_num);
 	InterruptDis(irq);
 	InterruptUnRegister(irq);
-	InterruptRegister((IRQ_FUN)ameba_audio_stream_tx_sport_interrupt, irq, (uint32_t)rstream, 4);
+	InterruptRegister((IRQ_FUN)ameba_audio_stream_tx_sport_interrupt, irq, (uint32_t)(uintptr_t)rstream, 4);
 	InterruptEn(irq, 4);
 
 	rstream->stream.state = STATE_INITED;
@@ -779,7 +794,7 @@ int32_t ameba_audio_stream_tx_get_buffer_status(Stream *stream)
 	uint32_t remain = 0;
 
 	if (rstream->stream.stream_mode == AMEBA_AUDIO_DMA_NOIRQ_MODE) {
-		uint32_t wr = (uint32_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
+		uint32_t wr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
 		uint32_t capacity = rstream->stream.rbuffer->capacity;
 		uint32_t dma_addr = GDMA_GetSrcAddr(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum);
 		remain = (wr < dma_addr) ? (capacity - (dma_addr - wr)) : (wr - dma_addr);
@@ -834,7 +849,7 @@ HAL_AUDIO_WEAK void ameba_audio_stream_tx_start(Stream *stream, int32_t state)
 
 	rstream->stream.state = state;
 
-	HAL_AUDIO_INFO("tx start at:%lldns", rstream->stream.trigger_tstamp);
+	HAL_AUDIO_INFO("tx start at:%" PRIu64 "ns", rstream->stream.trigger_tstamp);
 
 }
 
@@ -941,8 +956,7 @@ void ameba_audio_stream_tx_standby(Stream *stream)
 	ameba_audio_stream_tx_stop(stream, STATE_STANDBY);
 }
 
-//gdma done moving one period size data IRQ. Data is gdma_cb_data
-uint32_t ameba_audio_stream_tx_complete(void *data)
+static uint32_t ameba_audio_stream_tx_period_done(void *data, AudioIsrTraceEntry *trace)
 {
 	uint32_t tx_addr;
 	uint32_t tx_length;
@@ -961,8 +975,10 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 		tx_length = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
 		ameba_audio_stream_buffer_update_tx_readptr(rstream->stream.rbuffer, tx_length);
 		rstream->stream.gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer);
 
 		if (rstream->stream.sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(rstream->stream.sem_gdma_end);
 			return 0;
 		}
@@ -971,25 +987,30 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 			ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) < tx_length) {
 			rstream->stream.multi_dma_xrun_mask |= DMA_XRUN;
 			if (rstream->stream.extra_channel && ((rstream->stream.multi_dma_xrun_mask & EXTRA_DMA_XRUN) == 0)) {
+				trace->action = AUDIO_ISR_TRACE_WAIT_PEER;
 				return 0;
 			}
-			DiagPrintf("underrun \n");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
+			ameba_audio_stream_stats_xrun(&rstream->stream.stats);
 			ameba_audio_stream_tx_stop(gdata->stream, STATE_XRUN);
 		} else {
-			tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
 			ameba_audio_stream_tx_gdma_restart(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum, tx_addr, tx_length);
 			rstream->stream.gdma_cnt++;
 		}
 
 		if (rstream->stream.sem_need_post) {
 			rtos_sema_give(rstream->stream.sem);
+			trace->sem_posted = 1;
 		}
 	} else if (gdata->gdma_id == 1) {
 		extra_tx_length = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
 		ameba_audio_stream_buffer_update_tx_readptr(rstream->stream.extra_rbuffer, extra_tx_length);
 		rstream->stream.extra_gdma_irq_cnt++;
+		trace->fill_bytes = ameba_audio_stream_buffer_get_remain_size(rstream->stream.extra_rbuffer);
 
 		if (rstream->stream.extra_sem_gdma_end_need_post) {
+			trace->action = AUDIO_ISR_TRACE_END;
 			rtos_sema_give(rstream->stream.extra_sem_gdma_end);
 			return 0;
 		}
@@ -998,24 +1019,40 @@ uint32_t ameba_audio_stream_tx_complete(void *data)
 			ameba_audio_stream_buffer_get_remain_size(rstream->stream.extra_rbuffer) < extra_tx_length) {
 			rstream->stream.multi_dma_xrun_mask |= EXTRA_DMA_XRUN;
 			if ((rstream->stream.multi_dma_xrun_mask & DMA_XRUN) == 0) {
+				trace->action = AUDIO_ISR_TRACE_WAIT_PEER;
 				return 0;
 			}
-			DiagPrintf("extra underrun \n");
+			trace->action = AUDIO_ISR_TRACE_XRUN;
+			ameba_audio_stream_stats_xrun(&rstream->stream.stats);
 			ameba_audio_stream_tx_stop(gdata->stream, STATE_XRUN);
 		} else {
-			extra_tx_addr = (uint32_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+			extra_tx_addr = (uint32_t)(uintptr_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
 			ameba_audio_stream_tx_gdma_restart(txgdma_initstruct->GDMA_Index, txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_tx_length);
 			rstream->stream.extra_gdma_cnt++;
 		}
 
 		if (rstream->stream.extra_sem_need_post) {
 			rtos_sema_give(rstream->stream.extra_sem);
+			trace->sem_posted = 1;
 		}
 	}
 
 	return 0;
 }
 
+//gdma done moving one period size data IRQ. Data is gdma_cb_data
+uint32_t ameba_audio_stream_tx_complete(void *data)
+{
+	GdmaCallbackData *gdata = (GdmaCallbackData *) data;
+	uint64_t enter_us = ameba_audio_stream_stats_isr_enter();
+	AudioIsrTraceEntry *trace = ameba_audio_isr_trace_begin(STREAM_OUT, gdata->gdma_id);
+	uint32_t ret = ameba_audio_stream_tx_period_done(data, trace);
+
+	ameba_audio_isr_trace_end(trace);
+	ameba_audio_stream_stats_isr_exit(&gdata->stream->stats, enter_us);
+	return ret;
+}
+
 static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
 	uint32_t bytes_left_to_write = bytes;
@@ -1026,7 +1063,7 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 
 	while (bytes_left_to_write != 0) {
 		if (rstream->stream.start_gdma) {
-			uint32_t wr = (uint32_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
+			uint32_t wr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + rstream->stream.rbuffer->write_ptr);
 			uint32_t capacity = rstream->stream.rbuffer->capacity;
 			uint32_t dma_addr = GDMA_GetSrcAddr(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum);
 			uint32_t avail = (wr < dma_addr) ? (dma_addr - wr) : (capacity - (wr - dma_addr));
@@ -1034,6 +1071,10 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 			if (avail > bytes_left_to_write) {
 				bytes_written = ameba_audio_stream_buffer_write_in_noirq_mode(rstream->stream.rbuffer, (uint8_t *)data + bytes - bytes_left_to_write, bytes_left_to_write,
 								rstream->stream.period_bytes);
+				//gdma is less than two periods behind, it may reach this period before it ends.
+				if (capacity - avail + bytes_written < 2 * rstream->stream.period_bytes) {
+					ameba_audio_stream_buffer_sync_cache(rstream->stream.rbuffer);
+				}
 			} else if (!block) { // non-block mode
 				HAL_AUDIO_INFO("stream_tx_write no buffer available in non-block mode\n");
 				return bytes - bytes_left_to_write;
@@ -1048,6 +1089,8 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 							   ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer));
 			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) >= rstream->stream.period_bytes) {
 
+				//lines still dirty in defer mode must reach memory before gdma reads them.
+				ameba_audio_stream_buffer_sync_cache(rstream->stream.rbuffer);
 				AUDIO_SP_LLPTXGDMA_Init(rstream->stream.sport_dev_num, GDMA_INT, sp_txgdma_initstruct, rstream->stream.gdma_struct,
 										(IRQ_FUN)NULL,
 										rstream->stream.period_bytes, rstream->stream.period_count, rstream->stream.gdma_ch_lli);
@@ -1067,6 +1110,150 @@ static int32_t ameba_audio_stream_tx_write_in_noirq_mode(Stream *stream, const v
 	return bytes;
 }
 
+/*
+ * deinterleave frames straight into the two dma rings: the first frame_size bytes
+ * of each frame go to rbuffer(fifo0), the remaining extra_frame_size bytes go to
+ * extra_rbuffer(fifo1). Both rings share the same period layout, so they always
+ * advance and wrap by the same number of frames.
+ * return the frames written, limited by the free space of both rings.
+ * gdma irq should be masked by caller, because size_remain is updated in irq.
+ */
+static uint32_t ameba_audio_stream_tx_split_write(RenderStream *rstream, const void *data, uint32_t frames)
+{
+	AudioBuffer *buffer = rstream->stream.rbuffer;
+	AudioBuffer *extra_buffer = rstream->stream.extra_rbuffer;
+	uint32_t frame_size = rstream->stream.frame_size;
+	uint32_t extra_frame_size = rstream->stream.extra_frame_size;
+	uint32_t sample_bytes = frame_size / rstream->stream.channel;
+	const uint8_t *src = (const uint8_t *)data;
+	uint32_t avail;
+	uint32_t extra_avail;
+	uint32_t frames_to_write;
+	uint32_t frames_left;
+
+	avail = ameba_audio_stream_buffer_get_available_size(buffer) / frame_size;
+	extra_avail = ameba_audio_stream_buffer_get_available_size(extra_buffer) / extra_frame_size;
+	frames_to_write = avail < extra_avail ? avail : extra_avail;
+	frames_to_write = frames < frames_to_write ? frames : frames_to_write;
+	frames_left = frames_to_write;
+
+	while (frames_left != 0) {
+		uint32_t contiguous = (buffer->capacity - buffer->write_ptr) / frame_size;
+		uint32_t extra_contiguous = (extra_buffer->capacity - extra_buffer->write_ptr) / extra_frame_size;
+		uint32_t chunk = contiguous < extra_contiguous ? contiguous : extra_contiguous;
+		chunk = frames_left < chunk ? frames_left : chunk;
+
+		audio_hw_channel_deinterleave(buffer->raw_data + buffer->write_ptr, rstream->stream.channel,
+									  extra_buffer->raw_data + extra_buffer->write_ptr, rstream->stream.extra_channel,
+									  src, chunk, sample_bytes);
+
+		src += chunk * rstream->stream.config.frame_size;
+		buffer->write_ptr += chunk * frame_size;
+		if (buffer->write_ptr == buffer->capacity) {
+			buffer->write_ptr = 0;
+		}
+		extra_buffer->write_ptr += chunk * extra_frame_size;
+		if (extra_buffer->write_ptr == extra_buffer->capacity) {
+			extra_buffer->write_ptr = 0;
+		}
+		frames_left -= chunk;
+	}
+
+	buffer->size_remain += frames_to_write * frame_size;
+	extra_buffer->size_remain += frames_to_write * extra_frame_size;
+
+	return frames_to_write;
+}
+
+#if DEBUG_SPLIT_COST
+/* the former split path, only kept to measure what the direct split saves. */
+static void ameba_audio_stream_tx_legacy_split(RenderStream *rstream, const void *data, uint32_t bytes)
+{
+	uint32_t total_bytes = bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
+	uint32_t extra_total_bytes = bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
+	char *p_buf = (char *)rtos_mem_calloc(total_bytes, sizeof(char));
+	char *p_extra_buf = (char *)rtos_mem_calloc(extra_total_bytes, sizeof(char));
+	uint32_t idx = 0;
+
+	if (p_buf && p_extra_buf) {
+		for (; idx < bytes / rstream->stream.config.frame_size; idx++) {
+			memcpy(p_buf + idx * rstream->stream.frame_size, (char *)data + idx * rstream->stream.config.frame_size, rstream->stream.frame_size);
+			memcpy(p_extra_buf + idx * rstream->stream.extra_frame_size, (char *)data + idx * rstream->stream.config.frame_size + rstream->stream.frame_size,
+				   rstream->stream.extra_frame_size);
+		}
+	}
+
+	if (p_buf) {
+		rtos_mem_free(p_buf);
+	}
+	if (p_extra_buf) {
+		rtos_mem_free(p_extra_buf);
+	}
+}
+#endif
+
+/*start or restart gdma once there is enough data in the ring, gdma irq should be masked.*/
+static void ameba_audio_stream_tx_check_and_start_gdma(Stream *stream, bool has_extra_dma)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+
+	uint32_t tx_addr;
+	PGDMA_InitTypeDef sp_txgdma_initstruct = &(rstream->stream.gdma_struct->u.SpTxGdmaInitStruct);
+	uint32_t dma_len = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
+
+	uint32_t extra_tx_addr = 0;
+	PGDMA_InitTypeDef extra_sp_txgdma_initstruct = &(rstream->stream.extra_gdma_struct->u.SpTxGdmaInitStruct);
+	uint32_t extra_dma_len = 0;
+
+	if (has_extra_dma) {
+		extra_dma_len = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
+	}
+
+	if (rstream->stream.state == STATE_INITED) {
+		if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			GDMA_Cmd(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, ENABLE);
+			rstream->stream.gdma_cnt++;
+			HAL_AUDIO_INFO("gdma start: index:%d, chNum:%d, tx_addr:0x%" PRIx32 ", dma_len:%" PRIu32 "",
+						   sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
+
+			if (has_extra_dma) {
+				GDMA_Cmd(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, ENABLE);
+				rstream->stream.extra_gdma_cnt++;
+				HAL_AUDIO_INFO("gdma extra init: index:%d, chNum:%d, tx_addr:0x%" PRIx32 ", extra_dma_len:%" PRIu32 "",
+							   extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
+			}
+			rstream->stream.start_gdma = true;
+
+			ameba_audio_stream_tx_start(stream, STATE_STARTED);
+
+#if HAL_AUDIO_PLAYBACK_DUMP_DEBUG
+			ameba_audio_dump_gdma_regs(sp_txgdma_initstruct->GDMA_ChNum);
+			ameba_audio_dump_sport_regs(SPORT0_REG_BASE);
+			ameba_audio_dump_codec_regs();
+#endif
+		}
+	}
+
+	if (rstream->stream.state == STATE_XRUN_NOTIFIED || rstream->stream.state == STATE_STANDBY) {
+		if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
+			tx_addr = (uint32_t)(uintptr_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
+			HAL_AUDIO_VERBOSE("restart gdma at rp:%u %" PRId32 "", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer), rstream->stream.state);
+			rstream->stream.multi_dma_xrun_mask = 0;
+			ameba_audio_stream_tx_gdma_restart(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
+			rstream->stream.gdma_cnt++;
+
+			if (has_extra_dma) {
+				extra_tx_addr = (uint32_t)(uintptr_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+				HAL_AUDIO_VERBOSE("restart extra gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
+				ameba_audio_stream_tx_gdma_restart(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
+				rstream->stream.extra_gdma_cnt++;
+			}
+			ameba_audio_stream_tx_start(stream, STATE_STARTED);
+		}
+	}
+}
+
 static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
 	RenderStream *rstream = (RenderStream *)stream;
@@ -1075,17 +1262,10 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 	uint32_t total_bytes = bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
 	uint32_t bytes_left_to_write = total_bytes;
 	uint32_t bytes_written = 0;
-	uint32_t tx_addr;
-	PGDMA_InitTypeDef sp_txgdma_initstruct = &(rstream->stream.gdma_struct->u.SpTxGdmaInitStruct);
 
 	uint32_t extra_total_bytes = 0;
 	uint32_t extra_bytes_left_to_write = 0;
 	uint32_t extra_bytes_written = 0;
-	uint32_t extra_tx_addr;
-	PGDMA_InitTypeDef extra_sp_txgdma_initstruct = &(rstream->stream.extra_gdma_struct->u.SpTxGdmaInitStruct);
-
-	char *p_buf = NULL;
-	char *p_extra_buf = NULL;
 
 	uint32_t sem_timeout = block ? RTOS_MAX_TIMEOUT : rstream->stream.config.period_size * 1000 * rstream->stream.config.period_count / rstream->stream.config.rate;
 
@@ -1107,9 +1287,9 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 
 	if (AUDIO_OUT_DEBUG_BUFFER_LEVEL == 1) {
 		if (rstream->write_cnt % 100 == 0) {
-			HAL_AUDIO_DEBUG("wr cnt:%llu, remain:%dbytes, avail:%dbytes",
-							rstream->write_cnt, ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer),
-							ameba_audio_stream_buffer_get_available_size(rstream->stream.rbuffer));
+			HAL_AUDIO_DEBUG("wr cnt:%" PRIu64 ", remain:%" PRIu32 "bytes, avail:%" PRIu32 "bytes",
+							rstream->write_cnt, (uint32_t)ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer),
+							(uint32_t)ameba_audio_stream_buffer_get_available_size(rstream->stream.rbuffer));
 		}
 	}
 
@@ -1120,78 +1300,36 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 	if (has_extra_dma) {
 		extra_total_bytes = bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
 		extra_bytes_left_to_write = extra_total_bytes;
-		p_buf = (char *)rtos_mem_calloc(total_bytes, sizeof(char));
-		p_extra_buf = (char *)rtos_mem_calloc(extra_total_bytes, sizeof(char));
-
-		uint32_t idx = 0;
-		for (; idx < bytes / rstream->stream.config.frame_size; idx++) {
-			memcpy(p_buf + idx * rstream->stream.frame_size, (char *)data + idx * rstream->stream.config.frame_size, rstream->stream.frame_size);
-			memcpy(p_extra_buf + idx * rstream->stream.extra_frame_size, (char *)data + idx * rstream->stream.config.frame_size + rstream->stream.frame_size,
-				   rstream->stream.extra_frame_size);
-		}
-	} else {
-		p_buf = (char *)data;
+#if DEBUG_SPLIT_COST
+		int64_t legacy_start_ns = ameba_audio_get_now_ns();
+		ameba_audio_stream_tx_legacy_split(rstream, data, bytes);
+		s_legacy_split_ns += ameba_audio_get_now_ns() - legacy_start_ns;
+#endif
 	}
 
 	while (bytes_left_to_write != 0 || (extra_bytes_left_to_write != 0)) {
 		if (!rstream->stream.dma_irq_masked) {
 			ameba_audio_stream_tx_mask_gdma_irq(stream);
 		}
-		bytes_written = ameba_audio_stream_buffer_write(rstream->stream.rbuffer, (uint8_t *)p_buf + total_bytes - bytes_left_to_write, bytes_left_to_write);
-		rstream->total_written_from_tx_start += bytes_written / rstream->stream.frame_size;
-
-		uint32_t dma_len = rstream->stream.period_bytes * rstream->stream.channel / (rstream->stream.channel + rstream->stream.extra_channel);
-		uint32_t extra_dma_len = 0;
 
 		if (has_extra_dma) {
-			extra_bytes_written = ameba_audio_stream_buffer_write(rstream->stream.extra_rbuffer, (uint8_t *)p_extra_buf + extra_total_bytes - extra_bytes_left_to_write,
-								  extra_bytes_left_to_write);
-			extra_dma_len = rstream->stream.period_bytes * rstream->stream.extra_channel / (rstream->stream.channel + rstream->stream.extra_channel);
-		}
-
-		if (rstream->stream.state == STATE_INITED) {
-			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
-				tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
-				GDMA_Cmd(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, ENABLE);
-				rstream->stream.gdma_cnt++;
-				HAL_AUDIO_INFO("gdma start: index:%d, chNum:%d, tx_addr:0x%lx, dma_len:%lu",
-							   sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
-
-				if (has_extra_dma) {
-					GDMA_Cmd(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, ENABLE);
-					rstream->stream.extra_gdma_cnt++;
-					HAL_AUDIO_INFO("gdma extra init: index:%d, chNum:%d, tx_addr:0x%lx, extra_dma_len:%lu",
-								   extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
-				}
-				rstream->stream.start_gdma = true;
-
-				ameba_audio_stream_tx_start(stream, STATE_STARTED);
-
-#if HAL_AUDIO_PLAYBACK_DUMP_DEBUG
-				ameba_audio_dump_gdma_regs(sp_txgdma_initstruct->GDMA_ChNum);
-				ameba_audio_dump_sport_regs(SPORT0_REG_BASE);
-				ameba_audio_dump_codec_regs();
+			uint32_t frames_offset = (total_bytes - bytes_left_to_write) / rstream->stream.frame_size;
+#if DEBUG_SPLIT_COST
+			int64_t split_start_ns = ameba_audio_get_now_ns();
 #endif
-			}
+			uint32_t frames_written = ameba_audio_stream_tx_split_write(rstream, (const uint8_t *)data + frames_offset * rstream->stream.config.frame_size,
+									  bytes_left_to_write / rstream->stream.frame_size);
+#if DEBUG_SPLIT_COST
+			s_split_ns += ameba_audio_get_now_ns() - split_start_ns;
+#endif
+			bytes_written = frames_written * rstream->stream.frame_size;
+			extra_bytes_written = frames_written * rstream->stream.extra_frame_size;
+		} else {
+			bytes_written = ameba_audio_stream_buffer_write(rstream->stream.rbuffer, (uint8_t *)data + total_bytes - bytes_left_to_write, bytes_left_to_write);
 		}
+		rstream->total_written_from_tx_start += bytes_written / rstream->stream.frame_size;
 
-		if (rstream->stream.state == STATE_XRUN_NOTIFIED || rstream->stream.state == STATE_STANDBY) {
-			if (ameba_audio_stream_buffer_get_remain_size(rstream->stream.rbuffer) > MAX(dma_len, FIFO_BYTES)) {
-				tx_addr = (uint32_t)(rstream->stream.rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer));
-				HAL_AUDIO_VERBOSE("restart gdma at rp:%u %ld", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.rbuffer), rstream->stream.state);
-				rstream->stream.multi_dma_xrun_mask = 0;
-				ameba_audio_stream_tx_gdma_restart(sp_txgdma_initstruct->GDMA_Index, sp_txgdma_initstruct->GDMA_ChNum, tx_addr, dma_len);
-				rstream->stream.gdma_cnt++;
-
-				if (has_extra_dma) {
-					extra_tx_addr = (uint32_t)(rstream->stream.extra_rbuffer->raw_data + ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
-					HAL_AUDIO_VERBOSE("restart extra gdma at rp:%u", ameba_audio_stream_buffer_get_tx_readptr(rstream->stream.extra_rbuffer));
-					ameba_audio_stream_tx_gdma_restart(extra_sp_txgdma_initstruct->GDMA_Index, extra_sp_txgdma_initstruct->GDMA_ChNum, extra_tx_addr, extra_dma_len);
-					rstream->stream.extra_gdma_cnt++;
-				}
-				ameba_audio_stream_tx_start(stream, STATE_STARTED);
-			}
-		}
+		ameba_audio_stream_tx_check_and_start_gdma(stream, has_extra_dma);
 
 		bytes_left_to_write -= bytes_written;
 		if (ameba_audio_stream_buffer_get_available_size(rstream->stream.rbuffer) < bytes_left_to_write) {
@@ -1200,7 +1338,7 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 				ameba_audio_stream_tx_unmask_gdma_irq(stream);
 			}
 
-			int32_t sem_ret = rtos_sema_take(rstream->stream.sem, sem_timeout);
+			int32_t sem_ret = ameba_audio_stream_stats_sema_take(&rstream->stream.stats, rstream->stream.sem, sem_timeout);
 			if (sem_ret < 0) {
 				break;
 			}
@@ -1216,7 +1354,7 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 					ameba_audio_stream_tx_unmask_gdma_irq(stream);
 				}
 
-				int32_t sem_ret = rtos_sema_take(rstream->stream.extra_sem, sem_timeout);
+				int32_t sem_ret = ameba_audio_stream_stats_sema_take(&rstream->stream.stats, rstream->stream.extra_sem, sem_timeout);
 				if (sem_ret < 0) {
 					break;
 				}
@@ -1231,17 +1369,13 @@ static int32_t ameba_audio_stream_tx_write_in_irq_mode(Stream *stream, const voi
 		ameba_audio_stream_tx_unmask_gdma_irq(stream);
 	}
 
-	if (has_extra_dma) {
-		if (p_buf) {
-			rtos_mem_free(p_buf);
-			p_buf = NULL;
-		}
-
-		if (p_extra_buf) {
-			rtos_mem_free(p_extra_buf);
-			p_extra_buf = NULL;
-		}
+#if DEBUG_SPLIT_COST
+	if (has_extra_dma && ++s_split_cnt % 100 == 0) {
+		HAL_AUDIO_INFO("split cost of 100 writes, direct:%" PRIu64 "ns, legacy:%" PRIu64 "ns", s_split_ns, s_legacy_split_ns);
+		s_split_ns = 0;
+		s_legacy_split_ns = 0;
 	}
+#endif
 
 	return bytes - bytes_left_to_write * (rstream->stream.channel + rstream->stream.extra_channel) / rstream->stream.channel;
 }
@@ -1254,15 +1388,78 @@ int64_t ameba_audio_stream_tx_get_frames_written(Stream *stream)
 
 int32_t ameba_audio_stream_tx_write(Stream *stream, const void *data, uint32_t bytes, bool block)
 {
+	int32_t ret = 0;
+
 	if (stream) {
 		if (stream->stream_mode) {
-			return ameba_audio_stream_tx_write_in_noirq_mode(stream, data, bytes, block);
+			ret = ameba_audio_stream_tx_write_in_noirq_mode(stream, data, bytes, block);
 		} else {
-			return ameba_audio_stream_tx_write_in_irq_mode(stream, data, bytes, block);
+			ameba_audio_stream_stats_fill(&stream->stats, ameba_audio_stream_buffer_get_remain_size(stream->rbuffer));
+			ret = ameba_audio_stream_tx_write_in_irq_mode(stream, data, bytes, block);
+		}
+		if (ret > 0) {
+			stream->stats.bytes += ret;
 		}
 	}
 
-	return 0;
+	return ret;
+}
+
+int32_t ameba_audio_stream_tx_acquire_region(Stream *stream, void **region, uint32_t bytes)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+	uint32_t size;
+
+	if (!stream || !region) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	//noirq mode and the fifo0/fifo1 split of 6/8 channels need hal to copy the data.
+	if (rstream->stream.stream_mode || rstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	ameba_audio_stream_tx_mask_gdma_irq(stream);
+
+	if (rstream->stream.state == STATE_XRUN) {
+		rstream->stream.state = STATE_XRUN_NOTIFIED;
+		ameba_audio_stream_tx_unmask_gdma_irq(stream);
+		return HAL_OSAL_ERR_DEAD_OBJECT;
+	}
+
+	size = ameba_audio_stream_buffer_acquire_write_region(rstream->stream.rbuffer, region, bytes - bytes % rstream->stream.frame_size);
+	size -= size % rstream->stream.frame_size;
+
+	ameba_audio_stream_tx_unmask_gdma_irq(stream);
+
+	return size;
+}
+
+int32_t ameba_audio_stream_tx_commit_region(Stream *stream, uint32_t bytes)
+{
+	RenderStream *rstream = (RenderStream *)stream;
+
+	if (!stream) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	if (rstream->stream.stream_mode || rstream->stream.extra_channel) {
+		return HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	ameba_audio_stream_tx_mask_gdma_irq(stream);
+
+	bytes = ameba_audio_stream_buffer_commit_write(rstream->stream.rbuffer, bytes);
+	rstream->total_written_from_tx_start += bytes / rstream->stream.frame_size;
+	rstream->write_cnt++;
+
+	ameba_audio_stream_tx_check_and_start_gdma(stream, false);
+
+	ameba_audio_stream_tx_unmask_gdma_irq(stream);
+
+	rstream->stream.stats.bytes += bytes;
+
+	return bytes;
 }
 
 void ameba_audio_stream_tx_close(Stream *stream)
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <inttypes.h>
+
 #include "basic_types.h"
 
 #include "ameba.h"
@@ -307,7 +309,7 @@ int32_t ameba_audio_stream_get_mic_idx(uint32_t mic_category)
 		mic_num = DMIC8;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %ld not supported", mic_category);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] mic category %" PRId32 " not supported", mic_category);
 		return HAL_OSAL_ERR_INVALID_PARAM;
 	}
 
@@ -343,7 +345,7 @@ int32_t ameba_audio_stream_get_adc_chn_idx(uint32_t index)
 		adc_chn = ADCHN8;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc channel index: %" PRId32 " not supported", index);
 		break;
 	}
 
@@ -379,7 +381,7 @@ int32_t ameba_audio_stream_get_adc_idx(uint32_t index)
 		adc_num = ADC8;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %ld not supported", index);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] adc index: %" PRId32 " not supported", index);
 		break;
 	}
 
@@ -406,7 +408,7 @@ int32_t ameba_audio_stream_get_adc_eq_band_idx(uint32_t band_idx)
 		band_sel = ADCEQBD4;
 		break;
 	default:
-		HAL_AUDIO_ERROR("[AmebaAudioUtils] band index: %ld not supported", band_idx);
+		HAL_AUDIO_ERROR("[AmebaAudioUtils] band index: %" PRId32 " not supported", band_idx);
 		break;
 	}
 
@@ -417,84 +419,84 @@ void ameba_audio_dump_gdma_regs(u8 GDMA_ChNum)
 {
 	GDMA_TypeDef *GDMA = ((GDMA_TypeDef *)GDMA_BASE);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%lx", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%lx", GDMA_ChNum, GDMA->ChEnReg);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].SAR:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].SAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].DAR:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].DAR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_LOW:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CTL_HIGH:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CTL_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_LOW:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_LOW);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].CFG_HIGH:%" PRIx32 "", GDMA_ChNum, GDMA->CH[GDMA_ChNum].CFG_HIGH);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].ChEnReg:%" PRIx32 "", GDMA_ChNum, GDMA->ChEnReg);
 
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%lx", GDMA_ChNum, GDMA->MASK_TFR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%lx", GDMA_ChNum, GDMA->MASK_BLOCK);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%lx", GDMA_ChNum, GDMA->MASK_ERR);
-	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%lx", GDMA_ChNum, GDMA->STATUS_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_TFR:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_TFR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_BLOCK:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_BLOCK);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].MASK_ERR:%" PRIx32 "", GDMA_ChNum, GDMA->MASK_ERR);
+	HAL_AUDIO_DUMP_INFO("GDMA->CH[%d].STATUS_BLOCK:%" PRIx32 "", GDMA_ChNum, GDMA->STATUS_BLOCK);
 
 }
 
 void ameba_audio_dump_sport_regs(uint32_t SPORTx)
 {
 	int32_t tmp;
-	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)SPORTx;
+	AUDIO_SPORT_TypeDef *sportx = (AUDIO_SPORT_TypeDef *)(uintptr_t)SPORTx;
 	HAL_AUDIO_DUMP_INFO("dump sportx:0x%p", sportx);
 	tmp = sportx->SP_REG_MUX;
-	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_REG_MUX:%" PRIx32 "", tmp);
 	tmp = sportx->SP_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL0:%" PRIx32 "", tmp);
 	tmp = sportx->SP_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_CTRL1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_INT_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_INT_CTRL:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD0;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD0:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TRX_COUNTER_STATUS;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TRX_COUNTER_STATUS:%" PRIx32 "", tmp);
 	tmp = sportx->SP_ERR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_ERR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_SR_TX_BCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_LRCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FIFO_CTRL;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_CTRL:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FORMAT;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FORMAT:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_BCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_BCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_LRCLK;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_LRCLK:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DSP_COUNTER;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DSP_COUNTER:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD1;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL0;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL0:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD2;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD2:%" PRIx32 "", tmp);
 	tmp = sportx->SP_FIFO_IRQ;
-	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_FIFO_IRQ:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL2:%" PRIx32 "", tmp);
 	tmp = sportx->RSVD3;
-	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_RSVD3:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL3;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL3:%" PRIx32 "", tmp);
 	tmp = sportx->SP_DIRECT_CTRL4;
-	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_DIRECT_CTRL4:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_COUNTER1;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER1:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_COUNTER2;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_COUNTER2:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_FIFO_0_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_0_WR_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_FIFO_0_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_0_RD_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_TX_FIFO_1_WR_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_TX_FIFO_1_WR_ADDR:%" PRIx32 "", tmp);
 	tmp = sportx->SP_RX_FIFO_1_RD_ADDR;
-	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("REG_SP_RX_FIFO_1_RD_ADDR:%" PRIx32 "", tmp);
 
 }
 
@@ -509,74 +511,74 @@ void ameba_audio_dump_codec_regs(void)
 	}
 
 	tmp = g_audio_analog->AUD_ADDA_CTL;
-	HAL_AUDIO_DUMP_INFO("ADDA_CTL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("ADDA_CTL:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_HPO_CTL;
-	HAL_AUDIO_DUMP_INFO("AUD_HPO_CTL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("AUD_HPO_CTL:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MICBIAS_CTL0;
-	HAL_AUDIO_DUMP_INFO("MICBIAS_CTL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBIAS_CTL0:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MICBST_CTL0;
-	HAL_AUDIO_DUMP_INFO("MICBST_CTL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBST_CTL0:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MICBST_CTL1;
-	HAL_AUDIO_DUMP_INFO("MICBST_CTL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MICBST_CTL1:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->RSVD0;
-	HAL_AUDIO_DUMP_INFO("ANALOG_RSVD0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("ANALOG_RSVD0:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_DTS_CTL;
-	HAL_AUDIO_DUMP_INFO("DTS_CTL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("DTS_CTL:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL0;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL0:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL1;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL1:%" PRIx32 "", tmp);
 	tmp = g_audio_analog->AUD_MBIAS_CTL2;
-	HAL_AUDIO_DUMP_INFO("MBIAS_CTL2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("MBIAS_CTL2:%" PRIx32 "", tmp);
 
 	/***digital reg dump***/
 	tmp = audio_base->CODEC_AUDIO_CONTROL_0;
-	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_0:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_AUDIO_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_AUDIO_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_2;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_3;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_4;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_4:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_4:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_5;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_6;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_CLOCK_CONTROL_7;
-	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_CLOCK_CONTROL_5:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_I2S_AD_SEL_CONTROL;
-	HAL_AUDIO_DUMP_INFO("CODEC_I2S_AD_SEL_CONTROL:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_I2S_AD_SEL_CONTROL:%" PRIx32 "", tmp);
 
 	for (uint32_t i = 0; i < 2; i++) {
 		tmp = audio_base->CODEC_I2S_SRC_CTRL[i].CODEC_I2S_x_CONTROL;
-		HAL_AUDIO_DUMP_INFO("CODEC_I2S_SRC_CTRL_%lu:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_I2S_SRC_CTRL_%" PRIu32 ":%" PRIx32 "", i, tmp);
 		tmp = audio_base->CODEC_I2S_SRC_CTRL[i].CODEC_I2S_x_CONTROL_1;
-		HAL_AUDIO_DUMP_INFO("CODEC_I2S_SRC_CTRL_%lu:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_I2S_SRC_CTRL_%" PRIu32 ":%" PRIx32 "", i, tmp);
 	}
 
 	for (uint32_t i = 0; i < MAX_AD_NUM; i++) {
 		tmp = audio_base->CODEC_ADC_CH_CTRL[i].CODEC_ADC_x_CONTROL_0;
-		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%lu_CONTROL_0:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%" PRIu32 "_CONTROL_0:%" PRIx32 "", i, tmp);
 		tmp = audio_base->CODEC_ADC_CH_CTRL[i].CODEC_ADC_x_CONTROL_1;
-		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%lu_CONTROL_1:%lx", i, tmp);
+		HAL_AUDIO_DUMP_INFO("CODEC_ADC_%" PRIu32 "_CONTROL_1:%" PRIx32 "", i, tmp);
 	}
 
 	tmp = audio_base->CODEC_DAC_L_CONTROL_0;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_0:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_DAC_L_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_DAC_L_CONTROL_2;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_L_CONTROL_2:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_DAC_R_CONTROL_0;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_0:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_0:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_DAC_R_CONTROL_1;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_1:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_1:%" PRIx32 "", tmp);
 	tmp = audio_base->CODEC_DAC_R_CONTROL_2;
-	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_2:%lx", tmp);
+	HAL_AUDIO_DUMP_INFO("CODEC_DAC_R_CONTROL_2:%" PRIx32 "", tmp);
 
 }
 
@@ -602,7 +604,7 @@ AUDIO_SPORT_TypeDef *ameba_audio_get_sport_addr(uint32_t index)
 		addr = AUDIO_SPORT3_DEV;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		addr = NULL;
 		break;
 	}
@@ -626,7 +628,7 @@ int32_t ameba_audio_get_i2s_pin_func(uint32_t index)
 		pin_func = PINMUX_FUNCTION_I2S3;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		break;
 	}
 	return pin_func;
@@ -649,7 +651,7 @@ int32_t ameba_audio_get_sport_irq(uint32_t index)
 		irq = SPORT3_IRQ;
 		break;
 	default:
-		HAL_AUDIO_ERROR("unsupported sport:%lu", index);
+		HAL_AUDIO_ERROR("unsupported sport:%" PRIu32 "", index);
 		break;
 	}
 	return irq;
@@ -685,7 +687,7 @@ int32_t ameba_audio_stream_get_direct_out_channel_idx(uint32_t channel)
 		direct_out_channel = DIRECT_OUT_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct out:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct out:%" PRId32 "", channel);
 		break;
 	}
 
@@ -722,7 +724,7 @@ int32_t ameba_audio_stream_get_direct_in_channel_idx(uint32_t channel)
 		direct_in_channel = DIRECT_IN_CHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct in:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct in:%" PRId32 "", channel);
 		break;
 	}
 
@@ -759,7 +761,7 @@ int32_t ameba_audio_stream_get_direct_reg_idx(uint32_t channel)
 		direct_reg = DIRECT_REG_7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
@@ -796,7 +798,7 @@ int32_t ameba_audio_stream_get_sp_tx_channel_idx(uint32_t channel)
 		sp_tx_channel = TXCHN7;
 		break;
 	default:
-		HAL_AUDIO_ERROR("channel not supported for direct reg:%ld", channel);
+		HAL_AUDIO_ERROR("channel not supported for direct reg:%" PRId32 "", channel);
 		break;
 	}
 
@@ -22,6 +22,7 @@
 #include "ameba_audio_stream_capture.h"
 #include "ameba_audio_stream_control.h"
 
+#include "audio_hw_channel_utils.h"
 #include "audio_hw_compat.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_osal_errnos.h"
@@ -33,20 +34,13 @@
 
 #include "primary_audio_hw_card.h"
 
+#ifdef AUDIO_HW_AEC
+#include "ameba_audio_aec.h"
+#endif
+
 #define NOIRQ_CAPTURE_PERIOD_SIZE     128
 #define CAPTURE_PERIOD_SIZE           1024
 #define CAPTURE_PERIOD_COUNT          4
-#define AUDIO_CAPTURE_MODE            "cap_mode"
-#define MIC_CATEGORY                  "mic_category"
-// channels of pure data
-#define PURE_DATA                     "no_afe_pure_data"
-// for debug (mic,mic,..ref,out), only out buffer not filled by audio fwk
-#define ALL_DATA                      "no_afe_all_data"
-#define REF_CHANNEL                   "ref_channel"
-//0 master, 1 slave
-#define MASTER_SLAVE                  "master_slave"
-// I2S:0, Left justified:1, pcm_a:2, pcm_b:3.
-#define CAPTURE_DATA_FORMAT           "data_format"
 #define PURE_DATA_DUMP         0
 #define ALL_DATA_DUMP          0
 #define DUMP_FRAME                    48000
@@ -54,6 +48,7 @@
 typedef enum CAPTURE_MODE {
 	CAPTURE_PURE_DATA = 0,
 	CAPTURE_PURE_DATA_ADD_OUT,
+	CAPTURE_AEC,
 } CAPTURE_MODE;
 
 StreamConfig stream_input_config = {
@@ -79,11 +74,16 @@ struct PrimaryAudioHwStreamIn {
 	uint64_t rframe;
 	uint32_t requested_channels;
 	CAPTURE_MODE mode;
+	//mode the app set, it takes over from mode when the stream starts from standby.
+	CAPTURE_MODE next_mode;
 	uint32_t channel_for_ref;
 	uint64_t mic_category;
 	uint32_t device;
 	uint32_t master_slave;
 	uint32_t data_format;
+#ifdef AUDIO_HW_AEC
+	AudioAec *aec;
+#endif
 
 #if (PURE_DATA_DUMP || ALL_DATA_DUMP)
 	char *in_buf;  //2s data
@@ -163,6 +163,11 @@ static int32_t PrimarySetStreamInFormat(struct AudioHwStream *stream, enum Audio
 static int32_t DoInputStandby(struct PrimaryAudioHwStreamIn *cap)
 {
 	if (!cap->standby) {
+#ifdef AUDIO_HW_AEC
+		//the worker leaves its read only while the driver still runs.
+		ameba_audio_aec_destroy(cap->aec);
+		cap->aec = NULL;
+#endif
 		ameba_audio_stream_rx_stop(cap->in_pcm);
 		ameba_audio_stream_rx_close(cap->in_pcm);
 		cap->in_pcm = NULL;
@@ -205,56 +210,99 @@ static int32_t PrimaryDumpStreamIn(const struct AudioHwStream *stream, int32_t f
 	return HAL_OSAL_OK;
 }
 
-static int32_t PrimarySetStreamInParameters(struct AudioHwStream *stream, const char *str_pairs)
+static int32_t PrimarySetStreamInParameter(struct AudioHwStreamIn *stream, enum AudioHwParamKey key, int32_t value)
 {
-	HAL_AUDIO_VERBOSE("%s, keys = %s", __FUNCTION__, str_pairs);
 	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
-	struct string_cell *cells;
-	cells = string_cells_create_from_str(str_pairs);
-	int32_t value;
-	char string_value[15];
 
-	if (string_cells_has_key(cells, REF_CHANNEL)) {
-		string_cells_get_int(cells, REF_CHANNEL, &value);
+	switch (key) {
+	case AUDIO_HW_PARAM_REF_CHANNEL:
 		cap->channel_for_ref = value;
-	}
-
-	if (string_cells_has_key(cells, MIC_CATEGORY)) {
-		string_cells_get_int(cells, MIC_CATEGORY, &value);
+		break;
+	case AUDIO_HW_PARAM_MIC_CATEGORY:
 		cap->mic_category = value;
-	}
-
-	HAL_AUDIO_VERBOSE("check key AUDIO_CAPTURE_MODE");
-	if (string_cells_has_key(cells, AUDIO_CAPTURE_MODE)) {
-		string_cells_get_str(cells, AUDIO_CAPTURE_MODE, string_value, 15);
-		if (!strncmp(string_value, PURE_DATA, 14)) {
+		break;
+	case AUDIO_HW_PARAM_CAP_MODE:
+		if (value == AUDIO_HW_CAPTURE_NO_AFE_PURE_DATA) {
 			HAL_AUDIO_VERBOSE("mode:NO AFE PURE DATA");
-			cap->mode = CAPTURE_PURE_DATA;
-		} else if (!strncmp(string_value, ALL_DATA, 14)) {
+			cap->next_mode = CAPTURE_PURE_DATA;
+		} else if (value == AUDIO_HW_CAPTURE_NO_AFE_ALL_DATA) {
 			HAL_AUDIO_VERBOSE("mode:NO AFE ALL DATA");
-			cap->mode = CAPTURE_PURE_DATA_ADD_OUT;
+			cap->next_mode = CAPTURE_PURE_DATA_ADD_OUT;
+#ifdef AUDIO_HW_AEC
+		} else if (value == AUDIO_HW_CAPTURE_AEC) {
+			HAL_AUDIO_VERBOSE("mode:AEC");
+			cap->next_mode = CAPTURE_AEC;
+#endif
 		}
-	}
-
-	if (string_cells_has_key(cells, MASTER_SLAVE)) {
-		string_cells_get_int(cells, MASTER_SLAVE, &value);
+		break;
+	case AUDIO_HW_PARAM_MASTER_SLAVE:
 		cap->master_slave = value;
+		break;
+	case AUDIO_HW_PARAM_DATA_FORMAT:
+		cap->data_format = value;
+		break;
+	default:
+		HAL_AUDIO_VERBOSE("key:%d not supported", key);
+		return HAL_OSAL_ERR_INVALID_PARAM;
 	}
 
-	if (string_cells_has_key(cells, CAPTURE_DATA_FORMAT)) {
-		string_cells_get_int(cells, CAPTURE_DATA_FORMAT, &value);
-		cap->data_format = value;
+	return HAL_OSAL_OK;
+}
+
+static int32_t PrimarySetStreamInParameters(struct AudioHwStream *stream, const char *str_pairs)
+{
+	HAL_AUDIO_VERBOSE("%s, keys = %s", __FUNCTION__, str_pairs);
+	struct audio_hw_params params;
+
+	audio_hw_params_parse(str_pairs, &params);
+	for (int32_t key = 0; key < AUDIO_HW_PARAM_MAX; key++) {
+		if (audio_hw_params_has(&params, key)) {
+			PrimarySetStreamInParameter((struct AudioHwStreamIn *)stream, key, params.values[key]);
+		}
 	}
 
-	string_cells_destroy(cells);
 	return HAL_OSAL_OK;
 }
 
-static char *PrimaryGetStreamInParameters(const struct AudioHwStream *stream,
-		const char *keys)
+static int32_t PrimaryGetStreamInStats(const struct AudioHwStreamIn *stream, struct AudioHwStreamStats *stats)
 {
-	(void) stream;
-	(void) keys;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+	int32_t ret = HAL_OSAL_OK;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->in_pcm) {
+		ameba_audio_stream_stats_get(&cap->in_pcm->stats, stats);
+	} else {
+		memset(stats, 0, sizeof(*stats));
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
+static char *PrimaryGetStreamInParameters(const struct AudioHwStream *stream, const char *keys)
+{
+	struct AudioHwStreamStats stats;
+	char str[AMEBA_AUDIO_STREAM_STATS_STR_LEN];
+
+	if (keys && !strcmp(keys, AMEBA_AUDIO_STREAM_STATS_KEY)) {
+		PrimaryGetStreamInStats((const struct AudioHwStreamIn *)stream, &stats);
+		ameba_audio_stream_stats_to_str(&stats, str, sizeof(str));
+		return (char *)xstrdup(str);
+	}
+#ifdef AUDIO_HW_AEC
+	if (keys && !strcmp(keys, AMEBA_AUDIO_AEC_KEY)) {
+		struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+		char aec_str[AMEBA_AUDIO_AEC_STR_LEN];
+
+		rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+		ameba_audio_aec_to_str(cap->aec, aec_str, sizeof(aec_str));
+		rtos_mutex_give(cap->lock);
+		return (char *)xstrdup(aec_str);
+	}
+#endif
+
 	return (char *)xstrdup("");
 }
 
@@ -391,9 +439,73 @@ static int32_t ConfigurePureDataAddOut(struct PrimaryAudioHwStreamIn *cap)
 	return HAL_OSAL_OK;
 }
 
+#ifdef AUDIO_HW_AEC
+/*    the app gets the clean mics and the played reference, the driver captures the mics only.
+ *    requested_channels      mic_channels    driver_channels
+ *    2                       1               1
+ *    3                       2               2
+ *    4                       3               4(no 3 channels tdm in driver)
+ *    5                       4               4
+ */
+static int32_t ConfigureAec(struct PrimaryAudioHwStreamIn *cap)
+{
+	if (cap->requested_channels < 2 || cap->requested_channels > AUDIO_AEC_MAX_MICS + 1 ||
+		cap->config.format != AUDIO_HW_FORMAT_PCM_16_BIT) {
+		HAL_AUDIO_ERROR("aec needs 16bit and 2~%d channels", AUDIO_AEC_MAX_MICS + 1);
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	cap->config.channels = cap->requested_channels == 4 ? 4 : cap->requested_channels - 1;
+	return HAL_OSAL_OK;
+}
+
+static int32_t AecDriverRead(void *priv, void *data, uint32_t bytes)
+{
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)priv;
+
+	return ameba_audio_stream_rx_read(cap->in_pcm, data, bytes, RTOS_MAX_TIMEOUT);
+}
+
+static int32_t AecDriverPosition(void *priv, uint64_t *captured_frames, int64_t *now_ns)
+{
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)priv;
+	struct timespec tstamp;
+	int32_t ret;
+
+	ret = ameba_audio_stream_rx_get_position(cap->in_pcm, captured_frames, &tstamp);
+	*now_ns = (int64_t)tstamp.tv_sec * 1000000000LL + tstamp.tv_nsec;
+	return ret;
+}
+
+static int32_t StartAec(struct PrimaryAudioHwStreamIn *cap)
+{
+	AudioAecConfig aec_config = {
+		.rate = cap->config.rate,
+		.mic_channels = cap->requested_channels - 1,
+		.driver_channels = cap->config.channels,
+		.buffer_frames = cap->config.period_size * cap->config.period_count,
+		.read = AecDriverRead,
+		.position = AecDriverPosition,
+		.priv = cap,
+	};
+
+	cap->aec = ameba_audio_aec_create(&aec_config);
+	if (!cap->aec) {
+		ameba_audio_stream_rx_stop(cap->in_pcm);
+		ameba_audio_stream_rx_close(cap->in_pcm);
+		cap->in_pcm = NULL;
+		return HAL_OSAL_ERR_NO_MEMORY;
+	}
+
+	return HAL_OSAL_OK;
+}
+#endif
+
 static int32_t StartAudioHwStreamIn(struct PrimaryAudioHwStreamIn *cap)
 {
 	int32_t ret = HAL_OSAL_OK;
+	//a running aec worker or driver layout can not change under the reads.
+	cap->mode = cap->next_mode;
 	cap->config.channels = cap->requested_channels;
 
 	//HAL_AUDIO_INFO("%s", __FUNCTION__);
@@ -405,6 +517,11 @@ static int32_t StartAudioHwStreamIn(struct PrimaryAudioHwStreamIn *cap)
 	case CAPTURE_PURE_DATA_ADD_OUT:
 		ret = ConfigurePureDataAddOut(cap);
 		break;
+#ifdef AUDIO_HW_AEC
+	case CAPTURE_AEC:
+		ret = ConfigureAec(cap);
+		break;
+#endif
 	default:
 		HAL_AUDIO_ERROR("mode(%d) not supported!", cap->mode);
 		break;
@@ -431,13 +548,19 @@ static int32_t StartAudioHwStreamIn(struct PrimaryAudioHwStreamIn *cap)
 	}
 
 	ameba_audio_stream_rx_start(cap->in_pcm);
+
+#ifdef AUDIO_HW_AEC
+	if (cap->mode == CAPTURE_AEC) {
+		return StartAec(cap);
+	}
+#endif
+
 	return HAL_OSAL_OK;
 }
 
 static ssize_t PureDataRead(struct AudioHwStreamIn *stream, void *buffer, size_t bytes, uint32_t time_out_ms)
 {
 	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
-	uint32_t i = 0;
 	size_t app_frame_size = PrimaryAudioHwStreamInFrameSize((const struct AudioHwStreamIn *)stream);
 	size_t driver_frame_size = app_frame_size * cap->config.channels / cap->requested_channels;
 	HAL_AUDIO_VERBOSE("%s: bytes %u, app_frame_size:%d, driver_frame_size:%d", __FUNCTION__, bytes, app_frame_size, driver_frame_size);
@@ -457,17 +580,8 @@ static ssize_t PureDataRead(struct AudioHwStreamIn *stream, void *buffer, size_t
 			return ret;
 		}
 
-		for (i = 0; i < driver_bytes / driver_frame_size; i++) {
-			if (cap->config.format == AUDIO_HW_FORMAT_PCM_16_BIT) {
-				*((uint16_t *)buffer + cap->requested_channels * i) = *((uint16_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint16_t *)buffer + cap->requested_channels * i + 1) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint16_t *)buffer + cap->requested_channels * i + 2) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 2);
-			} else if (cap->config.format == AUDIO_HW_FORMAT_PCM_32_BIT || cap->config.format == AUDIO_HW_FORMAT_PCM_8_24_BIT) {
-				*((uint32_t *)buffer + cap->requested_channels * i) = *((uint32_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint32_t *)buffer + cap->requested_channels * i + 1) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint32_t *)buffer + cap->requested_channels * i + 2) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 2);
-			}
-		}
+		audio_hw_channel_drop(buffer, cap->requested_channels, cap->stream_buf, cap->config.channels,
+							  driver_bytes / driver_frame_size, GetAudioBytesPerSample(cap->config.format));
 	} else {
 		ret = ameba_audio_stream_rx_read(cap->in_pcm, buffer, bytes, time_out_ms);
 		if (ret < 0) {
@@ -489,7 +603,6 @@ static ssize_t PureDataAddOutRead(struct AudioHwStreamIn *stream, void *buffer,
 {
 	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
 	int32_t ret = 0;
-	uint32_t i = 0;
 
 	//bytes read from driver at one read.
 	uint32_t driver_bytes = 0;
@@ -518,49 +631,11 @@ static ssize_t PureDataAddOutRead(struct AudioHwStreamIn *stream, void *buffer,
 
 	switch (cap->requested_channels) {
 	case 3:
-		for (i = 0; i < frames; i++) {
-			if (cap->config.format == AUDIO_HW_FORMAT_PCM_16_BIT) {
-				*((uint16_t *)buffer + cap->requested_channels * i) = *((uint16_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint16_t *)buffer + cap->requested_channels * i + 1) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint16_t *)buffer + cap->requested_channels * i + 2) = 0;
-			} else if (cap->config.format == AUDIO_HW_FORMAT_PCM_32_BIT || cap->config.format == AUDIO_HW_FORMAT_PCM_8_24_BIT) {
-				*((uint32_t *)buffer + cap->requested_channels * i) = *((uint32_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint32_t *)buffer + cap->requested_channels * i + 1) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint32_t *)buffer + cap->requested_channels * i + 2) = 0;
-			}
-		}
-		break;
-	case 5:
-		for (i = 0; i < frames; i++) {
-			if (cap->config.format == AUDIO_HW_FORMAT_PCM_16_BIT) {
-				*((uint16_t *)buffer + cap->requested_channels * i) = *((uint16_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint16_t *)buffer + cap->requested_channels * i + 1) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint16_t *)buffer + cap->requested_channels * i + 2) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 2);
-				*((uint16_t *)buffer + cap->requested_channels * i + 3) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 3);
-				*((uint16_t *)buffer + cap->requested_channels * i + 4) = 0;
-			} else if (cap->config.format == AUDIO_HW_FORMAT_PCM_32_BIT || cap->config.format == AUDIO_HW_FORMAT_PCM_8_24_BIT) {
-				*((uint32_t *)buffer + cap->requested_channels * i) = *((uint32_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint32_t *)buffer + cap->requested_channels * i + 1) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint32_t *)buffer + cap->requested_channels * i + 2) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 2);
-				*((uint32_t *)buffer + cap->requested_channels * i + 3) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 3);
-				*((uint32_t *)buffer + cap->requested_channels * i + 4) = 0;
-			}
-		}
-		break;
 	case 4:
-		for (i = 0; i < driver_bytes / driver_frame_size; i++) {
-			if (cap->config.format == AUDIO_HW_FORMAT_PCM_16_BIT) {
-				*((uint16_t *)buffer + cap->requested_channels * i) = *((uint16_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint16_t *)buffer + cap->requested_channels * i + 1) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint16_t *)buffer + cap->requested_channels * i + 2) = *((uint16_t *)cap->stream_buf + cap->config.channels * i + 2);
-				*((uint16_t *)buffer + cap->requested_channels * i + 3) = 0;
-			} else if (cap->config.format == AUDIO_HW_FORMAT_PCM_32_BIT || cap->config.format == AUDIO_HW_FORMAT_PCM_8_24_BIT) {
-				*((uint32_t *)buffer + cap->requested_channels * i) = *((uint32_t *)cap->stream_buf + cap->config.channels * i);
-				*((uint32_t *)buffer + cap->requested_channels * i + 1) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 1);
-				*((uint32_t *)buffer + cap->requested_channels * i + 2) = *((uint32_t *)cap->stream_buf + cap->config.channels * i + 2);
-				*((uint32_t *)buffer + cap->requested_channels * i + 3) = 0;
-			}
-		}
+	case 5:
+		//the last channel is left as zero for the playback reference.
+		audio_hw_channel_insert_zero(buffer, cap->requested_channels, cap->stream_buf, cap->config.channels,
+									 cap->requested_channels - 1, frames, GetAudioBytesPerSample(cap->config.format));
 		break;
 
 	default:
@@ -578,6 +653,23 @@ static ssize_t PureDataAddOutRead(struct AudioHwStreamIn *stream, void *buffer,
 	return bytes;
 }
 
+#ifdef AUDIO_HW_AEC
+static ssize_t AecRead(struct AudioHwStreamIn *stream, void *buffer, size_t bytes, uint32_t time_out_ms)
+{
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+	uint32_t app_frame_size = PrimaryAudioHwStreamInFrameSize((const struct AudioHwStreamIn *)stream);
+	int32_t ret;
+
+	if (!cap->aec) {
+		return HAL_OSAL_ERR_NO_INIT;
+	}
+
+	ret = ameba_audio_aec_read(cap->aec, buffer, bytes / app_frame_size, time_out_ms);
+	cap->rframe += ret / app_frame_size;
+	return ret;
+}
+#endif
+
 static ssize_t PrimaryStreamInRead(struct AudioHwStreamIn *stream, void *buffer, size_t bytes)
 {
 	int32_t ret = 0;
@@ -609,6 +701,12 @@ static ssize_t PrimaryStreamInRead(struct AudioHwStreamIn *stream, void *buffer,
 		ret = PureDataAddOutRead(stream, buffer, bytes, RTOS_MAX_TIMEOUT);
 		break;
 
+#ifdef AUDIO_HW_AEC
+	case CAPTURE_AEC:
+		ret = AecRead(stream, buffer, bytes, RTOS_MAX_TIMEOUT);
+		break;
+#endif
+
 	default:
 		HAL_AUDIO_ERROR("mode(%d) not supported!", cap->mode);
 		break;
@@ -652,6 +750,12 @@ static ssize_t PrimaryStreamInReadTimeout(struct AudioHwStreamIn *stream, void *
 		ret = PureDataAddOutRead(stream, buffer, bytes, time_out_ms);
 		break;
 
+#ifdef AUDIO_HW_AEC
+	case CAPTURE_AEC:
+		ret = AecRead(stream, buffer, bytes, time_out_ms);
+		break;
+#endif
+
 	default:
 		HAL_AUDIO_ERROR("mode(%d) not supported!", cap->mode);
 		break;
@@ -663,6 +767,56 @@ exit:
 	return ret;
 }
 
+static ssize_t PrimaryStreamInAcquireBuffer(struct AudioHwStreamIn *stream, void **buffer, size_t bytes, uint32_t time_out_ms)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->standby) {
+		ret = StartAudioHwStreamIn(cap);
+		if (ret == 0) {
+			cap->standby = 0;
+		} else {
+			HAL_AUDIO_ERROR("start audio stream_in fail");
+			goto exit;
+		}
+	}
+
+	//the channels are converted by hal in other cases, use read instead.
+	if (cap->mode != CAPTURE_PURE_DATA || cap->config.channels != cap->requested_channels) {
+		ret = HAL_OSAL_ERR_INVALID_OPERATION;
+		goto exit;
+	}
+
+	ret = ameba_audio_stream_rx_acquire_region(cap->in_pcm, buffer, bytes, time_out_ms);
+
+exit:
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
+static ssize_t PrimaryStreamInCommitBuffer(struct AudioHwStreamIn *stream, size_t bytes)
+{
+	int32_t ret = 0;
+	struct PrimaryAudioHwStreamIn *cap = (struct PrimaryAudioHwStreamIn *)stream;
+
+	rtos_mutex_take(cap->lock, MUTEX_WAIT_TIMEOUT);
+	if (cap->in_pcm) {
+		ret = ameba_audio_stream_rx_commit_region(cap->in_pcm, bytes);
+	} else {
+		ret = HAL_OSAL_ERR_NO_INIT;
+	}
+
+	if (ret >= 0) {
+		cap->rframe += ret / PrimaryAudioHwStreamInFrameSize(stream);
+	}
+	rtos_mutex_give(cap->lock);
+
+	return ret;
+}
+
 static int32_t CheckInputParameters(uint32_t sample_rate, enum AudioHwFormat format, uint32_t channel_count)
 {
 	switch (format) {
@@ -770,6 +924,10 @@ struct AudioHwStreamIn *CreateAudioHwStreamIn(struct AudioHwCard *card, const st
 	in->stream.GetTriggerTime = PrimaryGetTriggerTime;
 	in->stream.Read = PrimaryStreamInRead;
 	in->stream.ReadTimeout = PrimaryStreamInReadTimeout;
+	in->stream.AcquireBuffer = PrimaryStreamInAcquireBuffer;
+	in->stream.CommitBuffer = PrimaryStreamInCommitBuffer;
+	in->stream.SetParameter = PrimarySetStreamInParameter;
+	in->stream.GetStats = PrimaryGetStreamInStats;
 
 	in->config = stream_input_config;
 	in->in_pcm = NULL;
@@ -780,6 +938,7 @@ struct AudioHwStreamIn *CreateAudioHwStreamIn(struct AudioHwCard *card, const st
 	rtos_mutex_create(&in->lock);
 	lpri_card->input = in;
 	in->mode = CAPTURE_PURE_DATA;
+	in->next_mode = in->mode;
 	in->device = AMEBA_AUDIO_IN_MIC;
 
 	in->config.rate = config->sample_rate;
@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "speex/speex_echo.h"
+#include "speex/speex_preprocess.h"
+#include "speex/speex_resampler.h"
+
+#include "audio_hw_channel_utils.h"
+#include "audio_hw_debug.h"
+#include "audio_hw_osal_errnos.h"
+
+#include "ameba_audio_aec.h"
+
+#define AUDIO_AEC_TASK_STACK            (1024 * 8)
+#define AUDIO_AEC_EXIT_TIMEOUT_MS       1000
+#define AUDIO_AEC_REF_CHUNK             256
+#define AUDIO_AEC_RESAMPLE_QUALITY      3
+
+struct _AudioAec {
+	AudioAecConfig config;
+	uint32_t frame_size;
+	uint32_t out_channels;
+
+	SpeexEchoState *echo;
+	SpeexPreprocessState *pre[AUDIO_AEC_MAX_MICS];
+
+	int16_t *driver_buf;
+	int16_t *mic_buf;
+	int16_t *clean_buf;
+	int16_t *chan_buf;
+	int16_t *ref_buf;
+	int16_t *out_buf;
+
+	//frames of out_channels, rd and wr run freely, wr - rd is the fill.
+	rtos_mutex_t lock;
+	int16_t *ring;
+	uint32_t ring_frames;
+	uint32_t ring_rd;
+	uint32_t ring_wr;
+	rtos_sema_t data_sema;
+
+	volatile bool running;
+	rtos_sema_t exit_sema;
+
+	//driver frames read so far, the same origin as the sport rx counter.
+	uint64_t mic_frames;
+	//reference frame index minus mic frame index.
+	int64_t ref_offset;
+	bool aligned;
+	int64_t realign_frames;
+	int64_t codec_delay_frames;
+
+	uint64_t blocks;
+	uint32_t realigns;
+	uint32_t overruns;
+	uint32_t read_errors;
+	uint32_t max_block_us;
+};
+
+/*
+ * Playback kept at the capture rate in mono, indexed by the render frame counter scaled
+ * to the capture rate, so the sport tx counter points into it directly.
+ */
+typedef struct {
+	rtos_mutex_t lock;
+	AudioAec *volatile aec;
+	int16_t *ring;
+	uint32_t ring_frames;
+	//valid indexes are [start, end).
+	int64_t start;
+	int64_t end;
+	uint32_t render_rate;
+	SpeexResamplerState *resampler;
+	//last sport tx counter snapshot, in capture rate frames.
+	bool timed;
+	uint64_t rendered_frames;
+	int64_t rendered_ns;
+	int16_t mono[AUDIO_AEC_REF_CHUNK];
+	int16_t resampled[AUDIO_AEC_REF_CHUNK];
+} AudioAecRef;
+
+static AudioAecRef g_aec_ref;
+
+static void ameba_audio_aec_ref_push(const int16_t *samples, uint32_t count)
+{
+	AudioAecRef *ref = &g_aec_ref;
+
+	for (uint32_t i = 0; i < count; i++) {
+		ref->ring[ref->end % ref->ring_frames] = samples[i];
+		ref->end++;
+	}
+	if (ref->end - ref->start > (int64_t)ref->ring_frames) {
+		ref->start = ref->end - ref->ring_frames;
+	}
+}
+
+static void ameba_audio_aec_ref_downmix(int16_t *dst, const void *data, uint32_t frames, uint32_t channels, uint32_t sample_bytes)
+{
+	if (sample_bytes == 2) {
+		const int16_t *src = (const int16_t *)data;
+		for (uint32_t i = 0; i < frames; i++, src += channels) {
+			int32_t sum = 0;
+			for (uint32_t c = 0; c < channels; c++) {
+				sum += src[c];
+			}
+			dst[i] = (int16_t)(sum / (int32_t)channels);
+		}
+	} else {
+		//32bit and 8_24bit are both msb aligned.
+		const int32_t *src = (const int32_t *)data;
+		for (uint32_t i = 0; i < frames; i++, src += channels) {
+			int64_t sum = 0;
+			for (uint32_t c = 0; c < channels; c++) {
+				sum += src[c];
+			}
+			dst[i] = (int16_t)((sum / (int32_t)channels) >> 16);
+		}
+	}
+}
+
+bool ameba_audio_aec_ref_active(void)
+{
+	return g_aec_ref.aec != NULL;
+}
+
+void ameba_audio_aec_ref_write(const void *data, uint32_t frames, uint32_t channels, uint32_t sample_bytes,
+							   uint32_t rate, uint64_t written_frames, uint64_t rendered_frames, int64_t rendered_ns)
+{
+	AudioAecRef *ref = &g_aec_ref;
+	const uint8_t *src = (const uint8_t *)data;
+	uint32_t aec_rate;
+	int64_t start;
+	int32_t err;
+
+	if (ref->aec == NULL || frames == 0 || channels == 0 || rate == 0 || (sample_bytes != 2 && sample_bytes != 4)) {
+		return;
+	}
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	if (ref->aec == NULL) {
+		goto exit;
+	}
+
+	aec_rate = ref->aec->config.rate;
+	if (rate != ref->render_rate) {
+		if (ref->resampler) {
+			speex_resampler_destroy(ref->resampler);
+			ref->resampler = NULL;
+		}
+		if (rate != aec_rate) {
+			ref->resampler = speex_resampler_init(1, rate, aec_rate, AUDIO_AEC_RESAMPLE_QUALITY, &err);
+			if (!ref->resampler) {
+				HAL_AUDIO_ERROR("resampler %" PRIu32 "->%" PRIu32 " fail:%" PRId32 "", rate, aec_rate, err);
+				ref->render_rate = 0;
+				goto exit;
+			}
+		}
+		ref->render_rate = rate;
+		ref->start = ref->end;
+	}
+
+	//the block continues the previous one unless the stream restarted or dropped data.
+	start = (int64_t)((written_frames - frames) * aec_rate / rate);
+	if (start - ref->end > ref->aec->realign_frames || ref->end - start > ref->aec->realign_frames) {
+		ref->start = start;
+		ref->end = start;
+		if (ref->resampler) {
+			speex_resampler_reset_mem(ref->resampler);
+		}
+	}
+
+	ref->timed = true;
+	ref->rendered_frames = rendered_frames * aec_rate / rate;
+	ref->rendered_ns = rendered_ns;
+
+	while (frames) {
+		uint32_t in_len = frames < AUDIO_AEC_REF_CHUNK ? frames : AUDIO_AEC_REF_CHUNK;
+
+		ameba_audio_aec_ref_downmix(ref->mono, src, in_len, channels, sample_bytes);
+		src += in_len * channels * sample_bytes;
+		frames -= in_len;
+
+		if (ref->resampler) {
+			const int16_t *in = ref->mono;
+			while (in_len) {
+				spx_uint32_t consumed = in_len;
+				spx_uint32_t produced = AUDIO_AEC_REF_CHUNK;
+				speex_resampler_process_int(ref->resampler, 0, in, &consumed, ref->resampled, &produced);
+				ameba_audio_aec_ref_push(ref->resampled, produced);
+				in += consumed;
+				in_len -= consumed;
+			}
+		} else {
+			ameba_audio_aec_ref_push(ref->mono, in_len);
+		}
+	}
+
+exit:
+	rtos_mutex_give(ref->lock);
+}
+
+void ameba_audio_aec_ref_reset(void)
+{
+	AudioAecRef *ref = &g_aec_ref;
+
+	if (ref->aec == NULL) {
+		return;
+	}
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	ref->timed = false;
+	ref->start = ref->end;
+	rtos_mutex_give(ref->lock);
+}
+
+static void ameba_audio_aec_ref_read(int64_t index, int16_t *dst, uint32_t frames)
+{
+	AudioAecRef *ref = &g_aec_ref;
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	for (uint32_t i = 0; i < frames; i++, index++) {
+		//not played yet or already gone: silence, the canceller sees no far end.
+		dst[i] = (index >= ref->start && index < ref->end) ? ref->ring[index % ref->ring_frames] : 0;
+	}
+	rtos_mutex_give(ref->lock);
+}
+
+/*
+ * At the moment both counters are latched, mic frame captured_frames enters the rx sport
+ * while reference frame playing leaves the tx sport. The dac and adc delays are not in
+ * the counters, the mic hears a reference frame that much after it left the sport.
+ */
+static void ameba_audio_aec_align(AudioAec *aec)
+{
+	AudioAecRef *ref = &g_aec_ref;
+	uint64_t captured_frames;
+	int64_t now_ns;
+	bool timed;
+	uint64_t rendered_frames;
+	int64_t rendered_ns;
+	int64_t playing;
+	int64_t offset;
+
+	if (aec->config.position(aec->config.priv, &captured_frames, &now_ns) != 0) {
+		return;
+	}
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	timed = ref->timed;
+	rendered_frames = ref->rendered_frames;
+	rendered_ns = ref->rendered_ns;
+	rtos_mutex_give(ref->lock);
+
+	if (!timed) {
+		return;
+	}
+
+	playing = (int64_t)rendered_frames + (now_ns - rendered_ns) * (int64_t)aec->config.rate / 1000000000LL;
+	offset = playing - (int64_t)captured_frames - aec->codec_delay_frames;
+	if (!aec->aligned || offset - aec->ref_offset > aec->realign_frames || aec->ref_offset - offset > aec->realign_frames) {
+		if (aec->aligned) {
+			aec->realigns++;
+			HAL_AUDIO_INFO("ref offset %" PRId64 " -> %" PRId64 "", aec->ref_offset, offset);
+		}
+		aec->ref_offset = offset;
+		aec->aligned = true;
+	}
+}
+
+static void ameba_audio_aec_process(AudioAec *aec)
+{
+	uint32_t mics = aec->config.mic_channels;
+	uint32_t n = aec->frame_size;
+	const int16_t *mic = aec->driver_buf;
+
+	if (aec->config.driver_channels != mics) {
+		audio_hw_channel_drop(aec->mic_buf, mics, aec->driver_buf, aec->config.driver_channels, n, sizeof(int16_t));
+		mic = aec->mic_buf;
+	}
+
+	ameba_audio_aec_ref_read((int64_t)aec->mic_frames + aec->ref_offset, aec->ref_buf, n);
+	speex_echo_cancellation(aec->echo, mic, aec->ref_buf, aec->clean_buf);
+
+	if (mics == 1) {
+		speex_preprocess_run(aec->pre[0], aec->clean_buf);
+	} else {
+		for (uint32_t c = 0; c < mics; c++) {
+			for (uint32_t i = 0; i < n; i++) {
+				aec->chan_buf[i] = aec->clean_buf[i * mics + c];
+			}
+			speex_preprocess_run(aec->pre[c], aec->chan_buf);
+			for (uint32_t i = 0; i < n; i++) {
+				aec->clean_buf[i * mics + c] = aec->chan_buf[i];
+			}
+		}
+	}
+
+	audio_hw_channel_interleave(aec->out_buf, aec->clean_buf, mics, aec->ref_buf, 1, n, sizeof(int16_t));
+}
+
+static void ameba_audio_aec_queue(AudioAec *aec)
+{
+	uint32_t n = aec->frame_size;
+	uint32_t pos;
+	uint32_t first;
+
+	rtos_mutex_take(aec->lock, MUTEX_WAIT_TIMEOUT);
+	if (aec->ring_frames - (aec->ring_wr - aec->ring_rd) < n) {
+		//the reader is late, drop the new block like a sport overrun.
+		aec->overruns++;
+		rtos_mutex_give(aec->lock);
+		return;
+	}
+
+	pos = aec->ring_wr % aec->ring_frames;
+	first = aec->ring_frames - pos < n ? aec->ring_frames - pos : n;
+	memcpy(aec->ring + pos * aec->out_channels, aec->out_buf, first * aec->out_channels * sizeof(int16_t));
+	memcpy(aec->ring, aec->out_buf + first * aec->out_channels, (n - first) * aec->out_channels * sizeof(int16_t));
+	aec->ring_wr += n;
+	rtos_mutex_give(aec->lock);
+
+	rtos_sema_give(aec->data_sema);
+}
+
+static void ameba_audio_aec_task(void *param)
+{
+	AudioAec *aec = (AudioAec *)param;
+	uint32_t driver_bytes = aec->frame_size * aec->config.driver_channels * sizeof(int16_t);
+
+	while (aec->running) {
+		int32_t ret = aec->config.read(aec->config.priv, aec->driver_buf, driver_bytes);
+		uint64_t start_us;
+		uint32_t block_us;
+
+		if (ret != (int32_t)driver_bytes) {
+			aec->read_errors++;
+			if (ret < 0) {
+				rtos_time_delay_ms(AUDIO_AEC_FRAME_MS);
+			}
+			continue;
+		}
+
+		start_us = rtos_time_get_current_system_time_us();
+		ameba_audio_aec_align(aec);
+		ameba_audio_aec_process(aec);
+		ameba_audio_aec_queue(aec);
+		block_us = (uint32_t)(rtos_time_get_current_system_time_us() - start_us);
+		if (block_us > aec->max_block_us) {
+			aec->max_block_us = block_us;
+		}
+
+		aec->mic_frames += aec->frame_size;
+		aec->blocks++;
+	}
+
+	rtos_sema_give(aec->exit_sema);
+	rtos_task_delete(NULL);
+}
+
+static void ameba_audio_aec_free(AudioAec *aec)
+{
+	if (aec->echo) {
+		speex_echo_state_destroy(aec->echo);
+	}
+	for (uint32_t c = 0; c < AUDIO_AEC_MAX_MICS; c++) {
+		if (aec->pre[c]) {
+			speex_preprocess_state_destroy(aec->pre[c]);
+		}
+	}
+	if (aec->data_sema) {
+		rtos_sema_delete(aec->data_sema);
+	}
+	if (aec->exit_sema) {
+		rtos_sema_delete(aec->exit_sema);
+	}
+	if (aec->lock) {
+		rtos_mutex_delete(aec->lock);
+	}
+	rtos_mem_free(aec->driver_buf);
+	rtos_mem_free(aec->mic_buf);
+	rtos_mem_free(aec->clean_buf);
+	rtos_mem_free(aec->chan_buf);
+	rtos_mem_free(aec->ref_buf);
+	rtos_mem_free(aec->out_buf);
+	rtos_mem_free(aec->ring);
+	rtos_mem_free(aec);
+}
+
+AudioAec *ameba_audio_aec_create(const AudioAecConfig *config)
+{
+	AudioAecRef *ref = &g_aec_ref;
+	AudioAec *aec;
+	uint32_t n;
+	uint32_t mics = config->mic_channels;
+	int32_t denoise = AUDIO_HW_AEC_NOISE_SUPPRESS_DB > 0;
+	int32_t suppress = -AUDIO_HW_AEC_NOISE_SUPPRESS_DB;
+	int32_t rate = (int32_t)config->rate;
+
+	if (mics == 0 || mics > AUDIO_AEC_MAX_MICS || config->driver_channels < mics || !config->read || !config->position) {
+		HAL_AUDIO_ERROR("mics:%" PRIu32 " driver channels:%" PRIu32 " not supported", mics, config->driver_channels);
+		return NULL;
+	}
+
+	if (ref->lock == NULL) {
+		rtos_mutex_create(&ref->lock);
+	}
+	if (ref->aec != NULL) {
+		HAL_AUDIO_ERROR("echo canceller is busy");
+		return NULL;
+	}
+
+	aec = (AudioAec *)rtos_mem_zmalloc(sizeof(AudioAec));
+	if (!aec) {
+		return NULL;
+	}
+
+	n = 1;
+	while (n * 2 <= config->rate * AUDIO_AEC_FRAME_MS / 1000) {
+		n *= 2;
+	}
+	aec->config = *config;
+	aec->frame_size = n;
+	aec->out_channels = mics + 1;
+	aec->ring_frames = config->buffer_frames > 2 * n ? config->buffer_frames : 2 * n;
+	aec->realign_frames = (int64_t)config->rate * AUDIO_AEC_REALIGN_US / 1000000;
+	aec->codec_delay_frames = (int64_t)config->rate * AUDIO_HW_AEC_CODEC_DELAY_US / 1000000;
+
+	aec->driver_buf = (int16_t *)rtos_mem_zmalloc(n * config->driver_channels * sizeof(int16_t));
+	aec->mic_buf = (int16_t *)rtos_mem_zmalloc(n * mics * sizeof(int16_t));
+	aec->clean_buf = (int16_t *)rtos_mem_zmalloc(n * mics * sizeof(int16_t));
+	aec->chan_buf = (int16_t *)rtos_mem_zmalloc(n * sizeof(int16_t));
+	aec->ref_buf = (int16_t *)rtos_mem_zmalloc(n * sizeof(int16_t));
+	aec->out_buf = (int16_t *)rtos_mem_zmalloc(n * aec->out_channels * sizeof(int16_t));
+	aec->ring = (int16_t *)rtos_mem_zmalloc(aec->ring_frames * aec->out_channels * sizeof(int16_t));
+	if (!aec->driver_buf || !aec->mic_buf || !aec->clean_buf || !aec->chan_buf || !aec->ref_buf || !aec->out_buf || !aec->ring) {
+		HAL_AUDIO_ERROR("no memory for buffers");
+		goto fail;
+	}
+
+	aec->echo = speex_echo_state_init_mc(n, config->rate * AUDIO_HW_AEC_TAIL_MS / 1000, mics, 1);
+	if (!aec->echo) {
+		goto fail;
+	}
+	speex_echo_ctl(aec->echo, SPEEX_ECHO_SET_SAMPLING_RATE, &rate);
+
+	for (uint32_t c = 0; c < mics; c++) {
+		aec->pre[c] = speex_preprocess_state_init(n, config->rate);
+		if (!aec->pre[c]) {
+			goto fail;
+		}
+		speex_preprocess_ctl(aec->pre[c], SPEEX_PREPROCESS_SET_DENOISE, &denoise);
+		speex_preprocess_ctl(aec->pre[c], SPEEX_PREPROCESS_SET_NOISE_SUPPRESS, &suppress);
+		//the residual echo estimate follows the first mic, close enough for mics on one board.
+		speex_preprocess_ctl(aec->pre[c], SPEEX_PREPROCESS_SET_ECHO_STATE, aec->echo);
+	}
+
+	if (rtos_mutex_create(&aec->lock) != RTK_SUCCESS ||
+		rtos_sema_create_binary(&aec->data_sema) != RTK_SUCCESS ||
+		rtos_sema_create_binary(&aec->exit_sema) != RTK_SUCCESS) {
+		goto fail;
+	}
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	ref->ring_frames = config->rate * AUDIO_AEC_REF_MS / 1000;
+	ref->ring = (int16_t *)rtos_mem_zmalloc(ref->ring_frames * sizeof(int16_t));
+	ref->start = 0;
+	ref->end = 0;
+	ref->render_rate = 0;
+	ref->timed = false;
+	if (ref->ring) {
+		ref->aec = aec;
+	}
+	rtos_mutex_give(ref->lock);
+	if (!ref->ring) {
+		HAL_AUDIO_ERROR("no memory for reference");
+		goto fail;
+	}
+
+	aec->running = true;
+	if (rtos_task_create(NULL, "audio_aec", ameba_audio_aec_task, aec, AUDIO_AEC_TASK_STACK, AUDIO_HW_AEC_TASK_PRIORITY) != RTK_SUCCESS) {
+		HAL_AUDIO_ERROR("create aec task fail");
+		aec->running = false;
+		ameba_audio_aec_destroy(aec);
+		return NULL;
+	}
+
+	HAL_AUDIO_INFO("rate:%" PRIu32 " mics:%" PRIu32 " frame:%" PRIu32 " tail:%d ms", config->rate, mics, n, AUDIO_HW_AEC_TAIL_MS);
+	return aec;
+
+fail:
+	ameba_audio_aec_free(aec);
+	return NULL;
+}
+
+void ameba_audio_aec_destroy(AudioAec *aec)
+{
+	AudioAecRef *ref = &g_aec_ref;
+
+	if (!aec) {
+		return;
+	}
+
+	if (aec->running) {
+		aec->running = false;
+		if (rtos_sema_take(aec->exit_sema, AUDIO_AEC_EXIT_TIMEOUT_MS) != RTK_SUCCESS) {
+			//the worker still uses aec, leaking it is better than a use after free.
+			HAL_AUDIO_ERROR("aec task does not exit");
+			return;
+		}
+	}
+
+	rtos_mutex_take(ref->lock, MUTEX_WAIT_TIMEOUT);
+	if (ref->aec == aec) {
+		ref->aec = NULL;
+		rtos_mem_free(ref->ring);
+		ref->ring = NULL;
+		if (ref->resampler) {
+			speex_resampler_destroy(ref->resampler);
+			ref->resampler = NULL;
+		}
+	}
+	rtos_mutex_give(ref->lock);
+
+	HAL_AUDIO_INFO("blocks:%" PRIu64 " realigns:%" PRIu32 " overruns:%" PRIu32 " max block:%" PRIu32 "us",
+				   aec->blocks, aec->realigns, aec->overruns, aec->max_block_us);
+	ameba_audio_aec_free(aec);
+}
+
+int32_t ameba_audio_aec_read(AudioAec *aec, void *buffer, uint32_t frames, uint32_t time_out_ms)
+{
+	uint8_t *dst = (uint8_t *)buffer;
+	uint32_t frame_bytes = aec->out_channels * sizeof(int16_t);
+	uint32_t done = 0;
+
+	while (done < frames) {
+		uint32_t avail;
+		uint32_t pos;
+		uint32_t count;
+
+		rtos_mutex_take(aec->lock, MUTEX_WAIT_TIMEOUT);
+		avail = aec->ring_wr - aec->ring_rd;
+		count = frames - done < avail ? frames - done : avail;
+		pos = aec->ring_rd % aec->ring_frames;
+		if (count > aec->ring_frames - pos) {
+			count = aec->ring_frames - pos;
+		}
+		memcpy(dst + done * frame_bytes, aec->ring + pos * aec->out_channels, count * frame_bytes);
+		aec->ring_rd += count;
+		rtos_mutex_give(aec->lock);
+
+		done += count;
+		if (done < frames && count == 0 && rtos_sema_take(aec->data_sema, time_out_ms) != RTK_SUCCESS) {
+			break;
+		}
+	}
+
+	return (int32_t)(done * frame_bytes);
+}
+
+/* Format as "key=value;..." like the SetParameters strings. */
+int32_t ameba_audio_aec_to_str(const AudioAec *aec, char *str, size_t len)
+{
+	if (!aec) {
+		return snprintf(str, len, "enabled=0");
+	}
+
+	return snprintf(str, len, "enabled=1;mics=%lu;blocks=%llu;ref_offset=%lld;realigns=%lu;overruns=%lu;read_errors=%lu;max_block_us=%lu",
+					(unsigned long)aec->config.mic_channels, (unsigned long long)aec->blocks, (long long)aec->ref_offset,
+					(unsigned long)aec->realigns, (unsigned long)aec->overruns, (unsigned long)aec->read_errors,
+					(unsigned long)aec->max_block_us);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_AEC_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_AEC_H
+
+#include <stddef.h>
+
+#include "basic_types.h"
+#include "os_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GetParameters key of the stream in to get the echo canceller state. */
+#define AMEBA_AUDIO_AEC_KEY             "aec"
+#define AMEBA_AUDIO_AEC_STR_LEN         160
+
+/*
+ * Board tuning, define them in ameba_audio_hw_usrcfg.h to override.
+ * AUDIO_HW_AEC_TAIL_MS: echo path length the adaptive filter covers, room reverb included.
+ * AUDIO_HW_AEC_CODEC_DELAY_US: dac + adc group delay outside the sport counters, the
+ * reference is moved this much later so the filter does not spend taps on it.
+ * AUDIO_HW_AEC_NOISE_SUPPRESS_DB: preprocessor noise attenuation, 0 disables denoise.
+ * The speexdsp build is fixed point, which has no preprocessor agc.
+ */
+#ifndef AUDIO_HW_AEC_TAIL_MS
+#define AUDIO_HW_AEC_TAIL_MS            128
+#endif
+#ifndef AUDIO_HW_AEC_CODEC_DELAY_US
+#define AUDIO_HW_AEC_CODEC_DELAY_US     1000
+#endif
+#ifndef AUDIO_HW_AEC_NOISE_SUPPRESS_DB
+#define AUDIO_HW_AEC_NOISE_SUPPRESS_DB  15
+#endif
+#ifndef AUDIO_HW_AEC_TASK_PRIORITY
+#define AUDIO_HW_AEC_TASK_PRIORITY      5
+#endif
+
+/*
+ * processing block: the power of two frames closest below 10ms(128 at 16k, 256 at 48k), the
+ * echo canceller and the preprocessor transform twice the block, and only power of two sizes
+ * run on the radix-4 fft backend.
+ */
+#define AUDIO_AEC_FRAME_MS              10
+/* playback kept for the reference, covers the render buffer plus the tail. */
+#define AUDIO_AEC_REF_MS                500
+/* the counter based alignment jitters by a few frames, only larger moves realign. */
+#define AUDIO_AEC_REALIGN_US            2000
+#define AUDIO_AEC_MAX_MICS              4
+
+/*
+ * Reads one block of driver frames, returns bytes read or a negative error.
+ */
+typedef int32_t (*AudioAecReadFunc)(void *priv, void *data, uint32_t bytes);
+/*
+ * Sport rx counter of the capture stream, and the time it was latched at.
+ */
+typedef int32_t (*AudioAecPositionFunc)(void *priv, uint64_t *captured_frames, int64_t *now_ns);
+
+typedef struct _AudioAecConfig {
+	uint32_t rate;
+	/* mic channels to clean, the first channels of each driver frame. */
+	uint32_t mic_channels;
+	uint32_t driver_channels;
+	/* frames buffered between the worker and the reader. */
+	uint32_t buffer_frames;
+	AudioAecReadFunc read;
+	AudioAecPositionFunc position;
+	void *priv;
+} AudioAecConfig;
+
+typedef struct _AudioAec AudioAec;
+
+/*
+ * Starts the worker task, which reads the driver with config->read, cancels the playback
+ * echo and denoises each mic, then queues frames of mic_channels clean channels plus the
+ * time aligned reference as the last channel. 16bit only, one instance at a time.
+ */
+AudioAec *ameba_audio_aec_create(const AudioAecConfig *config);
+/* stops the worker, the driver must still be running so the worker can leave its read. */
+void ameba_audio_aec_destroy(AudioAec *aec);
+/*
+ * Gets frames * (mic_channels + 1) samples, waiting at most time_out_ms for each block.
+ * Returns bytes read, short if it timed out.
+ */
+int32_t ameba_audio_aec_read(AudioAec *aec, void *buffer, uint32_t frames, uint32_t time_out_ms);
+
+/* true while an echo canceller runs, the stream out skips the tap otherwise. */
+bool ameba_audio_aec_ref_active(void);
+/*
+ * Playback tap, called by the primary stream out after each driver write with the data
+ * written, the frames written to the driver so far including this block, and a snapshot
+ * of the sport tx counter. Returns at once when no echo canceller runs.
+ */
+void ameba_audio_aec_ref_write(const void *data, uint32_t frames, uint32_t channels, uint32_t sample_bytes,
+							   uint32_t rate, uint64_t written_frames, uint64_t rendered_frames, int64_t rendered_ns);
+/* the stream out went to standby, its counters restart from 0. */
+void ameba_audio_aec_ref_reset(void);
+
+int32_t ameba_audio_aec_to_str(const AudioAec *aec, char *str, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_CYCLES_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_CYCLES_H
+
+#include "ameba.h"
+#include "basic_types.h"
+#include "os_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Free running cpu cycle counter of the core the caller runs on: mcycle on riscv, DWT
+ * CYCCNT on km4/km0, PMCCNTR on ca32. The ca32 counter is per core, so a measured section
+ * should not migrate between cores. Hosts without any of them get system time in cycles.
+ */
+static inline void ameba_audio_cycles_enable(void)
+{
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_7EM__)
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+#elif defined(__ARM_ARCH_7A__)
+	uint32_t enabled;
+	__asm volatile("mrc p15, 0, %0, c9, c12, 1" : "=r"(enabled));
+	if (!(enabled & 0x80000000)) {
+		uint32_t pmcr;
+		__asm volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+		__asm volatile("mcr p15, 0, %0, c9, c12, 0" :: "r"(pmcr | 0x1));
+		__asm volatile("mcr p15, 0, %0, c9, c12, 1" :: "r"(0x80000000));
+	}
+#endif
+}
+
+static inline uint32_t ameba_audio_cycles(void)
+{
+#if defined(__riscv)
+	uint32_t cycles;
+	__asm volatile("csrr %0, mcycle" : "=r"(cycles));
+	return cycles;
+#elif defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_7EM__)
+	return DWT->CYCCNT;
+#elif defined(__ARM_ARCH_7A__)
+	uint32_t cycles;
+	__asm volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+	return cycles;
+#else
+	return (uint32_t)(rtos_time_get_current_system_time_us() * (SystemGetCpuClk() / 1000000));
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "audio_hw_debug.h"
+
+#include "ameba_audio_drift.h"
+
+//the i2s pll is shared by all sports of the rate family, one loop drives it.
+static AudioDrift *g_drift_pll_owner;
+
+void ameba_audio_drift_init(AudioDrift *drift, uint32_t rate, bool capture, uint32_t target_ms)
+{
+	ameba_audio_drift_release_pll(drift);
+
+	memset(drift, 0, sizeof(AudioDrift));
+	drift->enabled = target_ms > 0 && rate > 0;
+	drift->capture = capture;
+	drift->rate = rate;
+	drift->target_frames = (float)target_ms * rate / 1000;
+}
+
+void ameba_audio_drift_restart(AudioDrift *drift)
+{
+	drift->primed = false;
+	drift->ppm = drift->drift_ppm;
+}
+
+bool ameba_audio_drift_update(AudioDrift *drift, int64_t counted_frames, int64_t ring_frames, uint32_t period_frames)
+{
+	uint64_t now_us = rtos_time_get_current_system_time_us();
+	int64_t fill_frames = counted_frames + drift->counter_offset;
+	float dt;
+	float error_s;
+	float ppm;
+
+	if (!drift->enabled) {
+		return false;
+	}
+
+	if (!drift->primed || fill_frames > ring_frames || fill_frames < ring_frames - (int64_t)period_frames) {
+		drift->counter_offset = ring_frames - period_frames / 2 - counted_frames;
+		fill_frames = counted_frames + drift->counter_offset;
+	}
+
+	if (!drift->primed) {
+		drift->primed = true;
+		drift->fill_frames = (float)fill_frames;
+		drift->start_us = now_us;
+		drift->last_us = now_us;
+		drift->last_update_us = now_us;
+		return false;
+	}
+
+	dt = (float)(now_us - drift->last_us) / 1000;
+	drift->fill_frames += ((float)fill_frames - drift->fill_frames) * dt / (AUDIO_DRIFT_FILTER_MS + dt);
+	drift->last_us = now_us;
+
+	if (now_us - drift->start_us < AUDIO_DRIFT_SETTLE_MS * 1000ULL) {
+		drift->last_update_us = now_us;
+		return false;
+	}
+	if (now_us - drift->last_update_us < AUDIO_DRIFT_UPDATE_MS * 1000ULL) {
+		return false;
+	}
+
+	dt = (float)(now_us - drift->last_update_us) / 1000000;
+	drift->last_update_us = now_us;
+
+	//render: too much queued means the sport is slow. capture: the reader is slow.
+	error_s = (drift->fill_frames - drift->target_frames) / drift->rate;
+	if (drift->capture) {
+		error_s = -error_s;
+	}
+
+	ppm = AUDIO_DRIFT_KP * error_s + drift->drift_ppm + AUDIO_DRIFT_KI * error_s * dt;
+	//no integration while saturated, or the loop winds up on a long underrun.
+	if (ppm < AUDIO_DRIFT_MAX_PPM && ppm > -AUDIO_DRIFT_MAX_PPM) {
+		drift->drift_ppm += AUDIO_DRIFT_KI * error_s * dt;
+	} else {
+		ppm = ppm > 0 ? AUDIO_DRIFT_MAX_PPM : -AUDIO_DRIFT_MAX_PPM;
+	}
+	drift->ppm = ppm;
+
+	return drift->ppm - drift->applied_ppm >= AUDIO_DRIFT_PLL_STEP_PPM ||
+		   drift->applied_ppm - drift->ppm >= AUDIO_DRIFT_PLL_STEP_PPM;
+}
+
+void ameba_audio_drift_applied(AudioDrift *drift, float ppm)
+{
+	drift->applied_ppm = ppm;
+}
+
+bool ameba_audio_drift_claim_pll(AudioDrift *drift)
+{
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	if (g_drift_pll_owner == NULL) {
+		g_drift_pll_owner = drift;
+		drift->owns_pll = true;
+	}
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	return drift->owns_pll;
+}
+
+void ameba_audio_drift_release_pll(AudioDrift *drift)
+{
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	if (g_drift_pll_owner == drift) {
+		g_drift_pll_owner = NULL;
+	}
+	drift->owns_pll = false;
+	drift->applied_ppm = 0;
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+}
+
+/* Format as "key=value;..." like the SetParameters strings. */
+int32_t ameba_audio_drift_to_str(const AudioDrift *drift, char *str, size_t len)
+{
+	return snprintf(str, len, "enabled=%d;owns_pll=%d;target_frames=%ld;fill_frames=%ld;drift_ppm=%ld;applied_ppm=%ld",
+					drift->enabled, drift->owns_pll, (long)drift->target_frames, (long)drift->fill_frames,
+					(long)drift->drift_ppm, (long)drift->applied_ppm);
+}
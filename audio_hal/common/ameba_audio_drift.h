@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_DRIFT_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_DRIFT_H
+
+#include "basic_types.h"
+#include "os_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GetParameters key of the streams to get the drift compensation state. */
+#define AMEBA_AUDIO_DRIFT_KEY           "drift"
+#define AMEBA_AUDIO_DRIFT_STR_LEN       128
+
+/* correction range, well above crystal and bt/usb source tolerances. */
+#define AUDIO_DRIFT_MAX_PPM             500.0f
+/* the i2s pll moves ~1.55ppm per FOF step, smaller changes are not written. */
+#define AUDIO_DRIFT_PLL_STEP_PPM        1.55f
+/* the fill after start is not steady yet, control begins this much later. */
+#define AUDIO_DRIFT_SETTLE_MS           1000
+#define AUDIO_DRIFT_UPDATE_MS           100
+/* time constant of the fill low pass, hides the write/dma sawtooth. */
+#define AUDIO_DRIFT_FILTER_MS           500
+/*
+ * PI gains on the fill error in seconds of audio. Critically damped loop at 0.1rad/s:
+ * 1ms of error asks for 200ppm, the integral settles on the source/sport clock drift.
+ */
+#define AUDIO_DRIFT_KP                  200000.0f
+#define AUDIO_DRIFT_KI                  10000.0f
+
+/*
+ * Keeps the frames queued between a producer on its own clock(bt, usb) and the sport
+ * at a target level by trimming the i2s pll. The stream calls update each time data
+ * arrives, and applies ppm when it returns true. Only one stream at a time owns the
+ * pll, the others keep estimating without trimming.
+ */
+typedef struct _AudioDrift {
+	bool enabled;
+	bool capture;
+	bool owns_pll;
+	bool primed;
+	uint32_t rate;
+	float target_frames;
+	float fill_frames;
+	/* rebases the sport counter fill on the ring fill, see ameba_audio_drift_update. */
+	int64_t counter_offset;
+	/* integral term, the estimated clock drift between source and sport. */
+	float drift_ppm;
+	float ppm;
+	float applied_ppm;
+	uint64_t start_us;
+	uint64_t last_us;
+	uint64_t last_update_us;
+} AudioDrift;
+
+/* target_ms 0 disables. capture: the sport produces and the task consumes. */
+void ameba_audio_drift_init(AudioDrift *drift, uint32_t rate, bool capture, uint32_t target_ms);
+/* stream restarted: refilter from scratch, keep the drift estimate as a warm start. */
+void ameba_audio_drift_restart(AudioDrift *drift);
+/*
+ * counted_frames: frames from the source minus frames shifted by the sport counter. Exact,
+ * but off by the frames a fifo underflow shifted without data.
+ * ring_frames: frames in the ring, which keeps each dma period until its irq, so the real
+ * fill is between ring_frames - period_frames and ring_frames.
+ * The counter fill is used, moved back into the ring bracket when it leaves it.
+ * Returns true when ppm moved by at least one pll step from applied_ppm.
+ */
+bool ameba_audio_drift_update(AudioDrift *drift, int64_t counted_frames, int64_t ring_frames, uint32_t period_frames);
+void ameba_audio_drift_applied(AudioDrift *drift, float ppm);
+
+bool ameba_audio_drift_claim_pll(AudioDrift *drift);
+void ameba_audio_drift_release_pll(AudioDrift *drift);
+
+int32_t ameba_audio_drift_to_str(const AudioDrift *drift, char *str, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
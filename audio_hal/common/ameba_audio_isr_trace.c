@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "audio_hw_debug.h"
+
+#include "ameba_audio_isr_trace.h"
+
+static AudioIsrTraceEntry g_isr_trace[AUDIO_ISR_TRACE_SIZE];
+//count of entries ever taken, the slot is head % AUDIO_ISR_TRACE_SIZE.
+static volatile uint32_t g_isr_trace_head;
+
+AudioIsrTraceEntry *ameba_audio_isr_trace_begin(uint32_t direction, uint32_t gdma_id)
+{
+	AudioIsrTraceEntry *entry;
+	uint32_t slot;
+
+	//the ca32 counter is per core, the irq may come to any of them.
+	ameba_audio_cycles_enable();
+
+	//gdma irqs of tx and rx may nest or come to different cores.
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	slot = g_isr_trace_head++ % AUDIO_ISR_TRACE_SIZE;
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	entry = &g_isr_trace[slot];
+	entry->action = AUDIO_ISR_TRACE_BUSY;
+	entry->direction = (uint8_t)direction;
+	entry->gdma_id = (uint8_t)gdma_id;
+	entry->sem_posted = 0;
+	entry->fill_bytes = 0;
+	entry->exit_cycles = 0;
+	entry->enter_cycles = ameba_audio_cycles();
+
+	return entry;
+}
+
+void ameba_audio_isr_trace_end(AudioIsrTraceEntry *entry)
+{
+	entry->exit_cycles = ameba_audio_cycles();
+	if (entry->action == AUDIO_ISR_TRACE_BUSY) {
+		entry->action = AUDIO_ISR_TRACE_RESTART;
+	}
+}
+
+/*
+ * Copy up to max finished entries, oldest first. No irq masking: the entries the irq
+ * overwrote during the copy are dropped by checking the head again afterwards.
+ */
+uint32_t ameba_audio_isr_trace_read(AudioIsrTraceEntry *entries, uint32_t max)
+{
+	uint32_t head = g_isr_trace_head;
+	uint32_t count = head < AUDIO_ISR_TRACE_SIZE ? head : AUDIO_ISR_TRACE_SIZE;
+	uint32_t first;
+	uint32_t valid = 0;
+
+	if (count > max) {
+		count = max;
+	}
+	first = head - count;
+
+	for (uint32_t i = 0; i < count; i++) {
+		entries[i] = g_isr_trace[(first + i) % AUDIO_ISR_TRACE_SIZE];
+	}
+
+	//slots reused by irqs coming during the copy hold newer data, skip them.
+	head = g_isr_trace_head;
+	for (uint32_t i = 0; i < count; i++) {
+		if (first + i + AUDIO_ISR_TRACE_SIZE <= head || entries[i].action == AUDIO_ISR_TRACE_BUSY) {
+			continue;
+		}
+		entries[valid++] = entries[i];
+	}
+
+	return valid;
+}
+
+void ameba_audio_isr_trace_clear(void)
+{
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	g_isr_trace_head = 0;
+	memset(g_isr_trace, 0, sizeof(g_isr_trace));
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_ISR_TRACE_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_ISR_TRACE_H
+
+#include "ameba_audio_cycles.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Trace ring of the gdma complete irqs of all streams. The irq fills one entry, task
+ * context reads them later, nothing is printed inside the irq.
+ */
+#define AUDIO_ISR_TRACE_SIZE        128
+
+/* What the irq decided for the gdma. */
+#define AUDIO_ISR_TRACE_BUSY        0  //entry being written by the irq
+#define AUDIO_ISR_TRACE_RESTART     1  //gdma restarted for the next period
+#define AUDIO_ISR_TRACE_XRUN        2  //ring empty(out) or full(in), gdma stopped
+#define AUDIO_ISR_TRACE_WAIT_PEER   3  //fifo0/fifo1 split, xrun waits for the other gdma
+#define AUDIO_ISR_TRACE_END         4  //stop/standby is waiting for this gdma end
+
+typedef struct _AudioIsrTraceEntry {
+	uint32_t enter_cycles;
+	uint32_t exit_cycles;
+	uint32_t fill_bytes;  //data in the ring after the irq bookkeeping
+	uint8_t  direction;   //STREAM_OUT or STREAM_IN
+	uint8_t  gdma_id;     //0: gdma for fifo0, 1: gdma for fifo1
+	uint8_t  action;
+	uint8_t  sem_posted;  //1 if a blocked Write/Read was woken
+} AudioIsrTraceEntry;
+
+AudioIsrTraceEntry *ameba_audio_isr_trace_begin(uint32_t direction, uint32_t gdma_id);
+void ameba_audio_isr_trace_end(AudioIsrTraceEntry *entry);
+uint32_t ameba_audio_isr_trace_read(AudioIsrTraceEntry *entries, uint32_t max);
+void ameba_audio_isr_trace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
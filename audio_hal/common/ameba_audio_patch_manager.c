@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "audio_hw_debug.h"
+#include "audio_hw_osal_errnos.h"
+
+#include "ameba_audio_patch_manager.h"
+
+enum {
+	PATCH_CONFLICT_NONE          = 0,
+	PATCH_CONFLICT_SPORT         = 1,
+	PATCH_CONFLICT_CODEC         = 2,
+	PATCH_CONFLICT_SPORT_RATE    = 3,
+	PATCH_CONFLICT_CLOCK_SOURCE  = 4,
+	PATCH_CONFLICT_PLL_FAMILY    = 5,
+};
+
+typedef struct {
+	bool used;
+	AudioPatchRoute route;
+} AudioPatchSlot;
+
+static AudioPatchSlot g_patch_slots[AUDIO_PATCH_MAX_NUM];
+
+static const char *g_patch_conflict_str[] = {
+	"none", "sport in use", "codec in use", "sport rate", "clock source", "pll rate family"
+};
+
+static bool ameba_audio_patch_manager_is_48k_family(uint32_t rate)
+{
+	return rate % 8000 == 0;
+}
+
+static uint32_t ameba_audio_patch_manager_check(const AudioPatchRoute *route, const AudioPatchRoute *running)
+{
+	uint32_t route_sports = route->rx_sports | route->tx_sports;
+	uint32_t running_sports = running->rx_sports | running->tx_sports;
+
+	if ((route->rx_sports & running->rx_sports) || (route->tx_sports & running->tx_sports)) {
+		return PATCH_CONFLICT_SPORT;
+	}
+
+	if ((route->codec_in && running->codec_in) || (route->codec_out && running->codec_out)) {
+		return PATCH_CONFLICT_CODEC;
+	}
+
+	//the other direction of a sport of the running patch.
+	if ((route_sports & running_sports) && route->rate != running->rate) {
+		return PATCH_CONFLICT_SPORT_RATE;
+	}
+
+	if (((route->clk_sports | route_sports) & (running->clk_sports | running_sports))
+		&& route->pll != running->pll) {
+		return PATCH_CONFLICT_CLOCK_SOURCE;
+	}
+
+	if (route->pll && running->pll
+		&& ameba_audio_patch_manager_is_48k_family(route->rate) != ameba_audio_patch_manager_is_48k_family(running->rate)) {
+		return PATCH_CONFLICT_PLL_FAMILY;
+	}
+
+	return PATCH_CONFLICT_NONE;
+}
+
+int32_t ameba_audio_patch_manager_add(const AudioPatchRoute *route)
+{
+	int32_t patch_index = HAL_OSAL_ERR_NO_MEMORY;
+	int32_t conflict_index = -1;
+	uint32_t conflict = PATCH_CONFLICT_NONE;
+
+	if (!route || !route->rate || !(route->rx_sports | route->codec_in) || !(route->tx_sports | route->codec_out)) {
+		return HAL_OSAL_ERR_INVALID_PARAM;
+	}
+
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	for (int32_t i = 0; i < AUDIO_PATCH_MAX_NUM; i++) {
+		if (!g_patch_slots[i].used) {
+			if (patch_index < 0) {
+				patch_index = i;
+			}
+			continue;
+		}
+		conflict = ameba_audio_patch_manager_check(route, &g_patch_slots[i].route);
+		if (conflict != PATCH_CONFLICT_NONE) {
+			conflict_index = i;
+			break;
+		}
+	}
+
+	if (conflict == PATCH_CONFLICT_NONE && patch_index >= 0) {
+		g_patch_slots[patch_index].used = true;
+		g_patch_slots[patch_index].route = *route;
+	}
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	if (conflict != PATCH_CONFLICT_NONE) {
+		HAL_AUDIO_ERROR("patch conflicts with patch %ld: %s", conflict_index, g_patch_conflict_str[conflict]);
+		return conflict == PATCH_CONFLICT_SPORT || conflict == PATCH_CONFLICT_CODEC ?
+			   HAL_OSAL_ERR_ALREADY_EXISTS : HAL_OSAL_ERR_INVALID_OPERATION;
+	}
+
+	if (patch_index < 0) {
+		HAL_AUDIO_ERROR("all %d patches in use", AUDIO_PATCH_MAX_NUM);
+		return patch_index;
+	}
+
+	HAL_AUDIO_INFO("add patch %ld, rx sports:%lx, tx sports:%lx, codec in:%d, out:%d, pll:%d, rate:%lu",
+				   patch_index, route->rx_sports, route->tx_sports, route->codec_in, route->codec_out,
+				   route->pll, route->rate);
+	return patch_index;
+}
+
+int32_t ameba_audio_patch_manager_get(int32_t patch_index, AudioPatchRoute *route)
+{
+	int32_t ret = HAL_OSAL_OK;
+
+	if (patch_index < 0 || patch_index >= AUDIO_PATCH_MAX_NUM || !route) {
+		return HAL_OSAL_ERR_BAD_INDEX;
+	}
+
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	if (g_patch_slots[patch_index].used) {
+		*route = g_patch_slots[patch_index].route;
+	} else {
+		ret = HAL_OSAL_ERR_NAMERR_NOT_FOUND;
+	}
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	return ret;
+}
+
+int32_t ameba_audio_patch_manager_remove(int32_t patch_index)
+{
+	int32_t ret = HAL_OSAL_OK;
+
+	if (patch_index < 0 || patch_index >= AUDIO_PATCH_MAX_NUM) {
+		return HAL_OSAL_ERR_BAD_INDEX;
+	}
+
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	if (g_patch_slots[patch_index].used) {
+		memset(&g_patch_slots[patch_index], 0, sizeof(AudioPatchSlot));
+	} else {
+		ret = HAL_OSAL_ERR_NAMERR_NOT_FOUND;
+	}
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	return ret;
+}
+
+uint32_t ameba_audio_patch_manager_get_sports(void)
+{
+	uint32_t sports = 0;
+
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	for (int32_t i = 0; i < AUDIO_PATCH_MAX_NUM; i++) {
+		if (g_patch_slots[i].used) {
+			sports |= g_patch_slots[i].route.rx_sports | g_patch_slots[i].route.tx_sports;
+		}
+	}
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	return sports;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_PATCH_MANAGER_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_PATCH_MANAGER_H
+
+#include "basic_types.h"
+#include "os_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_PATCH_MAX_NUM             4
+#define AUDIO_PATCH_SPORT_BIT(index)    ((uint32_t)0x00000001 << (index))
+
+/*
+ * Hardware held by one direct patch. The soc patch code fills it from the sources and
+ * sinks, the manager checks it against the patches already running.
+ */
+typedef struct _AudioPatchRoute {
+	/* bit n set: rx or tx of sport n belongs to the patch. */
+	uint32_t rx_sports;
+	uint32_t tx_sports;
+	/* sports whose clock source mux the patch selects, all of them on socs with one mux. */
+	uint32_t clk_sports;
+	bool codec_in;
+	bool codec_out;
+	/* sports of the patch run from the i2s pll instead of the xtal. */
+	bool pll;
+	/* direct routes have no src, every node of a patch runs at this rate. */
+	uint32_t rate;
+} AudioPatchRoute;
+
+/*
+ * Returns the patch index, or < 0 when the route needs a sport direction or codec path
+ * another patch holds, or can not share its clocks:
+ * - rx and tx of one sport share the bclk dividers, so the rate must match.
+ * - sports on one clock source mux must agree on pll or xtal.
+ * - the i2s pll runs at 98.304M or 45.1584M, all pll patches need one rate family.
+ */
+int32_t ameba_audio_patch_manager_add(const AudioPatchRoute *route);
+int32_t ameba_audio_patch_manager_get(int32_t patch_index, AudioPatchRoute *route);
+int32_t ameba_audio_patch_manager_remove(int32_t patch_index);
+/* sports any patch holds in either direction. */
+uint32_t ameba_audio_patch_manager_get_sports(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
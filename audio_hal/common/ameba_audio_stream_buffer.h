@@ -28,6 +28,19 @@ typedef struct _AudioBuffer {
 	size_t size_remain;
 	size_t capacity;
 	char *raw_data;
+	/*
+	 * noirq mode tx only: bytes written by cpu from dirty_start but not cleaned to
+	 * memory yet, gdma reads the ring without cpu involved, so they must be cleaned
+	 * before gdma gets there.
+	 */
+	size_t dirty_start;
+	size_t dirty_bytes;
+	/*
+	 * false: clean the lines touched right after each write.
+	 * true: coalesce the dirty lines and clean them when the write reaches the end
+	 * of a dma period, or when ameba_audio_stream_buffer_sync_cache is called.
+	 */
+	bool cache_defer;
 } AudioBuffer;
 
 AudioBuffer *ameba_audio_stream_buffer_create(void);
@@ -44,6 +57,12 @@ size_t ameba_audio_stream_buffer_get_rx_writeptr(AudioBuffer *buffer);
 void   ameba_audio_stream_buffer_update_rx_writeptr(AudioBuffer *buffer, size_t bytes);
 void   ameba_audio_stream_buffer_update_tx_readptr(AudioBuffer *buffer, size_t bytes);
 void   ameba_audio_stream_buffer_flush(AudioBuffer *buffer);
+size_t ameba_audio_stream_buffer_acquire_write_region(AudioBuffer *buffer, void **region, size_t bytes);
+size_t ameba_audio_stream_buffer_commit_write(AudioBuffer *buffer, size_t bytes);
+size_t ameba_audio_stream_buffer_acquire_read_region(AudioBuffer *buffer, void **region, size_t bytes);
+size_t ameba_audio_stream_buffer_commit_read(AudioBuffer *buffer, size_t bytes);
+void   ameba_audio_stream_buffer_set_cache_defer(AudioBuffer *buffer, bool defer);
+void   ameba_audio_stream_buffer_sync_cache(AudioBuffer *buffer);
 
 #ifdef __cplusplus
 }
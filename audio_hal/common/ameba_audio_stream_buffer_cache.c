@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * noirq mode tx ring writes and their cache maintenance, the same on all socs. The ring
+ * itself(create, alloc, read, write) stays in the soc ameba_audio_stream_buffer.c, as the
+ * memory it comes from differs.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ameba_audio_stream_buffer.h"
+
+/*clean the lines of [offset, offset + bytes) of the ring, bytes must not cross the ring end*/
+static void ameba_audio_stream_buffer_clean_lines(AudioBuffer *buffer, size_t offset, size_t bytes)
+{
+	uint32_t start = ((uint32_t)(uintptr_t)buffer->raw_data + offset) & ~(CACHE_LINE_SIZE - 1);
+	uint32_t end = ((uint32_t)(uintptr_t)buffer->raw_data + offset + bytes + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+
+	//gdma only reads tx ring, so clean is enough, nothing in the lines needs to be invalidated.
+	DCache_Clean(start, end - start);
+}
+
+void ameba_audio_stream_buffer_sync_cache(AudioBuffer *buffer)
+{
+	size_t size_1;
+
+	if (buffer->dirty_bytes == 0) {
+		return;
+	}
+
+	size_1 = buffer->capacity - buffer->dirty_start;
+	if (buffer->dirty_bytes <= size_1) {
+		ameba_audio_stream_buffer_clean_lines(buffer, buffer->dirty_start, buffer->dirty_bytes);
+	} else {
+		ameba_audio_stream_buffer_clean_lines(buffer, buffer->dirty_start, size_1);
+		ameba_audio_stream_buffer_clean_lines(buffer, 0, buffer->dirty_bytes - size_1);
+	}
+
+	buffer->dirty_bytes = 0;
+}
+
+void ameba_audio_stream_buffer_set_cache_defer(AudioBuffer *buffer, bool defer)
+{
+	if (!defer) {
+		ameba_audio_stream_buffer_sync_cache(buffer);
+	}
+	buffer->cache_defer = defer;
+}
+
+/*write to buffer by hal*/
+size_t ameba_audio_stream_buffer_write_in_noirq_mode(AudioBuffer *buffer, const void *data, size_t bytes, uint32_t period_bytes)
+{
+	if (bytes == 0 || buffer->capacity == 0) {
+		return 0;
+	}
+
+	size_t capacity = buffer->capacity;
+	size_t bytes_to_write = bytes;
+
+	if (buffer->dirty_bytes == 0) {
+		buffer->dirty_start = buffer->write_ptr;
+	}
+	buffer->dirty_bytes += bytes_to_write;
+	if (buffer->dirty_bytes > capacity) {
+		buffer->dirty_start = 0;
+		buffer->dirty_bytes = capacity;
+	}
+
+	if (bytes_to_write <= capacity - buffer->write_ptr) {
+		memcpy(buffer->raw_data + buffer->write_ptr, (u8 *)data, bytes_to_write);
+		buffer->write_ptr += bytes_to_write;
+		if (buffer->write_ptr == capacity) {
+			buffer->write_ptr = 0;
+		}
+	} else {
+		size_t size_1 = capacity - buffer->write_ptr;
+		memcpy(buffer->raw_data + buffer->write_ptr, (u8 *)data, size_1);
+		size_t size_2 = bytes_to_write - size_1;
+		memcpy(buffer->raw_data, (u8 *)data + size_1, size_2);
+		buffer->write_ptr = size_2;
+	}
+
+	/*
+	 * in defer mode, keep the dirty lines until the write reaches the end of a period,
+	 * so the small writes inside one period cost only one clean.
+	 */
+	if (!buffer->cache_defer || period_bytes == 0 ||
+		buffer->dirty_start % period_bytes + buffer->dirty_bytes >= period_bytes) {
+		ameba_audio_stream_buffer_sync_cache(buffer);
+	}
+
+	buffer->size_remain += bytes_to_write;
+
+	return bytes_to_write;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+
+#include "audio_hw_debug.h"
+
+#include "ameba_audio_stream_stats.h"
+
+void ameba_audio_stream_stats_get(const StreamStats *stats, struct AudioHwStreamStats *out)
+{
+	StreamStats snap;
+
+	//the isr fields are updated by the dma irq, take them in one piece.
+	rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+	snap = *stats;
+	rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+	memset(out, 0, sizeof(*out));
+	out->bytes = snap.bytes;
+	out->xrun_count = snap.xrun_count;
+	for (uint32_t i = 0; i < AUDIO_HW_STATS_XRUN_HISTORY && i < snap.xrun_count; i++) {
+		uint32_t index = (snap.xrun_index + AUDIO_HW_STATS_XRUN_HISTORY - 1 - i) % AUDIO_HW_STATS_XRUN_HISTORY;
+		out->xrun_ns[i] = snap.xrun_ns[index];
+	}
+	out->fill_min = snap.fill_min;
+	out->fill_max = snap.fill_max;
+	out->fill_avg = snap.fill_samples ? (uint32_t)(snap.fill_sum / snap.fill_samples) : 0;
+	out->isr_count = snap.isr_count;
+	out->isr_max_us = snap.isr_max_us;
+	out->isr_total_us = snap.isr_total_us;
+	out->blocked_count = snap.blocked_count;
+	out->blocked_max_us = snap.blocked_max_us;
+	out->blocked_total_us = snap.blocked_total_us;
+}
+
+/* Format as "key=value;..." like the SetParameters strings. */
+int32_t ameba_audio_stream_stats_to_str(const struct AudioHwStreamStats *stats, char *str, size_t len)
+{
+	return snprintf(str, len,
+			 "bytes=%" PRIu64 ";xrun_count=%" PRIu32 ";xrun_ns=%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64
+			 ";fill_min=%" PRIu32 ";fill_max=%" PRIu32 ";fill_avg=%" PRIu32
+			 ";isr_count=%" PRIu32 ";isr_max_us=%" PRIu32 ";isr_total_us=%" PRIu64
+			 ";blocked_count=%" PRIu32 ";blocked_max_us=%" PRIu32 ";blocked_total_us=%" PRIu64,
+			 stats->bytes, stats->xrun_count, stats->xrun_ns[0], stats->xrun_ns[1], stats->xrun_ns[2], stats->xrun_ns[3],
+			 stats->fill_min, stats->fill_max, stats->fill_avg,
+			 stats->isr_count, stats->isr_max_us, stats->isr_total_us,
+			 stats->blocked_count, stats->blocked_max_us, stats->blocked_total_us);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_STREAM_STATS_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_AUDIO_STREAM_STATS_H
+
+#include "basic_types.h"
+#include "os_wrapper.h"
+
+#include "hardware/audio/audio_hw_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GetParameters key of the streams to get the stats string. */
+#define AMEBA_AUDIO_STREAM_STATS_KEY     "stats"
+#define AMEBA_AUDIO_STREAM_STATS_STR_LEN 384
+
+/*
+ * Counters of one driver stream, cheap enough to be always on: the irq only adds two
+ * time reads, Write/Read one buffer level read, and a block two time reads around the sema.
+ * The isr fields and the fill of a capture stream are written by the dma irq, others by
+ * the Write/Read task.
+ */
+typedef struct _StreamStats {
+	uint64_t bytes;
+	uint32_t xrun_count;
+	uint32_t xrun_index;
+	int64_t  xrun_ns[AUDIO_HW_STATS_XRUN_HISTORY];
+	uint32_t fill_min;
+	uint32_t fill_max;
+	uint64_t fill_sum;
+	uint32_t fill_samples;
+	uint32_t isr_count;
+	uint32_t isr_max_us;
+	uint64_t isr_total_us;
+	uint32_t blocked_count;
+	uint32_t blocked_max_us;
+	uint64_t blocked_total_us;
+} StreamStats;
+
+static inline uint64_t ameba_audio_stream_stats_isr_enter(void)
+{
+	return rtos_time_get_current_system_time_us();
+}
+
+static inline void ameba_audio_stream_stats_isr_exit(StreamStats *stats, uint64_t enter_us)
+{
+	uint32_t cost_us = (uint32_t)(rtos_time_get_current_system_time_us() - enter_us);
+
+	stats->isr_count++;
+	stats->isr_total_us += cost_us;
+	if (cost_us > stats->isr_max_us) {
+		stats->isr_max_us = cost_us;
+	}
+}
+
+static inline void ameba_audio_stream_stats_xrun(StreamStats *stats)
+{
+	stats->xrun_ns[stats->xrun_index] = (int64_t)rtos_time_get_current_system_time_us() * 1000LL;
+	stats->xrun_index = (stats->xrun_index + 1) % AUDIO_HW_STATS_XRUN_HISTORY;
+	stats->xrun_count++;
+}
+
+static inline void ameba_audio_stream_stats_fill(StreamStats *stats, uint32_t fill_bytes)
+{
+	if (stats->fill_samples == 0 || fill_bytes < stats->fill_min) {
+		stats->fill_min = fill_bytes;
+	}
+	if (fill_bytes > stats->fill_max) {
+		stats->fill_max = fill_bytes;
+	}
+	stats->fill_sum += fill_bytes;
+	stats->fill_samples++;
+}
+
+/* rtos_sema_take, with the time blocked added to the stats. */
+static inline int32_t ameba_audio_stream_stats_sema_take(StreamStats *stats, rtos_sema_t sema, uint32_t timeout)
+{
+	uint64_t start_us = rtos_time_get_current_system_time_us();
+	int32_t ret = rtos_sema_take(sema, timeout);
+	uint32_t blocked_us = (uint32_t)(rtos_time_get_current_system_time_us() - start_us);
+
+	stats->blocked_count++;
+	stats->blocked_total_us += blocked_us;
+	if (blocked_us > stats->blocked_max_us) {
+		stats->blocked_max_us = blocked_us;
+	}
+
+	return ret;
+}
+
+void ameba_audio_stream_stats_get(const StreamStats *stats, struct AudioHwStreamStats *out);
+int32_t ameba_audio_stream_stats_to_str(const struct AudioHwStreamStats *stats, char *str, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "os_wrapper.h"
+#include "osal_c/osal_atomic.h"
+
+#include "audio_hw_debug.h"
+#include "audio_hw_osal_errnos.h"
+
+#include "ameba_spsc_ring.h"
+
+static uint32_t RoundUpPowerOf2(uint32_t value)
+{
+    uint32_t result = 1;
+
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+ring_buffer_header *ameba_spsc_ring_create(uint32_t capacity)
+{
+    ring_buffer_header *header;
+    void *raw;
+
+    if (capacity == 0 || capacity > 0x80000000) {
+        HAL_AUDIO_ERROR("%s invalid capacity:%" PRIu32 "", __FUNCTION__, capacity);
+        return NULL;
+    }
+
+    //room to move the header to the next line, the allocation is kept in the word before it.
+    raw = rtos_mem_zmalloc(sizeof(ring_buffer_header) + MAX_CACHE_LINE_SIZE + sizeof(void *));
+    if (!raw) {
+        HAL_AUDIO_ERROR("%s alloc header fail", __FUNCTION__);
+        return NULL;
+    }
+    header = (ring_buffer_header *)(((uintptr_t)raw + sizeof(void *) + MAX_CACHE_LINE_SIZE - 1) &
+                                    ~(uintptr_t)(MAX_CACHE_LINE_SIZE - 1));
+    ((void **)header)[-1] = raw;
+
+    header->capacity = RoundUpPowerOf2(capacity);
+    header->mask = header->capacity - 1;
+    header->type = RINGBUFFER_LOCAL;
+    header->buffer = rtos_mem_zmalloc(header->capacity);
+    if (!header->buffer) {
+        HAL_AUDIO_ERROR("%s alloc %" PRIu32 " bytes fail", __FUNCTION__, header->capacity);
+        rtos_mem_free(raw);
+        return NULL;
+    }
+
+    return header;
+}
+
+void ameba_spsc_ring_destroy(ring_buffer_header *header)
+{
+    if (!header) {
+        return;
+    }
+
+    rtos_mem_free(header->buffer);
+    rtos_mem_free(((void **)header)[-1]);
+}
+
+void ameba_spsc_ring_reset(ring_buffer_header *header)
+{
+    osal_atomic_release_store(0, &header->head);
+    osal_atomic_release_store(0, &header->tail);
+}
+
+uint32_t ameba_spsc_ring_capacity(const ring_buffer_header *header)
+{
+    return header->capacity;
+}
+
+uint32_t ameba_spsc_ring_available(const ring_buffer_header *header)
+{
+    uint32_t tail = osal_atomic_acquire_load(&header->tail);
+    uint32_t head = osal_atomic_acquire_load(&header->head);
+
+    return head - tail;
+}
+
+uint32_t ameba_spsc_ring_space(const ring_buffer_header *header)
+{
+    return header->capacity - ameba_spsc_ring_available(header);
+}
+
+uint32_t ameba_spsc_ring_write(ring_buffer_header *header, const void *data, uint32_t bytes)
+{
+    //only the writer changes head, no need to sync with itself.
+    uint32_t head = header->head;
+    uint32_t tail = osal_atomic_acquire_load(&header->tail);
+    uint32_t space = header->capacity - (head - tail);
+    uint32_t offset = head & header->mask;
+    uint32_t first;
+
+    if (bytes > space) {
+        bytes = space;
+    }
+    if (bytes == 0) {
+        return 0;
+    }
+
+    first = header->capacity - offset;
+    if (first > bytes) {
+        first = bytes;
+    }
+    memcpy((uint8_t *)header->buffer + offset, data, first);
+    if (bytes > first) {
+        memcpy(header->buffer, (const uint8_t *)data + first, bytes - first);
+    }
+
+    osal_atomic_release_store(head + bytes, &header->head);
+
+    return bytes;
+}
+
+uint32_t ameba_spsc_ring_write_wait(ring_buffer_header *header, const void *data, uint32_t bytes,
+                                   rtos_sema_t sema, volatile uint32_t *waiting, uint32_t wait_ms)
+{
+    uint32_t total = 0;
+    int ret;
+
+    while (1) {
+        total += ameba_spsc_ring_write(header, (const uint8_t *)data + total, bytes - total);
+        if (total == bytes) {
+            break;
+        }
+
+        osal_atomic_release_store(1, waiting);
+        //pairs with the barrier in ameba_spsc_ring_wake_writer, recheck after waiting is visible,
+        //otherwise the reader's wake up may be lost.
+        osal_atomic_memory_barrier();
+        ret = RTK_SUCCESS;
+        if (ameba_spsc_ring_space(header) == 0) {
+            ret = rtos_sema_take(sema, wait_ms);
+        }
+        osal_atomic_release_store(0, waiting);
+        if (ret != RTK_SUCCESS) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+bool ameba_spsc_ring_wake_writer(rtos_sema_t sema, volatile uint32_t *waiting)
+{
+    //pairs with the barrier in ameba_spsc_ring_write_wait, so either the writer sees the new
+    //tail, or the reader sees waiting.
+    osal_atomic_memory_barrier();
+    if (osal_atomic_acquire_load(waiting)) {
+        rtos_sema_give(sema);
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t ameba_spsc_ring_peek(const ring_buffer_header *header, void **data)
+{
+    //only the reader changes tail, no need to sync with itself.
+    uint32_t tail = header->tail;
+    uint32_t head = osal_atomic_acquire_load(&header->head);
+    uint32_t offset = tail & header->mask;
+    uint32_t available = head - tail;
+    uint32_t contiguous = header->capacity - offset;
+
+    if (data) {
+        *data = (uint8_t *)header->buffer + offset;
+    }
+
+    return available < contiguous ? available : contiguous;
+}
+
+void ameba_spsc_ring_commit(ring_buffer_header *header, uint32_t bytes)
+{
+    uint32_t tail = header->tail;
+
+    osal_atomic_release_store(tail + bytes, &header->tail);
+}
+
+uint32_t ameba_spsc_ring_read(ring_buffer_header *header, void *data, uint32_t bytes)
+{
+    uint32_t total = 0;
+    void *region = NULL;
+    uint32_t size;
+
+    //two rounds at most, before and after the wrap point.
+    while (total < bytes) {
+        size = ameba_spsc_ring_peek(header, &region);
+        if (size == 0) {
+            break;
+        }
+        if (size > bytes - total) {
+            size = bytes - total;
+        }
+        memcpy((uint8_t *)data + total, region, size);
+        ameba_spsc_ring_commit(header, size);
+        total += size;
+    }
+
+    return total;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_SPSC_RING_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AMEBA_SPSC_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "os_wrapper.h"
+#include "cutils/ring_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Lock free ring between one writer thread(the a2dp or usb stream out) and one reader
+ * thread(the sbc encoder or the usb sender), laid out on ring_buffer_header:
+ * 1. head is the write index and only changed by the writer, tail is the read index
+ *    and only changed by the reader, they live in different cache lines.
+ * 2. head and tail run freely and wrap at 2^32, capacity must be power of 2, so
+ *    head - tail is always the readable bytes.
+ * 3. the writer publishes data with a release store of head, the reader gets it with an
+ *    acquire load of head, and the same for tail in the other direction.
+ */
+
+/*
+ * alloc the header on a cache line boundary and the data buffer, capacity is rounded up
+ * to power of 2. The header is CACHE_ALIGNED, keep it out of structs from rtos_mem_zmalloc,
+ * which only aligns to 8 bytes, or head and tail may share a line.
+ * return NULL if fail.
+ */
+ring_buffer_header *ameba_spsc_ring_create(uint32_t capacity);
+void ameba_spsc_ring_destroy(ring_buffer_header *header);
+
+/*
+ * only call it when both sides are stopped.
+ */
+void ameba_spsc_ring_reset(ring_buffer_header *header);
+
+uint32_t ameba_spsc_ring_capacity(const ring_buffer_header *header);
+
+/*
+ * readable bytes, it can be called by both sides.
+ */
+uint32_t ameba_spsc_ring_available(const ring_buffer_header *header);
+
+/*
+ * writable bytes, it can be called by both sides.
+ */
+uint32_t ameba_spsc_ring_space(const ring_buffer_header *header);
+
+/*
+ * writer side, copy as much as possible, return the bytes written.
+ */
+uint32_t ameba_spsc_ring_write(ring_buffer_header *header, const void *data, uint32_t bytes);
+
+/*
+ * writer side, copy all bytes, sleep on sema while the ring is full. waiting is the flag
+ * the reader checks in ameba_spsc_ring_wake_writer, sema is created by the caller with
+ * count 0. return the bytes written, less than bytes if no space came within wait_ms.
+ */
+uint32_t ameba_spsc_ring_write_wait(ring_buffer_header *header, const void *data, uint32_t bytes,
+                                   rtos_sema_t sema, volatile uint32_t *waiting, uint32_t wait_ms);
+
+/*
+ * reader side, call it after read or commit, give sema if the writer sleeps on a full ring.
+ * return true if it was given.
+ */
+bool ameba_spsc_ring_wake_writer(rtos_sema_t sema, volatile uint32_t *waiting);
+
+/*
+ * reader side, copy as much as possible, return the bytes read.
+ */
+uint32_t ameba_spsc_ring_read(ring_buffer_header *header, void *data, uint32_t bytes);
+
+/*
+ * reader side zero copy access: *data points to the readable region before the wrap
+ * point, return its size. The region stays valid until ameba_spsc_ring_commit, call peek
+ * again after commit to get the data after the wrap point.
+ */
+uint32_t ameba_spsc_ring_peek(const ring_buffer_header *header, void **data);
+
+/*
+ * reader side, release bytes got from ameba_spsc_ring_peek back to the writer.
+ */
+void ameba_spsc_ring_commit(ring_buffer_header *header, uint32_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
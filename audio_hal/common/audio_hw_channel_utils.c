@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "audio_hw_channel_utils.h"
+
+/*
+ * neon kernels for the ca32. The m-class cores and the linux host use the c kernels,
+ * audio_hal/sim runs both and compares them.
+ */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUDIO_HW_CHANNEL_NEON  1
+#endif
+
+#if defined(__GNUC__)
+#define CHANNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define CHANNEL_INLINE static inline
+#endif
+
+#define IS_ALIGNED_4(ptr) ((((uintptr_t)(ptr)) & 0x03) == 0)
+
+/*
+ * c kernels, always inlined so that the dispatchers below get a copy with
+ * constant channel counts which the compiler fully unrolls.
+ */
+CHANNEL_INLINE void remap_16(uint16_t *dst, uint32_t dst_channels, const uint16_t *src, uint32_t src_channels,
+							 uint32_t keep_channels, uint32_t frames)
+{
+	uint32_t i;
+	uint32_t c;
+
+	for (i = 0; i < frames; i++) {
+		for (c = 0; c < keep_channels; c++) {
+			dst[c] = src[c];
+		}
+		for (; c < dst_channels; c++) {
+			dst[c] = 0;
+		}
+		dst += dst_channels;
+		src += src_channels;
+	}
+}
+
+CHANNEL_INLINE void remap_32(uint32_t *dst, uint32_t dst_channels, const uint32_t *src, uint32_t src_channels,
+							 uint32_t keep_channels, uint32_t frames)
+{
+	uint32_t i;
+	uint32_t c;
+
+	for (i = 0; i < frames; i++) {
+		for (c = 0; c < keep_channels; c++) {
+			dst[c] = src[c];
+		}
+		for (; c < dst_channels; c++) {
+			dst[c] = 0;
+		}
+		dst += dst_channels;
+		src += src_channels;
+	}
+}
+
+static void remap_bytes(uint8_t *dst, uint32_t dst_bytes, const uint8_t *src, uint32_t src_bytes,
+						uint32_t keep_bytes, uint32_t frames)
+{
+	uint32_t i;
+
+	for (i = 0; i < frames; i++) {
+		memcpy(dst, src, keep_bytes);
+		memset(dst + keep_bytes, 0, dst_bytes - keep_bytes);
+		dst += dst_bytes;
+		src += src_bytes;
+	}
+}
+
+CHANNEL_INLINE void split_bytes(uint8_t *dst, uint32_t dst_bytes, uint8_t *extra_dst, uint32_t extra_bytes,
+								const uint8_t *src, uint32_t frames)
+{
+	uint32_t i;
+
+	for (i = 0; i < frames; i++) {
+		memcpy(dst, src, dst_bytes);
+		memcpy(extra_dst, src + dst_bytes, extra_bytes);
+		dst += dst_bytes;
+		extra_dst += extra_bytes;
+		src += dst_bytes + extra_bytes;
+	}
+}
+
+CHANNEL_INLINE void merge_bytes(uint8_t *dst, const uint8_t *src, uint32_t src_bytes, const uint8_t *extra_src,
+								uint32_t extra_bytes, uint32_t frames)
+{
+	uint32_t i;
+
+	for (i = 0; i < frames; i++) {
+		memcpy(dst, src, src_bytes);
+		memcpy(dst + src_bytes, extra_src, extra_bytes);
+		dst += src_bytes + extra_bytes;
+		src += src_bytes;
+		extra_src += extra_bytes;
+	}
+}
+
+#if AUDIO_HW_CHANNEL_NEON
+/*
+ * 4 channels in, keep_channels kept, dst_channels out. return the frames done,
+ * the caller finishes the tail with the c kernel.
+ */
+static uint32_t remap_16_from_4_neon(uint16_t *dst, uint32_t dst_channels, const uint16_t *src,
+									 uint32_t keep_channels, uint32_t frames)
+{
+	uint16x8_t zero = vdupq_n_u16(0);
+	uint32_t i = 0;
+
+	for (; i + 8 <= frames; i += 8) {
+		uint16x8x4_t v = vld4q_u16(src + i * 4);
+		if (keep_channels < 4) {
+			v.val[3] = zero;
+		}
+		if (keep_channels < 3) {
+			v.val[2] = zero;
+		}
+		if (keep_channels < 2) {
+			v.val[1] = zero;
+		}
+		if (keep_channels < 1) {
+			v.val[0] = zero;
+		}
+		if (dst_channels == 4) {
+			vst4q_u16(dst + i * 4, v);
+		} else {
+			uint16x8x3_t o;
+			o.val[0] = v.val[0];
+			o.val[1] = v.val[1];
+			o.val[2] = v.val[2];
+			vst3q_u16(dst + i * 3, o);
+		}
+	}
+
+	return i;
+}
+
+static uint32_t remap_32_from_4_neon(uint32_t *dst, uint32_t dst_channels, const uint32_t *src,
+									 uint32_t keep_channels, uint32_t frames)
+{
+	uint32x4_t zero = vdupq_n_u32(0);
+	uint32_t i = 0;
+
+	for (; i + 4 <= frames; i += 4) {
+		uint32x4x4_t v = vld4q_u32(src + i * 4);
+		if (keep_channels < 4) {
+			v.val[3] = zero;
+		}
+		if (keep_channels < 3) {
+			v.val[2] = zero;
+		}
+		if (keep_channels < 2) {
+			v.val[1] = zero;
+		}
+		if (keep_channels < 1) {
+			v.val[0] = zero;
+		}
+		if (dst_channels == 4) {
+			vst4q_u32(dst + i * 4, v);
+		} else {
+			uint32x4x3_t o;
+			o.val[0] = v.val[0];
+			o.val[1] = v.val[1];
+			o.val[2] = v.val[2];
+			vst3q_u32(dst + i * 3, o);
+		}
+	}
+
+	return i;
+}
+
+/*
+ * 16bit 4 + 4 channels: a frame is 4 words, words 0-1 go to dst, words 2-3 to extra_dst.
+ */
+static uint32_t split_16_4_4_neon(uint32_t *dst, uint32_t *extra_dst, const uint32_t *src, uint32_t frames)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= frames; i += 4) {
+		uint32x4x4_t v = vld4q_u32(src + i * 4);
+		uint32x4x2_t lo;
+		uint32x4x2_t hi;
+		lo.val[0] = v.val[0];
+		lo.val[1] = v.val[1];
+		hi.val[0] = v.val[2];
+		hi.val[1] = v.val[3];
+		vst2q_u32(dst + i * 2, lo);
+		vst2q_u32(extra_dst + i * 2, hi);
+	}
+
+	return i;
+}
+
+static uint32_t merge_16_4_4_neon(uint32_t *dst, const uint32_t *src, const uint32_t *extra_src, uint32_t frames)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= frames; i += 4) {
+		uint32x4x2_t lo = vld2q_u32(src + i * 2);
+		uint32x4x2_t hi = vld2q_u32(extra_src + i * 2);
+		uint32x4x4_t v;
+		v.val[0] = lo.val[0];
+		v.val[1] = lo.val[1];
+		v.val[2] = hi.val[0];
+		v.val[3] = hi.val[1];
+		vst4q_u32(dst + i * 4, v);
+	}
+
+	return i;
+}
+#endif
+
+#if AUDIO_HW_CHANNEL_NEON
+/*
+ * 16bit 4 + 2 channels: a frame is 3 words, words 0-1 go to dst, word 2 to extra_dst.
+ */
+static uint32_t split_16_4_2_neon(uint32_t *dst, uint32_t *extra_dst, const uint32_t *src, uint32_t frames)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= frames; i += 4) {
+		uint32x4x3_t v = vld3q_u32(src + i * 3);
+		uint32x4x2_t lo;
+		lo.val[0] = v.val[0];
+		lo.val[1] = v.val[1];
+		vst2q_u32(dst + i * 2, lo);
+		vst1q_u32(extra_dst + i, v.val[2]);
+	}
+
+	return i;
+}
+
+static uint32_t merge_16_4_2_neon(uint32_t *dst, const uint32_t *src, const uint32_t *extra_src, uint32_t frames)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= frames; i += 4) {
+		uint32x4x2_t lo = vld2q_u32(src + i * 2);
+		uint32x4x3_t v;
+		v.val[0] = lo.val[0];
+		v.val[1] = lo.val[1];
+		v.val[2] = vld1q_u32(extra_src + i);
+		vst3q_u32(dst + i * 3, v);
+	}
+
+	return i;
+}
+#endif
+
+static void remap_16_dispatch(uint16_t *dst, uint32_t dst_channels, const uint16_t *src, uint32_t src_channels,
+							  uint32_t keep_channels, uint32_t frames)
+{
+	if (src_channels == 4) {
+#if AUDIO_HW_CHANNEL_NEON
+		if (dst_channels == 3 || dst_channels == 4) {
+			uint32_t done = remap_16_from_4_neon(dst, dst_channels, src, keep_channels, frames);
+			dst += done * dst_channels;
+			src += done * src_channels;
+			frames -= done;
+		}
+#endif
+		if (dst_channels == 3 && keep_channels == 3) {
+			remap_16(dst, 3, src, 4, 3, frames);
+			return;
+		} else if (dst_channels == 3 && keep_channels == 2) {
+			remap_16(dst, 3, src, 4, 2, frames);
+			return;
+		} else if (dst_channels == 4 && keep_channels == 3) {
+			remap_16(dst, 4, src, 4, 3, frames);
+			return;
+		} else if (dst_channels == 5 && keep_channels == 4) {
+			remap_16(dst, 5, src, 4, 4, frames);
+			return;
+		}
+	}
+
+	remap_16(dst, dst_channels, src, src_channels, keep_channels, frames);
+}
+
+static void remap_32_dispatch(uint32_t *dst, uint32_t dst_channels, const uint32_t *src, uint32_t src_channels,
+							  uint32_t keep_channels, uint32_t frames)
+{
+	if (src_channels == 4) {
+#if AUDIO_HW_CHANNEL_NEON
+		if (dst_channels == 3 || dst_channels == 4) {
+			uint32_t done = remap_32_from_4_neon(dst, dst_channels, src, keep_channels, frames);
+			dst += done * dst_channels;
+			src += done * src_channels;
+			frames -= done;
+		}
+#endif
+		if (dst_channels == 3 && keep_channels == 3) {
+			remap_32(dst, 3, src, 4, 3, frames);
+			return;
+		} else if (dst_channels == 3 && keep_channels == 2) {
+			remap_32(dst, 3, src, 4, 2, frames);
+			return;
+		} else if (dst_channels == 4 && keep_channels == 3) {
+			remap_32(dst, 4, src, 4, 3, frames);
+			return;
+		} else if (dst_channels == 5 && keep_channels == 4) {
+			remap_32(dst, 5, src, 4, 4, frames);
+			return;
+		}
+	}
+
+	remap_32(dst, dst_channels, src, src_channels, keep_channels, frames);
+}
+
+void audio_hw_channel_remap(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+							uint32_t keep_channels, uint32_t frames, uint32_t sample_bytes)
+{
+	if (!dst || !src || frames == 0 || keep_channels > src_channels || keep_channels > dst_channels) {
+		return;
+	}
+
+	if (sample_bytes == 2 && ((((uintptr_t)dst) | ((uintptr_t)src)) & 0x01) == 0) {
+		remap_16_dispatch((uint16_t *)dst, dst_channels, (const uint16_t *)src, src_channels, keep_channels, frames);
+	} else if (sample_bytes == 4 && IS_ALIGNED_4(dst) && IS_ALIGNED_4(src)) {
+		remap_32_dispatch((uint32_t *)dst, dst_channels, (const uint32_t *)src, src_channels, keep_channels, frames);
+	} else {
+		remap_bytes((uint8_t *)dst, dst_channels * sample_bytes, (const uint8_t *)src, src_channels * sample_bytes,
+					keep_channels * sample_bytes, frames);
+	}
+}
+
+void audio_hw_channel_drop(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+						   uint32_t frames, uint32_t sample_bytes)
+{
+	audio_hw_channel_remap(dst, dst_channels, src, src_channels, dst_channels, frames, sample_bytes);
+}
+
+void audio_hw_channel_insert_zero(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+								  uint32_t keep_channels, uint32_t frames, uint32_t sample_bytes)
+{
+	audio_hw_channel_remap(dst, dst_channels, src, src_channels, keep_channels, frames, sample_bytes);
+}
+
+void audio_hw_channel_deinterleave(void *dst, uint32_t dst_channels, void *extra_dst, uint32_t extra_channels,
+								   const void *src, uint32_t frames, uint32_t sample_bytes)
+{
+	uint32_t dst_bytes = dst_channels * sample_bytes;
+	uint32_t extra_bytes = extra_channels * sample_bytes;
+	uint32_t done = 0;
+
+	if (!dst || !extra_dst || !src || frames == 0) {
+		return;
+	}
+
+	if (IS_ALIGNED_4(dst) && IS_ALIGNED_4(extra_dst) && IS_ALIGNED_4(src)) {
+		if (dst_bytes == 8 && extra_bytes == 4) {
+#if AUDIO_HW_CHANNEL_NEON
+			done = split_16_4_2_neon((uint32_t *)dst, (uint32_t *)extra_dst, (const uint32_t *)src, frames);
+#endif
+			split_bytes((uint8_t *)dst + done * 8, 8, (uint8_t *)extra_dst + done * 4, 4, (const uint8_t *)src + done * 12, frames - done);
+			return;
+		} else if (dst_bytes == 8 && extra_bytes == 8) {
+#if AUDIO_HW_CHANNEL_NEON
+			done = split_16_4_4_neon((uint32_t *)dst, (uint32_t *)extra_dst, (const uint32_t *)src, frames);
+#endif
+			split_bytes((uint8_t *)dst + done * 8, 8, (uint8_t *)extra_dst + done * 8, 8, (const uint8_t *)src + done * 16, frames - done);
+			return;
+		} else if (dst_bytes == 16 && extra_bytes == 8) {
+			split_bytes((uint8_t *)dst, 16, (uint8_t *)extra_dst, 8, (const uint8_t *)src, frames);
+			return;
+		} else if (dst_bytes == 16 && extra_bytes == 16) {
+			split_bytes((uint8_t *)dst, 16, (uint8_t *)extra_dst, 16, (const uint8_t *)src, frames);
+			return;
+		}
+	}
+
+	split_bytes((uint8_t *)dst, dst_bytes, (uint8_t *)extra_dst, extra_bytes, (const uint8_t *)src, frames);
+}
+
+void audio_hw_channel_interleave(void *dst, const void *src, uint32_t src_channels, const void *extra_src,
+								 uint32_t extra_channels, uint32_t frames, uint32_t sample_bytes)
+{
+	uint32_t src_bytes = src_channels * sample_bytes;
+	uint32_t extra_bytes = extra_channels * sample_bytes;
+	uint32_t done = 0;
+
+	if (!dst || !src || !extra_src || frames == 0) {
+		return;
+	}
+
+	if (IS_ALIGNED_4(dst) && IS_ALIGNED_4(src) && IS_ALIGNED_4(extra_src)) {
+		if (src_bytes == 8 && extra_bytes == 4) {
+#if AUDIO_HW_CHANNEL_NEON
+			done = merge_16_4_2_neon((uint32_t *)dst, (const uint32_t *)src, (const uint32_t *)extra_src, frames);
+#endif
+			merge_bytes((uint8_t *)dst + done * 12, (const uint8_t *)src + done * 8, 8, (const uint8_t *)extra_src + done * 4, 4, frames - done);
+			return;
+		} else if (src_bytes == 8 && extra_bytes == 8) {
+#if AUDIO_HW_CHANNEL_NEON
+			done = merge_16_4_4_neon((uint32_t *)dst, (const uint32_t *)src, (const uint32_t *)extra_src, frames);
+#endif
+			merge_bytes((uint8_t *)dst + done * 16, (const uint8_t *)src + done * 8, 8, (const uint8_t *)extra_src + done * 8, 8, frames - done);
+			return;
+		} else if (src_bytes == 16 && extra_bytes == 8) {
+			merge_bytes((uint8_t *)dst, (const uint8_t *)src, 16, (const uint8_t *)extra_src, 8, frames);
+			return;
+		} else if (src_bytes == 16 && extra_bytes == 16) {
+			merge_bytes((uint8_t *)dst, (const uint8_t *)src, 16, (const uint8_t *)extra_src, 16, frames);
+			return;
+		}
+	}
+
+	merge_bytes((uint8_t *)dst, (const uint8_t *)src, src_bytes, (const uint8_t *)extra_src, extra_bytes, frames);
+}
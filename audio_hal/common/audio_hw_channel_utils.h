@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AMEBA_AUDIO_AUDIO_HAL_COMMON_AUDIO_HW_CHANNEL_UTILS_H
+#define AMEBA_AUDIO_AUDIO_HAL_COMMON_AUDIO_HW_CHANNEL_UTILS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Channel reorder kernels shared by the stream in/out and render/capture paths.
+ * All kernels work on interleaved frames of sample_bytes wide samples, sample_bytes
+ * can be 1, 2, 3 or 4. 16bit and 32bit samples with the channel layouts used by the
+ * hal (4 -> 3/4/5, 4 + 2, 4 + 4) have dedicated kernels, using neon on ca32 when
+ * the compiler enables it, other layouts and cores use the portable c version.
+ * src and dst must not overlap.
+ */
+
+/*
+ * copy the first keep_channels of each src_channels frame into dst_channels frames,
+ * the left dst_channels - keep_channels channels of each dst frame are set to 0.
+ * keep_channels should not be larger than src_channels or dst_channels.
+ */
+void audio_hw_channel_remap(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+							uint32_t keep_channels, uint32_t frames, uint32_t sample_bytes);
+
+/*
+ * drop the last src_channels - dst_channels channels of each frame, for example
+ * 4 channels captured but 3 channels requested.
+ */
+void audio_hw_channel_drop(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+						   uint32_t frames, uint32_t sample_bytes);
+
+/*
+ * keep the first keep_channels channels of each frame and append zero channels up to
+ * dst_channels, for example the reference channel placeholder of add out capture.
+ */
+void audio_hw_channel_insert_zero(void *dst, uint32_t dst_channels, const void *src, uint32_t src_channels,
+								  uint32_t keep_channels, uint32_t frames, uint32_t sample_bytes);
+
+/*
+ * split each frame of dst_channels + extra_channels channels: the first dst_channels
+ * go to dst, the others go to extra_dst, used for the fifo0/fifo1 split of 6/8 channels.
+ */
+void audio_hw_channel_deinterleave(void *dst, uint32_t dst_channels, void *extra_dst, uint32_t extra_channels,
+								   const void *src, uint32_t frames, uint32_t sample_bytes);
+
+/*
+ * merge frames of src_channels from src and extra_channels from extra_src into
+ * frames of src_channels + extra_channels, the reverse of audio_hw_channel_deinterleave.
+ */
+void audio_hw_channel_interleave(void *dst, const void *src, uint32_t src_channels, const void *extra_src,
+								 uint32_t extra_channels, uint32_t frames, uint32_t sample_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
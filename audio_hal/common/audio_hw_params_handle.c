@@ -221,3 +221,156 @@ int32_t string_cells_get_int(struct string_cell *cell_head, const char *key, int
 
 	return -EINVAL;
 }
+
+struct audio_hw_param_key {
+	const char *name;
+	uint8_t len;
+	int8_t id;
+};
+
+/*
+ * Perfect hash of the known keys: (2 * len + key[1] + key[len - 1]) & 15 is unique for
+ * each of them, so one strncmp confirms the key. Keep it collision free when adding keys.
+ */
+#define AUDIO_HW_PARAM_HASH_SIZE      16
+#define AUDIO_HW_PARAM_HASH(key, len) ((2 * (len) + (uint8_t)(key)[1] + (uint8_t)(key)[(len) - 1]) & (AUDIO_HW_PARAM_HASH_SIZE - 1))
+
+static const struct audio_hw_param_key audio_hw_param_keys[AUDIO_HW_PARAM_HASH_SIZE] = {
+	[3]  = {"drift_target_ms", 15, AUDIO_HW_PARAM_DRIFT_TARGET_MS},
+	[6]  = {"cap_mode",        8,  AUDIO_HW_PARAM_CAP_MODE},
+	[7]  = {"ref_channel",     11, AUDIO_HW_PARAM_REF_CHANNEL},
+	[9]  = {"amp_pin",         7,  AUDIO_HW_PARAM_AMP_PIN},
+	[10] = {"mic_category",    12, AUDIO_HW_PARAM_MIC_CATEGORY},
+	[11] = {"data_format",     11, AUDIO_HW_PARAM_DATA_FORMAT},
+	[14] = {"master_slave",    12, AUDIO_HW_PARAM_MASTER_SLAVE},
+	[15] = {"delay_start",     11, AUDIO_HW_PARAM_DELAY_START},
+};
+
+static const char *const audio_hw_capture_modes[] = {
+	[AUDIO_HW_CAPTURE_NO_AFE_PURE_DATA] = "no_afe_pure_data",
+	[AUDIO_HW_CAPTURE_NO_AFE_ALL_DATA] = "no_afe_all_data",
+	[AUDIO_HW_CAPTURE_AEC] = "aec",
+};
+
+int32_t audio_hw_params_key_id(const char *key, size_t len)
+{
+	const struct audio_hw_param_key *entry;
+
+	if (key == NULL || len < 2) {
+		return -ENOENT;
+	}
+
+	entry = &audio_hw_param_keys[AUDIO_HW_PARAM_HASH(key, len)];
+	if (entry->name == NULL || entry->len != len || strncmp(entry->name, key, len)) {
+		return -ENOENT;
+	}
+
+	return entry->id;
+}
+
+/* Same rules as strtol with base 0, but on a value that is not '\0' terminated. */
+static int32_t audio_hw_params_parse_int(const char *str, size_t len, int32_t *val)
+{
+	const char *end = str + len;
+	uint32_t base = 10;
+	uint32_t result = 0;
+	bool negative = false;
+
+	if (str < end && (*str == '-' || *str == '+')) {
+		negative = (*str == '-');
+		str++;
+	}
+
+	if (end - str > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		base = 16;
+		str += 2;
+	} else if (end - str > 1 && str[0] == '0') {
+		base = 8;
+		str++;
+	}
+
+	if (str == end) {
+		return -EINVAL;
+	}
+
+	for (; str < end; str++) {
+		uint32_t digit;
+		if (*str >= '0' && *str <= '9') {
+			digit = *str - '0';
+		} else if (*str >= 'a' && *str <= 'f') {
+			digit = *str - 'a' + 10;
+		} else if (*str >= 'A' && *str <= 'F') {
+			digit = *str - 'A' + 10;
+		} else {
+			return -EINVAL;
+		}
+		if (digit >= base) {
+			return -EINVAL;
+		}
+		result = result * base + digit;
+	}
+
+	*val = negative ? -(int32_t)result : (int32_t)result;
+	return 0;
+}
+
+static int32_t audio_hw_params_parse_value(int32_t id, const char *str, size_t len, int32_t *val)
+{
+	if (id == AUDIO_HW_PARAM_CAP_MODE) {
+		for (size_t i = 0; i < sizeof(audio_hw_capture_modes) / sizeof(audio_hw_capture_modes[0]); i++) {
+			if (strlen(audio_hw_capture_modes[i]) == len && !strncmp(audio_hw_capture_modes[i], str, len)) {
+				*val = (int32_t)i;
+				return 0;
+			}
+		}
+	}
+
+	return audio_hw_params_parse_int(str, len, val);
+}
+
+/*
+ * Parse "key1=value1;key2=value2" in one pass, without copying str_pairs. Unknown keys and
+ * invalid values are skipped, the first valid value wins for a key given more than once.
+ * Returns the number of known keys found.
+ */
+int32_t audio_hw_params_parse(const char *str_pairs, struct audio_hw_params *params)
+{
+	const char *cell = str_pairs;
+	int32_t found = 0;
+
+	params->mask = 0;
+	if (str_pairs == NULL) {
+		return -EINVAL;
+	}
+
+	while (*cell) {
+		const char *cell_end = strchr(cell, ';');
+		const char *equal;
+		int32_t id;
+		int32_t value;
+
+		if (cell_end == NULL) {
+			cell_end = cell + strlen(cell);
+		}
+
+		equal = memchr(cell, '=', cell_end - cell);
+		if (equal == NULL || equal == cell) {
+			HAL_AUDIO_VERBOSE("skip cell without key=value");
+		} else {
+			id = audio_hw_params_key_id(cell, equal - cell);
+			if (id < 0) {
+				HAL_AUDIO_VERBOSE("skip unknown key:%.*s", (int)(equal - cell), cell);
+			} else if (audio_hw_params_parse_value(id, equal + 1, cell_end - equal - 1, &value) != 0) {
+				HAL_AUDIO_ERROR("invalid value of key:%.*s", (int)(equal - cell), cell);
+			} else if (!audio_hw_params_has(params, id)) {
+				params->values[id] = value;
+				params->mask |= 1u << id;
+				found++;
+			}
+		}
+
+		cell = *cell_end ? cell_end + 1 : cell_end;
+	}
+
+	return found;
+}
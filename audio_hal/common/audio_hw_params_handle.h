@@ -18,6 +18,8 @@
 #include "platform_stdlib.h"
 #include "basic_types.h"
 
+#include "hardware/audio/audio_hw_types.h"
+
 struct string_cell {
 	char *key;
 	char *value;
@@ -31,4 +33,21 @@ int32_t string_cells_has_key(struct string_cell *cell_head, const char *key);
 int32_t string_cells_get_str(struct string_cell *cell_head, const char *key, char *out_val, int32_t len);
 int32_t string_cells_get_int(struct string_cell *cell_head, const char *key, int32_t *out_val);
 
+/*
+ * Known keys parsed in place, without heap, for the SetParameters of the streams.
+ * Bit n of mask is set when the key of id n is found with a valid value.
+ */
+struct audio_hw_params {
+	uint32_t mask;
+	int32_t values[AUDIO_HW_PARAM_MAX];
+};
+
+int32_t audio_hw_params_key_id(const char *key, size_t len);
+int32_t audio_hw_params_parse(const char *str_pairs, struct audio_hw_params *params);
+
+static inline bool audio_hw_params_has(const struct audio_hw_params *params, enum AudioHwParamKey key)
+{
+	return (params->mask & (1u << key)) != 0;
+}
+
 #endif
\ No newline at end of file
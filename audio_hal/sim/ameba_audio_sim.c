@@ -0,0 +1,1006 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ameba.h"
+#include "os_wrapper.h"
+
+#include "ameba_audio_sim.h"
+
+#define SIM_DIR_TX               0
+#define SIM_DIR_RX               1
+#define SIM_DIR_NUM              2
+
+/* frames the sport fifo covers while no gdma block is active. */
+#define SIM_FIFO_FRAMES          32
+/* channels one gdma moves, a tdm stream puts the rest on the external gdma. */
+#define SIM_INT_GDMA_MAX_CH      4
+
+typedef struct {
+	u32 rate;
+	u32 word_bytes;
+	u32 channels;
+	bool inited;
+	bool started;
+	bool counter_en;
+	u32 counter;
+	u32 comp_val;
+	u32 phase_counter;
+	double frame_frac;
+	/* fifo frames shifted out(tx) or in(rx) while no gdma block was there, per gdma. */
+	u32 fifo_debt[2];
+} SimSportDir;
+
+typedef struct {
+	SimSportDir dir[SIM_DIR_NUM];
+	bool dma_en;
+} SimSport;
+
+typedef struct {
+	bool used;
+	bool active;
+	u32 sport;
+	u32 dir;
+	u32 gdma_id;
+	u32 addr;
+	u32 len;
+	u32 pos;
+	struct GDMA_CH_LLI *lli;
+	IRQ_FUN callback;
+	void *callback_data;
+	bool int_en;
+	bool pending;
+	u64 raised_ns;
+	u64 due_ns;
+} SimGdmaCh;
+
+typedef struct {
+	IRQ_FUN fun;
+	void *data;
+	bool registered;
+	bool enabled;
+	bool pending;
+} SimIrq;
+
+typedef struct {
+	pthread_mutex_t irq_lock;
+	pthread_t thread;
+	bool running;
+	AudioSimConfig config;
+	unsigned int rand_state;
+	u64 last_ns;
+	SimSport sport[SIM_SPORT_NUM];
+	SimGdmaCh ch[SIM_GDMA_CH_NUM];
+	SimIrq irq[SIM_IRQ_NUM];
+	AudioSimTxSink tx_sink;
+	void *tx_sink_user;
+	AudioSimRxSource rx_source;
+	void *rx_source_user;
+	AudioSimStats stats;
+	/* i2s pll trim from the *_ClkTune calls, on top of clock_ppm. */
+	double pll_ppm;
+} AudioSim;
+
+GDMA_TypeDef sim_gdma_regs;
+AUDIO_SPORT_TypeDef sim_sport_regs[SIM_SPORT_NUM];
+const AUDIO_DevTable AUDIO_DEV_TABLE[SIM_SPORT_NUM] = {
+	{&sim_sport_regs[0], 0, 0},
+	{&sim_sport_regs[1], 0, 0},
+};
+
+static AudioSim s_sim = {
+	.irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP,
+};
+
+void ameba_audio_sim_irq_lock(void)
+{
+	pthread_mutex_lock(&s_sim.irq_lock);
+}
+
+void ameba_audio_sim_irq_unlock(void)
+{
+	pthread_mutex_unlock(&s_sim.irq_lock);
+}
+
+static u64 sim_now_ns(void)
+{
+	return rtos_time_get_current_system_time_ns();
+}
+
+static SimGdmaCh *sim_get_ch(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	if (GDMA_Index != 0 || GDMA_ChNum >= SIM_GDMA_CH_NUM) {
+		return NULL;
+	}
+
+	return &s_sim.ch[GDMA_ChNum];
+}
+
+static SimSportDir *sim_get_sport_dir(u32 index, u32 dir)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return NULL;
+	}
+
+	return &s_sim.sport[index].dir[dir];
+}
+
+/*
+ * bytes of one frame on the gdma, the internal gdma carries up to four
+ * channels and the external one the rest.
+ */
+static u32 sim_ch_frame_bytes(SimGdmaCh *ch)
+{
+	SimSportDir *sdir = &s_sim.sport[ch->sport].dir[ch->dir];
+	u32 channels = sdir->channels;
+
+	if (channels > SIM_INT_GDMA_MAX_CH) {
+		channels = (ch->gdma_id == 0) ? SIM_INT_GDMA_MAX_CH : channels - SIM_INT_GDMA_MAX_CH;
+	}
+
+	return channels * sdir->word_bytes;
+}
+
+static SimGdmaCh *sim_find_active_ch(u32 index, u32 dir, u32 gdma_id)
+{
+	int i;
+
+	for (i = 0; i < SIM_GDMA_CH_NUM; i++) {
+		SimGdmaCh *ch = &s_sim.ch[i];
+		if (ch->used && ch->sport == index && ch->dir == dir && ch->gdma_id == gdma_id) {
+			return ch;
+		}
+	}
+
+	return NULL;
+}
+
+static void sim_block_done(SimGdmaCh *ch, u64 now)
+{
+	if (ch->dir == SIM_DIR_TX) {
+		s_sim.stats.tx_dma_blocks++;
+	} else {
+		s_sim.stats.rx_dma_blocks++;
+	}
+
+	if (ch->lli) {
+		ch->lli = ch->lli->pNextLli;
+		ch->addr = (ch->dir == SIM_DIR_TX) ? ch->lli->LliEle.Sarx : ch->lli->LliEle.Darx;
+		ch->pos = 0;
+		return;
+	}
+
+	ch->active = false;
+	if (!ch->callback) {
+		return;
+	}
+
+	ch->pending = true;
+	ch->raised_ns = now;
+	ch->due_ns = now;
+	if (s_sim.config.irq_jitter_us) {
+		ch->due_ns += (u64)(rand_r(&s_sim.rand_state) % (s_sim.config.irq_jitter_us + 1)) * 1000ULL;
+	}
+}
+
+/* move frames between one gdma and the sport, returns the frames it could not cover. */
+static u32 sim_move_frames(SimGdmaCh *ch, u32 frames, u64 now)
+{
+	u32 frame_bytes;
+
+	if (!ch) {
+		return frames;
+	}
+
+	frame_bytes = sim_ch_frame_bytes(ch);
+	if (!frame_bytes) {
+		return frames;
+	}
+
+	while (frames && ch->active) {
+		u32 chunk_frames = (ch->len - ch->pos) / frame_bytes;
+		u32 bytes;
+		u8 *p;
+
+		if (chunk_frames > frames) {
+			chunk_frames = frames;
+		}
+		bytes = chunk_frames * frame_bytes;
+		p = (u8 *)(uintptr_t)(ch->addr + ch->pos);
+
+		if (ch->dir == SIM_DIR_TX) {
+			if (s_sim.tx_sink) {
+				s_sim.tx_sink(s_sim.tx_sink_user, ch->sport, ch->gdma_id, p, bytes);
+			}
+		} else {
+			if (s_sim.rx_source) {
+				s_sim.rx_source(s_sim.rx_source_user, ch->sport, ch->gdma_id, p, bytes);
+			} else {
+				memset(p, 0, bytes);
+			}
+		}
+
+		ch->pos += bytes;
+		frames -= chunk_frames;
+		if (ch->len - ch->pos < frame_bytes) {
+			sim_block_done(ch, now);
+		}
+	}
+
+	return frames;
+}
+
+static void sim_raise_sport_irq(u32 index)
+{
+	s_sim.irq[index].pending = true;
+}
+
+static void sim_run_sport_dir(u32 index, u32 dir, u64 elapsed_ns, u64 now)
+{
+	SimSport *sport = &s_sim.sport[index];
+	SimSportDir *sdir = &sport->dir[dir];
+	double frames_f;
+	u32 frames;
+	u32 gdma_num;
+	u32 id;
+
+	if (!sdir->inited || !sdir->started) {
+		return;
+	}
+
+	frames_f = (double)elapsed_ns * sdir->rate * (1.0 + (s_sim.config.clock_ppm + s_sim.pll_ppm) * 1e-6) / 1e9 + sdir->frame_frac;
+	frames = (u32)frames_f;
+	sdir->frame_frac = frames_f - frames;
+	if (!frames) {
+		return;
+	}
+
+	if (dir == SIM_DIR_TX) {
+		s_sim.stats.tx_frames += frames;
+	} else {
+		s_sim.stats.rx_frames += frames;
+	}
+
+	if (sdir->counter_en) {
+		sdir->counter += frames;
+		while (sdir->comp_val && sdir->counter >= sdir->comp_val) {
+			sdir->counter -= sdir->comp_val;
+			sim_raise_sport_irq(index);
+		}
+	}
+
+	gdma_num = (sdir->channels > SIM_INT_GDMA_MAX_CH) ? 2 : 1;
+	for (id = 0; id < gdma_num; id++) {
+		u32 need = frames + sdir->fifo_debt[id];
+		u32 left = need;
+
+		if (sport->dma_en) {
+			left = sim_move_frames(sim_find_active_ch(index, dir, id), need, now);
+		}
+
+		if (left > SIM_FIFO_FRAMES) {
+			if (dir == SIM_DIR_TX) {
+				s_sim.stats.tx_underflow_frames += left - SIM_FIFO_FRAMES;
+			} else {
+				s_sim.stats.rx_overflow_frames += left - SIM_FIFO_FRAMES;
+			}
+			left = SIM_FIFO_FRAMES;
+		}
+		sdir->fifo_debt[id] = left;
+	}
+}
+
+static void sim_deliver_irqs(u64 now)
+{
+	int i;
+
+	for (i = 0; i < SIM_GDMA_CH_NUM; i++) {
+		SimGdmaCh *ch = &s_sim.ch[i];
+		u64 latency;
+
+		if (!ch->used || !ch->pending || !ch->int_en || now < ch->due_ns) {
+			continue;
+		}
+
+		ch->pending = false;
+		latency = now - ch->raised_ns;
+		s_sim.stats.gdma_irqs++;
+		s_sim.stats.irq_latency_total_ns += latency;
+		if (latency > s_sim.stats.irq_latency_max_ns) {
+			s_sim.stats.irq_latency_max_ns = latency;
+		}
+		ch->callback(ch->callback_data);
+	}
+
+	for (i = 0; i < SIM_IRQ_NUM; i++) {
+		SimIrq *irq = &s_sim.irq[i];
+
+		if (!irq->pending || !irq->registered || !irq->enabled) {
+			continue;
+		}
+
+		irq->pending = false;
+		s_sim.stats.sport_irqs++;
+		irq->fun(irq->data);
+	}
+}
+
+static void sim_tick(u64 now)
+{
+	u64 elapsed_ns = now - s_sim.last_ns;
+	u32 index;
+
+	s_sim.last_ns = now;
+	for (index = 0; index < SIM_SPORT_NUM; index++) {
+		sim_run_sport_dir(index, SIM_DIR_TX, elapsed_ns, now);
+		sim_run_sport_dir(index, SIM_DIR_RX, elapsed_ns, now);
+	}
+
+	sim_deliver_irqs(now);
+}
+
+static void *sim_timer_thread(void *param)
+{
+	struct timespec next;
+
+	(void)param;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	while (__atomic_load_n(&s_sim.running, __ATOMIC_ACQUIRE)) {
+		next.tv_nsec += (long)s_sim.config.tick_us * 1000L;
+		while (next.tv_nsec >= 1000000000L) {
+			next.tv_sec++;
+			next.tv_nsec -= 1000000000L;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+		ameba_audio_sim_irq_lock();
+		sim_tick(sim_now_ns());
+		ameba_audio_sim_irq_unlock();
+	}
+
+	return NULL;
+}
+
+void ameba_audio_sim_get_default_config(AudioSimConfig *config)
+{
+	config->tick_us = 250;
+	config->irq_jitter_us = 0;
+	config->clock_ppm = 0;
+	config->seed = 1;
+}
+
+int ameba_audio_sim_start(const AudioSimConfig *config)
+{
+	if (s_sim.running) {
+		return FAIL;
+	}
+
+	ameba_audio_sim_get_default_config(&s_sim.config);
+	if (config) {
+		s_sim.config = *config;
+	}
+	if (!s_sim.config.tick_us) {
+		s_sim.config.tick_us = 1;
+	}
+	s_sim.rand_state = s_sim.config.seed;
+	s_sim.last_ns = sim_now_ns();
+
+	__atomic_store_n(&s_sim.running, true, __ATOMIC_RELEASE);
+	if (pthread_create(&s_sim.thread, NULL, sim_timer_thread, NULL) != 0) {
+		s_sim.running = false;
+		return FAIL;
+	}
+
+	return SUCCESS;
+}
+
+void ameba_audio_sim_stop(void)
+{
+	if (!s_sim.running) {
+		return;
+	}
+
+	__atomic_store_n(&s_sim.running, false, __ATOMIC_RELEASE);
+	pthread_join(s_sim.thread, NULL);
+}
+
+void ameba_audio_sim_set_tx_sink(AudioSimTxSink sink, void *user)
+{
+	ameba_audio_sim_irq_lock();
+	s_sim.tx_sink = sink;
+	s_sim.tx_sink_user = user;
+	ameba_audio_sim_irq_unlock();
+}
+
+void ameba_audio_sim_set_rx_source(AudioSimRxSource source, void *user)
+{
+	ameba_audio_sim_irq_lock();
+	s_sim.rx_source = source;
+	s_sim.rx_source_user = user;
+	ameba_audio_sim_irq_unlock();
+}
+
+void ameba_audio_sim_get_stats(AudioSimStats *stats)
+{
+	ameba_audio_sim_irq_lock();
+	*stats = s_sim.stats;
+	stats->cache_ops = __atomic_load_n(&s_sim.stats.cache_ops, __ATOMIC_RELAXED);
+	stats->cache_bytes = __atomic_load_n(&s_sim.stats.cache_bytes, __ATOMIC_RELAXED);
+	ameba_audio_sim_irq_unlock();
+}
+
+void ameba_audio_sim_reset_stats(void)
+{
+	ameba_audio_sim_irq_lock();
+	memset(&s_sim.stats, 0, sizeof(s_sim.stats));
+	ameba_audio_sim_irq_unlock();
+}
+
+void ameba_audio_sim_set_pll_ppm(float ppm)
+{
+	ameba_audio_sim_irq_lock();
+	s_sim.pll_ppm = ppm;
+	ameba_audio_sim_irq_unlock();
+}
+
+/* cache maintenance has nothing to do on the host, it is only counted. */
+static void sim_count_cache_op(u32 Bytes)
+{
+	__atomic_fetch_add(&s_sim.stats.cache_ops, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&s_sim.stats.cache_bytes, Bytes, __ATOMIC_RELAXED);
+}
+
+void DCache_Clean(u32 Address, u32 Bytes)
+{
+	(void)Address;
+	sim_count_cache_op(Bytes);
+}
+
+void DCache_Invalidate(u32 Address, u32 Bytes)
+{
+	(void)Address;
+	sim_count_cache_op(Bytes);
+}
+
+void DCache_CleanInvalidate(u32 Address, u32 Bytes)
+{
+	(void)Address;
+	sim_count_cache_op(Bytes);
+}
+
+bool InterruptRegister(IRQ_FUN IrqFun, int32_t IrqNum, u32 Data, u32 Priority)
+{
+	(void)Priority;
+
+	if (IrqNum < 0 || IrqNum >= SIM_IRQ_NUM) {
+		return FALSE;
+	}
+
+	ameba_audio_sim_irq_lock();
+	s_sim.irq[IrqNum].fun = IrqFun;
+	s_sim.irq[IrqNum].data = (void *)(uintptr_t)Data;
+	s_sim.irq[IrqNum].registered = true;
+	ameba_audio_sim_irq_unlock();
+
+	return TRUE;
+}
+
+bool InterruptUnRegister(int32_t IrqNum)
+{
+	if (IrqNum < 0 || IrqNum >= SIM_IRQ_NUM) {
+		return FALSE;
+	}
+
+	ameba_audio_sim_irq_lock();
+	memset(&s_sim.irq[IrqNum], 0, sizeof(SimIrq));
+	ameba_audio_sim_irq_unlock();
+
+	return TRUE;
+}
+
+void InterruptEn(int32_t IrqNum, u32 Priority)
+{
+	(void)Priority;
+
+	if (IrqNum >= 0 && IrqNum < SIM_IRQ_NUM) {
+		ameba_audio_sim_irq_lock();
+		s_sim.irq[IrqNum].enabled = true;
+		ameba_audio_sim_irq_unlock();
+	}
+}
+
+void InterruptDis(int32_t IrqNum)
+{
+	if (IrqNum >= 0 && IrqNum < SIM_IRQ_NUM) {
+		ameba_audio_sim_irq_lock();
+		s_sim.irq[IrqNum].enabled = false;
+		ameba_audio_sim_irq_unlock();
+	}
+}
+
+/*
+ * an interrupt unmasked while pending is taken on the next tick, so the delay
+ * of a masked block end is at most one tick_us longer than on target.
+ */
+void GDMA_INTConfig(u8 GDMA_Index, u8 GDMA_ChNum, u32 GDMA_IT, u32 NewState)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	(void)GDMA_IT;
+	if (!ch) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	ch->int_en = (NewState == ENABLE);
+	if (ch->int_en) {
+		sim_gdma_regs.MASK_TFR |= BIT(GDMA_ChNum);
+	} else {
+		sim_gdma_regs.MASK_TFR &= ~BIT(GDMA_ChNum);
+	}
+	ameba_audio_sim_irq_unlock();
+}
+
+u32 GDMA_ClearINT(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	if (ch) {
+		ameba_audio_sim_irq_lock();
+		ch->pending = false;
+		ameba_audio_sim_irq_unlock();
+	}
+
+	return 0;
+}
+
+void GDMA_Cmd(u8 GDMA_Index, u8 GDMA_ChNum, u32 NewState)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	if (!ch) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	ch->active = (NewState == ENABLE) && ch->used;
+	if (ch->active) {
+		sim_gdma_regs.ChEnReg |= BIT(GDMA_ChNum);
+	} else {
+		sim_gdma_regs.ChEnReg &= ~BIT(GDMA_ChNum);
+	}
+	ameba_audio_sim_irq_unlock();
+}
+
+bool GDMA_ChnlFree(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	if (!ch) {
+		return FALSE;
+	}
+
+	ameba_audio_sim_irq_lock();
+	memset(ch, 0, sizeof(SimGdmaCh));
+	sim_gdma_regs.ChEnReg &= ~BIT(GDMA_ChNum);
+	ameba_audio_sim_irq_unlock();
+
+	return TRUE;
+}
+
+void GDMA_Abort(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	if (!ch) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	ch->active = false;
+	ch->pending = false;
+	sim_gdma_regs.ChEnReg &= ~BIT(GDMA_ChNum);
+	ameba_audio_sim_irq_unlock();
+}
+
+static u32 sim_get_cur_addr(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+	u32 addr;
+
+	if (!ch) {
+		return 0;
+	}
+
+	ameba_audio_sim_irq_lock();
+	addr = ch->addr + ch->pos;
+	ameba_audio_sim_irq_unlock();
+
+	return addr;
+}
+
+u32 GDMA_GetSrcAddr(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	return sim_get_cur_addr(GDMA_Index, GDMA_ChNum);
+}
+
+u32 GDMA_GetDstAddr(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	return sim_get_cur_addr(GDMA_Index, GDMA_ChNum);
+}
+
+static void sim_sync_gdma_regs(u8 GDMA_ChNum, SimGdmaCh *ch)
+{
+	if (ch->dir == SIM_DIR_TX) {
+		sim_gdma_regs.CH[GDMA_ChNum].SAR = ch->addr;
+		sim_gdma_regs.CH[GDMA_ChNum].DAR = (u32)(uintptr_t)&sim_sport_regs[ch->sport].SP_TX_FIFO_0_WR_ADDR;
+	} else {
+		sim_gdma_regs.CH[GDMA_ChNum].SAR = (u32)(uintptr_t)&sim_sport_regs[ch->sport].SP_RX_FIFO_0_RD_ADDR;
+		sim_gdma_regs.CH[GDMA_ChNum].DAR = ch->addr;
+	}
+	sim_gdma_regs.CH[GDMA_ChNum].CTL_HIGH = ch->len;
+	sim_gdma_regs.ChEnReg |= BIT(GDMA_ChNum);
+}
+
+static bool sim_gdma_init(u32 Index, u32 dir, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+						  IRQ_FUN CallbackFunc, u32 addr, u32 Length, struct GDMA_CH_LLI *Lli)
+{
+	SimGdmaCh *ch = NULL;
+	int i;
+
+	if (Index >= SIM_SPORT_NUM || !Length) {
+		return FALSE;
+	}
+
+	ameba_audio_sim_irq_lock();
+	for (i = 0; i < SIM_GDMA_CH_NUM; i++) {
+		if (!s_sim.ch[i].used) {
+			ch = &s_sim.ch[i];
+			break;
+		}
+	}
+	if (!ch) {
+		ameba_audio_sim_irq_unlock();
+		RTK_LOGE("SIM", "no free gdma channel\n");
+		return FALSE;
+	}
+
+	memset(ch, 0, sizeof(SimGdmaCh));
+	ch->used = true;
+	ch->active = true;
+	ch->sport = Index;
+	ch->dir = dir;
+	ch->gdma_id = (SelGDMA == GDMA_EXT) ? 1 : 0;
+	ch->addr = addr;
+	ch->len = Length;
+	ch->lli = Lli;
+	ch->callback = CallbackFunc;
+	ch->callback_data = CallbackData;
+	ch->int_en = (CallbackFunc != NULL);
+
+	GDMA_InitStruct->GDMA_Index = 0;
+	GDMA_InitStruct->GDMA_ChNum = i;
+	GDMA_InitStruct->GDMA_IsrType = (TransferType | ErrType);
+	GDMA_InitStruct->GDMA_BlockSize = Length;
+	sim_sync_gdma_regs(i, ch);
+	ameba_audio_sim_irq_unlock();
+
+	return TRUE;
+}
+
+static bool sim_gdma_restart(u8 GDMA_Index, u8 GDMA_ChNum, u32 addr, u32 length)
+{
+	SimGdmaCh *ch = sim_get_ch(GDMA_Index, GDMA_ChNum);
+
+	if (!ch || !ch->used) {
+		return FALSE;
+	}
+
+	ameba_audio_sim_irq_lock();
+	ch->addr = addr;
+	ch->len = length;
+	ch->pos = 0;
+	ch->pending = false;
+	ch->active = true;
+	sim_sync_gdma_regs(GDMA_ChNum, ch);
+	ameba_audio_sim_irq_unlock();
+
+	return TRUE;
+}
+
+bool AUDIO_SP_TXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+						  IRQ_FUN CallbackFunc, u8 *pTxData, u32 Length)
+{
+	return sim_gdma_init(Index, SIM_DIR_TX, SelGDMA, GDMA_InitStruct, CallbackData, CallbackFunc,
+						 (u32)(uintptr_t)pTxData, Length, NULL);
+}
+
+bool AUDIO_SP_RXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+						  IRQ_FUN CallbackFunc, u8 *pRxData, u32 Length)
+{
+	return sim_gdma_init(Index, SIM_DIR_RX, SelGDMA, GDMA_InitStruct, CallbackData, CallbackFunc,
+						 (u32)(uintptr_t)pRxData, Length, NULL);
+}
+
+bool AUDIO_SP_TXGDMA_Restart(u8 GDMA_Index, u8 GDMA_ChNum, u32 tx_addr, u32 tx_length)
+{
+	return sim_gdma_restart(GDMA_Index, GDMA_ChNum, tx_addr, tx_length);
+}
+
+bool AUDIO_SP_RXGDMA_Restart(u8 GDMA_Index, u8 GDMA_ChNum, u32 rx_addr, u32 rx_length)
+{
+	return sim_gdma_restart(GDMA_Index, GDMA_ChNum, rx_addr, rx_length);
+}
+
+/* the lli list is walked cyclically, Length is the bytes of each block. */
+bool AUDIO_SP_LLPTXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+							 IRQ_FUN CallbackFunc, u32 Length, u32 MaxLLP, struct GDMA_CH_LLI *Lli)
+{
+	(void)MaxLLP;
+
+	if (!Lli) {
+		return FALSE;
+	}
+
+	return sim_gdma_init(Index, SIM_DIR_TX, SelGDMA, GDMA_InitStruct, CallbackData, CallbackFunc,
+						 Lli->LliEle.Sarx, Length, Lli);
+}
+
+bool AUDIO_SP_LLPRXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+							 IRQ_FUN CallbackFunc, u32 Length, u32 MaxLLP, struct GDMA_CH_LLI *Lli)
+{
+	(void)MaxLLP;
+
+	if (!Lli) {
+		return FALSE;
+	}
+
+	return sim_gdma_init(Index, SIM_DIR_RX, SelGDMA, GDMA_InitStruct, CallbackData, CallbackFunc,
+						 Lli->LliEle.Darx, Length, Lli);
+}
+
+void AUDIO_SP_StructInit(SP_InitTypeDef *SP_InitStruct)
+{
+	memset(SP_InitStruct, 0, sizeof(SP_InitTypeDef));
+	SP_InitStruct->SP_SelDataFormat = SP_DF_I2S;
+	SP_InitStruct->SP_SelWordLen = SP_TXWL_16;
+	SP_InitStruct->SP_SelChLen = SP_TXWL_32;
+	SP_InitStruct->SP_SelI2SMonoStereo = SP_CH_STEREO;
+	SP_InitStruct->SP_SelTDM = SP_TX_NOTDM;
+	SP_InitStruct->SP_SelFIFO = SP_TX_FIFO2;
+	SP_InitStruct->SP_SetMultiIO = SP_TX_MULTIIO_DIS;
+	SP_InitStruct->SP_SR = SP_48K;
+}
+
+static void sim_sport_dir_init(SimSportDir *sdir, SP_InitTypeDef *SP_InitStruct)
+{
+	memset(sdir, 0, sizeof(SimSportDir));
+	sdir->rate = SP_InitStruct->SP_SR;
+	sdir->word_bytes = (SP_InitStruct->SP_SelWordLen == SP_TXWL_16) ? 2 : 4;
+	if (SP_InitStruct->SP_SelTDM != SP_TX_NOTDM) {
+		sdir->channels = SP_InitStruct->SP_SelTDM;
+	} else {
+		sdir->channels = (SP_InitStruct->SP_SelI2SMonoStereo == SP_CH_MONO) ? 1 : 2;
+	}
+	sdir->inited = true;
+}
+
+void AUDIO_SP_Init(u32 index, u32 direction, SP_InitTypeDef *SP_InitStruct)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	if (direction & SP_DIR_TX) {
+		sim_sport_dir_init(&s_sim.sport[index].dir[SIM_DIR_TX], SP_InitStruct);
+		sim_sport_regs[index].SP_SR_TX_BCLK = SP_InitStruct->SP_SR;
+	}
+	if (direction & SP_DIR_RX) {
+		sim_sport_dir_init(&s_sim.sport[index].dir[SIM_DIR_RX], SP_InitStruct);
+		sim_sport_regs[index].SP_RX_BCLK = SP_InitStruct->SP_SR;
+	}
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_Deinit(u32 index, u32 direction)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	if (direction & SP_DIR_TX) {
+		memset(&s_sim.sport[index].dir[SIM_DIR_TX], 0, sizeof(SimSportDir));
+	}
+	if (direction & SP_DIR_RX) {
+		memset(&s_sim.sport[index].dir[SIM_DIR_RX], 0, sizeof(SimSportDir));
+	}
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_Reset(u32 index)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	memset(&s_sim.sport[index], 0, sizeof(SimSport));
+	memset(&sim_sport_regs[index], 0, sizeof(AUDIO_SPORT_TypeDef));
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_SetMasterSlave(u32 index, u32 role)
+{
+	(void)index;
+	(void)role;
+}
+
+static void sim_sport_start(u32 index, u32 dir, u32 NewState)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, dir);
+	u32 start_bit = (dir == SIM_DIR_TX) ? SP_BIT_START_TX : SP_BIT_START_RX;
+	u32 disable_bit = (dir == SIM_DIR_TX) ? SP_BIT_TX_DISABLE : SP_BIT_RX_DISABLE;
+
+	if (!sdir) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	sdir->started = (NewState == ENABLE);
+	sdir->frame_frac = 0;
+	memset(sdir->fifo_debt, 0, sizeof(sdir->fifo_debt));
+	if (sdir->started) {
+		sim_sport_regs[index].SP_CTRL0 = (sim_sport_regs[index].SP_CTRL0 | start_bit) & ~disable_bit;
+	} else {
+		sim_sport_regs[index].SP_CTRL0 = (sim_sport_regs[index].SP_CTRL0 & ~start_bit) | disable_bit;
+	}
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_TXStart(u32 index, u32 NewState)
+{
+	sim_sport_start(index, SIM_DIR_TX, NewState);
+}
+
+void AUDIO_SP_RXStart(u32 index, u32 NewState)
+{
+	sim_sport_start(index, SIM_DIR_RX, NewState);
+}
+
+void AUDIO_SP_DmaCmd(u32 index, u32 NewState)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	s_sim.sport[index].dma_en = (NewState == ENABLE);
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_TXSetFifo(u32 index, u32 fifo_num, u32 NewState)
+{
+	(void)index;
+	(void)fifo_num;
+	(void)NewState;
+}
+
+void AUDIO_SP_RXSetFifo(u32 index, u32 fifo_num, u32 NewState)
+{
+	(void)index;
+	(void)fifo_num;
+	(void)NewState;
+}
+
+static void sim_set_counter(u32 index, u32 dir, u32 state)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, dir);
+
+	if (!sdir) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	sdir->counter_en = (state == ENABLE);
+	sdir->counter = 0;
+	ameba_audio_sim_irq_unlock();
+}
+
+void AUDIO_SP_SetTXCounter(u32 index, u32 state)
+{
+	sim_set_counter(index, SIM_DIR_TX, state);
+}
+
+void AUDIO_SP_SetRXCounter(u32 index, u32 state)
+{
+	sim_set_counter(index, SIM_DIR_RX, state);
+}
+
+void AUDIO_SP_SetTXCounterCompVal(u32 index, u32 comp_val)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, SIM_DIR_TX);
+
+	if (sdir) {
+		sdir->comp_val = comp_val;
+	}
+}
+
+void AUDIO_SP_SetRXCounterCompVal(u32 index, u32 comp_val)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, SIM_DIR_RX);
+
+	if (sdir) {
+		sdir->comp_val = comp_val;
+	}
+}
+
+/* the counters read back the value of the last phase latch, like on target. */
+void AUDIO_SP_SetPhaseLatch(u32 index)
+{
+	if (index >= SIM_SPORT_NUM) {
+		return;
+	}
+
+	ameba_audio_sim_irq_lock();
+	s_sim.sport[index].dir[SIM_DIR_TX].phase_counter = s_sim.sport[index].dir[SIM_DIR_TX].counter;
+	s_sim.sport[index].dir[SIM_DIR_RX].phase_counter = s_sim.sport[index].dir[SIM_DIR_RX].counter;
+	ameba_audio_sim_irq_unlock();
+}
+
+u32 AUDIO_SP_GetTXCounterVal(u32 index)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, SIM_DIR_TX);
+
+	return sdir ? sdir->phase_counter : 0;
+}
+
+u32 AUDIO_SP_GetRXCounterVal(u32 index)
+{
+	SimSportDir *sdir = sim_get_sport_dir(index, SIM_DIR_RX);
+
+	return sdir ? sdir->phase_counter : 0;
+}
+
+/* frames move whole, there is no phase inside a frame. */
+u32 AUDIO_SP_GetTXPhaseVal(u32 index)
+{
+	(void)index;
+	return 0;
+}
+
+u32 AUDIO_SP_GetRXPhaseVal(u32 index)
+{
+	(void)index;
+	return 0;
+}
+
+void AUDIO_SP_ClearTXCounterIrq(u32 index)
+{
+	(void)index;
+}
+
+void AUDIO_SP_ClearRXCounterIrq(u32 index)
+{
+	(void)index;
+}
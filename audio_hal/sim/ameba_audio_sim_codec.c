@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * the codec, clocks and pins do not exist on the host, their calls only keep the
+ * hal flow of the target.
+ */
+
+#include "ameba.h"
+#include "i2c_api.h"
+
+#include "ameba_audio_sim.h"
+
+AUD_TypeDef sim_aud_regs;
+AUDIO_TypeDef sim_audio_regs;
+u32 sim_pinmux_regs[64];
+
+void AUDIO_CODEC_I2S_StructInit(I2S_InitTypeDef *I2S_initstruct)
+{
+	memset(I2S_initstruct, 0, sizeof(I2S_InitTypeDef));
+}
+
+void AUDIO_CODEC_SetI2SIP(u32 i2s_sel, u32 NewState)
+{
+	(void)i2s_sel;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetI2SSRC(u32 i2s_sel, u32 src)
+{
+	(void)i2s_sel;
+	(void)src;
+}
+
+void AUDIO_CODEC_SetI2SParameters(u32 i2s_sel, u32 path, I2S_InitTypeDef *I2S_Params)
+{
+	(void)i2s_sel;
+	(void)path;
+	(void)I2S_Params;
+}
+
+void AUDIO_CODEC_Playback(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct)
+{
+	(void)i2s_sel;
+	(void)type;
+	(void)I2S_InitStruct;
+}
+
+void AUDIO_CODEC_Record(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct)
+{
+	(void)i2s_sel;
+	(void)type;
+	(void)I2S_InitStruct;
+}
+
+void AUDIO_CODEC_SetAudioIP(u32 NewState)
+{
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetANAClk(u32 NewState)
+{
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetLDOMode(u32 powermode)
+{
+	(void)powermode;
+}
+
+void AUDIO_CODEC_DisPAD(u32 path)
+{
+	(void)path;
+}
+
+void AUDIO_CODEC_EnableDAC(u32 channel, u32 NewState)
+{
+	(void)channel;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_EnableDACFifo(u32 NewState)
+{
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetDACSrc(u32 i2s_sel, u32 dac_l_src, u32 dac_r_src)
+{
+	(void)i2s_sel;
+	(void)dac_l_src;
+	(void)dac_r_src;
+}
+
+void AUDIO_CODEC_SetDACSRSrc(u32 src, u32 sr)
+{
+	(void)src;
+	(void)sr;
+}
+
+void AUDIO_CODEC_SetDACASRC(u32 sr, u32 NewState)
+{
+	(void)sr;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetDACHPF(u32 channel, u32 NewState)
+{
+	(void)channel;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetDACMute(u32 channel, u32 Mute)
+{
+	(void)channel;
+	(void)Mute;
+}
+
+void AUDIO_CODEC_SetDACPowerMode(u32 channel, u32 powermode)
+{
+	(void)channel;
+	(void)powermode;
+}
+
+void AUDIO_CODEC_SetDACVolume(u32 channel, u32 Gain)
+{
+	(void)channel;
+	(void)Gain;
+}
+
+void AUDIO_CODEC_SetDACZDET(u32 channel, u32 type)
+{
+	(void)channel;
+	(void)type;
+}
+
+void AUDIO_CODEC_SetDACZDETTimeOut(u32 channel, u32 TimeOut)
+{
+	(void)channel;
+	(void)TimeOut;
+}
+
+void AUDIO_CODEC_SetLineOutMode(u32 channel, u32 mode)
+{
+	(void)channel;
+	(void)mode;
+}
+
+void AUDIO_CODEC_SetLineOutMute(u32 channel, u32 type, u32 NewState)
+{
+	(void)channel;
+	(void)type;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetLineOutPowerMode(u32 channel, u32 powermode)
+{
+	(void)channel;
+	(void)powermode;
+}
+
+void AUDIO_CODEC_EnableADC(u32 ad_chn, u32 NewState)
+{
+	(void)ad_chn;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_EnableADCFifo(u32 ad_chn, u32 NewState)
+{
+	(void)ad_chn;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_EnableADCForMask(u32 ad_chn_mask)
+{
+	(void)ad_chn_mask;
+}
+
+void AUDIO_CODEC_EnableADCFifoForMask(u32 ad_chn_mask)
+{
+	(void)ad_chn_mask;
+}
+
+void AUDIO_CODEC_SetADCANAFilter(u32 adc_sel, u32 NewState)
+{
+	(void)adc_sel;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetADCANASrc(u32 ad_chn, u32 amic_num)
+{
+	(void)ad_chn;
+	(void)amic_num;
+}
+
+void AUDIO_CODEC_SetADCDmicFilter(u32 adc_num, u32 NewState)
+{
+	(void)adc_num;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetADCHPF(u32 adc_sel, u32 fc, u32 NewState)
+{
+	(void)adc_sel;
+	(void)fc;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetADCMixMute(u32 adc_num, u32 type, u32 newstate)
+{
+	(void)adc_num;
+	(void)type;
+	(void)newstate;
+}
+
+void AUDIO_CODEC_SetADCMute(u32 adc_sel, u32 newstate)
+{
+	(void)adc_sel;
+	(void)newstate;
+}
+
+void AUDIO_CODEC_SetADCSRSrc(u32 src, u32 sr)
+{
+	(void)src;
+	(void)sr;
+}
+
+void AUDIO_CODEC_SetADCVolume(u32 adc_sel, u32 gain)
+{
+	(void)adc_sel;
+	(void)gain;
+}
+
+void AUDIO_CODEC_SetDmicClk(u32 clk, u32 NewState)
+{
+	(void)clk;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetDmicSrc(u32 ad_chn, u32 dmic_num)
+{
+	(void)ad_chn;
+	(void)dmic_num;
+}
+
+void AUDIO_CODEC_SetMicBiasPowerMode(u32 powermode)
+{
+	(void)powermode;
+}
+
+void AUDIO_CODEC_SetMicBstChnMute(u32 amic_sel, u32 type, u32 newstate)
+{
+	(void)amic_sel;
+	(void)type;
+	(void)newstate;
+}
+
+void AUDIO_CODEC_SetMicBstGain(u32 amic_sel, u32 gain)
+{
+	(void)amic_sel;
+	(void)gain;
+}
+
+void AUDIO_CODEC_SetMicBstInputMode(u32 amic_num, u32 mode)
+{
+	(void)amic_num;
+	(void)mode;
+}
+
+void AUDIO_CODEC_SetMicBstPowerMode(u32 amic_num, u32 powermode)
+{
+	(void)amic_num;
+	(void)powermode;
+}
+
+void Pinmux_Config(u8 PinName, u32 PinFunc)
+{
+	(void)PinName;
+	(void)PinFunc;
+}
+
+void GPIO_Init(GPIO_InitTypeDef *GPIO_InitStruct)
+{
+	(void)GPIO_InitStruct;
+}
+
+void GPIO_WriteBit(u32 GPIO_Pin, u32 Pin_State)
+{
+	(void)GPIO_Pin;
+	(void)Pin_State;
+}
+
+void RCC_PeriphClockCmd(u32 APBPeriph, u32 APBPeriph_Clock, u8 NewState)
+{
+	(void)APBPeriph;
+	(void)APBPeriph_Clock;
+	(void)NewState;
+}
+
+void RCC_PeriphClockSource_SPORT(u32 Source)
+{
+	(void)Source;
+}
+
+void RCC_PeriphClockSource_AUDIOCODEC(u32 Source)
+{
+	(void)Source;
+}
+
+void PLL_I2S_98P304M(u32 Source, u32 NewState)
+{
+	(void)Source;
+	(void)NewState;
+}
+
+void PLL_I2S_45P158M(u32 Source, u32 NewState)
+{
+	(void)Source;
+	(void)NewState;
+}
+
+/* the pll moves in FOF steps of ~1.55ppm, the sim applies the value as asked. */
+static float sim_pll_clk_tune(float ppm, u32 action)
+{
+	switch (action) {
+	case PLL_FASTER:
+		ameba_audio_sim_set_pll_ppm(ppm);
+		return ppm;
+	case PLL_SLOWER:
+		ameba_audio_sim_set_pll_ppm(-ppm);
+		return ppm;
+	default:
+		ameba_audio_sim_set_pll_ppm(0);
+		return 0;
+	}
+}
+
+float PLL_I2S_98P304M_ClkTune(u32 Source, float ppm, u32 action)
+{
+	(void)Source;
+
+	return sim_pll_clk_tune(ppm, action);
+}
+
+float PLL_I2S_45P158M_ClkTune(u32 Source, float ppm, u32 action)
+{
+	(void)Source;
+
+	return sim_pll_clk_tune(ppm, action);
+}
+
+bool TrustZone_IsSecure(void)
+{
+	return FALSE;
+}
+
+//host has no cycle counter for the hal, the isr trace counts in us at this rate.
+u32 SystemGetCpuClk(void)
+{
+	return 400000000;
+}
+
+void i2c_init(i2c_t *obj, PinName sda, PinName scl)
+{
+	(void)obj;
+	(void)sda;
+	(void)scl;
+}
+
+void i2c_frequency(i2c_t *obj, int hz)
+{
+	(void)obj;
+	(void)hz;
+}
+
+int i2c_read(i2c_t *obj, int address, char *data, int length, int stop)
+{
+	(void)obj;
+	(void)address;
+	(void)data;
+	(void)length;
+	(void)stop;
+
+	return length;
+}
+
+int i2c_write(i2c_t *obj, int address, const char *data, int length, int stop)
+{
+	(void)obj;
+	(void)address;
+	(void)data;
+	(void)length;
+	(void)stop;
+
+	return length;
+}
+
+void i2c_reset(i2c_t *obj)
+{
+	(void)obj;
+}
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ameba.h"
+#include "os_wrapper.h"
+
+#include "ameba_audio_sim.h"
+
+/*
+ * The hal keeps dma addresses in u32, so the heap is carved from an arena in the
+ * low 2GB(MAP_32BIT), with power of 2 size classes and a free list per class.
+ */
+#define SIM_HEAP_SIZE            (256 * 1024 * 1024)
+#define SIM_HEAP_MIN_SHIFT       5
+#define SIM_HEAP_CLASS_NUM       27
+#define SIM_HEAP_HEADER          32
+
+typedef struct SimHeapBlock {
+	struct SimHeapBlock *next;
+	uint32_t size_class;
+} SimHeapBlock;
+
+typedef struct {
+	pthread_mutex_t lock;
+	uint8_t *base;
+	size_t used;
+	SimHeapBlock *free_list[SIM_HEAP_CLASS_NUM];
+} SimHeap;
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint32_t count;
+	uint32_t max_count;
+} SimSema;
+
+typedef struct {
+	pthread_t thread;
+	void (*routine)(void *);
+	void *param;
+} SimTask;
+
+static SimHeap s_heap = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static int s_log_level = RTK_LOG_WARN;
+
+static uint32_t sim_heap_size_class(uint32_t size)
+{
+	uint32_t size_class = 0;
+
+	while (((uint32_t)1 << (size_class + SIM_HEAP_MIN_SHIFT)) < size) {
+		size_class++;
+	}
+
+	return size_class;
+}
+
+void *rtos_mem_malloc(uint32_t size)
+{
+	SimHeapBlock *block = NULL;
+	uint32_t size_class = sim_heap_size_class(size);
+	size_t bytes;
+
+	if (size_class >= SIM_HEAP_CLASS_NUM) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&s_heap.lock);
+	if (!s_heap.base) {
+		void *base = mmap(NULL, SIM_HEAP_SIZE, PROT_READ | PROT_WRITE,
+						  MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_NORESERVE, -1, 0);
+		if (base == MAP_FAILED) {
+			pthread_mutex_unlock(&s_heap.lock);
+			fprintf(stderr, "sim heap map fail:%d\n", errno);
+			return NULL;
+		}
+		s_heap.base = (uint8_t *)base;
+	}
+
+	if (s_heap.free_list[size_class]) {
+		block = s_heap.free_list[size_class];
+		s_heap.free_list[size_class] = block->next;
+	} else {
+		bytes = SIM_HEAP_HEADER + ((size_t)1 << (size_class + SIM_HEAP_MIN_SHIFT));
+		if (s_heap.used + bytes <= SIM_HEAP_SIZE) {
+			block = (SimHeapBlock *)(s_heap.base + s_heap.used);
+			block->size_class = size_class;
+			s_heap.used += bytes;
+		}
+	}
+	pthread_mutex_unlock(&s_heap.lock);
+
+	return block ? (uint8_t *)block + SIM_HEAP_HEADER : NULL;
+}
+
+void *rtos_mem_zmalloc(uint32_t size)
+{
+	void *pbuf = rtos_mem_malloc(size);
+
+	if (pbuf) {
+		memset(pbuf, 0, size);
+	}
+
+	return pbuf;
+}
+
+void *rtos_mem_calloc(uint32_t count, uint32_t size)
+{
+	return rtos_mem_zmalloc(count * size);
+}
+
+void *rtos_mem_realloc(void *pbuf, uint32_t size)
+{
+	SimHeapBlock *block;
+	uint32_t old_size;
+	void *new_buf;
+
+	if (!pbuf) {
+		return rtos_mem_malloc(size);
+	}
+
+	block = (SimHeapBlock *)((uint8_t *)pbuf - SIM_HEAP_HEADER);
+	old_size = (uint32_t)1 << (block->size_class + SIM_HEAP_MIN_SHIFT);
+	if (size <= old_size) {
+		return pbuf;
+	}
+
+	new_buf = rtos_mem_malloc(size);
+	if (new_buf) {
+		memcpy(new_buf, pbuf, old_size);
+		rtos_mem_free(pbuf);
+	}
+
+	return new_buf;
+}
+
+void rtos_mem_free(void *pbuf)
+{
+	SimHeapBlock *block;
+
+	if (!pbuf) {
+		return;
+	}
+
+	block = (SimHeapBlock *)((uint8_t *)pbuf - SIM_HEAP_HEADER);
+	pthread_mutex_lock(&s_heap.lock);
+	block->next = s_heap.free_list[block->size_class];
+	s_heap.free_list[block->size_class] = block;
+	pthread_mutex_unlock(&s_heap.lock);
+}
+
+static void sim_deadline(struct timespec *ts, uint32_t wait_ms)
+{
+	clock_gettime(CLOCK_MONOTONIC, ts);
+	ts->tv_sec += wait_ms / 1000;
+	ts->tv_nsec += (long)(wait_ms % 1000) * 1000000L;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+int rtos_sema_create(rtos_sema_t *pp_handle, uint32_t init_count, uint32_t max_count)
+{
+	pthread_condattr_t attr;
+	SimSema *sema = (SimSema *)calloc(1, sizeof(SimSema));
+
+	if (!sema) {
+		return FAIL;
+	}
+
+	pthread_mutex_init(&sema->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&sema->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	sema->count = init_count;
+	sema->max_count = max_count;
+	*pp_handle = sema;
+
+	return SUCCESS;
+}
+
+int rtos_sema_create_binary(rtos_sema_t *pp_handle)
+{
+	return rtos_sema_create(pp_handle, 0, 1);
+}
+
+int rtos_sema_delete(rtos_sema_t p_handle)
+{
+	SimSema *sema = (SimSema *)p_handle;
+
+	if (!sema) {
+		return FAIL;
+	}
+
+	pthread_cond_destroy(&sema->cond);
+	pthread_mutex_destroy(&sema->lock);
+	free(sema);
+
+	return SUCCESS;
+}
+
+int rtos_sema_take(rtos_sema_t p_handle, uint32_t wait_ms)
+{
+	SimSema *sema = (SimSema *)p_handle;
+	struct timespec deadline;
+	int ret = 0;
+
+	if (!sema) {
+		return FAIL;
+	}
+
+	if (wait_ms != RTOS_MAX_TIMEOUT) {
+		sim_deadline(&deadline, wait_ms);
+	}
+
+	pthread_mutex_lock(&sema->lock);
+	while (sema->count == 0 && ret != ETIMEDOUT) {
+		if (wait_ms == RTOS_MAX_TIMEOUT) {
+			pthread_cond_wait(&sema->cond, &sema->lock);
+		} else {
+			ret = pthread_cond_timedwait(&sema->cond, &sema->lock, &deadline);
+		}
+	}
+	if (sema->count == 0) {
+		pthread_mutex_unlock(&sema->lock);
+		return FAIL;
+	}
+	sema->count--;
+	pthread_mutex_unlock(&sema->lock);
+
+	return SUCCESS;
+}
+
+int rtos_sema_give(rtos_sema_t p_handle)
+{
+	SimSema *sema = (SimSema *)p_handle;
+
+	if (!sema) {
+		return FAIL;
+	}
+
+	pthread_mutex_lock(&sema->lock);
+	if (sema->count < sema->max_count) {
+		sema->count++;
+	}
+	pthread_cond_signal(&sema->cond);
+	pthread_mutex_unlock(&sema->lock);
+
+	return SUCCESS;
+}
+
+int rtos_mutex_create(rtos_mutex_t *pp_handle)
+{
+	pthread_mutex_t *mutex = (pthread_mutex_t *)calloc(1, sizeof(pthread_mutex_t));
+
+	if (!mutex) {
+		return FAIL;
+	}
+
+	pthread_mutex_init(mutex, NULL);
+	*pp_handle = mutex;
+
+	return SUCCESS;
+}
+
+int rtos_mutex_delete(rtos_mutex_t p_handle)
+{
+	if (!p_handle) {
+		return FAIL;
+	}
+
+	pthread_mutex_destroy((pthread_mutex_t *)p_handle);
+	free(p_handle);
+
+	return SUCCESS;
+}
+
+int rtos_mutex_take(rtos_mutex_t p_handle, uint32_t wait_ms)
+{
+	struct timespec deadline;
+
+	if (!p_handle) {
+		return FAIL;
+	}
+
+	if (wait_ms == RTOS_MAX_TIMEOUT) {
+		return pthread_mutex_lock((pthread_mutex_t *)p_handle) == 0 ? SUCCESS : FAIL;
+	}
+
+	//pthread_mutex_timedlock only takes CLOCK_REALTIME.
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += wait_ms / 1000;
+	deadline.tv_nsec += (long)(wait_ms % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	return pthread_mutex_timedlock((pthread_mutex_t *)p_handle, &deadline) == 0 ? SUCCESS : FAIL;
+}
+
+int rtos_mutex_give(rtos_mutex_t p_handle)
+{
+	if (!p_handle) {
+		return FAIL;
+	}
+
+	return pthread_mutex_unlock((pthread_mutex_t *)p_handle) == 0 ? SUCCESS : FAIL;
+}
+
+void rtos_critical_enter(uint32_t component_id)
+{
+	(void)component_id;
+	ameba_audio_sim_irq_lock();
+}
+
+void rtos_critical_exit(uint32_t component_id)
+{
+	(void)component_id;
+	ameba_audio_sim_irq_unlock();
+}
+
+static void *sim_task_entry(void *param)
+{
+	SimTask *task = (SimTask *)param;
+
+	task->routine(task->param);
+
+	return NULL;
+}
+
+int rtos_task_create(rtos_task_t *pp_handle, const char *p_name, void (*p_routine)(void *),
+					 void *p_param, uint16_t stack_size_in_byte, uint16_t priority)
+{
+	SimTask *task = (SimTask *)calloc(1, sizeof(SimTask));
+
+	(void)p_name;
+	(void)stack_size_in_byte;
+	(void)priority;
+
+	if (!task) {
+		return FAIL;
+	}
+
+	task->routine = p_routine;
+	task->param = p_param;
+	if (pthread_create(&task->thread, NULL, sim_task_entry, task) != 0) {
+		free(task);
+		return FAIL;
+	}
+
+	if (pp_handle) {
+		*pp_handle = task;
+	}
+
+	return SUCCESS;
+}
+
+int rtos_task_delete(rtos_task_t p_handle)
+{
+	SimTask *task = (SimTask *)p_handle;
+
+	//tasks delete themselves with NULL on target, here they just return from the routine.
+	if (!task) {
+		return SUCCESS;
+	}
+
+	pthread_join(task->thread, NULL);
+	free(task);
+
+	return SUCCESS;
+}
+
+void rtos_time_delay_ms(uint32_t ms)
+{
+	rtos_time_delay_us(ms * 1000);
+}
+
+void rtos_time_delay_us(uint32_t us)
+{
+	struct timespec ts;
+
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (long)(us % 1000000) * 1000L;
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+	}
+}
+
+uint64_t rtos_time_get_current_system_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t rtos_time_get_current_system_time_us(void)
+{
+	return rtos_time_get_current_system_time_ns() / 1000;
+}
+
+uint32_t rtos_time_get_current_system_time_ms(void)
+{
+	return (uint32_t)(rtos_time_get_current_system_time_ns() / 1000000);
+}
+
+void ameba_audio_sim_set_log_level(int level)
+{
+	s_log_level = level;
+}
+
+void rtk_log_write(int level, const char *tag, const char *fmt, ...)
+{
+	va_list args;
+
+	if (level != RTK_LOG_ALWAYS && level > s_log_level) {
+		return;
+	}
+
+	fprintf(stderr, "[%s] ", tag);
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+}
+
+void DiagPrintf(const char *fmt, ...)
+{
+	va_list args;
+
+	if (s_log_level < RTK_LOG_WARN) {
+		return;
+	}
+
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * zero copy access of the stream ring buffer: a byte counter goes in by write or by
+ * acquire_write_region/commit_write in turns, and comes out by read or by
+ * acquire_read_region/commit_read, with random sizes and partial commits. Checks every
+ * byte arrives once and in order, a region never crosses the end of raw_data, and the
+ * ring accounting(size_remain) matches the bytes in flight after each step.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ameba_audio_stream_buffer.h"
+#include "ameba_audio_types.h"
+
+#define BUFFER_TEST_MAX_PIECE 4096
+
+typedef struct {
+	AudioBuffer *buffer;
+	uint32_t max_piece;
+	uint32_t seed;
+	uint64_t sent;
+	uint64_t done;
+	uint64_t errors;
+	uint64_t region_writes;
+	uint64_t region_reads;
+} BufferTest;
+
+static uint32_t buffer_test_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 8;
+}
+
+static void buffer_test_error(BufferTest *test, const char *what, uint64_t got, uint64_t expect)
+{
+	if (test->errors++ < 8) {
+		printf("%s: got %llu, expect %llu\n", what, (unsigned long long)got, (unsigned long long)expect);
+	}
+}
+
+static void buffer_test_check_region(BufferTest *test, void *region, size_t size)
+{
+	char *start = test->buffer->raw_data;
+
+	if ((char *)region < start || (char *)region + size > start + test->buffer->capacity) {
+		buffer_test_error(test, "region end", (uint64_t)((char *)region + size - start), test->buffer->capacity);
+	}
+}
+
+static void buffer_test_write(BufferTest *test, uint32_t len)
+{
+	uint8_t piece[BUFFER_TEST_MAX_PIECE];
+	void *region = NULL;
+	size_t size;
+	uint32_t i;
+
+	if (len & 1) {
+		for (i = 0; i < len; i++) {
+			piece[i] = (uint8_t)(test->sent + i);
+		}
+		test->sent += ameba_audio_stream_buffer_write(test->buffer, piece, len);
+		return;
+	}
+
+	size = ameba_audio_stream_buffer_acquire_write_region(test->buffer, &region, len);
+	if (size == 0) {
+		return;
+	}
+	buffer_test_check_region(test, region, size);
+	//fill all of it, commit part of it: the uncommitted tail is overwritten by the next write.
+	for (i = 0; i < size; i++) {
+		((uint8_t *)region)[i] = (uint8_t)(test->sent + i);
+	}
+	size -= buffer_test_rand(&test->seed) % 2 ? size / 3 : 0;
+	test->sent += ameba_audio_stream_buffer_commit_write(test->buffer, size);
+	test->region_writes++;
+}
+
+static void buffer_test_check(BufferTest *test, const uint8_t *data, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (data[i] != (uint8_t)(test->done + i)) {
+			buffer_test_error(test, "byte", data[i], (uint8_t)(test->done + i));
+		}
+	}
+	test->done += len;
+}
+
+static void buffer_test_read(BufferTest *test, uint32_t len)
+{
+	uint8_t piece[BUFFER_TEST_MAX_PIECE];
+	void *region = NULL;
+	size_t size;
+
+	if (len & 1) {
+		size = ameba_audio_stream_buffer_read(test->buffer, piece, len, AMEBA_AUDIO_DMA_IRQ_MODE);
+		buffer_test_check(test, piece, size);
+		return;
+	}
+
+	size = ameba_audio_stream_buffer_acquire_read_region(test->buffer, &region, len);
+	if (size == 0) {
+		return;
+	}
+	buffer_test_check_region(test, region, size);
+	size -= buffer_test_rand(&test->seed) % 2 ? size / 3 : 0;
+	buffer_test_check(test, (const uint8_t *)region, size);
+	if (ameba_audio_stream_buffer_commit_read(test->buffer, size) != size) {
+		buffer_test_error(test, "commit read", 0, size);
+	}
+	test->region_reads++;
+}
+
+int main(int argc, char **argv)
+{
+	BufferTest test;
+	uint32_t capacity = 1024;
+	uint64_t total = 4ULL * 1024 * 1024;
+	void *region = NULL;
+	int opt;
+
+	memset(&test, 0, sizeof(test));
+	test.max_piece = 700;
+	test.seed = 1;
+	while ((opt = getopt(argc, argv, "c:m:n:s:h")) != -1) {
+		switch (opt) {
+		case 'c':
+			capacity = strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			test.max_piece = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			total = strtoull(optarg, NULL, 0);
+			break;
+		case 's':
+			test.seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			printf("usage: %s [-c capacity] [-m max_piece] [-n bytes] [-s seed]\n", argv[0]);
+			return opt == 'h' ? 0 : 1;
+		}
+	}
+	if (test.max_piece == 0 || test.max_piece > BUFFER_TEST_MAX_PIECE) {
+		test.max_piece = BUFFER_TEST_MAX_PIECE;
+	}
+
+	test.buffer = ameba_audio_stream_buffer_create();
+	if (!test.buffer) {
+		printf("buffer create fail\n");
+		return 1;
+	}
+	ameba_audio_stream_buffer_alloc(test.buffer, capacity);
+	if (!test.buffer->raw_data) {
+		printf("buffer alloc fail\n");
+		return 1;
+	}
+
+	if (ameba_audio_stream_buffer_acquire_read_region(test.buffer, &region, capacity) != 0) {
+		buffer_test_error(&test, "empty ring read region", 1, 0);
+	}
+
+	while (test.done < total) {
+		uint32_t len = buffer_test_rand(&test.seed) % test.max_piece + 1;
+
+		if (buffer_test_rand(&test.seed) % 2 && test.sent < total) {
+			buffer_test_write(&test, len);
+		} else {
+			buffer_test_read(&test, len);
+		}
+		if (ameba_audio_stream_buffer_get_remain_size(test.buffer) != test.sent - test.done) {
+			buffer_test_error(&test, "size_remain", ameba_audio_stream_buffer_get_remain_size(test.buffer), test.sent - test.done);
+			break;
+		}
+		if (ameba_audio_stream_buffer_get_remain_size(test.buffer) == capacity &&
+			ameba_audio_stream_buffer_acquire_write_region(test.buffer, &region, capacity) != 0) {
+			buffer_test_error(&test, "full ring write region", 1, 0);
+		}
+	}
+
+	printf("capacity:%u bytes:%llu region writes:%llu region reads:%llu errors:%llu\n", (unsigned)capacity,
+		   (unsigned long long)test.done, (unsigned long long)test.region_writes, (unsigned long long)test.region_reads,
+		   (unsigned long long)test.errors);
+	ameba_audio_stream_buffer_release(test.buffer);
+
+	return test.errors ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * two thread stress of the a2dp/usb spsc ring: a writer thread pushes a byte counter in
+ * random sized pieces, the reader drains it with read and peek/commit in turns and checks
+ * every byte arrives once and in order. The writer sleeps on a full ring through
+ * write_wait and the reader wakes it with wake_writer, like the a2dp and usb stream outs,
+ * the reader polls an empty ring, so head and tail wrap and race on every access.
+ */
+
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ameba_spsc_ring.h"
+
+#define RING_TEST_MAX_PIECE 4096
+#define RING_TEST_WAIT_MS   2000
+
+typedef struct {
+	ring_buffer_header *rb;
+	uint64_t total;
+	uint32_t max_piece;
+	uint32_t seed;
+	uint64_t done;
+	uint64_t errors;
+	uint64_t peeks;
+	uint64_t wakeups;
+	rtos_sema_t sema;
+	volatile uint32_t waiting;
+} RingTest;
+
+static uint32_t ring_test_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 8;
+}
+
+static void *ring_test_writer(void *param)
+{
+	RingTest *test = (RingTest *)param;
+	uint8_t piece[RING_TEST_MAX_PIECE];
+	uint64_t sent = 0;
+	uint32_t seed = test->seed;
+
+	while (sent < test->total) {
+		uint32_t len = ring_test_rand(&seed) % test->max_piece + 1;
+
+		if (len > test->total - sent) {
+			len = test->total - sent;
+		}
+		for (uint32_t i = 0; i < len; i++) {
+			piece[i] = (uint8_t)(sent + i);
+		}
+		if (ameba_spsc_ring_write_wait(test->rb, piece, len, test->sema, &test->waiting, RING_TEST_WAIT_MS) != len) {
+			printf("writer stalled at byte %llu\n", (unsigned long long)sent);
+			test->errors++;
+			test->done = test->total;
+			break;
+		}
+		sent += len;
+		//on a single core host the sides would only swap on a full or empty ring, and
+		//every read and write would start at offset 0 and never wrap.
+		sched_yield();
+	}
+
+	return NULL;
+}
+
+static void ring_test_check(RingTest *test, const uint8_t *data, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		if (data[i] != (uint8_t)(test->done + i)) {
+			if (test->errors++ < 8) {
+				printf("byte %llu: got %u, expect %u\n", (unsigned long long)(test->done + i), data[i],
+					   (uint8_t)(test->done + i));
+			}
+		}
+	}
+	test->done += len;
+}
+
+static void *ring_test_reader(void *param)
+{
+	RingTest *test = (RingTest *)param;
+	uint8_t piece[RING_TEST_MAX_PIECE];
+	uint32_t seed = test->seed ^ 0x5a5a5a5a;
+
+	while (test->done < test->total) {
+		uint32_t len = ring_test_rand(&seed) % test->max_piece + 1;
+		void *region;
+
+		if (len & 1) {
+			len = ameba_spsc_ring_read(test->rb, piece, len);
+			ring_test_check(test, piece, len);
+		} else {
+			uint32_t size = ameba_spsc_ring_peek(test->rb, &region);
+
+			if (len > size) {
+				len = size;
+			}
+			ring_test_check(test, (const uint8_t *)region, len);
+			ameba_spsc_ring_commit(test->rb, len);
+			test->peeks += len != 0;
+		}
+		test->wakeups += ameba_spsc_ring_wake_writer(test->sema, &test->waiting);
+		sched_yield();
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	RingTest test;
+	pthread_t writer;
+	pthread_t reader;
+	uint32_t capacity = 1024;
+	int opt;
+
+	memset(&test, 0, sizeof(test));
+	test.total = 16ULL * 1024 * 1024;
+	test.max_piece = 700;
+	test.seed = 1;
+	while ((opt = getopt(argc, argv, "c:m:n:s:h")) != -1) {
+		switch (opt) {
+		case 'c':
+			capacity = strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			test.max_piece = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			test.total = strtoull(optarg, NULL, 0);
+			break;
+		case 's':
+			test.seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			printf("usage: %s [-c capacity] [-m max_piece] [-n bytes] [-s seed]\n", argv[0]);
+			return opt == 'h' ? 0 : 1;
+		}
+	}
+	if (test.max_piece == 0 || test.max_piece > RING_TEST_MAX_PIECE) {
+		test.max_piece = RING_TEST_MAX_PIECE;
+	}
+
+	test.rb = ameba_spsc_ring_create(capacity);
+	if (!test.rb) {
+		printf("ring create fail\n");
+		return 1;
+	}
+	if ((uintptr_t)test.rb % MAX_CACHE_LINE_SIZE) {
+		printf("ring header %p is not cache line aligned\n", (void *)test.rb);
+		test.errors++;
+	}
+
+	if (rtos_sema_create(&test.sema, 0, RTOS_SEMA_MAX_COUNT) != SUCCESS) {
+		printf("sema create fail\n");
+		return 1;
+	}
+
+	pthread_create(&writer, NULL, ring_test_writer, &test);
+	pthread_create(&reader, NULL, ring_test_reader, &test);
+	pthread_join(writer, NULL);
+	pthread_join(reader, NULL);
+
+	if (ameba_spsc_ring_available(test.rb) != 0) {
+		printf("%lu bytes left in the ring\n", (unsigned long)ameba_spsc_ring_available(test.rb));
+		test.errors++;
+	}
+	//pieces up to max_piece against a smaller ring, the writer has to sleep on a full one.
+	if (test.max_piece * 2 > ameba_spsc_ring_capacity(test.rb) && test.wakeups == 0) {
+		printf("the writer never slept on a full ring\n");
+		test.errors++;
+	}
+	printf("capacity:%lu bytes:%llu peek reads:%llu writer wakeups:%llu errors:%llu\n",
+		   (unsigned long)ameba_spsc_ring_capacity(test.rb), (unsigned long long)test.done,
+		   (unsigned long long)test.peeks, (unsigned long long)test.wakeups, (unsigned long long)test.errors);
+	rtos_sema_delete(test.sema);
+	ameba_spsc_ring_destroy(test.rb);
+
+	return test.errors ? 1 : 0;
+}
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * drives the unmodified amebalite stream engine on the simulated sport/gdma:
+ * a writer thread feeds ameba_audio_stream_tx_write, an optional reader thread
+ * drains ameba_audio_stream_rx_read, and the gdma/sport interrupts are raised
+ * by the simulation timer thread. With -z both sides go through the zero copy
+ * acquire/commit region calls instead. With -b it runs the cache bench of the
+ * noirq tx ring instead.
+ */
+
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ameba.h"
+#include "os_wrapper.h"
+#include "audio_hw_types.h"
+#include "ameba_audio_types.h"
+#include "ameba_audio_stream.h"
+#include "ameba_audio_stream_render.h"
+#include "ameba_audio_stream_capture.h"
+#include "ameba_audio_stream_control.h"
+#include "ameba_audio_drift.h"
+
+#include "ameba_audio_sim.h"
+
+typedef struct {
+	uint32_t rate;
+	uint32_t channels;
+	uint32_t period_size;
+	uint32_t period_count;
+	uint32_t mode;
+	uint32_t write_frames;
+	uint32_t stall_us;
+	uint32_t seconds;
+	uint32_t drift_ms;
+	bool capture;
+	bool zero_copy;
+	uint32_t cache_period_bytes;
+	uint32_t cache_period_count;
+	AudioSimConfig sim;
+} BenchArgs;
+
+typedef struct {
+	uint64_t calls;
+	uint64_t bytes;
+	uint64_t total_ns;
+	uint64_t max_ns;
+} BenchCallStats;
+
+typedef struct {
+	BenchArgs *args;
+	Stream *stream;
+	volatile bool running;
+	BenchCallStats stats;
+	AudioDrift drift;
+} BenchThread;
+
+static void bench_usage(const char *name)
+{
+	printf("usage: %s [-r rate] [-c channels] [-p period_size] [-n period_count] [-m irq|noirq]\n"
+		   "          [-w write_frames] [-s stall_us] [-t seconds] [-j irq_jitter_us] [-x clock_ppm]\n"
+		   "          [-k tick_us] [-d drift_target_ms] [-R] [-z] [-v]\n"
+		   "       %s -b period_bytes,period_count\n", name, name);
+}
+
+static void bench_call_done(BenchCallStats *stats, uint64_t start_ns, int32_t bytes)
+{
+	uint64_t cost = rtos_time_get_current_system_time_ns() - start_ns;
+
+	stats->calls++;
+	stats->total_ns += cost;
+	if (cost > stats->max_ns) {
+		stats->max_ns = cost;
+	}
+	if (bytes > 0) {
+		stats->bytes += bytes;
+	}
+}
+
+/* what PrimaryStreamOutWrite does with drift_target_ms set. */
+static void bench_drift_compensate(BenchThread *bt)
+{
+	int64_t counted_frames = ameba_audio_stream_tx_get_frames_written(bt->stream) - ameba_audio_stream_tx_sport_rendered_frames(bt->stream);
+	int64_t ring_frames = ameba_audio_stream_buffer_get_remain_size(bt->stream->rbuffer) / bt->stream->frame_size;
+	float ppm;
+
+	if (!ameba_audio_drift_update(&bt->drift, counted_frames, ring_frames, bt->stream->period_bytes / bt->stream->frame_size) ||
+		!ameba_audio_drift_claim_pll(&bt->drift)) {
+		return;
+	}
+
+	ppm = bt->drift.ppm;
+	if (ppm >= 0) {
+		ppm = ameba_audio_ctl_pll_clock_tune(ameba_audio_get_ctl(), bt->args->rate, ppm, PLL_FASTER);
+	} else {
+		ppm = -ameba_audio_ctl_pll_clock_tune(ameba_audio_get_ctl(), bt->args->rate, -ppm, PLL_SLOWER);
+	}
+	ameba_audio_drift_applied(&bt->drift, ppm);
+}
+
+static void bench_fill(int16_t *buf, uint32_t samples, uint32_t *phase)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		buf[i] = (int16_t)((*phase)++ * 64);
+	}
+}
+
+/* what a source writing by AcquireBuffer/CommitBuffer does: it renders into the ring in place. */
+static int32_t bench_write_region(BenchThread *bt, uint32_t bytes, uint32_t *phase)
+{
+	uint32_t period_us = (uint64_t)bt->args->period_size * 1000000 / bt->args->rate;
+	uint32_t done = 0;
+	void *region;
+	int32_t ret;
+
+	while (done < bytes && bt->running) {
+		ret = ameba_audio_stream_tx_acquire_region(bt->stream, &region, bytes - done);
+		if (ret < 0) {
+			return done ? (int32_t)done : ret;
+		}
+		if (ret == 0) {
+			//ring full, wait for the gdma to take a part of a period.
+			rtos_time_delay_us(period_us / 4);
+			continue;
+		}
+		bench_fill((int16_t *)region, ret / 2, phase);
+		ret = ameba_audio_stream_tx_commit_region(bt->stream, ret);
+		if (ret < 0) {
+			return done ? (int32_t)done : ret;
+		}
+		done += ret;
+	}
+
+	return done;
+}
+
+static void *bench_writer(void *param)
+{
+	BenchThread *bt = (BenchThread *)param;
+	uint32_t frame_bytes = bt->args->channels * 2;
+	uint32_t bytes = bt->args->write_frames * frame_bytes;
+	int16_t *buf = (int16_t *)calloc(1, bytes);
+	uint32_t phase = 0;
+	uint64_t next_ns = rtos_time_get_current_system_time_ns();
+
+	while (bt->running) {
+		uint64_t start_ns;
+
+		//drift test: the source runs on the host clock like a bt/usb stream, not on the sport.
+		if (bt->args->drift_ms) {
+			uint64_t now_ns = rtos_time_get_current_system_time_ns();
+			next_ns += (uint64_t)bt->args->write_frames * 1000000000ULL / bt->args->rate;
+			if (next_ns > now_ns) {
+				rtos_time_delay_us((next_ns - now_ns) / 1000);
+			}
+		}
+
+		if (bt->args->zero_copy) {
+			start_ns = rtos_time_get_current_system_time_ns();
+			bench_call_done(&bt->stats, start_ns, bench_write_region(bt, bytes, &phase));
+		} else {
+			bench_fill(buf, bytes / 2, &phase);
+			start_ns = rtos_time_get_current_system_time_ns();
+			bench_call_done(&bt->stats, start_ns, ameba_audio_stream_tx_write(bt->stream, buf, bytes, true));
+		}
+		if (bt->args->drift_ms) {
+			bench_drift_compensate(bt);
+		}
+		if (bt->args->stall_us) {
+			rtos_time_delay_us(bt->args->stall_us);
+		}
+	}
+
+	free(buf);
+	return NULL;
+}
+
+static void *bench_reader(void *param)
+{
+	BenchThread *bt = (BenchThread *)param;
+	uint32_t bytes = bt->args->period_size * bt->args->channels * 2;
+	uint8_t *buf = (uint8_t *)calloc(1, bytes);
+
+	while (bt->running) {
+		uint64_t start_ns = rtos_time_get_current_system_time_ns();
+		int32_t ret;
+		void *region;
+
+		if (bt->args->zero_copy) {
+			//the data is consumed in place, a region stops at the ring end so it may be short.
+			ret = ameba_audio_stream_rx_acquire_region(bt->stream, &region, bytes, 1000);
+			if (ret > 0) {
+				ret = ameba_audio_stream_rx_commit_region(bt->stream, ret);
+			}
+		} else {
+			ret = ameba_audio_stream_rx_read(bt->stream, buf, bytes);
+		}
+		bench_call_done(&bt->stats, start_ns, ret);
+	}
+
+	free(buf);
+	return NULL;
+}
+
+static void bench_print_calls(const char *name, BenchCallStats *stats, uint32_t frame_bytes, double seconds)
+{
+	if (!stats->calls) {
+		printf("%s: no calls\n", name);
+		return;
+	}
+
+	printf("%s: %llu calls, %.1f frames/s, avg %.1f us, max %.1f us\n", name,
+		   (unsigned long long)stats->calls, stats->bytes / frame_bytes / seconds,
+		   stats->total_ns / 1000.0 / stats->calls, stats->max_ns / 1000.0);
+}
+
+static void bench_print_stream_stats(const char *name, Stream *stream)
+{
+	struct AudioHwStreamStats stats;
+	char str[AMEBA_AUDIO_STREAM_STATS_STR_LEN];
+
+	ameba_audio_stream_stats_get(&stream->stats, &stats);
+	ameba_audio_stream_stats_to_str(&stats, str, sizeof(str));
+	printf("%s stats: %s\n", name, str);
+}
+
+/* the old noirq write: clean invalidate a period for each write, and the whole ring when wrap. */
+static void bench_cache_write_legacy(AudioBuffer *buffer, const void *data, size_t bytes, uint32_t period_bytes)
+{
+	size_t capacity = buffer->capacity;
+
+	if (bytes <= capacity - buffer->write_ptr) {
+		memcpy(buffer->raw_data + buffer->write_ptr, data, bytes);
+		DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data + buffer->write_ptr, period_bytes + CACHE_LINE_SIZE);
+		buffer->write_ptr += bytes;
+		if (buffer->write_ptr == capacity) {
+			buffer->write_ptr = 0;
+		}
+	} else {
+		size_t size_1 = capacity - buffer->write_ptr;
+		memcpy(buffer->raw_data + buffer->write_ptr, data, size_1);
+		memcpy(buffer->raw_data, (const uint8_t *)data + size_1, bytes - size_1);
+		DCache_CleanInvalidate((uint32_t)(uintptr_t)buffer->raw_data, (uint32_t)capacity + CACHE_LINE_SIZE);
+		buffer->write_ptr = bytes - size_1;
+	}
+}
+
+/*
+ * writes a noirq ring of period_bytes * period_count with 64 bytes up to period_bytes each
+ * time, and prints the cache maintenance calls and the time per write of the old way, the
+ * per write line clean and the deferred clean of ameba_audio_stream_buffer_write_in_noirq_mode.
+ */
+static int bench_cache(uint32_t period_bytes, uint32_t period_count)
+{
+	const char *mode_name[3] = {"legacy", "clean", "defer"};
+	uint32_t total = period_bytes * period_count * 8;
+	AudioSimStats sim_stats;
+	AudioBuffer *buffer;
+	uint8_t *data;
+	uint32_t bytes;
+	uint32_t mode;
+	uint32_t written;
+	uint64_t start_ns;
+	uint64_t cost_ns;
+
+	buffer = ameba_audio_stream_buffer_create();
+	if (!buffer) {
+		return 1;
+	}
+	ameba_audio_stream_buffer_alloc(buffer, period_bytes * period_count);
+	data = (uint8_t *)calloc(1, period_bytes);
+	if (!buffer->raw_data || !data) {
+		free(data);
+		ameba_audio_stream_buffer_release(buffer);
+		return 1;
+	}
+
+	printf("cache bench: period %lu bytes x %lu\n", (unsigned long)period_bytes, (unsigned long)period_count);
+	for (bytes = 64; bytes <= period_bytes; bytes <<= 1) {
+		for (mode = 0; mode < 3; mode++) {
+			ameba_audio_stream_buffer_flush(buffer);
+			buffer->cache_defer = (mode == 2);
+			ameba_audio_sim_reset_stats();
+			start_ns = rtos_time_get_current_system_time_ns();
+			for (written = 0; written < total; written += bytes) {
+				if (mode == 0) {
+					bench_cache_write_legacy(buffer, data, bytes, period_bytes);
+				} else {
+					ameba_audio_stream_buffer_write_in_noirq_mode(buffer, data, bytes, period_bytes);
+				}
+				//nobody consumes the ring here.
+				buffer->size_remain = 0;
+			}
+			ameba_audio_stream_buffer_sync_cache(buffer);
+			cost_ns = rtos_time_get_current_system_time_ns() - start_ns;
+			ameba_audio_sim_get_stats(&sim_stats);
+			printf("%-6s write %5lu bytes: %lu writes, cache ops %llu (%llu bytes), %.1f ns per write\n",
+				   mode_name[mode], (unsigned long)bytes, (unsigned long)(total / bytes),
+				   (unsigned long long)sim_stats.cache_ops, (unsigned long long)sim_stats.cache_bytes,
+				   (double)cost_ns / (total / bytes));
+		}
+	}
+
+	free(data);
+	ameba_audio_stream_buffer_release(buffer);
+	return 0;
+}
+
+static int bench_parse_args(int argc, char **argv, BenchArgs *args)
+{
+	char *end;
+	int opt;
+
+	memset(args, 0, sizeof(BenchArgs));
+	args->rate = 48000;
+	args->channels = 2;
+	args->period_size = 256;
+	args->period_count = 4;
+	args->mode = AMEBA_AUDIO_DMA_IRQ_MODE;
+	args->write_frames = 256;
+	args->seconds = 5;
+	ameba_audio_sim_get_default_config(&args->sim);
+
+	while ((opt = getopt(argc, argv, "r:c:p:n:m:w:s:t:j:x:k:d:b:Rzvh")) != -1) {
+		switch (opt) {
+		case 'r':
+			args->rate = strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			args->channels = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			args->period_size = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			args->period_count = strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			args->mode = strcmp(optarg, "noirq") ? AMEBA_AUDIO_DMA_IRQ_MODE : AMEBA_AUDIO_DMA_NOIRQ_MODE;
+			break;
+		case 'w':
+			args->write_frames = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			args->stall_us = strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			args->seconds = strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			args->sim.irq_jitter_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'x':
+			args->sim.clock_ppm = strtol(optarg, NULL, 0);
+			break;
+		case 'k':
+			args->sim.tick_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			args->drift_ms = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			args->cache_period_bytes = strtoul(optarg, &end, 0);
+			args->cache_period_count = *end == ',' ? strtoul(end + 1, NULL, 0) : 0;
+			if (args->cache_period_bytes == 0 || args->cache_period_count == 0) {
+				return -1;
+			}
+			break;
+		case 'R':
+			args->capture = true;
+			break;
+		case 'z':
+			args->zero_copy = true;
+			break;
+		case 'v':
+			ameba_audio_sim_set_log_level(RTK_LOG_INFO);
+			break;
+		default:
+			return -1;
+		}
+	}
+
+	//noirq mode copies into the ring itself, the stream refuses regions.
+	if (args->zero_copy && args->mode == AMEBA_AUDIO_DMA_NOIRQ_MODE) {
+		printf("-z needs irq mode\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	BenchArgs args;
+	StreamConfig config;
+	BenchThread tx = {0};
+	BenchThread rx = {0};
+	pthread_t tx_thread;
+	pthread_t rx_thread;
+	AudioSimStats sim_stats;
+	uint64_t rendered_frames = 0;
+	struct timespec tstamp;
+	uint64_t start_ns;
+	double seconds;
+
+	if (bench_parse_args(argc, argv, &args) != 0) {
+		bench_usage(argv[0]);
+		return 1;
+	}
+
+	if (args.cache_period_bytes) {
+		return bench_cache(args.cache_period_bytes, args.cache_period_count);
+	}
+
+	memset(&config, 0, sizeof(StreamConfig));
+	config.channels = args.channels;
+	config.format = AUDIO_HW_FORMAT_PCM_16_BIT;
+	config.rate = args.rate;
+	config.frame_size = args.channels * 2;
+	config.period_size = args.period_size;
+	config.period_count = args.period_count;
+	config.mode = args.mode;
+
+	ameba_audio_sim_start(&args.sim);
+
+	tx.args = &args;
+	ameba_audio_drift_init(&tx.drift, args.rate, false, args.drift_ms);
+	tx.stream = ameba_audio_stream_tx_init(AMEBA_AUDIO_DEVICE_SPEAKER, config);
+	if (!tx.stream) {
+		printf("tx init fail\n");
+		return 1;
+	}
+
+	if (args.capture) {
+		rx.args = &args;
+		rx.stream = ameba_audio_stream_rx_init(AMEBA_AUDIO_IN_I2S, config);
+		if (!rx.stream) {
+			printf("rx init fail\n");
+			return 1;
+		}
+		ameba_audio_stream_rx_start(rx.stream);
+	}
+
+	ameba_audio_sim_reset_stats();
+	start_ns = rtos_time_get_current_system_time_ns();
+	tx.running = true;
+	pthread_create(&tx_thread, NULL, bench_writer, &tx);
+	if (args.capture) {
+		rx.running = true;
+		pthread_create(&rx_thread, NULL, bench_reader, &rx);
+	}
+
+	rtos_time_delay_ms(args.seconds * 1000);
+
+	ameba_audio_stream_tx_get_position(tx.stream, &rendered_frames, &tstamp);
+	seconds = (rtos_time_get_current_system_time_ns() - start_ns) / 1e9;
+	ameba_audio_sim_get_stats(&sim_stats);
+
+	tx.running = false;
+	rx.running = false;
+	pthread_join(tx_thread, NULL);
+	if (args.capture) {
+		pthread_join(rx_thread, NULL);
+	}
+
+	printf("config: rate %lu, channels %lu, period %lu x %lu, %s, jitter %lu us, ppm %ld, tick %lu us\n",
+		   (unsigned long)args.rate, (unsigned long)args.channels, (unsigned long)args.period_size,
+		   (unsigned long)args.period_count, args.mode == AMEBA_AUDIO_DMA_NOIRQ_MODE ? "noirq" : "irq",
+		   (unsigned long)args.sim.irq_jitter_us, (long)args.sim.clock_ppm, (unsigned long)args.sim.tick_us);
+	bench_print_calls(args.zero_copy ? "tx_region" : "tx_write", &tx.stats, config.frame_size, seconds);
+	if (args.capture) {
+		bench_print_calls(args.zero_copy ? "rx_region" : "rx_read", &rx.stats, config.frame_size, seconds);
+	}
+	printf("sport: tx %llu frames, rx %llu frames, rendered %llu frames, expected %.0f\n",
+		   (unsigned long long)sim_stats.tx_frames, (unsigned long long)sim_stats.rx_frames,
+		   (unsigned long long)rendered_frames, seconds * args.rate);
+	printf("xrun: tx underflow %llu frames, rx overflow %llu frames\n",
+		   (unsigned long long)sim_stats.tx_underflow_frames, (unsigned long long)sim_stats.rx_overflow_frames);
+	printf("irq: gdma %llu (latency avg %.1f us, max %.1f us), sport %llu, cache ops %llu (%llu bytes)\n",
+		   (unsigned long long)sim_stats.gdma_irqs,
+		   sim_stats.gdma_irqs ? sim_stats.irq_latency_total_ns / 1000.0 / sim_stats.gdma_irqs : 0.0,
+		   sim_stats.irq_latency_max_ns / 1000.0, (unsigned long long)sim_stats.sport_irqs,
+		   (unsigned long long)sim_stats.cache_ops, (unsigned long long)sim_stats.cache_bytes);
+	bench_print_stream_stats("tx", tx.stream);
+	if (args.drift_ms) {
+		char str[AMEBA_AUDIO_DRIFT_STR_LEN];
+		ameba_audio_drift_to_str(&tx.drift, str, sizeof(str));
+		printf("tx drift: %s\n", str);
+	}
+	if (args.capture) {
+		bench_print_stream_stats("rx", rx.stream);
+	}
+
+	if (args.capture) {
+		ameba_audio_stream_rx_close(rx.stream);
+	}
+	ameba_audio_stream_tx_close(tx.stream);
+	ameba_audio_sim_stop();
+
+	return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * channel reorder kernels against a byte by byte reference of the c fallback: every
+ * channel layout up to 8 + 8 channels, 1 to 4 byte samples, frame counts around the
+ * neon block sizes and buffers at 0/1/2 byte offsets, so that the neon, the 16/32bit
+ * c and the byte kernels all run. Bytes past the end of dst must stay untouched.
+ * Built once with the kernels of the host and once with the neon kernels.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "audio_hw_channel_utils.h"
+
+#define CHANNEL_TEST_MAX_CHANNELS 8
+#define CHANNEL_TEST_MAX_BYTES    4
+#define CHANNEL_TEST_GUARD        16
+#define CHANNEL_TEST_BUF_BYTES    (40 * 2 * CHANNEL_TEST_MAX_CHANNELS * CHANNEL_TEST_MAX_BYTES + CHANNEL_TEST_GUARD + 8)
+
+static const uint32_t g_test_frames[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 40};
+
+typedef struct {
+	uint8_t src[CHANNEL_TEST_BUF_BYTES];
+	uint8_t extra_src[CHANNEL_TEST_BUF_BYTES];
+	uint8_t dst[CHANNEL_TEST_BUF_BYTES];
+	uint8_t extra_dst[CHANNEL_TEST_BUF_BYTES];
+	uint8_t ref[CHANNEL_TEST_BUF_BYTES];
+	uint8_t extra_ref[CHANNEL_TEST_BUF_BYTES];
+	uint64_t cases;
+	uint64_t errors;
+} ChannelTest;
+
+static void ref_remap(uint8_t *dst, uint32_t dst_channels, const uint8_t *src, uint32_t src_channels,
+					  uint32_t keep_channels, uint32_t frames, uint32_t sample_bytes)
+{
+	uint32_t i;
+	uint32_t b;
+
+	for (i = 0; i < frames; i++) {
+		for (b = 0; b < dst_channels * sample_bytes; b++) {
+			dst[i * dst_channels * sample_bytes + b] = b < keep_channels * sample_bytes ?
+					src[i * src_channels * sample_bytes + b] : 0;
+		}
+	}
+}
+
+static void ref_deinterleave(uint8_t *dst, uint32_t dst_channels, uint8_t *extra_dst, uint32_t extra_channels,
+							 const uint8_t *src, uint32_t frames, uint32_t sample_bytes)
+{
+	uint32_t dst_bytes = dst_channels * sample_bytes;
+	uint32_t extra_bytes = extra_channels * sample_bytes;
+	uint32_t i;
+	uint32_t b;
+
+	for (i = 0; i < frames; i++) {
+		for (b = 0; b < dst_bytes; b++) {
+			dst[i * dst_bytes + b] = src[i * (dst_bytes + extra_bytes) + b];
+		}
+		for (b = 0; b < extra_bytes; b++) {
+			extra_dst[i * extra_bytes + b] = src[i * (dst_bytes + extra_bytes) + dst_bytes + b];
+		}
+	}
+}
+
+static void ref_interleave(uint8_t *dst, const uint8_t *src, uint32_t src_channels, const uint8_t *extra_src,
+						   uint32_t extra_channels, uint32_t frames, uint32_t sample_bytes)
+{
+	uint32_t src_bytes = src_channels * sample_bytes;
+	uint32_t extra_bytes = extra_channels * sample_bytes;
+	uint32_t i;
+	uint32_t b;
+
+	for (i = 0; i < frames; i++) {
+		for (b = 0; b < src_bytes; b++) {
+			dst[i * (src_bytes + extra_bytes) + b] = src[i * src_bytes + b];
+		}
+		for (b = 0; b < extra_bytes; b++) {
+			dst[i * (src_bytes + extra_bytes) + src_bytes + b] = extra_src[i * extra_bytes + b];
+		}
+	}
+}
+
+static void channel_test_fill(ChannelTest *test)
+{
+	uint32_t seed = 1;
+	uint32_t i;
+
+	for (i = 0; i < CHANNEL_TEST_BUF_BYTES; i++) {
+		seed = seed * 1103515245 + 12345;
+		test->src[i] = (uint8_t)(seed >> 16);
+		test->extra_src[i] = (uint8_t)(seed >> 8);
+	}
+}
+
+static void channel_test_reset(ChannelTest *test)
+{
+	memset(test->dst, 0xa5, sizeof(test->dst));
+	memset(test->ref, 0xa5, sizeof(test->ref));
+	memset(test->extra_dst, 0x5a, sizeof(test->extra_dst));
+	memset(test->extra_ref, 0x5a, sizeof(test->extra_ref));
+}
+
+static void channel_test_compare(ChannelTest *test, const char *what, uint32_t a, uint32_t b, uint32_t c,
+								 uint32_t frames, uint32_t sample_bytes, uint32_t offset)
+{
+	test->cases++;
+	if (memcmp(test->dst, test->ref, sizeof(test->dst)) == 0 &&
+		memcmp(test->extra_dst, test->extra_ref, sizeof(test->extra_dst)) == 0) {
+		return;
+	}
+	if (test->errors++ < 8) {
+		printf("%s mismatch: channels %u/%u/%u, frames:%u, sample_bytes:%u, offset:%u\n", what, (unsigned)a,
+			   (unsigned)b, (unsigned)c, (unsigned)frames, (unsigned)sample_bytes, (unsigned)offset);
+	}
+}
+
+static void channel_test_remap(ChannelTest *test, uint32_t frames, uint32_t sample_bytes, uint32_t offset)
+{
+	uint8_t *dst = test->dst + offset;
+	uint8_t *ref = test->ref + offset;
+	const uint8_t *src = test->src + offset;
+	uint32_t src_channels;
+	uint32_t dst_channels;
+	uint32_t keep;
+
+	for (src_channels = 1; src_channels <= CHANNEL_TEST_MAX_CHANNELS; src_channels++) {
+		for (dst_channels = 1; dst_channels <= CHANNEL_TEST_MAX_CHANNELS; dst_channels++) {
+			for (keep = 0; keep <= src_channels && keep <= dst_channels; keep++) {
+				channel_test_reset(test);
+				audio_hw_channel_remap(dst, dst_channels, src, src_channels, keep, frames, sample_bytes);
+				ref_remap(ref, dst_channels, src, src_channels, keep, frames, sample_bytes);
+				channel_test_compare(test, "remap", src_channels, dst_channels, keep, frames, sample_bytes, offset);
+
+				channel_test_reset(test);
+				audio_hw_channel_insert_zero(dst, dst_channels, src, src_channels, keep, frames, sample_bytes);
+				ref_remap(ref, dst_channels, src, src_channels, keep, frames, sample_bytes);
+				channel_test_compare(test, "insert_zero", src_channels, dst_channels, keep, frames, sample_bytes, offset);
+			}
+			if (dst_channels <= src_channels) {
+				channel_test_reset(test);
+				audio_hw_channel_drop(dst, dst_channels, src, src_channels, frames, sample_bytes);
+				ref_remap(ref, dst_channels, src, src_channels, dst_channels, frames, sample_bytes);
+				channel_test_compare(test, "drop", src_channels, dst_channels, dst_channels, frames, sample_bytes, offset);
+			}
+		}
+	}
+}
+
+static void channel_test_split_merge(ChannelTest *test, uint32_t frames, uint32_t sample_bytes, uint32_t offset)
+{
+	uint32_t channels;
+	uint32_t extra_channels;
+
+	for (channels = 1; channels <= CHANNEL_TEST_MAX_CHANNELS; channels++) {
+		for (extra_channels = 1; extra_channels <= CHANNEL_TEST_MAX_CHANNELS; extra_channels++) {
+			channel_test_reset(test);
+			audio_hw_channel_deinterleave(test->dst + offset, channels, test->extra_dst + offset, extra_channels,
+										  test->src + offset, frames, sample_bytes);
+			ref_deinterleave(test->ref + offset, channels, test->extra_ref + offset, extra_channels,
+							 test->src + offset, frames, sample_bytes);
+			channel_test_compare(test, "deinterleave", channels, extra_channels, 0, frames, sample_bytes, offset);
+
+			channel_test_reset(test);
+			audio_hw_channel_interleave(test->dst + offset, test->src + offset, channels, test->extra_src + offset,
+										extra_channels, frames, sample_bytes);
+			ref_interleave(test->ref + offset, test->src + offset, channels, test->extra_src + offset,
+						   extra_channels, frames, sample_bytes);
+			channel_test_compare(test, "interleave", channels, extra_channels, 0, frames, sample_bytes, offset);
+		}
+	}
+}
+
+int main(void)
+{
+	static ChannelTest test;
+	uint32_t sample_bytes;
+	uint32_t offset;
+	uint32_t i;
+
+	channel_test_fill(&test);
+	for (sample_bytes = 1; sample_bytes <= CHANNEL_TEST_MAX_BYTES; sample_bytes++) {
+		for (offset = 0; offset <= 2; offset++) {
+			for (i = 0; i < sizeof(g_test_frames) / sizeof(g_test_frames[0]); i++) {
+				channel_test_remap(&test, g_test_frames[i], sample_bytes, offset);
+				channel_test_split_merge(&test, g_test_frames[i], sample_bytes, offset);
+			}
+		}
+	}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	printf("kernels:neon cases:%llu errors:%llu\n", (unsigned long long)test.cases, (unsigned long long)test.errors);
+#else
+	printf("kernels:c cases:%llu errors:%llu\n", (unsigned long long)test.cases, (unsigned long long)test.errors);
+#endif
+
+	return test.errors ? 1 : 0;
+}
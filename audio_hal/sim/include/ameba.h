@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_H
+
+/*
+ * Host replacement of the soc header for the simulated audio backend.
+ * It only carries what the amebalite stream engine needs, the peripherals
+ * behind these declarations are emulated in ameba_audio_sim.c.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "basic_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* cache */
+#define CACHE_LINE_SIZE                 32
+
+void DCache_Clean(u32 Address, u32 Bytes);
+void DCache_Invalidate(u32 Address, u32 Bytes);
+void DCache_CleanInvalidate(u32 Address, u32 Bytes);
+
+/* log */
+enum {
+	RTK_LOG_NONE    = 0,
+	RTK_LOG_ERROR   = 1,
+	RTK_LOG_WARN    = 2,
+	RTK_LOG_INFO    = 3,
+	RTK_LOG_DEBUG   = 4,
+	RTK_LOG_ALWAYS  = 5,
+};
+
+void rtk_log_write(int level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+void DiagPrintf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#define RTK_LOGE(tag, ...)              rtk_log_write(RTK_LOG_ERROR, tag, __VA_ARGS__)
+#define RTK_LOGW(tag, ...)              rtk_log_write(RTK_LOG_WARN, tag, __VA_ARGS__)
+#define RTK_LOGI(tag, ...)              rtk_log_write(RTK_LOG_INFO, tag, __VA_ARGS__)
+#define RTK_LOGD(tag, ...)              rtk_log_write(RTK_LOG_DEBUG, tag, __VA_ARGS__)
+#define RTK_LOGA(tag, ...)              rtk_log_write(RTK_LOG_ALWAYS, tag, __VA_ARGS__)
+#define RTK_LOGS(tag, ...)              rtk_log_write(RTK_LOG_ALWAYS, tag, __VA_ARGS__)
+
+/* irq */
+typedef u32(*IRQ_FUN)(void *Data);
+
+enum {
+	SPORT0_IRQ      = 0,
+	SPORT1_IRQ      = 1,
+	SIM_IRQ_NUM     = 2,
+};
+
+bool InterruptRegister(IRQ_FUN IrqFun, int32_t IrqNum, u32 Data, u32 Priority);
+bool InterruptUnRegister(int32_t IrqNum);
+void InterruptEn(int32_t IrqNum, u32 Priority);
+void InterruptDis(int32_t IrqNum);
+
+/* register access */
+#define HAL_READ32(base, addr)          (*((volatile u32 *)((uintptr_t)(base) + (addr))))
+#define HAL_WRITE32(base, addr, value)  ((*((volatile u32 *)((uintptr_t)(base) + (addr)))) = (value))
+
+extern u32 sim_pinmux_regs[64];
+#define PINMUX_REG_BASE                 ((uintptr_t)sim_pinmux_regs)
+#define REG_I2S_CTRL                    0x0
+#define PAD_BIT_SP0_DIO0_MUXSEL         BIT(0)
+#define PAD_BIT_SP0_DIO1_MUXSEL         BIT(1)
+#define PAD_BIT_SP0_DIO2_MUXSEL         BIT(2)
+#define PAD_BIT_SP0_DIO3_MUXSEL         BIT(3)
+#define PAD_BIT_SP1_DIO0_MUXSEL         BIT(4)
+#define PAD_BIT_SP1_DIO1_MUXSEL         BIT(5)
+#define PAD_BIT_SP1_DIO2_MUXSEL         BIT(6)
+#define PAD_BIT_SP1_DIO3_MUXSEL         BIT(7)
+
+/* pinmux and gpio */
+enum {
+	PINMUX_FUNCTION_GPIO = 0,
+	PINMUX_FUNCTION_I2S0_MCLK,
+	PINMUX_FUNCTION_I2S0_BCLK,
+	PINMUX_FUNCTION_I2S0_WS,
+	PINMUX_FUNCTION_I2S0_DIO0,
+	PINMUX_FUNCTION_I2S0_DIO1,
+	PINMUX_FUNCTION_I2S0_DIO2,
+	PINMUX_FUNCTION_I2S0_DIO3,
+	PINMUX_FUNCTION_I2S1_MCLK,
+	PINMUX_FUNCTION_I2S1_BCLK,
+	PINMUX_FUNCTION_I2S1_WS,
+	PINMUX_FUNCTION_I2S1_DIO0,
+	PINMUX_FUNCTION_I2S1_DIO1,
+	PINMUX_FUNCTION_I2S1_DIO2,
+	PINMUX_FUNCTION_I2S1_DIO3,
+	PINMUX_FUNCTION_DMIC_CLK,
+	PINMUX_FUNCTION_DMIC_DATA0,
+	PINMUX_FUNCTION_DMIC_DATA1,
+};
+
+#define _PB_0                           0x20
+#define _PB_1                           0x21
+#define _PB_2                           0x22
+
+typedef struct {
+	u32 GPIO_Pin;
+	u32 GPIO_Mode;
+	u32 GPIO_PuPd;
+	u32 GPIO_ITTrigger;
+	u32 GPIO_ITPolarity;
+	u32 GPIO_ITDebounce;
+} GPIO_InitTypeDef;
+
+#define GPIO_Mode_IN                    0
+#define GPIO_Mode_OUT                   1
+#define GPIO_PuPd_NOPULL                0
+
+void Pinmux_Config(u8 PinName, u32 PinFunc);
+void GPIO_Init(GPIO_InitTypeDef *GPIO_InitStruct);
+void GPIO_WriteBit(u32 GPIO_Pin, u32 Pin_State);
+
+/* clock */
+enum {
+	CKSL_I2S_XTAL40M = 0,
+	CKSL_I2S_CPUPLL,
+	CKSL_I2S_DSPPLL,
+};
+
+#define APBPeriph_SPORT0                0
+#define APBPeriph_SPORT1                1
+#define APBPeriph_AC                    2
+#define APBPeriph_AC_AIP                3
+#define APBPeriph_CLOCK_NULL            0xFF
+#define APBPeriph_SPORT0_CLOCK          0
+#define APBPeriph_SPORT1_CLOCK          1
+#define APBPeriph_AC_CLOCK              2
+#define CKSL_AC_XTAL                    0
+#define CKSL_AC_SYSPLL                  1
+
+void RCC_PeriphClockCmd(u32 APBPeriph, u32 APBPeriph_Clock, u8 NewState);
+void RCC_PeriphClockSource_SPORT(u32 Source);
+void RCC_PeriphClockSource_AUDIOCODEC(u32 Source);
+void PLL_I2S_98P304M(u32 Source, u32 NewState);
+void PLL_I2S_45P158M(u32 Source, u32 NewState);
+float PLL_I2S_98P304M_ClkTune(u32 Source, float ppm, u32 action);
+float PLL_I2S_45P158M_ClkTune(u32 Source, float ppm, u32 action);
+bool TrustZone_IsSecure(void);
+u32 SystemGetCpuClk(void);
+
+#define PLL_AUTO                        0
+#define PLL_FASTER                      1
+#define PLL_SLOWER                      2
+
+#include "ameba_audio_sim_gdma.h"
+#include "ameba_audio_sim_sport.h"
+#include "ameba_audio_sim_codec.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
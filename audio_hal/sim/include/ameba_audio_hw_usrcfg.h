@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_HW_USRCFG_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_HW_USRCFG_H
+
+/*
+ * board configuration of the simulated backend, see the usrcfg of each soc
+ * for the meaning of the items.
+ */
+
+#define AUDIO_HW_AMPLIFIER_TYPE         AMP_DUMMY
+#define AUDIO_HW_AMPLIFIER_CONTROL_ENABLE 0
+#define AUDIO_HW_AMPLIFIER_PIN          _PB_0
+#define AUDIO_HW_AMPLIFIER_ENABLE_TIME  0
+#define AUDIO_HW_AMPLIFIER_DISABLE_TIME 0
+#define AUDIO_HW_AMPLIFIER_MUTE_ENABLE  0
+
+#define AUDIO_HW_DMIC_CLK_PIN           _PB_1
+#define AUDIO_HW_DMIC_DATA0_PIN         _PB_2
+#define AUDIO_HW_DMIC_DATA1_PIN         _PB_2
+#define AUDIO_HW_DMIC_STEADY_TIME       0
+
+#define AUDIO_HW_OUT_SPORT_CLK_TYPE     0
+#define AUDIO_HW_IN_SPORT_CLK_TYPE      0
+#define AUDIO_HW_MAX_SPORT_IRQ_X        0x7FFF
+
+#define AUDIO_I2S_OUT_SPORT_INDEX       1
+#define AUDIO_I2S_OUT_MULTIIO_EN        0
+#define AUDIO_I2S_OUT_DATA_FORMAT       SP_DF_I2S
+#define AUDIO_I2S_OUT_MCLK_PIN          _PB_0
+#define AUDIO_I2S_OUT_BCLK_PIN          _PB_0
+#define AUDIO_I2S_OUT_LRCLK_PIN         _PB_0
+#define AUDIO_I2S_OUT_DATA0_PIN         _PB_0
+#define AUDIO_I2S_OUT_DATA1_PIN         _PB_0
+#define AUDIO_I2S_OUT_DATA2_PIN         _PB_0
+#define AUDIO_I2S_OUT_DATA3_PIN         _PB_0
+
+#define AUDIO_I2S_MASTER                0
+#define AUDIO_I2S_SLAVE                 1
+
+#define AUDIO_I2S_IN_SPORT_INDEX        1
+#define AUDIO_I2S_IN_ROLE               AUDIO_I2S_MASTER
+#define AUDIO_I2S_IN_MULTIIO_EN         0
+#define AUDIO_I2S_IN_DATA_FORMAT        SP_DF_I2S
+#define AUDIO_I2S_IN_MCLK_PIN           _PB_0
+#define AUDIO_I2S_IN_BCLK_PIN           _PB_0
+#define AUDIO_I2S_IN_LRCLK_PIN          _PB_0
+#define AUDIO_I2S_IN_DATA0_PIN          _PB_0
+#define AUDIO_I2S_IN_DATA1_PIN          _PB_0
+#define AUDIO_I2S_IN_DATA2_PIN          _PB_0
+#define AUDIO_I2S_IN_DATA3_PIN          _PB_0
+
+#define AUDIO_OUT_DEBUG_BUFFER_LEVEL    0
+
+#endif
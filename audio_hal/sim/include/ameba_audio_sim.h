@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_H
+
+/*
+ * host simulation of the sport/gdma pair the audio hal drives.
+ *
+ * a timer thread moves frames at the configured sample rate, copies them
+ * between the gdma blocks and the sink/source callbacks, and raises the gdma
+ * and sport counter interrupts. interrupts run on the timer thread while it
+ * holds the simulated irq lock, rtos_critical_enter and GDMA_INTConfig mask
+ * them like on target.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+	/* period of the timer thread, frames are moved in chunks of this length. */
+	uint32_t tick_us;
+	/* a gdma interrupt is delivered up to this much later than its block end. */
+	uint32_t irq_jitter_us;
+	/* sport clock error against the host clock, in ppm. */
+	int32_t clock_ppm;
+	uint32_t seed;
+} AudioSimConfig;
+
+typedef struct {
+	uint64_t tx_frames;
+	uint64_t rx_frames;
+	uint64_t tx_dma_blocks;
+	uint64_t rx_dma_blocks;
+	/* frames the sport sent or received without a gdma block behind them. */
+	uint64_t tx_underflow_frames;
+	uint64_t rx_overflow_frames;
+	uint64_t gdma_irqs;
+	uint64_t sport_irqs;
+	/* time from block end to the gdma callback, in ns. */
+	uint64_t irq_latency_max_ns;
+	uint64_t irq_latency_total_ns;
+	uint64_t cache_ops;
+	uint64_t cache_bytes;
+} AudioSimStats;
+
+/*
+ * sink gets every chunk the tx sport shifts out, source fills every chunk the
+ * rx sport shifts in. gdma_id is 0 for the internal gdma and 1 for the external
+ * one of a tdm stream. both run on the timer thread.
+ */
+typedef void (*AudioSimTxSink)(void *user, uint32_t index, uint32_t gdma_id, const uint8_t *data, uint32_t bytes);
+typedef void (*AudioSimRxSource)(void *user, uint32_t index, uint32_t gdma_id, uint8_t *data, uint32_t bytes);
+
+void ameba_audio_sim_get_default_config(AudioSimConfig *config);
+int ameba_audio_sim_start(const AudioSimConfig *config);
+void ameba_audio_sim_stop(void);
+
+void ameba_audio_sim_set_tx_sink(AudioSimTxSink sink, void *user);
+void ameba_audio_sim_set_rx_source(AudioSimRxSource source, void *user);
+
+void ameba_audio_sim_get_stats(AudioSimStats *stats);
+void ameba_audio_sim_reset_stats(void);
+
+/* trims the rate of all sports, what the *_ClkTune calls do on target. */
+void ameba_audio_sim_set_pll_ppm(float ppm);
+
+/* RTK_LOG_* level printed by the hal logs, warnings by default. */
+void ameba_audio_sim_set_log_level(int level);
+
+void ameba_audio_sim_irq_lock(void);
+void ameba_audio_sim_irq_unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_CODEC_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * the codec has no timing role in the simulation, the settings are only
+ * accepted so that the control paths of the stream engine run as on target.
+ */
+
+enum {
+	I2S0 = 0,
+	I2S1 = 1,
+};
+
+enum {
+	DAC_L = 0,
+	DAC_R = 1,
+};
+
+enum {
+	ADC1 = 0, ADC2, ADC3, ADC4, ADC5,
+};
+
+enum {
+	ADCHN1 = 0, ADCHN2, ADCHN3, ADCHN4, ADCHN5,
+};
+
+enum {
+	AMIC1 = 0, AMIC2, AMIC3, AMIC4, AMIC5,
+};
+
+enum {
+	DMIC1 = 0, DMIC2, DMIC3, DMIC4, DMIC5, DMIC6, DMIC7, DMIC8,
+};
+
+enum {
+	MICBST_GAIN_0DB = 0, MICBST_GAIN_5DB, MICBST_GAIN_10DB, MICBST_GAIN_15DB, MICBST_GAIN_20DB,
+	MICBST_GAIN_25DB, MICBST_GAIN_30DB, MICBST_GAIN_35DB, MICBST_GAIN_40DB,
+};
+
+#define SR_8K                           8000
+#define SR_11P025K                      11025
+#define SR_16K                          16000
+#define SR_22P05K                       22050
+#define SR_24K                          24000
+#define SR_32K                          32000
+#define SR_44P1K                        44100
+#define SR_48K                          48000
+#define SR_88P2K                        88200
+#define SR_96K                          96000
+#define SR_192K                         192000
+
+#define WL_8                            8
+#define WL_16                           16
+#define WL_24                           24
+
+#define I2S_NOTDM                       0
+#define I2S_TDM4                        4
+#define I2S_TDM6                        6
+#define I2S_TDM8                        8
+
+#define MUTE                            1
+#define UNMUTE                          0
+#define POWER_ON                        1
+#define POWER_OFF                       0
+#define NORMALPOWER                     0
+#define LOWPOWER                        1
+#define DIFF                            0
+#define SINGLE                          1
+
+#define PAD_DACL                        0
+#define PAD_DACR                        1
+#define PAD_MIC1                        2
+#define PAD_MIC2                        3
+#define PAD_MIC3                        4
+#define DACPATH                         0
+#define ADCPATH                         1
+#define ANAAD                           0
+#define DMIC                            1
+#define DACIN                           0
+#define MICIN                           1
+#define SOURCE0                         0
+#define SOURCE1                         1
+#define I2SL                            0
+#define I2SR                            1
+#define ZDET_STEP                       1
+#define DMIC_5M                         0
+#define DMIC_2P5M                       1
+#define DMIC_1P25M                      2
+#define DMIC_769P2K                     3
+#define INTERNAL_SPORT                  0
+#define EXTERNAL_I2S                    1
+
+#define APP_AMIC_RECORD                 BIT(0)
+#define APP_DMIC_RECORD                 BIT(1)
+#define APP_LINE_IN_RECORD              BIT(2)
+#define APP_LINE_OUT                    BIT(3)
+#define APP_I2S_RECORD                  BIT(4)
+
+typedef struct {
+	u32 CODEC_SelI2STxSR;
+	u32 CODEC_SelI2STxWordLen;
+	u32 CODEC_SelI2STxCHLen;
+	u32 CODEC_SelI2STxDataFormat;
+	u32 CODEC_SelI2STxCh;
+	u32 CODEC_SelTxI2STdm;
+	u32 CODEC_SelI2SRxSR;
+	u32 CODEC_SelI2SRxWordLen;
+	u32 CODEC_SelI2SRxCHLen;
+	u32 CODEC_SelI2SRxDataFormat;
+	u32 CODEC_SelI2SRxCh;
+	u32 CODEC_SelRxI2STdm;
+} I2S_InitTypeDef;
+
+typedef struct {
+	volatile u32 AUD_ADDA_CTL;
+	volatile u32 AUD_LO_CTL;
+	volatile u32 AUD_MICBIAS_CTL0;
+	volatile u32 AUD_MICBST_CTL0;
+	volatile u32 AUD_MICBST_CTL1;
+	volatile u32 RSVD0;
+	volatile u32 AUD_DTS_CTL;
+	volatile u32 AUD_MBIAS_CTL0;
+	volatile u32 AUD_MBIAS_CTL1;
+	volatile u32 AUD_MBIAS_CTL2;
+} AUD_TypeDef;
+
+typedef struct {
+	volatile u32 CODEC_ADC_x_CONTROL_0;
+	volatile u32 CODEC_ADC_x_CONTROL_1;
+} CODEC_ADC_CH_CTRL_TypeDef;
+
+typedef struct {
+	volatile u32 CODEC_AUDIO_CONTROL_0;
+	volatile u32 CODEC_AUDIO_CONTROL_1;
+	volatile u32 CODEC_CLOCK_CONTROL_1;
+	volatile u32 CODEC_CLOCK_CONTROL_2;
+	volatile u32 CODEC_CLOCK_CONTROL_3;
+	volatile u32 CODEC_CLOCK_CONTROL_4;
+	volatile u32 CODEC_CLOCK_CONTROL_5;
+	volatile u32 CODEC_CLOCK_CONTROL_6;
+	volatile u32 CODEC_CLOCK_CONTROL_7;
+	volatile u32 CODEC_I2S_0_CONTROL;
+	volatile u32 CODEC_I2S_0_CONTROL_1;
+	CODEC_ADC_CH_CTRL_TypeDef CODEC_ADC_CH_CTRL[8];
+	volatile u32 CODEC_DAC_L_CONTROL_0;
+	volatile u32 CODEC_DAC_L_CONTROL_1;
+	volatile u32 CODEC_DAC_L_CONTROL_2;
+} AUDIO_TypeDef;
+
+extern AUD_TypeDef sim_aud_regs;
+extern AUDIO_TypeDef sim_audio_regs;
+#define AUD_SYS_BASE                    (&sim_aud_regs)
+#define AUDIO_REG_BASE                  (&sim_audio_regs)
+#define AUDIO_REG_BASE_S                (&sim_audio_regs)
+
+void AUDIO_CODEC_I2S_StructInit(I2S_InitTypeDef *I2S_initstruct);
+void AUDIO_CODEC_SetI2SIP(u32 i2s_sel, u32 NewState);
+void AUDIO_CODEC_SetI2SSRC(u32 i2s_sel, u32 src);
+void AUDIO_CODEC_SetI2SParameters(u32 i2s_sel, u32 path, I2S_InitTypeDef *I2S_Params);
+void AUDIO_CODEC_Playback(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct);
+void AUDIO_CODEC_Record(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct);
+void AUDIO_CODEC_SetAudioIP(u32 NewState);
+void AUDIO_CODEC_SetANAClk(u32 NewState);
+void AUDIO_CODEC_SetLDOMode(u32 powermode);
+void AUDIO_CODEC_DisPAD(u32 path);
+void AUDIO_CODEC_EnableDAC(u32 channel, u32 NewState);
+void AUDIO_CODEC_EnableDACFifo(u32 NewState);
+void AUDIO_CODEC_SetDACSrc(u32 i2s_sel, u32 dac_l_src, u32 dac_r_src);
+void AUDIO_CODEC_SetDACSRSrc(u32 src, u32 sr);
+void AUDIO_CODEC_SetDACASRC(u32 sr, u32 NewState);
+void AUDIO_CODEC_SetDACHPF(u32 channel, u32 NewState);
+void AUDIO_CODEC_SetDACMute(u32 channel, u32 Mute);
+void AUDIO_CODEC_SetDACPowerMode(u32 channel, u32 powermode);
+void AUDIO_CODEC_SetDACVolume(u32 channel, u32 Gain);
+void AUDIO_CODEC_SetDACZDET(u32 channel, u32 type);
+void AUDIO_CODEC_SetDACZDETTimeOut(u32 channel, u32 TimeOut);
+void AUDIO_CODEC_SetLineOutMode(u32 channel, u32 mode);
+void AUDIO_CODEC_SetLineOutMute(u32 channel, u32 type, u32 NewState);
+void AUDIO_CODEC_SetLineOutPowerMode(u32 channel, u32 powermode);
+void AUDIO_CODEC_EnableADC(u32 ad_chn, u32 NewState);
+void AUDIO_CODEC_EnableADCFifo(u32 ad_chn, u32 NewState);
+void AUDIO_CODEC_EnableADCForMask(u32 ad_chn_mask);
+void AUDIO_CODEC_EnableADCFifoForMask(u32 ad_chn_mask);
+void AUDIO_CODEC_SetADCANAFilter(u32 adc_sel, u32 NewState);
+void AUDIO_CODEC_SetADCANASrc(u32 ad_chn, u32 amic_num);
+void AUDIO_CODEC_SetADCDmicFilter(u32 adc_num, u32 NewState);
+void AUDIO_CODEC_SetADCHPF(u32 adc_sel, u32 fc, u32 NewState);
+void AUDIO_CODEC_SetADCMixMute(u32 adc_num, u32 type, u32 newstate);
+void AUDIO_CODEC_SetADCMute(u32 adc_sel, u32 newstate);
+void AUDIO_CODEC_SetADCSRSrc(u32 src, u32 sr);
+void AUDIO_CODEC_SetADCVolume(u32 adc_sel, u32 gain);
+void AUDIO_CODEC_SetDmicClk(u32 clk, u32 NewState);
+void AUDIO_CODEC_SetDmicSrc(u32 ad_chn, u32 dmic_num);
+void AUDIO_CODEC_SetMicBiasPowerMode(u32 powermode);
+void AUDIO_CODEC_SetMicBstChnMute(u32 amic_sel, u32 type, u32 newstate);
+void AUDIO_CODEC_SetMicBstGain(u32 amic_sel, u32 gain);
+void AUDIO_CODEC_SetMicBstInputMode(u32 amic_num, u32 mode);
+void AUDIO_CODEC_SetMicBstPowerMode(u32 amic_num, u32 powermode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_GDMA_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_GDMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_GDMA_CH_NUM                 8
+
+#define TransferType                    BIT(0)
+#define BlockType                       BIT(1)
+#define ErrType                         BIT(4)
+
+typedef struct {
+	u32 GDMA_DIR;
+	u32 GDMA_DstDataWidth;
+	u32 GDMA_SrcDataWidth;
+	u32 GDMA_DstInc;
+	u32 GDMA_SrcInc;
+	u32 GDMA_DstMsize;
+	u32 GDMA_SrcMsize;
+	u32 GDMA_SrcAddr;
+	u32 GDMA_DstAddr;
+	u32 GDMA_BlockSize;
+	u32 GDMA_IsrType;
+	u32 GDMA_ReloadSrc;
+	u32 GDMA_ReloadDst;
+	u32 GDMA_LlpDstEn;
+	u32 GDMA_LlpSrcEn;
+	u32 GDMA_SrcHandshakeInterface;
+	u32 GDMA_DstHandshakeInterface;
+	u8 GDMA_Index;
+	u8 GDMA_ChNum;
+	u8 GDMA_Priority;
+	u32 SecureTransfer;
+} GDMA_InitTypeDef, *PGDMA_InitTypeDef;
+
+struct GDMA_CH_LLI_ELE {
+	u32 Sarx;
+	u32 Darx;
+	u32 Llpx;
+	u32 CtlxLow;
+	u32 CtlxUp;
+	u32 Temp;
+};
+
+struct GDMA_CH_LLI {
+	struct GDMA_CH_LLI_ELE LliEle;
+	struct GDMA_CH_LLI *pNextLli;
+	u32 BlockSize;
+};
+
+typedef struct {
+	volatile u32 SAR;
+	volatile u32 DAR;
+	volatile u32 LLP;
+	volatile u32 CTL_LOW;
+	volatile u32 CTL_HIGH;
+	volatile u32 CFG_LOW;
+	volatile u32 CFG_HIGH;
+} GDMA_ChannelTypeDef;
+
+typedef struct {
+	GDMA_ChannelTypeDef CH[SIM_GDMA_CH_NUM];
+	volatile u32 ChEnReg;
+	volatile u32 MASK_TFR;
+	volatile u32 MASK_BLOCK;
+	volatile u32 MASK_ERR;
+	volatile u32 STATUS_BLOCK;
+} GDMA_TypeDef;
+
+extern GDMA_TypeDef sim_gdma_regs;
+#define GDMA_BASE                       (&sim_gdma_regs)
+
+void GDMA_INTConfig(u8 GDMA_Index, u8 GDMA_ChNum, u32 GDMA_IT, u32 NewState);
+u32 GDMA_ClearINT(u8 GDMA_Index, u8 GDMA_ChNum);
+void GDMA_Cmd(u8 GDMA_Index, u8 GDMA_ChNum, u32 NewState);
+bool GDMA_ChnlFree(u8 GDMA_Index, u8 GDMA_ChNum);
+void GDMA_Abort(u8 GDMA_Index, u8 GDMA_ChNum);
+u32 GDMA_GetSrcAddr(u8 GDMA_Index, u8 GDMA_ChNum);
+u32 GDMA_GetDstAddr(u8 GDMA_Index, u8 GDMA_ChNum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
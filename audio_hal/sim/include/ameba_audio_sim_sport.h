@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_SPORT_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_AMEBA_AUDIO_SIM_SPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_SPORT_NUM                   2
+
+/*
+ * the simulated sport paces the streams with these values, so rates and word
+ * lengths carry their real numbers instead of register codes.
+ */
+#define SP_8K                           8000
+#define SP_11P025K                      11025
+#define SP_12K                          12000
+#define SP_16K                          16000
+#define SP_22P05K                       22050
+#define SP_24K                          24000
+#define SP_32K                          32000
+#define SP_44P1K                        44100
+#define SP_48K                          48000
+#define SP_88P2K                        88200
+#define SP_96K                          96000
+#define SP_176P4K                       176400
+#define SP_192K                         192000
+
+#define SP_TXWL_16                      16
+#define SP_TXWL_20                      20
+#define SP_TXWL_24                      24
+#define SP_TXWL_32                      32
+#define SP_RXWL_16                      16
+#define SP_RXWL_20                      20
+#define SP_RXWL_24                      24
+#define SP_RXWL_32                      32
+
+#define SP_CH_STEREO                    0
+#define SP_CH_MONO                      1
+
+#define SP_TX_NOTDM                     0
+#define SP_TX_TDM4                      4
+#define SP_TX_TDM6                      6
+#define SP_TX_TDM8                      8
+#define SP_RX_NOTDM                     0
+#define SP_RX_TDM4                      4
+#define SP_RX_TDM6                      6
+#define SP_RX_TDM8                      8
+
+#define SP_TX_FIFO2                     2
+#define SP_TX_FIFO4                     4
+#define SP_TX_FIFO6                     6
+#define SP_TX_FIFO8                     8
+#define SP_RX_FIFO2                     2
+#define SP_RX_FIFO4                     4
+#define SP_RX_FIFO6                     6
+#define SP_RX_FIFO8                     8
+
+#define SP_DF_I2S                       0
+#define SP_DF_LEFT                      1
+#define SP_DF_PCM_A                     2
+#define SP_DF_PCM_B                     3
+
+#define SP_TX_MULTIIO_DIS               0
+#define SP_TX_MULTIIO_EN                1
+#define SP_RX_MULTIIO_DIS               0
+#define SP_RX_MULTIIO_EN                1
+
+#define SP_DIR_TX                       1
+#define SP_DIR_RX                       2
+
+#define MASTER                          0
+#define SLAVE                           1
+
+#define GDMA_INT                        0
+#define GDMA_EXT                        1
+
+enum {
+	TXCHN0 = 0, TXCHN1, TXCHN2, TXCHN3, TXCHN4, TXCHN5, TXCHN6, TXCHN7,
+};
+
+enum {
+	RXCHN0 = 0, RXCHN1, RXCHN2, RXCHN3, RXCHN4, RXCHN5, RXCHN6, RXCHN7,
+};
+
+enum {
+	DIRECT_OUT_CHN0 = 0, DIRECT_OUT_CHN1, DIRECT_OUT_CHN2, DIRECT_OUT_CHN3,
+	DIRECT_OUT_CHN4, DIRECT_OUT_CHN5, DIRECT_OUT_CHN6, DIRECT_OUT_CHN7,
+};
+
+enum {
+	DIRECT_IN_CHN0 = 0, DIRECT_IN_CHN1, DIRECT_IN_CHN2, DIRECT_IN_CHN3,
+	DIRECT_IN_CHN4, DIRECT_IN_CHN5, DIRECT_IN_CHN6, DIRECT_IN_CHN7,
+};
+
+enum {
+	DIRECT_REG_0 = 0, DIRECT_REG_1, DIRECT_REG_2, DIRECT_REG_3,
+	DIRECT_REG_4, DIRECT_REG_5, DIRECT_REG_6, DIRECT_REG_7,
+};
+
+typedef struct {
+	u32 SP_SelDataFormat;
+	u32 SP_SelWordLen;
+	u32 SP_SelChLen;
+	u32 SP_SelI2SMonoStereo;
+	u32 SP_SelTDM;
+	u32 SP_SelFIFO;
+	u32 SP_SetMultiIO;
+	u32 SP_SR;
+	u32 SP_SelClk;
+	u32 SP_Fix_Bclk;
+	u32 SP_Bclk;
+} SP_InitTypeDef;
+
+typedef struct {
+	volatile u32 SP_REG_MUX;
+	volatile u32 SP_CTRL0;
+	volatile u32 SP_CTRL1;
+	volatile u32 SP_INT_CTRL;
+	volatile u32 RSVD0;
+	volatile u32 SP_TRX_COUNTER_STATUS;
+	volatile u32 SP_ERR;
+	volatile u32 SP_SR_TX_BCLK;
+	volatile u32 SP_TX_LRCLK;
+	volatile u32 SP_FIFO_CTRL;
+	volatile u32 SP_FORMAT;
+	volatile u32 SP_RX_BCLK;
+	volatile u32 SP_RX_LRCLK;
+	volatile u32 SP_DSP_COUNTER;
+	volatile u32 RSVD1;
+	volatile u32 SP_DIRECT_CTRL0;
+	volatile u32 RSVD2;
+	volatile u32 SP_FIFO_IRQ;
+	volatile u32 SP_DIRECT_CTRL1;
+	volatile u32 SP_DIRECT_CTRL2;
+	volatile u32 RSVD3;
+	volatile u32 SP_DIRECT_CTRL3;
+	volatile u32 SP_DIRECT_CTRL4;
+	volatile u32 SP_RX_COUNTER1;
+	volatile u32 SP_RX_COUNTER2;
+	volatile u32 SP_TX_FIFO_0_WR_ADDR;
+	volatile u32 SP_RX_FIFO_0_RD_ADDR;
+	volatile u32 SP_TX_FIFO_1_WR_ADDR;
+	volatile u32 SP_RX_FIFO_1_RD_ADDR;
+} AUDIO_SPORT_TypeDef;
+
+#define SP_BIT_TX_DISABLE               BIT(1)
+#define SP_BIT_START_TX                 BIT(2)
+#define SP_BIT_RX_DISABLE               BIT(3)
+#define SP_BIT_START_RX                 BIT(4)
+
+typedef struct {
+	AUDIO_SPORT_TypeDef *SPORTx;
+	u32 Tx_HandshakeInterface;
+	u32 Rx_HandshakeInterface;
+} AUDIO_DevTable;
+
+extern AUDIO_SPORT_TypeDef sim_sport_regs[SIM_SPORT_NUM];
+extern const AUDIO_DevTable AUDIO_DEV_TABLE[SIM_SPORT_NUM];
+
+#define AUDIO_SPORT0_DEV                (&sim_sport_regs[0])
+#define AUDIO_SPORT1_DEV                (&sim_sport_regs[1])
+#define SPORT0_REG_BASE                 ((u32)(uintptr_t)&sim_sport_regs[0])
+#define SPORT1_REG_BASE                 ((u32)(uintptr_t)&sim_sport_regs[1])
+
+void AUDIO_SP_StructInit(SP_InitTypeDef *SP_InitStruct);
+void AUDIO_SP_Init(u32 index, u32 direction, SP_InitTypeDef *SP_InitStruct);
+void AUDIO_SP_Deinit(u32 index, u32 direction);
+void AUDIO_SP_Reset(u32 index);
+void AUDIO_SP_SetMasterSlave(u32 index, u32 role);
+void AUDIO_SP_TXStart(u32 index, u32 NewState);
+void AUDIO_SP_RXStart(u32 index, u32 NewState);
+void AUDIO_SP_DmaCmd(u32 index, u32 NewState);
+void AUDIO_SP_TXSetFifo(u32 index, u32 fifo_num, u32 NewState);
+void AUDIO_SP_RXSetFifo(u32 index, u32 fifo_num, u32 NewState);
+
+bool AUDIO_SP_TXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+						  IRQ_FUN CallbackFunc, u8 *pTxData, u32 Length);
+bool AUDIO_SP_RXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+						  IRQ_FUN CallbackFunc, u8 *pRxData, u32 Length);
+bool AUDIO_SP_TXGDMA_Restart(u8 GDMA_Index, u8 GDMA_ChNum, u32 tx_addr, u32 tx_length);
+bool AUDIO_SP_RXGDMA_Restart(u8 GDMA_Index, u8 GDMA_ChNum, u32 rx_addr, u32 rx_length);
+bool AUDIO_SP_LLPTXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+							 IRQ_FUN CallbackFunc, u32 Length, u32 MaxLLP, struct GDMA_CH_LLI *Lli);
+bool AUDIO_SP_LLPRXGDMA_Init(u32 Index, u32 SelGDMA, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
+							 IRQ_FUN CallbackFunc, u32 Length, u32 MaxLLP, struct GDMA_CH_LLI *Lli);
+
+void AUDIO_SP_SetTXCounter(u32 index, u32 state);
+void AUDIO_SP_SetRXCounter(u32 index, u32 state);
+void AUDIO_SP_SetTXCounterCompVal(u32 index, u32 comp_val);
+void AUDIO_SP_SetRXCounterCompVal(u32 index, u32 comp_val);
+u32 AUDIO_SP_GetTXCounterVal(u32 index);
+u32 AUDIO_SP_GetRXCounterVal(u32 index);
+void AUDIO_SP_SetPhaseLatch(u32 index);
+u32 AUDIO_SP_GetTXPhaseVal(u32 index);
+u32 AUDIO_SP_GetRXPhaseVal(u32 index);
+void AUDIO_SP_ClearTXCounterIrq(u32 index);
+void AUDIO_SP_ClearRXCounterIrq(u32 index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_BASIC_TYPES_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_BASIC_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+
+#ifndef TRUE
+#define TRUE                            1
+#endif
+#ifndef FALSE
+#define FALSE                           0
+#endif
+
+#define ENABLE                          1
+#define DISABLE                         0
+
+#define SUCCESS                         0
+#define FAIL                            (-1)
+#define RTK_SUCCESS                     0
+#define RTK_FAIL                        (-1)
+
+#ifndef BIT
+#define BIT(x)                          ((u32)1 << (x))
+#endif
+
+#ifndef MIN
+#define MIN(a, b)                       (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b)                       (((a) > (b)) ? (a) : (b))
+#endif
+
+#define _memset                         memset
+#define _memcpy                         memcpy
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_I2C_API_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_I2C_API_H
+
+#include "ameba.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int PinName;
+
+typedef struct i2c_s {
+	u32 i2c_idx;
+} i2c_t;
+
+void i2c_init(i2c_t *obj, PinName sda, PinName scl);
+void i2c_frequency(i2c_t *obj, int hz);
+int i2c_read(i2c_t *obj, int address, char *data, int length, int stop);
+int i2c_write(i2c_t *obj, int address, const char *data, int length, int stop);
+void i2c_reset(i2c_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_OS_WRAPPER_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_INCLUDE_OS_WRAPPER_H
+
+/*
+ * rtos wrapper of the simulated backend, implemented on posix threads in
+ * ameba_audio_sim_os.c.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "basic_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTOS_MAX_TIMEOUT                0xFFFFFFFFUL
+#define RTOS_MAX_DELAY                  0xFFFFFFFFUL
+#define RTOS_SEMA_MAX_COUNT             0xFFFFFFFFUL
+#define MUTEX_WAIT_TIMEOUT              0xFFFFFFFFUL
+
+#define RTOS_CRITICAL_AUDIO             0
+
+typedef void *rtos_sema_t;
+typedef void *rtos_mutex_t;
+typedef void *rtos_task_t;
+
+/*
+ * memory from these calls lies in the low 4GB of the address space, the hal
+ * passes dma addresses around as u32 like on target.
+ */
+void *rtos_mem_malloc(uint32_t size);
+void *rtos_mem_zmalloc(uint32_t size);
+void *rtos_mem_calloc(uint32_t count, uint32_t size);
+void *rtos_mem_realloc(void *pbuf, uint32_t size);
+void rtos_mem_free(void *pbuf);
+
+int rtos_sema_create(rtos_sema_t *pp_handle, uint32_t init_count, uint32_t max_count);
+int rtos_sema_create_binary(rtos_sema_t *pp_handle);
+int rtos_sema_delete(rtos_sema_t p_handle);
+int rtos_sema_take(rtos_sema_t p_handle, uint32_t wait_ms);
+int rtos_sema_give(rtos_sema_t p_handle);
+
+int rtos_mutex_create(rtos_mutex_t *pp_handle);
+int rtos_mutex_delete(rtos_mutex_t p_handle);
+int rtos_mutex_take(rtos_mutex_t p_handle, uint32_t wait_ms);
+int rtos_mutex_give(rtos_mutex_t p_handle);
+
+/*
+ * a critical section masks the simulated interrupts, like disabling irq on target.
+ */
+void rtos_critical_enter(uint32_t component_id);
+void rtos_critical_exit(uint32_t component_id);
+
+int rtos_task_create(rtos_task_t *pp_handle, const char *p_name, void (*p_routine)(void *),
+					 void *p_param, uint16_t stack_size_in_byte, uint16_t priority);
+int rtos_task_delete(rtos_task_t p_handle);
+
+void rtos_time_delay_ms(uint32_t ms);
+void rtos_time_delay_us(uint32_t us);
+uint32_t rtos_time_get_current_system_time_ms(void);
+uint64_t rtos_time_get_current_system_time_us(void);
+uint64_t rtos_time_get_current_system_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * plain c version of the neon intrinsics used by audio_hw_channel_utils.c, so the
+ * neon kernels build and run on a host without neon. Lane order and the element
+ * (de)interleave of vldN/vstN follow the arm definitions.
+ */
+
+#ifndef AMEBA_AUDIO_AUDIO_HAL_SIM_NEON_ARM_NEON_H
+#define AMEBA_AUDIO_AUDIO_HAL_SIM_NEON_ARM_NEON_H
+
+#include <stdint.h>
+
+typedef struct {
+	uint16_t lane[8];
+} uint16x8_t;
+
+typedef struct {
+	uint32_t lane[4];
+} uint32x4_t;
+
+#define SIM_NEON_TYPES(base)                                                      \
+	typedef struct { base##_t val[2]; } base##x2_t;                               \
+	typedef struct { base##_t val[3]; } base##x3_t;                               \
+	typedef struct { base##_t val[4]; } base##x4_t;
+
+SIM_NEON_TYPES(uint16x8)
+SIM_NEON_TYPES(uint32x4)
+
+#define SIM_NEON_LDST(suffix, base, elem, lanes, count)                             \
+	static inline base##x##count##_t vld##count##q_##suffix(const elem *ptr)      \
+	{                                                                             \
+		base##x##count##_t r;                                                     \
+		int l, v;                                                                 \
+		for (l = 0; l < lanes; l++) {                                             \
+			for (v = 0; v < count; v++) {                                         \
+				r.val[v].lane[l] = ptr[l * count + v];                            \
+			}                                                                     \
+		}                                                                         \
+		return r;                                                                 \
+	}                                                                             \
+	static inline void vst##count##q_##suffix(elem *ptr, base##x##count##_t r)    \
+	{                                                                             \
+		int l, v;                                                                 \
+		for (l = 0; l < lanes; l++) {                                             \
+			for (v = 0; v < count; v++) {                                         \
+				ptr[l * count + v] = r.val[v].lane[l];                            \
+			}                                                                     \
+		}                                                                         \
+	}
+
+#define SIM_NEON_VEC(suffix, base, elem, lanes)                                    \
+	static inline base##_t vdupq_n_##suffix(elem value)                           \
+	{                                                                             \
+		base##_t r;                                                               \
+		int l;                                                                    \
+		for (l = 0; l < lanes; l++) {                                             \
+			r.lane[l] = value;                                                    \
+		}                                                                         \
+		return r;                                                                 \
+	}                                                                             \
+	static inline base##_t vld1q_##suffix(const elem *ptr)                        \
+	{                                                                             \
+		base##_t r;                                                               \
+		int l;                                                                    \
+		for (l = 0; l < lanes; l++) {                                             \
+			r.lane[l] = ptr[l];                                                   \
+		}                                                                         \
+		return r;                                                                 \
+	}                                                                             \
+	static inline void vst1q_##suffix(elem *ptr, base##_t r)                      \
+	{                                                                             \
+		int l;                                                                    \
+		for (l = 0; l < lanes; l++) {                                             \
+			ptr[l] = r.lane[l];                                                   \
+		}                                                                         \
+	}                                                                             \
+	SIM_NEON_LDST(suffix, base, elem, lanes, 2)                                   \
+	SIM_NEON_LDST(suffix, base, elem, lanes, 3)                                   \
+	SIM_NEON_LDST(suffix, base, elem, lanes, 4)
+
+SIM_NEON_VEC(u16, uint16x8, uint16_t, 8)
+SIM_NEON_VEC(u32, uint32x4, uint32_t, 4)
+
+#endif
@@ -33,6 +33,13 @@ struct UsbAudioHwCard {
     struct UsbAudioHwStreamIn *input;
 };
 
+/*
+ * Implemented by the usb host glue when its uac class driver exposes the feedback endpoint:
+ * the rate the dac really plays at in Hz Q16.16. Returns HAL_OSAL_OK, the default returns
+ * HAL_OSAL_ERR_NOT_SUPPORT and the output only follows its ring fill.
+ */
+int32_t usb_audio_hal_get_feedback_rate(uint32_t *rate_q16);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
  */
 
 #include <inttypes.h>
+#include <string.h>
 
 #include "os_wrapper.h"
 #include "usbh_composite_uac1.h"
@@ -23,6 +24,8 @@
 #include "audio_hw_osal_errnos.h"
 #include "audio_hw_debug.h"
 #include "audio_hw_params_handle.h"
+#include "ameba_audio_drift.h"
+#include "ameba_spsc_ring.h"
 
 #include "hardware/audio/audio_hw_types.h"
 #include "hardware/audio/audio_hw_utils.h"
@@ -37,7 +40,17 @@
 #define DUMP_FRAME                192000
 #define DUMP_ENABLE               0
 
-#define DELAY_START              "delay_start"
+//one usb transfer, the sender task hands the host this much per usbh_composite_uac_write.
+#define USB_OUT_PERIOD_MS         8
+//periods the ring between Write and the sender holds.
+#define USB_OUT_PERIOD_COUNT      4
+#define USB_OUT_WRITE_TIMEOUT_MS  200
+#define USB_OUT_TASK_STACK        (1024 * 4)
+#ifndef USB_OUT_TASK_PRIORITY
+#define USB_OUT_TASK_PRIORITY     6
+#endif
+//limit of feedback and fill corrections together, a dac further off than this is broken.
+#define USB_OUT_MAX_PPM           1000.0f
 
 struct UsbAudioHwStreamOut {
     struct AudioHwStreamOut stream;
@@ -56,6 +69,36 @@ struct UsbAudioHwStreamOut {
     uint16_t sequence;
     uint64_t written;
     bool delay_start;
+
+    //pcm from UsbStreamOutWrite to the sender task, one writer and one reader.
+    ring_buffer_header *rb;
+    uint32_t rb_size;
+    //writer sleeps on rb_sem only when the ring is full, the sender gives it when rb_waiting is set.
+    rtos_sema_t rb_sem;
+    volatile uint32_t rb_waiting;
+    //given by the writer after each write, the sender waits on it while the ring is short.
+    rtos_sema_t data_sem;
+    rtos_sema_t exit_sem;
+    volatile bool running;
+
+    size_t frame_size;
+    uint32_t period_frames;
+    //one usb transfer, and the source frames it is resampled from, see UsbStreamOutResample.
+    uint8_t *period_buf;
+    uint8_t *src_buf;
+    uint32_t src_frames;
+
+    //source frames the usb host has taken, and the time its last transfer completed.
+    uint64_t consumed;
+    int64_t consumed_ns;
+    uint32_t underruns;
+    uint32_t write_errors;
+
+    //rate adaptation: each output frame advances the source by step, both in Q32 frames.
+    AudioDrift drift;
+    uint64_t step;
+    uint64_t phase;
+    uint32_t feedback_rate;
 };
 
 static inline size_t UsbAudioHwStreamOutFrameSize(const struct AudioHwStreamOut *s)
@@ -64,7 +107,8 @@ static inline size_t UsbAudioHwStreamOutFrameSize(const struct AudioHwStreamOut
     enum AudioHwFormat format = s->common.GetFormat(&s->common);
 
     if (AudioIsLinearPCM(format)) {
-        chan_samp_sz = GetAudioBytesPerSample(format);
+        //float pcm is resampled as is, it is not in the common sample size table.
+        chan_samp_sz = format == AUDIO_HW_FORMAT_PCM_FLOAT ? sizeof(float) : GetAudioBytesPerSample(format);
         size_t frame_size = s->common.GetChannels(&s->common) * chan_samp_sz;
         HAL_AUDIO_VERBOSE("Stream out frame size:%d", frame_size);
         return frame_size;
@@ -90,12 +134,8 @@ static size_t UsbGetStreamOutBufferSize(const struct AudioHwStream *stream)
 {
     struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
 
-    int32_t chan_samp_sz;
-    enum AudioHwFormat format = out->format;
-
-    chan_samp_sz = GetAudioBytesPerSample(format);
-    size_t frame_size = out->channel_count * chan_samp_sz;
-    return 256 * frame_size;
+    //one usb transfer, writes of this size keep the ring topped up a period at a time.
+    return out->period_frames * out->frame_size;
 }
 
 static uint32_t UsbGetStreamOutChannels(const struct AudioHwStream *stream)
@@ -127,11 +167,229 @@ static int32_t UsbSetStreamOutFormat(struct AudioHwStream *stream, enum AudioHwF
     return HAL_OSAL_OK;
 }
 
+static int64_t UsbStreamOutNowNs(void)
+{
+    return (int64_t)rtos_time_get_current_system_time_us() * 1000LL;
+}
+
+/*
+ * rate the usb dac really plays at, in Hz Q16.16, from the feedback endpoint of an asynchronous
+ * uac sink. The usb host glue overrides it when its class driver exposes the feedback value,
+ * without it the stream follows the ring fill when a drift target is set.
+ * This weak one reports no feedback, and the drift target is 0 until SetParameter sets
+ * AUDIO_HW_PARAM_DRIFT_TARGET_MS, so by default the dac is fed at the nominal rate.
+ * Set a target only for a source on its own clock(bt), one paced by Write blocking(a
+ * decoder) keeps the ring full and would be played up to USB_OUT_MAX_PPM fast.
+ */
+__attribute__((weak)) int32_t usb_audio_hal_get_feedback_rate(uint32_t *rate_q16)
+{
+    (void) rate_q16;
+    return HAL_OSAL_ERR_NOT_SUPPORT;
+}
+
+/* sender side, source frames per output frame from the feedback rate and the fill correction. */
+static void UsbStreamOutUpdateStep(struct UsbAudioHwStreamOut *out)
+{
+    uint32_t rate_q16 = 0;
+    float ppm = out->drift.applied_ppm;
+
+    if (usb_audio_hal_get_feedback_rate(&rate_q16) == HAL_OSAL_OK && rate_q16) {
+        out->feedback_rate = rate_q16;
+        //the dac takes rate_q16 frames a second, feed it that many from sample_rate of source.
+        ppm += ((float)out->sample_rate * 65536.0f / (float)rate_q16 - 1.0f) * 1000000.0f;
+    }
+
+    if (ppm > USB_OUT_MAX_PPM) {
+        ppm = USB_OUT_MAX_PPM;
+    } else if (ppm < -USB_OUT_MAX_PPM) {
+        ppm = -USB_OUT_MAX_PPM;
+    }
+    out->step = (uint64_t)((double)(1ULL << 32) * (1.0 + (double)ppm / 1000000.0));
+}
+
+/* source frames the next transfer needs, they follow the history frame at the head of src_buf. */
+static uint32_t UsbStreamOutSourceFrames(const struct UsbAudioHwStreamOut *out)
+{
+    if (!out->src_buf) {
+        return out->period_frames;
+    }
+    return (uint32_t)((out->phase + out->period_frames * out->step) >> 32);
+}
+
+//f is the fraction of the way from x0 to x1 in Q16.
+#define USB_OUT_LERP_INT(x0, x1, f)   ((x0) + ((((x1) - (x0)) * (f)) >> 16))
+#define USB_OUT_LERP_FLOAT(x0, x1, f) ((x0) + ((x1) - (x0)) * ((float)(f) * (1.0f / 65536.0f)))
+
+#define USB_OUT_RESAMPLE(type, acc, lerp, out, frames) do { \
+    const type *src = (const type *)(out)->src_buf; \
+    type *dst = (type *)(out)->period_buf; \
+    uint32_t ch = (out)->channel_count; \
+    uint64_t pos = (out)->phase; \
+    for (uint32_t i = 0; i < (out)->period_frames; i++, pos += (out)->step) { \
+        uint32_t k = (uint32_t)(pos >> 32); \
+        /* only a step below 1 reaches past the block, by less than 1 - step of a frame. */ \
+        uint32_t k1 = k < (frames) ? k + 1 : (frames); \
+        int64_t f = (int64_t)((pos >> 16) & 0xffff); \
+        for (uint32_t c = 0; c < ch; c++) { \
+            acc x0 = src[k * ch + c]; \
+            acc x1 = src[k1 * ch + c]; \
+            *dst++ = (type)lerp(x0, x1, f); \
+        } \
+    } \
+} while (0)
+
+/*
+ * linear interpolation from src_buf to period_buf. src_buf holds the last source frame of the
+ * previous transfer followed by the new ones, the fractional phase carries over to the next.
+ */
+static void UsbStreamOutResample(struct UsbAudioHwStreamOut *out, uint32_t frames)
+{
+    if (out->format == AUDIO_HW_FORMAT_PCM_FLOAT) {
+        USB_OUT_RESAMPLE(float, float, USB_OUT_LERP_FLOAT, out, frames);
+    } else if (out->frame_size / out->channel_count == sizeof(int16_t)) {
+        USB_OUT_RESAMPLE(int16_t, int64_t, USB_OUT_LERP_INT, out, frames);
+    } else {
+        USB_OUT_RESAMPLE(int32_t, int64_t, USB_OUT_LERP_INT, out, frames);
+    }
+
+    out->phase = (out->phase + out->period_frames * out->step) & 0xffffffffULL;
+    memmove(out->src_buf, out->src_buf + frames * out->frame_size, out->frame_size);
+}
+
+/* sender side, fills the next transfer, returns the source frames it took from the ring. */
+static uint32_t UsbStreamOutFill(struct UsbAudioHwStreamOut *out, uint32_t need, uint32_t avail)
+{
+    uint8_t *dst = out->src_buf ? out->src_buf + out->frame_size : out->period_buf;
+    uint32_t frames = avail < need ? avail : need;
+
+    ameba_spsc_ring_read(out->rb, dst, frames * out->frame_size);
+    ameba_spsc_ring_wake_writer(out->rb_sem, &out->rb_waiting);
+    //an underrun is padded with silence, the dac keeps its clock instead of starving.
+    memset(dst + frames * out->frame_size, 0, (need - frames) * out->frame_size);
+
+    if (out->src_buf) {
+        UsbStreamOutResample(out, need);
+    }
+
+    return frames;
+}
+
+static void UsbStreamOutDriftUpdate(struct UsbAudioHwStreamOut *out)
+{
+    int64_t counted_frames;
+    int64_t ring_frames;
+
+    if (!out->drift.enabled) {
+        return;
+    }
+
+    rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+    counted_frames = out->written - out->consumed;
+    rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+    ring_frames = ameba_spsc_ring_available(out->rb) / out->frame_size;
+    //no pll behind a usb dac, the resampler takes any correction so it is applied as is.
+    if (ameba_audio_drift_update(&out->drift, counted_frames, ring_frames, out->period_frames)) {
+        ameba_audio_drift_applied(&out->drift, out->drift.ppm);
+    }
+}
+
+/*
+ * drains the ring to the usb host one transfer at a time. usbh_composite_uac_write returns when
+ * the host has taken the transfer, so the ring fill follows the dac and Write never waits on usb.
+ */
+static void UsbStreamOutSendTask(void *param)
+{
+    struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)param;
+    uint32_t period_bytes = out->period_frames * out->frame_size;
+    bool primed = false;
+
+    while (out->running) {
+        uint32_t need;
+        uint32_t avail;
+        uint32_t frames;
+        int32_t ret;
+
+        UsbStreamOutUpdateStep(out);
+        need = UsbStreamOutSourceFrames(out);
+        avail = ameba_spsc_ring_available(out->rb) / out->frame_size;
+        if (avail < need) {
+            //wait for the writer, once started give it one period before padding with silence.
+            if (rtos_sema_take(out->data_sem, USB_OUT_PERIOD_MS) == RTK_SUCCESS || !primed) {
+                continue;
+            }
+            avail = ameba_spsc_ring_available(out->rb) / out->frame_size;
+            if (avail < need) {
+                out->underruns++;
+            }
+        }
+
+        frames = UsbStreamOutFill(out, need, avail);
+        ret = usbh_composite_uac_write(out->period_buf, period_bytes, USB_OUT_WRITE_TIMEOUT_MS);
+        if (ret != (int32_t)period_bytes) {
+            out->write_errors++;
+            HAL_AUDIO_VERBOSE("usb write %" PRIu32 " bytes, ret:%" PRId32, period_bytes, ret);
+        }
+
+        rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+        out->consumed += frames;
+        out->consumed_ns = UsbStreamOutNowNs();
+        rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+        primed = true;
+
+        UsbStreamOutDriftUpdate(out);
+    }
+
+    rtos_sema_give(out->exit_sem);
+    rtos_task_delete(NULL);
+}
+
+/* must be called with output stream mutex locked */
+static int32_t StartUsbStreamOut(struct UsbAudioHwStreamOut *out)
+{
+    uint32_t rate_q16 = 0;
+
+    if (!out->drift.enabled && usb_audio_hal_get_feedback_rate(&rate_q16) != HAL_OSAL_OK) {
+        HAL_AUDIO_INFO("usb out at nominal rate, no feedback rate and no drift target");
+    }
+
+    out->phase = 0;
+    out->step = 1ULL << 32;
+    if (out->src_buf) {
+        memset(out->src_buf, 0, out->frame_size);
+    }
+    ameba_audio_drift_restart(&out->drift);
+
+    out->running = true;
+    if (rtos_task_create(NULL, "usb_audio_out", UsbStreamOutSendTask, out, USB_OUT_TASK_STACK, USB_OUT_TASK_PRIORITY) != RTK_SUCCESS) {
+        HAL_AUDIO_ERROR("create usb out task fail");
+        out->running = false;
+        return HAL_OSAL_ERR_NO_MEMORY;
+    }
+
+    return HAL_OSAL_OK;
+}
+
 /* must be called with hw device and output stream mutexes locked */
 static int32_t DoStandbyOutput(struct UsbAudioHwStreamOut *out)
 {
     if (!out->standby) {
         out->standby = 1;
+        if (out->running) {
+            out->running = false;
+            rtos_sema_give(out->data_sem);
+            if (rtos_sema_take(out->exit_sem, USB_OUT_WRITE_TIMEOUT_MS * 2) != RTK_SUCCESS) {
+                HAL_AUDIO_ERROR("usb out task does not exit");
+            }
+        }
+        ameba_spsc_ring_reset(out->rb);
+
+        rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+        //the ring is dropped, what was left in it will never be played.
+        out->written = out->consumed;
+        rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+        HAL_AUDIO_INFO("usb out standby, consumed:%" PRIu64 " underruns:%" PRIu32 " write errors:%" PRIu32,
+                       out->consumed, out->underruns, out->write_errors);
     }
     return HAL_OSAL_OK;
 }
@@ -169,64 +427,111 @@ static int32_t UsbGetStreamOutBufferStatus(struct AudioHwStream *stream)
     return 0;
 }
 
-static int32_t UsbSetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+static int32_t UsbSetStreamOutParameter(struct AudioHwStreamOut *stream, enum AudioHwParamKey key, int32_t value)
 {
-    HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
     struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
-    struct string_cell *cells;
-    cells = string_cells_create_from_str(str_pairs);
-    int32_t value;
 
-    if (string_cells_has_key(cells, DELAY_START)) {
-        string_cells_get_int(cells, DELAY_START, &value);
+    switch (key) {
+    case AUDIO_HW_PARAM_DELAY_START:
         out->delay_start = value == 1 ? true : false;
+        break;
+    case AUDIO_HW_PARAM_DRIFT_TARGET_MS:
+        //only the sender task reads the loop, it restarts on the next write after standby.
+        rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+        DoStandbyOutput(out);
+        ameba_audio_drift_init(&out->drift, out->sample_rate, false, value > 0 ? value : 0);
+        rtos_mutex_give(out->lock);
+        break;
+    default:
+        HAL_AUDIO_VERBOSE("key:%d not supported", key);
+        return HAL_OSAL_ERR_INVALID_PARAM;
+    }
+
+    return HAL_OSAL_OK;
+}
+
+static int32_t UsbSetStreamOutParameters(struct AudioHwStream *stream, const char *str_pairs)
+{
+    HAL_AUDIO_INFO("%s, keys = %s", __FUNCTION__, str_pairs);
+    struct audio_hw_params params;
+
+    audio_hw_params_parse(str_pairs, &params);
+    for (int32_t key = 0; key < AUDIO_HW_PARAM_MAX; key++) {
+        if (audio_hw_params_has(&params, key)) {
+            UsbSetStreamOutParameter((struct AudioHwStreamOut *)stream, key, params.values[key]);
+        }
     }
 
-    string_cells_destroy(cells);
     return HAL_OSAL_OK;
 }
 
 static char *UsbGetStreamOutParameters(const struct AudioHwStream *stream, const char *keys)
 {
-    (void) stream;
-    (void) keys;
+    char str[AMEBA_AUDIO_DRIFT_STR_LEN];
+
+    if (keys && !strcmp(keys, AMEBA_AUDIO_DRIFT_KEY)) {
+        ameba_audio_drift_to_str(&((struct UsbAudioHwStreamOut *)stream)->drift, str, sizeof(str));
+        return (char *)xstrdup(str);
+    }
+
     return (char *)xstrdup("");
 }
 
 static uint32_t UsbGetStreamOutLatency(const struct AudioHwStreamOut *stream)
 {
-    (void) stream;
-    //todo
-    return 0;
+    struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
+    uint64_t queued;
+
+    rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+    queued = out->written - out->consumed;
+    rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+    //frames in the ring, plus the transfer the usb host is sending.
+    return (uint32_t)(queued * 1000 / out->sample_rate) + USB_OUT_PERIOD_MS;
 }
 
 static int32_t UsbGetPresentationPosition(const struct AudioHwStreamOut *stream, uint64_t *frames, struct timespec *timestamp)
 {
-    (void) frames;
-    (void) timestamp;
-
     struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
-    int32_t ret = -1;
+    uint64_t consumed;
+    int64_t consumed_ns;
 
-    rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
-    //todo
-    rtos_mutex_give(out->lock);
+    rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+    consumed = out->consumed;
+    consumed_ns = out->consumed_ns;
+    rtos_critical_exit(RTOS_CRITICAL_AUDIO);
 
-    return ret;
+    if (!consumed_ns) {
+        return HAL_OSAL_ERR_NOT_ENOUGH_DATA;
+    }
+
+    //frames the usb host has taken, at the time it took the last of them.
+    *frames = consumed;
+    timestamp->tv_sec = consumed_ns / 1000000000LL;
+    timestamp->tv_nsec = consumed_ns % 1000000000LL;
+
+    return HAL_OSAL_OK;
 }
 
 static int32_t UsbGetPresentTime(const struct AudioHwStreamOut *stream, int64_t *now_ns, int64_t *audio_ns)
 {
     struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
-    int32_t ret = -1;
-    (void) now_ns;
-    (void) audio_ns;
+    uint64_t consumed;
+    int64_t consumed_ns;
 
-    rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
-    //todo get more accurate time.
-    rtos_mutex_give(out->lock);
+    rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+    consumed = out->consumed;
+    consumed_ns = out->consumed_ns;
+    rtos_critical_exit(RTOS_CRITICAL_AUDIO);
+
+    if (!consumed_ns) {
+        return HAL_OSAL_ERR_NOT_ENOUGH_DATA;
+    }
 
-    return ret;
+    *now_ns = consumed_ns;
+    *audio_ns = (int64_t)((double)consumed * 1000000000.0 / (double)out->sample_rate);
+
+    return HAL_OSAL_OK;
 }
 
 static int64_t UsbGetTriggerTime(const struct AudioHwStreamOut *stream)
@@ -251,30 +556,40 @@ static ssize_t UsbStreamOutWrite(struct AudioHwStreamOut *stream, const void *bu
                                      size_t bytes, bool block)
 {
     HAL_AUDIO_VERBOSE("write: %u %d", bytes, block);
-    (void) block;
     int32_t ret = 0;
-    int32_t timeout_ms = 1000 * 10;
     struct UsbAudioHwStreamOut *out = (struct UsbAudioHwStreamOut *)stream;
-    size_t frame_size = UsbAudioHwStreamOutFrameSize((const struct AudioHwStreamOut *)stream);
+    //the ring drains a period per USB_OUT_PERIOD_MS, a full ring that does not move is a stalled dac.
+    uint32_t max_wait_ms = USB_OUT_PERIOD_MS * USB_OUT_PERIOD_COUNT + USB_OUT_WRITE_TIMEOUT_MS;
 
-    ret = usbh_composite_uac_write((uint8_t *)(buffer), bytes, timeout_ms);
-    if (ret != (int32_t)bytes) {
-        HAL_AUDIO_INFO("bytes: %d, written: %ld", bytes, ret);
+    rtos_mutex_take(out->lock, MUTEX_WAIT_TIMEOUT);
+    if (out->standby) {
+        ret = StartUsbStreamOut(out);
+        if (ret != HAL_OSAL_OK) {
+            rtos_mutex_give(out->lock);
+            return ret;
+        }
+        out->standby = 0;
     }
+    rtos_mutex_give(out->lock);
 
-    //write successfully
-    if (ret >= 0) {
-        ret = bytes;
-        out->written += bytes / frame_size;
-        //sync with ameba audio driver's total_counter_boundary max value.
-        if (out->written > UINT64_MAX) {
-            out->written = 0;
+    //whole frames only, the sender reads the ring a frame at a time.
+    bytes -= bytes % out->frame_size;
+    size_t bytes_left = bytes;
+    if (block) {
+        bytes_left -= ameba_spsc_ring_write_wait(out->rb, buffer, bytes, out->rb_sem, &out->rb_waiting, max_wait_ms);
+        if (bytes_left) {
+            HAL_AUDIO_ERROR("usb out stalled, %u bytes left", bytes_left);
         }
+    } else {
+        bytes_left -= ameba_spsc_ring_write(out->rb, buffer, bytes);
     }
+    rtos_sema_give(out->data_sem);
 
-    rtos_mutex_give(out->lock);
+    rtos_critical_enter(RTOS_CRITICAL_AUDIO);
+    out->written += (bytes - bytes_left) / out->frame_size;
+    rtos_critical_exit(RTOS_CRITICAL_AUDIO);
 
-    return ret;
+    return bytes - bytes_left;
 }
 
 void DestroyUsbAudioHwStreamOut(struct AudioHwStreamOut *stream_out)
@@ -284,6 +599,12 @@ void DestroyUsbAudioHwStreamOut(struct AudioHwStreamOut *stream_out)
     UsbStandbyStreamOut(&stream_out->common);
 
     rtos_mutex_delete(out->lock);
+    ameba_spsc_ring_destroy(out->rb);
+    rtos_sema_delete(out->rb_sem);
+    rtos_sema_delete(out->data_sem);
+    rtos_sema_delete(out->exit_sem);
+    rtos_mem_free(out->period_buf);
+    rtos_mem_free(out->src_buf);
     rtos_mem_free(out);
 
     HAL_AUDIO_INFO("DestroyUsbAudioHwStreamOut");
@@ -313,6 +634,7 @@ struct AudioHwStreamOut *CreateUsbAudioHwStreamOut(struct AudioHwCard *card, con
     out->stream.common.Standby = UsbStandbyStreamOut;
     out->stream.common.Dump = UsbDumpStreamOut;
     out->stream.common.SetParameters = UsbSetStreamOutParameters;
+    out->stream.SetParameter = UsbSetStreamOutParameter;
     out->stream.common.GetParameters = UsbGetStreamOutParameters;
     out->stream.common.GetBufferStatus = UsbGetStreamOutBufferStatus;
     out->stream.GetPresentationPosition = UsbGetPresentationPosition;
@@ -348,7 +670,33 @@ struct AudioHwStreamOut *CreateUsbAudioHwStreamOut(struct AudioHwCard *card, con
     HAL_AUDIO_INFO("usb rate:%ld, channels:%ld, format:%d",
                     out->sample_rate, out->channel_count, out->format);
 
+    out->frame_size = UsbAudioHwStreamOutFrameSize(&out->stream);
+    out->period_frames = out->sample_rate * USB_OUT_PERIOD_MS / 1000;
+    out->period_buf = (uint8_t *)rtos_mem_zmalloc(out->period_frames * out->frame_size);
+    //16, 32 bit and float pcm go through the resampler: history frame, a period, and room for the correction.
+    if (AudioIsLinearPCM(out->format) && (out->frame_size / out->channel_count == sizeof(int16_t) ||
+                                          out->frame_size / out->channel_count == sizeof(int32_t))) {
+        out->src_frames = out->period_frames + out->period_frames / 64 + 2;
+        out->src_buf = (uint8_t *)rtos_mem_zmalloc(out->src_frames * out->frame_size);
+    } else {
+        HAL_AUDIO_INFO("usb format:%d is sent without rate adaptation", out->format);
+    }
+    if (!out->period_buf || (out->src_frames && !out->src_buf) ||
+        !(out->rb = ameba_spsc_ring_create(out->period_frames * out->frame_size * USB_OUT_PERIOD_COUNT))) {
+        HAL_AUDIO_ERROR("usb out buffers alloc fail");
+        rtos_mem_free(out->period_buf);
+        rtos_mem_free(out->src_buf);
+        rtos_mem_free(out);
+        return NULL;
+    }
+    out->rb_size = ameba_spsc_ring_capacity(out->rb);
+
     rtos_mutex_create(&out->lock);
+    rtos_sema_create_binary(&out->rb_sem);
+    rtos_sema_create_binary(&out->data_sem);
+    rtos_sema_create_binary(&out->exit_sem);
+    out->rb_waiting = 0;
+    ameba_audio_drift_init(&out->drift, out->sample_rate, false, 0);
 
     pri_card->output = out;
 
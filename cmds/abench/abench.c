@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "Abench"
+
+#include "ameba_soc.h"
+#include "audio/audio_record.h"
+#include "audio/audio_service.h"
+#include "audio/audio_track.h"
+#include "common/audio_errnos.h"
+#include "os_wrapper.h"
+#include "platform_stdlib.h"
+#include "basic_types.h"
+
+#include "log/log.h"
+#include "abench.h"
+
+#define ABENCH_MAX_VALUES      8
+#define ABENCH_HIST_BUCKETS    16
+#define ABENCH_CASE_SECONDS    5
+//the cpu meter needs this long without audio to learn the idle speed.
+#define ABENCH_CALIB_MS        1000
+//a position standing still this long while the track has data counts as one xrun.
+#define ABENCH_STALL_MS        20
+//record falling this many periods behind the capture position counts as one xrun.
+#define ABENCH_OVERRUN_PERIODS 8
+
+#define EXAMPLE_AUDIO_DEBUG(fmt, args...)    MEDIA_LOGD("[%s]: " fmt "", __func__, ## args)
+#define EXAMPLE_AUDIO_ERROR(fmt, args...)    MEDIA_LOGE("[%s]: " fmt "", __func__, ## args)
+
+enum {
+    ABENCH_MODE_ALL = 0,
+    ABENCH_MODE_PLAY = 1,
+    ABENCH_MODE_RECORD = 2,
+};
+
+typedef struct {
+    uint32_t values[ABENCH_MAX_VALUES];
+    uint32_t count;
+} AbenchList;
+
+typedef struct {
+    uint32_t rate;
+    uint32_t channels;
+    uint32_t bits;
+    uint32_t buffer_bytes;
+    uint32_t frames_one_time;
+} AbenchCase;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t frames;
+    uint64_t total_us;
+    uint32_t max_us;
+    uint32_t hist[ABENCH_HIST_BUCKETS];
+    uint32_t xruns;
+    int64_t drift_ppm;
+    uint32_t cpu_per_frame;
+} AbenchResult;
+
+static void abench_help(void);
+
+static AbenchList g_rates = {{16000, 48000}, 2};
+static AbenchList g_channels = {{1, 2}, 2};
+static AbenchList g_bits = {{16}, 1};
+static AbenchList g_buffer_bytes = {{0}, 1};
+static AbenchList g_frames_one_time = {{256, 1024}, 2};
+static uint32_t g_case_seconds = ABENCH_CASE_SECONDS;
+static uint32_t g_mode = ABENCH_MODE_ALL;
+
+static volatile bool g_spin_running = false;
+static volatile uint32_t g_spin_loops = 0;
+static rtos_sema_t g_spin_exit_sema = NULL;
+static uint32_t g_idle_loops_per_ms = 0;
+
+/*
+ * the cpu meter: a task on the lowest priority counts loops, the loops it loses
+ * while audio runs are the cpu time audio takes, in all its tasks and irqs.
+ * ca32 is smp and the meter task can run on either core, the time it loses is
+ * wall time rather than cycles of one core, so it is reported as busy_ns_per_frame
+ * there and cycles_per_frame on the single core mcus.
+ */
+#ifdef CONFIG_ARM_CORE_CA32
+#define ABENCH_CPU_KEY "busy_ns_per_frame"
+#else
+#define ABENCH_CPU_KEY "cycles_per_frame"
+#endif
+
+static void abench_spin_thread(void *param)
+{
+    (void) param;
+
+    while (g_spin_running) {
+        g_spin_loops++;
+    }
+
+    rtos_sema_give(g_spin_exit_sema);
+    rtos_task_delete(NULL);
+}
+
+static int32_t abench_spin_start(void)
+{
+    g_spin_loops = 0;
+    g_spin_running = true;
+    if (rtos_task_create(NULL, ((const char *)"abench_spin_thread"), abench_spin_thread, NULL, 1024, 0) != RTK_SUCCESS) {
+        g_spin_running = false;
+        EXAMPLE_AUDIO_ERROR("error: rtos_task_create(abench_spin_thread) failed");
+        return AUDIO_ERR_NO_MEMORY;
+    }
+
+    return AUDIO_OK;
+}
+
+static uint32_t abench_spin_stop(void)
+{
+    if (!g_spin_running) {
+        return 0;
+    }
+
+    g_spin_running = false;
+    rtos_sema_take(g_spin_exit_sema, RTOS_MAX_TIMEOUT);
+
+    return g_spin_loops;
+}
+
+static void abench_spin_calibrate(void)
+{
+    if (abench_spin_start() != AUDIO_OK) {
+        return;
+    }
+
+    rtos_time_delay_ms(ABENCH_CALIB_MS);
+    g_idle_loops_per_ms = abench_spin_stop() / ABENCH_CALIB_MS;
+    EXAMPLE_AUDIO_DEBUG("idle loops per ms:%lu, cpu clk:%lu", g_idle_loops_per_ms, SystemGetCpuClk());
+}
+
+static uint32_t abench_cpu_per_frame(uint32_t spin_loops, uint64_t elapsed_us, uint64_t frames)
+{
+    uint64_t idle_loops = (uint64_t)g_idle_loops_per_ms * elapsed_us / 1000;
+    uint64_t busy_us;
+
+    if (!idle_loops || !frames) {
+        return 0;
+    }
+
+    if (spin_loops >= idle_loops) {
+        return 0;
+    }
+
+    busy_us = elapsed_us * (idle_loops - spin_loops) / idle_loops;
+
+#ifdef CONFIG_ARM_CORE_CA32
+    return (uint32_t)(busy_us * 1000 / frames);
+#else
+    return (uint32_t)(busy_us * (SystemGetCpuClk() / 1000000) / frames);
+#endif
+}
+
+static void abench_add_call(AbenchResult *result, uint64_t start_us, int32_t bytes, uint32_t frame_size)
+{
+    uint32_t cost_us = (uint32_t)(rtos_time_get_current_system_time_us() - start_us);
+    uint32_t bucket = 0;
+
+    while (bucket < ABENCH_HIST_BUCKETS - 1 && cost_us >= (2U << bucket)) {
+        bucket++;
+    }
+
+    result->hist[bucket]++;
+    result->calls++;
+    result->total_us += cost_us;
+    if (cost_us > result->max_us) {
+        result->max_us = cost_us;
+    }
+    if (bytes > 0) {
+        result->frames += bytes / frame_size;
+    }
+}
+
+//upper bound in us of the histogram bucket that holds the percent-th call.
+static uint32_t abench_percentile_us(AbenchResult *result, uint32_t percent)
+{
+    uint64_t target = (result->calls * percent + 99) / 100;
+    uint64_t seen = 0;
+    uint32_t bucket;
+
+    for (bucket = 0; bucket < ABENCH_HIST_BUCKETS; bucket++) {
+        seen += result->hist[bucket];
+        if (seen >= target) {
+            break;
+        }
+    }
+
+    return 2U << (bucket < ABENCH_HIST_BUCKETS ? bucket : ABENCH_HIST_BUCKETS - 1);
+}
+
+static int64_t abench_drift_ppm(int64_t first_now_ns, int64_t first_audio_ns, int64_t last_now_ns, int64_t last_audio_ns)
+{
+    int64_t now_delta = last_now_ns - first_now_ns;
+    int64_t audio_delta = last_audio_ns - first_audio_ns;
+
+    if (now_delta <= 0) {
+        return 0;
+    }
+
+    return (audio_delta - now_delta) * 1000000LL / now_delta;
+}
+
+static uint32_t abench_get_format(uint32_t bits)
+{
+    switch (bits) {
+    case 16:
+        return AUDIO_FORMAT_PCM_16_BIT;
+    case 24:
+        return AUDIO_FORMAT_PCM_24_BIT;
+    case 32:
+        return AUDIO_FORMAT_PCM_32_BIT;
+    default:
+        return AUDIO_FORMAT_INVALID;
+    }
+}
+
+/*
+ * one line per case, so the uart logs of two firmware releases can be grepped
+ * for "ABENCH " and diffed.
+ */
+static void abench_report(const char *dir, AbenchCase *bench_case, AbenchResult *result)
+{
+    uint32_t i;
+
+    printf("ABENCH {\"dir\":\"%s\",\"rate\":%lu,\"channels\":%lu,\"bits\":%lu,\"buffer_bytes\":%lu,\"frames_one_time\":%lu,",
+           dir, bench_case->rate, bench_case->channels, bench_case->bits, bench_case->buffer_bytes, bench_case->frames_one_time);
+    printf("\"calls\":%llu,\"frames\":%llu,\"avg_us\":%llu,\"p50_us\":%lu,\"p99_us\":%lu,\"max_us\":%lu,",
+           result->calls, result->frames, result->calls ? result->total_us / result->calls : 0,
+           abench_percentile_us(result, 50), abench_percentile_us(result, 99), result->max_us);
+    printf("\"" ABENCH_CPU_KEY "\":%lu,\"xruns\":%lu,\"drift_ppm\":%lld,\"hist_us_log2\":[",
+           result->cpu_per_frame, result->xruns, result->drift_ppm);
+    for (i = 0; i < ABENCH_HIST_BUCKETS; i++) {
+        printf("%lu%s", result->hist[i], i == ABENCH_HIST_BUCKETS - 1 ? "]}\n" : ",");
+    }
+}
+
+static void abench_fill_pcm(int8_t *buffer, uint32_t frames, uint32_t channels, uint32_t bits, uint32_t *phase)
+{
+    uint32_t bps = bits / 8;
+    uint32_t i;
+    uint32_t chn;
+    uint32_t b;
+
+    for (i = 0; i < frames; i++) {
+        //a saw tooth is enough to keep the data path busy.
+        int32_t res = (int32_t)((*phase)++ << 20);
+        for (chn = 0; chn < channels; chn++) {
+            for (b = 0; b < bps; b++) {
+                *buffer++ = (res >> (32 - bps * 8 + b * 8)) & 0xff;
+            }
+        }
+    }
+}
+
+static void abench_play_case(AbenchCase *bench_case)
+{
+    AbenchResult result;
+    struct AudioTrack *track;
+    AudioTrackConfig track_config;
+    uint32_t format = abench_get_format(bench_case->bits);
+    uint32_t frame_size = bench_case->channels * bench_case->bits / 8;
+    uint32_t size = bench_case->frames_one_time * frame_size;
+    uint32_t phase = 0;
+    uint64_t position = 0;
+    uint64_t last_position = 0;
+    uint64_t last_move_us = 0;
+    bool stalled = false;
+    int64_t first_now_ns = 0;
+    int64_t first_audio_ns = 0;
+    int64_t now_ns = 0;
+    int64_t audio_ns = 0;
+    uint64_t start_us;
+    uint64_t end_us;
+    uint32_t spin_loops;
+    int8_t *buffer;
+
+    memset(&result, 0, sizeof(AbenchResult));
+
+    buffer = (int8_t *)malloc(size);
+    if (!buffer) {
+        EXAMPLE_AUDIO_ERROR("malloc %lu bytes fail", size);
+        return;
+    }
+
+    track = AudioTrack_Create();
+    if (!track) {
+        EXAMPLE_AUDIO_ERROR("error: new AudioTrack failed");
+        free(buffer);
+        return;
+    }
+
+    track_config.category_type = AUDIO_CATEGORY_MEDIA;
+    track_config.sample_rate = bench_case->rate;
+    track_config.format = format;
+    track_config.channel_count = bench_case->channels;
+    track_config.buffer_bytes = bench_case->buffer_bytes;
+    if (!track_config.buffer_bytes) {
+        track_config.buffer_bytes = AudioTrack_GetMinBufferBytes(track, AUDIO_CATEGORY_MEDIA, bench_case->rate, format, bench_case->channels) * 4;
+    }
+    if (AudioTrack_Init(track, &track_config, AUDIO_OUTPUT_FLAG_NONE) != AUDIO_OK || AudioTrack_Start(track) != AUDIO_OK) {
+        EXAMPLE_AUDIO_ERROR("error: track init or start fail");
+        AudioTrack_Destroy(track);
+        free(buffer);
+        return;
+    }
+
+    abench_spin_start();
+    start_us = rtos_time_get_current_system_time_us();
+    end_us = start_us + (uint64_t)g_case_seconds * 1000000;
+    last_move_us = start_us;
+
+    while (rtos_time_get_current_system_time_us() < end_us) {
+        uint64_t call_us;
+        int32_t ret;
+
+        abench_fill_pcm(buffer, bench_case->frames_one_time, bench_case->channels, bench_case->bits, &phase);
+
+        call_us = rtos_time_get_current_system_time_us();
+        ret = AudioTrack_Write(track, buffer, size, true);
+        abench_add_call(&result, call_us, ret, frame_size);
+
+        if (AudioTrack_GetPosition(track, &position) == AUDIO_OK) {
+            call_us = rtos_time_get_current_system_time_us();
+            if (position != last_position) {
+                last_position = position;
+                last_move_us = call_us;
+                stalled = false;
+            } else if (position && !stalled && call_us - last_move_us > ABENCH_STALL_MS * 1000) {
+                result.xruns++;
+                stalled = true;
+            }
+        }
+
+        if (AudioTrack_GetPresentTime(track, &now_ns, &audio_ns) == AUDIO_OK && !first_now_ns) {
+            first_now_ns = now_ns;
+            first_audio_ns = audio_ns;
+        }
+    }
+
+    spin_loops = abench_spin_stop();
+    result.cpu_per_frame = abench_cpu_per_frame(spin_loops, rtos_time_get_current_system_time_us() - start_us, result.frames);
+    if (first_now_ns) {
+        result.drift_ppm = abench_drift_ppm(first_now_ns, first_audio_ns, now_ns, audio_ns);
+    }
+
+    AudioTrack_Pause(track);
+    AudioTrack_Flush(track);
+    AudioTrack_Stop(track);
+    AudioTrack_Destroy(track);
+    free(buffer);
+
+    abench_report("play", bench_case, &result);
+}
+
+static void abench_record_case(AbenchCase *bench_case)
+{
+    AbenchResult result;
+    struct AudioRecord *record;
+    AudioRecordConfig record_config;
+    AudioTimestamp tstamp;
+    uint32_t format = abench_get_format(bench_case->bits);
+    uint32_t frame_size = bench_case->channels * bench_case->bits / 8;
+    uint32_t size = bench_case->frames_one_time * frame_size;
+    uint64_t period_frames;
+    bool overrun = false;
+    int64_t first_now_ns = 0;
+    int64_t first_audio_ns = 0;
+    int64_t now_ns = 0;
+    int64_t audio_ns = 0;
+    uint64_t start_us;
+    uint64_t end_us;
+    uint32_t spin_loops;
+    int8_t *buffer;
+
+    memset(&result, 0, sizeof(AbenchResult));
+
+    buffer = (int8_t *)malloc(size);
+    if (!buffer) {
+        EXAMPLE_AUDIO_ERROR("malloc %lu bytes fail", size);
+        return;
+    }
+
+    record = AudioRecord_Create();
+    if (!record) {
+        EXAMPLE_AUDIO_ERROR("record create failed");
+        free(buffer);
+        return;
+    }
+
+    record_config.sample_rate = bench_case->rate;
+    record_config.format = format;
+    record_config.channel_count = bench_case->channels;
+    record_config.device = DEVICE_IN_MIC;
+    //0 means using default period bytes.
+    record_config.buffer_bytes = bench_case->buffer_bytes;
+    if (AudioRecord_Init(record, &record_config, AUDIO_INPUT_FLAG_NONE) != AUDIO_OK || AudioRecord_Start(record) != AUDIO_OK) {
+        EXAMPLE_AUDIO_ERROR("error: record init or start fail");
+        AudioRecord_Destroy(record);
+        free(buffer);
+        return;
+    }
+
+    period_frames = AudioRecord_GetBufferSize(record) / frame_size;
+
+    abench_spin_start();
+    start_us = rtos_time_get_current_system_time_us();
+    end_us = start_us + (uint64_t)g_case_seconds * 1000000;
+
+    while (rtos_time_get_current_system_time_us() < end_us) {
+        uint64_t call_us = rtos_time_get_current_system_time_us();
+        int32_t ret = AudioRecord_Read(record, buffer, size, true);
+
+        abench_add_call(&result, call_us, ret, frame_size);
+
+        if (AudioRecord_GetTimestamp(record, &tstamp) == AUDIO_OK && period_frames) {
+            if (tstamp.position > result.frames + period_frames * ABENCH_OVERRUN_PERIODS) {
+                if (!overrun) {
+                    result.xruns++;
+                }
+                overrun = true;
+            } else {
+                overrun = false;
+            }
+        }
+
+        if (AudioRecord_GetPresentTime(record, &now_ns, &audio_ns) == AUDIO_OK && !first_now_ns) {
+            first_now_ns = now_ns;
+            first_audio_ns = audio_ns;
+        }
+    }
+
+    spin_loops = abench_spin_stop();
+    result.cpu_per_frame = abench_cpu_per_frame(spin_loops, rtos_time_get_current_system_time_us() - start_us, result.frames);
+    if (first_now_ns) {
+        result.drift_ppm = abench_drift_ppm(first_now_ns, first_audio_ns, now_ns, audio_ns);
+    }
+
+    AudioRecord_Stop(record);
+    AudioRecord_Destroy(record);
+    free(buffer);
+
+    abench_report("record", bench_case, &result);
+}
+
+void example_abench_thread(void *param)
+{
+    AbenchCase bench_case;
+    uint32_t r, c, f, b, w;
+
+    (void) param;
+    EXAMPLE_AUDIO_DEBUG("Abench begin");
+
+    rtos_sema_create_binary(&g_spin_exit_sema);
+    AudioService_Init();
+    abench_spin_calibrate();
+
+    for (r = 0; r < g_rates.count; r++) {
+        for (c = 0; c < g_channels.count; c++) {
+            for (f = 0; f < g_bits.count; f++) {
+                for (b = 0; b < g_buffer_bytes.count; b++) {
+                    for (w = 0; w < g_frames_one_time.count; w++) {
+                        bench_case.rate = g_rates.values[r];
+                        bench_case.channels = g_channels.values[c];
+                        bench_case.bits = g_bits.values[f];
+                        bench_case.buffer_bytes = g_buffer_bytes.values[b];
+                        bench_case.frames_one_time = g_frames_one_time.values[w];
+
+                        if (abench_get_format(bench_case.bits) == AUDIO_FORMAT_INVALID) {
+                            EXAMPLE_AUDIO_ERROR("invalid format bits:%lu", bench_case.bits);
+                            continue;
+                        }
+
+                        if (g_mode != ABENCH_MODE_RECORD) {
+                            abench_play_case(&bench_case);
+                        }
+                        if (g_mode != ABENCH_MODE_PLAY) {
+                            abench_record_case(&bench_case);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    rtos_sema_delete(g_spin_exit_sema);
+    g_spin_exit_sema = NULL;
+    EXAMPLE_AUDIO_DEBUG("Abench end");
+
+    rtos_task_delete(NULL);
+}
+
+//"48000,16000" -> list, at most ABENCH_MAX_VALUES values.
+static void abench_parse_list(const char *arg, AbenchList *list)
+{
+    const char *p = arg;
+
+    list->count = 0;
+    while (*p && list->count < ABENCH_MAX_VALUES) {
+        list->values[list->count++] = strtoul(p, NULL, 10);
+        while (*p && *p != ',') {
+            p++;
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+}
+
+void example_abench(char **argv)
+{
+    /* parse command line arguments */
+    while (*argv) {
+        if (strcmp(*argv, "-r") == 0) {
+            argv++;
+            if (*argv) {
+                abench_parse_list(*argv, &g_rates);
+            }
+        } else if (strcmp(*argv, "-c") == 0) {
+            argv++;
+            if (*argv) {
+                abench_parse_list(*argv, &g_channels);
+            }
+        } else if (strcmp(*argv, "-f") == 0) {
+            argv++;
+            if (*argv) {
+                abench_parse_list(*argv, &g_bits);
+            }
+        } else if (strcmp(*argv, "-b") == 0) {
+            argv++;
+            if (*argv) {
+                abench_parse_list(*argv, &g_buffer_bytes);
+            }
+        } else if (strcmp(*argv, "-w") == 0) {
+            argv++;
+            if (*argv) {
+                abench_parse_list(*argv, &g_frames_one_time);
+            }
+        } else if (strcmp(*argv, "-t") == 0) {
+            argv++;
+            if (*argv) {
+                g_case_seconds = atoi(*argv);
+            }
+        } else if (strcmp(*argv, "-m") == 0) {
+            argv++;
+            if (*argv) {
+                g_mode = atoi(*argv);
+            }
+        }
+        if (*argv) {
+            argv++;
+        }
+    }
+
+    if (rtos_task_create(NULL, ((const char *)"example_abench_thread"), example_abench_thread, NULL, 8192 * 4, 1) != RTK_SUCCESS) {
+        EXAMPLE_AUDIO_ERROR("error: rtos_task_create(example_abench_thread) failed");
+    }
+}
+
+uint32_t abench_cmd_handle(int argc, char *argv[])
+{
+    if (argc <= 0) {
+        abench_help();
+    }
+
+    example_abench((char **)argv);
+    return TRUE;
+}
+
+static void abench_help(void)
+{
+    MEDIA_LOGD("abench [OPTION...]\n"
+        "\t\t test cmd: abench [-r] rates [-c] channels [-f] format_bits [-b] buffer_bytes [-w] frames_one_time [-t] seconds_per_case [-m] mode\n"
+        "\t\t every list is comma separated, all combinations are run.\n"
+        "\t\t mode: 0:play and record, 1:play only, 2:record only\n"
+        "\t\t default params: [-r] 16000,48000 [-c] 1,2 [-f] 16 [-b] 0 [-w] 256,1024 [-t] 5 [-m] 0\n"
+        "\t\t test demo: abench -r 48000 -c 2 -f 16,32 -w 480 -m 1\n");
+}
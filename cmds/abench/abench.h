@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_CMDS_ABENCH_ABENCH_H
+#define AMEBA_AUDIO_CMDS_ABENCH_ABENCH_H
+
+uint32_t abench_cmd_handle(int argc, char *argv[]);
+
+#endif /* AMEBA_AUDIO_CMDS_ABENCH_ABENCH_H */
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "Atrace"
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+#include "platform_stdlib.h"
+#include "basic_types.h"
+
+#include "log/log.h"
+#include "ameba_audio_isr_trace.h"
+#include "atrace.h"
+
+#define ATRACE_DIRECTIONS      2
+
+#define EXAMPLE_AUDIO_DEBUG(fmt, args...)    MEDIA_LOGD("[%s]: " fmt "", __func__, ## args)
+
+typedef struct {
+    uint32_t count;
+    uint32_t exec_cycles[AUDIO_ISR_TRACE_SIZE];
+    uint32_t max_interval_cycles;
+    uint32_t min_fill_bytes;
+    uint32_t max_fill_bytes;
+    uint32_t actions[AUDIO_ISR_TRACE_END + 1];
+    uint32_t sem_posts;
+} AtraceSummary;
+
+//static, the trace copy is too big for the cmd thread stack.
+static AudioIsrTraceEntry g_entries[AUDIO_ISR_TRACE_SIZE];
+static AtraceSummary g_summary[ATRACE_DIRECTIONS];
+
+static const char *g_direction_names[ATRACE_DIRECTIONS] = {"out", "in"};
+static const char *g_action_names[AUDIO_ISR_TRACE_END + 1] = {"busy", "restart", "xrun", "wait_peer", "end"};
+
+static void atrace_help(void)
+{
+    MEDIA_LOGD("atrace [OPTION...]\n"
+        "\t\t test cmd: atrace [-v] list_entries [-c] clear\n"
+        "\t\t dump the gdma complete irq trace of audio hal: percentiles of irq execution time,\n"
+        "\t\t the longest gap between two irqs of one gdma, fill level and restart decisions.\n"
+        "\t\t default params: [-v] 0 [-c] 0\n"
+        "\t\t test demo: atrace -v 1 -c 1\n");
+}
+
+static void atrace_sort(uint32_t *values, uint32_t count)
+{
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t value = values[i];
+        uint32_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+static uint32_t atrace_percentile(const uint32_t *sorted, uint32_t count, uint32_t percent)
+{
+    uint32_t index = (count * percent + 99) / 100;
+
+    if (index == 0) {
+        index = 1;
+    }
+    return sorted[index - 1];
+}
+
+static uint32_t atrace_cycles_to_us(uint32_t cycles)
+{
+    uint32_t cycles_per_us = SystemGetCpuClk() / 1000000;
+
+    return cycles_per_us ? cycles / cycles_per_us : cycles;
+}
+
+static void atrace_summarize(const AudioIsrTraceEntry *entries, uint32_t count)
+{
+    //last irq enter per direction and gdma, for the gap between two periods.
+    uint32_t last_enter[ATRACE_DIRECTIONS][2];
+    bool has_last[ATRACE_DIRECTIONS][2];
+
+    memset(g_summary, 0, sizeof(g_summary));
+    memset(has_last, 0, sizeof(has_last));
+    for (uint32_t d = 0; d < ATRACE_DIRECTIONS; d++) {
+        g_summary[d].min_fill_bytes = UINT32_MAX;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const AudioIsrTraceEntry *entry = &entries[i];
+        uint32_t d = entry->direction < ATRACE_DIRECTIONS ? entry->direction : ATRACE_DIRECTIONS - 1;
+        uint32_t g = entry->gdma_id ? 1 : 0;
+        AtraceSummary *summary = &g_summary[d];
+
+        summary->exec_cycles[summary->count++] = entry->exit_cycles - entry->enter_cycles;
+        if (entry->action <= AUDIO_ISR_TRACE_END) {
+            summary->actions[entry->action]++;
+        }
+        summary->sem_posts += entry->sem_posted;
+        if (entry->fill_bytes < summary->min_fill_bytes) {
+            summary->min_fill_bytes = entry->fill_bytes;
+        }
+        if (entry->fill_bytes > summary->max_fill_bytes) {
+            summary->max_fill_bytes = entry->fill_bytes;
+        }
+
+        if (has_last[d][g] && entry->enter_cycles - last_enter[d][g] > summary->max_interval_cycles) {
+            summary->max_interval_cycles = entry->enter_cycles - last_enter[d][g];
+        }
+        last_enter[d][g] = entry->enter_cycles;
+        has_last[d][g] = true;
+    }
+}
+
+static void atrace_print_summary(void)
+{
+    for (uint32_t d = 0; d < ATRACE_DIRECTIONS; d++) {
+        AtraceSummary *summary = &g_summary[d];
+        uint32_t p50, p90, p99, max;
+
+        if (summary->count == 0) {
+            continue;
+        }
+
+        atrace_sort(summary->exec_cycles, summary->count);
+        p50 = atrace_percentile(summary->exec_cycles, summary->count, 50);
+        p90 = atrace_percentile(summary->exec_cycles, summary->count, 90);
+        p99 = atrace_percentile(summary->exec_cycles, summary->count, 99);
+        max = summary->exec_cycles[summary->count - 1];
+
+        EXAMPLE_AUDIO_DEBUG("%s: irqs:%lu exec cycles p50:%lu p90:%lu p99:%lu max:%lu", g_direction_names[d],
+                            summary->count, p50, p90, p99, max);
+        EXAMPLE_AUDIO_DEBUG("%s: exec us p50:%lu p90:%lu p99:%lu max:%lu, max irq interval:%luus", g_direction_names[d],
+                            atrace_cycles_to_us(p50), atrace_cycles_to_us(p90), atrace_cycles_to_us(p99),
+                            atrace_cycles_to_us(max), atrace_cycles_to_us(summary->max_interval_cycles));
+        EXAMPLE_AUDIO_DEBUG("%s: restart:%lu xrun:%lu wait_peer:%lu end:%lu sem posts:%lu fill:%lu~%lu bytes",
+                            g_direction_names[d], summary->actions[AUDIO_ISR_TRACE_RESTART],
+                            summary->actions[AUDIO_ISR_TRACE_XRUN], summary->actions[AUDIO_ISR_TRACE_WAIT_PEER],
+                            summary->actions[AUDIO_ISR_TRACE_END], summary->sem_posts,
+                            summary->min_fill_bytes, summary->max_fill_bytes);
+    }
+}
+
+static void atrace_print_entries(const AudioIsrTraceEntry *entries, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        const AudioIsrTraceEntry *entry = &entries[i];
+
+        EXAMPLE_AUDIO_DEBUG("%3lu %s gdma%u enter:%lu exec:%lu fill:%lu %s%s", i,
+                            g_direction_names[entry->direction ? 1 : 0], entry->gdma_id, entry->enter_cycles,
+                            entry->exit_cycles - entry->enter_cycles, entry->fill_bytes,
+                            entry->action <= AUDIO_ISR_TRACE_END ? g_action_names[entry->action] : "?",
+                            entry->sem_posted ? " sem" : "");
+    }
+}
+
+void example_atrace(char **argv)
+{
+    uint32_t verbose = 0;
+    uint32_t clear = 0;
+    uint32_t count;
+
+    /* parse command line arguments */
+    while (*argv) {
+        if (strcmp(*argv, "-v") == 0) {
+            argv++;
+            if (*argv) {
+                verbose = atoi(*argv);
+            }
+        } else if (strcmp(*argv, "-c") == 0) {
+            argv++;
+            if (*argv) {
+                clear = atoi(*argv);
+            }
+        } else if (strcmp(*argv, "-h") == 0) {
+            atrace_help();
+            return;
+        }
+        if (*argv) {
+            argv++;
+        }
+    }
+
+    count = ameba_audio_isr_trace_read(g_entries, AUDIO_ISR_TRACE_SIZE);
+    EXAMPLE_AUDIO_DEBUG("%lu irqs traced, cpu clk:%lu", count, SystemGetCpuClk());
+
+    if (verbose) {
+        atrace_print_entries(g_entries, count);
+    }
+    atrace_summarize(g_entries, count);
+    atrace_print_summary();
+
+    if (clear) {
+        ameba_audio_isr_trace_clear();
+    }
+}
+
+uint32_t atrace_cmd_handle(int argc, char *argv[])
+{
+    if (argc <= 0) {
+        atrace_help();
+    }
+
+    example_atrace((char **)argv);
+    return TRUE;
+}
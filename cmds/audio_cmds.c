@@ -135,6 +135,45 @@ uint32_t pcrecord_cmd_thread(uint16_t argc, u8 *argv[]) {
 #endif
 
 
+// ----------------------------------------------------------------------
+// abench_cmd
+#ifdef CONFIG_CMD_ABENCH
+extern uint32_t abench_cmd_handle(int argc, char *argv[]);
+
+uint32_t abench_cmd_thread(uint16_t argc, u8 *argv[]) {
+    printf("abench_cmd_thread start.\n");
+
+    AUDIO_MEM_DEBUG_INFO_INIT();
+
+    abench_cmd_handle(argc, (char **)argv);
+
+    rtos_time_delay_ms(1 * 1000);
+
+    AUDIO_MEM_DEBUG_INFO_DUMP();
+    printf("abench_cmd_thread exit.\n\n\n");
+
+    return TRUE;
+}
+#endif
+
+
+// ----------------------------------------------------------------------
+// atrace_cmd
+#ifdef CONFIG_CMD_ATRACE
+extern uint32_t atrace_cmd_handle(int argc, char *argv[]);
+
+uint32_t atrace_cmd_thread(uint16_t argc, u8 *argv[]) {
+    printf("atrace_cmd_thread start.\n");
+
+    atrace_cmd_handle(argc, (char **)argv);
+
+    printf("atrace_cmd_thread exit.\n\n\n");
+
+    return TRUE;
+}
+#endif
+
+
 // ----------------------------------------------------------------------
 // audio_cmds_table
 CMD_TABLE_DATA_SECTION
@@ -190,4 +229,26 @@ const COMMAND_TABLE audio_cmd_table[] = {
         (const u8 *)"\tpcrecord\n"
     },
 #endif
+
+#ifdef CONFIG_CMD_ABENCH
+    {
+        (const u8 *)"abench", 1, abench_cmd_thread,
+        (const u8 *)"\tabench\n"
+                    "\t\ttest cmd: abench [-r] rates [-c] channels [-f] format_bits [-b] buffer_bytes [-w] frames_one_time [-t] seconds_per_case [-m] mode\n"
+                    "\t\tlists are comma separated, every combination is one case, mode 0:play and record, 1:play only, 2:record only\n"
+                    "\t\tdefault params: [-r] 16000,48000 [-c] 1,2 [-f] 16 [-b] 0 [-w] 256,1024 [-t] 5 [-m] 0\n"
+                    "\t\ttest demo: abench -r 48000 -c 2 -w 480 -m 1\n"
+    },
+#endif
+
+#ifdef CONFIG_CMD_ATRACE
+    {
+        (const u8 *)"atrace", 1, atrace_cmd_thread,
+        (const u8 *)"\tatrace\n"
+                    "\t\ttest cmd: atrace [-v] list_entries [-c] clear\n"
+                    "\t\tdump the audio gdma irq trace: execution time percentiles, max irq interval, xruns\n"
+                    "\t\tdefault params: [-v] 0 [-c] 0\n"
+                    "\t\ttest demo: atrace -v 1 -c 1\n"
+    },
+#endif
 };
\ No newline at end of file
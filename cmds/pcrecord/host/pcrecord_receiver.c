@@ -0,0 +1,826 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Reference receiver of the pcrecord uart protocol for linux. It configures and starts a
+ * capture, checks every data message and writes the audio to a wav file. flac captures are
+ * also kept as the .flac stream the device sent. Control messages are the binary frames of
+ * audio_cmds/audio_uart_frame.h, or json for devices built with PR_UART_USE_JSON.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FLAC/stream_decoder.h"
+#include "opus_multistream.h"
+
+#define PR_DATA_HEADER_LEN      15
+#define PR_MAX_PAYLOAD          32767
+#define PR_MAX_JSON             1024
+#define PR_MAX_CHANNELS         8
+/* RECORD_PAGE_SIZE of pcrecord.c, the size of a dropped pcm page */
+#define PR_PAGE_SIZE            2048
+#define PR_REPLY_TIMEOUT_MS     2000
+#define PR_OPUS_MAX_FRAME       (48000 * 120 / 1000)
+
+/* audio_uart_frame.h */
+#define PR_FRAME_SOF0           0xA5
+#define PR_FRAME_SOF1           0x5A
+#define PR_FRAME_HEADER_LEN     8
+#define PR_FRAME_MAX_PAYLOAD    256
+
+/* pcrecord.h */
+#define PR_MSG_ACK              0x00
+#define PR_MSG_ERROR            0x01
+#define PR_MSG_CONFIG           0x02
+#define PR_MSG_START            0x03
+#define PR_MSG_STOP             0x04
+#define PR_MSG_QUERY            0x06
+#define PR_CONFIG_LEN           46
+
+/* audio_type.h */
+#define AUDIO_FORMAT_PCM_16_BIT 0x02
+#define AUDIO_FORMAT_PCM_24_BIT 0x10
+
+enum {
+    CODEC_PCM,
+    CODEC_FLAC,
+    CODEC_OPUS,
+};
+
+static const char *const g_codec_names[] = {"pcm", "flac", "opus"};
+static const char *const g_msg_names[] = {"ack", "error", "config", "start", "stop", "data", "query", "volume"};
+
+typedef struct {
+    const char *device;
+    const char *input;
+    const char *raw;
+    const char *output;
+    int rate;
+    int chnum;
+    int bits;
+    int codec;
+    int level;
+    int bitrate;
+    int seconds;
+    int use_json;
+    int chl[PR_MAX_CHANNELS];
+} receiver_config_t;
+
+typedef struct {
+    int is_data;
+    int is_error;
+    /* json reply, or the text of a reply frame */
+    char json[PR_MAX_JSON + 1];
+    uint32_t seq;
+    uint32_t dropped;
+    int len;
+    int checksum;
+    unsigned char payload[PR_MAX_PAYLOAD];
+} receiver_msg_t;
+
+typedef struct {
+    const receiver_config_t *config;
+    int fd;
+    int is_tty;
+    FILE *raw;
+    FILE *wav;
+    FILE *flac;
+    char flac_path[256];
+    OpusMSDecoder *opus;
+    opus_int16 opus_pcm[PR_OPUS_MAX_FRAME * PR_MAX_CHANNELS];
+    uint32_t wav_bytes;
+    uint32_t msgs;
+    uint64_t bytes;
+    uint32_t bad_checksum;
+    uint32_t lost;
+    uint32_t skipped;
+    uint32_t last_seq;
+    uint32_t dropped;
+    int have_seq;
+    uint16_t frame_seq;
+} receiver_t;
+
+static receiver_msg_t g_msg;
+static volatile sig_atomic_t g_stop;
+
+static void on_signal(int sig)
+{
+    (void) sig;
+    g_stop = 1;
+}
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int open_uart(const char *device)
+{
+    struct termios tio;
+    int fd = open(device, O_RDWR | O_NOCTTY);
+
+    if (fd < 0) {
+        fprintf(stderr, "open %s: %s\n", device, strerror(errno));
+        return -1;
+    }
+
+    memset(&tio, 0, sizeof(tio));
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, B1500000);
+    cfsetospeed(&tio, B1500000);
+    if (tcsetattr(fd, TCSANOW, &tio) < 0) {
+        fprintf(stderr, "set %s to 1500000 baud: %s\n", device, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+/* len bytes or -1 at the end of the input or the timeout */
+static int read_bytes(receiver_t *rx, void *buf, int len, int timeout_ms)
+{
+    unsigned char *p = (unsigned char *)buf;
+    uint64_t end = now_ms() + timeout_ms;
+    int got = 0;
+
+    while (got < len) {
+        ssize_t n;
+
+        if (rx->is_tty) {
+            int64_t left = (int64_t)(end - now_ms());
+            struct timeval tv;
+            fd_set fds;
+
+            if (left <= 0) {
+                return -1;
+            }
+            tv.tv_sec = left / 1000;
+            tv.tv_usec = (left % 1000) * 1000;
+            FD_ZERO(&fds);
+            FD_SET(rx->fd, &fds);
+            if (select(rx->fd + 1, &fds, NULL, NULL, &tv) <= 0) {
+                continue;
+            }
+        }
+
+        n = read(rx->fd, p + got, len - got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            if (rx->is_tty && n == 0) {
+                continue;
+            }
+            return -1;
+        }
+        if (rx->raw) {
+            fwrite(p + got, 1, n, rx->raw);
+        }
+        got += n;
+    }
+    return got;
+}
+
+/* CRC-16/CCITT-FALSE of the frames */
+static uint16_t frame_crc16(const unsigned char *data, int len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? (uint16_t)(crc << 1) ^ 0x1021 : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static const char *msg_name(int type)
+{
+    return type < (int)(sizeof(g_msg_names) / sizeof(g_msg_names[0])) ? g_msg_names[type] : "unknown";
+}
+
+/* rest of a reply frame after its first byte, 0 with the reply as text in g_msg */
+static int read_frame(receiver_t *rx)
+{
+    unsigned char frame[PR_FRAME_HEADER_LEN + PR_FRAME_MAX_PAYLOAD + 2];
+    unsigned char *payload = frame + PR_FRAME_HEADER_LEN;
+    int type;
+    int len;
+
+    frame[0] = PR_FRAME_SOF0;
+    if (read_bytes(rx, frame + 1, PR_FRAME_HEADER_LEN - 1, PR_REPLY_TIMEOUT_MS) != PR_FRAME_HEADER_LEN - 1 ||
+        frame[1] != PR_FRAME_SOF1) {
+        return -1;
+    }
+    type = frame[2];
+    len = frame[6] | frame[7] << 8;
+    if (len > PR_FRAME_MAX_PAYLOAD || read_bytes(rx, payload, len + 2, PR_REPLY_TIMEOUT_MS) != len + 2 ||
+        frame_crc16(frame + 2, PR_FRAME_HEADER_LEN - 2 + len) != (payload[len] | payload[len + 1] << 8)) {
+        return -1;
+    }
+
+    g_msg.is_data = 0;
+    g_msg.is_error = type == PR_MSG_ERROR;
+    if ((type == PR_MSG_ACK || type == PR_MSG_ERROR) && len >= 2) {
+        snprintf(g_msg.json, sizeof(g_msg.json), "%s %s, status %d", msg_name(type), msg_name(payload[0]),
+                 (signed char)payload[1]);
+    } else if (type == PR_MSG_QUERY && len >= 3 && 3 + payload[1] <= len &&
+               3 + payload[1] + payload[2 + payload[1]] <= len) {
+        int version_len = payload[1];
+        int codecs_len = payload[2 + version_len];
+
+        snprintf(g_msg.json, sizeof(g_msg.json), "status %s, version %.*s, codecs %.*s", payload[0] ? "busy" : "idle",
+                 version_len, (const char *)payload + 2, codecs_len, (const char *)payload + 3 + version_len);
+    } else {
+        snprintf(g_msg.json, sizeof(g_msg.json), "%s, %d bytes", msg_name(type), len);
+    }
+    return 0;
+}
+
+/* 0 with a message in g_msg, -1 when nothing came before the timeout */
+static int read_message(receiver_t *rx, int timeout_ms)
+{
+    unsigned char c;
+    unsigned char header[PR_DATA_HEADER_LEN];
+    int16_t len;
+
+    while (read_bytes(rx, &c, 1, timeout_ms) == 1) {
+        if (c == PR_FRAME_SOF0) {
+            if (read_frame(rx) == 0) {
+                return 0;
+            }
+            rx->skipped++;
+            continue;
+        }
+
+        if (c == '{') {
+            int depth = 1;
+            int n = 0;
+
+            g_msg.json[n++] = c;
+            while (depth && read_bytes(rx, &c, 1, PR_REPLY_TIMEOUT_MS) == 1) {
+                depth += c == '{' ? 1 : c == '}' ? -1 : 0;
+                if (n < PR_MAX_JSON) {
+                    g_msg.json[n++] = c;
+                }
+            }
+            g_msg.json[n] = '\0';
+            g_msg.is_data = 0;
+            g_msg.is_error = strstr(g_msg.json, "\"error\"") != NULL;
+            return depth ? -1 : 0;
+        }
+
+        if (c != 'd') {
+            rx->skipped++;
+            continue;
+        }
+        header[0] = c;
+        if (read_bytes(rx, header + 1, 3, PR_REPLY_TIMEOUT_MS) != 3 || memcmp(header, "data", 4)) {
+            rx->skipped += 4;
+            continue;
+        }
+        if (read_bytes(rx, header + 4, PR_DATA_HEADER_LEN - 4, PR_REPLY_TIMEOUT_MS) != PR_DATA_HEADER_LEN - 4) {
+            return -1;
+        }
+        memcpy(&g_msg.seq, header + 4, 4);
+        memcpy(&len, header + 8, 2);
+        g_msg.checksum = header[10];
+        memcpy(&g_msg.dropped, header + 11, 4);
+        if (len <= 0) {
+            rx->skipped += PR_DATA_HEADER_LEN;
+            continue;
+        }
+        g_msg.len = len;
+        if (read_bytes(rx, g_msg.payload, len, PR_REPLY_TIMEOUT_MS) != len) {
+            return -1;
+        }
+        g_msg.is_data = 1;
+        return 0;
+    }
+    return -1;
+}
+
+static void wav_write_header(FILE *wav, const receiver_config_t *config, uint32_t data_bytes)
+{
+    uint32_t block = config->chnum * config->bits / 8;
+    unsigned char h[44];
+    uint32_t v32;
+    uint16_t v16;
+
+    memcpy(h, "RIFF", 4);
+    v32 = 36 + data_bytes;
+    memcpy(h + 4, &v32, 4);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    v32 = 16;
+    memcpy(h + 16, &v32, 4);
+    v16 = 1;
+    memcpy(h + 20, &v16, 2);
+    v16 = config->chnum;
+    memcpy(h + 22, &v16, 2);
+    v32 = config->rate;
+    memcpy(h + 24, &v32, 4);
+    v32 = config->rate * block;
+    memcpy(h + 28, &v32, 4);
+    v16 = block;
+    memcpy(h + 32, &v16, 2);
+    v16 = config->bits;
+    memcpy(h + 34, &v16, 2);
+    memcpy(h + 36, "data", 4);
+    memcpy(h + 40, &data_bytes, 4);
+
+    fseek(wav, 0, SEEK_SET);
+    fwrite(h, 1, sizeof(h), wav);
+    fseek(wav, 0, SEEK_END);
+}
+
+static void wav_write(receiver_t *rx, const void *data, uint32_t bytes)
+{
+    fwrite(data, 1, bytes, rx->wav);
+    rx->wav_bytes += bytes;
+}
+
+static void handle_data(receiver_t *rx)
+{
+    const receiver_config_t *config = rx->config;
+    unsigned char checksum = 0;
+    uint32_t gap = 0;
+
+    for (int i = 0; i < g_msg.len; i++) {
+        checksum ^= g_msg.payload[i];
+    }
+    rx->msgs++;
+    rx->bytes += PR_DATA_HEADER_LEN + g_msg.len;
+    if (checksum != g_msg.checksum) {
+        rx->bad_checksum++;
+        return;
+    }
+
+    /* pcm sequence numbers count the pages the device dropped, encoded ones count messages */
+    if (rx->have_seq && g_msg.seq > rx->last_seq + 1) {
+        gap = g_msg.seq - rx->last_seq - 1;
+        if (config->codec == CODEC_PCM) {
+            gap -= g_msg.dropped - rx->dropped;
+        }
+        rx->lost += gap;
+    }
+    if (g_msg.dropped != rx->dropped) {
+        fprintf(stderr, "device dropped %u pages before seq %u\n", g_msg.dropped - rx->dropped, g_msg.seq);
+    }
+
+    switch (config->codec) {
+    case CODEC_PCM: {
+        /* keep the timing, missing pages become silence */
+        static const unsigned char silence[PR_PAGE_SIZE];
+        uint32_t pages = rx->have_seq ? g_msg.seq - rx->last_seq - 1 : 0;
+
+        for (uint32_t i = 0; i < pages; i++) {
+            wav_write(rx, silence, PR_PAGE_SIZE);
+        }
+        wav_write(rx, g_msg.payload, g_msg.len);
+        break;
+    }
+    case CODEC_FLAC:
+        fwrite(g_msg.payload, 1, g_msg.len, rx->flac);
+        break;
+    case CODEC_OPUS: {
+        int frames;
+
+        /* packet loss concealment for the packets lost on the uart */
+        for (uint32_t i = 0; i < gap; i++) {
+            frames = opus_multistream_decode(rx->opus, NULL, 0, rx->opus_pcm, config->rate / 50, 0);
+            if (frames > 0) {
+                wav_write(rx, rx->opus_pcm, frames * config->chnum * 2);
+            }
+        }
+        frames = opus_multistream_decode(rx->opus, g_msg.payload, g_msg.len, rx->opus_pcm, PR_OPUS_MAX_FRAME, 0);
+        if (frames < 0) {
+            fprintf(stderr, "opus decode seq %u: %s\n", g_msg.seq, opus_strerror(frames));
+        } else {
+            wav_write(rx, rx->opus_pcm, frames * config->chnum * 2);
+        }
+        break;
+    }
+    }
+
+    rx->have_seq = 1;
+    rx->last_seq = g_msg.seq;
+    rx->dropped = g_msg.dropped;
+}
+
+static FLAC__StreamDecoderWriteStatus flac_write(const FLAC__StreamDecoder *decoder, const FLAC__Frame *frame,
+        const FLAC__int32 *const buffer[], void *client_data)
+{
+    (void) decoder;
+    receiver_t *rx = (receiver_t *)client_data;
+    int bytes = rx->config->bits / 8;
+    unsigned char sample[4];
+
+    if (frame->header.channels != (uint32_t)rx->config->chnum ||
+        frame->header.bits_per_sample != (uint32_t)rx->config->bits) {
+        fprintf(stderr, "flac frame is %u ch %u bit, the capture %d ch %d bit\n", frame->header.channels,
+                frame->header.bits_per_sample, rx->config->chnum, rx->config->bits);
+        return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+    }
+
+    for (uint32_t i = 0; i < frame->header.blocksize; i++) {
+        for (uint32_t ch = 0; ch < frame->header.channels; ch++) {
+            uint32_t v = (uint32_t)buffer[ch][i];
+
+            for (int b = 0; b < bytes; b++) {
+                sample[b] = v >> (8 * b);
+            }
+            wav_write(rx, sample, bytes);
+        }
+    }
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+static void flac_error(const FLAC__StreamDecoder *decoder, FLAC__StreamDecoderErrorStatus status, void *client_data)
+{
+    (void) decoder;
+    (void) client_data;
+    fprintf(stderr, "flac: %s\n", FLAC__StreamDecoderErrorStatusString[status]);
+}
+
+static int decode_flac(receiver_t *rx)
+{
+    FLAC__StreamDecoder *decoder = FLAC__stream_decoder_new();
+    int ret = 0;
+
+    if (!decoder) {
+        return -1;
+    }
+    if (FLAC__stream_decoder_init_file(decoder, rx->flac_path, flac_write, NULL, flac_error, rx) !=
+        FLAC__STREAM_DECODER_INIT_STATUS_OK || !FLAC__stream_decoder_process_until_end_of_stream(decoder)) {
+        fprintf(stderr, "decode %s: %s\n", rx->flac_path,
+                FLAC__StreamDecoderStateString[FLAC__stream_decoder_get_state(decoder)]);
+        ret = -1;
+    }
+    FLAC__stream_decoder_finish(decoder);
+    FLAC__stream_decoder_delete(decoder);
+    return ret;
+}
+
+static void send_json(receiver_t *rx, const char *json)
+{
+    if (write(rx->fd, json, strlen(json)) < 0) {
+        fprintf(stderr, "write: %s\n", strerror(errno));
+    }
+}
+
+static void send_frame(receiver_t *rx, int type, const unsigned char *payload, int len)
+{
+    unsigned char frame[PR_FRAME_HEADER_LEN + PR_FRAME_MAX_PAYLOAD + 2];
+    uint16_t crc;
+
+    rx->frame_seq++;
+    frame[0] = PR_FRAME_SOF0;
+    frame[1] = PR_FRAME_SOF1;
+    frame[2] = type;
+    frame[3] = 0;
+    frame[4] = rx->frame_seq & 0xff;
+    frame[5] = rx->frame_seq >> 8;
+    frame[6] = len & 0xff;
+    frame[7] = len >> 8;
+    memcpy(frame + PR_FRAME_HEADER_LEN, payload, len);
+    crc = frame_crc16(frame + 2, PR_FRAME_HEADER_LEN - 2 + len);
+    frame[PR_FRAME_HEADER_LEN + len] = crc & 0xff;
+    frame[PR_FRAME_HEADER_LEN + len + 1] = crc >> 8;
+    if (write(rx->fd, frame, PR_FRAME_HEADER_LEN + len + 2) < 0) {
+        fprintf(stderr, "write: %s\n", strerror(errno));
+    }
+}
+
+static void put_u32(unsigned char *p, uint32_t v)
+{
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = v >> 24;
+}
+
+static void send_config(receiver_t *rx)
+{
+    const receiver_config_t *config = rx->config;
+    int format = config->bits == 24 ? AUDIO_FORMAT_PCM_24_BIT : AUDIO_FORMAT_PCM_16_BIT;
+
+    if (config->use_json) {
+        char json[PR_MAX_JSON];
+        int n;
+
+        n = snprintf(json, sizeof(json), "{\"type\":\"config\",\"mode\":0,\"record\":{\"sample_rate\":%d,\"device\":1,"
+                     "\"format\":%d,\"chl_num\":%d", config->rate, format, config->chnum);
+        for (int i = 0; i < PR_MAX_CHANNELS; i++) {
+            n += snprintf(json + n, sizeof(json) - n, ",\"chl%d\":%d", i + 1, config->chl[i]);
+        }
+        snprintf(json + n, sizeof(json) - n, ",\"codec\":\"%s\",\"level\":%d,\"bitrate\":%d}}",
+                 g_codec_names[config->codec], config->level, config->bitrate);
+        send_json(rx, json);
+    } else {
+        unsigned char payload[PR_CONFIG_LEN];
+
+        put_u32(payload, config->rate);
+        payload[4] = 1;
+        payload[5] = format;
+        payload[6] = config->chnum;
+        payload[7] = 0;
+        for (int i = 0; i < PR_MAX_CHANNELS; i++) {
+            put_u32(payload + 8 + i * 4, config->chl[i]);
+        }
+        payload[40] = config->codec;
+        payload[41] = config->level;
+        put_u32(payload + 42, config->bitrate);
+        send_frame(rx, PR_MSG_CONFIG, payload, PR_CONFIG_LEN);
+    }
+}
+
+/* query, start and stop carry nothing but their type */
+static void send_request(receiver_t *rx, int type)
+{
+    char json[64];
+
+    if (rx->config->use_json) {
+        snprintf(json, sizeof(json), "{\"type\":\"%s\"}", msg_name(type));
+        send_json(rx, json);
+    } else {
+        send_frame(rx, type, NULL, 0);
+    }
+}
+
+/* 0 on an ack, data that comes before it is kept */
+static int wait_reply(receiver_t *rx, const char *what)
+{
+    uint64_t end = now_ms() + PR_REPLY_TIMEOUT_MS;
+
+    while (now_ms() < end) {
+        if (read_message(rx, PR_REPLY_TIMEOUT_MS)) {
+            break;
+        }
+        if (g_msg.is_data) {
+            handle_data(rx);
+            continue;
+        }
+        printf("%s: %s\n", what, g_msg.json);
+        return g_msg.is_error ? -1 : 0;
+    }
+    fprintf(stderr, "%s: no reply\n", what);
+    return -1;
+}
+
+static int record(receiver_t *rx)
+{
+    const receiver_config_t *config = rx->config;
+    uint64_t end;
+
+    send_request(rx, PR_MSG_QUERY);
+    if (wait_reply(rx, "query")) {
+        return -1;
+    }
+
+    send_config(rx);
+    if (wait_reply(rx, "config")) {
+        return -1;
+    }
+
+    send_request(rx, PR_MSG_START);
+    if (wait_reply(rx, "start")) {
+        return -1;
+    }
+
+    end = now_ms() + (uint64_t)config->seconds * 1000;
+    while (!g_stop && now_ms() < end) {
+        if (read_message(rx, 100) == 0) {
+            if (g_msg.is_data) {
+                handle_data(rx);
+            } else {
+                printf("%s\n", g_msg.json);
+            }
+        }
+    }
+
+    send_request(rx, PR_MSG_STOP);
+    return wait_reply(rx, "stop");
+}
+
+static int parse_codec(const char *name)
+{
+    for (int i = 0; i < (int)(sizeof(g_codec_names) / sizeof(g_codec_names[0])); i++) {
+        if (!strcmp(name, g_codec_names[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void usage(const char *name)
+{
+    printf("usage: %s [options] <out.wav>\n"
+           "  -d <tty>       uart of the device, default /dev/ttyUSB0\n"
+           "  -i <file>      decode a saved uart stream instead of recording\n"
+           "  -s <file>      save the uart stream\n"
+           "  -r <rate>      sample rate, default 16000\n"
+           "  -c <channels>  channels, default 2\n"
+           "  -b <16|24>     bits per sample, default 16, 24 is flac only\n"
+           "  -m <v,v,...>   chl1~chl8 values of the config message, default amic 1~channels\n"
+           "  -x <codec>     pcm, flac or opus, default pcm\n"
+           "  -l <level>     flac compression level, default 0\n"
+           "  -k <bitrate>   opus bits per second of each channel, default 32000\n"
+           "  -t <seconds>   record time, default 10\n"
+           "  -j             json control messages, for devices built with PR_UART_USE_JSON\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    receiver_config_t config = {
+        .device = "/dev/ttyUSB0",
+        .rate = 16000,
+        .chnum = 2,
+        .bits = 16,
+        .codec = CODEC_PCM,
+        .bitrate = 32000,
+        .seconds = 10,
+    };
+    static receiver_t rx;
+    const char *mics = NULL;
+    int opt;
+    int ret = 0;
+
+    while ((opt = getopt(argc, argv, "d:i:s:r:c:b:m:x:l:k:t:jh")) != -1) {
+        switch (opt) {
+        case 'd':
+            config.device = optarg;
+            break;
+        case 'i':
+            config.input = optarg;
+            break;
+        case 's':
+            config.raw = optarg;
+            break;
+        case 'r':
+            config.rate = atoi(optarg);
+            break;
+        case 'c':
+            config.chnum = atoi(optarg);
+            break;
+        case 'b':
+            config.bits = atoi(optarg);
+            break;
+        case 'm':
+            mics = optarg;
+            break;
+        case 'x':
+            config.codec = parse_codec(optarg);
+            break;
+        case 'l':
+            config.level = atoi(optarg);
+            break;
+        case 'k':
+            config.bitrate = atoi(optarg);
+            break;
+        case 't':
+            config.seconds = atoi(optarg);
+            break;
+        case 'j':
+            config.use_json = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1 || config.codec < 0 || config.chnum < 1 || config.chnum > PR_MAX_CHANNELS ||
+        (config.bits != 16 && config.bits != 24) || (config.bits == 24 && config.codec == CODEC_OPUS)) {
+        usage(argv[0]);
+        return 1;
+    }
+    config.output = argv[optind];
+
+    /* unused channels are 0xffff, no amic and no dmic */
+    for (int i = 0; i < PR_MAX_CHANNELS; i++) {
+        config.chl[i] = i < config.chnum ? 0xff00 | (i + 1) : 0xffff;
+    }
+    for (int i = 0; mics && *mics && i < PR_MAX_CHANNELS; i++) {
+        char *next;
+
+        config.chl[i] = strtol(mics, &next, 0);
+        mics = *next == ',' ? next + 1 : next;
+    }
+
+    rx.config = &config;
+    rx.wav = fopen(config.output, "wb+");
+    if (!rx.wav) {
+        fprintf(stderr, "open %s: %s\n", config.output, strerror(errno));
+        return 1;
+    }
+    wav_write_header(rx.wav, &config, 0);
+
+    if (config.codec == CODEC_FLAC) {
+        const char *dot = strrchr(config.output, '.');
+        int stem = dot ? (int)(dot - config.output) : (int)strlen(config.output);
+
+        snprintf(rx.flac_path, sizeof(rx.flac_path), "%.*s.flac", stem, config.output);
+        rx.flac = fopen(rx.flac_path, "wb");
+        if (!rx.flac) {
+            fprintf(stderr, "open %s: %s\n", rx.flac_path, strerror(errno));
+            return 1;
+        }
+    } else if (config.codec == CODEC_OPUS) {
+        unsigned char mapping[PR_MAX_CHANNELS];
+        int error;
+
+        /* same layout as the device, one mono stream per channel */
+        for (int i = 0; i < config.chnum; i++) {
+            mapping[i] = i;
+        }
+        rx.opus = opus_multistream_decoder_create(config.rate, config.chnum, config.chnum, 0, mapping, &error);
+        if (!rx.opus) {
+            fprintf(stderr, "opus decoder: %s\n", opus_strerror(error));
+            return 1;
+        }
+    }
+
+    if (config.raw) {
+        rx.raw = fopen(config.raw, "wb");
+    }
+
+    signal(SIGINT, on_signal);
+    if (config.input) {
+        rx.fd = open(config.input, O_RDONLY);
+        if (rx.fd < 0) {
+            fprintf(stderr, "open %s: %s\n", config.input, strerror(errno));
+            return 1;
+        }
+        while (!g_stop && read_message(&rx, 0) == 0) {
+            if (g_msg.is_data) {
+                handle_data(&rx);
+            } else {
+                printf("%s\n", g_msg.json);
+            }
+        }
+    } else {
+        rx.fd = open_uart(config.device);
+        if (rx.fd < 0) {
+            return 1;
+        }
+        rx.is_tty = 1;
+        ret = record(&rx);
+    }
+    close(rx.fd);
+
+    if (rx.flac) {
+        fclose(rx.flac);
+        if (rx.msgs && decode_flac(&rx)) {
+            ret = -1;
+        }
+    }
+    if (rx.opus) {
+        opus_multistream_decoder_destroy(rx.opus);
+    }
+    if (rx.raw) {
+        fclose(rx.raw);
+    }
+    wav_write_header(rx.wav, &config, rx.wav_bytes);
+    fclose(rx.wav);
+
+    printf("%u messages, %llu bytes, %u bad checksum, %u lost on the uart, %u pages dropped by the device, "
+           "%u bytes out of sync\n", rx.msgs, (unsigned long long)rx.bytes, rx.bad_checksum, rx.lost, rx.dropped,
+           rx.skipped);
+    if (rx.wav_bytes) {
+        uint32_t block = config.chnum * config.bits / 8;
+        double seconds = (double)rx.wav_bytes / block / config.rate;
+
+        printf("%s: %.2f s, %.1f kbit/s on the uart, %.1f%% of pcm\n", config.output, seconds,
+               rx.bytes * 8 / seconds / 1000, rx.bytes * 100.0 / rx.wav_bytes);
+    }
+    return ret ? 1 : 0;
+}
@@ -17,6 +17,8 @@
 
 #include "log/log.h"
 #include "pcrecord.h"
+#include "pcrecord_codec.h"
+#include "audio_uart_frame.h"
 
 #ifdef CONFIG_AUDIO_MIXER
 #include "audio/audio_service.h"
@@ -37,24 +39,54 @@ extern s32 wifi_get_join_status(u8 *join_status);
 #define PR_UART_TX          PA_25
 #define PR_UART_RX          PA_24
 #define PR_UART_USE_DMA_TX  1
+/* 1: json control messages found by counting braces in the rx irq, for tools older than the binary frames */
+#define PR_UART_USE_JSON    0
+#if PR_UART_USE_DMA_TX
+#define PR_TX_TASK_PRIORITY 8
+#else
+/* serial_putc busy waits, keep it under the other tasks */
+#define PR_TX_TASK_PRIORITY 3
+#endif
 
 #define PR_BAUDRATE         1500000
 #define PC_BUFLEN           1024
-#define RECORD_PAGE_NUM     2
+/* pages between the recorder and the uart, how much uart lag a capture rides out before dropping */
+#ifndef RECORD_PAGE_NUM
+#define RECORD_PAGE_NUM     8
+#endif
 #define RECORD_PAGE_SIZE    2048
+/* "data", seq, payload length, payload checksum, pages dropped so far */
+#define PR_DATA_HEADER_LEN  15
+#define PR_FLAC_LEVEL       0
+#define PR_OPUS_BITRATE     32000
 
 #define MAX_URL_LEN         64
 #define SERVER_PORT         80
 
+#if PR_UART_USE_JSON
 static int start_cnt = 0;
 static int end_cnt = 0;
 
 unsigned char pc_buf[PC_BUFLEN];
-char record_buf[RECORD_PAGE_NUM * RECORD_PAGE_SIZE]__attribute__((aligned(64)));
-char tx_buf[RECORD_PAGE_SIZE];
 int pc_datasize = 0;
 rtos_sema_t pr_rx_sema;
+#else
+static struct audio_uart_frame_rx pr_frame_rx;
+/* replies go out by dma from here, only the rx task writes it */
+static uint8_t pr_reply_frame[AUDIO_UART_FRAME_MAX_LEN] __attribute__((aligned(32)));
+/* frame being handled, replies echo its type and seq */
+static const struct audio_uart_frame *pr_request = NULL;
+#endif
+char record_buf[RECORD_PAGE_NUM * RECORD_PAGE_SIZE]__attribute__((aligned(64)));
+/* reads land here while the ring is full, the record must keep being drained */
+static char record_drop_buf[RECORD_PAGE_SIZE]__attribute__((aligned(64)));
+/* sent by dma after pc_msg_audio_data_binary returns, so it cannot live on the stack */
+static unsigned char pr_data_header[PR_DATA_HEADER_LEN];
+static pr_page_t pr_pages[RECORD_PAGE_NUM];
+/* encoder between the ring and the uart, NULL sends the pages as they are */
+static struct pr_codec *pr_codec = NULL;
 rtos_sema_t pr_dma_tx_sema;
+rtos_sema_t pr_page_sema;
 rtos_mutex_t pr_tx_mutex;
 struct AudioRecord *audio_record = NULL;
 rtos_task_t record_task;
@@ -62,6 +94,7 @@ rtos_task_t tx_task;
 rtos_task_t playback_task;
 
 volatile bool recorder_is_running = false;
+volatile bool sender_is_running = false;
 volatile bool player_is_running = false;
 
 struct list_head pr_url_list;
@@ -100,6 +133,7 @@ static unsigned short sine_48000[96] = {
 };
 #endif
 
+#if PR_UART_USE_JSON
 const struct pr_msg pr_msg_type[] = {
     {PR_MSG_ACK,        "ack"       },
     {PR_MSG_ERROR,      "error"     },
@@ -110,9 +144,11 @@ const struct pr_msg pr_msg_type[] = {
     {PR_MSG_QUERY,      "query"     },
     {PR_MSG_VOLUME,     "volume"    },
 };
+#endif
 
 void pc_recorder_start(msg_attrib_t *pattrib);
 void pc_playback_task(void *param);
+void pc_codec_output(void *priv, const unsigned char *data, int len);
 
 #if defined(CONFIG_MEDIA_PLAYER) && CONFIG_MEDIA_PLAYER
 void OnStateChangedPC(const struct MediaPlayerCallback *listener, const struct MediaPlayer *player, int state)
@@ -291,6 +327,16 @@ void pr_uart_send_string(char *pstr, int len)
 #endif
 }
 
+/* the buffer passed to pr_uart_send_string can be reused or freed after this */
+void pr_uart_wait_send_done(void)
+{
+#if PR_UART_USE_DMA_TX
+    rtos_sema_take(pr_dma_tx_sema, RTOS_MAX_TIMEOUT);
+    rtos_sema_give(pr_dma_tx_sema);
+#endif
+}
+
+#if PR_UART_USE_JSON
 void pr_uart_irq(uint32_t id, SerialIrq event)
 {
     serial_t    *sobj = (serial_t *)id;
@@ -317,6 +363,27 @@ void pr_uart_irq(uint32_t id, SerialIrq event)
         }
     }
 }
+#else
+/* payload is already at AUDIO_UART_FRAME_PAYLOAD(pr_reply_frame) */
+static void pc_frame_reply(uint8_t type, uint16_t len)
+{
+    int frame_len = audio_uart_frame_pack(pr_reply_frame, type, pr_request ? pr_request->seq : 0, NULL, len);
+
+    rtos_mutex_take(pr_tx_mutex, MUTEX_WAIT_TIMEOUT);
+    pr_uart_send_string((char *)pr_reply_frame, frame_len);
+    pr_uart_wait_send_done();
+    rtos_mutex_give(pr_tx_mutex);
+}
+
+static void pc_frame_ack(int status)
+{
+    uint8_t *payload = AUDIO_UART_FRAME_PAYLOAD(pr_reply_frame);
+
+    payload[0] = pr_request ? pr_request->type : PR_MSG_ERROR;
+    payload[1] = (uint8_t)(int8_t)status;
+    pc_frame_reply(status >= 0 ? PR_MSG_ACK : PR_MSG_ERROR, 2);
+}
+#endif
 
 static void uart_dma_tx_done(uint32_t id)
 {
@@ -334,8 +401,10 @@ void pr_uart_init_mbed(void)
 
     serial_rx_fifo_level(&pr_sobj, FifoLvHalf);
     serial_set_flow_control(&pr_sobj, FlowControlNone, 0, 0);
+#if PR_UART_USE_JSON
     serial_irq_handler(&pr_sobj, pr_uart_irq, (uint32_t)&pr_sobj);
     serial_irq_set(&pr_sobj, RxIrq, ENABLE);
+#endif
 #if PR_UART_USE_DMA_TX
     serial_send_comp_handler(&pr_sobj, (void *)uart_dma_tx_done, (uint32_t) &pr_sobj);
 #endif
@@ -343,6 +412,7 @@ void pr_uart_init_mbed(void)
 
 int pr_audiorecord_query(void)
 {
+#if PR_UART_USE_JSON
     cJSON *msg_obj;
     char *msg_js = NULL;
 
@@ -352,6 +422,7 @@ int pr_audiorecord_query(void)
 
     cJSON_AddStringToObject(msg_obj, "type", "query");
     cJSON_AddStringToObject(msg_obj, "version", PR_VERSION);
+    cJSON_AddStringToObject(msg_obj, "codecs", pr_codec_names());
 
     switch (pr_adapter.record_status) {
     case RECORD_IDLE:
@@ -368,8 +439,25 @@ int pr_audiorecord_query(void)
     MEDIA_LOGD("[PCRECORD INFO] %s, %s", __func__, msg_js);
     rtos_mutex_take(pr_tx_mutex, MUTEX_WAIT_TIMEOUT);
     pr_uart_send_string(msg_js, strlen(msg_js));
+    pr_uart_wait_send_done();
     rtos_mutex_give(pr_tx_mutex);
     rtos_mem_free(msg_js);
+#else
+    uint8_t *payload = AUDIO_UART_FRAME_PAYLOAD(pr_reply_frame);
+    const char *codecs = pr_codec_names();
+    int len = 0;
+
+    payload[len++] = pr_adapter.record_status;
+    payload[len++] = strlen(PR_VERSION);
+    memcpy(payload + len, PR_VERSION, strlen(PR_VERSION));
+    len += strlen(PR_VERSION);
+    payload[len++] = strlen(codecs);
+    memcpy(payload + len, codecs, strlen(codecs));
+    len += strlen(codecs);
+
+    MEDIA_LOGD("[PCRECORD INFO] %s, status %d, version %s, codecs %s", __func__, pr_adapter.record_status, PR_VERSION, codecs);
+    pc_frame_reply(PR_MSG_QUERY, len);
+#endif
 
     return 0;
 }
@@ -378,9 +466,6 @@ int pr_audiorecord_config(msg_attrib_t *pattrib)
 {
     MEDIA_LOGD("[PCRECORD INFO] ================>Free Heap: %d", (int)rtos_mem_get_free_heap_size());
 
-    pr_adapter.rx_cnt = 0;
-    pr_adapter.tx_cnt = 0;
-
     audio_record = AudioRecord_Create();
     if (!audio_record) {
         MEDIA_LOGE("[PCRECORD INFO] record create failed");
@@ -414,6 +499,23 @@ int pr_audiorecord_start(msg_attrib_t *pattrib)
         MEDIA_LOGE("[PCRECORD INFO] record start fail");
         return -1;
     }
+
+    /* the sender of a running record owns the codec */
+    if (pattrib->codec != PR_CODEC_PCM && !recorder_is_running && !sender_is_running) {
+        pr_codec_config_t codec_config;
+
+        codec_config.codec = pattrib->codec;
+        codec_config.samplerate = pattrib->samplerate;
+        codec_config.chnum = pattrib->chnum;
+        codec_config.format = pattrib->format;
+        codec_config.level = pattrib->codec_level;
+        codec_config.bitrate = pattrib->codec_bitrate;
+        pr_codec = pr_codec_open(&codec_config, pc_codec_output, NULL);
+        if (!pr_codec) {
+            MEDIA_LOGE("[PCRECORD INFO] codec open fail");
+            return -1;
+        }
+    }
     AudioRecord_Start(audio_record);
 
     for (int i = 0; i < pattrib->adcindex; i++) {
@@ -448,25 +550,29 @@ int pr_audiorecord_stop(void)
     return 0;
 }
 
-int pc_msg_audio_data_binary(int seq, char *data, int data_len)
+int pc_msg_audio_data_binary(int seq, int dropped, char *data, int data_len)
 {
-    unsigned char buf[MAX_URL_LEN];
+    unsigned char *buf = pr_data_header;
     unsigned char checksum = 0;
     unsigned int offset = 0;
+    short len = data_len;
 
     for (int i = 0; i < data_len; i++) {
         checksum ^= data[i];
     }
 
+    rtos_mutex_take(pr_tx_mutex, MUTEX_WAIT_TIMEOUT);
+    /* the header dma is done once the data dma before it has started, so the buffer is free here */
     memcpy(buf, "data", strlen("data"));
     offset += strlen("data");
-    *(int *)(buf + offset) = seq;
+    memcpy(buf + offset, &seq, 4);
     offset += 4;
-    *(short *)(buf + offset) = data_len;
+    memcpy(buf + offset, &len, 2);
     offset += 2;
-    *(unsigned char *)(buf + offset) = checksum;
+    buf[offset] = checksum;
     offset += 1;
-    rtos_mutex_take(pr_tx_mutex, MUTEX_WAIT_TIMEOUT);
+    memcpy(buf + offset, &dropped, 4);
+    offset += 4;
     pr_uart_send_string((char *)buf, offset);
     pr_uart_send_string((char *)data, data_len);
     rtos_mutex_give(pr_tx_mutex);
@@ -474,8 +580,21 @@ int pc_msg_audio_data_binary(int seq, char *data, int data_len)
     return 0;
 }
 
+/* the encoder output is sent from the tx task while it holds the page being encoded */
+void pc_codec_output(void *priv, const unsigned char *data, int len)
+{
+    (void) priv;
+    u32 index = pr_adapter.tx_cnt % RECORD_PAGE_NUM;
+
+    pr_adapter.msg_cnt++;
+    pc_msg_audio_data_binary(pr_adapter.msg_cnt, pr_pages[index].dropped, (char *)data, len);
+    /* the codec reuses its output buffer once this returns */
+    pr_uart_wait_send_done();
+}
+
 int pc_msg_response_ack(int opt)
 {
+#if PR_UART_USE_JSON
     cJSON *msg_obj;
     char *msg_js = NULL;
 
@@ -495,10 +614,14 @@ int pc_msg_response_ack(int opt)
     MEDIA_LOGD("[PCRECORD INFO] %s, %s", __func__, msg_js);
     rtos_mutex_take(pr_tx_mutex, MUTEX_WAIT_TIMEOUT);
     pr_uart_send_string(msg_js, strlen(msg_js));
+    pr_uart_wait_send_done();
     MEDIA_LOGD("[PCRECORD INFO] %s, send ack done(%d)", __func__, strlen(msg_js));
     rtos_mutex_give(pr_tx_mutex);
 
     rtos_mem_free(msg_js);
+#else
+    pc_frame_ack(opt >= 0 ? AUDIO_UART_FRAME_OK : AUDIO_UART_FRAME_ERR_PARAM);
+#endif
     return 0;
 }
 
@@ -528,6 +651,61 @@ int pc_msg_audio_chmap(msg_attrib_t *pattrib, int ch, int index)
     return 0;
 }
 
+/* the rest of a config message once it is parsed, chl holds the chl1~chl8 masks and url is read with mode 1 */
+int pc_msg_config(msg_attrib_t *pattrib, const int *chl, const char *url)
+{
+    char tempbuf[64];
+
+    if (pattrib->mode == 1 && url) {
+        pattrib->url = rtos_mem_malloc(strlen(url) + 1);
+        memset(pattrib->url, 0x00, strlen(url) + 1);
+
+        memcpy(pattrib->url, url, strlen(url));
+        if (player_is_running) {
+            rtos_time_delay_ms(200);
+            MEDIA_LOGD("[PCRECORD INFO] %s, Player is running", __func__);
+        } else {
+            pr_adapter.record_stop = 0; // add for play before start record
+            if (rtos_task_create(&playback_task, ((const char *)"playback_task"), pc_playback_task,
+                                 pattrib, 8192 * 4, 2) != RTK_SUCCESS) {
+                MEDIA_LOGD("%s rtos_task_create(playback_task) failed", __FUNCTION__);
+            }
+        }
+    }
+
+    pattrib->refch = -1;
+    pattrib->adcindex = 0;
+    pattrib->offset = 0;
+    memset(pattrib->chmap, 0x00, 256);
+
+    for (int i = 0; i < MAX_CHANNEL_COUNT; i++) {
+        pc_msg_audio_chmap(pattrib, chl[i], i + 1);
+    }
+
+    memset(tempbuf, 0x00, sizeof(tempbuf));
+    if (pattrib->refch != -1) {
+        sprintf(tempbuf, "ref_channel=%d;cap_mode=no_afe_all_data", pattrib->refch);
+    } else {
+        sprintf(tempbuf, "cap_mode=no_afe_all_data");
+    }
+    memcpy(pattrib->chmap + pattrib->offset, tempbuf, strlen(tempbuf));
+
+    MEDIA_LOGD("[PCRECORD INFO] samplerate: %d", pattrib->samplerate);
+    MEDIA_LOGD("[PCRECORD INFO] device: %d", pattrib->device);
+    MEDIA_LOGD("[PCRECORD INFO] format: %d", pattrib->format);
+    MEDIA_LOGD("[PCRECORD INFO] chnum: %d", pattrib->chnum);
+    MEDIA_LOGD("[PCRECORD INFO] refch: %d", pattrib->refch);
+    MEDIA_LOGD("[PCRECORD INFO] parameters, %s", pattrib->chmap);
+    MEDIA_LOGD("[PCRECORD INFO] codec: %d", pattrib->codec);
+
+    if (pattrib->codec < 0) {
+        MEDIA_LOGE("[PCRECORD INFO] codec not supported, built in: %s", pr_codec_names());
+        return -1;
+    }
+    return pr_audiorecord_config(pattrib);
+}
+
+#if PR_UART_USE_JSON
 bool check_cjson(char *inbuf, int len)
 {
     char p[PC_BUFLEN], *p1;
@@ -597,8 +775,10 @@ void pc_msg_process(msg_attrib_t *pattrib)
     switch (pattrib->type) {
     case PR_MSG_CONFIG: {
         /* parse config information */
-        cJSON *samplerate, *device, *format, *chnum, *mode, *record, *play, *curl;
-        cJSON *ch1, *ch2, *ch3, *ch4, *ch5, *ch6, *ch7, *ch8;
+        cJSON *samplerate, *device, *format, *chnum, *mode, *record, *play, *curl = NULL;
+        cJSON *codec, *level, *bitrate;
+        int chl[MAX_CHANNEL_COUNT];
+        char name[8];
 
         mode = cJSON_GetObjectItem(root, "mode");
         record = cJSON_GetObjectItem(root, "record");
@@ -607,70 +787,29 @@ void pc_msg_process(msg_attrib_t *pattrib)
         device = cJSON_GetObjectItem(record, "device");
         format = cJSON_GetObjectItem(record, "format");
         chnum = cJSON_GetObjectItem(record, "chl_num");
-        ch1 = cJSON_GetObjectItem(record, "chl1");
-        ch2 = cJSON_GetObjectItem(record, "chl2");
-        ch3 = cJSON_GetObjectItem(record, "chl3");
-        ch4 = cJSON_GetObjectItem(record, "chl4");
-        ch5 = cJSON_GetObjectItem(record, "chl5");
-        ch6 = cJSON_GetObjectItem(record, "chl6");
-        ch7 = cJSON_GetObjectItem(record, "chl7");
-        ch8 = cJSON_GetObjectItem(record, "chl8");
-
-        if (mode && mode->valueint == 1) {
+        for (int i = 0; i < MAX_CHANNEL_COUNT; i++) {
+            sprintf(name, "chl%d", i + 1);
+            chl[i] = cJSON_GetObjectItem(record, name)->valueint;
+        }
+        codec = cJSON_GetObjectItem(record, "codec");
+        level = cJSON_GetObjectItem(record, "level");
+        bitrate = cJSON_GetObjectItem(record, "bitrate");
+
+        pattrib->mode = mode ? mode->valueint : 0;
+        if (pattrib->mode == 1) {
             play = cJSON_GetObjectItem(root, "play");
             curl = cJSON_GetObjectItem(play, "url");
-
-            pattrib->url = rtos_mem_malloc(strlen(curl->valuestring) + 1);
-            memset(pattrib->url, 0x00, strlen(curl->valuestring) + 1);
-
-            memcpy(pattrib->url, curl->valuestring, strlen(curl->valuestring));
-            if (player_is_running) {
-                rtos_time_delay_ms(200);
-                MEDIA_LOGD("[PCRECORD INFO] %s, Player is running", __func__);
-            } else {
-                pr_adapter.record_stop = 0; // add for play before start record
-                if (rtos_task_create(&playback_task, ((const char *)"playback_task"), pc_playback_task,
-                                     pattrib, 8192 * 4, 2) != RTK_SUCCESS) {
-                    MEDIA_LOGD("%s rtos_task_create(playback_task) failed", __FUNCTION__);
-                }
-            }
         }
 
         pattrib->samplerate = samplerate->valueint;
         pattrib->device = device->valueint;
         pattrib->format = format->valueint;
         pattrib->chnum = chnum->valueint;
+        pattrib->codec = pr_codec_type(codec ? codec->valuestring : NULL);
+        pattrib->codec_level = level ? level->valueint : PR_FLAC_LEVEL;
+        pattrib->codec_bitrate = bitrate ? bitrate->valueint : PR_OPUS_BITRATE;
 
-        pattrib->refch = -1;
-        pattrib->adcindex = 0;
-        pattrib->offset = 0;
-        memset(pattrib->chmap, 0x00, 256);
-
-        pc_msg_audio_chmap(pattrib, ch1->valueint, 1);
-        pc_msg_audio_chmap(pattrib, ch2->valueint, 2);
-        pc_msg_audio_chmap(pattrib, ch3->valueint, 3);
-        pc_msg_audio_chmap(pattrib, ch4->valueint, 4);
-        pc_msg_audio_chmap(pattrib, ch5->valueint, 5);
-        pc_msg_audio_chmap(pattrib, ch6->valueint, 6);
-        pc_msg_audio_chmap(pattrib, ch7->valueint, 7);
-        pc_msg_audio_chmap(pattrib, ch8->valueint, 8);
-
-        memset(tempbuf, 0x00, PC_BUFLEN);
-        if (pattrib->refch != -1) {
-            sprintf(tempbuf, "ref_channel=%d;cap_mode=no_afe_all_data", pattrib->refch);
-        } else {
-            sprintf(tempbuf, "cap_mode=no_afe_all_data");
-        }
-        memcpy(pattrib->chmap + pattrib->offset, tempbuf, strlen(tempbuf));
-
-        MEDIA_LOGD("[PCRECORD INFO] samplerate: %d", pattrib->samplerate);
-        MEDIA_LOGD("[PCRECORD INFO] device: %d", pattrib->device);
-        MEDIA_LOGD("[PCRECORD INFO] format: %d", pattrib->format);
-        MEDIA_LOGD("[PCRECORD INFO] chnum: %d", pattrib->chnum);
-        MEDIA_LOGD("[PCRECORD INFO] refch: %d", pattrib->refch);
-        MEDIA_LOGD("[PCRECORD INFO] parameters, %s", pattrib->chmap);
-
-        opt = pr_audiorecord_config(pattrib);
+        opt = pc_msg_config(pattrib, chl, curl ? curl->valuestring : NULL);
     }
     pc_msg_response_ack(opt);
     break;
@@ -711,12 +850,112 @@ void pc_msg_process(msg_attrib_t *pattrib)
 
     cJSON_Delete(root);
 }
+#else
+static int pc_frame_config(const struct audio_uart_frame *frame, void *priv)
+{
+    msg_attrib_t *pattrib = (msg_attrib_t *)priv;
+    const uint8_t *payload = frame->payload;
+    char url[AUDIO_UART_FRAME_MAX_PAYLOAD - PR_CONFIG_LEN + 1];
+    int url_len = frame->len - PR_CONFIG_LEN;
+    int chl[MAX_CHANNEL_COUNT];
+
+    pattrib->samplerate = audio_uart_frame_get_u32(payload);
+    pattrib->device = payload[4];
+    pattrib->format = payload[5];
+    pattrib->chnum = payload[6];
+    pattrib->mode = payload[7];
+    for (int i = 0; i < MAX_CHANNEL_COUNT; i++) {
+        chl[i] = (int)audio_uart_frame_get_u32(payload + 8 + i * 4);
+    }
+    pattrib->codec = pr_codec_built_in(payload[40]) ? payload[40] : -1;
+    pattrib->codec_level = payload[41];
+    pattrib->codec_bitrate = (int)audio_uart_frame_get_u32(payload + 42);
+
+    memcpy(url, payload + PR_CONFIG_LEN, url_len);
+    url[url_len] = '\0';
+    if (pattrib->mode == 1 && url_len == 0) {
+        return AUDIO_UART_FRAME_ERR_PARAM;
+    }
+
+    return pc_msg_config(pattrib, chl, url) < 0 ? AUDIO_UART_FRAME_ERR_PARAM : AUDIO_UART_FRAME_OK;
+}
+
+static int pc_frame_start(const struct audio_uart_frame *frame, void *priv)
+{
+    (void) frame;
+    msg_attrib_t *pattrib = (msg_attrib_t *)priv;
+
+    /* the ack has to go out before the first data message */
+    pc_msg_response_ack(pr_audiorecord_start(pattrib));
+    pc_recorder_start(pattrib);
+    return 1;
+}
+
+static int pc_frame_stop(const struct audio_uart_frame *frame, void *priv)
+{
+    (void) frame;
+    (void) priv;
+
+    return pr_audiorecord_stop() < 0 ? AUDIO_UART_FRAME_ERR_PARAM : AUDIO_UART_FRAME_OK;
+}
+
+static int pc_frame_query(const struct audio_uart_frame *frame, void *priv)
+{
+    (void) frame;
+    (void) priv;
+
+    return pr_audiorecord_query() < 0 ? AUDIO_UART_FRAME_ERR_PARAM : 1;
+}
+
+static int pc_frame_volume(const struct audio_uart_frame *frame, void *priv)
+{
+    (void) priv;
+    float vol;
+
+    if (frame->payload[0] > 100) {
+        return AUDIO_UART_FRAME_ERR_PARAM;
+    }
+    vol = (float)frame->payload[0] / 100.0f;
+
+    MEDIA_LOGD("[PCRECORD INFO] volume: %f", vol);
+
+#if defined(CONFIG_AUDIO_MIXER) && CONFIG_AUDIO_MIXER
+    AudioControl_SetHardwareVolume(vol, vol);
+#endif
+    return AUDIO_UART_FRAME_OK;
+}
+
+static const struct audio_uart_frame_handler pr_frame_handlers[] = {
+    {PR_MSG_CONFIG,     PR_CONFIG_LEN,  pc_frame_config },
+    {PR_MSG_START,      0,              pc_frame_start  },
+    {PR_MSG_STOP,       0,              pc_frame_stop   },
+    {PR_MSG_QUERY,      0,              pc_frame_query  },
+    {PR_MSG_VOLUME,     1,              pc_frame_volume },
+};
+
+void pc_frame_process(const struct audio_uart_frame *frame, msg_attrib_t *pattrib)
+{
+    int ret;
+
+    pr_request = frame;
+    ret = audio_uart_frame_dispatch(pr_frame_handlers, sizeof(pr_frame_handlers) / sizeof(pr_frame_handlers[0]),
+                                    frame, pattrib);
+    if (ret < 0) {
+        MEDIA_LOGE("[PCRECORD INFO] %s, type 0x%x seq %d len %d: error %d", __func__, frame->type, frame->seq, frame->len, ret);
+    }
+    if (ret <= 0) {
+        pc_frame_ack(ret);
+    }
+    pr_request = NULL;
+}
+#endif
 
 void pc_rx_task(void *param)
 {
     (void)param;
 
     msg_attrib_t pattrib = {0};
+#if PR_UART_USE_JSON
     cJSON_Hooks memoryHook;
 
     memoryHook.malloc_fn = malloc;
@@ -729,6 +968,25 @@ void pc_rx_task(void *param)
         rtos_sema_take(pr_rx_sema, RTOS_MAX_TIMEOUT);
         pc_msg_process(&pattrib);
     }
+#else
+    struct audio_uart_frame *frame;
+
+    /* above this task so the next request is read in while one is handled */
+    if (audio_uart_frame_rx_start(&pr_frame_rx, &pr_sobj, 2) != 0) {
+        MEDIA_LOGE("[PCRECORD INFO] %s, frame receiver start failed", __func__);
+        rtos_task_delete(NULL);
+        return;
+    }
+
+    while (1) {
+        frame = audio_uart_frame_rx_get(&pr_frame_rx, RTOS_MAX_TIMEOUT);
+        if (!frame) {
+            continue;
+        }
+        pc_frame_process(frame, &pattrib);
+        audio_uart_frame_rx_put(&pr_frame_rx);
+    }
+#endif
 
     rtos_task_delete(NULL);
 }
@@ -736,44 +994,78 @@ void pc_rx_task(void *param)
 void pc_tx_task(void *param)
 {
     (void)param;
-    int index = 0;
+    u32 index = 0;
+    u32 dropped = 0;
 
+    sender_is_running = true;
     while (1) {
-
-        if (pr_adapter.tx_cnt < pr_adapter.rx_cnt) {
-            index = pr_adapter.tx_cnt % RECORD_PAGE_NUM;
-            memcpy(tx_buf, record_buf + index * RECORD_PAGE_SIZE, RECORD_PAGE_SIZE);
-            pr_adapter.tx_cnt++;
-            pc_msg_audio_data_binary(pr_adapter.tx_cnt, tx_buf, RECORD_PAGE_SIZE);
-        }
+        /* one give per page the recorder puts into the ring, and one when it exits */
+        rtos_sema_take(pr_page_sema, RTOS_MAX_TIMEOUT);
         if (pr_adapter.record_stop) {
             break;
         }
 
-        rtos_time_delay_ms(2);
+        index = pr_adapter.tx_cnt % RECORD_PAGE_NUM;
+        if (pr_codec) {
+            if (pr_pages[index].dropped != dropped) {
+                pr_codec_skip(pr_codec, (unsigned long)(pr_pages[index].dropped - dropped) * RECORD_PAGE_SIZE);
+            }
+            /* encoded data goes out through pc_codec_output */
+            pr_codec_write(pr_codec, record_buf + index * RECORD_PAGE_SIZE, RECORD_PAGE_SIZE);
+        } else {
+            pc_msg_audio_data_binary(pr_pages[index].seq, pr_pages[index].dropped,
+                                     record_buf + index * RECORD_PAGE_SIZE, RECORD_PAGE_SIZE);
+            /* the page goes back to the recorder only when the uart is done reading it */
+            pr_uart_wait_send_done();
+        }
+        dropped = pr_pages[index].dropped;
+        pr_adapter.tx_cnt++;
     }
-    MEDIA_LOGD("[PCRECORD INFO] %s, exit", __func__);
+    pr_codec_close(pr_codec);
+    pr_codec = NULL;
+    MEDIA_LOGD("[PCRECORD INFO] %s, exit, sent %lu pages, dropped %lu, ring peak %lu/%d", __func__,
+               pr_adapter.tx_cnt, pr_adapter.drop_cnt, pr_adapter.max_fill, RECORD_PAGE_NUM);
+    sender_is_running = false;
     rtos_task_delete(tx_task);
 }
 
 static void pc_recorder_task(void *param)
 {
     (void)param;
-    int index = 0;
+    u32 index = 0;
+    u32 fill = 0;
+    char *page = NULL;
     recorder_is_running = true;
     while (1) {
-        index = pr_adapter.rx_cnt % RECORD_PAGE_NUM;
-        AudioRecord_Read(audio_record, record_buf + index * RECORD_PAGE_SIZE, RECORD_PAGE_SIZE, true);
-        pr_adapter.rx_cnt++;
-#if PR_UART_USE_DMA_TX
-        pc_msg_audio_data_binary(pr_adapter.rx_cnt, record_buf + index * RECORD_PAGE_SIZE, RECORD_PAGE_SIZE);
-#endif
+        fill = pr_adapter.rx_cnt - pr_adapter.tx_cnt;
+        if (fill < RECORD_PAGE_NUM) {
+            index = pr_adapter.rx_cnt % RECORD_PAGE_NUM;
+            page = record_buf + index * RECORD_PAGE_SIZE;
+        } else {
+            /* the uart is a whole ring behind, blocking here would overrun the record instead */
+            page = record_drop_buf;
+        }
+        AudioRecord_Read(audio_record, page, RECORD_PAGE_SIZE, true);
+        pr_adapter.seq++;
         if (pr_adapter.record_stop) {
             break;
         }
+
+        if (page == record_drop_buf) {
+            pr_adapter.drop_cnt++;
+            continue;
+        }
+        pr_pages[index].seq = pr_adapter.seq;
+        pr_pages[index].dropped = pr_adapter.drop_cnt;
+        pr_adapter.rx_cnt++;
+        if (fill + 1 > pr_adapter.max_fill) {
+            pr_adapter.max_fill = fill + 1;
+        }
+        rtos_sema_give(pr_page_sema);
     }
-    MEDIA_LOGD("[PCRECORD INFO] %s, exit", __func__);
+    MEDIA_LOGD("[PCRECORD INFO] %s, exit, read %lu pages", __func__, pr_adapter.seq);
     recorder_is_running = false;
+    rtos_sema_give(pr_page_sema);
     rtos_task_delete(record_task);
 }
 
@@ -1062,25 +1354,31 @@ exit:
 void pc_recorder_start(msg_attrib_t *pattrib)
 {
     (void) pattrib;
-    if (recorder_is_running) {
+    if (recorder_is_running || sender_is_running) {
         rtos_time_delay_ms(200);
         MEDIA_LOGD("[PCRECORD INFO] %s, Recorder is running", __func__);
         return;
     }
     pr_adapter.record_stop = 0;
     pr_adapter.record_status = RECORD_BUSY;
+    pr_adapter.rx_cnt = 0;
+    pr_adapter.tx_cnt = 0;
+    pr_adapter.seq = 0;
+    pr_adapter.drop_cnt = 0;
+    pr_adapter.max_fill = 0;
+    pr_adapter.msg_cnt = 0;
+    /* pages the last sender did not get to before it stopped */
+    while (rtos_sema_take(pr_page_sema, 0) == RTK_SUCCESS) {
+    }
 
-
+    if (rtos_task_create(&tx_task, ((const char *)"pc_tx_task"), pc_tx_task,
+                         NULL, 1024 * 4, PR_TX_TASK_PRIORITY) != RTK_SUCCESS) {
+        MEDIA_LOGE("%s rtos_task_create(pc_tx_task) failed", __FUNCTION__);
+    }
     if (rtos_task_create(&record_task, ((const char *)"pc_recorder_task"), pc_recorder_task,
                          NULL, 1024 * 4, 9) != RTK_SUCCESS) {
         MEDIA_LOGE("%s rtos_task_create(pc_recorder_task) failed", __FUNCTION__);
     }
-#if PR_UART_USE_DMA_TX == 0
-    if (rtos_task_create(&tx_task, ((const char *)"pc_tx_task"), pc_tx_task,
-                         NULL, 1024 * 4, 3) != RTK_SUCCESS) {
-        MEDIA_LOGE("%s rtos_task_create(pc_tx_task) failed", __FUNCTION__);
-    }
-#endif
 }
 
 uint32_t pcrecord_cmd_handle(int argc, char *argv[])
@@ -1101,7 +1399,10 @@ uint32_t pcrecord_cmd_handle(int argc, char *argv[])
 #if PR_UART_USE_DMA_TX
     rtos_sema_create(&pr_dma_tx_sema, 1, RTOS_SEMA_MAX_COUNT);
 #endif
+#if PR_UART_USE_JSON
     rtos_sema_create(&pr_rx_sema, 0, RTOS_SEMA_MAX_COUNT);
+#endif
+    rtos_sema_create(&pr_page_sema, 0, RTOS_SEMA_MAX_COUNT);
     //rtw_init_queue(&url_list);
     INIT_LIST_HEAD(&pr_url_list);
     rtos_mutex_create(&pr_tx_mutex);
@@ -1111,7 +1412,7 @@ uint32_t pcrecord_cmd_handle(int argc, char *argv[])
     pr_adapter.record_stop = 0;
     pr_adapter.record_status = RECORD_IDLE;
     pr_adapter.rx_cnt = 0;
-    pr_adapter.rx_cnt = 0;
+    pr_adapter.tx_cnt = 0;
 
     memset(record_buf, 0x00, RECORD_PAGE_NUM * RECORD_PAGE_SIZE);
 
@@ -37,7 +37,17 @@
 #define PR_MSG_QUERY    0x06
 #define PR_MSG_VOLUME   0x07
 
-#define PR_VERSION      "1.0"
+/*
+ * payloads of the binary control frames, little endian, see audio_cmds/audio_uart_frame.h for the framing.
+ *   config:     sample_rate u32 | device u8 | format u8 | chl_num u8 | mode u8 | chl1~chl8 u32 |
+ *               codec u8 | level u8 | bitrate u32 | url, codec is a PR_CODEC_* and url runs to the end of the payload
+ *   volume:     value u8, 0~100
+ *   ack/error:  type u8 | status s8
+ *   query:      empty, answered with status u8 | version length u8 | version | codecs length u8 | codecs
+ */
+#define PR_CONFIG_LEN   46
+
+#define PR_VERSION      "1.3"
 #define RECORD_IDLE     0x0
 #define RECORD_BUSY     0x1
 
@@ -84,11 +94,23 @@ typedef struct msg_attrib_s {
     int mode;
     int ch_src[MAX_CHANNEL_COUNT];
     u8 *url;
+    int codec;
+    int codec_level;
+    int codec_bitrate;
 } msg_attrib_t;
 
+typedef struct pr_page_s {
+    u32 seq;        /* position in the capture, dropped pages counted */
+    u32 dropped;    /* pages dropped before this one */
+} pr_page_t;
+
 typedef struct pr_adapter_s {
-    int rx_cnt;
-    int tx_cnt;
+    volatile u32 rx_cnt;    /* pages the recorder put into the ring */
+    volatile u32 tx_cnt;    /* pages the uart is done with */
+    u32 seq;                /* pages read from the record */
+    u32 drop_cnt;           /* pages read while the ring was full */
+    u32 max_fill;           /* most pages waiting in the ring */
+    u32 msg_cnt;            /* data messages of an encoded stream */
     u8 record_stop;
     u8 record_status;
 } pr_adapter_t;
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "PCRecordCodec"
+
+#include <string.h>
+
+#include "log/log.h"
+#include "os_wrapper.h"
+#include "audio/audio_type.h"
+
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+#include "FLAC/stream_encoder.h"
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+#include "opus_multistream.h"
+#endif
+
+#include "pcrecord_codec.h"
+
+#define PR_CODEC_MAX_CHANNELS   8
+/* flac takes 32 bit samples, pages are converted this many frames at a time */
+#define PR_FLAC_CHUNK_FRAMES    128
+#define PR_OPUS_FRAME_MS        20
+/* a 20 ms opus packet of one stream stays under 1275 bytes, plus the self delimiting length */
+#define PR_OPUS_STREAM_BYTES    1280
+
+struct pr_codec {
+    int type;
+    int chnum;
+    int sample_bytes;
+    int frame_bytes;
+    pr_codec_output_t output;
+    void *priv;
+
+    /* a frame the last write ended in the middle of */
+    unsigned char stash[PR_CODEC_MAX_CHANNELS * 4];
+    int stash_len;
+    /* bytes of a frame cut by dropped pcm, skipped at the start of the next write */
+    int skip_len;
+
+    unsigned char *out;
+    int out_len;
+
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+    FLAC__StreamEncoder *flac;
+    FLAC__int32 *flac_in;
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+    OpusMSEncoder *opus;
+    opus_int16 *opus_in;
+    int opus_frame;
+    int opus_filled;
+#endif
+};
+
+static const char *const pr_codec_name[] = {
+    [PR_CODEC_PCM] = "pcm",
+    [PR_CODEC_FLAC] = "flac",
+    [PR_CODEC_OPUS] = "opus",
+};
+
+int pr_codec_built_in(int type)
+{
+    switch (type) {
+    case PR_CODEC_PCM:
+        return 1;
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+    case PR_CODEC_FLAC:
+        return 1;
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+    case PR_CODEC_OPUS:
+        return 1;
+#endif
+    default:
+        return 0;
+    }
+}
+
+int pr_codec_type(const char *name)
+{
+    if (!name) {
+        return PR_CODEC_PCM;
+    }
+
+    for (int i = 0; i < (int)(sizeof(pr_codec_name) / sizeof(pr_codec_name[0])); i++) {
+        if (!strcmp(name, pr_codec_name[i])) {
+            return pr_codec_built_in(i) ? i : -1;
+        }
+    }
+    return -1;
+}
+
+const char *pr_codec_names(void)
+{
+    return "pcm"
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+           ",flac"
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+           ",opus"
+#endif
+           ;
+}
+
+static void pr_codec_flush(struct pr_codec *codec)
+{
+    if (codec->out_len && codec->output) {
+        codec->output(codec->priv, codec->out, codec->out_len);
+    }
+    codec->out_len = 0;
+}
+
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+static FLAC__StreamEncoderWriteStatus pr_flac_write(const FLAC__StreamEncoder *encoder, const FLAC__byte buffer[],
+        size_t bytes, uint32_t samples, uint32_t current_frame, void *client_data)
+{
+    (void) encoder;
+    (void) samples;
+    (void) current_frame;
+    struct pr_codec *codec = (struct pr_codec *)client_data;
+
+    /* the stream header comes from pr_codec_open, it waits in out until the first write */
+    while (bytes) {
+        size_t len = PR_CODEC_MAX_OUTPUT - codec->out_len;
+
+        if (len > bytes) {
+            len = bytes;
+        }
+        memcpy(codec->out + codec->out_len, buffer, len);
+        codec->out_len += len;
+        buffer += len;
+        bytes -= len;
+        if (codec->out_len == PR_CODEC_MAX_OUTPUT) {
+            pr_codec_flush(codec);
+        }
+    }
+    return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+}
+
+static int pr_flac_open(struct pr_codec *codec, const pr_codec_config_t *config)
+{
+    FLAC__StreamEncoderInitStatus status;
+    FLAC__bool ok = true;
+
+    codec->flac_in = (FLAC__int32 *)rtos_mem_malloc(PR_FLAC_CHUNK_FRAMES * codec->chnum * sizeof(FLAC__int32));
+    codec->flac = FLAC__stream_encoder_new();
+    if (!codec->flac_in || !codec->flac) {
+        MEDIA_LOGE("no memory for flac encoder");
+        return -1;
+    }
+
+    ok &= FLAC__stream_encoder_set_channels(codec->flac, codec->chnum);
+    ok &= FLAC__stream_encoder_set_bits_per_sample(codec->flac, codec->sample_bytes * 8);
+    ok &= FLAC__stream_encoder_set_sample_rate(codec->flac, config->samplerate);
+    ok &= FLAC__stream_encoder_set_compression_level(codec->flac, config->level);
+    /* nothing checks it on the way and it costs as much as the fixed predictors */
+    ok &= FLAC__stream_encoder_set_do_md5(codec->flac, false);
+    if (!ok) {
+        MEDIA_LOGE("flac does not take %d ch %d bit %dHz level %d", codec->chnum, codec->sample_bytes * 8,
+                   config->samplerate, config->level);
+        return -1;
+    }
+
+    /* no seek callback, the stream info keeps the total samples unknown */
+    status = FLAC__stream_encoder_init_stream(codec->flac, pr_flac_write, NULL, NULL, NULL, codec);
+    if (status != FLAC__STREAM_ENCODER_INIT_STATUS_OK) {
+        MEDIA_LOGE("flac init fail:%d", status);
+        return -1;
+    }
+    return 0;
+}
+
+static int pr_flac_encode(struct pr_codec *codec, const unsigned char *pcm, int frames)
+{
+    while (frames) {
+        int count = frames < PR_FLAC_CHUNK_FRAMES ? frames : PR_FLAC_CHUNK_FRAMES;
+        int samples = count * codec->chnum;
+
+        if (codec->sample_bytes == 2) {
+            const short *in = (const short *)pcm;
+            for (int i = 0; i < samples; i++) {
+                codec->flac_in[i] = in[i];
+            }
+        } else {
+            for (int i = 0; i < samples; i++) {
+                const unsigned char *in = pcm + i * 3;
+                codec->flac_in[i] = (FLAC__int32)((uint32_t)in[0] << 8 | (uint32_t)in[1] << 16 | (uint32_t)in[2] << 24) >> 8;
+            }
+        }
+
+        if (!FLAC__stream_encoder_process_interleaved(codec->flac, codec->flac_in, count)) {
+            MEDIA_LOGE("flac encode fail:%d", FLAC__stream_encoder_get_state(codec->flac));
+            return -1;
+        }
+        pcm += count * codec->frame_bytes;
+        frames -= count;
+    }
+    return 0;
+}
+#endif
+
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+static int pr_opus_open(struct pr_codec *codec, const pr_codec_config_t *config)
+{
+    unsigned char mapping[PR_CODEC_MAX_CHANNELS];
+    int error = 0;
+
+    /* every mic is its own mono stream, the channels are not a stereo or surround layout */
+    for (int i = 0; i < codec->chnum; i++) {
+        mapping[i] = i;
+    }
+    codec->opus = opus_multistream_encoder_create(config->samplerate, codec->chnum, codec->chnum, 0, mapping,
+                  OPUS_APPLICATION_AUDIO, &error);
+    if (!codec->opus) {
+        MEDIA_LOGE("opus does not take %d ch %dHz:%d", codec->chnum, config->samplerate, error);
+        return -1;
+    }
+    opus_multistream_encoder_ctl(codec->opus, OPUS_SET_BITRATE(config->bitrate * codec->chnum));
+
+    codec->opus_frame = config->samplerate * PR_OPUS_FRAME_MS / 1000;
+    codec->opus_in = (opus_int16 *)rtos_mem_malloc(codec->opus_frame * codec->frame_bytes);
+    if (!codec->opus_in) {
+        MEDIA_LOGE("no memory for opus frame");
+        return -1;
+    }
+    return 0;
+}
+
+static int pr_opus_encode(struct pr_codec *codec, const unsigned char *pcm, int frames)
+{
+    while (frames) {
+        int count = codec->opus_frame - codec->opus_filled;
+        int len;
+
+        if (count > frames) {
+            count = frames;
+        }
+        memcpy(codec->opus_in + codec->opus_filled * codec->chnum, pcm, count * codec->frame_bytes);
+        codec->opus_filled += count;
+        pcm += count * codec->frame_bytes;
+        frames -= count;
+        if (codec->opus_filled < codec->opus_frame) {
+            break;
+        }
+
+        codec->opus_filled = 0;
+        len = opus_multistream_encode(codec->opus, codec->opus_in, codec->opus_frame, codec->out, PR_CODEC_MAX_OUTPUT);
+        if (len < 0) {
+            MEDIA_LOGE("opus encode fail:%d", len);
+            return -1;
+        }
+        /* one message each, the receiver needs the packet boundaries */
+        codec->out_len = len;
+        pr_codec_flush(codec);
+    }
+    return 0;
+}
+#endif
+
+static int pr_codec_encode(struct pr_codec *codec, const unsigned char *pcm, int frames)
+{
+    switch (codec->type) {
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+    case PR_CODEC_FLAC:
+        return pr_flac_encode(codec, pcm, frames);
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+    case PR_CODEC_OPUS:
+        return pr_opus_encode(codec, pcm, frames);
+#endif
+    default:
+        codec->out_len = frames * codec->frame_bytes;
+        codec->output(codec->priv, pcm, codec->out_len);
+        codec->out_len = 0;
+        return 0;
+    }
+}
+
+struct pr_codec *pr_codec_open(const pr_codec_config_t *config, pr_codec_output_t output, void *priv)
+{
+    struct pr_codec *codec;
+    int ret = 0;
+
+    if (!pr_codec_built_in(config->codec)) {
+        MEDIA_LOGE("codec %d not built in", config->codec);
+        return NULL;
+    }
+    if (config->chnum <= 0 || config->chnum > PR_CODEC_MAX_CHANNELS) {
+        MEDIA_LOGE("%d channels not supported", config->chnum);
+        return NULL;
+    }
+    if (config->format != AUDIO_FORMAT_PCM_16_BIT &&
+        !(config->format == AUDIO_FORMAT_PCM_24_BIT && config->codec == PR_CODEC_FLAC)) {
+        MEDIA_LOGE("format %d not supported by %s", config->format, pr_codec_name[config->codec]);
+        return NULL;
+    }
+
+    codec = (struct pr_codec *)rtos_mem_zmalloc(sizeof(struct pr_codec));
+    if (!codec) {
+        return NULL;
+    }
+    codec->type = config->codec;
+    codec->chnum = config->chnum;
+    codec->sample_bytes = config->format == AUDIO_FORMAT_PCM_24_BIT ? 3 : 2;
+    codec->frame_bytes = codec->sample_bytes * codec->chnum;
+    codec->output = output;
+    codec->priv = priv;
+
+    if (codec->type != PR_CODEC_PCM) {
+        codec->out = (unsigned char *)rtos_mem_malloc(PR_CODEC_MAX_OUTPUT);
+        if (!codec->out) {
+            MEDIA_LOGE("no memory for codec output");
+            ret = -1;
+        }
+    }
+
+    switch (ret ? -1 : codec->type) {
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+    case PR_CODEC_FLAC:
+        ret = pr_flac_open(codec, config);
+        break;
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+    case PR_CODEC_OPUS:
+        ret = pr_opus_open(codec, config);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    if (ret) {
+        pr_codec_close(codec);
+        return NULL;
+    }
+    MEDIA_LOGD("%s %dHz %dch %d bit", pr_codec_name[codec->type], config->samplerate, codec->chnum, codec->sample_bytes * 8);
+    return codec;
+}
+
+int pr_codec_write(struct pr_codec *codec, const void *pcm, int bytes)
+{
+    const unsigned char *in = (const unsigned char *)pcm;
+    int frames;
+    int ret = 0;
+
+    if (codec->skip_len) {
+        int len = codec->skip_len < bytes ? codec->skip_len : bytes;
+
+        codec->skip_len -= len;
+        in += len;
+        bytes -= len;
+    }
+
+    /* pages are not a whole number of frames for every channel count */
+    if (codec->stash_len) {
+        int len = codec->frame_bytes - codec->stash_len;
+
+        if (len > bytes) {
+            len = bytes;
+        }
+        memcpy(codec->stash + codec->stash_len, in, len);
+        codec->stash_len += len;
+        in += len;
+        bytes -= len;
+        if (codec->stash_len < codec->frame_bytes) {
+            return 0;
+        }
+        codec->stash_len = 0;
+        ret = pr_codec_encode(codec, codec->stash, 1);
+    }
+
+    frames = bytes / codec->frame_bytes;
+    if (frames && !ret) {
+        ret = pr_codec_encode(codec, in, frames);
+    }
+    codec->stash_len = bytes - frames * codec->frame_bytes;
+    memcpy(codec->stash, in + frames * codec->frame_bytes, codec->stash_len);
+
+    pr_codec_flush(codec);
+    return ret;
+}
+
+void pr_codec_skip(struct pr_codec *codec, unsigned long bytes)
+{
+    /* phase of the next byte written inside its frame */
+    int phase = (int)((codec->stash_len + codec->skip_len + bytes) % codec->frame_bytes);
+
+    codec->stash_len = 0;
+    codec->skip_len = phase ? codec->frame_bytes - phase : 0;
+}
+
+void pr_codec_close(struct pr_codec *codec)
+{
+    if (!codec) {
+        return;
+    }
+
+    codec->output = NULL;
+#if defined(CONFIG_CMD_PCRECORD_FLAC) && CONFIG_CMD_PCRECORD_FLAC
+    if (codec->flac) {
+        FLAC__stream_encoder_finish(codec->flac);
+        FLAC__stream_encoder_delete(codec->flac);
+    }
+    if (codec->flac_in) {
+        rtos_mem_free(codec->flac_in);
+    }
+#endif
+#if defined(CONFIG_CMD_PCRECORD_OPUS) && CONFIG_CMD_PCRECORD_OPUS
+    if (codec->opus) {
+        opus_multistream_encoder_destroy(codec->opus);
+    }
+    if (codec->opus_in) {
+        rtos_mem_free(codec->opus_in);
+    }
+#endif
+    if (codec->out) {
+        rtos_mem_free(codec->out);
+    }
+    rtos_mem_free(codec);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_AUDIO_CMDS_PCRECORD_PCRECORD_CODEC_H
+#define AMEBA_AUDIO_CMDS_PCRECORD_PCRECORD_CODEC_H
+
+#define PR_CODEC_PCM    0
+#define PR_CODEC_FLAC   1
+#define PR_CODEC_OPUS   2
+
+/* largest payload the codec hands out at once, it has to fit the short length of the data header */
+#define PR_CODEC_MAX_OUTPUT     8192
+
+typedef struct pr_codec_config_s {
+    int codec;
+    int samplerate;
+    int chnum;
+    int format;         /* AUDIO_FORMAT_PCM_16_BIT, or AUDIO_FORMAT_PCM_24_BIT for flac */
+    int level;          /* flac compression level, 0~8 */
+    int bitrate;        /* opus bits per second of each channel */
+} pr_codec_config_t;
+
+/* called with each piece of encoded stream, flac bytes or one whole opus packet */
+typedef void (*pr_codec_output_t)(void *priv, const unsigned char *data, int len);
+
+struct pr_codec;
+
+/* PR_CODEC_* of a "codec" name in the config message, -1 for names not built in */
+int pr_codec_type(const char *name);
+
+/* 1 if the PR_CODEC_* of a binary config message is built in */
+int pr_codec_built_in(int type);
+
+/* names of the codecs built in, separated by ',' */
+const char *pr_codec_names(void);
+
+/* output is only called from pr_codec_write, the stream header goes out with the first page */
+struct pr_codec *pr_codec_open(const pr_codec_config_t *config, pr_codec_output_t output, void *priv);
+
+/* takes any number of bytes, frames split across pages are joined */
+int pr_codec_write(struct pr_codec *codec, const void *pcm, int bytes);
+
+/* bytes of pcm lost before the next write, the frame they cut is dropped so the channels stay in place */
+void pr_codec_skip(struct pr_codec *codec, unsigned long bytes);
+
+/* the samples of an unfinished flac block or opus frame are dropped */
+void pr_codec_close(struct pr_codec *codec);
+
+#endif /* AMEBA_AUDIO_CMDS_PCRECORD_PCRECORD_CODEC_H */
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "CachedStreamS"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os_wrapper.h"
+
+#include "log/log.h"
+#include "common/audio_errnos.h"
+
+#include "cached_stream_source.h"
+
+#define CSS_DEFAULT_BLOCK_SIZE      (4 * 1024)
+#define CSS_DEFAULT_BLOCK_COUNT     16
+#define CSS_DEFAULT_READ_AHEAD      8
+#define CSS_DEFAULT_READ_TIMEOUT_MS 50
+#define CSS_DEFAULT_TASK_PRIORITY   1
+#define CSS_TASK_STACK              (2048 * 4)
+
+//misses and seek targets waiting for the task, a reader only has one outstanding at a time.
+#define CSS_PRIORITY_SLOTS          4
+//reads that continue where the last one ended before the task starts reading ahead.
+#define CSS_SEQUENTIAL_READS        2
+//upstream had nothing yet, the task tries the same block again after this.
+#define CSS_RETRY_MS                5
+#define CSS_EXIT_TIMEOUT_MS         3000
+
+enum CachedBlockState {
+    CSS_BLOCK_EMPTY,
+    CSS_BLOCK_LOADING,
+    CSS_BLOCK_READY,
+    CSS_BLOCK_ERROR,
+};
+
+typedef struct CachedBlock {
+    off_t offset;
+    uint8_t *data;
+    uint32_t valid;
+    //valid is all the upstream has for this block, reads past it are the end of stream.
+    bool eof;
+    int32_t error;
+    enum CachedBlockState state;
+    uint32_t last_used;
+} CachedBlock;
+
+typedef struct CachedStreamSource {
+    StreamSource base;
+
+    StreamSource *upstream;
+    CachedStreamSourceConfig config;
+
+    rtos_mutex_t lock;
+    //the task waits on work_sema, readers wait on load_sema which is given after each load.
+    rtos_sema_t work_sema;
+    rtos_sema_t load_sema;
+    rtos_sema_t exit_sema;
+    volatile bool alive;
+
+    CachedBlock *blocks;
+    uint8_t *buffer;
+    uint32_t tick;
+
+    off_t priority[CSS_PRIORITY_SLOTS];
+    uint32_t priority_count;
+
+    //end of the last read, and how many reads in a row started there.
+    off_t next_offset;
+    uint32_t sequential;
+    //block offset the upstream ended at, -1 while unknown.
+    off_t eof_offset;
+
+    CachedStreamSourceStats stats;
+} CachedStreamSource;
+
+static void CachedStreamSource_Task(void *param);
+
+static off_t CachedStreamSource_BlockOffset(const CachedStreamSource *cache, off_t offset)
+{
+    return offset - offset % (off_t)cache->config.block_size;
+}
+
+/* must be called with lock held */
+static CachedBlock *CachedStreamSource_Find(CachedStreamSource *cache, off_t block_offset)
+{
+    for (uint32_t i = 0; i < cache->config.block_count; i++) {
+        CachedBlock *block = &cache->blocks[i];
+        if (block->state != CSS_BLOCK_EMPTY && block->offset == block_offset) {
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+/* must be called with lock held, keeps the blocks from keep_start to keep_end for the read-ahead. */
+static CachedBlock *CachedStreamSource_Victim(CachedStreamSource *cache, off_t keep_start, off_t keep_end)
+{
+    CachedBlock *victim = NULL;
+
+    for (uint32_t i = 0; i < cache->config.block_count; i++) {
+        CachedBlock *block = &cache->blocks[i];
+        if (block->state == CSS_BLOCK_EMPTY) {
+            return block;
+        }
+        if (block->state == CSS_BLOCK_LOADING || (block->offset >= keep_start && block->offset < keep_end)) {
+            continue;
+        }
+        if (!victim || (int32_t)(block->last_used - victim->last_used) < 0) {
+            victim = block;
+        }
+    }
+
+    return victim;
+}
+
+/* must be called with lock held */
+static int32_t CachedStreamSource_PushPriority(CachedStreamSource *cache, off_t block_offset)
+{
+    for (uint32_t i = 0; i < cache->priority_count; i++) {
+        if (cache->priority[i] == block_offset) {
+            return AUDIO_OK;
+        }
+    }
+    if (cache->priority_count == CSS_PRIORITY_SLOTS) {
+        return AUDIO_ERR_NO_MEMORY;
+    }
+
+    cache->priority[cache->priority_count++] = block_offset;
+    return AUDIO_OK;
+}
+
+/* must be called with lock held */
+static void CachedStreamSource_PopPriority(CachedStreamSource *cache, off_t block_offset)
+{
+    for (uint32_t i = 0; i < cache->priority_count; i++) {
+        if (cache->priority[i] == block_offset) {
+            memmove(&cache->priority[i], &cache->priority[i + 1], (cache->priority_count - i - 1) * sizeof(off_t));
+            cache->priority_count--;
+            return;
+        }
+    }
+}
+
+void CachedStreamSource_GetDefaultConfig(CachedStreamSourceConfig *config)
+{
+    config->block_size = CSS_DEFAULT_BLOCK_SIZE;
+    config->block_count = CSS_DEFAULT_BLOCK_COUNT;
+    config->read_ahead_blocks = CSS_DEFAULT_READ_AHEAD;
+    config->read_timeout_ms = CSS_DEFAULT_READ_TIMEOUT_MS;
+    config->task_priority = CSS_DEFAULT_TASK_PRIORITY;
+}
+
+static int32_t CachedStreamSource_CheckPrepared(const StreamSource *source)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)source;
+
+    if (!cache) {
+        return AUDIO_ERR_NO_INIT;
+    }
+
+    return cache->upstream->CheckPrepared(cache->upstream);
+}
+
+static int32_t CachedStreamSource_GetLength(const StreamSource *source, off_t *size)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)source;
+
+    if (!cache) {
+        return STREAM_SOURCE_FAIL;
+    }
+
+    return cache->upstream->GetLength(cache->upstream, size);
+}
+
+static ssize_t CachedStreamSource_ReadAt(const StreamSource *source, off_t offset, void *data, size_t size)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)source;
+    uint32_t start_ms;
+    size_t copied = 0;
+    ssize_t ret = 0;
+    bool missed = false;
+
+    if (!cache || !data || !size || offset < 0) {
+        MEDIA_LOGE("ReadAt invalid param, source: %p, data: %p, size: %d", source, data, size);
+        return (ssize_t)AUDIO_ERR_INVALID_OPERATION;
+    }
+
+    start_ms = rtos_time_get_current_system_time_ms();
+    rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+
+    if (offset == cache->next_offset) {
+        if (cache->sequential < CSS_SEQUENTIAL_READS) {
+            cache->sequential++;
+        }
+    } else {
+        cache->sequential = 0;
+    }
+
+    while (copied < size) {
+        off_t pos = offset + (off_t)copied;
+        off_t block_offset = CachedStreamSource_BlockOffset(cache, pos);
+        CachedBlock *block = CachedStreamSource_Find(cache, block_offset);
+        uint32_t in_block = (uint32_t)(pos - block_offset);
+
+        if (block && block->state == CSS_BLOCK_READY && (in_block < block->valid || block->eof)) {
+            uint32_t bytes = in_block < block->valid ? block->valid - in_block : 0;
+            if (!bytes) {
+                ret = copied ? (ssize_t)copied : (ssize_t)STREAM_SOURCE_EOF;
+                break;
+            }
+            if (bytes > size - copied) {
+                bytes = size - copied;
+            }
+            memcpy((uint8_t *)data + copied, block->data + in_block, bytes);
+            block->last_used = ++cache->tick;
+            copied += bytes;
+            ret = (ssize_t)copied;
+            continue;
+        }
+
+        if (block && block->state == CSS_BLOCK_ERROR) {
+            //report it once, the next read tries the upstream again.
+            ret = block->error;
+            block->state = CSS_BLOCK_EMPTY;
+            break;
+        }
+
+        //a short block that is not at the end of stream is loaded again for the bytes that came since.
+        if (block && block->state == CSS_BLOCK_READY) {
+            block->state = CSS_BLOCK_EMPTY;
+        }
+        missed = true;
+        CachedStreamSource_PushPriority(cache, block_offset);
+        rtos_mutex_give(cache->lock);
+        rtos_sema_give(cache->work_sema);
+
+        uint32_t waited_ms = rtos_time_get_current_system_time_ms() - start_ms;
+        if (waited_ms >= cache->config.read_timeout_ms ||
+            rtos_sema_take(cache->load_sema, cache->config.read_timeout_ms - waited_ms) != RTK_SUCCESS) {
+            //only whole reads are returned before the end of stream, the reader retries and hits.
+            rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+            ret = (ssize_t)STREAM_SOURCE_READ_AGAIN;
+            cache->stats.read_again++;
+            break;
+        }
+        rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+    }
+
+    if (ret > 0) {
+        cache->next_offset = offset + ret;
+        if (missed) {
+            cache->stats.misses++;
+        } else {
+            cache->stats.hits++;
+        }
+    }
+    rtos_mutex_give(cache->lock);
+
+    if (ret > 0 && cache->sequential >= CSS_SEQUENTIAL_READS) {
+        rtos_sema_give(cache->work_sema);
+    }
+
+    return ret;
+}
+
+/* the task's next job: a priority block first, then the first missing block ahead of the reader. */
+static CachedBlock *CachedStreamSource_NextJob(CachedStreamSource *cache)
+{
+    off_t keep_start = CachedStreamSource_BlockOffset(cache, cache->next_offset);
+    off_t keep_end = keep_start + (off_t)cache->config.read_ahead_blocks * cache->config.block_size;
+    CachedBlock *block;
+    off_t block_offset = -1;
+    bool read_ahead = false;
+
+    while (cache->priority_count) {
+        block = CachedStreamSource_Find(cache, cache->priority[0]);
+        if (!block || block->state == CSS_BLOCK_EMPTY) {
+            block_offset = cache->priority[0];
+            break;
+        }
+        //already there, or being loaded for the same reason.
+        CachedStreamSource_PopPriority(cache, cache->priority[0]);
+    }
+
+    if (block_offset < 0 && cache->sequential >= CSS_SEQUENTIAL_READS) {
+        for (off_t offset = keep_start; offset < keep_end; offset += cache->config.block_size) {
+            if (cache->eof_offset >= 0 && offset > cache->eof_offset) {
+                break;
+            }
+            block = CachedStreamSource_Find(cache, offset);
+            if (!block) {
+                block_offset = offset;
+                break;
+            }
+            if (block->state != CSS_BLOCK_READY || !(block->eof || block->valid == cache->config.block_size)) {
+                //wait for the reader to ask for a block the upstream could not fill.
+                break;
+            }
+        }
+        read_ahead = block_offset >= 0;
+    }
+
+    if (block_offset < 0) {
+        return NULL;
+    }
+
+    block = CachedStreamSource_Find(cache, block_offset);
+    if (!block) {
+        block = CachedStreamSource_Victim(cache, keep_start, keep_end);
+    }
+    if (!block) {
+        //every block is ahead of the reader already.
+        return NULL;
+    }
+
+    if (read_ahead) {
+        cache->stats.read_ahead_loads++;
+    }
+    block->offset = block_offset;
+    block->valid = 0;
+    block->eof = false;
+    block->error = AUDIO_OK;
+    block->state = CSS_BLOCK_LOADING;
+
+    return block;
+}
+
+/* fills the block from the upstream without the lock, returns the last upstream result. */
+static ssize_t CachedStreamSource_Load(CachedStreamSource *cache, CachedBlock *block)
+{
+    ssize_t ret = 0;
+
+    while (block->valid < cache->config.block_size && cache->alive) {
+        ret = cache->upstream->ReadAt(cache->upstream, block->offset + block->valid, block->data + block->valid,
+                                      cache->config.block_size - block->valid);
+        cache->stats.upstream_reads++;
+        if (ret > 0) {
+            block->valid += ret;
+            continue;
+        }
+        if (ret == 0 || ret == STREAM_SOURCE_EOF) {
+            block->eof = true;
+        }
+        break;
+    }
+
+    return ret;
+}
+
+static void CachedStreamSource_Task(void *param)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)param;
+
+    while (cache->alive) {
+        CachedBlock *block;
+        ssize_t ret;
+
+        rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+        block = CachedStreamSource_NextJob(cache);
+        rtos_mutex_give(cache->lock);
+        if (!block) {
+            rtos_sema_take(cache->work_sema, RTOS_MAX_TIMEOUT);
+            continue;
+        }
+
+        ret = CachedStreamSource_Load(cache, block);
+
+        rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+        if (block->valid || block->eof) {
+            block->state = CSS_BLOCK_READY;
+            block->last_used = ++cache->tick;
+            if (block->eof && (cache->eof_offset < 0 || block->offset < cache->eof_offset)) {
+                cache->eof_offset = block->offset;
+            }
+            CachedStreamSource_PopPriority(cache, block->offset);
+        } else if (ret == STREAM_SOURCE_READ_AGAIN || !cache->alive) {
+            //nothing yet, a priority block stays queued and is tried again.
+            block->state = CSS_BLOCK_EMPTY;
+        } else {
+            block->error = (int32_t)ret;
+            block->state = CSS_BLOCK_ERROR;
+            CachedStreamSource_PopPriority(cache, block->offset);
+            MEDIA_LOGE("upstream read at %ld fail: %d", (long)block->offset, (int)ret);
+        }
+        rtos_mutex_give(cache->lock);
+        rtos_sema_give(cache->load_sema);
+
+        if (block->state == CSS_BLOCK_EMPTY) {
+            rtos_sema_take(cache->work_sema, CSS_RETRY_MS);
+        }
+    }
+
+    rtos_sema_give(cache->exit_sema);
+    rtos_task_delete(NULL);
+}
+
+StreamSource *CachedStreamSource_Create(StreamSource *upstream, const CachedStreamSourceConfig *config)
+{
+    CachedStreamSource *cache;
+
+    if (!upstream) {
+        MEDIA_LOGE("invalid upstream source.");
+        return NULL;
+    }
+
+    cache = calloc(1, sizeof(CachedStreamSource));
+    if (!cache) {
+        MEDIA_LOGE("fail to alloc CachedStreamSource.");
+        return NULL;
+    }
+
+    if (config) {
+        cache->config = *config;
+    } else {
+        CachedStreamSource_GetDefaultConfig(&cache->config);
+    }
+    if (!cache->config.block_size || cache->config.block_count < 2) {
+        MEDIA_LOGE("invalid block size %lu or count %lu", cache->config.block_size, cache->config.block_count);
+        free(cache);
+        return NULL;
+    }
+    //keep one block for the reader's misses while the rest are read ahead.
+    if (cache->config.read_ahead_blocks >= cache->config.block_count) {
+        cache->config.read_ahead_blocks = cache->config.block_count - 1;
+    }
+
+    cache->base.CheckPrepared = CachedStreamSource_CheckPrepared;
+    cache->base.ReadAt = CachedStreamSource_ReadAt;
+    cache->base.GetLength = CachedStreamSource_GetLength;
+    cache->upstream = upstream;
+    cache->eof_offset = -1;
+
+    cache->blocks = calloc(cache->config.block_count, sizeof(CachedBlock));
+    cache->buffer = malloc(cache->config.block_size * cache->config.block_count);
+    if (!cache->blocks || !cache->buffer) {
+        MEDIA_LOGE("fail to alloc %lu blocks of %lu bytes.", cache->config.block_count, cache->config.block_size);
+        free(cache->blocks);
+        free(cache->buffer);
+        free(cache);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < cache->config.block_count; i++) {
+        cache->blocks[i].data = cache->buffer + i * cache->config.block_size;
+    }
+
+    rtos_mutex_create(&cache->lock);
+    rtos_sema_create_binary(&cache->work_sema);
+    rtos_sema_create_binary(&cache->load_sema);
+    rtos_sema_create_binary(&cache->exit_sema);
+
+    cache->alive = true;
+    if (rtos_task_create(NULL, "CachedStreamSource", CachedStreamSource_Task, (void *)cache, CSS_TASK_STACK,
+                         cache->config.task_priority) != RTK_SUCCESS) {
+        MEDIA_LOGE("fail to create cache task.");
+        cache->alive = false;
+        CachedStreamSource_Destroy((StreamSource *)cache);
+        return NULL;
+    }
+
+    MEDIA_LOGD("CachedStreamSource_Create(%p), %lu blocks of %lu bytes, read ahead %lu", upstream,
+               cache->config.block_count, cache->config.block_size, cache->config.read_ahead_blocks);
+
+    return (StreamSource *)cache;
+}
+
+int32_t CachedStreamSource_Destroy(StreamSource *source)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)source;
+
+    if (!cache) {
+        return AUDIO_ERR_INVALID_PARAM;
+    }
+
+    if (cache->alive) {
+        cache->alive = false;
+        rtos_sema_give(cache->work_sema);
+        if (rtos_sema_take(cache->exit_sema, CSS_EXIT_TIMEOUT_MS) != RTK_SUCCESS) {
+            //the task still reads the upstream into the blocks, leaking them is better than a use after free.
+            MEDIA_LOGE("cache task does not exit.");
+            return AUDIO_ERR_TIMED_OUT;
+        }
+    }
+
+    MEDIA_LOGD("CachedStreamSource_Destroy, hits: %lu, misses: %lu, read ahead: %lu, upstream reads: %lu, read again: %lu",
+               cache->stats.hits, cache->stats.misses, cache->stats.read_ahead_loads, cache->stats.upstream_reads,
+               cache->stats.read_again);
+
+    rtos_mutex_delete(cache->lock);
+    rtos_sema_delete(cache->work_sema);
+    rtos_sema_delete(cache->load_sema);
+    rtos_sema_delete(cache->exit_sema);
+    free(cache->blocks);
+    free(cache->buffer);
+    free(cache);
+
+    return AUDIO_OK;
+}
+
+void CachedStreamSource_GetStats(StreamSource *source, CachedStreamSourceStats *stats)
+{
+    CachedStreamSource *cache = (CachedStreamSource *)source;
+
+    rtos_mutex_take(cache->lock, MUTEX_WAIT_TIMEOUT);
+    *stats = cache->stats;
+    rtos_mutex_give(cache->lock);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CACHED_STREAM_SOURCE_H_
+#define _CACHED_STREAM_SOURCE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "media/stream_source.h"
+
+/*
+ * A StreamSource that keeps blocks of another one in an LRU cache, and loads them on its own
+ * task. Only that task calls the upstream ReadAt, so a slow or late upstream never spins the
+ * reader: a miss waits up to read_timeout_ms for its block before STREAM_SOURCE_READ_AGAIN.
+ * Sequential reads make the task read ahead, random small reads(mp4 moov parsing) only load
+ * the blocks they touch and hit the cache when they come back.
+ */
+typedef struct CachedStreamSourceConfig {
+    uint32_t block_size;
+    uint32_t block_count;
+    //blocks loaded past the read position once reads are sequential, less than block_count.
+    uint32_t read_ahead_blocks;
+    uint32_t read_timeout_ms;
+    uint32_t task_priority;
+} CachedStreamSourceConfig;
+
+typedef struct CachedStreamSourceStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t read_ahead_loads;
+    uint32_t upstream_reads;
+    uint32_t read_again;
+} CachedStreamSourceStats;
+
+void CachedStreamSource_GetDefaultConfig(CachedStreamSourceConfig *config);
+
+/*
+ * upstream has to stay valid until CachedStreamSource_Destroy returns AUDIO_OK, its
+ * CheckPrepared and GetLength are called from the reader's thread while the cache task reads it.
+ * config NULL takes the default config.
+ */
+StreamSource *CachedStreamSource_Create(StreamSource *upstream, const CachedStreamSourceConfig *config);
+/*
+ * Returns AUDIO_OK, or AUDIO_ERR_TIMED_OUT when the cache task is stuck in an upstream read:
+ * the cache is leaked then, and the caller must not destroy the upstream either.
+ */
+int32_t CachedStreamSource_Destroy(StreamSource *source);
+
+void CachedStreamSource_GetStats(StreamSource *source, CachedStreamSourceStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _CACHED_STREAM_SOURCE_H_
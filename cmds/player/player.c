@@ -24,10 +24,12 @@
 #include "basic_types.h"
 
 #include "log/log.h"
+#include "common/audio_errnos.h"
 #include "audio/audio_service.h"
 #include "media/media_player.h"
 
 #include "mystream_source.h"
+#include "cached_stream_source.h"
 #include "player.h"
 
 /* source data */
@@ -39,6 +41,7 @@
 #define MAX_URL_SIZE 1024
 static char g_url[MAX_URL_SIZE];
 bool g_streaming = false;
+bool g_source_cache = true;
 float g_volume = 1.0;
 
 enum PlayingStatus {
@@ -133,6 +136,7 @@ void StartPlay(struct MediaPlayer *player, const char *url)
     MEDIA_LOGD("start to play: %s", url);
     int32_t ret = 0;
     StreamSource *stream_source = NULL;
+    StreamSource *cached_source = NULL;
 
     g_playing_status = IDLE;
 
@@ -140,7 +144,10 @@ void StartPlay(struct MediaPlayer *player, const char *url)
 
     if (g_streaming) {
         stream_source = MyStreamSource_Create((char *)ready_to_convert0, sizeof(ready_to_convert0));
-        ret = MediaPlayer_SetDataSource(player, stream_source);
+        if (stream_source && g_source_cache) {
+            cached_source = CachedStreamSource_Create(stream_source, NULL);
+        }
+        ret = MediaPlayer_SetDataSource(player, cached_source ? cached_source : stream_source);
     } else {
         ret = MediaPlayer_SetSource(player, url);
     }
@@ -207,6 +214,11 @@ void StartPlay(struct MediaPlayer *player, const char *url)
     }
 
 exit:
+    if (cached_source && CachedStreamSource_Destroy(cached_source) != AUDIO_OK) {
+        //the cache task may still be reading it.
+        MEDIA_LOGE("cache not destroyed, keep its stream source.");
+        stream_source = NULL;
+    }
     if (stream_source) {
         MyStreamSource_Destroy((MyStreamSource *)stream_source);
     }
@@ -276,6 +288,7 @@ static void player_help(void)
     MEDIA_LOGD("player [OPTION...]\n"
             "\t\t[-f file]        An audio file buffer or path\n"
             "\t\t[-s 0/1]         Use stream source flag, stream source must be used together with audio file buffer\n"
+            "\t\t[-c 0/1]         Read the stream source through the read-ahead cache, default 1\n"
             "\t\tExamples:\n"
             "\t\t1. play a http file:\n"
             "\t\t   player -f http://aod.cos.tx.xmcdn.com/group72/M02/0A/07/wKgO0F4tEivQbT6uAEBqyNIMu88237.mp3\n"
@@ -292,6 +305,7 @@ uint32_t player_cmd_handle(int argc, char *argv[])
 
     memset(g_url, 0, MAX_URL_SIZE);
     g_streaming = false;
+    g_source_cache = true;
     g_volume = 1.0;
 
     /* parse command line arguments */
@@ -305,6 +319,9 @@ uint32_t player_cmd_handle(int argc, char *argv[])
         } else if (strcmp((const char *)*argv, "-s") == 0) {
             argv++;
             g_streaming = atoi((const char *)*argv);
+        } else if (strcmp((const char *)*argv, "-c") == 0) {
+            argv++;
+            g_source_cache = atoi((const char *)*argv);
         } else if (strcmp((const char *)*argv, "-v") == 0) {
             argv++;
             g_volume = atof((const char *)*argv);
@@ -314,7 +331,7 @@ uint32_t player_cmd_handle(int argc, char *argv[])
             argv++;
         }
     }
-    MEDIA_LOGD("Usage: url is %s, use stream source:%d, volume:%f", g_url, g_streaming, g_volume);
+    MEDIA_LOGD("Usage: url is %s, use stream source:%d, cache:%d, volume:%f", g_url, g_streaming, g_source_cache, g_volume);
 
     if (rtos_task_create(NULL, ((const char *)"player_thread"), player_thread, NULL, 8 * 1024, 1) != RTK_SUCCESS) {
         MEDIA_LOGD("%s rtos_task_create(player_thread) failed", __FUNCTION__);
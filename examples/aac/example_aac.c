@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os_wrapper.h"
+#include "ameba_soc.h"
+#include "platform_stdlib.h"
+
+#include "aacdec.h"
+
+#include "example_bench.h"
+#include "example_aac.h"
+
+#define EXAMPLE_AAC_DEBUG(fmt, args...)    printf("=> D/AacExample:[%s]: " fmt "\n", __func__, ## args)
+#define EXAMPLE_AAC_ERROR(fmt, args...)    printf("=> E/AacExample:[%s]: " fmt "\n", __func__, ## args)
+
+//max errors skipped per file before giving up, a broken file should not hang the benchmark.
+#define AAC_BENCH_MAX_ERRORS    16
+
+//reference corpus of adts files, see README.md for how the files are made.
+static const char *g_corpus[] = {
+	"lfs://44k_stereo_lc_128k.aac",
+	"lfs://48k_stereo_he_64k.aac",
+	"lfs://48k_stereo_he_32k.aac",
+	"lfs://32k_mono_he_24k.aac",
+};
+
+#ifdef AAC_ENABLE_PROFILE
+static const char *g_block_names[AAC_PROF_NUM_BLOCKS] = {
+	"noiseless",
+	"dequant",
+	"stereo",
+	"pns/tns",
+	"imdct",
+	"sbr bitstream",
+	"sbr qmf analysis",
+	"sbr hf generation",
+	"sbr hf adjustment",
+	"sbr qmf synthesis",
+};
+#endif
+
+//one frame of the largest output: sbr doubles the 1024 samples per channel.
+static short g_pcm[AAC_MAX_NCHANS * AAC_MAX_NSAMPS * 2];
+
+//unsigned int to match AACProfileTimer, the decoder reads it for the per block profile.
+static unsigned int aac_bench_cycles(void)
+{
+	return (unsigned int)example_bench_cycles();
+}
+
+static uint8_t *aac_bench_load(const char *path, int *size)
+{
+	FILE *file = fopen(path, "r");
+	uint8_t *data = NULL;
+	long length;
+
+	if (!file) {
+		EXAMPLE_AAC_ERROR("open %s fail", path);
+		return NULL;
+	}
+
+	fseek(file, 0L, SEEK_END);
+	length = ftell(file);
+	fseek(file, 0L, SEEK_SET);
+	if (length > 0) {
+		data = (uint8_t *)malloc(length);
+	}
+	if (!data) {
+		EXAMPLE_AAC_ERROR("no memory for %s, %ld bytes", path, length);
+	} else if (fread(data, 1, length, file) != (size_t)length) {
+		EXAMPLE_AAC_ERROR("read %s fail", path);
+		free(data);
+		data = NULL;
+	}
+
+	fclose(file);
+	*size = (int)length;
+	return data;
+}
+
+#ifdef AAC_ENABLE_PROFILE
+//million cycles per second of audio for each decode block, the sbr steps are zero for aac-lc.
+static void aac_bench_print_profile(const char *path, HAACDecoder decoder, uint32_t rate, uint64_t samples)
+{
+	AACProfileInfo profile;
+	uint64_t total = 0;
+	uint64_t sbr = 0;
+	uint32_t mcps_x100;
+
+	AACGetProfileInfo(decoder, &profile);
+	for (int i = 0; i < AAC_PROF_NUM_BLOCKS; i++) {
+		total += profile.ticks[i];
+		if (i >= AAC_PROF_SBR_BITSTREAM) {
+			sbr += profile.ticks[i];
+		}
+	}
+	if (total == 0) {
+		return;
+	}
+
+	for (int i = 0; i < AAC_PROF_NUM_BLOCKS; i++) {
+		mcps_x100 = (uint32_t)(profile.ticks[i] * rate / samples / 10000);
+		EXAMPLE_AAC_DEBUG("%s: %-18s %3lu.%02lu MCPS %3lu%%", path, g_block_names[i], mcps_x100 / 100, mcps_x100 % 100,
+						  (uint32_t)(profile.ticks[i] * 100 / total));
+	}
+	mcps_x100 = (uint32_t)(sbr * rate / samples / 10000);
+	EXAMPLE_AAC_DEBUG("%s: sbr total %lu.%02lu MCPS %lu%%, %d of %d frames with sbr", path, mcps_x100 / 100, mcps_x100 % 100,
+					  (uint32_t)(sbr * 100 / total), profile.sbrFrames, profile.frames);
+}
+#endif
+
+static void aac_bench_run(const char *path)
+{
+	HAACDecoder decoder;
+	AACFrameInfo info = {0};
+	uint8_t *data;
+	uint8_t *ptr;
+	int size = 0;
+	int left;
+	int err;
+	int errors = 0;
+	uint64_t total_cycles = 0;
+	uint64_t samples = 0;
+	uint32_t frames = 0;
+	uint32_t max_cycles = 0;
+	uint32_t cpu_mhz = SystemGetCpuClk() / 1000000;
+	uint32_t mcps;
+
+	data = aac_bench_load(path, &size);
+	if (!data) {
+		return;
+	}
+
+	decoder = AACInitDecoder();
+	if (!decoder) {
+		EXAMPLE_AAC_ERROR("no memory for the decoder");
+		free(data);
+		return;
+	}
+#ifdef AAC_ENABLE_PROFILE
+	AACSetProfileTimer(decoder, aac_bench_cycles);
+#endif
+
+	ptr = data;
+	left = size;
+	while (left > 0) {
+		uint32_t start = aac_bench_cycles();
+		err = AACDecode(decoder, &ptr, &left, g_pcm);
+		uint32_t cycles = aac_bench_cycles() - start;
+
+		if (err == ERR_AAC_INDATA_UNDERFLOW) {
+			break;
+		} else if (err) {
+			//skip the bad frame, AACDecode looks for the next sync word.
+			EXAMPLE_AAC_ERROR("%s decode error:%d at %lu frames", path, err, frames);
+			if (++errors > AAC_BENCH_MAX_ERRORS) {
+				break;
+			}
+			ptr++;
+			left--;
+			continue;
+		}
+
+		AACGetLastFrameInfo(decoder, &info);
+		total_cycles += cycles;
+		samples += info.outputSamps / info.nChans;
+		frames++;
+		if (cycles > max_cycles) {
+			max_cycles = cycles;
+		}
+	}
+
+	if (samples == 0) {
+		EXAMPLE_AAC_ERROR("%s decoded nothing", path);
+	} else {
+		//million cycles per second of audio, the real time load of one core follows from the cpu clock.
+		mcps = (uint32_t)(total_cycles * info.sampRateOut / samples / 1000000);
+		EXAMPLE_AAC_DEBUG("%s: %s %dHz (core %dHz) %dch %dbps, %llums audio, %lu frames, max %lu cycles per frame",
+						  path, info.sampRateOut != info.sampRateCore ? "HE-AAC" : "AAC-LC", info.sampRateOut, info.sampRateCore,
+						  info.nChans, info.bitRate, samples * 1000 / info.sampRateOut, frames, max_cycles);
+		EXAMPLE_AAC_DEBUG("%s: %lu MCPS, %lu%% of %luMHz, %lu.%02lux real time", path, mcps,
+						  cpu_mhz ? mcps * 100 / cpu_mhz : 0, cpu_mhz,
+						  mcps ? cpu_mhz / mcps : 0, mcps ? cpu_mhz * 100 / mcps % 100 : 0);
+#ifdef AAC_ENABLE_PROFILE
+		aac_bench_print_profile(path, decoder, info.sampRateOut, samples);
+#endif
+	}
+
+	AACDeInitDecoder(decoder);
+	free(data);
+}
+
+static void example_aac_thread(void *param)
+{
+	(void) param;
+
+	example_bench_cycles_init();
+	EXAMPLE_AAC_DEBUG("cpu clk:%lu, %d files", SystemGetCpuClk(), (int)(sizeof(g_corpus) / sizeof(g_corpus[0])));
+
+	for (uint32_t i = 0; i < sizeof(g_corpus) / sizeof(g_corpus[0]); i++) {
+		aac_bench_run(g_corpus[i]);
+	}
+
+	EXAMPLE_AAC_DEBUG("done");
+	rtos_task_delete(NULL);
+}
+
+void example_aac(void)
+{
+	if (rtos_task_create(NULL, ((const char *)"example_aac_thread"), example_aac_thread, NULL, 1024 * 8, 1) != RTK_SUCCESS) {
+		EXAMPLE_AAC_ERROR("error: rtos_task_create(example_aac_thread) failed");
+	}
+}
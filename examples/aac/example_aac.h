@@ -0,0 +1,6 @@
+#ifndef _EXAMPLE_AAC_H_
+#define _EXAMPLE_AAC_H_
+
+void example_aac(void);
+
+#endif //_EXAMPLE_AAC_H_
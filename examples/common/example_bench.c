@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+
+#include "example_bench.h"
+
+#define EXAMPLE_BENCH_PI    3.14159265f
+
+void example_bench_speech(int16_t *pcm, int32_t samples, int32_t channels, int32_t rate, uint32_t *pos, uint32_t *seed)
+{
+	for (int32_t i = 0; i < samples; i++) {
+		float t = (float)(*pos) / rate;
+		float pitch = 140.0f + 40.0f * sinf(2.0f * EXAMPLE_BENCH_PI * 0.7f * t);
+		float envelope = 0.5f + 0.5f * sinf(2.0f * EXAMPLE_BENCH_PI * 4.0f * t);
+		float value = 0.0f;
+
+		for (int32_t h = 1; h <= 8; h++) {
+			value += sinf(2.0f * EXAMPLE_BENCH_PI * pitch * h * t) / h;
+		}
+		*seed = *seed * 1664525 + 1013904223;
+		value = value * envelope * 6000.0f + (float)((int32_t)(*seed >> 20) - 2048);
+
+		for (int32_t c = 0; c < channels; c++) {
+			pcm[i * channels + c] = (int16_t)value;
+		}
+		(*pos)++;
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _EXAMPLE_BENCH_H_
+#define _EXAMPLE_BENCH_H_
+
+#include "os_wrapper.h"
+#include "ameba_soc.h"
+
+/*
+ * Cpu cycle counter of the codec benchmarks: mcycle on riscv, DWT CYCCNT on km4/km0.
+ * The ca32 pmu counter is per core and a task may move between cores during a frame,
+ * so ca32 gets system time scaled by the cpu clock.
+ */
+static inline void example_bench_cycles_init(void)
+{
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_7EM__)
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+#endif
+}
+
+static inline uint32_t example_bench_cycles(void)
+{
+#if defined(__riscv)
+	uint32_t cycles;
+	__asm volatile("csrr %0, mcycle" : "=r"(cycles));
+	return cycles;
+#elif defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_7EM__)
+	return DWT->CYCCNT;
+#else
+	return (uint32_t)(rtos_time_get_current_system_time_us() * (SystemGetCpuClk() / 1000000));
+#endif
+}
+
+/*
+ * Voiced speech stand-in: a gliding pitch with decaying harmonics, syllable shaped envelope
+ * and some noise, the same value on every channel. pos and seed carry the signal from one
+ * call to the next.
+ */
+void example_bench_speech(int16_t *pcm, int32_t samples, int32_t channels, int32_t rate, uint32_t *pos, uint32_t *seed);
+
+#endif //_EXAMPLE_BENCH_H_
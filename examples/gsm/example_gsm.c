@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os_wrapper.h"
+#include "ameba_soc.h"
+#include "platform_stdlib.h"
+
+#include "gsm.h"
+
+#include "example_bench.h"
+#include "example_gsm.h"
+
+#define EXAMPLE_GSM_DEBUG(fmt, args...)    printf("=> D/GsmExample:[%s]: " fmt "\n", __func__, ## args)
+#define EXAMPLE_GSM_ERROR(fmt, args...)    printf("=> E/GsmExample:[%s]: " fmt "\n", __func__, ## args)
+
+#define GSM_BENCH_RATE           8000
+#define GSM_BENCH_FRAME_SAMPLES  160
+#define GSM_BENCH_FRAME_BYTES    33
+#define GSM_BENCH_FRAMES         250
+#define GSM_BENCH_PASSES         8
+
+static gsm_byte g_frames[GSM_BENCH_FRAMES][GSM_BENCH_FRAME_BYTES];
+static gsm_signal g_pcm[GSM_BENCH_FRAME_SAMPLES];
+
+static int32_t gsm_bench_encode(void)
+{
+	uint32_t pos = 0;
+	uint32_t seed = 1;
+	gsm enc = gsm_create();
+
+	if (!enc) {
+		EXAMPLE_GSM_ERROR("create encoder fail");
+		return -1;
+	}
+
+	for (int32_t i = 0; i < GSM_BENCH_FRAMES; i++) {
+		example_bench_speech(g_pcm, GSM_BENCH_FRAME_SAMPLES, 1, GSM_BENCH_RATE, &pos, &seed);
+		gsm_encode(enc, g_pcm, g_frames[i]);
+	}
+
+	gsm_destroy(enc);
+	return 0;
+}
+
+static void gsm_bench_decode(void)
+{
+	uint32_t cpu_clk = SystemGetCpuClk();
+	uint32_t frames = 0;
+	uint64_t start_us;
+	uint64_t total_us;
+	uint32_t max_us = 0;
+	gsm dec = gsm_create();
+
+	if (!dec) {
+		EXAMPLE_GSM_ERROR("create decoder fail");
+		return;
+	}
+
+	start_us = rtos_time_get_current_system_time_us();
+	for (int32_t pass = 0; pass < GSM_BENCH_PASSES; pass++) {
+		for (int32_t i = 0; i < GSM_BENCH_FRAMES; i++) {
+			uint64_t frame_us = rtos_time_get_current_system_time_us();
+
+			if (gsm_decode(dec, g_frames[i], g_pcm) < 0) {
+				EXAMPLE_GSM_ERROR("decode frame %ld fail", i);
+				gsm_destroy(dec);
+				return;
+			}
+			frame_us = rtos_time_get_current_system_time_us() - frame_us;
+			if (frame_us > max_us) {
+				max_us = (uint32_t)frame_us;
+			}
+			frames++;
+		}
+	}
+	total_us = rtos_time_get_current_system_time_us() - start_us;
+	gsm_destroy(dec);
+
+	if (total_us == 0) {
+		EXAMPLE_GSM_ERROR("decode too fast to time, raise GSM_BENCH_PASSES");
+		return;
+	}
+
+	EXAMPLE_GSM_DEBUG("%lu frames in %lluus: %llu frames/s, %llu streams in real time",
+					  frames, total_us, (uint64_t)frames * 1000000 / total_us,
+					  (uint64_t)frames * 1000000 / total_us * GSM_BENCH_FRAME_SAMPLES / GSM_BENCH_RATE);
+	EXAMPLE_GSM_DEBUG("%llu cycles per frame avg, %llu max",
+					  total_us * (cpu_clk / 1000000) / frames, (uint64_t)max_us * (cpu_clk / 1000000));
+}
+
+static void example_gsm_thread(void *param)
+{
+	(void) param;
+
+	EXAMPLE_GSM_DEBUG("cpu clk:%lu, %d frames x %d passes", SystemGetCpuClk(), GSM_BENCH_FRAMES, GSM_BENCH_PASSES);
+
+	if (gsm_bench_encode() == 0) {
+		gsm_bench_decode();
+	}
+
+	EXAMPLE_GSM_DEBUG("done");
+	rtos_task_delete(NULL);
+}
+
+void example_gsm(void)
+{
+	if (rtos_task_create(NULL, ((const char *)"example_gsm_thread"), example_gsm_thread, NULL, 1024 * 4, 1) != RTK_SUCCESS) {
+		EXAMPLE_GSM_ERROR("error: rtos_task_create(example_gsm_thread) failed");
+	}
+}
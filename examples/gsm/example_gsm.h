@@ -0,0 +1,6 @@
+#ifndef _EXAMPLE_GSM_H_
+#define _EXAMPLE_GSM_H_
+
+void example_gsm(void);
+
+#endif //_EXAMPLE_GSM_H_
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os_wrapper.h"
+#include "ameba_soc.h"
+#include "platform_stdlib.h"
+
+#include "opus.h"
+
+#include "example_bench.h"
+#include "example_opus.h"
+
+#define EXAMPLE_OPUS_DEBUG(fmt, args...)    printf("=> D/OpusExample:[%s]: " fmt "\n", __func__, ## args)
+#define EXAMPLE_OPUS_ERROR(fmt, args...)    printf("=> E/OpusExample:[%s]: " fmt "\n", __func__, ## args)
+
+#define OPUS_BENCH_FRAME_MS        20
+#define OPUS_BENCH_FRAMES          250
+#define OPUS_BENCH_MAX_RATE        48000
+#define OPUS_BENCH_MAX_CHANNELS    2
+#define OPUS_BENCH_MAX_FRAME       (OPUS_BENCH_MAX_RATE * OPUS_BENCH_FRAME_MS / 1000)
+#define OPUS_BENCH_MAX_PACKET      1500
+
+typedef struct {
+	const char *name;
+	int32_t rate;
+	int32_t channels;
+	int32_t application;
+	int32_t bitrate;
+} OpusBenchCase;
+
+typedef struct {
+	uint64_t total;
+	uint32_t max;
+} OpusBenchCycles;
+
+static const OpusBenchCase g_cases[] = {
+	{"voip 16k mono", 16000, 1, OPUS_APPLICATION_VOIP, 24000},
+	{"audio 48k stereo", 48000, 2, OPUS_APPLICATION_AUDIO, 96000},
+};
+
+static const int32_t g_complexities[] = {0, 3, 5, 8, 10};
+
+static opus_int16 g_pcm[OPUS_BENCH_MAX_FRAME * OPUS_BENCH_MAX_CHANNELS];
+static opus_int16 g_decoded[OPUS_BENCH_MAX_FRAME * OPUS_BENCH_MAX_CHANNELS];
+static unsigned char g_packet[OPUS_BENCH_MAX_PACKET];
+
+static void opus_bench_add(OpusBenchCycles *cycles, uint32_t value)
+{
+	cycles->total += value;
+	if (value > cycles->max) {
+		cycles->max = value;
+	}
+}
+
+//percent of one core, a frame has to finish within its own duration.
+static uint32_t opus_bench_load(uint32_t cycles)
+{
+	uint32_t clk = SystemGetCpuClk();
+
+	return clk ? (uint32_t)((uint64_t)cycles * 100 * 1000 / OPUS_BENCH_FRAME_MS / clk) : 0;
+}
+
+static int32_t opus_bench_run(const OpusBenchCase *bench, int32_t complexity)
+{
+	int32_t frame_size = bench->rate * OPUS_BENCH_FRAME_MS / 1000;
+	OpusBenchCycles enc_cycles = {0, 0};
+	OpusBenchCycles dec_cycles = {0, 0};
+	uint32_t total_bytes = 0;
+	uint32_t pos = 0;
+	uint32_t seed = 1;
+	OpusEncoder *enc;
+	OpusDecoder *dec;
+	int32_t error;
+
+	enc = opus_encoder_create(bench->rate, bench->channels, bench->application, &error);
+	if (!enc) {
+		EXAMPLE_OPUS_ERROR("create encoder fail:%ld", error);
+		return error;
+	}
+	dec = opus_decoder_create(bench->rate, bench->channels, &error);
+	if (!dec) {
+		EXAMPLE_OPUS_ERROR("create decoder fail:%ld", error);
+		opus_encoder_destroy(enc);
+		return error;
+	}
+
+	opus_encoder_ctl(enc, OPUS_SET_BITRATE(bench->bitrate));
+	opus_encoder_ctl(enc, OPUS_SET_COMPLEXITY(complexity));
+	opus_encoder_ctl(enc, OPUS_SET_VBR(0));
+
+	for (int32_t i = 0; i < OPUS_BENCH_FRAMES; i++) {
+		uint32_t start;
+		int32_t bytes;
+		int32_t samples;
+
+		example_bench_speech(g_pcm, frame_size, bench->channels, bench->rate, &pos, &seed);
+
+		start = example_bench_cycles();
+		bytes = opus_encode(enc, g_pcm, frame_size, g_packet, OPUS_BENCH_MAX_PACKET);
+		opus_bench_add(&enc_cycles, example_bench_cycles() - start);
+		if (bytes < 0) {
+			EXAMPLE_OPUS_ERROR("encode frame %ld fail:%ld", i, bytes);
+			error = bytes;
+			break;
+		}
+		total_bytes += bytes;
+
+		start = example_bench_cycles();
+		samples = opus_decode(dec, g_packet, bytes, g_decoded, frame_size, 0);
+		opus_bench_add(&dec_cycles, example_bench_cycles() - start);
+		if (samples != frame_size) {
+			EXAMPLE_OPUS_ERROR("decode frame %ld fail:%ld", i, samples);
+			error = samples < 0 ? samples : OPUS_INTERNAL_ERROR;
+			break;
+		}
+	}
+
+	if (error == OPUS_OK) {
+		uint32_t enc_avg = (uint32_t)(enc_cycles.total / OPUS_BENCH_FRAMES);
+		uint32_t dec_avg = (uint32_t)(dec_cycles.total / OPUS_BENCH_FRAMES);
+
+		EXAMPLE_OPUS_DEBUG("%s complexity:%ld enc avg:%lu max:%lu cycles (%lu%%) dec avg:%lu max:%lu cycles (%lu%%) %lu bytes/frame",
+						   bench->name, complexity, enc_avg, enc_cycles.max, opus_bench_load(enc_avg),
+						   dec_avg, dec_cycles.max, opus_bench_load(dec_avg), total_bytes / OPUS_BENCH_FRAMES);
+	}
+
+	opus_decoder_destroy(dec);
+	opus_encoder_destroy(enc);
+	return error;
+}
+
+static void example_opus_thread(void *param)
+{
+	(void) param;
+
+	example_bench_cycles_init();
+	EXAMPLE_OPUS_DEBUG("%s, cpu clk:%lu, %d frames of %dms per run", opus_get_version_string(), SystemGetCpuClk(),
+					   OPUS_BENCH_FRAMES, OPUS_BENCH_FRAME_MS);
+
+	for (uint32_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+		for (uint32_t j = 0; j < sizeof(g_complexities) / sizeof(g_complexities[0]); j++) {
+			if (opus_bench_run(&g_cases[i], g_complexities[j]) != OPUS_OK) {
+				break;
+			}
+		}
+	}
+
+	EXAMPLE_OPUS_DEBUG("done");
+	rtos_task_delete(NULL);
+}
+
+void example_opus(void)
+{
+	//the fixed point encoder allocas its scratch on the task stack.
+	if (rtos_task_create(NULL, ((const char *)"example_opus_thread"), example_opus_thread, NULL, 1024 * 32, 1) != RTK_SUCCESS) {
+		EXAMPLE_OPUS_ERROR("error: rtos_task_create(example_opus_thread) failed");
+	}
+}
@@ -0,0 +1,6 @@
+#ifndef _EXAMPLE_OPUS_H_
+#define _EXAMPLE_OPUS_H_
+
+void example_opus(void);
+
+#endif //_EXAMPLE_OPUS_H_
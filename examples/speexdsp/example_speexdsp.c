@@ -1,123 +1,752 @@
-/* Copyright (C) 2007 Jean-Marc Valin
-
-   File: testresample.c
-   Testing the resampling code
-
-   Redistribution and use in source and binary forms, with or without
-   modification, are permitted provided that the following conditions are
-   met:
-
-   1. Redistributions of source code must retain the above copyright notice,
-   this list of conditions and the following disclaimer.
-
-   2. Redistributions in binary form must reproduce the above copyright
-   notice, this list of conditions and the following disclaimer in the
-   documentation and/or other materials provided with the distribution.
-
-   3. The name of the author may not be used to endorse or promote products
-   derived from this software without specific prior written permission.
-
-   THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
-   IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
-   OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-   DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
-   INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-   (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
-   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
-   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
-   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
-   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-   POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#ifdef HAVE_CONFIG_H
-#include "config.h"
-#endif
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Resampler quality/cpu benchmark: every rate pair x channel count x quality 0-10 prints one csv row.
+ * A 1kHz tone is resampled and fitted against the ideal tone at the output rate over a whole number of
+ * periods, the fit gives SINAD (noise, images and distortion) and THD (harmonics 2-5). Down-sampling
+ * cases also feed a tone above the output nyquist and report how far its alias is suppressed, measured
+ * at the frequency it folds to.
+ *
+ * FFT backend benchmark: every backend in spx_fft_backends at the sizes the echo canceller and the
+ * preprocessor use with 64/128/256 sample frames, then both of them together on each backend.
+ */
 
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__RTOS__)
 #include "os_wrapper.h"
 #include "ameba_soc.h"
 #include "platform_stdlib.h"
+#include "example_bench.h"
+#include "example_speexdsp.h"
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
 
 #include "speex/speex_resampler.h"
-#include <stdio.h>
-#include <math.h>
-#include <stdlib.h>
+#include "speex/speex_echo.h"
+#include "speex/speex_preprocess.h"
+//speexdsp internal, spx_fft_init and its backends.
+#include "arch.h"
+#include "fftwrap.h"
+
+#define BENCH_MAX_CHANNELS    8
+#define BENCH_BLOCK_MS        10
+#define BENCH_SETTLE_MS       50
+#define BENCH_WINDOW_MS       200
+#define BENCH_TONE_HZ         1000
+#define BENCH_HARMONICS       5
+#define BENCH_AMPLITUDE       23170.0   //-3dBFS
+#define BENCH_PI              3.14159265358979323846
+
+#define FFT_BENCH_RUNS        200
+#define FFT_BENCH_MAX_SIZE    512
+#define AEC_BENCH_RATE        16000
+#define AEC_BENCH_TAIL        2048      //128ms
+#define AEC_BENCH_SECONDS     4
+#define AEC_BENCH_ECHO_LEN    512
+
+#if defined(__RTOS__)
+#define BENCH_TIME_UNIT       "cycles"
+#else
+#define BENCH_TIME_UNIT       "ns"
+#endif
 
-#define NN 256
-
-const short Sine12bit[256] = {
-	2048, 2098, 2148, 2198, 2248, 2298, 2348, 2398, 2447, 2496,
-	2545, 2594, 2642, 2690, 2737, 2785, 2831, 2877, 2923, 2968,
-	3013, 3057, 3100, 3143, 3185, 3227, 3267, 3307, 3347, 3385,
-	3423, 3460, 3496, 3531, 3565, 3598, 3631, 3662, 3692, 3722,
-	3750, 3778, 3804, 3829, 3854, 3877, 3899, 3920, 3940, 3958,
-	3976, 3992, 4007, 4021, 4034, 4046, 4056, 4065, 4073, 4080,
-	4086, 4090, 4093, 4095, 4095, 4095, 4093, 4090, 4086, 4080,
-	4073, 4065, 4056, 4046, 4034, 4021, 4007, 3992, 3976, 3958,
-	3940, 3920, 3899, 3877, 3854, 3829, 3804, 3778, 3750, 3722,
-	3692, 3662, 3631, 3598, 3565, 3531, 3496, 3460, 3423, 3385,
-	3347, 3307, 3267, 3227, 3185, 3143, 3100, 3057, 3013, 2968,
-	2923, 2877, 2831, 2785, 2737, 2690, 2642, 2594, 2545, 2496,
-	2447, 2398, 2348, 2298, 2248, 2198, 2148, 2098, 2047, 1997,
-	1947, 1897, 1847, 1797, 1747, 1697, 1648, 1599, 1550, 1501,
-	1453, 1405, 1358, 1310, 1264, 1218, 1172, 1127, 1082, 1038,
-	995, 952, 910, 868, 828, 788, 748, 710, 672, 635,
-	599, 564, 530, 497, 464, 433, 403, 373, 345, 317,
-	291, 266, 241, 218, 196, 175, 155, 137, 119, 103,
-	88, 74, 61, 49, 39, 30, 22, 15, 9, 5,
-	2, 0, 0, 0, 2, 5, 9, 15, 22, 30,
-	39, 49, 61, 74, 88, 103, 119, 137, 155, 175,
-	196, 218, 241, 266, 291, 317, 345, 373, 403, 433,
-	464, 497, 530, 564, 599, 635, 672, 710, 748, 788,
-	828, 868, 910, 952, 995, 1038, 1082, 1127, 1172, 1218,
-	1264, 1310, 1358, 1405, 1453, 1501, 1550, 1599, 1648, 1697,
-	1747, 1797, 1847, 1897, 1947, 1997
+typedef struct {
+	uint32_t in_rate;
+	uint32_t out_rate;
+} BenchRatePair;
+
+typedef struct {
+	double sum;
+	double energy;
+	double sin_sum[BENCH_HARMONICS];
+	double cos_sum[BENCH_HARMONICS];
+	uint32_t count;
+} BenchFit;
+
+typedef struct {
+	uint64_t time;
+	uint64_t out_samples;
+	uint32_t peak_bytes;
+	double sinad_db;
+	double thd_db;
+	double alias_db;
+} BenchResult;
+
+typedef struct {
+	uint64_t fft_time;
+	uint64_t ifft_time;
+	uint32_t peak_bytes;
+	double fft_snr_db;
+	double roundtrip_snr_db;
+} FftBenchResult;
+
+typedef struct {
+	uint64_t time;
+	uint32_t frames;
+	uint32_t peak_bytes;
+	double suppression_db;
+} AecBenchResult;
+
+static const BenchRatePair g_rate_pairs[] = {
+	{8000, 16000},
+	{16000, 48000},
+	{48000, 16000},
+	{32000, 48000},
+	{22050, 48000},
+	{44100, 48000},
+	{48000, 44100},
 };
 
-void testresample(void *param)
+static const uint32_t g_channels[] = {1, 2, 8};
+
+//echo canceller and preprocessor frames, both transform twice the frame.
+static const int g_fft_sizes[] = {128, 256, 512};
+static const int g_aec_frames[] = {64, 128, 256};
+
+static int16_t g_in[48000 * BENCH_BLOCK_MS / 1000 * BENCH_MAX_CHANNELS];
+//up to 3x up-sampling plus the resampler's slack.
+static int16_t g_out[48000 * BENCH_BLOCK_MS / 1000 * 3 * BENCH_MAX_CHANNELS + 64 * BENCH_MAX_CHANNELS];
+
+static spx_word16_t g_fft_in[FFT_BENCH_MAX_SIZE];
+static spx_word16_t g_fft_work[FFT_BENCH_MAX_SIZE];
+static spx_word16_t g_fft_out[FFT_BENCH_MAX_SIZE];
+static double g_fft_ref[FFT_BENCH_MAX_SIZE];
+static double g_fft_in_ref[FFT_BENCH_MAX_SIZE];
+static double g_fft_cos[FFT_BENCH_MAX_SIZE];
+
+static spx_int16_t g_aec_far[FFT_BENCH_MAX_SIZE / 2];
+static spx_int16_t g_aec_mic[FFT_BENCH_MAX_SIZE / 2];
+static spx_int16_t g_aec_out[FFT_BENCH_MAX_SIZE / 2];
+static spx_int16_t g_aec_history[AEC_BENCH_ECHO_LEN];
+
+static uint32_t g_noise_seed = 1;
+
+#if defined(__RTOS__)
+static void bench_time_init(void)
 {
-	(void) param;
-	spx_uint32_t i;
-	float *fin, *fout;
-	int count = 0;
+	example_bench_cycles_init();
+}
 
-	SpeexResamplerState *st = speex_resampler_init(1, 8000, 12000, 10, NULL);
-	speex_resampler_set_rate(st, 96000, 44100);
-	speex_resampler_skip_zeros(st);
+static uint32_t bench_time(void)
+{
+	return example_bench_cycles();
+}
+
+static uint32_t g_heap_base;
+static uint32_t g_heap_min_ever;
+static uint32_t g_heap_peak;
+
+/* the heap is sampled after each call, a transient inside a call only shows when it sets a new low water mark. */
+static void bench_heap_peak_start(void)
+{
+	g_heap_base = rtos_mem_get_free_heap_size();
+	g_heap_min_ever = rtos_mem_get_minimum_ever_free_heap_size();
+	g_heap_peak = 0;
+}
+
+static void bench_heap_peak_sample(void)
+{
+	uint32_t used = g_heap_base - rtos_mem_get_free_heap_size();
+
+	if ((int32_t)used > (int32_t)g_heap_peak) {
+		g_heap_peak = used;
+	}
+}
+
+static uint32_t bench_heap_peak(void)
+{
+	uint32_t min_ever = rtos_mem_get_minimum_ever_free_heap_size();
+
+	bench_heap_peak_sample();
+	if (min_ever < g_heap_min_ever && g_heap_base - min_ever > g_heap_peak) {
+		g_heap_peak = g_heap_base - min_ever;
+	}
+	return g_heap_peak;
+}
+
+static double bench_time_per_second(void)
+{
+	return (double)SystemGetCpuClk();
+}
+#else
+static void bench_time_init(void)
+{
+}
+
+static uint32_t bench_time(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/* host/CMakeLists.txt points the resampler's malloc/realloc/free here, mallinfo would also count freed chunks
+   parked in the thread cache. */
+static size_t g_heap_used;
+static size_t g_heap_base;
+static size_t g_heap_peak;
+
+#define BENCH_HEAP_HEADER    16
 
-	fin = malloc(NN * sizeof(float));
-	fout = malloc(2 * NN * sizeof(float));
+void *bench_malloc(size_t size)
+{
+	uint8_t *p = malloc(size + BENCH_HEAP_HEADER);
+
+	if (!p) {
+		return NULL;
+	}
+	*(size_t *)p = size;
+	g_heap_used += size;
+	if (g_heap_used > g_heap_peak) {
+		g_heap_peak = g_heap_used;
+	}
+	return p + BENCH_HEAP_HEADER;
+}
+
+void bench_free(void *ptr)
+{
+	uint8_t *p = ptr;
+
+	if (!p) {
+		return;
+	}
+	p -= BENCH_HEAP_HEADER;
+	g_heap_used -= *(size_t *)p;
+	free(p);
+}
+
+void *bench_realloc(void *ptr, size_t size)
+{
+	void *p = bench_malloc(size);
+
+	if (p && ptr) {
+		size_t old = *(size_t *)((uint8_t *)ptr - BENCH_HEAP_HEADER);
+
+		memcpy(p, ptr, old < size ? old : size);
+		bench_free(ptr);
+	}
+	return p;
+}
+
+static void bench_heap_peak_start(void)
+{
+	g_heap_base = g_heap_used;
+	g_heap_peak = g_heap_used;
+}
+
+static void bench_heap_peak_sample(void)
+{
+}
+
+static uint32_t bench_heap_peak(void)
+{
+	return (uint32_t)(g_heap_peak - g_heap_base);
+}
 
-	while (1) {
-		spx_uint32_t in_len;
-		spx_uint32_t out_len;
-		printf("[IN] = %d\n", NN);
-		for (i = 0; i < NN; i++) {
-			fin[i] = Sine12bit[i];
-			printf(" %f ", fin[i]);
+static double bench_time_per_second(void)
+{
+	return 1e9;
+}
+#endif
+
+/* a tone by rotation, sinf per sample would dominate the run time on the mcu. */
+static void bench_tone_fill(int16_t *buf, uint32_t frames, uint32_t channels, double *re, double *im, double step)
+{
+	double c = cos(step);
+	double s = sin(step);
+
+	for (uint32_t i = 0; i < frames; i++) {
+		double next_re = *re * c - *im * s;
+		int16_t value = (int16_t)lrint(BENCH_AMPLITUDE * *im);
+
+		*im = *re * s + *im * c;
+		*re = next_re;
+		for (uint32_t ch = 0; ch < channels; ch++) {
+			buf[i * channels + ch] = value;
 		}
-		printf("\n");
+	}
+}
+
+/* projects channel 0 on the tone and its harmonics, the window is a whole number of periods so the basis is orthogonal. */
+static void bench_fit_add(BenchFit *fit, const int16_t *buf, uint32_t frames, uint32_t channels, uint32_t start,
+						  uint32_t window, uint32_t *index, double rot_re[][2], double rot_im[][2])
+{
+	for (uint32_t i = 0; i < frames; i++, (*index)++) {
+		double x;
 
-		in_len = NN;
-		out_len = 2 * NN;
-		/*if (count==2)
-		    speex_resampler_set_quality(st, 10);*/
-		speex_resampler_process_float(st, 0, fin, &in_len, fout, &out_len);
+		if (*index < start || *index >= start + window) {
+			continue;
+		}
+		x = buf[i * channels];
+		fit->sum += x;
+		fit->energy += x * x;
+		for (uint32_t h = 0; h < BENCH_HARMONICS; h++) {
+			double re = rot_re[h][0] * rot_re[h][1] - rot_im[h][0] * rot_im[h][1];
+			double im = rot_re[h][0] * rot_im[h][1] + rot_im[h][0] * rot_re[h][1];
 
-		printf("[OUT] = %d\n", (int)out_len);
-		for (i = 0; i < out_len; i++) {
-			//out[i]=floor(.5+fout[i]);
-			printf(" %f ", fout[i]);
+			fit->sin_sum[h] += x * rot_im[h][0];
+			fit->cos_sum[h] += x * rot_re[h][0];
+			rot_re[h][0] = re;
+			rot_im[h][0] = im;
 		}
-		printf("\n");
-		count++;
+		fit->count++;
 	}
+}
+
+static double bench_fit_energy(const BenchFit *fit, uint32_t h)
+{
+	return (fit->sin_sum[h] * fit->sin_sum[h] + fit->cos_sum[h] * fit->cos_sum[h]) * 2.0 / fit->count;
+}
+
+static double bench_db(double num, double den)
+{
+	if (den <= 0.0) {
+		return 200.0;
+	}
+	return 10.0 * log10(num / den);
+}
+
+/* runs the tone at tone_hz through a fresh resampler, returns the fit of the output against fit_hz and its harmonics. */
+static int bench_run_tone(uint32_t in_rate, uint32_t out_rate, uint32_t channels, int quality, uint32_t tone_hz,
+						  uint32_t fit_hz, BenchFit *fit, BenchResult *result)
+{
+	uint32_t in_block = in_rate * BENCH_BLOCK_MS / 1000;
+	uint32_t in_total = in_rate * (BENCH_SETTLE_MS + BENCH_WINDOW_MS + 2 * BENCH_BLOCK_MS) / 1000;
+	uint32_t start = out_rate * BENCH_SETTLE_MS / 1000;
+	uint32_t window = out_rate * BENCH_WINDOW_MS / 1000;
+	double in_step = 2.0 * BENCH_PI * tone_hz / in_rate;
+	double out_step = 2.0 * BENCH_PI * fit_hz / out_rate;
+	double in_re = 1.0;
+	double in_im = 0.0;
+	double rot_re[BENCH_HARMONICS][2];
+	double rot_im[BENCH_HARMONICS][2];
+	uint32_t out_index = 0;
+	SpeexResamplerState *st;
+	int err = RESAMPLER_ERR_SUCCESS;
+
+	memset(fit, 0, sizeof(*fit));
+	for (uint32_t h = 0; h < BENCH_HARMONICS; h++) {
+		//[0] is the running phasor, [1] the per sample rotation.
+		rot_re[h][0] = 1.0;
+		rot_im[h][0] = 0.0;
+		rot_re[h][1] = cos(out_step * (h + 1));
+		rot_im[h][1] = sin(out_step * (h + 1));
+	}
+
+	bench_heap_peak_start();
+	st = speex_resampler_init(channels, in_rate, out_rate, quality, &err);
+	if (!st) {
+		printf("# %lu->%lu ch%lu q%d init fail:%s\n", (unsigned long)in_rate, (unsigned long)out_rate,
+			   (unsigned long)channels, quality, speex_resampler_strerror(err));
+		return -1;
+	}
+	speex_resampler_skip_zeros(st);
+
+	for (uint32_t done = 0; done < in_total; done += in_block) {
+		spx_uint32_t in_len = in_block;
+		spx_uint32_t out_len = sizeof(g_out) / sizeof(g_out[0]) / channels;
+		uint32_t begin;
+
+		bench_tone_fill(g_in, in_block, channels, &in_re, &in_im, in_step);
+
+		begin = bench_time();
+		err = speex_resampler_process_interleaved_int(st, g_in, &in_len, g_out, &out_len);
+		result->time += (uint32_t)(bench_time() - begin);
+		result->out_samples += out_len * channels;
+		bench_heap_peak_sample();
+		if (err != RESAMPLER_ERR_SUCCESS) {
+			break;
+		}
+
+		bench_fit_add(fit, g_out, out_len, channels, start, window, &out_index, rot_re, rot_im);
+	}
+
+	result->peak_bytes = bench_heap_peak();
 	speex_resampler_destroy(st);
-	free(fin);
-	free(fout);
+	if (err != RESAMPLER_ERR_SUCCESS || fit->count < window) {
+		printf("# %lu->%lu ch%lu q%d process fail:%s, %lu of %lu samples\n", (unsigned long)in_rate,
+			   (unsigned long)out_rate, (unsigned long)channels, quality, speex_resampler_strerror(err),
+			   (unsigned long)fit->count, (unsigned long)window);
+		return -1;
+	}
+	return 0;
+}
+
+/* where a tone above the output nyquist lands after down-sampling without a filter. */
+static uint32_t bench_alias_fold(uint32_t tone_hz, uint32_t out_rate)
+{
+	uint32_t folded = tone_hz % out_rate;
+
+	return folded > out_rate / 2 ? out_rate - folded : folded;
+}
+
+/*
+ * half way between the two nyquists, on a 10Hz grid so the window holds whole periods of the tone and of its
+ * alias. When that folds onto DC or the output nyquist(48k->16k puts it at 16k), where a tone can not be
+ * fitted, it moves up by out_rate/16 while staying under the input nyquist.
+ */
+static uint32_t bench_alias_tone(uint32_t in_rate, uint32_t out_rate)
+{
+	uint32_t tone_hz = (out_rate / 2 + in_rate / 2) / 2 / 10 * 10;
+	uint32_t margin = out_rate / 32;
+	uint32_t alias_hz = bench_alias_fold(tone_hz, out_rate);
+
+	if ((alias_hz < margin || alias_hz > out_rate / 2 - margin) && tone_hz + out_rate / 16 < in_rate / 2) {
+		tone_hz += out_rate / 16 / 10 * 10;
+	}
+	return tone_hz;
+}
+
+static int bench_run_case(uint32_t in_rate, uint32_t out_rate, uint32_t channels, int quality, BenchResult *result)
+{
+	BenchFit fit;
+	double fundamental;
+	double harmonics = 0.0;
+	double noise;
+
+	memset(result, 0, sizeof(*result));
+	if (bench_run_tone(in_rate, out_rate, channels, quality, BENCH_TONE_HZ, BENCH_TONE_HZ, &fit, result) != 0) {
+		return -1;
+	}
+
+	fundamental = bench_fit_energy(&fit, 0);
+	for (uint32_t h = 1; h < BENCH_HARMONICS; h++) {
+		if ((h + 1) * BENCH_TONE_HZ < out_rate / 2) {
+			harmonics += bench_fit_energy(&fit, h);
+		}
+	}
+	noise = fit.energy - fundamental - fit.sum * fit.sum / fit.count;
+	result->sinad_db = bench_db(fundamental, noise);
+	result->thd_db = bench_db(harmonics, fundamental);
+	result->alias_db = 0.0;
+
+	if (in_rate > out_rate) {
+		BenchResult alias_result;
+		double in_energy = BENCH_AMPLITUDE * BENCH_AMPLITUDE / 2.0;
+		uint32_t alias_hz = bench_alias_tone(in_rate, out_rate);
+
+		memset(&alias_result, 0, sizeof(alias_result));
+		if (bench_run_tone(in_rate, out_rate, channels, quality, alias_hz, bench_alias_fold(alias_hz, out_rate),
+						   &fit, &alias_result) != 0) {
+			return -1;
+		}
+		result->alias_db = bench_db(bench_fit_energy(&fit, 0) / fit.count, in_energy);
+	}
+	return 0;
+}
+
+static void example_speexdsp_bench(void)
+{
+	BenchResult result;
+
+	bench_time_init();
+	printf("in_rate,out_rate,channels,quality,input_latency,peak_heap_bytes,%s_per_out_sample,sinad_db,thd_db,alias_db\n",
+		   BENCH_TIME_UNIT);
+
+	for (uint32_t p = 0; p < sizeof(g_rate_pairs) / sizeof(g_rate_pairs[0]); p++) {
+		for (uint32_t c = 0; c < sizeof(g_channels) / sizeof(g_channels[0]); c++) {
+			for (int q = 0; q <= 10; q++) {
+				uint32_t in_rate = g_rate_pairs[p].in_rate;
+				uint32_t out_rate = g_rate_pairs[p].out_rate;
+				SpeexResamplerState *st;
+				int latency;
+
+				if (bench_run_case(in_rate, out_rate, g_channels[c], q, &result) != 0) {
+					continue;
+				}
+
+				st = speex_resampler_init(1, in_rate, out_rate, q, NULL);
+				latency = st ? speex_resampler_get_input_latency(st) : -1;
+				if (st) {
+					speex_resampler_destroy(st);
+				}
+
+				printf("%lu,%lu,%lu,%d,%d,%lu,%.2f,%.1f,%.1f,%.1f\n", (unsigned long)in_rate, (unsigned long)out_rate,
+					   (unsigned long)g_channels[c], q, latency, (unsigned long)result.peak_bytes,
+					   result.out_samples ? (double)result.time / result.out_samples : 0.0,
+					   result.sinad_db, result.thd_db, result.alias_db);
+			}
+		}
+	}
+}
+
+/* uniform in [-amplitude, amplitude), an lcg restarted per case feeds every backend and target the same input. */
+static spx_int16_t bench_noise(int32_t amplitude)
+{
+	g_noise_seed = g_noise_seed * 1664525u + 1013904223u;
+	return (spx_int16_t)(((int32_t)(g_noise_seed >> 16) - 32768) * amplitude / 32768);
+}
+
+/* dft of g_fft_in scaled by 1/size, packed like spx_fft: {DC, re(1), im(1), ..., nyquist}. */
+static void bench_fft_reference(int size)
+{
+	for (int n = 0; n < size; n++) {
+		g_fft_cos[n] = cos(2.0 * BENCH_PI * n / size);
+	}
+	for (int k = 0; k <= size / 2; k++) {
+		double re = 0.0;
+		double im = 0.0;
+
+		for (int n = 0; n < size; n++) {
+			int phase = (k * n) % size;
+
+			re += g_fft_in[n] * g_fft_cos[phase];
+			//sin(x) = cos(x - pi/2)
+			im -= g_fft_in[n] * g_fft_cos[(phase + size * 3 / 4) % size];
+		}
+		if (k == 0) {
+			g_fft_ref[0] = re / size;
+		} else if (k == size / 2) {
+			g_fft_ref[size - 1] = re / size;
+		} else {
+			g_fft_ref[2 * k - 1] = re / size;
+			g_fft_ref[2 * k] = im / size;
+		}
+	}
+}
+
+static double bench_snr_db(const double *ref, const spx_word16_t *out, int len)
+{
+	double signal = 0.0;
+	double noise = 0.0;
+
+	for (int i = 0; i < len; i++) {
+		double err = ref[i] - out[i];
+
+		signal += ref[i] * ref[i];
+		noise += err * err;
+	}
+	return bench_db(signal, noise);
+}
+
+/* fails when the backend does not take this size, spx_fft_init would have picked another one. */
+static int bench_fft_run(const SpxFftBackend *backend, int size, FftBenchResult *result)
+{
+	void *table;
+
+	memset(result, 0, sizeof(*result));
+	if (!backend->supports(size)) {
+		return -1;
+	}
+	bench_heap_peak_start();
+	spx_fft_select_backend(backend->name);
+	table = spx_fft_init(size);
+	spx_fft_select_backend(NULL);
+	if (!table) {
+		return -1;
+	}
+
+	g_noise_seed = 1;
+	for (int n = 0; n < size; n++) {
+		g_fft_in[n] = bench_noise(16384);
+		g_fft_in_ref[n] = g_fft_in[n];
+	}
+	bench_fft_reference(size);
+
+	for (int r = 0; r < FFT_BENCH_RUNS; r++) {
+		uint32_t begin;
+
+		memcpy(g_fft_work, g_fft_in, size * sizeof(g_fft_in[0]));
+		begin = bench_time();
+		spx_fft(table, g_fft_work, g_fft_out);
+		result->fft_time += (uint32_t)(bench_time() - begin);
+		begin = bench_time();
+		spx_ifft(table, g_fft_out, g_fft_work);
+		result->ifft_time += (uint32_t)(bench_time() - begin);
+	}
+	result->fft_snr_db = bench_snr_db(g_fft_ref, g_fft_out, size);
+	result->roundtrip_snr_db = bench_snr_db(g_fft_in_ref, g_fft_work, size);
+	result->peak_bytes = bench_heap_peak();
+
+	spx_fft_destroy(table);
+	return 0;
+}
+
+/*
+ * White noise far end, an echo path of three taps and a quiet near end through the echo canceller
+ * and the preprocessor with denoise and residual echo suppression. Suppression is measured over the
+ * last second, once the filter has converged.
+ */
+static int bench_aec_run(const SpxFftBackend *backend, int frame, AecBenchResult *result)
+{
+	int rate = AEC_BENCH_RATE;
+	int denoise = 1;
+	uint32_t total = AEC_BENCH_SECONDS * AEC_BENCH_RATE / frame;
+	uint32_t measured = AEC_BENCH_RATE / frame;
+	uint32_t history_pos = 0;
+	double mic_energy = 0.0;
+	double out_energy = 0.0;
+	SpeexEchoState *echo;
+	SpeexPreprocessState *pre;
+
+	memset(result, 0, sizeof(*result));
+	if (!backend->supports(2 * frame)) {
+		return -1;
+	}
+	memset(g_aec_history, 0, sizeof(g_aec_history));
+	bench_heap_peak_start();
+	spx_fft_select_backend(backend->name);
+	echo = speex_echo_state_init(frame, AEC_BENCH_TAIL);
+	pre = speex_preprocess_state_init(frame, rate);
+	spx_fft_select_backend(NULL);
+	if (!echo || !pre) {
+		if (echo) {
+			speex_echo_state_destroy(echo);
+		}
+		if (pre) {
+			speex_preprocess_state_destroy(pre);
+		}
+		return -1;
+	}
+	speex_echo_ctl(echo, SPEEX_ECHO_SET_SAMPLING_RATE, &rate);
+	speex_preprocess_ctl(pre, SPEEX_PREPROCESS_SET_DENOISE, &denoise);
+	speex_preprocess_ctl(pre, SPEEX_PREPROCESS_SET_ECHO_STATE, echo);
+
+	g_noise_seed = 1;
+	for (uint32_t f = 0; f < total; f++) {
+		uint32_t begin;
+
+		for (int i = 0; i < frame; i++) {
+			int32_t mic;
+
+			g_aec_far[i] = bench_noise(8192);
+			g_aec_history[history_pos] = g_aec_far[i];
+			mic = g_aec_history[(history_pos + AEC_BENCH_ECHO_LEN - 40) % AEC_BENCH_ECHO_LEN] / 2
+				  + g_aec_history[(history_pos + AEC_BENCH_ECHO_LEN - 200) % AEC_BENCH_ECHO_LEN] / 4
+				  - g_aec_history[(history_pos + AEC_BENCH_ECHO_LEN - 450) % AEC_BENCH_ECHO_LEN] / 8
+				  + bench_noise(16);
+			g_aec_mic[i] = (spx_int16_t)mic;
+			history_pos = (history_pos + 1) % AEC_BENCH_ECHO_LEN;
+		}
+
+		begin = bench_time();
+		speex_echo_cancellation(echo, g_aec_mic, g_aec_far, g_aec_out);
+		speex_preprocess_run(pre, g_aec_out);
+		result->time += (uint32_t)(bench_time() - begin);
+		result->frames++;
+		bench_heap_peak_sample();
+
+		if (f >= total - measured) {
+			for (int i = 0; i < frame; i++) {
+				mic_energy += (double)g_aec_mic[i] * g_aec_mic[i];
+				out_energy += (double)g_aec_out[i] * g_aec_out[i];
+			}
+		}
+	}
+	result->suppression_db = bench_db(mic_energy, out_energy);
+	result->peak_bytes = bench_heap_peak();
+
+	speex_preprocess_state_destroy(pre);
+	speex_echo_state_destroy(echo);
+	return 0;
+}
+
+static void example_speexdsp_fft_bench(void)
+{
+	FftBenchResult fft;
+	AecBenchResult aec;
+
+	bench_time_init();
+	printf("backend,fft_size,peak_heap_bytes,%s_per_fft,%s_per_ifft,fft_snr_db,roundtrip_snr_db\n",
+		   BENCH_TIME_UNIT, BENCH_TIME_UNIT);
+	for (int b = 0; spx_fft_backends[b]; b++) {
+		for (uint32_t s = 0; s < sizeof(g_fft_sizes) / sizeof(g_fft_sizes[0]); s++) {
+			if (bench_fft_run(spx_fft_backends[b], g_fft_sizes[s], &fft) != 0) {
+				continue;
+			}
+			printf("%s,%d,%lu,%.0f,%.0f,%.1f,%.1f\n", spx_fft_backends[b]->name, g_fft_sizes[s],
+				   (unsigned long)fft.peak_bytes, (double)fft.fft_time / FFT_BENCH_RUNS,
+				   (double)fft.ifft_time / FFT_BENCH_RUNS, fft.fft_snr_db, fft.roundtrip_snr_db);
+		}
+	}
+
+	printf("backend,frame,tail,peak_heap_bytes,%s_per_frame,cpu_percent_at_16k,suppression_db\n", BENCH_TIME_UNIT);
+	for (int b = 0; spx_fft_backends[b]; b++) {
+		for (uint32_t f = 0; f < sizeof(g_aec_frames) / sizeof(g_aec_frames[0]); f++) {
+			double per_frame;
+
+			if (bench_aec_run(spx_fft_backends[b], g_aec_frames[f], &aec) != 0) {
+				continue;
+			}
+			per_frame = (double)aec.time / aec.frames;
+			printf("%s,%d,%d,%lu,%.0f,%.2f,%.1f\n", spx_fft_backends[b]->name, g_aec_frames[f], AEC_BENCH_TAIL,
+				   (unsigned long)aec.peak_bytes, per_frame,
+				   100.0 * per_frame * AEC_BENCH_RATE / g_aec_frames[f] / bench_time_per_second(), aec.suppression_db);
+		}
+	}
+}
+
+#if defined(__RTOS__)
+static void example_speexdsp_thread(void *param)
+{
+	(void) param;
+
+	printf("# speexdsp resampler bench, cpu clk:%lu\n", SystemGetCpuClk());
+	example_speexdsp_bench();
+	printf("# speexdsp fft bench\n");
+	example_speexdsp_fft_bench();
+	printf("# done\n");
+	rtos_task_delete(NULL);
 }
 
 void example_speexdsp(void)
 {
-	rtos_task_create(NULL, ((const char *)"autorun_task"), testresample, NULL, 1024 * 4, 1);
-}
\ No newline at end of file
+	//process_int keeps an 8192 sample scratch on the stack.
+	if (rtos_task_create(NULL, ((const char *)"example_speexdsp_thread"), example_speexdsp_thread, NULL, 1024 * 24, 1) != RTK_SUCCESS) {
+		printf("error: rtos_task_create(example_speexdsp_thread) failed\n");
+	}
+}
+#else
+int main(int argc, char **argv)
+{
+	int resampler = 1;
+	int fft = 1;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "rfh")) != -1) {
+		switch (opt) {
+		case 'r':
+			fft = 0;
+			break;
+		case 'f':
+			resampler = 0;
+			break;
+		default:
+			printf("usage: %s [-r] [-f]\n"
+				   "  -r  resampler benchmark only\n"
+				   "  -f  fft and echo canceller benchmark only\n"
+				   "  -h  this help\n", argv[0]);
+			return opt == 'h' ? 0 : 1;
+		}
+	}
+
+	if (resampler) {
+		example_speexdsp_bench();
+	}
+	if (fft) {
+		example_speexdsp_fft_bench();
+	}
+	return 0;
+}
+#endif
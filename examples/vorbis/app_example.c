@@ -0,0 +1,12 @@
+/******************************************************************************
+*
+* Copyright(c) 2007 - 2018 Realtek Corporation. All rights reserved.
+*
+******************************************************************************/
+#include "ameba_soc.h"
+#include "example_vorbis.h"
+
+void app_example(void)
+{
+	example_vorbis();
+}
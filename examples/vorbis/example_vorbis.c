@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os_wrapper.h"
+#include "ameba_soc.h"
+#include "platform_stdlib.h"
+
+#include "ivorbisfile.h"
+
+#include "example_bench.h"
+#include "example_vorbis.h"
+
+#define EXAMPLE_VORBIS_DEBUG(fmt, args...)    printf("=> D/VorbisExample:[%s]: " fmt "\n", __func__, ## args)
+#define EXAMPLE_VORBIS_ERROR(fmt, args...)    printf("=> E/VorbisExample:[%s]: " fmt "\n", __func__, ## args)
+
+#define VORBIS_BENCH_PCM_BYTES    4096
+
+typedef struct {
+	const uint8_t *data;
+	size_t size;
+	size_t pos;
+} VorbisBenchSource;
+
+//reference corpus, see README.md for how the files are made.
+static const char *g_corpus[] = {
+	"lfs://44k_stereo_q5.ogg",
+	"lfs://48k_stereo_q2.ogg",
+	"lfs://16k_mono_q0.ogg",
+};
+
+static int16_t g_pcm[VORBIS_BENCH_PCM_BYTES / sizeof(int16_t)];
+
+static size_t vorbis_bench_read(void *ptr, size_t size, size_t nmemb, void *datasource)
+{
+	VorbisBenchSource *source = (VorbisBenchSource *)datasource;
+	size_t bytes = size * nmemb;
+
+	if (bytes > source->size - source->pos) {
+		bytes = source->size - source->pos;
+	}
+	memcpy(ptr, source->data + source->pos, bytes);
+	source->pos += bytes;
+	return size ? bytes / size : 0;
+}
+
+static int vorbis_bench_seek(void *datasource, ogg_int64_t offset, int whence)
+{
+	VorbisBenchSource *source = (VorbisBenchSource *)datasource;
+	ogg_int64_t pos;
+
+	switch (whence) {
+	case SEEK_SET:
+		pos = offset;
+		break;
+	case SEEK_CUR:
+		pos = (ogg_int64_t)source->pos + offset;
+		break;
+	case SEEK_END:
+		pos = (ogg_int64_t)source->size + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if (pos < 0 || pos > (ogg_int64_t)source->size) {
+		return -1;
+	}
+	source->pos = (size_t)pos;
+	return 0;
+}
+
+static int vorbis_bench_close(void *datasource)
+{
+	(void) datasource;
+	return 0;
+}
+
+static long vorbis_bench_tell(void *datasource)
+{
+	return (long)((VorbisBenchSource *)datasource)->pos;
+}
+
+static uint8_t *vorbis_bench_load(const char *path, size_t *size)
+{
+	FILE *file = fopen(path, "r");
+	uint8_t *data = NULL;
+	long length;
+
+	if (!file) {
+		EXAMPLE_VORBIS_ERROR("open %s fail", path);
+		return NULL;
+	}
+
+	fseek(file, 0L, SEEK_END);
+	length = ftell(file);
+	fseek(file, 0L, SEEK_SET);
+	if (length > 0) {
+		data = (uint8_t *)malloc(length);
+	}
+	if (!data) {
+		EXAMPLE_VORBIS_ERROR("no memory for %s, %ld bytes", path, length);
+	} else if (fread(data, 1, length, file) != (size_t)length) {
+		EXAMPLE_VORBIS_ERROR("read %s fail", path);
+		free(data);
+		data = NULL;
+	}
+
+	fclose(file);
+	*size = (size_t)length;
+	return data;
+}
+
+static void vorbis_bench_run(const char *path)
+{
+	ov_callbacks callbacks = {vorbis_bench_read, vorbis_bench_seek, vorbis_bench_close, vorbis_bench_tell};
+	VorbisBenchSource source = {NULL, 0, 0};
+	OggVorbis_File vf;
+	vorbis_info *info;
+	uint64_t total_cycles = 0;
+	uint64_t frames = 0;
+	uint32_t max_cycles = 0;
+	uint32_t cpu_mhz = SystemGetCpuClk() / 1000000;
+	uint32_t mcps;
+	int bitstream = 0;
+
+	source.data = vorbis_bench_load(path, &source.size);
+	if (!source.data) {
+		return;
+	}
+
+	if (ov_open_callbacks(&source, &vf, NULL, 0, callbacks) < 0) {
+		EXAMPLE_VORBIS_ERROR("%s is not ogg vorbis", path);
+		free((void *)source.data);
+		return;
+	}
+	info = ov_info(&vf, -1);
+
+	while (1) {
+		uint32_t start = example_bench_cycles();
+		long bytes = ov_read(&vf, g_pcm, VORBIS_BENCH_PCM_BYTES, &bitstream);
+		uint32_t cycles = example_bench_cycles() - start;
+
+		if (bytes == 0) {
+			break;
+		} else if (bytes == OV_HOLE) {
+			//a hole in the data, tremolo goes on with the next page.
+			EXAMPLE_VORBIS_ERROR("%s hole at %llu frames", path, frames);
+			continue;
+		} else if (bytes < 0) {
+			EXAMPLE_VORBIS_ERROR("%s decode error:%ld at %llu frames", path, bytes, frames);
+			break;
+		}
+
+		total_cycles += cycles;
+		frames += bytes / sizeof(int16_t) / info->channels;
+		if (cycles > max_cycles) {
+			max_cycles = cycles;
+		}
+	}
+
+	if (frames == 0) {
+		EXAMPLE_VORBIS_ERROR("%s decoded nothing", path);
+	} else {
+		//million cycles per second of audio, the real time load of one core follows from the cpu clock.
+		mcps = (uint32_t)(total_cycles * info->rate / frames / 1000000);
+		EXAMPLE_VORBIS_DEBUG("%s: %ldHz %dch %ldbps, %llums audio, %llu cycles, max %lu cycles per read",
+							 path, info->rate, info->channels, info->bitrate_nominal, frames * 1000 / info->rate,
+							 total_cycles, max_cycles);
+		EXAMPLE_VORBIS_DEBUG("%s: %lu MCPS, %lu%% of %luMHz, %lu.%02lux real time", path, mcps,
+							 cpu_mhz ? mcps * 100 / cpu_mhz : 0, cpu_mhz,
+							 mcps ? cpu_mhz / mcps : 0, mcps ? cpu_mhz * 100 / mcps % 100 : 0);
+	}
+
+	ov_clear(&vf);
+	free((void *)source.data);
+}
+
+static void example_vorbis_thread(void *param)
+{
+	(void) param;
+
+	example_bench_cycles_init();
+	EXAMPLE_VORBIS_DEBUG("cpu clk:%lu, %d files", SystemGetCpuClk(), (int)(sizeof(g_corpus) / sizeof(g_corpus[0])));
+
+	for (uint32_t i = 0; i < sizeof(g_corpus) / sizeof(g_corpus[0]); i++) {
+		vorbis_bench_run(g_corpus[i]);
+	}
+
+	EXAMPLE_VORBIS_DEBUG("done");
+	rtos_task_delete(NULL);
+}
+
+void example_vorbis(void)
+{
+	if (rtos_task_create(NULL, ((const char *)"example_vorbis_thread"), example_vorbis_thread, NULL, 1024 * 8, 1) != RTK_SUCCESS) {
+		EXAMPLE_VORBIS_ERROR("error: rtos_task_create(example_vorbis_thread) failed");
+	}
+}
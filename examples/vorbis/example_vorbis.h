@@ -0,0 +1,6 @@
+#ifndef _EXAMPLE_VORBIS_H_
+#define _EXAMPLE_VORBIS_H_
+
+void example_vorbis(void);
+
+#endif //_EXAMPLE_VORBIS_H_
@@ -57,14 +57,18 @@ void AudioManager_Destroy(void);
 
 /**
  * @brief create audio patch between devices or ports.
- * @only support amebadplus I2S IN->I2S OUT
+ * The data goes from sport to sport in hardware, without cpu copy. Several patches
+ * can run at once when they use different sports, and one patch can feed several sinks.
+ * Sink channel n comes from channel n of the sources laid one after another. All
+ * sources and sinks of a patch must have the same sample rate.
  *
  * @param manager is the pointer of struct AudioManager.
  * @param num_sources is total number of sources.
  * @param sources are the sources of the patch.
  * @param num_sinks is total number of sinks.
  * @param sinks are the sinks of the patch.
- * @return Returns index of patch that's created.
+ * @return Returns index of patch that's created, or < 0 if the sports, codec or
+ * clocks it needs are used by another patch or stream.
  * @since 1.0
  * @version 1.0
  */
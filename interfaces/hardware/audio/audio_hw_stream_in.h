@@ -115,6 +115,53 @@ struct AudioHwStreamIn {
 	 * @return Returns the data size read from driver, if read blocks more than time_out_ms, return -ETIMEDOUT.
 	 */
 	ssize_t (*ReadTimeout)(struct AudioHwStreamIn *stream, void *buffer, size_t bytes, uint32_t time_out_ms);
+
+	/**
+	 * @brief Get captured data in the driver buffer to process in place, instead of copying it out by Read.
+	 * This is optional, it is NULL if the stream doesn't support it. It may also return -ENOSYS when the
+	 * current configuration needs channel conversion, then use Read instead.
+	 *
+	 * @param stream is the pointer of the audio stream in.
+	 * @param buffer is the pointer to receive the address of the data inside the driver buffer.
+	 * @param bytes  is the max size wanted.
+	 * @param time_out_ms  is the timeout ms to wait for data.
+	 * @return Returns the data size at *buffer, it can be less than bytes when the driver buffer wraps,
+	 * call CommitBuffer and AcquireBuffer again for the rest; returns < 0 if error happens.
+	 */
+	ssize_t (*AcquireBuffer)(struct AudioHwStreamIn *stream, void **buffer, size_t bytes, uint32_t time_out_ms);
+
+	/**
+	 * @brief Give the data got by AcquireBuffer back to the driver after processing.
+	 *
+	 * @param stream is the pointer of the audio stream in.
+	 * @param bytes  is the size processed, no more than the return value of AcquireBuffer.
+	 * @return Returns the size given back; returns < 0 if error happens.
+	 */
+	ssize_t (*CommitBuffer)(struct AudioHwStreamIn *stream, size_t bytes);
+
+	/**
+	 * @brief Set one parameter by id, same as SetParameters with the "key=value" string of the id,
+	 * but without building and parsing the string. This is optional, it is NULL if the stream doesn't support it.
+	 *
+	 * @param stream is the pointer of the audio stream in.
+	 * @param key is the id of the parameter.
+	 * @param value is the value of the parameter.
+	 * @return Returns 0 if the operation is successful;
+	 * returns -EINVAL if the key is not supported by the stream.
+	 */
+	int32_t (*SetParameter)(struct AudioHwStreamIn *stream, enum AudioHwParamKey key, int32_t value);
+
+	/**
+	 * @brief Get the statistics of the current AudioHwStreamIn, the same values are returned as
+	 * "key=value;..." string by GetParameters with key "stats". This is optional, it is NULL if the
+	 * stream doesn't support it.
+	 *
+	 * @param stream is the pointer of the audio stream in.
+	 * @param stats is the pointer to receive the statistics.
+	 * @return Returns 0 if the operation is successful;
+	 * returns < 0 if the stream is not started yet, stats are all 0 then.
+	 */
+	int32_t (*GetStats)(const struct AudioHwStreamIn *stream, struct AudioHwStreamStats *stats);
 };
 
 /**
@@ -144,6 +144,52 @@ struct AudioHwStreamOut {
 	 * returns < 0 otherwise.
 	 */
 	int32_t (*Flush)(struct AudioHwStreamOut *stream);
+
+	/**
+	 * @brief Get free space in the driver buffer to render into directly, instead of copying data by Write.
+	 * This is optional, it is NULL if the stream doesn't support it. It may also return -ENOSYS when the
+	 * current configuration needs channel conversion, then use Write instead.
+	 *
+	 * @param stream is the pointer of the audio stream out.
+	 * @param buffer is the pointer to receive the address of the free space inside the driver buffer.
+	 * @param bytes  is the max size wanted.
+	 * @return Returns the size can be written at *buffer, it can be less than bytes when the driver buffer
+	 * wraps or is nearly full, 0 if the driver buffer is full; returns < 0 if error happens.
+	 */
+	ssize_t (*AcquireBuffer)(struct AudioHwStreamOut *stream, void **buffer, size_t bytes);
+
+	/**
+	 * @brief Queue the data written into the space got by AcquireBuffer to the driver.
+	 *
+	 * @param stream is the pointer of the audio stream out.
+	 * @param bytes  is the size written, no more than the return value of AcquireBuffer.
+	 * @return Returns the size queued; returns < 0 if error happens.
+	 */
+	ssize_t (*CommitBuffer)(struct AudioHwStreamOut *stream, size_t bytes);
+
+	/**
+	 * @brief Set one parameter by id, same as SetParameters with the "key=value" string of the id,
+	 * but without building and parsing the string. This is optional, it is NULL if the stream doesn't support it.
+	 *
+	 * @param stream is the pointer of the audio stream out.
+	 * @param key is the id of the parameter.
+	 * @param value is the value of the parameter.
+	 * @return Returns 0 if the operation is successful;
+	 * returns -EINVAL if the key is not supported by the stream.
+	 */
+	int32_t (*SetParameter)(struct AudioHwStreamOut *stream, enum AudioHwParamKey key, int32_t value);
+
+	/**
+	 * @brief Get the statistics of the current AudioHwStreamOut, the same values are returned as
+	 * "key=value;..." string by GetParameters with key "stats". This is optional, it is NULL if the
+	 * stream doesn't support it.
+	 *
+	 * @param stream is the pointer of the audio stream out.
+	 * @param stats is the pointer to receive the statistics.
+	 * @return Returns 0 if the operation is successful;
+	 * returns < 0 if the stream is not started yet, stats are all 0 then.
+	 */
+	int32_t (*GetStats)(const struct AudioHwStreamOut *stream, struct AudioHwStreamStats *stats);
 };
 
 #ifdef __cplusplus
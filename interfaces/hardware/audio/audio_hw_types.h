@@ -137,6 +137,79 @@ enum AudioHwInputFlag {
     AUDIO_HW_INPUT_FLAG_NOIRQ        = 0x1u,
 };
 
+/**
+ * @brief Defines the ids of the parameters that can be set by SetParameter of AudioHwStreamOut
+ * and AudioHwStreamIn, the string form of each id is the key used by SetParameters.
+ */
+enum AudioHwParamKey {
+    /** "amp_pin", amplifier enable pin of the stream out */
+    AUDIO_HW_PARAM_AMP_PIN           = 0,
+    /** "delay_start", 1 to start the stream out after its buffer is full */
+    AUDIO_HW_PARAM_DELAY_START       = 1,
+    /** "ref_channel", channel index of the reference data of the stream in */
+    AUDIO_HW_PARAM_REF_CHANNEL       = 2,
+    /** "mic_category", microphone category of the stream in */
+    AUDIO_HW_PARAM_MIC_CATEGORY      = 3,
+    /** "cap_mode", capture mode of the stream in, see AudioHwCaptureMode */
+    AUDIO_HW_PARAM_CAP_MODE          = 4,
+    /** "master_slave", 0 master, 1 slave */
+    AUDIO_HW_PARAM_MASTER_SLAVE      = 5,
+    /** "data_format", I2S:0, Left justified:1, pcm_a:2, pcm_b:3 */
+    AUDIO_HW_PARAM_DATA_FORMAT       = 6,
+    /** "drift_target_ms", stream out fill kept by trimming the i2s pll against the source clock, 0 off.
+     *  amebagreen2 has no pll trim, it only reports the estimate in GetParameters("drift") */
+    AUDIO_HW_PARAM_DRIFT_TARGET_MS   = 7,
+    /** count of the parameter ids */
+    AUDIO_HW_PARAM_MAX,
+};
+
+/**
+ * @brief Defines the values of AUDIO_HW_PARAM_CAP_MODE.
+ */
+enum AudioHwCaptureMode {
+    /** "no_afe_pure_data", channels of pure data */
+    AUDIO_HW_CAPTURE_NO_AFE_PURE_DATA = 0,
+    /** "no_afe_all_data", for debug (mic,mic,..ref,out), only out buffer not filled by audio fwk */
+    AUDIO_HW_CAPTURE_NO_AFE_ALL_DATA  = 1,
+    /** "aec", (mic,mic,..ref): mics after echo cancellation and denoise, then the time aligned playback reference */
+    AUDIO_HW_CAPTURE_AEC              = 2,
+};
+
+/**
+ * @brief Defines how many of the latest xrun timestamps are kept in AudioHwStreamStats.
+ */
+#define AUDIO_HW_STATS_XRUN_HISTORY 4
+
+/**
+ * @brief Defines the statistics of an audio stream, counted since the driver stream is opened.
+ */
+struct AudioHwStreamStats {
+    /** bytes moved between the stream and the driver buffer */
+    uint64_t bytes;
+    /** xrun count, underrun for stream out, overrun for stream in */
+    uint32_t xrun_count;
+    /** time in ns of the latest xruns, same clock as GetPresentTime, [0] is the latest, 0 if none */
+    int64_t xrun_ns[AUDIO_HW_STATS_XRUN_HISTORY];
+    /** min data bytes in the driver buffer, sampled at each Write or Read */
+    uint32_t fill_min;
+    /** max data bytes in the driver buffer, sampled at each Write or Read */
+    uint32_t fill_max;
+    /** average data bytes in the driver buffer, sampled at each Write or Read */
+    uint32_t fill_avg;
+    /** dma interrupt count */
+    uint32_t isr_count;
+    /** max time in us spent in the dma interrupt handler */
+    uint32_t isr_max_us;
+    /** total time in us spent in the dma interrupt handler */
+    uint64_t isr_total_us;
+    /** times the stream blocked waiting for the driver buffer */
+    uint32_t blocked_count;
+    /** max time in us of one block */
+    uint32_t blocked_max_us;
+    /** total time in us blocked */
+    uint64_t blocked_total_us;
+};
+
 /**
  * @brief Defines the audio card information.
  */
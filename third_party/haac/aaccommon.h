@@ -143,8 +143,25 @@ typedef struct _AACDecInfo {
 	int pnsUsed;
 	int frameCount;
 
+#ifdef AAC_ENABLE_PROFILE
+	AACProfileTimer profileTimer;
+	AACProfileInfo profileInfo;
+#endif
+
 } AACDecInfo;
 
+/* per-block timing, each PROFILE_ADD charges the ticks since the last PROFILE_MARK/PROFILE_ADD
+ *   of the same mark to block blk, so a chain of blocks costs one timer read per block
+ */
+#ifdef AAC_ENABLE_PROFILE
+#define PROFILE_MARK(info, mark)		((mark) = ((info)->profileTimer ? (info)->profileTimer() : 0))
+#define PROFILE_ADD(info, blk, mark)	ProfileAdd((info), (blk), &(mark))
+void ProfileAdd(AACDecInfo *aacDecInfo, int blk, unsigned int *mark);
+#else
+#define PROFILE_MARK(info, mark)
+#define PROFILE_ADD(info, blk, mark)
+#endif
+
 /* decoder functions which must be implemented for each platform */
 void FreeBuffers(AACDecInfo *aacDecInfo);
 void ClearBuffer(void *buf, int nBytes);
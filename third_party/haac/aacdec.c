@@ -301,6 +301,107 @@ int AACFlushCodec(HAACDecoder hAACDecoder)
 	return ERR_AAC_NONE;
 }
 
+#ifdef AAC_ENABLE_PROFILE
+/**************************************************************************************
+ * Function:    AACSetProfileTimer
+ *
+ * Description: set the timer used to profile the decode blocks
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              free running counter, NULL to stop profiling
+ *
+ * Outputs:     updated codec state
+ *
+ * Return:      none
+ *
+ * Notes:       the counter is read a few times per element, a cycle counter
+ *                (DWT CYCCNT, mcycle) keeps the overhead small
+ **************************************************************************************/
+void AACSetProfileTimer(HAACDecoder hAACDecoder, AACProfileTimer timer)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo) {
+		return;
+	}
+
+	aacDecInfo->profileTimer = timer;
+}
+
+/**************************************************************************************
+ * Function:    AACGetProfileInfo
+ *
+ * Description: get the ticks spent in each decode block since the last reset
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              pointer to AACProfileInfo struct
+ *
+ * Outputs:     filled-in AACProfileInfo struct
+ *
+ * Return:      none
+ **************************************************************************************/
+void AACGetProfileInfo(HAACDecoder hAACDecoder, AACProfileInfo *aacProfileInfo)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo) {
+		memset(aacProfileInfo, 0, sizeof(AACProfileInfo));
+		return;
+	}
+
+	*aacProfileInfo = aacDecInfo->profileInfo;
+}
+
+/**************************************************************************************
+ * Function:    AACResetProfileInfo
+ *
+ * Description: clear the profile counters
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *
+ * Outputs:     updated codec state
+ *
+ * Return:      none
+ **************************************************************************************/
+void AACResetProfileInfo(HAACDecoder hAACDecoder)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo) {
+		return;
+	}
+
+	memset(&aacDecInfo->profileInfo, 0, sizeof(AACProfileInfo));
+}
+
+/**************************************************************************************
+ * Function:    ProfileAdd
+ *
+ * Description: charge the ticks since *mark to one decode block
+ *
+ * Inputs:      valid AACDecInfo struct
+ *              block index (AAC_PROF_xxx)
+ *              timer value at the end of the previous block
+ *
+ * Outputs:     updated profile counters
+ *              *mark set to the current timer value
+ *
+ * Return:      none
+ **************************************************************************************/
+void ProfileAdd(AACDecInfo *aacDecInfo, int blk, unsigned int *mark)
+{
+	unsigned int now;
+
+	if (!aacDecInfo->profileTimer) {
+		return;
+	}
+
+	now = aacDecInfo->profileTimer();
+	aacDecInfo->profileInfo.ticks[blk] += (unsigned int)(now - *mark);
+	*mark = now;
+}
+#endif
+
 /**************************************************************************************
  * Function:    AACDecode
  *
@@ -334,6 +435,9 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 #endif
 	unsigned char *inbuf_backup = *inbuf;
 	int bytesLeft_backup = *bytesLeft;
+#ifdef AAC_ENABLE_PROFILE
+	unsigned int profMark;
+#endif
 
 	if (!aacDecInfo) {
 		return ERR_AAC_NULL_POINTER;
@@ -429,6 +533,7 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 #ifdef AAC_ENABLE_SBR
 	baseChanSBR = 0;
 #endif
+	PROFILE_MARK(aacDecInfo, profMark);
 	do {
 		/* parse next syntactic element */
 		err = DecodeNextElement(aacDecInfo, &inptr, &bitOffset, &bitsAvail);
@@ -439,6 +544,7 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 			}
 			return err;
 		}
+		PROFILE_ADD(aacDecInfo, AAC_PROF_NOISELESS, profMark);
 
 		elementChans = elementNumChans[aacDecInfo->currBlockID];
 		if (baseChan + elementChans > AAC_MAX_NCHANS) {
@@ -455,10 +561,12 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 				}
 				return err;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_NOISELESS, profMark);
 
 			if (Dequantize(aacDecInfo, ch)) {
 				return ERR_AAC_DEQUANT;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_DEQUANT, profMark);
 		}
 
 		/* mid-side and intensity stereo */
@@ -466,6 +574,7 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 			if (StereoProcess(aacDecInfo)) {
 				return ERR_AAC_STEREO_PROCESS;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_STEREO, profMark);
 		}
 
 		/* PNS, TNS, inverse transform */
@@ -485,10 +594,12 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 			if (TNSFilter(aacDecInfo, ch)) {
 				return ERR_AAC_TNS;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_PNS_TNS, profMark);
 
 			if (IMDCT(aacDecInfo, ch, baseChan + ch, outbuf)) {
 				return ERR_AAC_IMDCT;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_IMDCT, profMark);
 		}
 
 #ifdef AAC_ENABLE_SBR
@@ -509,11 +620,13 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 			if (DecodeSBRBitstream(aacDecInfo, baseChanSBR)) {
 				return ERR_AAC_SBR_BITSTREAM;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_BITSTREAM, profMark);
 
-			/* apply SBR */
+			/* apply SBR (profiles its own steps) */
 			if (DecodeSBRData(aacDecInfo, baseChanSBR, outbuf)) {
 				return ERR_AAC_SBR_DATA;
 			}
+			PROFILE_MARK(aacDecInfo, profMark);
 
 			baseChanSBR += elementChansSBR;
 		}
@@ -536,6 +649,12 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 
 	/* update pointers */
 	aacDecInfo->frameCount++;
+#ifdef AAC_ENABLE_PROFILE
+	aacDecInfo->profileInfo.frames++;
+	if (aacDecInfo->sbrEnabled) {
+		aacDecInfo->profileInfo.sbrFrames++;
+	}
+#endif
 	*bytesLeft -= (inptr - *inbuf);
 	*inbuf = inptr;
 
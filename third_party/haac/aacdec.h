@@ -119,6 +119,33 @@ typedef struct _AACFrameInfo {
 
 typedef void *HAACDecoder;
 
+/* decode blocks timed when AAC_ENABLE_PROFILE is defined at compile time
+ * SBR_QMFA..SBR_QMFS are the four steps of DecodeSBRData(), zero for plain AAC-LC
+ */
+enum {
+	AAC_PROF_NOISELESS = 0,		/* element side info, scalefactors, huffman spectral data */
+	AAC_PROF_DEQUANT,
+	AAC_PROF_STEREO,			/* M/S and intensity stereo */
+	AAC_PROF_PNS_TNS,			/* PNS, short block deinterleave, TNS */
+	AAC_PROF_IMDCT,				/* DCT-IV, window and overlap-add */
+	AAC_PROF_SBR_BITSTREAM,
+	AAC_PROF_SBR_QMFA,			/* 32-band analysis QMF */
+	AAC_PROF_SBR_HFGEN,
+	AAC_PROF_SBR_HFADJ,
+	AAC_PROF_SBR_QMFS,			/* 64-band synthesis QMF */
+
+	AAC_PROF_NUM_BLOCKS
+};
+
+/* free running counter supplied by the application (e.g. CPU cycle counter), may wrap */
+typedef unsigned int (*AACProfileTimer)(void);
+
+typedef struct _AACProfileInfo {
+	unsigned long long ticks[AAC_PROF_NUM_BLOCKS];	/* timer ticks spent in each block */
+	int frames;										/* frames decoded since the last reset */
+	int sbrFrames;									/* how many of them with SBR */
+} AACProfileInfo;
+
 /* public C API */
 HAACDecoder AACInitDecoder(void);
 void AACDeInitDecoder(HAACDecoder hAACDecoder);
@@ -129,6 +156,12 @@ void AACGetLastFrameInfo(HAACDecoder hAACDecoder, AACFrameInfo *aacFrameInfo);
 int AACSetRawBlockParams(HAACDecoder hAACDecoder, int copyLast, AACFrameInfo *aacFrameInfo);
 int AACFlushCodec(HAACDecoder hAACDecoder);
 
+#ifdef AAC_ENABLE_PROFILE
+void AACSetProfileTimer(HAACDecoder hAACDecoder, AACProfileTimer timer);
+void AACGetProfileInfo(HAACDecoder hAACDecoder, AACProfileInfo *aacProfileInfo);
+void AACResetProfileInfo(HAACDecoder hAACDecoder);
+#endif
+
 #ifdef HELIX_CONFIG_AAC_GENERATE_TRIGTABS_FLOAT
 int AACInitTrigtabsFloat(void);
 void AACFreeTrigtabsFloat(void);
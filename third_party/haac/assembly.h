@@ -49,6 +49,11 @@
  * FASTABS(x)               branchless absolute value of signed integer x
  * CLZ(x)                   count leading zeros on signed integer x
  * MADD64(sum64, x, y)		64-bit multiply accumulate: sum64 += (x*y)
+ *
+ * with AAC_ENABLE_ARM_OPT, cores with the Arm DSP instructions (Armv7E-M/Armv8-M
+ *   mainline with DSP, Armv7-A) use ssat, clz, smmul and smlal for these, and cores
+ *   with Neon also get MULSHIFT32_X2/MULSHIFT32_X4 for the vector kernels
+ *   all of them give the same results as the generic C versions
  **************************************************************************************/
 
 #ifndef _ASSEMBLY_H
@@ -56,6 +61,28 @@
 
 #include <inttypes.h>
 
+#if defined(AAC_ENABLE_ARM_OPT) && defined(__arm__) && defined(__ARM_FEATURE_DSP)
+#define AAC_ARM_DSP
+#endif
+
+#if defined(AAC_ENABLE_ARM_OPT) && defined(__arm__) && defined(__ARM_NEON)
+#define AAC_ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef AAC_ARM_DSP
+
+static __inline short CLIPTOSHORT(int x)
+{
+	int z;
+
+	__asm__ ("ssat %0, #16, %1" : "=r" (z) : "r" (x));
+
+	return (short)z;
+}
+
+#else
+
 static short CLIPTOSHORT(int x)
 {
 	int sign;
@@ -69,6 +96,8 @@ static short CLIPTOSHORT(int x)
 	return (short)x;
 }
 
+#endif
+
 static int FASTABS(int x)
 {
 	int sign;
@@ -80,6 +109,20 @@ static int FASTABS(int x)
 	return x;
 }
 
+#ifdef AAC_ARM_DSP
+
+static __inline int CLZ(int x)
+{
+	int numZeros;
+
+	/* clz returns 32 for x == 0 */
+	__asm__ ("clz %0, %1" : "=r" (numZeros) : "r" (x));
+
+	return numZeros;
+}
+
+#else
+
 static int CLZ(int x)
 {
 	int numZeros;
@@ -112,6 +155,8 @@ static int CLZ(int x)
 	return numZeros;
 }
 
+#endif
+
 typedef int64_t Word64;
 
 typedef union _U64 {
@@ -123,6 +168,27 @@ typedef union _U64 {
 	} r;
 } U64;
 
+#ifdef AAC_ARM_DSP
+
+static __inline int MULSHIFT32(int x, int y)
+{
+	int z;
+
+	/* smmul truncates like the >> 32 below, smmulr would round */
+	__asm__ ("smmul %0, %1, %2" : "=r" (z) : "r" (x), "r" (y));
+
+	return z;
+}
+
+static __inline Word64 MADD64(Word64 sum64, int x, int y)
+{
+	__asm__ ("smlal %Q0, %R0, %1, %2" : "+r" (sum64) : "r" (x), "r" (y));
+
+	return sum64;
+}
+
+#else
+
 static int MULSHIFT32(int x, int y)
 {
 	int z;
@@ -139,6 +205,26 @@ static Word64 MADD64(Word64 sum64, int x, int y)
 	return sum64;
 }
 
+#endif
+
+#ifdef AAC_ARM_NEON
+
+/* MULSHIFT32 on 2 or 4 lanes: vqdmulh gives (2*x*y) >> 32, so one more shift makes (x*y) >> 32
+ * vqdmulh only saturates for x == y == 0x80000000, callers pass a table value (window, twiddle)
+ *   as one operand and the tables never hold 0x80000000, so this matches MULSHIFT32 exactly
+ */
+static __inline int32x2_t MULSHIFT32_X2(int32x2_t x, int32x2_t y)
+{
+	return vshr_n_s32(vqdmulh_s32(x, y), 1);
+}
+
+static __inline int32x4_t MULSHIFT32_X4(int32x4_t x, int32x4_t y)
+{
+	return vshrq_n_s32(vqdmulhq_s32(x, y), 1);
+}
+
+#endif
+
 #define CLIP_2N_SHIFT(y, n) {                   \
         int sign = (y) >> 31;                   \
         if (sign != (y) >> (30 - (n)))  {       \
@@ -65,7 +65,49 @@ static const int postSkip[NUM_IMDCT_SIZES] = {15, 1};
  *              i.e. gains 2-7= -5 int bits (short) or 2-10 = -8 int bits (long)
  *              normalization by -1/N is rolled into tables here (see trigtabs.c)
  *              uses 3-mul, 3-add butterflies instead of 4-mul, 2-add
+ *              the Neon version does two steps of the loop at once, the 2 front and
+ *                the 2 back butterflies in one vector each, same results as the C version
  **************************************************************************************/
+#if defined(AAC_ARM_NEON)
+static void PreMultiply(int tabidx, int *zbuf1)
+{
+	int i, nmdct;
+	int *zbuf2;
+	const int *csptr;
+	int32x2x4_t cs;
+	int32x2x2_t f, b;
+	int32x4_t cps2, sin2, ar, ai, t, z1, z2;
+
+	nmdct = nmdctTab[tabidx];
+	zbuf2 = zbuf1 + nmdct - 4;
+	csptr = cos4sin4tab + cos4sin4tabOffset[tabidx];
+
+	/* lanes: front butterflies of steps i, i+1, back butterflies of steps i, i+1
+	 * the front ones read/write zbuf1[0..3], the back ones zbuf2[0..3] in reverse
+	 */
+	for (i = nmdct >> 3; i != 0; i--) {
+		/* val[0..3] = cps2a, sin2a, cps2b, sin2b of steps i, i+1 */
+		cs = vld4_s32(csptr);
+		csptr += 8;
+		cps2 = vcombine_s32(cs.val[0], cs.val[2]);
+		sin2 = vcombine_s32(cs.val[1], cs.val[3]);
+
+		f = vld2_s32(zbuf1);
+		b = vld2_s32(zbuf2);
+		ar = vcombine_s32(f.val[0], vrev64_s32(b.val[0]));
+		ai = vcombine_s32(vrev64_s32(b.val[1]), f.val[1]);
+
+		t  = MULSHIFT32_X4(sin2, vaddq_s32(ar, ai));
+		z2 = vsubq_s32(MULSHIFT32_X4(cps2, ai), t);
+		z1 = vaddq_s32(MULSHIFT32_X4(vsubq_s32(cps2, vshlq_n_s32(sin2, 1)), ar), t);
+
+		vst2_s32(zbuf1, (int32x2x2_t){{vget_low_s32(z1), vget_low_s32(z2)}});
+		vst2_s32(zbuf2, (int32x2x2_t){{vrev64_s32(vget_high_s32(z1)), vrev64_s32(vget_high_s32(z2))}});
+		zbuf1 += 4;
+		zbuf2 -= 4;
+	}
+}
+#else
 static void PreMultiply(int tabidx, int *zbuf1)
 {
 	int i, nmdct, ar1, ai1, ar2, ai2, z1, z2;
@@ -110,6 +152,7 @@ static void PreMultiply(int tabidx, int *zbuf1)
 		*zbuf2-- = z1;	/* cos*ar2 + sin*ai2 */
 	}
 }
+#endif
 
 /**************************************************************************************
  * Function:    PostMultiply
@@ -125,7 +168,49 @@ static void PreMultiply(int tabidx, int *zbuf1)
  *
  * Notes:       minimum 1 GB in, 2 GB out - gains 2 int bits
  *              uses 3-mul, 3-add butterflies instead of 4-mul, 2-add
+ *              the Neon version does two steps of the loop at once for long blocks,
+ *                where the table is read without a skip, same results as the C version
  **************************************************************************************/
+#if defined(AAC_ARM_NEON)
+static void PostMultiplyLong(int *fft1, int nmdct)
+{
+	int i;
+	int *fft2;
+	const int *csptr;
+	int32x2x2_t cs0, cs1, f, b;
+	int32x4_t cps2, sin2, ar, ai, t, front, back;
+
+	csptr = cos1sin1tab;
+	fft2 = fft1 + nmdct - 4;
+
+	/* lanes: first butterfly of steps i, i+1, second butterfly of steps i, i+1
+	 * step i uses table entry i for its first butterfly and i+1 for its second one,
+	 *   so the lanes take entries i, i+1, i+1, i+2
+	 */
+	for (i = nmdct >> 3; i != 0; i--) {
+		cs0 = vld2_s32(csptr);
+		cs1 = vld2_s32(csptr + 2);
+		csptr += 4;
+		cps2 = vcombine_s32(cs0.val[0], cs1.val[0]);
+		sin2 = vcombine_s32(cs0.val[1], cs1.val[1]);
+
+		f = vld2_s32(fft1);
+		b = vld2_s32(fft2);
+		ar = vcombine_s32(f.val[0], vrev64_s32(b.val[0]));
+		ai = vcombine_s32(f.val[1], vneg_s32(vrev64_s32(b.val[1])));
+
+		t = MULSHIFT32_X4(sin2, vaddq_s32(ar, ai));
+		back = vsubq_s32(t, MULSHIFT32_X4(cps2, ai));	/* sin*ar - cos*ai */
+		front = vaddq_s32(t, MULSHIFT32_X4(vsubq_s32(cps2, vshlq_n_s32(sin2, 1)), ar));	/* cos*ar + sin*ai */
+
+		vst2_s32(fft1, (int32x2x2_t){{vget_low_s32(front), vget_high_s32(front)}});
+		vst2_s32(fft2, (int32x2x2_t){{vrev64_s32(vget_high_s32(back)), vrev64_s32(vget_low_s32(back))}});
+		fft1 += 4;
+		fft2 -= 4;
+	}
+}
+#endif
+
 static void PostMultiply(int tabidx, int *fft1)
 {
 	int i, nmdct, ar1, ai1, ar2, ai2, skipFactor;
@@ -138,6 +223,13 @@ static void PostMultiply(int tabidx, int *fft1)
 	skipFactor = postSkip[tabidx];
 	fft2 = fft1 + nmdct - 1;
 
+#if defined(AAC_ARM_NEON)
+	if (skipFactor == 1) {
+		PostMultiplyLong(fft1, nmdct);
+		return;
+	}
+#endif
+
 	/* load coeffs for first pass
 	 * cps2 = (cos+sin), sin2 = sin, cms2 = (cos-sin)
 	 */
@@ -258,7 +258,81 @@ static const int nfftlog2Tab[NUM_FFT_SIZES] =	{6, 9};
  *              min 1 GB in
  *              gbOut = gbIn - 1 (short block) or gbIn - 2 (long block)
  *              uses 3-mul, 3-add butterflies instead of 4-mul, 2-add
+ *              the Neon version does two butterflies of a group at once (gp is 4 or
+ *                more, so always even), same arithmetic and results as the C version
  **************************************************************************************/
+#if defined(AAC_ARM_NEON)
+static void R4Core(int *x, int bg, int gp, int *wtab)
+{
+	int32x2x2_t a, b, c, d, wb, wc, wd;
+	int32x4_t w0, w1;
+	int32x2_t tr, ti;
+	int i, j, step;
+	int *xptr, *wptr;
+
+	for (; bg != 0; gp <<= 2, bg >>= 2) {
+
+		step = 2 * gp;
+		xptr = x;
+
+		for (i = bg; i != 0; i--) {
+
+			wptr = wtab;
+
+			for (j = gp; j != 0; j -= 2) {
+
+				/* val[0] = (cos, cos), val[1] = (sin, sin) of butterflies j, j+1 */
+				w0 = vld1q_s32(wptr);
+				w1 = vld1q_s32(wptr + 6);
+				wb = vtrn_s32(vget_low_s32(w0), vget_low_s32(w1));
+				wc = vtrn_s32(vget_high_s32(w0), vget_high_s32(w1));
+				wd = vtrn_s32(vld1_s32(wptr + 4), vld1_s32(wptr + 10));
+				wptr += 12;
+
+				a = vld2_s32(xptr);
+				b = vld2_s32(xptr + step);
+				c = vld2_s32(xptr + 2 * step);
+				d = vld2_s32(xptr + 3 * step);
+
+				tr = MULSHIFT32_X2(wb.val[1], vadd_s32(b.val[0], b.val[1]));
+				b.val[0] = vsub_s32(MULSHIFT32_X2(vadd_s32(wb.val[0], vshl_n_s32(wb.val[1], 1)), b.val[0]), tr);
+				b.val[1] = vadd_s32(MULSHIFT32_X2(wb.val[0], b.val[1]), tr);
+
+				tr = MULSHIFT32_X2(wc.val[1], vadd_s32(c.val[0], c.val[1]));
+				c.val[0] = vsub_s32(MULSHIFT32_X2(vadd_s32(wc.val[0], vshl_n_s32(wc.val[1], 1)), c.val[0]), tr);
+				c.val[1] = vadd_s32(MULSHIFT32_X2(wc.val[0], c.val[1]), tr);
+
+				tr = MULSHIFT32_X2(wd.val[1], vadd_s32(d.val[0], d.val[1]));
+				d.val[0] = vsub_s32(MULSHIFT32_X2(vadd_s32(wd.val[0], vshl_n_s32(wd.val[1], 1)), d.val[0]), tr);
+				d.val[1] = vadd_s32(MULSHIFT32_X2(wd.val[0], d.val[1]), tr);
+
+				tr = vshr_n_s32(a.val[0], 2);
+				ti = vshr_n_s32(a.val[1], 2);
+				a.val[0] = vsub_s32(tr, b.val[0]);
+				a.val[1] = vsub_s32(ti, b.val[1]);
+				b.val[0] = vadd_s32(tr, b.val[0]);
+				b.val[1] = vadd_s32(ti, b.val[1]);
+
+				tr = c.val[0];
+				ti = c.val[1];
+				c.val[0] = vadd_s32(tr, d.val[0]);
+				c.val[1] = vsub_s32(d.val[1], ti);
+				d.val[0] = vsub_s32(tr, d.val[0]);
+				d.val[1] = vadd_s32(d.val[1], ti);
+
+				/* same outputs as the C version: (ar + ci, ai + dr), (br - cr, bi - di), ... */
+				vst2_s32(xptr + 3 * step, (int32x2x2_t){{vadd_s32(a.val[0], c.val[1]), vadd_s32(a.val[1], d.val[0])}});
+				vst2_s32(xptr + 2 * step, (int32x2x2_t){{vsub_s32(b.val[0], c.val[0]), vsub_s32(b.val[1], d.val[1])}});
+				vst2_s32(xptr + step, (int32x2x2_t){{vsub_s32(a.val[0], c.val[1]), vsub_s32(a.val[1], d.val[0])}});
+				vst2_s32(xptr, (int32x2x2_t){{vadd_s32(b.val[0], c.val[0]), vadd_s32(b.val[1], d.val[1])}});
+				xptr += 4;
+			}
+			xptr += 3 * step;
+		}
+		wtab += 3 * step;
+	}
+}
+#else
 /* __attribute__ ((section (".data"))) */ static void R4Core(int *x, int bg, int gp, int *wtab)
 {
 	int ar, ai, br, bi, cr, ci, dr, di, tr, ti;
@@ -354,6 +428,7 @@ static const int nfftlog2Tab[NUM_FFT_SIZES] =	{6, 9};
 		wtab += 3 * step;
 	}
 }
+#endif
 
 
 /**************************************************************************************
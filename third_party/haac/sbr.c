@@ -223,12 +223,16 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 	SBRGrid *sbrGrid;
 	SBRFreq *sbrFreq;
 	SBRChan *sbrChan;
+#ifdef AAC_ENABLE_PROFILE
+	unsigned int profMark;
+#endif
 
 	/* validate pointers */
 	if (!aacDecInfo || !aacDecInfo->psInfoSBR) {
 		return ERR_AAC_NULL_POINTER;
 	}
 	psi = (PSInfoSBR *)(aacDecInfo->psInfoSBR);
+	PROFILE_MARK(aacDecInfo, profMark);
 
 	/* same header and freq tables for both channels in CPE */
 	sbrHdr =  &(psi->sbrHdr[chBase]);
@@ -288,6 +292,7 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 			gbIdx = ((l + HF_GEN) >> 5) & 0x01;
 			sbrChan->gbMask[gbIdx] |= gbMask;	/* gbIdx = (0 if i < 32), (1 if i >= 32) */
 		}
+		PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_QMFA, profMark);
 
 		if (upsampleOnly) {
 			/* no SBR - just run synthesis QMF to upsample by 2x */
@@ -297,6 +302,7 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 				QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
 				outptr += 64 * aacDecInfo->nChans;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_QMFS, profMark);
 		} else {
 			/* if previous frame had lower SBR starting freq than current, zero out the synthesized QMF
 			 *   bands so they aren't used as sources for patching
@@ -312,6 +318,7 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 
 			/* step 2 - HF generation */
 			GenerateHighFreq(psi, sbrGrid, sbrFreq, sbrChan, ch);
+			PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_HFGEN, profMark);
 
 			/* restore SBR bands that were cleared before patch generation (time slots 0, 1 no longer needed) */
 			for (k = sbrFreq->kStartPrev; k < sbrFreq->kStart; k++) {
@@ -323,6 +330,7 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 
 			/* step 3 - HF adjustment */
 			AdjustHighFreq(psi, sbrHdr, sbrGrid, sbrFreq, sbrChan, ch);
+			PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_HFADJ, profMark);
 
 			/* step 4 - synthesis QMF */
 			qmfsBands = sbrFreq->kStartPrev + sbrFreq->numQMFBandsPrev;
@@ -338,6 +346,7 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 				QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
 				outptr += 64 * aacDecInfo->nChans;
 			}
+			PROFILE_ADD(aacDecInfo, AAC_PROF_SBR_QMFS, profMark);
 		}
 
 		/* save delay */
@@ -62,7 +62,59 @@
  * Return:      none
  *
  * Notes:       use this function when the decoded PCM is going to the SBR decoder
+ *              the Neon version does 4 steps of the loop at once, the sample sets it
+ *                reads and writes from the top and from the bottom of the overlap
+ *                buffer never meet, so the in-place update works as in the C loop
  **************************************************************************************/
+#if defined(AAC_ARM_NEON)
+static __inline int32x4_t ReverseX4(int32x4_t x)
+{
+	return vcombine_s32(vrev64_s32(vget_high_s32(x)), vrev64_s32(vget_low_s32(x)));
+}
+
+void DecWindowOverlapNoClip(int *buf0, int *over0, int *out0, int winTypeCurr, int winTypePrev)
+{
+	int i;
+	int *buf1, *over1, *out1;
+	const int *wndPrev, *wndCurr;
+	int32x4x2_t w;
+	int32x4_t in, f0, f1;
+
+	buf0 += (1024 >> 1);
+	buf1  = buf0  - 4;
+	out1  = out0 + 1024 - 4;
+	over1 = over0 + 1024 - 4;
+
+	wndPrev = (winTypePrev == 1 ? kbdWindow + kbdWindowOffset[1] : sinWindow + sinWindowOffset[1]);
+	wndCurr = (winTypeCurr == 1 ? kbdWindow + kbdWindowOffset[1] : sinWindow + sinWindowOffset[1]);
+
+	/* lanes n = 0..3 are steps i+n of the C loop, buf1/over1/out1 run downwards so they are reversed */
+	for (i = 0; i < (1024 >> 1); i += 4) {
+		w = vld2q_s32(wndPrev);
+		wndPrev += 8;
+		in = vld1q_s32(buf0);
+		buf0 += 4;
+
+		f0 = MULSHIFT32_X4(w.val[0], in);
+		f1 = MULSHIFT32_X4(w.val[1], in);
+
+		vst1q_s32(out0, vsubq_s32(vld1q_s32(over0), f0));
+		out0 += 4;
+		vst1q_s32(out1, vaddq_s32(vld1q_s32(over1), ReverseX4(f1)));
+		out1 -= 4;
+
+		w = vld2q_s32(wndCurr);
+		wndCurr += 8;
+		in = ReverseX4(vld1q_s32(buf1));
+		buf1 -= 4;
+
+		vst1q_s32(over1, ReverseX4(MULSHIFT32_X4(w.val[0], in)));
+		over1 -= 4;
+		vst1q_s32(over0, MULSHIFT32_X4(w.val[1], in));
+		over0 += 4;
+	}
+}
+#else
 void DecWindowOverlapNoClip(int *buf0, int *over0, int *out0, int winTypeCurr, int winTypePrev)
 {
 	int in, w0, w1, f0, f1;
@@ -121,6 +173,7 @@ void DecWindowOverlapNoClip(int *buf0, int *over0, int *out0, int winTypeCurr, i
 		} while (over0 < over1);
 	}
 }
+#endif
 
 /**************************************************************************************
  * Function:    DecWindowOverlapLongStart
@@ -221,9 +221,62 @@ static void PostMultiply64(int *fft1, int nSampsOut)
  *
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrqmfak.s when building for ARM!
+ *              the Neon version does outputs k and k+1 together: for each tap the
+ *                ring buffer only wraps between taps, never between outputs, so the
+ *                two delay samples of a tap are neighbours
  **************************************************************************************/
-#if 0
-void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf);
+#if defined(AAC_ARM_NEON)
+void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf)
+{
+	int j, k, dOff;
+	const int *dPtr[10];
+	const int *cPtr0, *cPtr1;
+	int32x2_t c, d;
+	int64x2_t lo, hi;
+
+	/* tap j of output k is delay[dOff(j) - k], dPtr[j] points at the pair for k = 0 */
+	dOff = dIdx * 32 + 31;
+	for (j = 0; j < 10; j++) {
+		dPtr[j] = delay + dOff - 1;
+		dOff -= 32;
+		if (dOff < 0) {
+			dOff += 320;
+		}
+	}
+
+	for (k = 0; k < 32; k += 2) {
+		cPtr0 = cTab + 5 * k;
+		cPtr1 = cTab + 33 * 5 - 1 - 5 * k;
+		lo = vdupq_n_s64(0);
+		hi = vdupq_n_s64(0);
+
+		for (j = 0; j < 5; j++) {
+			c = vset_lane_s32(cPtr0[5 + j], vdup_n_s32(cPtr0[j]), 1);
+			d = vrev64_s32(vld1_s32(dPtr[j] - k));
+			if (j & 0x01) {
+				hi = vmlal_s32(hi, c, d);
+			} else {
+				lo = vmlal_s32(lo, c, d);
+			}
+		}
+		for (j = 0; j < 5; j++) {
+			c = vset_lane_s32(cPtr1[-5 - j], vdup_n_s32(cPtr1[-j]), 1);
+			if (k == 0 && (j & 0x01)) {
+				/* flip sign to create cTab[384], cTab[512] */
+				c = vset_lane_s32(-cPtr1[-j], c, 0);
+			}
+			d = vrev64_s32(vld1_s32(dPtr[5 + j] - k));
+			if (j & 0x01) {
+				lo = vmlal_s32(lo, c, d);
+			} else {
+				hi = vmlal_s32(hi, c, d);
+			}
+		}
+
+		vst1_s32(uBuf + k, vshrn_n_s64(lo, 32));
+		vst1_s32(uBuf + 32 + k, vshrn_n_s64(hi, 32));
+	}
+}
 #else
 void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf)
 {
@@ -471,9 +524,57 @@ int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, i
  *
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrqmfsk.s when building for ARM!
+ *              the Neon version does outputs k and k+1 together, like QMFAnalysisConv
  **************************************************************************************/
-#if 0
-void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
+#if defined(AAC_ARM_NEON)
+void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans)
+{
+	int j, k, dOff0, dOff1;
+	const int *dPtr0[5], *dPtr1[5];
+	int32x2x2_t c;
+	int32x2_t d0, d1, hi;
+	int64x2_t sum;
+	int16x4_t pcm;
+
+	/* even taps read delay[dOff0(j) + k], odd taps delay[dOff1(j) - k] */
+	dOff0 = (dIdx) * 128;
+	dOff1 = dOff0 - 1;
+	if (dOff1 < 0) {
+		dOff1 += 1280;
+	}
+	for (j = 0; j < 5; j++) {
+		dPtr0[j] = delay + dOff0;
+		dPtr1[j] = delay + dOff1 - 1;
+		dOff0 -= 256;
+		if (dOff0 < 0) {
+			dOff0 += 1280;
+		}
+		dOff1 -= 256;
+		if (dOff1 < 0) {
+			dOff1 += 1280;
+		}
+	}
+
+	for (k = 0; k <= 63; k += 2) {
+		sum = vdupq_n_s64(0);
+		for (j = 0; j < 5; j++) {
+			/* c.val[0] = even tap of outputs k, k+1, c.val[1] = odd tap */
+			c = vtrn_s32(vld1_s32(cPtr + 2 * j), vld1_s32(cPtr + 10 + 2 * j));
+			d0 = vld1_s32(dPtr0[j] + k);
+			d1 = vrev64_s32(vld1_s32(dPtr1[j] - k));
+			sum = vmlal_s32(sum, c.val[0], d0);
+			sum = vmlal_s32(sum, c.val[1], d1);
+		}
+		cPtr += 20;
+
+		hi = vshrn_n_s64(sum, 32);
+		hi = vshr_n_s32(vadd_s32(hi, vdup_n_s32(RND_VAL)), FBITS_OUT_QMFS);
+		pcm = vqmovn_s32(vcombine_s32(hi, hi));
+		outbuf[0] = vget_lane_s16(pcm, 0);
+		outbuf[nChans] = vget_lane_s16(pcm, 1);
+		outbuf += 2 * nChans;
+	}
+}
 #else
 void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans)
 {
@@ -145,6 +145,25 @@ opus_uint32 opus_cpu_capabilities(void)
 	}
 	return flags;
 }
+#elif defined(__RTOS__) && defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'A')
+/* RTOS on an A-profile core: no /proc, but the code runs privileged and can
+ * read the feature registers. ARMv7-A and later always have EDSP and media. */
+
+opus_uint32 opus_cpu_capabilities(void)
+{
+	opus_uint32 flags = OPUS_CPU_ARM_EDSP_FLAG | OPUS_CPU_ARM_MEDIA_FLAG;
+
+# if defined(OPUS_ARM_MAY_HAVE_NEON) || defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+	opus_uint32 mvfr1;
+
+	/* MVFR1[11:8]: Advanced SIMD integer instructions. */
+	__asm__ __volatile__("vmrs %0, mvfr1" : "=r"(mvfr1));
+	if ((mvfr1 >> 8) & 0xF) {
+		flags |= OPUS_CPU_ARM_NEON_FLAG;
+	}
+# endif
+	return flags;
+}
 #else
 /* The feature registers which can tell us what the processor supports are
  * accessible in priveleged modes only, so we can't have a general user-space
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+   @file fft_radix4.c
+   @brief Fixed-point radix-4 real FFT for power of two sizes
+
+   A real FFT of nfft points runs as a complex FFT of ncfft = nfft/2 points on the even/odd
+   samples, followed by the same split kiss_fftr2 does. The complex FFT is decimation in time on
+   digit reversed input: a radix-2 pass first when log2(ncfft) is odd, then radix-4 passes.
+
+   Each radix-4 butterfly keeps its sums in 32 bits: the twiddle products are Q30 shifted down by
+   2, so the four terms add without overflow and the result is rounded once. The forward passes
+   scale by 1/4 (1/2 for the radix-2 pass), the inverse ones do not scale, like kiss_fft.
+   Kernels override r4_pass_forward/r4_pass_inverse, they must give the same results bit for bit.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include <string.h>
+
+#include "arch.h"
+#include "os_support.h"
+#include "fft_radix4.h"
+
+#ifdef FIXED_POINT
+
+#define R4_MIN_FFT_SIZE 16
+#define R4_MAX_FFT_SIZE 4096
+
+typedef struct {
+   spx_int16_t r;
+   spx_int16_t i;
+} spx_r4_cpx;
+
+struct spx_r4_fft_state {
+   int nfft;
+   int ncfft;
+   /* log2(ncfft) is odd, the first pass is radix-2 */
+   int radix2;
+   spx_r4_cpx *tmpbuf;
+   /* for each radix-4 pass with sub length L > 1: w^k, w^2k, w^3k of w = e^(-2*pi*i/4L), L entries each */
+   spx_r4_cpx *twiddles;
+   /* e^(-i*pi*(k/ncfft + 1/2)) for the real split, k = 0..ncfft/2 */
+   spx_r4_cpx *super_twiddles;
+   spx_uint16_t *bitrev;
+};
+
+static void r4_bfly_forward(spx_r4_cpx *f, int L, const spx_r4_cpx *w1, const spx_r4_cpx *w2, const spx_r4_cpx *w3)
+{
+   /* f[L] holds the sub transform of the 4n+2 samples and f[2L] the 4n+1 ones, digit reversal order */
+   spx_word32_t t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+   spx_word32_t s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i;
+
+   t0r = SHL32(EXTEND32(f[0].r), 13);
+   t0i = SHL32(EXTEND32(f[0].i), 13);
+   t1r = SHR32(SUB32(MULT16_16(f[2*L].r, w1->r), MULT16_16(f[2*L].i, w1->i)), 2);
+   t1i = SHR32(ADD32(MULT16_16(f[2*L].r, w1->i), MULT16_16(f[2*L].i, w1->r)), 2);
+   t2r = SHR32(SUB32(MULT16_16(f[L].r, w2->r), MULT16_16(f[L].i, w2->i)), 2);
+   t2i = SHR32(ADD32(MULT16_16(f[L].r, w2->i), MULT16_16(f[L].i, w2->r)), 2);
+   t3r = SHR32(SUB32(MULT16_16(f[3*L].r, w3->r), MULT16_16(f[3*L].i, w3->i)), 2);
+   t3i = SHR32(ADD32(MULT16_16(f[3*L].r, w3->i), MULT16_16(f[3*L].i, w3->r)), 2);
+
+   s0r = ADD32(t0r, t2r);
+   s0i = ADD32(t0i, t2i);
+   s1r = SUB32(t0r, t2r);
+   s1i = SUB32(t0i, t2i);
+   s2r = ADD32(t1r, t3r);
+   s2i = ADD32(t1i, t3i);
+   s3r = SUB32(t1r, t3r);
+   s3i = SUB32(t1i, t3i);
+
+   f[0].r = PSHR32(ADD32(s0r, s2r), 15);
+   f[0].i = PSHR32(ADD32(s0i, s2i), 15);
+   f[L].r = PSHR32(ADD32(s1r, s3i), 15);
+   f[L].i = PSHR32(SUB32(s1i, s3r), 15);
+   f[2*L].r = PSHR32(SUB32(s0r, s2r), 15);
+   f[2*L].i = PSHR32(SUB32(s0i, s2i), 15);
+   f[3*L].r = PSHR32(SUB32(s1r, s3i), 15);
+   f[3*L].i = PSHR32(ADD32(s1i, s3r), 15);
+}
+
+static void r4_bfly_inverse(spx_r4_cpx *f, int L, const spx_r4_cpx *w1, const spx_r4_cpx *w2, const spx_r4_cpx *w3)
+{
+   spx_word32_t t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+   spx_word32_t s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i;
+
+   /* conjugate twiddles */
+   t0r = SHL32(EXTEND32(f[0].r), 13);
+   t0i = SHL32(EXTEND32(f[0].i), 13);
+   t1r = SHR32(ADD32(MULT16_16(f[2*L].r, w1->r), MULT16_16(f[2*L].i, w1->i)), 2);
+   t1i = SHR32(SUB32(MULT16_16(f[2*L].i, w1->r), MULT16_16(f[2*L].r, w1->i)), 2);
+   t2r = SHR32(ADD32(MULT16_16(f[L].r, w2->r), MULT16_16(f[L].i, w2->i)), 2);
+   t2i = SHR32(SUB32(MULT16_16(f[L].i, w2->r), MULT16_16(f[L].r, w2->i)), 2);
+   t3r = SHR32(ADD32(MULT16_16(f[3*L].r, w3->r), MULT16_16(f[3*L].i, w3->i)), 2);
+   t3i = SHR32(SUB32(MULT16_16(f[3*L].i, w3->r), MULT16_16(f[3*L].r, w3->i)), 2);
+
+   s0r = ADD32(t0r, t2r);
+   s0i = ADD32(t0i, t2i);
+   s1r = SUB32(t0r, t2r);
+   s1i = SUB32(t0i, t2i);
+   s2r = ADD32(t1r, t3r);
+   s2i = ADD32(t1i, t3i);
+   s3r = SUB32(t1r, t3r);
+   s3i = SUB32(t1i, t3i);
+
+   f[0].r = PSHR32(ADD32(s0r, s2r), 13);
+   f[0].i = PSHR32(ADD32(s0i, s2i), 13);
+   f[L].r = PSHR32(SUB32(s1r, s3i), 13);
+   f[L].i = PSHR32(ADD32(s1i, s3r), 13);
+   f[2*L].r = PSHR32(SUB32(s0r, s2r), 13);
+   f[2*L].i = PSHR32(SUB32(s0i, s2i), 13);
+   f[3*L].r = PSHR32(ADD32(s1r, s3i), 13);
+   f[3*L].i = PSHR32(SUB32(s1i, s3r), 13);
+}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include "fft_radix4_neon.h"
+#elif defined(__ARM_FEATURE_DSP)
+#include "fft_radix4_arm_dsp.h"
+#endif
+
+#ifndef OVERRIDE_R4_PASS_FORWARD
+static void r4_pass_forward(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+   int b, k;
+   for (b = 0; b < ncfft; b += 4*L)
+      for (k = 0; k < L; k++)
+         r4_bfly_forward(f + b + k, L, tw + k, tw + L + k, tw + 2*L + k);
+}
+#endif
+
+#ifndef OVERRIDE_R4_PASS_INVERSE
+static void r4_pass_inverse(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+   int b, k;
+   for (b = 0; b < ncfft; b += 4*L)
+      for (k = 0; k < L; k++)
+         r4_bfly_inverse(f + b + k, L, tw + k, tw + L + k, tw + 2*L + k);
+}
+#endif
+
+/* The first pass, on digit reversed single points: radix-2 when log2(ncfft) is odd, otherwise
+   radix-4 with all twiddles 1. */
+static void r4_first_pass(spx_r4_cpx *f, int ncfft, int radix2, int inverse)
+{
+   int b;
+   int shift = inverse ? 0 : (radix2 ? 1 : 2);
+
+   if (radix2)
+   {
+      for (b = 0; b < ncfft; b += 2)
+      {
+         spx_word32_t ar = f[b].r, ai = f[b].i, cr = f[b+1].r, ci = f[b+1].i;
+         f[b].r = PSHR32(ADD32(ar, cr), shift);
+         f[b].i = PSHR32(ADD32(ai, ci), shift);
+         f[b+1].r = PSHR32(SUB32(ar, cr), shift);
+         f[b+1].i = PSHR32(SUB32(ai, ci), shift);
+      }
+      return;
+   }
+   for (b = 0; b < ncfft; b += 4)
+   {
+      spx_word32_t s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i;
+      s0r = ADD32(f[b].r, f[b+1].r);
+      s0i = ADD32(f[b].i, f[b+1].i);
+      s1r = SUB32(f[b].r, f[b+1].r);
+      s1i = SUB32(f[b].i, f[b+1].i);
+      s2r = ADD32(f[b+2].r, f[b+3].r);
+      s2i = ADD32(f[b+2].i, f[b+3].i);
+      s3r = SUB32(f[b+2].r, f[b+3].r);
+      s3i = SUB32(f[b+2].i, f[b+3].i);
+      if (inverse)
+      {
+         s3r = -s3r;
+         s3i = -s3i;
+      }
+      f[b].r = PSHR32(ADD32(s0r, s2r), shift);
+      f[b].i = PSHR32(ADD32(s0i, s2i), shift);
+      f[b+1].r = PSHR32(ADD32(s1r, s3i), shift);
+      f[b+1].i = PSHR32(SUB32(s1i, s3r), shift);
+      f[b+2].r = PSHR32(SUB32(s0r, s2r), shift);
+      f[b+2].i = PSHR32(SUB32(s0i, s2i), shift);
+      f[b+3].r = PSHR32(SUB32(s1r, s3i), shift);
+      f[b+3].i = PSHR32(ADD32(s1i, s3r), shift);
+   }
+}
+
+static void r4_cfft(spx_r4_fft_cfg st, int inverse)
+{
+   spx_r4_cpx *tw = st->twiddles;
+   int L = st->radix2 ? 2 : 4;
+
+   r4_first_pass(st->tmpbuf, st->ncfft, st->radix2, inverse);
+   for (; L < st->ncfft; L *= 4)
+   {
+      if (inverse)
+         r4_pass_inverse(st->tmpbuf, tw, L, st->ncfft);
+      else
+         r4_pass_forward(st->tmpbuf, tw, L, st->ncfft);
+      tw += 3*L;
+   }
+}
+
+static spx_r4_cpx r4_cexp(double phase)
+{
+   spx_r4_cpx w;
+   double r = floor(.5 + 32768. * cos(phase));
+   double i = floor(.5 + 32768. * sin(phase));
+   /* keep |w| <= 1 so no product is -32768*-32768 */
+   w.r = (spx_int16_t)(r > 32767. ? 32767. : (r < -32767. ? -32767. : r));
+   w.i = (spx_int16_t)(i > 32767. ? 32767. : (i < -32767. ? -32767. : i));
+   return w;
+}
+
+int spx_r4_fft_supports(int nfft)
+{
+   return nfft >= R4_MIN_FFT_SIZE && nfft <= R4_MAX_FFT_SIZE && (nfft & (nfft - 1)) == 0;
+}
+
+spx_r4_fft_cfg spx_r4_fft_alloc(int nfft)
+{
+   const double pi = 3.14159265358979323846264338327;
+   spx_r4_fft_cfg st;
+   int ncfft, bits, L, i, k;
+   int ntw = 0;
+
+   if (!spx_r4_fft_supports(nfft))
+      return NULL;
+   ncfft = nfft >> 1;
+   for (bits = 0; (1 << bits) < ncfft; bits++)
+      ;
+
+   st = (spx_r4_fft_cfg)speex_alloc(sizeof(struct spx_r4_fft_state));
+   if (!st)
+      return NULL;
+   st->nfft = nfft;
+   st->ncfft = ncfft;
+   st->radix2 = bits & 1;
+   for (L = st->radix2 ? 2 : 4; L < ncfft; L *= 4)
+      ntw += 3*L;
+
+   st->tmpbuf = (spx_r4_cpx *)speex_alloc(ncfft * sizeof(spx_r4_cpx));
+   st->twiddles = (spx_r4_cpx *)speex_alloc(ntw * sizeof(spx_r4_cpx));
+   st->super_twiddles = (spx_r4_cpx *)speex_alloc((ncfft/2 + 1) * sizeof(spx_r4_cpx));
+   st->bitrev = (spx_uint16_t *)speex_alloc(ncfft * sizeof(spx_uint16_t));
+   if (!st->tmpbuf || !st->twiddles || !st->super_twiddles || !st->bitrev)
+   {
+      spx_r4_fft_free(st);
+      return NULL;
+   }
+
+   for (i = 0; i < ncfft; i++)
+   {
+      int rev = 0;
+      for (k = 0; k < bits; k++)
+         rev |= ((i >> k) & 1) << (bits - 1 - k);
+      st->bitrev[i] = rev;
+   }
+
+   ntw = 0;
+   for (L = st->radix2 ? 2 : 4; L < ncfft; L *= 4)
+   {
+      for (k = 0; k < L; k++)
+      {
+         st->twiddles[ntw + k] = r4_cexp(-2. * pi * k / (4 * L));
+         st->twiddles[ntw + L + k] = r4_cexp(-2. * pi * 2 * k / (4 * L));
+         st->twiddles[ntw + 2*L + k] = r4_cexp(-2. * pi * 3 * k / (4 * L));
+      }
+      ntw += 3*L;
+   }
+
+   for (k = 0; k <= ncfft/2; k++)
+      st->super_twiddles[k] = r4_cexp(-pi * ((double)k / ncfft + .5));
+
+   return st;
+}
+
+void spx_r4_fft_free(spx_r4_fft_cfg st)
+{
+   if (!st)
+      return;
+   speex_free(st->tmpbuf);
+   speex_free(st->twiddles);
+   speex_free(st->super_twiddles);
+   speex_free(st->bitrev);
+   speex_free(st);
+}
+
+void spx_r4_fftr(spx_r4_fft_cfg st, const spx_word16_t *timedata, spx_word16_t *freqdata)
+{
+   spx_r4_cpx *tmp = st->tmpbuf;
+   int ncfft = st->ncfft;
+   int k;
+
+   for (k = 0; k < ncfft; k++)
+   {
+      tmp[k].r = timedata[2*st->bitrev[k]];
+      tmp[k].i = timedata[2*st->bitrev[k] + 1];
+   }
+   r4_cfft(st, 0);
+
+   freqdata[0] = PSHR32(ADD32(tmp[0].r, tmp[0].i), 1);
+   freqdata[2*ncfft-1] = PSHR32(SUB32(tmp[0].r, tmp[0].i), 1);
+   for (k = 1; k <= ncfft/2; k++)
+   {
+      const spx_r4_cpx *tw = &st->super_twiddles[k];
+      spx_word16_t f2kr, f2ki;
+      spx_word32_t f1kr, f1ki, twr, twi;
+
+      f2kr = PSHR32(SUB32(tmp[k].r, tmp[ncfft-k].r), 1);
+      f2ki = PSHR32(ADD32(tmp[k].i, tmp[ncfft-k].i), 1);
+      f1kr = SHL32(ADD32(tmp[k].r, tmp[ncfft-k].r), 13);
+      f1ki = SHL32(SUB32(tmp[k].i, tmp[ncfft-k].i), 13);
+      twr = SHR32(SUB32(MULT16_16(f2kr, tw->r), MULT16_16(f2ki, tw->i)), 1);
+      twi = SHR32(ADD32(MULT16_16(f2ki, tw->r), MULT16_16(f2kr, tw->i)), 1);
+
+      freqdata[2*k-1] = PSHR32(ADD32(f1kr, twr), 15);
+      freqdata[2*k] = PSHR32(ADD32(f1ki, twi), 15);
+      freqdata[2*(ncfft-k)-1] = PSHR32(SUB32(f1kr, twr), 15);
+      freqdata[2*(ncfft-k)] = PSHR32(SUB32(twi, f1ki), 15);
+   }
+}
+
+void spx_r4_fftri(spx_r4_fft_cfg st, const spx_word16_t *freqdata, spx_word16_t *timedata)
+{
+   spx_r4_cpx *tmp = st->tmpbuf;
+   int ncfft = st->ncfft;
+   int k;
+
+   /* the split writes straight to the digit reversed positions */
+   tmp[0].r = ADD16(freqdata[0], freqdata[2*ncfft-1]);
+   tmp[0].i = SUB16(freqdata[0], freqdata[2*ncfft-1]);
+   for (k = 1; k <= ncfft/2; k++)
+   {
+      const spx_r4_cpx *tw = &st->super_twiddles[k];
+      spx_word16_t fekr, feki, dr, di, fokr, foki;
+
+      fekr = ADD16(freqdata[2*k-1], freqdata[2*(ncfft-k)-1]);
+      feki = SUB16(freqdata[2*k], freqdata[2*(ncfft-k)]);
+      dr = SUB16(freqdata[2*k-1], freqdata[2*(ncfft-k)-1]);
+      di = ADD16(freqdata[2*k], freqdata[2*(ncfft-k)]);
+      fokr = PSHR32(ADD32(MULT16_16(dr, tw->r), MULT16_16(di, tw->i)), 15);
+      foki = PSHR32(SUB32(MULT16_16(di, tw->r), MULT16_16(dr, tw->i)), 15);
+
+      tmp[st->bitrev[k]].r = ADD16(fekr, fokr);
+      tmp[st->bitrev[k]].i = ADD16(feki, foki);
+      tmp[st->bitrev[ncfft-k]].r = SUB16(fekr, fokr);
+      tmp[st->bitrev[ncfft-k]].i = SUB16(foki, feki);
+   }
+   r4_cfft(st, 1);
+
+   memcpy(timedata, tmp, ncfft * sizeof(spx_r4_cpx));
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+   @file fft_radix4.h
+   @brief Fixed-point radix-4 real FFT for power of two sizes
+*/
+
+#ifndef FFT_RADIX4_H
+#define FFT_RADIX4_H
+
+#include "arch.h"
+
+#ifdef FIXED_POINT
+
+typedef struct spx_r4_fft_state *spx_r4_fft_cfg;
+
+/** Non zero when nfft is a size the radix-4 FFT handles: a power of two from 16 to 4096. */
+int spx_r4_fft_supports(int nfft);
+
+/** One table serves both directions. Returns NULL for an unsupported size. */
+spx_r4_fft_cfg spx_r4_fft_alloc(int nfft);
+
+void spx_r4_fft_free(spx_r4_fft_cfg st);
+
+/** Real to half-complex, scaled by 1/nfft, packed like kiss_fftr2:
+    {DC, re(1), im(1), ..., re(nfft/2-1), im(nfft/2-1), nyquist}. */
+void spx_r4_fftr(spx_r4_fft_cfg st, const spx_word16_t *timedata, spx_word16_t *freqdata);
+
+/** Half-complex to real, unscaled, the inverse of spx_r4_fftr like kiss_fftri2. */
+void spx_r4_fftri(spx_r4_fft_cfg st, const spx_word16_t *freqdata, spx_word16_t *timedata);
+
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+   @file fft_radix4_arm_dsp.h
+   @brief Radix-4 FFT passes (Armv7E-M/Armv8-M DSP extension version)
+*/
+
+#if defined(FIXED_POINT) && defined(__ARM_FEATURE_DSP)
+
+#include <string.h>
+
+/* One complex sample in one word, real part in the low half. */
+static inline uint32_t r4_read_cpx(const spx_r4_cpx *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void r4_write_cpx(spx_r4_cpx *p, spx_word32_t re, spx_word32_t im) {
+    uint32_t v = ((uint32_t)re & 0xffff) | ((uint32_t)im << 16);
+    memcpy(p, &v, sizeof(v));
+}
+
+/* x.lo*y.lo - x.hi*y.hi */
+static inline int32_t smusd(uint32_t x, uint32_t y) {
+    int32_t ret;
+    asm ("smusd %[ret], %[x], %[y]"
+         : [ret] "=r" (ret)
+         : [x] "r" (x), [y] "r" (y)
+         : );
+    return ret;
+}
+
+/* x.lo*y.lo + x.hi*y.hi */
+static inline int32_t smuad(uint32_t x, uint32_t y) {
+    int32_t ret;
+    asm ("smuad %[ret], %[x], %[y]"
+         : [ret] "=r" (ret)
+         : [x] "r" (x), [y] "r" (y)
+         : );
+    return ret;
+}
+
+/* x.lo*y.hi + x.hi*y.lo */
+static inline int32_t smuadx(uint32_t x, uint32_t y) {
+    int32_t ret;
+    asm ("smuadx %[ret], %[x], %[y]"
+         : [ret] "=r" (ret)
+         : [x] "r" (x), [y] "r" (y)
+         : );
+    return ret;
+}
+
+/* x.lo*y.hi - x.hi*y.lo */
+static inline int32_t smusdx(uint32_t x, uint32_t y) {
+    int32_t ret;
+    asm ("smusdx %[ret], %[x], %[y]"
+         : [ret] "=r" (ret)
+         : [x] "r" (x), [y] "r" (y)
+         : );
+    return ret;
+}
+
+/* Each complex multiply is two dual 16 bit MACs. The twiddles never hold -32768, so the sums
+   cannot overflow and the results match r4_bfly_forward/r4_bfly_inverse. */
+#define OVERRIDE_R4_PASS_FORWARD
+static void r4_pass_forward(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+    int b, k;
+
+    for (b = 0; b < ncfft; b += 4*L) {
+        spx_r4_cpx *p = f + b;
+        for (k = 0; k < L; k++, p++) {
+            uint32_t d0 = r4_read_cpx(p);
+            uint32_t d2 = r4_read_cpx(p + L);
+            uint32_t d1 = r4_read_cpx(p + 2*L);
+            uint32_t d3 = r4_read_cpx(p + 3*L);
+            uint32_t w1 = r4_read_cpx(tw + k);
+            uint32_t w2 = r4_read_cpx(tw + L + k);
+            uint32_t w3 = r4_read_cpx(tw + 2*L + k);
+            spx_word32_t t0r = (int32_t)(d0 << 16) >> 3;
+            spx_word32_t t0i = (int32_t)(d0 & 0xffff0000) >> 3;
+            spx_word32_t t1r = smusd(d1, w1) >> 2;
+            spx_word32_t t1i = smuadx(d1, w1) >> 2;
+            spx_word32_t t2r = smusd(d2, w2) >> 2;
+            spx_word32_t t2i = smuadx(d2, w2) >> 2;
+            spx_word32_t t3r = smusd(d3, w3) >> 2;
+            spx_word32_t t3i = smuadx(d3, w3) >> 2;
+            spx_word32_t s0r = t0r + t2r, s0i = t0i + t2i;
+            spx_word32_t s1r = t0r - t2r, s1i = t0i - t2i;
+            spx_word32_t s2r = t1r + t3r, s2i = t1i + t3i;
+            spx_word32_t s3r = t1r - t3r, s3i = t1i - t3i;
+
+            r4_write_cpx(p, PSHR32(s0r + s2r, 15), PSHR32(s0i + s2i, 15));
+            r4_write_cpx(p + L, PSHR32(s1r + s3i, 15), PSHR32(s1i - s3r, 15));
+            r4_write_cpx(p + 2*L, PSHR32(s0r - s2r, 15), PSHR32(s0i - s2i, 15));
+            r4_write_cpx(p + 3*L, PSHR32(s1r - s3i, 15), PSHR32(s1i + s3r, 15));
+        }
+    }
+}
+
+#define OVERRIDE_R4_PASS_INVERSE
+static void r4_pass_inverse(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+    int b, k;
+
+    for (b = 0; b < ncfft; b += 4*L) {
+        spx_r4_cpx *p = f + b;
+        for (k = 0; k < L; k++, p++) {
+            uint32_t d0 = r4_read_cpx(p);
+            uint32_t d2 = r4_read_cpx(p + L);
+            uint32_t d1 = r4_read_cpx(p + 2*L);
+            uint32_t d3 = r4_read_cpx(p + 3*L);
+            uint32_t w1 = r4_read_cpx(tw + k);
+            uint32_t w2 = r4_read_cpx(tw + L + k);
+            uint32_t w3 = r4_read_cpx(tw + 2*L + k);
+            spx_word32_t t0r = (int32_t)(d0 << 16) >> 3;
+            spx_word32_t t0i = (int32_t)(d0 & 0xffff0000) >> 3;
+            spx_word32_t t1r = smuad(d1, w1) >> 2;
+            spx_word32_t t1i = smusdx(w1, d1) >> 2;
+            spx_word32_t t2r = smuad(d2, w2) >> 2;
+            spx_word32_t t2i = smusdx(w2, d2) >> 2;
+            spx_word32_t t3r = smuad(d3, w3) >> 2;
+            spx_word32_t t3i = smusdx(w3, d3) >> 2;
+            spx_word32_t s0r = t0r + t2r, s0i = t0i + t2i;
+            spx_word32_t s1r = t0r - t2r, s1i = t0i - t2i;
+            spx_word32_t s2r = t1r + t3r, s2i = t1i + t3i;
+            spx_word32_t s3r = t1r - t3r, s3i = t1i - t3i;
+
+            r4_write_cpx(p, PSHR32(s0r + s2r, 13), PSHR32(s0i + s2i, 13));
+            r4_write_cpx(p + L, PSHR32(s1r - s3i, 13), PSHR32(s1i + s3r, 13));
+            r4_write_cpx(p + 2*L, PSHR32(s0r - s2r, 13), PSHR32(s0i - s2i, 13));
+            r4_write_cpx(p + 3*L, PSHR32(s1r + s3i, 13), PSHR32(s1i - s3r, 13));
+        }
+    }
+}
+
+#endif
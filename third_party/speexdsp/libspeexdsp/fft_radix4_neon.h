@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+   @file fft_radix4_neon.h
+   @brief Radix-4 FFT passes (NEON version)
+*/
+
+#if defined(FIXED_POINT)
+
+#include <arm_neon.h>
+
+/* Four butterflies per step, vld2 splits the interleaved samples into real and imaginary
+   lanes. The widening multiplies keep the C arithmetic, so the results match r4_bfly_forward and
+   r4_bfly_inverse bit for bit. Passes with L < 4 stay on the C butterflies. */
+
+#define R4_NEON_TWIDDLE(d, w, re, im, inverse) do { \
+    if (inverse) { \
+        re = vshrq_n_s32(vmlal_s16(vmull_s16(d.val[0], w.val[0]), d.val[1], w.val[1]), 2); \
+        im = vshrq_n_s32(vmlsl_s16(vmull_s16(d.val[1], w.val[0]), d.val[0], w.val[1]), 2); \
+    } else { \
+        re = vshrq_n_s32(vmlsl_s16(vmull_s16(d.val[0], w.val[0]), d.val[1], w.val[1]), 2); \
+        im = vshrq_n_s32(vmlal_s16(vmull_s16(d.val[0], w.val[1]), d.val[1], w.val[0]), 2); \
+    } \
+} while (0)
+
+static inline void r4_pass_neon(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft, int inverse)
+{
+    int b, k;
+
+    for (b = 0; b < ncfft; b += 4*L) {
+        int16_t *p = (int16_t *)(f + b);
+        for (k = 0; k < L; k += 4) {
+            int16x4x2_t d0 = vld2_s16(p + 2*k);
+            int16x4x2_t d2 = vld2_s16(p + 2*(k + L));
+            int16x4x2_t d1 = vld2_s16(p + 2*(k + 2*L));
+            int16x4x2_t d3 = vld2_s16(p + 2*(k + 3*L));
+            int16x4x2_t w1 = vld2_s16((const int16_t *)(tw + k));
+            int16x4x2_t w2 = vld2_s16((const int16_t *)(tw + L + k));
+            int16x4x2_t w3 = vld2_s16((const int16_t *)(tw + 2*L + k));
+            int32x4_t t0r = vshll_n_s16(d0.val[0], 13);
+            int32x4_t t0i = vshll_n_s16(d0.val[1], 13);
+            int32x4_t t1r, t1i, t2r, t2i, t3r, t3i;
+            int32x4_t s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i;
+            int16x4x2_t x;
+
+            R4_NEON_TWIDDLE(d1, w1, t1r, t1i, inverse);
+            R4_NEON_TWIDDLE(d2, w2, t2r, t2i, inverse);
+            R4_NEON_TWIDDLE(d3, w3, t3r, t3i, inverse);
+
+            s0r = vaddq_s32(t0r, t2r);
+            s0i = vaddq_s32(t0i, t2i);
+            s1r = vsubq_s32(t0r, t2r);
+            s1i = vsubq_s32(t0i, t2i);
+            s2r = vaddq_s32(t1r, t3r);
+            s2i = vaddq_s32(t1i, t3i);
+            s3r = vsubq_s32(t1r, t3r);
+            s3i = vsubq_s32(t1i, t3i);
+            if (inverse) {
+                /* s1 + j*s3 goes to f[L], s1 - j*s3 to f[3L] */
+                s3r = vnegq_s32(s3r);
+                s3i = vnegq_s32(s3i);
+            }
+
+            if (inverse) {
+                x.val[0] = vrshrn_n_s32(vaddq_s32(s0r, s2r), 13);
+                x.val[1] = vrshrn_n_s32(vaddq_s32(s0i, s2i), 13);
+                vst2_s16(p + 2*k, x);
+                x.val[0] = vrshrn_n_s32(vaddq_s32(s1r, s3i), 13);
+                x.val[1] = vrshrn_n_s32(vsubq_s32(s1i, s3r), 13);
+                vst2_s16(p + 2*(k + L), x);
+                x.val[0] = vrshrn_n_s32(vsubq_s32(s0r, s2r), 13);
+                x.val[1] = vrshrn_n_s32(vsubq_s32(s0i, s2i), 13);
+                vst2_s16(p + 2*(k + 2*L), x);
+                x.val[0] = vrshrn_n_s32(vsubq_s32(s1r, s3i), 13);
+                x.val[1] = vrshrn_n_s32(vaddq_s32(s1i, s3r), 13);
+                vst2_s16(p + 2*(k + 3*L), x);
+            } else {
+                x.val[0] = vrshrn_n_s32(vaddq_s32(s0r, s2r), 15);
+                x.val[1] = vrshrn_n_s32(vaddq_s32(s0i, s2i), 15);
+                vst2_s16(p + 2*k, x);
+                x.val[0] = vrshrn_n_s32(vaddq_s32(s1r, s3i), 15);
+                x.val[1] = vrshrn_n_s32(vsubq_s32(s1i, s3r), 15);
+                vst2_s16(p + 2*(k + L), x);
+                x.val[0] = vrshrn_n_s32(vsubq_s32(s0r, s2r), 15);
+                x.val[1] = vrshrn_n_s32(vsubq_s32(s0i, s2i), 15);
+                vst2_s16(p + 2*(k + 2*L), x);
+                x.val[0] = vrshrn_n_s32(vsubq_s32(s1r, s3i), 15);
+                x.val[1] = vrshrn_n_s32(vaddq_s32(s1i, s3r), 15);
+                vst2_s16(p + 2*(k + 3*L), x);
+            }
+        }
+    }
+}
+
+#define OVERRIDE_R4_PASS_FORWARD
+static void r4_pass_forward(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+    int b, k;
+
+    if ((L & 3) == 0) {
+        r4_pass_neon(f, tw, L, ncfft, 0);
+        return;
+    }
+    for (b = 0; b < ncfft; b += 4*L)
+        for (k = 0; k < L; k++)
+            r4_bfly_forward(f + b + k, L, tw + k, tw + L + k, tw + 2*L + k);
+}
+
+#define OVERRIDE_R4_PASS_INVERSE
+static void r4_pass_inverse(spx_r4_cpx *f, const spx_r4_cpx *tw, int L, int ncfft)
+{
+    int b, k;
+
+    if ((L & 3) == 0) {
+        r4_pass_neon(f, tw, L, ncfft, 1);
+        return;
+    }
+    for (b = 0; b < ncfft; b += 4*L)
+        for (k = 0; k < L; k++)
+            r4_bfly_inverse(f + b + k, L, tw + k, tw + L + k, tw + 2*L + k);
+}
+
+#endif
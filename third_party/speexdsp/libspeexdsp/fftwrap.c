@@ -292,8 +292,13 @@ void spx_ifft(void *table, spx_word16_t *in, spx_word16_t *out)
 
 #elif defined(USE_KISS_FFT)
 
+#include <string.h>
 #include "kiss_fftr.h"
 #include "kiss_fft.h"
+#include "fftwrap.h"
+#ifdef USE_RADIX4_FFT
+#include "fft_radix4.h"
+#endif
 
 struct kiss_config {
    kiss_fftr_cfg forward;
@@ -301,7 +306,12 @@ struct kiss_config {
    int N;
 };
 
-void *spx_fft_init(int size)
+static int kiss_supports(int size)
+{
+   return size > 0 && (size & 1) == 0;
+}
+
+static void *kiss_init(int size)
 {
    struct kiss_config *table;
    table = (struct kiss_config*)speex_alloc(sizeof(struct kiss_config));
@@ -311,7 +321,7 @@ void *spx_fft_init(int size)
    return table;
 }
 
-void spx_fft_destroy(void *table)
+static void kiss_destroy(void *table)
 {
    struct kiss_config *t = (struct kiss_config *)table;
    kiss_fftr_free(t->forward);
@@ -321,19 +331,15 @@ void spx_fft_destroy(void *table)
 
 #ifdef FIXED_POINT
 
-void spx_fft(void *table, spx_word16_t *in, spx_word16_t *out)
+static void kiss_forward(void *table, spx_word16_t *in, spx_word16_t *out)
 {
-   int shift;
    struct kiss_config *t = (struct kiss_config *)table;
-   shift = maximize_range(in, in, 32000, t->N);
    kiss_fftr2(t->forward, in, out);
-   renorm_range(in, in, shift, t->N);
-   renorm_range(out, out, shift, t->N);
 }
 
 #else
 
-void spx_fft(void *table, spx_word16_t *in, spx_word16_t *out)
+static void kiss_forward(void *table, spx_word16_t *in, spx_word16_t *out)
 {
    int i;
    float scale;
@@ -345,12 +351,146 @@ void spx_fft(void *table, spx_word16_t *in, spx_word16_t *out)
 }
 #endif
 
-void spx_ifft(void *table, spx_word16_t *in, spx_word16_t *out)
+static void kiss_backward(void *table, spx_word16_t *in, spx_word16_t *out)
 {
    struct kiss_config *t = (struct kiss_config *)table;
    kiss_fftri2(t->backward, in, out);
 }
 
+static const SpxFftBackend kiss_backend = {
+   "kiss", kiss_supports, kiss_init, kiss_destroy, kiss_forward, kiss_backward
+};
+
+#ifdef USE_RADIX4_FFT
+
+static void *radix4_init(int size)
+{
+   return spx_r4_fft_alloc(size);
+}
+
+static void radix4_destroy(void *table)
+{
+   spx_r4_fft_free((spx_r4_fft_cfg)table);
+}
+
+static void radix4_forward(void *table, spx_word16_t *in, spx_word16_t *out)
+{
+   spx_r4_fftr((spx_r4_fft_cfg)table, in, out);
+}
+
+static void radix4_backward(void *table, spx_word16_t *in, spx_word16_t *out)
+{
+   spx_r4_fftri((spx_r4_fft_cfg)table, in, out);
+}
+
+static const SpxFftBackend radix4_backend = {
+   "radix4", spx_r4_fft_supports, radix4_init, radix4_destroy, radix4_forward, radix4_backward
+};
+
+#endif
+
+const SpxFftBackend * const spx_fft_backends[] = {
+#ifdef USE_RADIX4_FFT
+   &radix4_backend,
+#endif
+   &kiss_backend,
+   NULL
+};
+
+/* Set by spx_fft_select_backend, NULL picks the first backend that supports the size. */
+static const SpxFftBackend *forced_backend;
+
+struct fft_table {
+   const SpxFftBackend *backend;
+   void *table;
+   int N;
+};
+
+int spx_fft_select_backend(const char *name)
+{
+   int i;
+   if (name == NULL)
+   {
+      forced_backend = NULL;
+      return 0;
+   }
+   for (i=0;spx_fft_backends[i];i++)
+   {
+      if (strcmp(spx_fft_backends[i]->name, name) == 0)
+      {
+         forced_backend = spx_fft_backends[i];
+         return 0;
+      }
+   }
+   return -1;
+}
+
+const char *spx_fft_backend_name(void *table)
+{
+   return ((struct fft_table *)table)->backend->name;
+}
+
+void *spx_fft_init(int size)
+{
+   struct fft_table *t;
+   const SpxFftBackend *backend = forced_backend;
+   int i;
+
+   if (backend == NULL || !backend->supports(size))
+   {
+      backend = NULL;
+      for (i=0;spx_fft_backends[i];i++)
+      {
+         if (spx_fft_backends[i]->supports(size))
+         {
+            backend = spx_fft_backends[i];
+            break;
+         }
+      }
+      if (backend == NULL)
+         return NULL;
+   }
+   t = (struct fft_table *)speex_alloc(sizeof(struct fft_table));
+   t->backend = backend;
+   t->table = backend->init(size);
+   t->N = size;
+   return t;
+}
+
+void spx_fft_destroy(void *table)
+{
+   struct fft_table *t = (struct fft_table *)table;
+   t->backend->destroy(t->table);
+   speex_free(t);
+}
+
+#ifdef FIXED_POINT
+
+void spx_fft(void *table, spx_word16_t *in, spx_word16_t *out)
+{
+   int shift;
+   struct fft_table *t = (struct fft_table *)table;
+   shift = maximize_range(in, in, 32000, t->N);
+   t->backend->fft(t->table, in, out);
+   renorm_range(in, in, shift, t->N);
+   renorm_range(out, out, shift, t->N);
+}
+
+#else
+
+void spx_fft(void *table, spx_word16_t *in, spx_word16_t *out)
+{
+   struct fft_table *t = (struct fft_table *)table;
+   t->backend->fft(t->table, in, out);
+}
+#endif
+
+void spx_ifft(void *table, spx_word16_t *in, spx_word16_t *out)
+{
+   struct fft_table *t = (struct fft_table *)table;
+   t->backend->ifft(t->table, in, out);
+}
+
 
 #else
 
@@ -369,7 +509,7 @@ void spx_fft_float(void *table, float *in, float *out)
 #ifdef USE_SMALLFT
    int N = ((struct drft_lookup *)table)->n;
 #elif defined(USE_KISS_FFT)
-   int N = ((struct kiss_config *)table)->N;
+   int N = ((struct fft_table *)table)->N;
 #else
 #endif
 #ifdef VAR_ARRAYS
@@ -405,7 +545,7 @@ void spx_ifft_float(void *table, float *in, float *out)
 #ifdef USE_SMALLFT
    int N = ((struct drft_lookup *)table)->n;
 #elif defined(USE_KISS_FFT)
-   int N = ((struct kiss_config *)table)->N;
+   int N = ((struct fft_table *)table)->N;
 #else
 #endif
 #ifdef VAR_ARRAYS
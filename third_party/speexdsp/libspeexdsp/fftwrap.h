@@ -55,4 +55,30 @@ void spx_fft_float(void *table, float *in, float *out);
 /** Backward (half-complex to real) transform of float data */
 void spx_ifft_float(void *table, float *in, float *out);
 
+/** An FFT implementation spx_fft_init can run on. In fixed-point the wrapper scales the input
+    to full range before fft and back after, a backend only transforms:
+    fft is real to half-complex scaled by 1/size, packed as
+    {DC, re(1), im(1), ..., re(size/2-1), im(size/2-1), nyquist},
+    ifft is the unscaled inverse. in and out never overlap. */
+typedef struct {
+   const char *name;
+   /** Non zero when the backend can transform this size */
+   int (*supports)(int size);
+   void *(*init)(int size);
+   void (*destroy)(void *table);
+   void (*fft)(void *table, spx_word16_t *in, spx_word16_t *out);
+   void (*ifft)(void *table, spx_word16_t *in, spx_word16_t *out);
+} SpxFftBackend;
+
+/** Backends built in with USE_KISS_FFT, preferred first, NULL terminated. spx_fft_init takes
+    the first one that supports the size, kiss is last and supports every even size. */
+extern const SpxFftBackend * const spx_fft_backends[];
+
+/** Makes spx_fft_init prefer the backend called name for the tables it creates from now on,
+    NULL goes back to the built in order. Returns -1 when there is no such backend. */
+int spx_fft_select_backend(const char *name);
+
+/** Name of the backend an FFT table runs on */
+const char *spx_fft_backend_name(void *table);
+
 #endif
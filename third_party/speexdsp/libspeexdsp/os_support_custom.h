@@ -55,4 +55,13 @@ static void speex_free_scratch(void *ptr)
 	free(ptr);
 }
 
+#ifdef __RTOS__
+#include "os_wrapper.h"
+
+/* Guards the resampler's shared sinc tables, only held for list updates */
+#define OVERRIDE_SPEEX_TABLE_LOCK
+#define speex_table_lock() rtos_critical_enter(RTOS_CRITICAL_AUDIO)
+#define speex_table_unlock() rtos_critical_exit(RTOS_CRITICAL_AUDIO)
+#endif
+
 #endif // #ifndef _OS_SUPPORT_CUSTOM_H_
\ No newline at end of file
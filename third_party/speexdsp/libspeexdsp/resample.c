@@ -104,6 +104,17 @@ static void speex_free(void *ptr) {free(ptr);}
 #include "resample_neon.h"
 #endif
 
+#ifdef USE_ARM_DSP
+#include "resample_arm_dsp.h"
+#endif
+
+#ifdef RESAMPLE_TABLE_CACHE
+#ifndef OVERRIDE_SPEEX_TABLE_LOCK
+#define speex_table_lock()
+#define speex_table_unlock()
+#endif
+#endif
+
 /* Numer of elements to allocate on the stack */
 #ifdef VAR_ARRAYS
 #define FIXED_STACK_ALLOC 8192
@@ -113,6 +124,22 @@ static void speex_free(void *ptr) {free(ptr);}
 
 typedef int (*resampler_basic_func)(SpeexResamplerState *, spx_uint32_t , const spx_word16_t *, spx_uint32_t *, spx_word16_t *, spx_uint32_t *);
 
+#ifdef RESAMPLE_TABLE_CACHE
+/* A sinc table shared by all resamplers with the same filter, direct or
+   interpolated as update_filter would have built it for each of them */
+struct SincTableEntry {
+   struct SincTableEntry *next;
+   int          quality;
+   int          use_direct;
+   spx_uint32_t den_rate;
+   spx_uint32_t filt_len;
+   spx_uint32_t oversample;
+   float        cutoff;
+   int          refs;
+   spx_word16_t *table;
+};
+#endif
+
 struct SpeexResamplerState_ {
    spx_uint32_t in_rate;
    spx_uint32_t out_rate;
@@ -143,6 +170,9 @@ struct SpeexResamplerState_ {
 
    int    in_stride;
    int    out_stride;
+#ifdef RESAMPLE_TABLE_CACHE
+   struct SincTableEntry *shared_table;
+#endif
 } ;
 
 static const double kaiser12_table[68] = {
@@ -602,6 +632,174 @@ static int multiply_frac(spx_uint32_t *result, spx_uint32_t value, spx_uint32_t
    return RESAMPLER_ERR_SUCCESS;
 }
 
+#ifdef RESAMPLE_TABLE_CACHE
+static struct SincTableEntry *sinc_table_cache = NULL;
+
+/* The conversions nearly every non-native stream goes through */
+static int sinc_table_cache_match(const SpeexResamplerState *st)
+{
+   static const spx_uint32_t rate_pairs[][2] = {
+      {44100, 48000}, {48000, 44100}, {16000, 48000}, {48000, 16000},
+   };
+   spx_uint32_t i;
+
+   for (i=0;i<sizeof(rate_pairs)/sizeof(rate_pairs[0]);i++)
+   {
+      if (st->in_rate == rate_pairs[i][0] && st->out_rate == rate_pairs[i][1])
+         return 1;
+   }
+   return 0;
+}
+
+static struct SincTableEntry *sinc_table_cache_find(const SpeexResamplerState *st, int use_direct)
+{
+   struct SincTableEntry *entry;
+
+   for (entry=sinc_table_cache;entry;entry=entry->next)
+   {
+      if (entry->quality == st->quality && entry->use_direct == use_direct
+          && entry->den_rate == st->den_rate && entry->filt_len == st->filt_len
+          && entry->oversample == st->oversample && entry->cutoff == st->cutoff)
+         return entry;
+   }
+   return NULL;
+}
+
+static void sinc_table_cache_detach(SpeexResamplerState *st)
+{
+   struct SincTableEntry *entry = st->shared_table;
+   struct SincTableEntry **link;
+
+   if (!entry)
+      return;
+
+   speex_table_lock();
+   if (--entry->refs == 0)
+   {
+      for (link=&sinc_table_cache;*link;link=&(*link)->next)
+      {
+         if (*link == entry)
+         {
+            *link = entry->next;
+            break;
+         }
+      }
+   } else {
+      entry = NULL;
+   }
+   speex_table_unlock();
+
+   if (entry)
+   {
+      speex_free(entry->table);
+      speex_free(entry);
+   }
+   st->shared_table = NULL;
+   st->sinc_table = NULL;
+   st->sinc_table_length = 0;
+}
+
+/* Points the resampler at a shared copy of the table update_filter would build,
+   building it on first use, so the output is the same as without the cache.
+   The sinc is computed outside the lock, the loser of a race drops its copy. */
+static int sinc_table_cache_attach(SpeexResamplerState *st, int use_direct, spx_uint32_t table_length)
+{
+   struct SincTableEntry *entry;
+   struct SincTableEntry *found;
+
+   sinc_table_cache_detach(st);
+   if (!sinc_table_cache_match(st))
+      return 0;
+
+   speex_table_lock();
+   found = sinc_table_cache_find(st, use_direct);
+   if (found)
+      found->refs++;
+   speex_table_unlock();
+
+   if (!found)
+   {
+      entry = (struct SincTableEntry *)speex_alloc(sizeof(*entry));
+      if (!entry)
+         return 0;
+      entry->table = (spx_word16_t *)speex_alloc(table_length*sizeof(spx_word16_t));
+      if (!entry->table)
+      {
+         speex_free(entry);
+         return 0;
+      }
+      entry->quality = st->quality;
+      entry->use_direct = use_direct;
+      entry->den_rate = st->den_rate;
+      entry->filt_len = st->filt_len;
+      entry->oversample = st->oversample;
+      entry->cutoff = st->cutoff;
+      entry->refs = 1;
+      if (use_direct)
+      {
+         spx_uint32_t i;
+         for (i=0;i<st->den_rate;i++)
+         {
+            spx_int32_t j;
+            for (j=0;j<st->filt_len;j++)
+            {
+               entry->table[i*st->filt_len+j] = sinc(st->cutoff,((j-(spx_int32_t)st->filt_len/2+1)-((float)i)/st->den_rate), st->filt_len, quality_map[st->quality].window_func);
+            }
+         }
+      } else {
+         spx_int32_t i;
+         for (i=-4;i<(spx_int32_t)(st->oversample*st->filt_len+4);i++)
+            entry->table[i+4] = sinc(st->cutoff,(i/(float)st->oversample - st->filt_len/2), st->filt_len, quality_map[st->quality].window_func);
+      }
+
+      speex_table_lock();
+      found = sinc_table_cache_find(st, use_direct);
+      if (found)
+      {
+         found->refs++;
+      } else {
+         entry->next = sinc_table_cache;
+         sinc_table_cache = entry;
+         found = entry;
+         entry = NULL;
+      }
+      speex_table_unlock();
+
+      if (entry)
+      {
+         speex_free(entry->table);
+         speex_free(entry);
+      }
+   }
+
+   speex_free(st->sinc_table);
+   st->sinc_table = found->table;
+   st->sinc_table_length = 0;
+   st->shared_table = found;
+   if (use_direct)
+   {
+#ifdef FIXED_POINT
+      st->resampler_ptr = resampler_basic_direct_single;
+#else
+      if (st->quality>8)
+         st->resampler_ptr = resampler_basic_direct_double;
+      else
+         st->resampler_ptr = resampler_basic_direct_single;
+#endif
+   } else {
+#ifdef FIXED_POINT
+      st->resampler_ptr = resampler_basic_interpolate_single;
+#else
+      if (st->quality>8)
+         st->resampler_ptr = resampler_basic_interpolate_double;
+      else
+         st->resampler_ptr = resampler_basic_interpolate_single;
+#endif
+   }
+   return 1;
+}
+#endif
+
 static int update_filter(SpeexResamplerState *st)
 {
    spx_uint32_t old_length = st->filt_len;
@@ -656,6 +854,10 @@ static int update_filter(SpeexResamplerState *st)
 
       min_sinc_table_length = st->filt_len*st->oversample+8;
    }
+#ifdef RESAMPLE_TABLE_CACHE
+   if (sinc_table_cache_attach(st, use_direct, min_sinc_table_length))
+      goto filter_ready;
+#endif
    if (st->sinc_table_length < min_sinc_table_length)
    {
       spx_word16_t *sinc_table = (spx_word16_t *)speex_realloc(st->sinc_table,min_sinc_table_length*sizeof(spx_word16_t));
@@ -700,6 +902,10 @@ static int update_filter(SpeexResamplerState *st)
       /*fprintf (stderr, "resampler uses interpolated sinc table and normalised cutoff %f\n", cutoff);*/
    }
 
+#ifdef RESAMPLE_TABLE_CACHE
+filter_ready:
+#endif
+
    /* Here's the place where we update the filter memory to take into account
       the change in filter length. It's probably the messiest part of the code
       due to handling of lots of corner cases. */
@@ -822,6 +1028,9 @@ EXPORT SpeexResamplerState *speex_resampler_init_frac(spx_uint32_t nb_channels,
    st->den_rate = 0;
    st->quality = -1;
    st->sinc_table_length = 0;
+#ifdef RESAMPLE_TABLE_CACHE
+   st->shared_table = NULL;
+#endif
    st->mem_alloc_size = 0;
    st->filt_len = 0;
    st->mem = 0;
@@ -868,6 +1077,9 @@ fail:
 EXPORT void speex_resampler_destroy(SpeexResamplerState *st)
 {
    speex_free(st->mem);
+#ifdef RESAMPLE_TABLE_CACHE
+   sinc_table_cache_detach(st);
+#endif
    speex_free(st->sinc_table);
    speex_free(st->last_sample);
    speex_free(st->magic_samples);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Realtek, LLC.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+   @file resample_arm_dsp.h
+   @brief Resampler functions (Armv7E-M/Armv8-M DSP extension version)
+*/
+
+#if defined(FIXED_POINT) && defined(__ARM_FEATURE_DSP)
+
+#include <string.h>
+
+#undef WORD2INT
+#define WORD2INT(x) (saturate_32bit_to_16bit(x))
+static inline int32_t saturate_32bit_to_16bit(int32_t a) {
+    int32_t ret;
+    asm ("ssat %[ret], #16, %[a]"
+         : [ret] "=r" (ret)
+         : [a] "r" (a)
+         : );
+    return ret;
+}
+
+/* Two 16 bit samples in one word, the sinc table rows and the input start at any sample. */
+static inline uint32_t read_16x2(const int16_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline int64_t smlald(uint32_t x, uint32_t y, int64_t acc) {
+    union {
+        int64_t v;
+        struct {
+            uint32_t lo;
+            int32_t hi;
+        } w;
+    } a;
+    a.v = acc;
+    asm ("smlald %[lo], %[hi], %[x], %[y]"
+         : [lo] "+r" (a.w.lo), [hi] "+r" (a.w.hi)
+         : [x] "r" (x), [y] "r" (y)
+         : );
+    return a.v;
+}
+
+#define OVERRIDE_INNER_PRODUCT_SINGLE
+/* Only works when len % 2 == 0, the resampler keeps filt_len a multiple of 8.
+   Accumulates in 64 bits, then rounds and saturates like SATURATE32PSHR(sum, 15, 32767). */
+static inline int32_t inner_product_single(const int16_t *a, const int16_t *b, unsigned int len)
+{
+    int64_t acc0 = 0;
+    int64_t acc1 = 0;
+
+    for (; len >= 8; len -= 8, a += 8, b += 8) {
+        acc0 = smlald(read_16x2(a), read_16x2(b), acc0);
+        acc1 = smlald(read_16x2(a + 2), read_16x2(b + 2), acc1);
+        acc0 = smlald(read_16x2(a + 4), read_16x2(b + 4), acc0);
+        acc1 = smlald(read_16x2(a + 6), read_16x2(b + 6), acc1);
+    }
+    for (; len >= 2; len -= 2, a += 2, b += 2) {
+        acc0 = smlald(read_16x2(a), read_16x2(b), acc0);
+    }
+
+    acc0 += acc1;
+    if (acc0 >= ((int64_t)32767 << 15))
+        return 32767;
+    if (acc0 <= -((int64_t)32767 << 15))
+        return -32767;
+    return (int32_t)((acc0 + (1 << 14)) >> 15);
+}
+
+#endif